@@ -0,0 +1,86 @@
+#include "harness.hpp"
+
+namespace bench {
+namespace deep {
+
+////////////////////////////////////////////////////////////////////////////////
+// Chain of nested composites, each level with an extra leaf sibling
+
+using M = hfsm2::Machine;
+
+enum : int { DEPTH = 12 };
+
+template <int N> struct Head;
+template <int N> struct Leaf;
+
+template <int N>
+struct Chain {
+	using Type = M::Composite<Head<N>,
+							  typename Chain<N + 1>::Type,
+							  Leaf<N>>;
+};
+
+template <>
+struct Chain<DEPTH> {
+	using Type = M::Composite<Head<DEPTH>,
+							  Leaf<DEPTH>,
+							  Leaf<DEPTH + 1>>;
+};
+
+using FSM = M::Root<Head<0>,
+					Chain<1>::Type,
+					Leaf<0>>;
+
+//------------------------------------------------------------------------------
+
+template <int N>
+struct Head
+	: FSM::State
+{
+	void update(FullControl&)									{ sink += N;								}
+
+	template <typename TEvent>
+	void react(const TEvent&, FullControl&)						{ sink += N;								}
+};
+
+template <int N>
+struct Leaf
+	: FSM::State
+{
+	void update(FullControl&)									{ sink += N;								}
+
+	template <typename TEvent>
+	void react(const TEvent&, FullControl&)						{ sink += N;								}
+};
+
+//------------------------------------------------------------------------------
+
+static_assert(FSM::Instance::STATE_COUNT == 2 * DEPTH + 3, "");
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+
+void
+benchDeep(Harness& harness) {
+	using namespace deep;
+
+	// transitions between the deepest leaves
+	benchMachine<FSM::Instance, Leaf<DEPTH>, Leaf<DEPTH + 1>>(harness, "deep");
+
+	// transitions across the whole chain
+	FSM::Instance machine;
+
+	bool flip = false;
+	harness.run("deep", "transition_far", [&] {
+		flip = !flip;
+		if (flip)
+			machine.changeTo<Leaf<0>>();
+		else
+			machine.changeTo<Leaf<DEPTH>>();
+
+		machine.update();
+	});
+}
+
+}
@@ -0,0 +1,89 @@
+#include "harness.hpp"
+
+namespace bench {
+namespace ortho {
+
+////////////////////////////////////////////////////////////////////////////////
+// Orthogonal regions nested three levels deep
+
+using M = hfsm2::Machine;
+
+template <int N> struct O;
+
+using FSM = M::Root<O<0>,
+				M::Orthogonal<O<1>,
+					M::Composite<O<2>,
+						O<3>,
+						O<4>
+					>,
+					M::Orthogonal<O<5>,
+						M::Composite<O<6>,
+							O<7>,
+							O<8>
+						>,
+						M::Orthogonal<O<9>,
+							M::Composite<O<10>,
+								O<11>,
+								O<12>
+							>,
+							M::Composite<O<13>,
+								O<14>,
+								O<15>
+							>
+						>,
+						M::Composite<O<16>,
+							O<17>,
+							O<18>
+						>
+					>,
+					M::Composite<O<19>,
+						O<20>,
+						O<21>
+					>
+				>,
+				O<22>
+			>;
+
+//------------------------------------------------------------------------------
+
+template <int N>
+struct O
+	: FSM::State
+{
+	void update(FullControl&)									{ sink += N;								}
+
+	template <typename TEvent>
+	void react(const TEvent&, FullControl&)						{ sink += N;								}
+};
+
+//------------------------------------------------------------------------------
+
+static_assert(FSM::Instance::STATE_COUNT == 23, "");
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+
+void
+benchOrtho(Harness& harness) {
+	using namespace ortho;
+
+	// re-entering the whole orthogonal tree
+	benchMachine<FSM::Instance, O<22>, O<15>>(harness, "ortho");
+
+	// flipping a single innermost region
+	FSM::Instance machine;
+
+	bool flip = false;
+	harness.run("ortho", "transition_leaf", [&] {
+		flip = !flip;
+		if (flip)
+			machine.changeTo<O<15>>();
+		else
+			machine.changeTo<O<14>>();
+
+		machine.update();
+	});
+}
+
+}
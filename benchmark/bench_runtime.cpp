@@ -0,0 +1,114 @@
+#include "harness.hpp"
+
+namespace bench {
+namespace runtime {
+
+////////////////////////////////////////////////////////////////////////////////
+// The 'ortho' hierarchy, described at run time
+
+using M = hfsm2::Machine;
+
+using RT = M::Runtime<23, 7, 3>;
+
+using Region = hfsm2::RuntimeRegion;
+
+//------------------------------------------------------------------------------
+
+void
+update(const hfsm2::StateID stateId, RT::FullControl&) {
+	sink += stateId;
+}
+
+void
+react(const hfsm2::StateID stateId, const RT::Event&, RT::FullControl&) {
+	sink += stateId;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+RT::Layout
+makeLayout() {
+	RT::Callbacks callbacks;
+	callbacks.update = update;
+	callbacks.react	 = react;
+
+	RT::Layout layout;
+
+	const auto add = [&](const hfsm2::StateID parent, const Region region) {
+		return layout.add(parent, region, callbacks);
+	};
+
+	const auto o0  = add(hfsm2::INVALID_STATE_ID, Region::COMPOSITE);
+	const auto o1  = add(o0,  Region::ORTHOGONAL);
+	const auto o2  = add(o1,  Region::COMPOSITE);
+					 add(o2,  Region::NONE);
+					 add(o2,  Region::NONE);
+	const auto o5  = add(o1,  Region::ORTHOGONAL);
+	const auto o6  = add(o5,  Region::COMPOSITE);
+					 add(o6,  Region::NONE);
+					 add(o6,  Region::NONE);
+	const auto o9  = add(o5,  Region::ORTHOGONAL);
+	const auto o10 = add(o9,  Region::COMPOSITE);
+					 add(o10, Region::NONE);
+					 add(o10, Region::NONE);
+	const auto o13 = add(o9,  Region::COMPOSITE);
+					 add(o13, Region::NONE);
+					 add(o13, Region::NONE);
+	const auto o16 = add(o5,  Region::COMPOSITE);
+					 add(o16, Region::NONE);
+					 add(o16, Region::NONE);
+	const auto o19 = add(o1,  Region::COMPOSITE);
+					 add(o19, Region::NONE);
+					 add(o19, Region::NONE);
+					 add(o0,  Region::NONE);
+
+	layout.build();
+
+	return layout;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+
+void
+benchRuntime(Harness& harness) {
+	using namespace runtime;
+
+	const RT::Layout layout = makeLayout();
+	hfsm2::EmptyContext context;
+
+	harness.run("ortho_runtime", "construct", [&] {
+		RT::Instance machine{layout, context};
+		sink += machine.isActive(22);
+	});
+
+	RT::Instance machine{layout, context};
+
+	harness.run("ortho_runtime", "update", [&] {
+		machine.update();
+	});
+
+	harness.run("ortho_runtime", "react", [&] {
+		machine.react(Tick{});
+	});
+
+	// re-entering the whole orthogonal tree
+	bool flip = false;
+	harness.run("ortho_runtime", "transition", [&] {
+		flip = !flip;
+		machine.changeTo(flip ? 15 : 22);
+		machine.update();
+	});
+
+	// flipping a single innermost region
+	RT::Instance leaf{layout, context};
+
+	harness.run("ortho_runtime", "transition_leaf", [&] {
+		flip = !flip;
+		leaf.changeTo(flip ? 15 : 14);
+		leaf.update();
+	});
+}
+
+}
@@ -0,0 +1,97 @@
+#include "harness.hpp"
+
+#include <memory>
+
+namespace bench {
+namespace scheduler {
+
+////////////////////////////////////////////////////////////////////////////////
+// Several small machine types, ticked through virtual wrappers or a SchedulerT<>
+
+using M = hfsm2::Machine;
+
+template <int N, int I> struct O;
+
+template <int N>
+using FSM = M::Root<O<N, 0>,
+				O<N, 1>,
+				O<N, 2>
+			>;
+
+//------------------------------------------------------------------------------
+
+template <int N, int I>
+struct O
+	: FSM<N>::State
+{
+	void update(typename FSM<N>::State::FullControl&)			{ sink += N;								}
+};
+
+//------------------------------------------------------------------------------
+
+enum : unsigned { MACHINES_PER_TYPE = 256 };
+
+using Scheduler = hfsm2::SchedulerT<MACHINES_PER_TYPE,
+									FSM<0>::Instance,
+									FSM<1>::Instance,
+									FSM<2>::Instance,
+									FSM<3>::Instance>;
+
+//------------------------------------------------------------------------------
+
+struct IMachine {
+	virtual ~IMachine() = default;
+
+	virtual void update() = 0;
+};
+
+template <typename TInstance>
+struct MachineT
+	: IMachine
+{
+	void update() override										{ machine.update();							}
+
+	TInstance machine;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TInstance>
+void
+add(std::vector<std::unique_ptr<IMachine>>& machines,
+	Scheduler& scheduler)
+{
+	machines.emplace_back(new MachineT<TInstance>{});
+	scheduler.emplace<TInstance>();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+
+void
+benchScheduler(Harness& harness) {
+	using namespace scheduler;
+
+	std::vector<std::unique_ptr<IMachine>> machines;
+	std::unique_ptr<Scheduler> pools{new Scheduler};
+
+	// types interleaved, as they'd be created in a game world
+	for (unsigned i = 0; i < MACHINES_PER_TYPE; ++i) {
+		add<FSM<0>::Instance>(machines, *pools);
+		add<FSM<1>::Instance>(machines, *pools);
+		add<FSM<2>::Instance>(machines, *pools);
+		add<FSM<3>::Instance>(machines, *pools);
+	}
+
+	harness.run("scheduler", "tick_virtual", [&] {
+		for (const std::unique_ptr<IMachine>& machine : machines)
+			machine->update();
+	});
+
+	harness.run("scheduler", "tick", [&] {
+		pools->update();
+	});
+}
+
+}
@@ -0,0 +1,132 @@
+#include "harness.hpp"
+
+namespace bench {
+namespace stress {
+
+////////////////////////////////////////////////////////////////////////////////
+// Same hierarchy as test/test_stress.cpp
+
+using M = hfsm2::Machine;
+
+#define S(s) struct s
+
+using FSM = M::Root<S(Apex),
+				S(S1),
+				M::Orthogonal<S(O2),
+					M::Composite<S(O2_C1),
+						S(O2_C1_S1),
+						S(O2_C1_S2),
+						M::Orthogonal<S(O2_C1_O3),
+							M::Composite<S(O2_C1_O3_C1),
+								S(O2_C1_O3_C1_S1),
+								S(O2_C1_O3_C1_S2)
+							>,
+							M::Composite<S(O2_C1_O3_C2),
+								S(O2_C1_O3_C2_S1),
+								S(O2_C1_O3_C2_S2),
+								S(O2_C1_O3_C2_S3)
+							>
+						>
+					>,
+					M::Composite<S(O2_C2),
+						S(O2_C2_S1),
+						M::Composite<S(O2_C2_C2),
+							S(O2_C2_C2_S1),
+							S(O2_C2_C2_S2)
+						>,
+						M::Composite<S(O2_C2_C3),
+							S(O2_C2_C3_S1),
+							S(O2_C2_C3_S2)
+						>,
+						M::Composite<S(O2_C2_C4),
+							S(O2_C2_C4_S1),
+							S(O2_C2_C4_S2)
+						>,
+						S(O2_C2_S5)
+					>
+				>,
+				S(S3)
+			>;
+
+#undef S
+
+//------------------------------------------------------------------------------
+
+struct Apex				: FSM::State {};
+
+struct S1				: FSM::State {};
+struct O2				: FSM::State {};
+
+struct O2_C1			: FSM::State {};
+struct O2_C1_S1			: FSM::State {};
+struct O2_C1_S2			: FSM::State {};
+
+struct O2_C1_O3			: FSM::State {};
+
+struct O2_C1_O3_C1		: FSM::State {};
+struct O2_C1_O3_C1_S1	: FSM::State {};
+struct O2_C1_O3_C1_S2	: FSM::State {};
+
+struct O2_C1_O3_C2		: FSM::State {};
+struct O2_C1_O3_C2_S1	: FSM::State {};
+struct O2_C1_O3_C2_S2	: FSM::State {};
+struct O2_C1_O3_C2_S3	: FSM::State {};
+
+struct O2_C2			: FSM::State {};
+struct O2_C2_S1			: FSM::State {};
+
+struct O2_C2_C2			: FSM::State {};
+struct O2_C2_C2_S1		: FSM::State {};
+struct O2_C2_C2_S2		: FSM::State {};
+
+struct O2_C2_C3			: FSM::State {};
+struct O2_C2_C3_S1		: FSM::State {};
+struct O2_C2_C3_S2		: FSM::State {};
+
+struct O2_C2_C4			: FSM::State {};
+struct O2_C2_C4_S1		: FSM::State {};
+struct O2_C2_C4_S2		: FSM::State {};
+
+struct O2_C2_S5			: FSM::State {};
+struct S3				: FSM::State {};
+
+//------------------------------------------------------------------------------
+
+static_assert(FSM::Instance::STATE_COUNT == 27, "");
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+
+void
+benchStress(Harness& harness) {
+	using namespace stress;
+
+	benchMachine<FSM::Instance, S1, O2_C1_O3_C2_S3>(harness, "stress");
+
+	// update / react above run in S1, repeat them with the nested orthogonal regions active
+	FSM::Instance deep;
+	deep.changeTo<O2_C1_O3_C2_S3>();
+	deep.update();
+
+	harness.run("stress", "update_deep", [&] {
+		deep.update();
+	});
+
+	harness.run("stress", "react_deep", [&] {
+		deep.react(Tick{});
+	});
+
+	// round-robin over every state
+	FSM::Instance machine;
+
+	hfsm2::StateID target = 0;
+	harness.run("stress", "transition_all", [&] {
+		target = (target + 1) % FSM::Instance::STATE_COUNT;
+
+		machine.changeTo(target);
+		machine.update();
+	});
+}
+
+}
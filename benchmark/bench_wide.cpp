@@ -0,0 +1,69 @@
+#include "harness.hpp"
+
+namespace bench {
+namespace wide {
+
+////////////////////////////////////////////////////////////////////////////////
+// Wide utilitarian and random regions side by side
+
+using M = hfsm2::Machine;
+
+template <int N> struct W;
+
+using FSM = M::Root<W<0>,
+				M::Utilitarian<W<1>,
+					W< 2>, W< 3>, W< 4>, W< 5>, W< 6>, W< 7>, W< 8>, W< 9>,
+					W<10>, W<11>, W<12>, W<13>, W<14>, W<15>, W<16>, W<17>,
+					W<18>, W<19>, W<20>, W<21>, W<22>, W<23>, W<24>, W<25>,
+					W<26>, W<27>, W<28>, W<29>, W<30>, W<31>, W<32>, W<33>
+				>,
+				M::Random<W<34>,
+					W<35>, W<36>, W<37>, W<38>, W<39>, W<40>, W<41>, W<42>,
+					W<43>, W<44>, W<45>, W<46>, W<47>, W<48>, W<49>, W<50>,
+					W<51>, W<52>, W<53>, W<54>, W<55>, W<56>, W<57>, W<58>,
+					W<59>, W<60>, W<61>, W<62>, W<63>, W<64>, W<65>, W<66>
+				>
+			>;
+
+//------------------------------------------------------------------------------
+
+template <int N>
+struct W
+	: FSM::State
+{
+	float utility(const Control&)								{ return (float) (N % 7);					}
+
+	void update(FullControl&)									{ sink += N;								}
+
+	template <typename TEvent>
+	void react(const TEvent&, FullControl&)						{ sink += N;								}
+};
+
+//------------------------------------------------------------------------------
+
+static_assert(FSM::Instance::STATE_COUNT == 67, "");
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+
+void
+benchWide(Harness& harness) {
+	using namespace wide;
+
+	benchMachine<FSM::Instance, W<2>, W<33>>(harness, "wide");
+
+	FSM::Instance machine;
+
+	harness.run("wide", "utilize", [&] {
+		machine.utilize<W<1>>();
+		machine.update();
+	});
+
+	harness.run("wide", "randomize", [&] {
+		machine.randomize<W<34>>();
+		machine.update();
+	});
+}
+
+}
@@ -0,0 +1,213 @@
+#include "counters.hpp"
+
+#ifdef __linux__
+	#include <linux/perf_event.h>
+	#include <sys/ioctl.h>
+	#include <sys/syscall.h>
+	#include <unistd.h>
+	#include <string.h>
+#endif
+
+namespace bench {
+
+////////////////////////////////////////////////////////////////////////////////
+
+const char*
+counterName(const Counter counter) {
+	switch (counter) {
+	case Counter::CYCLES:			return "cycles";
+	case Counter::INSTRUCTIONS:		return "instructions";
+	case Counter::BRANCH_MISSES:	return "branch_misses";
+	case Counter::L1D_MISSES:		return "l1d_misses";
+
+	default:
+		return "";
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef __linux__
+
+namespace {
+
+int
+openCounter(const uint32_t type,
+			const uint64_t config,
+			const int leader)
+{
+	perf_event_attr attr;
+	memset(&attr, 0, sizeof(attr));
+
+	attr.size			= sizeof(attr);
+	attr.type			= type;
+	attr.config			= config;
+	attr.disabled		= leader < 0;		// the whole group follows its leader
+	attr.exclude_kernel = 1;
+	attr.exclude_hv		= 1;
+	attr.read_format	= PERF_FORMAT_GROUP						|
+						  PERF_FORMAT_ID						|
+						  PERF_FORMAT_TOTAL_TIME_ENABLED		|
+						  PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+	return (int) syscall(SYS_perf_event_open, &attr, 0, -1, leader, 0);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct Event {
+	uint32_t type;
+	uint64_t config;
+};
+
+const Event EVENTS[PerfCounters::COUNT] = {
+	{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+	{PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+	{PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+	{PERF_TYPE_HW_CACHE, PERF_COUNT_HW_CACHE_L1D					|
+						 PERF_COUNT_HW_CACHE_OP_READ		 <<	 8	|
+						 PERF_COUNT_HW_CACHE_RESULT_MISS	 << 16},
+};
+
+// PERF_FORMAT_GROUP layout with the other read_format flags above
+struct GroupReading {
+	uint64_t count;
+	uint64_t timeEnabled;
+	uint64_t timeRunning;
+
+	struct {
+		uint64_t value;
+		uint64_t id;
+	} values[PerfCounters::COUNT];
+};
+
+}
+
+//------------------------------------------------------------------------------
+
+PerfCounters::PerfCounters() {
+	for (unsigned i = 0; i < COUNT; ++i)
+		_fds[i] = -1;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+PerfCounters::~PerfCounters() {
+	for (unsigned i = 0; i < COUNT; ++i)
+		if (_fds[i] >= 0)
+			close(_fds[i]);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+bool
+PerfCounters::open() {
+	for (unsigned i = 0; i < COUNT; ++i) {
+		if (_fds[i] >= 0)
+			continue;
+
+		const int fd = openCounter(EVENTS[i].type, EVENTS[i].config, _leader);
+		if (fd < 0)
+			continue;
+
+		// values are matched to counters by id
+		if (ioctl(fd, PERF_EVENT_IOC_ID, &_ids[i]) < 0) {
+			close(fd);
+
+			// without the leader, there's no group to join
+			if (_leader < 0)
+				return false;
+
+			continue;
+		}
+
+		_fds[i] = fd;
+
+		if (_leader < 0)
+			_leader = fd;
+	}
+
+	return any();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void
+PerfCounters::start() {
+	if (_leader >= 0) {
+		ioctl(_leader, PERF_EVENT_IOC_RESET,  PERF_IOC_FLAG_GROUP);
+		ioctl(_leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void
+PerfCounters::stop(uint64_t (&values)[COUNT]) {
+	for (unsigned i = 0; i < COUNT; ++i)
+		values[i] = 0;
+
+	_coverage = 1.0;
+
+	if (_leader < 0)
+		return;
+
+	ioctl(_leader, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+
+	GroupReading reading;
+	if (read(_leader, &reading, sizeof(reading)) < (ssize_t) (3 * sizeof(uint64_t)))
+		return;
+
+	// never scheduled, nothing to scale
+	if (reading.timeRunning == 0) {
+		_coverage = 0.0;
+		return;
+	}
+
+	_coverage = (double) reading.timeRunning / (double) reading.timeEnabled;
+
+	for (uint64_t v = 0; v < reading.count && v < COUNT; ++v)
+		for (unsigned i = 0; i < COUNT; ++i)
+			if (_fds[i] >= 0 && _ids[i] == reading.values[v].id)
+				values[i] = (uint64_t) ((double) reading.values[v].value / _coverage);
+}
+
+#else
+
+//------------------------------------------------------------------------------
+
+PerfCounters::PerfCounters() {
+	for (unsigned i = 0; i < COUNT; ++i)
+		_fds[i] = -1;
+}
+
+PerfCounters::~PerfCounters() {}
+
+bool
+PerfCounters::open()								{ return false;								}
+
+void
+PerfCounters::start() {}
+
+void
+PerfCounters::stop(uint64_t (&values)[COUNT]) {
+	for (unsigned i = 0; i < COUNT; ++i)
+		values[i] = 0;
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+
+bool
+PerfCounters::any() const {
+	for (unsigned i = 0; i < COUNT; ++i)
+		if (_fds[i] >= 0)
+			return true;
+
+	return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
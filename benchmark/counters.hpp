@@ -0,0 +1,65 @@
+// HFSM2 (hierarchical state machine for games and interactive applications)
+// Hardware performance counters
+
+#pragma once
+
+#include <stdint.h>
+
+namespace bench {
+
+////////////////////////////////////////////////////////////////////////////////
+
+enum class Counter : unsigned {
+	CYCLES,
+	INSTRUCTIONS,
+	BRANCH_MISSES,
+	L1D_MISSES,
+
+	COUNT
+};
+
+const char* counterName(const Counter counter);
+
+//------------------------------------------------------------------------------
+
+// Linux perf_event_open() counters for the calling thread, opened as a single group
+//  Counters the kernel or the container refuses to open are skipped,
+//  on other platforms none are available
+
+class PerfCounters {
+public:
+	enum : unsigned { COUNT = (unsigned) Counter::COUNT };
+
+	PerfCounters();
+	~PerfCounters();
+
+	PerfCounters(const PerfCounters&) = delete;
+	PerfCounters& operator = (const PerfCounters&) = delete;
+
+	// Returns false if none of the counters could be opened
+	bool open();
+
+	bool any() const;
+	bool available(const Counter counter) const		{ return _fds[(unsigned) counter] >= 0;		}
+
+	void start();
+
+	// Read counter values accumulated since start() into 'values'
+	//  If the kernel multiplexed the group with other events, values are
+	//  scaled up to the whole window, see coverage()
+	//  Unavailable counters read as 0
+	void stop(uint64_t (&values)[COUNT]);
+
+	// Share of the last start() / stop() window the group was counting for, 1.0 unless multiplexed
+	double coverage() const							{ return _coverage;							}
+
+private:
+	int _fds[COUNT];
+	uint64_t _ids[COUNT];
+	int _leader = -1;
+	double _coverage = 1.0;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,90 @@
+#include "harness.hpp"
+
+#include <string.h>
+
+namespace bench {
+
+////////////////////////////////////////////////////////////////////////////////
+
+volatile uint64_t sink = 0;
+
+//------------------------------------------------------------------------------
+
+bool
+Harness::selected(const char* const shape,
+				  const char* const operation) const
+{
+	if (!_filter)
+		return true;
+
+	const std::string name = std::string{shape} + "/" + operation;
+
+	return name.find(_filter) != std::string::npos;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+void
+Harness::report(const Result& result) const {
+	fprintf(stderr, "%-8s %-16s %10.1f ns/op  (min %.1f, %llu iterations)",
+			result.shape.c_str(),
+			result.operation.c_str(),
+			result.nsPerOp,
+			result.nsMin,
+			(unsigned long long) result.iterations);
+
+	for (unsigned c = 0; c < PerfCounters::COUNT; ++c)
+		if (result.counters[c] >= 0.0)
+			fprintf(stderr, " %s %.1f", counterName((Counter) c), result.counters[c]);
+
+	// counters were multiplexed with other events, values are extrapolated
+	if (result.coverage < 1.0)
+		fprintf(stderr, " [counters scaled, ran %.0f%% of the time]", 100.0 * result.coverage);
+
+	fprintf(stderr, "\n");
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+bool
+Harness::writeJson(FILE* const file) const {
+#if defined _MSC_VER
+	fprintf(file, "{\n\t\"library\": \"hfsm2\",\n\t\"compiler\": \"msvc %d\",\n", _MSC_FULL_VER);
+#elif defined __VERSION__
+	fprintf(file, "{\n\t\"library\": \"hfsm2\",\n\t\"compiler\": \"%s\",\n", __VERSION__);
+#else
+	fprintf(file, "{\n\t\"library\": \"hfsm2\",\n\t\"compiler\": \"unknown\",\n");
+#endif
+	fprintf(file, "\t\"benchmarks\": [");
+
+	for (size_t i = 0; i < _results.size(); ++i) {
+		const Result& result = _results[i];
+
+		fprintf(file, "%s\n\t\t{\"shape\": \"%s\", \"operation\": \"%s\", "
+					  "\"iterations\": %llu, \"ns_per_op\": %.3f, \"ns_min\": %.3f",
+				i ? "," : "",
+				result.shape.c_str(),
+				result.operation.c_str(),
+				(unsigned long long) result.iterations,
+				result.nsPerOp,
+				result.nsMin);
+
+		// per operation, only the counters that could be opened
+		for (unsigned c = 0; c < PerfCounters::COUNT; ++c)
+			if (result.counters[c] >= 0.0)
+				fprintf(file, ", \"%s_per_op\": %.3f", counterName((Counter) c), result.counters[c]);
+
+		if (result.coverage < 1.0)
+			fprintf(file, ", \"counter_coverage\": %.3f", result.coverage);
+
+		fprintf(file, "}");
+	}
+
+	fprintf(file, "\n\t]\n}\n");
+
+	return !ferror(file);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,219 @@
+// HFSM2 (hierarchical state machine for games and interactive applications)
+// Microbenchmark harness
+
+#pragma once
+
+#define HFSM_ENABLE_SERIALIZATION
+#include <hfsm2/machine.hpp>
+
+#include "counters.hpp"
+
+#include <chrono>
+#include <stdint.h>
+#include <stdio.h>
+#include <string>
+#include <vector>
+
+namespace bench {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Written to by state methods and benchmark bodies so the optimizer keeps them
+extern volatile uint64_t sink;
+
+//------------------------------------------------------------------------------
+
+struct Result {
+	std::string shape;
+	std::string operation;
+
+	uint64_t iterations;
+	double nsPerOp;		// median of Harness::REPEATS samples
+	double nsMin;		// fastest sample
+
+	// Hardware counters per operation, negative if unavailable
+	double counters[PerfCounters::COUNT];
+
+	// Share of the counter pass the counters were scheduled for, see PerfCounters::coverage()
+	double coverage;
+};
+
+//------------------------------------------------------------------------------
+
+class Harness {
+public:
+	enum : unsigned { REPEATS = 5 };
+
+	// 'minSeconds' - minimal duration of a single sample
+	// 'filter'		- only run benchmarks whose "shape/operation" contains it
+	// 'counters'	- optional hardware counters, read over an extra pass after timing
+	Harness(const double minSeconds,
+			const char* const filter = nullptr,
+			PerfCounters* const counters = nullptr)
+		: _minSeconds{minSeconds}
+		, _filter{filter}
+		, _counters{counters && counters->any() ? counters : nullptr}
+	{}
+
+	// Time 'operation()', calibrating the iteration count to '_minSeconds'
+	template <typename TOperation>
+	void run(const char* const shape,
+			 const char* const operation,
+			 TOperation&& function);
+
+	const std::vector<Result>& results() const					{ return _results;							}
+
+	bool writeJson(FILE* const file) const;
+
+private:
+	using Clock = std::chrono::steady_clock;
+
+	template <typename TOperation>
+	double sample(TOperation& function,
+				  const uint64_t iterations);
+
+	bool selected(const char* const shape,
+				  const char* const operation) const;
+
+	void report(const Result& result) const;
+
+private:
+	const double _minSeconds;
+	const char* const _filter;
+	PerfCounters* const _counters;
+
+	std::vector<Result> _results;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TOperation>
+double
+Harness::sample(TOperation& function,
+				const uint64_t iterations)
+{
+	const Clock::time_point start = Clock::now();
+
+	for (uint64_t i = 0; i < iterations; ++i)
+		function();
+
+	return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TOperation>
+void
+Harness::run(const char* const shape,
+			 const char* const operation,
+			 TOperation&& function)
+{
+	if (!selected(shape, operation))
+		return;
+
+	uint64_t iterations = 1;
+
+	for (double elapsed = sample(function, iterations);
+		 elapsed < _minSeconds && iterations < (1ull << 40);
+		 elapsed = sample(function, iterations))
+	{
+		iterations = elapsed > 0.0 ?
+			(uint64_t) (iterations * 1.2 * _minSeconds / elapsed) + 1 :
+			iterations * 10;
+	}
+
+	double samples[REPEATS];
+	for (unsigned r = 0; r < REPEATS; ++r)
+		samples[r] = sample(function, iterations) * 1e9 / (double) iterations;
+
+	for (unsigned i = 1; i < REPEATS; ++i)
+		for (unsigned j = i; j > 0 && samples[j - 1] > samples[j]; --j) {
+			const double swap = samples[j];
+			samples[j] = samples[j - 1];
+			samples[j - 1] = swap;
+		}
+
+	Result result{shape, operation, iterations, samples[REPEATS / 2], samples[0], {}, 1.0};
+
+	for (unsigned c = 0; c < PerfCounters::COUNT; ++c)
+		result.counters[c] = -1.0;
+
+	if (_counters) {
+		uint64_t values[PerfCounters::COUNT];
+
+		_counters->start();
+		sample(function, iterations);
+		_counters->stop(values);
+
+		for (unsigned c = 0; c < PerfCounters::COUNT; ++c)
+			if (_counters->available((Counter) c))
+				result.counters[c] = (double) values[c] / (double) iterations;
+
+		result.coverage = _counters->coverage();
+	}
+
+	_results.push_back(result);
+	report(result);
+}
+
+//------------------------------------------------------------------------------
+
+struct Tick {};
+
+// Operations shared by all shapes
+//  'TA', 'TB' - leaf states to alternate between in the 'transition' benchmark
+template <typename TInstance, typename TA, typename TB>
+void
+benchMachine(Harness& harness,
+			 const char* const shape)
+{
+	harness.run(shape, "construct", [] {
+		TInstance machine;
+		sink += machine.template isActive<TA>();
+	});
+
+	TInstance machine;
+
+	harness.run(shape, "update", [&] {
+		machine.update();
+	});
+
+	harness.run(shape, "react", [&] {
+		machine.react(Tick{});
+	});
+
+	bool flip = false;
+	harness.run(shape, "transition", [&] {
+		flip = !flip;
+		if (flip)
+			machine.template changeTo<TB>();
+		else
+			machine.template changeTo<TA>();
+
+		machine.update();
+	});
+
+	typename TInstance::SerialBuffer buffer;
+
+	harness.run(shape, "save", [&] {
+		machine.save(buffer);
+		sink += buffer.bitSize;
+	});
+
+	harness.run(shape, "load", [&] {
+		machine.load(buffer);
+	});
+}
+
+//------------------------------------------------------------------------------
+
+void benchDeep	   (Harness& harness);
+void benchWide	   (Harness& harness);
+void benchOrtho	   (Harness& harness);
+void benchStress   (Harness& harness);
+void benchRuntime  (Harness& harness);
+void benchScheduler(Harness& harness);
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,65 @@
+// HFSM2 (hierarchical state machine for games and interactive applications)
+// Microbenchmarks
+//
+// Usage: hfsm2_bench [--out <path.json>] [--min-time <ms>] [--filter <shape/operation>] [--counters]
+//  Human-readable results go to stderr, JSON to stdout or '--out'
+//  '--counters' adds Linux hardware counters per operation, where the kernel allows them
+
+#include "harness.hpp"
+
+#include <stdlib.h>
+#include <string.h>
+
+////////////////////////////////////////////////////////////////////////////////
+
+int
+main(int argc, char** argv) {
+	const char* out = nullptr;
+	const char* filter = nullptr;
+	double minSeconds = 0.05;
+	bool counters = false;
+
+	for (int i = 1; i < argc; ++i) {
+		if (!strcmp(argv[i], "--out") && i + 1 < argc)
+			out = argv[++i];
+		else if (!strcmp(argv[i], "--min-time") && i + 1 < argc)
+			minSeconds = atof(argv[++i]) / 1000.0;
+		else if (!strcmp(argv[i], "--filter") && i + 1 < argc)
+			filter = argv[++i];
+		else if (!strcmp(argv[i], "--counters"))
+			counters = true;
+		else {
+			fprintf(stderr, "usage: %s [--out <path.json>] [--min-time <ms>] [--filter <shape/operation>] [--counters]\n", argv[0]);
+			return 1;
+		}
+	}
+
+	bench::PerfCounters perfCounters;
+
+	if (counters && !perfCounters.open())
+		fprintf(stderr, "hardware counters unavailable, reporting timings only\n");
+
+	bench::Harness harness{minSeconds, filter, counters ? &perfCounters : nullptr};
+
+	bench::benchDeep	 (harness);
+	bench::benchWide	 (harness);
+	bench::benchOrtho	 (harness);
+	bench::benchStress	 (harness);
+	bench::benchRuntime	 (harness);
+	bench::benchScheduler(harness);
+
+	FILE* const file = out ? fopen(out, "w") : stdout;
+	if (!file) {
+		fprintf(stderr, "can't open '%s'\n", out);
+		return 1;
+	}
+
+	const bool written = harness.writeJson(file);
+
+	if (out)
+		fclose(file);
+
+	return written ? 0 : 1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
@@ -17,6 +17,7 @@ struct LoggerInterfaceT {
 	using RegionID		 = ::hfsm2::RegionID;
 	using TransitionType = ::hfsm2::TransitionType;
 	using StatusEvent	 = ::hfsm2::StatusEvent;
+	using WatchdogEvent	 = ::hfsm2::WatchdogEvent;
 
 	virtual void recordMethod(Context& /*context*/,
 							  const StateID /*origin*/,
@@ -55,6 +56,14 @@ struct LoggerInterfaceT {
 										const StateID /*prong*/,
 										const Utilty /*utilty*/)
 	{}
+
+	// origin, target - the pair of states the machine oscillates between,
+	//					INVALID_STATE_ID for SUBSTITUTION_LIMIT
+	virtual void recordWatchdogEvent(Context& /*context*/,
+									 const WatchdogEvent /*event*/,
+									 const StateID /*origin*/,
+									 const StateID /*target*/)
+	{}
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -69,4 +78,70 @@ using LoggerInterfaceT = void;
 
 using LoggerInterface = LoggerInterfaceT<>;
 
+////////////////////////////////////////////////////////////////////////////////
+
+// Non-virtual logger policy with the same member functions as LoggerInterfaceT,
+//  select with ConfigT<>::LoggerT<EmptyLoggerT<..>>
+//  Custom policies can follow the same pattern and get their calls inlined
+
+template <typename TContext = EmptyContext,
+		  typename TUtilty = float>
+struct EmptyLoggerT {
+	using Context		 = TContext;
+	using Utilty		 = TUtilty;
+
+	using Method		 = ::hfsm2::Method;
+	using StateID		 = ::hfsm2::StateID;
+	using RegionID		 = ::hfsm2::RegionID;
+	using TransitionType = ::hfsm2::TransitionType;
+	using StatusEvent	 = ::hfsm2::StatusEvent;
+	using WatchdogEvent	 = ::hfsm2::WatchdogEvent;
+
+	HFSM_INLINE void recordMethod(Context& /*context*/,
+								  const StateID /*origin*/,
+								  const Method /*method*/)
+	{}
+
+	HFSM_INLINE void recordTransition(Context& /*context*/,
+									  const StateID /*origin*/,
+									  const TransitionType /*transitionType*/,
+									  const StateID /*target*/)
+	{}
+
+	HFSM_INLINE void recordTaskStatus(Context& /*context*/,
+									  const RegionID /*region*/,
+									  const StateID /*origin*/,
+									  const StatusEvent /*event*/)
+	{}
+
+	HFSM_INLINE void recordPlanStatus(Context& /*context*/,
+									  const RegionID /*region*/,
+									  const StatusEvent /*event*/)
+	{}
+
+	HFSM_INLINE void recordCancelledPending(Context& /*context*/,
+											const StateID /*origin*/)
+	{}
+
+	HFSM_INLINE void recordUtilityResolution(Context& /*context*/,
+											 const StateID /*head*/,
+											 const StateID /*prong*/,
+											 const Utilty /*utilty*/)
+	{}
+
+	HFSM_INLINE void recordRandomResolution(Context& /*context*/,
+											const StateID /*head*/,
+											const StateID /*prong*/,
+											const Utilty /*utilty*/)
+	{}
+
+	HFSM_INLINE void recordWatchdogEvent(Context& /*context*/,
+										 const WatchdogEvent /*event*/,
+										 const StateID /*origin*/,
+										 const StateID /*target*/)
+	{}
+};
+
+using EmptyLogger = EmptyLoggerT<>;
+
 }
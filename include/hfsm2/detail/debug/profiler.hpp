@@ -0,0 +1,148 @@
+#pragma once
+
+#ifdef HFSM_ENABLE_PROFILER
+
+namespace hfsm2 {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Timestamp source for the profiler
+//  CPU cycles (rdtsc) with HFSM_PROFILER_RDTSC defined, steady_clock nanoseconds otherwise
+
+struct ProfilerClock {
+	static HFSM_INLINE uint64_t now();
+};
+
+//------------------------------------------------------------------------------
+
+// Aggregated timings of a single state method
+//  Members:
+//   count		- Number of calls
+//   total		- Sum of call durations
+//   min, max	- Shortest and longest call durations
+//   histogram	- Bucket 0 counts calls shorter than 1 tick, bucket N - [2^(N-1), 2^N) ticks,
+//				  the last bucket collects everything longer
+
+struct ProfileEntry {
+	enum : unsigned { BUCKET_COUNT = 32 };
+
+	HFSM_INLINE void add(const uint64_t duration);
+
+	HFSM_INLINE uint64_t mean() const							{ return count ? total / count : 0;			}
+
+	uint64_t count = 0;
+	uint64_t total = 0;
+	uint64_t min = UINT64_MAX;
+	uint64_t max = 0;
+	uint32_t histogram[BUCKET_COUNT] = {};
+};
+
+//------------------------------------------------------------------------------
+
+// Single timed call, kept for the Chrome trace export
+
+struct ProfileEvent {
+	uint64_t start;
+	uint32_t duration;
+	StateID stateId;
+	Method method;
+};
+
+//------------------------------------------------------------------------------
+
+// Per-state, per-method timing profiler
+//  Attach with R_::attachProfiler(), state methods are timed at the same points
+//  they're logged by HFSM_ENABLE_LOG_INTERFACE
+
+template <LongIndex NStateCount>
+class ProfilerT {
+public:
+	static constexpr LongIndex STATE_COUNT  = NStateCount;
+	static constexpr LongIndex METHOD_COUNT = (LongIndex) Method::COUNT;
+
+	HFSM_INLINE void record(const StateID stateId,
+							const Method method,
+							const uint64_t start,
+							const uint64_t end);
+
+	HFSM_INLINE const ProfileEntry& entry(const StateID stateId,
+										  const Method method) const;
+
+	HFSM_INLINE void clear();
+
+	// Additionally keep individual calls in a ring buffer over 'events', needed for writeChromeTrace()
+	//  'capacity' must be a power of two
+	HFSM_INLINE void attachEvents(ProfileEvent* const events,
+								  const uint32_t capacity);
+
+	// Number of events currently held in the ring
+	HFSM_INLINE uint32_t eventCount() const;
+
+	// Write a text table of all called state methods to 'path'
+	//  'names' - optional state names, indexed by StateID
+	bool writeReport(const char* const path,
+					 const char* const* const names = nullptr) const;
+
+	// Write held events to 'path' in Chrome trace event format (chrome://tracing, Perfetto)
+	//  'ticksPerMicrosecond' - clock rate, 1000 for the default steady_clock
+	//  Returns false if no events were attached
+	bool writeChromeTrace(const char* const path,
+						  const char* const* const names = nullptr,
+						  const double ticksPerMicrosecond = 1000.0) const;
+
+private:
+	detail::StaticArray<ProfileEntry, STATE_COUNT * METHOD_COUNT> _entries;
+
+	ProfileEvent* _events = nullptr;
+	uint32_t _eventMask = 0;
+	uint32_t _eventHead = 0;
+	bool _eventsWrapped = false;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+// Times the enclosing scope, does nothing for states without a head
+
+template <typename TProfiler, bool NEnabled>
+struct ProfilerScope {
+	HFSM_INLINE ProfilerScope(TProfiler* const profiler_,
+							  const StateID stateId_,
+							  const Method method_)
+		: profiler{profiler_}
+		, start{profiler_ ? ProfilerClock::now() : 0}
+		, stateId{stateId_}
+		, method{method_}
+	{}
+
+	HFSM_INLINE ~ProfilerScope() {
+		if (profiler)
+			profiler->record(stateId, method, start, ProfilerClock::now());
+	}
+
+	TProfiler* const profiler;
+	const uint64_t start;
+	const StateID stateId;
+	const Method method;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TProfiler>
+struct ProfilerScope<TProfiler, false> {
+	HFSM_INLINE ProfilerScope(TProfiler* const,
+							  const StateID,
+							  const Method)
+	{}
+};
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+
+#include "profiler.inl"
+
+#endif
@@ -0,0 +1,200 @@
+namespace hfsm2 {
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline
+uint64_t
+ProfilerClock::now() {
+#if defined HFSM_PROFILER_RDTSC
+	return __rdtsc();
+#else
+	return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+						  std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline
+void
+ProfileEntry::add(const uint64_t duration) {
+	++count;
+	total += duration;
+
+	if (min > duration)
+		min = duration;
+
+	if (max < duration)
+		max = duration;
+
+	unsigned bucket = 0;
+	for (uint64_t d = duration; d && bucket < BUCKET_COUNT - 1; d >>= 1)
+		++bucket;
+
+	++histogram[bucket];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <LongIndex NSC>
+void
+ProfilerT<NSC>::record(const StateID stateId,
+					   const Method method,
+					   const uint64_t start,
+					   const uint64_t end)
+{
+	HFSM_ASSERT(stateId < STATE_COUNT);
+	HFSM_ASSERT(method  < Method::COUNT);
+
+	const uint64_t duration = end > start ? end - start : 0;
+
+	_entries[stateId * METHOD_COUNT + (LongIndex) method].add(duration);
+
+	if (_events) {
+		ProfileEvent& event = _events[_eventHead & _eventMask];
+		event.start	   = start;
+		event.duration = duration < UINT32_MAX ? (uint32_t) duration : UINT32_MAX;
+		event.stateId  = stateId;
+		event.method   = method;
+
+		if ((_eventHead & _eventMask) == _eventMask)
+			_eventsWrapped = true;
+
+		++_eventHead;
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NSC>
+const ProfileEntry&
+ProfilerT<NSC>::entry(const StateID stateId,
+					  const Method method) const
+{
+	HFSM_ASSERT(stateId < STATE_COUNT);
+	HFSM_ASSERT(method  < Method::COUNT);
+
+	return _entries[stateId * METHOD_COUNT + (LongIndex) method];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NSC>
+void
+ProfilerT<NSC>::clear() {
+	_entries.fill(ProfileEntry{});
+
+	_eventHead = 0;
+	_eventsWrapped = false;
+}
+
+//------------------------------------------------------------------------------
+
+template <LongIndex NSC>
+void
+ProfilerT<NSC>::attachEvents(ProfileEvent* const events,
+							 const uint32_t capacity)
+{
+	HFSM_ASSERT(!events || (capacity && (capacity & (capacity - 1)) == 0));
+
+	_events	   = events;
+	_eventMask = events ? capacity - 1 : 0;
+	_eventHead = 0;
+	_eventsWrapped = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NSC>
+uint32_t
+ProfilerT<NSC>::eventCount() const {
+	return !_events		  ? 0 :
+		   _eventsWrapped ? _eventMask + 1 : _eventHead;
+}
+
+//------------------------------------------------------------------------------
+
+template <LongIndex NSC>
+bool
+ProfilerT<NSC>::writeReport(const char* const path,
+							const char* const* const names) const
+{
+	FILE* const file = fopen(path, "w");
+	if (!file)
+		return false;
+
+	fprintf(file, "%-32s %-14s %12s %14s %10s %10s %10s  histogram (log2 bucket:count)\n",
+			"state", "method", "count", "total", "min", "mean", "max");
+
+	for (LongIndex s = 0; s < STATE_COUNT; ++s)
+		for (LongIndex m = 0; m < METHOD_COUNT; ++m) {
+			const ProfileEntry& e = _entries[s * METHOD_COUNT + m];
+
+			if (e.count) {
+				if (names && names[s])
+					fprintf(file, "%-32s ", names[s]);
+				else
+					fprintf(file, "%-32u ", (unsigned) s);
+
+				fprintf(file, "%-14s %12llu %14llu %10llu %10llu %10llu ",
+						methodName((Method) m),
+						(unsigned long long) e.count,
+						(unsigned long long) e.total,
+						(unsigned long long) e.min,
+						(unsigned long long) e.mean(),
+						(unsigned long long) e.max);
+
+				for (unsigned b = 0; b < ProfileEntry::BUCKET_COUNT; ++b)
+					if (e.histogram[b])
+						fprintf(file, " %u:%u", b, (unsigned) e.histogram[b]);
+
+				fprintf(file, "\n");
+			}
+		}
+
+	return fclose(file) == 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NSC>
+bool
+ProfilerT<NSC>::writeChromeTrace(const char* const path,
+								 const char* const* const names,
+								 const double ticksPerMicrosecond) const
+{
+	if (!_events)
+		return false;
+
+	FILE* const file = fopen(path, "w");
+	if (!file)
+		return false;
+
+	const uint32_t count = eventCount();
+	const uint32_t first = _eventHead - count;
+
+	fprintf(file, "{\"traceEvents\":[");
+
+	for (uint32_t i = 0; i < count; ++i) {
+		const ProfileEvent& event = _events[(first + i) & _eventMask];
+
+		fprintf(file, i ? ",\n" : "\n");
+
+		if (names && names[event.stateId])
+			fprintf(file, "{\"name\":\"%s::%s\"", names[event.stateId], methodName(event.method));
+		else
+			fprintf(file, "{\"name\":\"%u::%s\"", (unsigned) event.stateId, methodName(event.method));
+
+		fprintf(file, ",\"cat\":\"hfsm2\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":0}",
+				event.start	   / ticksPerMicrosecond,
+				event.duration / ticksPerMicrosecond);
+	}
+
+	fprintf(file, "\n]}\n");
+
+	return fclose(file) == 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -42,6 +42,13 @@ enum class StatusEvent : uint8_t {
 	COUNT
 };
 
+enum class WatchdogEvent : uint8_t {
+	SUBSTITUTION_LIMIT,
+	OSCILLATION,
+
+	COUNT
+};
+
 //------------------------------------------------------------------------------
 
 static inline
@@ -113,6 +120,21 @@ transitionName(const TransitionType transitionType) {
 	}
 }
 
+//------------------------------------------------------------------------------
+
+static inline
+const char*
+watchdogEventName(const WatchdogEvent event) {
+	switch (event) {
+	case WatchdogEvent::SUBSTITUTION_LIMIT:	return "substitutionLimit";
+	case WatchdogEvent::OSCILLATION:		return "oscillation";
+
+	default:
+		HFSM_BREAK();
+		return nullptr;
+	}
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 }
@@ -0,0 +1,79 @@
+#pragma once
+
+#ifdef HFSM_ENABLE_STATISTICS
+
+namespace hfsm2 {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Operational counters of a single machine instance
+//  Attach with R_::attachStatistics(), one per instance
+//  Time is measured in ticks - update() / react() calls of the attached machine
+//  Trivially copyable, so a snapshot is a plain copy
+//  merge() aggregates instances of a pool
+
+template <LongIndex NStateCount>
+class StatisticsT {
+public:
+	static constexpr LongIndex STATE_COUNT = NStateCount;
+
+	// Applied transitions, origin INVALID_STATE_ID stands for requests made from outside the machine
+	HFSM_INLINE uint32_t transitions(const StateID origin,
+									 const StateID destination) const;
+
+	// Transitions into 'destination' cancelled by guards
+	HFSM_INLINE uint32_t cancelled(const StateID destination) const;
+
+	// Number of times the state was activated
+	HFSM_INLINE uint32_t visits(const StateID stateId) const;
+
+	// Ticks spent in the state, including the ongoing visit
+	HFSM_INLINE uint64_t dwell(const StateID stateId) const;
+
+	HFSM_INLINE uint32_t tick() const							{ return _tick;								}
+
+	void merge(const StatisticsT& other);
+
+	// Reset counters, keep tracking ongoing visits from the current tick
+	void clear();
+
+	// Write non-zero transition counts and per-state dwell times to 'path' as CSV
+	//  'names' - optional state names, indexed by StateID
+	bool writeCsv(const char* const path,
+				  const char* const* const names = nullptr) const;
+
+	//----------------------------------------------------------------------
+
+	HFSM_INLINE void advance()									{ ++_tick;									}
+
+	HFSM_INLINE void recordTransition(const StateID origin,
+									  const StateID destination);
+
+	HFSM_INLINE void recordCancelled (const StateID destination);
+
+	HFSM_INLINE void recordEnter(const StateID stateId);
+	HFSM_INLINE void recordExit (const StateID stateId);
+
+private:
+	struct Activity {
+		uint64_t dwell = 0;
+		uint32_t enteredAt = 0;
+		uint32_t visits = 0;
+		uint32_t cancelled = 0;
+		bool active = false;
+	};
+
+	// STATE_COUNT + 1 rows, the last one for external requests
+	detail::StaticArray<uint32_t, (STATE_COUNT + 1) * STATE_COUNT> _transitions{0u};
+	detail::StaticArray<Activity, STATE_COUNT> _activities;
+
+	uint32_t _tick = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+
+#include "statistics.inl"
+
+#endif
@@ -0,0 +1,188 @@
+namespace hfsm2 {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <LongIndex NSC>
+uint32_t
+StatisticsT<NSC>::transitions(const StateID origin,
+							  const StateID destination) const
+{
+	HFSM_ASSERT(origin < STATE_COUNT || origin == INVALID_STATE_ID);
+	HFSM_ASSERT(destination < STATE_COUNT);
+
+	const LongIndex row = origin < STATE_COUNT ? origin : STATE_COUNT;
+
+	return _transitions[row * STATE_COUNT + destination];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NSC>
+uint32_t
+StatisticsT<NSC>::cancelled(const StateID destination) const {
+	HFSM_ASSERT(destination < STATE_COUNT);
+
+	return _activities[destination].cancelled;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NSC>
+uint32_t
+StatisticsT<NSC>::visits(const StateID stateId) const {
+	HFSM_ASSERT(stateId < STATE_COUNT);
+
+	return _activities[stateId].visits;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NSC>
+uint64_t
+StatisticsT<NSC>::dwell(const StateID stateId) const {
+	HFSM_ASSERT(stateId < STATE_COUNT);
+
+	const Activity& activity = _activities[stateId];
+
+	return activity.active ?
+		activity.dwell + (_tick - activity.enteredAt) :
+		activity.dwell;
+}
+
+//------------------------------------------------------------------------------
+
+template <LongIndex NSC>
+void
+StatisticsT<NSC>::merge(const StatisticsT& other) {
+	for (LongIndex i = 0; i < _transitions.count(); ++i)
+		_transitions[i] += other._transitions[i];
+
+	for (StateID s = 0; s < STATE_COUNT; ++s) {
+		Activity& activity = _activities[s];
+		const Activity& source = other._activities[s];
+
+		activity.dwell	   += other.dwell(s);
+		activity.visits	   += source.visits;
+		activity.cancelled += source.cancelled;
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NSC>
+void
+StatisticsT<NSC>::clear() {
+	_transitions.fill(0u);
+
+	for (StateID s = 0; s < STATE_COUNT; ++s) {
+		Activity& activity = _activities[s];
+
+		activity.dwell	   = 0;
+		activity.enteredAt = _tick;
+		activity.visits	   = 0;
+		activity.cancelled = 0;
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NSC>
+bool
+StatisticsT<NSC>::writeCsv(const char* const path,
+						   const char* const* const names) const
+{
+	FILE* const file = fopen(path, "w");
+	if (!file)
+		return false;
+
+	const auto writeName = [&](const StateID s) {
+		if (s == INVALID_STATE_ID)
+			fprintf(file, "external,");
+		else if (names && names[s])
+			fprintf(file, "%s,", names[s]);
+		else
+			fprintf(file, "%u,", (unsigned) s);
+	};
+
+	fprintf(file, "origin,destination,transitions\n");
+
+	for (LongIndex o = 0; o <= STATE_COUNT; ++o)
+		for (StateID d = 0; d < STATE_COUNT; ++d)
+			if (const uint32_t count = _transitions[o * STATE_COUNT + d]) {
+				writeName(o < STATE_COUNT ? (StateID) o : INVALID_STATE_ID);
+				writeName(d);
+				fprintf(file, "%u\n", (unsigned) count);
+			}
+
+	fprintf(file, "\nstate,visits,dwell,cancelled\n");
+
+	for (StateID s = 0; s < STATE_COUNT; ++s) {
+		writeName(s);
+		fprintf(file, "%u,%llu,%u\n",
+				(unsigned) _activities[s].visits,
+				(unsigned long long) dwell(s),
+				(unsigned) _activities[s].cancelled);
+	}
+
+	return fclose(file) == 0;
+}
+
+//------------------------------------------------------------------------------
+
+template <LongIndex NSC>
+void
+StatisticsT<NSC>::recordTransition(const StateID origin,
+								   const StateID destination)
+{
+	HFSM_ASSERT(origin < STATE_COUNT || origin == INVALID_STATE_ID);
+	HFSM_ASSERT(destination < STATE_COUNT);
+
+	const LongIndex row = origin < STATE_COUNT ? origin : STATE_COUNT;
+
+	++_transitions[row * STATE_COUNT + destination];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NSC>
+void
+StatisticsT<NSC>::recordCancelled(const StateID destination) {
+	HFSM_ASSERT(destination < STATE_COUNT);
+
+	++_activities[destination].cancelled;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NSC>
+void
+StatisticsT<NSC>::recordEnter(const StateID stateId) {
+	HFSM_ASSERT(stateId < STATE_COUNT);
+
+	Activity& activity = _activities[stateId];
+
+	if (!activity.active) {
+		activity.enteredAt = _tick;
+		activity.active	   = true;
+		++activity.visits;
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NSC>
+void
+StatisticsT<NSC>::recordExit(const StateID stateId) {
+	HFSM_ASSERT(stateId < STATE_COUNT);
+
+	Activity& activity = _activities[stateId];
+
+	if (activity.active) {
+		activity.dwell += _tick - activity.enteredAt;
+		activity.active = false;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -54,10 +54,11 @@ struct alignas(alignof(void*)) StructureStateInfo {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-#ifdef HFSM_ENABLE_TRANSITION_HISTORY
+#if defined HFSM_ENABLE_TRANSITION_HISTORY || defined HFSM_ENABLE_TRANSITION_TRACE
 
+inline
 TransitionType
-HFSM_INLINE convert(const Request::Type type) {
+convert(const Request::Type type) {
 	switch (type) {
 		case Request::CHANGE:
 			return TransitionType::CHANGE;
@@ -85,8 +86,9 @@ HFSM_INLINE convert(const Request::Type type) {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+inline
 Request::Type
-HFSM_INLINE convert(const TransitionType type) {
+convert(const TransitionType type) {
 	switch (type) {
 	case TransitionType::CHANGE:
 		return Request::CHANGE;
@@ -155,7 +157,9 @@ struct alignas(4) Transition {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-bool operator == (const Transition& l, const Transition& r) {
+inline
+bool
+operator == (const Transition& l, const Transition& r) {
 	return l.stateId		== r.stateId
 		&& l.method			== r.method
 		&& l.transitionType	== r.transitionType;
@@ -0,0 +1,176 @@
+#pragma once
+
+#ifdef HFSM_ENABLE_TRANSITION_TRACE
+
+namespace hfsm2 {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Single trace entry, one per request processed by a machine
+//  Members:
+//   tick			- Value of the machine's update() / react() counter
+//   instance		- Id passed to attachTrace(), tells machines sharing a trace apart
+//   origin			- State that issued the request, INVALID_STATE_ID for external requests
+//   target			- Destination state
+//   transitionType	- Type of the request
+//   method			- NONE if the transition was applied,
+//					  ENTRY_GUARD / EXIT_GUARD if it was cancelled by the respective guard
+
+struct alignas(4) TraceRecord {
+	uint32_t tick;
+	uint16_t instance;
+	StateID origin;
+	StateID target;
+	TransitionType transitionType;
+	Method method;
+};
+
+static_assert(sizeof(TraceRecord) == 12, "TraceRecord layout is a part of the trace file format");
+
+//------------------------------------------------------------------------------
+
+// Header written by TransitionTrace::flush(), followed by 'count' records
+
+struct TraceHeader {
+	enum : uint32_t { MAGIC	  = 0x52544648 }; // 'HFTR'
+	enum : uint16_t { VERSION = 1 };
+
+	uint32_t magic;
+	uint16_t version;
+	uint16_t recordSize;
+	uint64_t count;
+};
+
+static_assert(sizeof(TraceHeader) == 16, "TraceHeader layout is a part of the trace file format");
+
+//------------------------------------------------------------------------------
+
+// Ring buffer slot, the record is kept in relaxed atomic words
+//  'stamp' is odd while record() is writing the slot and even once it's written,
+//  telling flush() if the record changed while it was being copied
+
+struct TraceSlot {
+	enum : uint32_t { WORDS = sizeof(TraceRecord) / sizeof(uint32_t) };
+
+	std::atomic<uint32_t> stamp{0};
+	std::atomic<uint32_t> words[WORDS];
+};
+
+static_assert(sizeof(TraceRecord) % sizeof(uint32_t) == 0, "TraceRecord needs to fit TraceSlot words");
+
+//------------------------------------------------------------------------------
+
+// Ring buffer of trace records over external storage
+//  Intended to be used one per thread, shared by all the machines updated on it
+//  Recording is wait-free, flush() may be called from a different thread,
+//  records overwritten while flush() copies them are left out
+
+class TransitionTrace {
+public:
+	// 'capacity' must be a power of two
+	HFSM_INLINE TransitionTrace(TraceSlot* const slots,
+								const uint32_t capacity);
+
+	HFSM_INLINE void record(const TraceRecord& record);
+
+	HFSM_INLINE uint32_t capacity() const						{ return _mask + 1;							}
+
+	// Number of records currently held in the ring
+	HFSM_INLINE uint32_t count() const;
+
+	// Size of the buffer needed by flush() to write out all held records
+	HFSM_INLINE size_t flushSize() const;
+
+	// Write the header followed by held records in chronological order into 'buffer'
+	//  (e.g. a memory-mapped file view), return the number of bytes written,
+	//  or 0 if 'size' can't fit the header
+	size_t flush(void* const buffer,
+				 const size_t size) const;
+
+	HFSM_INLINE void clear();
+
+private:
+	// 'stamp' of the slot holding record number 'n' once it's written
+	static HFSM_INLINE uint32_t writtenStamp(const uint32_t n)	{ return 2 * n + 2;							}
+
+private:
+	TraceSlot* const _slots;
+	const uint32_t _mask;
+
+	std::atomic<uint32_t> _head{0};
+	std::atomic<bool> _wrapped{false};
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <uint32_t NCapacity>
+class TransitionTraceT
+	: public TransitionTrace
+{
+	static_assert(NCapacity && (NCapacity & (NCapacity - 1)) == 0, "Trace capacity needs to be a power of two");
+
+public:
+	HFSM_INLINE TransitionTraceT()
+		: TransitionTrace{_storage, NCapacity}
+	{}
+
+private:
+	TraceSlot _storage[NCapacity];
+};
+
+//------------------------------------------------------------------------------
+
+// Read-only view of a buffer written by TransitionTrace::flush()
+
+class TraceReader {
+public:
+	HFSM_INLINE TraceReader(const void* const data,
+							const size_t size);
+
+	HFSM_INLINE bool valid() const								{ return _records != nullptr;				}
+
+	HFSM_INLINE uint64_t count() const							{ return _count;							}
+	HFSM_INLINE const TraceRecord* records() const				{ return _records;							}
+
+	HFSM_INLINE const TraceRecord& operator[] (const uint64_t i) const;
+
+private:
+	const TraceRecord* _records = nullptr;
+	uint64_t _count = 0;
+};
+
+//------------------------------------------------------------------------------
+
+#ifdef HFSM_ENABLE_TRANSITION_HISTORY
+
+// Re-apply the transitions recorded for machine 'instance' via replayTransitions(),
+//  one call per recorded tick, cancelled transitions are skipped
+//  'machine' needs to start from the same state the traced one started from
+//  Returns the number of transitions replayed
+
+template <typename TMachine>
+uint64_t
+replayTrace(TMachine& machine,
+			const TraceRecord* const records,
+			const uint64_t count,
+			const uint16_t instance = 0);
+
+template <typename TMachine>
+HFSM_INLINE
+uint64_t
+replayTrace(TMachine& machine,
+			const TraceReader& reader,
+			const uint16_t instance = 0)
+{
+	return replayTrace(machine, reader.records(), reader.count(), instance);
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+
+#include "transition_trace.inl"
+
+#endif
@@ -0,0 +1,195 @@
+namespace hfsm2 {
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline
+TransitionTrace::TransitionTrace(TraceSlot* const slots,
+								 const uint32_t capacity)
+	: _slots{slots}
+	, _mask{capacity - 1}
+{
+	HFSM_ASSERT(slots);
+	HFSM_ASSERT(capacity && (capacity & (capacity - 1)) == 0);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+inline
+void
+TransitionTrace::record(const TraceRecord& record) {
+	const uint32_t head = _head.load(std::memory_order_relaxed);
+	TraceSlot& slot = _slots[head & _mask];
+
+	uint32_t words[TraceSlot::WORDS];
+	memcpy(words, &record, sizeof(TraceRecord));
+
+	// the odd stamp has to be visible before any of the new words
+	slot.stamp.store(writtenStamp(head) - 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	for (uint32_t w = 0; w < TraceSlot::WORDS; ++w)
+		slot.words[w].store(words[w], std::memory_order_relaxed);
+
+	slot.stamp.store(writtenStamp(head), std::memory_order_release);
+
+	if ((head & _mask) == _mask)
+		_wrapped.store(true, std::memory_order_relaxed);
+
+	_head.store(head + 1, std::memory_order_release);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+inline
+uint32_t
+TransitionTrace::count() const {
+	const uint32_t head = _head.load(std::memory_order_acquire);
+
+	return _wrapped.load(std::memory_order_relaxed) ? capacity() : head;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+inline
+size_t
+TransitionTrace::flushSize() const {
+	return sizeof(TraceHeader) + sizeof(TraceRecord) * count();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+inline
+size_t
+TransitionTrace::flush(void* const buffer,
+					   const size_t size) const
+{
+	if (!HFSM_CHECKED(buffer) || size < sizeof(TraceHeader))
+		return 0;
+
+	const uint32_t head = _head.load(std::memory_order_acquire);
+	const uint32_t held = _wrapped.load(std::memory_order_relaxed) ? capacity() : head;
+	const uint32_t fits = (uint32_t) ((size - sizeof(TraceHeader)) / sizeof(TraceRecord));
+
+	const uint32_t taken = held < fits ? held : fits;
+	const uint32_t first = head - taken;
+
+	char* const records = static_cast<char*>(buffer) + sizeof(TraceHeader);
+	uint32_t count = 0;
+
+	for (uint32_t n = first; n != head; ++n) {
+		const TraceSlot& slot = _slots[n & _mask];
+
+		// already overwritten by newer records
+		const uint32_t stamp = slot.stamp.load(std::memory_order_acquire);
+		if (stamp != writtenStamp(n))
+			continue;
+
+		uint32_t words[TraceSlot::WORDS];
+		for (uint32_t w = 0; w < TraceSlot::WORDS; ++w)
+			words[w] = slot.words[w].load(std::memory_order_relaxed);
+
+		// overwritten while copying
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot.stamp.load(std::memory_order_relaxed) != stamp)
+			continue;
+
+		memcpy(records + sizeof(TraceRecord) * count++, words, sizeof(TraceRecord));
+	}
+
+	TraceHeader header;
+	header.magic	  = TraceHeader::MAGIC;
+	header.version	  = TraceHeader::VERSION;
+	header.recordSize = (uint16_t) sizeof(TraceRecord);
+	header.count	  = count;
+
+	memcpy(buffer, &header, sizeof(TraceHeader));
+
+	return sizeof(TraceHeader) + sizeof(TraceRecord) * count;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+inline
+void
+TransitionTrace::clear() {
+	_wrapped.store(false, std::memory_order_relaxed);
+	_head	.store(0,	  std::memory_order_release);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline
+TraceReader::TraceReader(const void* const data,
+						 const size_t size)
+{
+	if (HFSM_CHECKED(data) && size >= sizeof(TraceHeader)) {
+		TraceHeader header;
+		memcpy(&header, data, sizeof(TraceHeader));
+
+		if (header.magic	  == TraceHeader::MAGIC	  &&
+			header.version	  == TraceHeader::VERSION &&
+			header.recordSize == sizeof(TraceRecord)  &&
+			header.count	  <= (size - sizeof(TraceHeader)) / sizeof(TraceRecord))
+		{
+			_records = reinterpret_cast<const TraceRecord*>(static_cast<const char*>(data) + sizeof(TraceHeader));
+			_count	 = header.count;
+		}
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+inline
+const TraceRecord&
+TraceReader::operator[] (const uint64_t i) const {
+	HFSM_ASSERT(i < _count);
+
+	return _records[i];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef HFSM_ENABLE_TRANSITION_HISTORY
+
+template <typename TMachine>
+uint64_t
+replayTrace(TMachine& machine,
+			const TraceRecord* const records,
+			const uint64_t count,
+			const uint16_t instance)
+{
+	using Transitions = typename TMachine::TransitionHistory;
+
+	Transitions transitions;
+	uint32_t tick = 0;
+	uint64_t replayed = 0;
+
+	for (uint64_t i = 0; i < count; ++i) {
+		const TraceRecord& record = records[i];
+
+		if (record.instance != instance || record.method != Method::NONE)
+			continue;
+
+		if (transitions.count() &&
+			(record.tick != tick || transitions.count() == Transitions::CAPACITY))
+		{
+			machine.replayTransitions(&transitions[0], transitions.count());
+			transitions.clear();
+		}
+
+		tick = record.tick;
+		transitions.append(Transition{record.target, Method::NONE, record.transitionType});
+		++replayed;
+	}
+
+	if (transitions.count())
+		machine.replayTransitions(&transitions[0], transitions.count());
+
+	return replayed;
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
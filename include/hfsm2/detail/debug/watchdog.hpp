@@ -0,0 +1,80 @@
+#pragma once
+
+#ifdef HFSM_ENABLE_WATCHDOG
+
+namespace hfsm2 {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Counters of pathological transition patterns, see R_::watchdogReport()
+//  Members:
+//   ticks				- Number of update() / react() calls
+//   calls				- Number of calls that processed transitions
+//   rounds				- Substitution rounds over all calls
+//   maxRounds			- Most substitution rounds within a single call
+//   limitHits			- Calls that ran out of substitution rounds with requests still pending
+//   oscillations		- Transitions reverting an earlier one (A -> B -> A)
+//						  within Watchdog::WINDOW ticks
+//   oscillationOrigin,
+//   oscillationTarget	- States of the latest oscillating transition
+
+struct WatchdogReport {
+	uint32_t ticks = 0;
+	uint32_t calls = 0;
+	uint32_t rounds = 0;
+	uint32_t maxRounds = 0;
+	uint32_t limitHits = 0;
+	uint32_t oscillations = 0;
+
+	StateID oscillationOrigin = INVALID_STATE_ID;
+	StateID oscillationTarget = INVALID_STATE_ID;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+class Watchdog {
+public:
+	// Sliding window for oscillation detection, in ticks
+	enum : uint32_t { WINDOW = 4 };
+
+	HFSM_INLINE void tick()										{ ++_report.ticks;							}
+
+	// Returns true if the substitution limit was hit
+	HFSM_INLINE bool recordRounds(const LongIndex rounds,
+								  const bool requestsPending);
+
+	// Returns true if the transition reverts a recent one
+	HFSM_INLINE bool recordTransition(const StateID origin,
+									  const StateID target);
+
+	HFSM_INLINE const WatchdogReport& report() const			{ return _report;							}
+
+	HFSM_INLINE void reset();
+
+private:
+	struct Recent {
+		uint32_t tick;
+		StateID origin;
+		StateID target;
+	};
+
+	enum : unsigned { RECENT_CAPACITY = 8 };
+
+	WatchdogReport _report;
+
+	Recent _recent[RECENT_CAPACITY];
+	unsigned _recentCount = 0;
+	unsigned _recentHead = 0;
+};
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+
+#include "watchdog.inl"
+
+#endif
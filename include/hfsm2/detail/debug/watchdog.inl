@@ -0,0 +1,76 @@
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline
+bool
+Watchdog::recordRounds(const LongIndex rounds,
+					   const bool requestsPending)
+{
+	++_report.calls;
+	_report.rounds += rounds;
+
+	if (_report.maxRounds < rounds)
+		_report.maxRounds = rounds;
+
+	if (requestsPending)
+		++_report.limitHits;
+
+	return requestsPending;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+inline
+bool
+Watchdog::recordTransition(const StateID origin,
+						   const StateID target)
+{
+	if (origin == INVALID_STATE_ID || origin == target)
+		return false;
+
+	bool oscillating = false;
+
+	for (unsigned i = 0; i < _recentCount; ++i) {
+		const Recent& recent = _recent[i];
+
+		if (recent.origin == target &&
+			recent.target == origin &&
+			_report.ticks - recent.tick <= WINDOW)
+		{
+			oscillating = true;
+			break;
+		}
+	}
+
+	if (oscillating) {
+		++_report.oscillations;
+		_report.oscillationOrigin = origin;
+		_report.oscillationTarget = target;
+	}
+
+	_recent[_recentHead] = Recent{_report.ticks, origin, target};
+	_recentHead = (_recentHead + 1) % RECENT_CAPACITY;
+
+	if (_recentCount < RECENT_CAPACITY)
+		++_recentCount;
+
+	return oscillating;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+inline
+void
+Watchdog::reset() {
+	_report = WatchdogReport{};
+
+	_recentCount = 0;
+	_recentHead	 = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
@@ -0,0 +1,183 @@
+#pragma once
+
+#ifdef HFSM_ENABLE_POOL
+
+namespace hfsm2 {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Default time source for PoolT::updateFor(), steady_clock nanoseconds
+//  Any type with 'static uint64_t now()' can replace it, e.g. one reading rdtsc
+
+struct PoolClock {
+	static HFSM_INLINE uint64_t now();
+};
+
+//------------------------------------------------------------------------------
+
+// Visiting orders for PoolT::updateFor()
+//  RoundRobinOrder	- resume from the first machine left out by the previous call
+//  StarvationOrder	- machines that waited longest go first
+//  Custom orders provide
+//   'float operator()(const uint32_t handle, const Instance& machine, const uint32_t staleness) const',
+//   higher values are updated first, e.g. inverse camera distance for LOD
+
+struct RoundRobinOrder {};
+
+struct StarvationOrder {
+	template <typename TInstance>
+	HFSM_INLINE float operator() (const uint32_t /*handle*/,
+								  const TInstance& /*machine*/,
+								  const uint32_t staleness) const	{ return (float) staleness;				}
+};
+
+//------------------------------------------------------------------------------
+
+// Scheduler for a pool of machines of the same type, available with HFSM_ENABLE_POOL
+//  Machines are owned by the caller and registered with add()
+//  Only awake machines are updated, a machine goes dormant once
+//  R_::needsUpdate() reports it has nothing left to do,
+//  and wakes up on react() through the pool, or on wake() / refresh()
+//  Storage is sized by 'NCapacity', large pools are best allocated on the heap
+//  Staleness counts pool updates since the machine was last updated
+//  With HFSM_ENABLE_POOL_INDEX, the pool also keeps a list of machines per active state,
+//  updated only for the states a machine entered or exited, see R_::activityChanges(),
+//  memory use is 'NCapacity * STATE_COUNT * 8' bytes
+
+template <typename TInstance,
+		  uint32_t NCapacity,
+		  typename TClock = PoolClock>
+class PoolT {
+public:
+	using Instance = TInstance;
+	using Handle   = uint32_t;
+	using Clock	   = TClock;
+
+	static constexpr uint32_t CAPACITY		 = NCapacity;
+	static constexpr Handle	  INVALID_HANDLE = (Handle) -1;
+
+#ifdef HFSM_ENABLE_POOL_INDEX
+	static constexpr LongIndex STATE_COUNT	 = Instance::STATE_COUNT;
+
+	struct Members {
+		HFSM_INLINE const Handle* begin() const							{ return first;							}
+		HFSM_INLINE const Handle* end()	const							{ return first + size;					}
+
+		HFSM_INLINE uint32_t count() const								{ return size;							}
+
+		const Handle* first;
+		uint32_t size;
+	};
+#endif
+
+	HFSM_INLINE PoolT();
+
+	// Register 'machine', returns INVALID_HANDLE if the pool is full
+	HFSM_INLINE Handle add(Instance& machine);
+	HFSM_INLINE void remove(const Handle handle);
+
+	HFSM_INLINE		  Instance& operator[] (const Handle handle)		{ return *_machines[handle];			}
+	HFSM_INLINE const Instance& operator[] (const Handle handle) const	{ return *_machines[handle];			}
+
+	HFSM_INLINE uint32_t count() const									{ return _count;						}
+	HFSM_INLINE uint32_t awakeCount() const								{ return _awakeCount;					}
+
+	HFSM_INLINE bool isAwake(const Handle handle) const;
+
+	// Pool updates since the machine's last update, 1 for a machine updated every time
+	//  Stays at the pre-update value while the machine itself is being updated
+	HFSM_INLINE uint32_t staleness(const Handle handle) const;
+
+	// Machine being updated right now, INVALID_HANDLE outside of update() / updateFor()
+	HFSM_INLINE Handle current() const									{ return _current;						}
+
+#ifdef HFSM_ENABLE_POOL_INDEX
+	// Machines with the state active, in no particular order
+	//  Invalidated by any pool call that can change a machine
+	HFSM_INLINE Members inState(const StateID stateId) const;
+
+	template <typename TState>
+	HFSM_INLINE Members inState() const			{ return inState(Instance::template stateId<TState>());	}
+#endif
+
+	// Update awake machines, putting idle ones to sleep
+	HFSM_INLINE void update();
+
+	// Update awake machines in 'order' until 'budget' clock ticks are spent,
+	//  returns the number of machines updated
+	//  The clock is sampled after every 'checkInterval' machines,
+	//  so the budget can be overrun by up to 'checkInterval - 1' updates
+	template <typename TOrder = RoundRobinOrder>
+	HFSM_INLINE uint32_t updateFor(const uint64_t budget,
+								   const TOrder& order = TOrder{},
+								   const uint32_t checkInterval = 8);
+
+	// React on a single machine, waking it if needed
+	template <typename TEvent>
+	HFSM_INLINE void react(const Handle handle,
+						   const TEvent& event);
+
+	// React on every registered machine
+	template <typename TEvent>
+	HFSM_INLINE void react(const TEvent& event);
+
+	// Keep the machine awake until its next update()
+	HFSM_INLINE void wake(const Handle handle);
+
+	// Re-check the machine after changing it outside of the pool, e.g. after changeTo()
+	HFSM_INLINE void refresh(const Handle handle);
+
+private:
+	HFSM_INLINE void sleep(const Handle handle);
+
+	// Update a single machine, returns false if it went to sleep
+	HFSM_INLINE bool updateMachine(const Handle handle);
+
+	HFSM_INLINE void arrange(const RoundRobinOrder& order);
+
+	template <typename TOrder>
+	HFSM_INLINE void arrange(const TOrder& order);
+
+#ifdef HFSM_ENABLE_POOL_INDEX
+	HFSM_INLINE void reindex(const Handle handle);
+	HFSM_INLINE void rescan(const Handle handle);
+	HFSM_INLINE void relist(const Handle handle, const StateID stateId);
+	HFSM_INLINE void enlist(const Handle handle, const StateID stateId);
+	HFSM_INLINE void delist(const Handle handle, const StateID stateId);
+#endif
+
+private:
+	Instance* _machines[CAPACITY];
+	uint32_t _awakeIndices[CAPACITY];		// position in '_awake', INVALID_HANDLE if dormant
+	uint32_t _lastUpdates[CAPACITY];		// '_tick' of the last update
+
+	Handle _order[CAPACITY];				// visiting order of the current updateFor()
+	float _priorities[CAPACITY];
+
+	Handle _awake[CAPACITY];
+	uint32_t _awakeCount = 0;
+
+	Handle _free[CAPACITY];
+	uint32_t _freeCount = 0;
+
+	uint32_t _used = 0;						// high-water mark of handles
+	uint32_t _count = 0;
+
+	uint32_t _tick = 0;
+	uint32_t _cursor = 0;					// RoundRobinOrder start, position in '_awake'
+	Handle _current = INVALID_HANDLE;
+
+#ifdef HFSM_ENABLE_POOL_INDEX
+	Handle _members[STATE_COUNT * CAPACITY];		// per-state lists, 'CAPACITY' slots each
+	uint32_t _memberCounts[STATE_COUNT];
+	uint32_t _positions[CAPACITY * STATE_COUNT];	// position in the state's list, INVALID_HANDLE if absent
+#endif
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+
+#include "pool.inl"
+
+#endif
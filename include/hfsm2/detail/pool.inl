@@ -0,0 +1,374 @@
+namespace hfsm2 {
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline
+uint64_t
+PoolClock::now() {
+	return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+						  std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TI, uint32_t NC, typename TC>
+PoolT<TI, NC, TC>::PoolT() {
+	for (uint32_t i = 0; i < CAPACITY; ++i) {
+		_machines[i]	 = nullptr;
+		_awakeIndices[i] = INVALID_HANDLE;
+		_lastUpdates[i]	 = 0;
+	}
+
+#ifdef HFSM_ENABLE_POOL_INDEX
+	for (StateID s = 0; s < STATE_COUNT; ++s)
+		_memberCounts[s] = 0;
+
+	for (uint32_t i = 0; i < CAPACITY * STATE_COUNT; ++i)
+		_positions[i] = INVALID_HANDLE;
+#endif
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TI, uint32_t NC, typename TC>
+typename PoolT<TI, NC, TC>::Handle
+PoolT<TI, NC, TC>::add(Instance& machine) {
+	Handle handle;
+
+	if (_freeCount)
+		handle = _free[--_freeCount];
+	else if (_used < CAPACITY)
+		handle = _used++;
+	else
+		return INVALID_HANDLE;
+
+	_machines[handle] = &machine;
+	_lastUpdates[handle] = _tick;
+	++_count;
+
+	HFSM_IF_POOL_INDEX(rescan(handle));
+
+	refresh(handle);
+
+	return handle;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TI, uint32_t NC, typename TC>
+void
+PoolT<TI, NC, TC>::remove(const Handle handle) {
+	HFSM_ASSERT(handle < _used && _machines[handle]);
+
+	sleep(handle);
+
+#ifdef HFSM_ENABLE_POOL_INDEX
+	for (StateID s = 0; s < STATE_COUNT; ++s)
+		if (_positions[handle * STATE_COUNT + s] != INVALID_HANDLE)
+			delist(handle, s);
+#endif
+
+	_machines[handle] = nullptr;
+	_free[_freeCount++] = handle;
+	--_count;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TI, uint32_t NC, typename TC>
+bool
+PoolT<TI, NC, TC>::isAwake(const Handle handle) const {
+	HFSM_ASSERT(handle < CAPACITY);
+
+	return _awakeIndices[handle] != INVALID_HANDLE;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TI, uint32_t NC, typename TC>
+uint32_t
+PoolT<TI, NC, TC>::staleness(const Handle handle) const {
+	HFSM_ASSERT(handle < CAPACITY);
+
+	return _tick - _lastUpdates[handle];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_POOL_INDEX
+
+template <typename TI, uint32_t NC, typename TC>
+typename PoolT<TI, NC, TC>::Members
+PoolT<TI, NC, TC>::inState(const StateID stateId) const {
+	HFSM_ASSERT(stateId < STATE_COUNT);
+
+	return Members{_members + stateId * CAPACITY, _memberCounts[stateId]};
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+
+template <typename TI, uint32_t NC, typename TC>
+void
+PoolT<TI, NC, TC>::update() {
+	++_tick;
+
+	// the last awake machine takes the slot of a sleeping one, visit it next
+	for (uint32_t i = 0; i < _awakeCount; )
+		if (updateMachine(_awake[i]))
+			++i;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TI, uint32_t NC, typename TC>
+template <typename TOrder>
+uint32_t
+PoolT<TI, NC, TC>::updateFor(const uint64_t budget,
+							 const TOrder& order,
+							 const uint32_t checkInterval)
+{
+	HFSM_ASSERT(checkInterval);
+
+	++_tick;
+
+	const uint32_t total = _awakeCount;
+	if (total == 0)
+		return 0;
+
+	// '_order' is a snapshot, machines going to sleep don't disturb it
+	arrange(order);
+
+	const uint64_t start = Clock::now();
+
+	uint32_t i = 0;
+	for (uint32_t untilCheck = checkInterval; i < total; ) {
+		updateMachine(_order[i++]);
+
+		if (--untilCheck == 0) {
+			if (Clock::now() - start >= budget)
+				break;
+
+			untilCheck = checkInterval;
+		}
+	}
+
+	// start the next round-robin pass from the first machine left out
+	_cursor = 0;
+	if (i < total) {
+		const uint32_t index = _awakeIndices[_order[i]];
+
+		if (index != INVALID_HANDLE)
+			_cursor = index;
+	}
+
+	return i;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TI, uint32_t NC, typename TC>
+template <typename TEvent>
+void
+PoolT<TI, NC, TC>::react(const Handle handle,
+					 const TEvent& event)
+{
+	HFSM_ASSERT(handle < _used && _machines[handle]);
+
+	_machines[handle]->react(event);
+
+	refresh(handle);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TI, uint32_t NC, typename TC>
+template <typename TEvent>
+void
+PoolT<TI, NC, TC>::react(const TEvent& event) {
+	for (Handle handle = 0; handle < _used; ++handle)
+		if (_machines[handle])
+			react(handle, event);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TI, uint32_t NC, typename TC>
+void
+PoolT<TI, NC, TC>::wake(const Handle handle) {
+	HFSM_ASSERT(handle < _used && _machines[handle]);
+
+	if (_awakeIndices[handle] == INVALID_HANDLE) {
+		_awakeIndices[handle] = _awakeCount;
+		_awake[_awakeCount++] = handle;
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TI, uint32_t NC, typename TC>
+void
+PoolT<TI, NC, TC>::refresh(const Handle handle) {
+	HFSM_ASSERT(handle < _used && _machines[handle]);
+
+	HFSM_IF_POOL_INDEX(reindex(handle));
+
+	if (_machines[handle]->needsUpdate())
+		wake(handle);
+	else
+		sleep(handle);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TI, uint32_t NC, typename TC>
+void
+PoolT<TI, NC, TC>::sleep(const Handle handle) {
+	const uint32_t index = _awakeIndices[handle];
+
+	if (index != INVALID_HANDLE) {
+		const Handle last = _awake[--_awakeCount];
+
+		_awake[index] = last;
+		_awakeIndices[last] = index;
+		_awakeIndices[handle] = INVALID_HANDLE;
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TI, uint32_t NC, typename TC>
+bool
+PoolT<TI, NC, TC>::updateMachine(const Handle handle) {
+	Instance& machine = *_machines[handle];
+
+	_current = handle;
+	machine.update();
+	_current = INVALID_HANDLE;
+
+	_lastUpdates[handle] = _tick;
+
+	HFSM_IF_POOL_INDEX(reindex(handle));
+
+	if (machine.needsUpdate())
+		return true;
+
+	sleep(handle);
+
+	return false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TI, uint32_t NC, typename TC>
+void
+PoolT<TI, NC, TC>::arrange(const RoundRobinOrder& /*order*/) {
+	const uint32_t start = _cursor < _awakeCount ? _cursor : 0;
+
+	uint32_t o = 0;
+	for (uint32_t i = start; i < _awakeCount; ++i)
+		_order[o++] = _awake[i];
+	for (uint32_t i = 0; i < start; ++i)
+		_order[o++] = _awake[i];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TI, uint32_t NC, typename TC>
+template <typename TOrder>
+void
+PoolT<TI, NC, TC>::arrange(const TOrder& order) {
+	for (uint32_t i = 0; i < _awakeCount; ++i) {
+		const Handle handle = _awake[i];
+
+		_order[i] = handle;
+		_priorities[handle] = order(handle, *_machines[handle], staleness(handle));
+	}
+
+	std::sort(_order,
+			  _order + _awakeCount,
+			  [this](const Handle l, const Handle r) { return _priorities[l] > _priorities[r]; });
+}
+
+//------------------------------------------------------------------------------
+
+#ifdef HFSM_ENABLE_POOL_INDEX
+
+template <typename TI, uint32_t NC, typename TC>
+void
+PoolT<TI, NC, TC>::reindex(const Handle handle) {
+	Instance& machine = *_machines[handle];
+
+	const typename Instance::ActivityChanges& changes = machine.activityChanges();
+
+	for (LongIndex c = 0; c < changes.states.count(); ++c)
+		relist(handle, changes.states[c]);
+
+	machine.clearActivityChanges();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TI, uint32_t NC, typename TC>
+void
+PoolT<TI, NC, TC>::rescan(const Handle handle) {
+	for (StateID s = 0; s < STATE_COUNT; ++s)
+		relist(handle, s);
+
+	_machines[handle]->clearActivityChanges();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TI, uint32_t NC, typename TC>
+void
+PoolT<TI, NC, TC>::relist(const Handle handle,
+						  const StateID stateId)
+{
+	const bool listed = _positions[handle * STATE_COUNT + stateId] != INVALID_HANDLE;
+
+	if (_machines[handle]->isActive(stateId)) {
+		if (!listed)
+			enlist(handle, stateId);
+	} else {
+		if (listed)
+			delist(handle, stateId);
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TI, uint32_t NC, typename TC>
+void
+PoolT<TI, NC, TC>::enlist(const Handle handle,
+						  const StateID stateId)
+{
+	const uint32_t position = _memberCounts[stateId]++;
+
+	_members[stateId * CAPACITY + position] = handle;
+	_positions[handle * STATE_COUNT + stateId] = position;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TI, uint32_t NC, typename TC>
+void
+PoolT<TI, NC, TC>::delist(const Handle handle,
+						  const StateID stateId)
+{
+	Handle* const members = _members + stateId * CAPACITY;
+
+	const uint32_t position = _positions[handle * STATE_COUNT + stateId];
+	const Handle last = members[--_memberCounts[stateId]];
+
+	members[position] = last;
+	_positions[last	  * STATE_COUNT + stateId] = position;
+	_positions[handle * STATE_COUNT + stateId] = INVALID_HANDLE;
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+#ifdef HFSM_ENABLE_TRANSITION_HISTORY
+
+namespace hfsm2 {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Stream of transitions from many machines, for any byte transport
+//  A frame per machine that transitioned:
+//   varint entity id, varint transition count,
+//   varint 'stateId << 3 | TransitionType' per transition
+//  Machines without transitions are left out,
+//  a transition into one of the first 16 states takes a single byte
+//  R_::transitionHistory() only holds the transitions of the last update() / react(),
+//  so frames are written after each of them
+
+template <LongIndex NCapacity>
+class ReplicationWriterT {
+public:
+	static constexpr LongIndex CAPACITY = NCapacity;
+
+	// Append a frame with the machine's transition history,
+	//  returns false and leaves the stream intact if the frame doesn't fit
+	template <typename TMachine>
+	HFSM_INLINE bool write(const uint32_t entityId,
+						   const TMachine& machine);
+
+	HFSM_INLINE bool write(const uint32_t entityId,
+						   const Transition* const transitions,
+						   const LongIndex count);
+
+	HFSM_INLINE void clear()											{ _size = 0; _frames = 0;				}
+
+	HFSM_INLINE const uint8_t* data() const								{ return _bytes;						}
+	HFSM_INLINE LongIndex size() const									{ return _size;							}
+	HFSM_INLINE LongIndex frameCount() const							{ return _frames;						}
+
+private:
+	HFSM_INLINE bool writeVarint(LongIndex& cursor,
+								 uint32_t value);
+
+private:
+	uint8_t _bytes[CAPACITY];
+	LongIndex _size = 0;
+	LongIndex _frames = 0;
+};
+
+//------------------------------------------------------------------------------
+
+// Applies a stream written by ReplicationWriterT, doesn't copy the bytes
+
+class ReplicationReader {
+public:
+	HFSM_INLINE ReplicationReader(const uint8_t* const data,
+								  const size_t size);
+
+	// Replay every frame on the machine 'resolve(entityId)' points to,
+	//  frames resolved to nullptr are skipped
+	//  Returns the number of frames replayed, stops at the first malformed frame
+	template <typename TMachine, typename TResolve>
+	HFSM_INLINE uint32_t apply(TResolve&& resolve);
+
+	HFSM_INLINE bool failed() const										{ return _failed;						}
+	HFSM_INLINE bool done() const										{ return _cursor == _end;				}
+
+private:
+	HFSM_INLINE bool readVarint(uint32_t& value);
+
+private:
+	const uint8_t* _cursor;
+	const uint8_t* const _end;
+	bool _failed = false;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+
+#include "replication.inl"
+
+#endif
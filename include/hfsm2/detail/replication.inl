@@ -0,0 +1,152 @@
+namespace hfsm2 {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <LongIndex NC>
+template <typename TMachine>
+bool
+ReplicationWriterT<NC>::write(const uint32_t entityId,
+							  const TMachine& machine)
+{
+	const auto& history = machine.transitionHistory();
+
+	return history.count() == 0 ||
+		   write(entityId, &history[0], history.count());
+}
+
+//------------------------------------------------------------------------------
+
+template <LongIndex NC>
+bool
+ReplicationWriterT<NC>::write(const uint32_t entityId,
+							  const Transition* const transitions,
+							  const LongIndex count)
+{
+	if (count == 0)
+		return true;
+
+	HFSM_ASSERT(transitions);
+
+	LongIndex cursor = _size;
+
+	if (!writeVarint(cursor, entityId) ||
+		!writeVarint(cursor, count))
+		return false;
+
+	for (LongIndex i = 0; i < count; ++i) {
+		const Transition& transition = transitions[i];
+		HFSM_ASSERT(transition.transitionType < TransitionType::COUNT);
+
+		if (!writeVarint(cursor, (uint32_t) transition.stateId << 3 |
+										  (uint32_t) transition.transitionType))
+			return false;
+	}
+
+	_size = cursor;
+	++_frames;
+
+	return true;
+}
+
+//------------------------------------------------------------------------------
+
+template <LongIndex NC>
+bool
+ReplicationWriterT<NC>::writeVarint(LongIndex& cursor,
+									uint32_t value)
+{
+	do {
+		if (cursor >= CAPACITY)
+			return false;
+
+		const uint8_t low = (uint8_t) (value & 0x7F);
+		value >>= 7;
+
+		_bytes[cursor++] = value ? (uint8_t) (low | 0x80) : low;
+	} while (value);
+
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline
+ReplicationReader::ReplicationReader(const uint8_t* const data,
+									 const size_t size)
+	: _cursor{data}
+	, _end{data + size}
+{
+	HFSM_ASSERT(data || size == 0);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TMachine, typename TResolve>
+uint32_t
+ReplicationReader::apply(TResolve&& resolve) {
+	constexpr LongIndex CAPACITY = TMachine::TransitionHistory::CAPACITY;
+
+	Transition transitions[CAPACITY];
+	uint32_t applied = 0;
+
+	while (!_failed && _cursor < _end) {
+		uint32_t entityId;
+		uint32_t count;
+
+		if (!readVarint(entityId) ||
+			!readVarint(count) ||
+			count == 0 || count > CAPACITY)
+		{
+			_failed = true;
+			break;
+		}
+
+		for (uint32_t i = 0; i < count; ++i) {
+			uint32_t packed;
+
+			if (!readVarint(packed) ||
+				(packed >> 3) >= TMachine::STATE_COUNT ||
+				(packed &  7) >= (uint32_t) TransitionType::COUNT)
+			{
+				_failed = true;
+				return applied;
+			}
+
+			transitions[i] = Transition{(StateID) (packed >> 3),
+										Method::NONE,
+										(TransitionType) (packed & 7)};
+		}
+
+		if (TMachine* const machine = resolve(entityId)) {
+			machine->replayTransitions(transitions, count);
+			++applied;
+		}
+	}
+
+	return applied;
+}
+
+//------------------------------------------------------------------------------
+
+inline
+bool
+ReplicationReader::readVarint(uint32_t& value) {
+	value = 0;
+
+	for (unsigned shift = 0; shift < 35; shift += 7) {
+		if (_cursor >= _end)
+			return false;
+
+		const uint8_t byte = *_cursor++;
+		value |= (uint32_t) (byte & 0x7F) << shift;
+
+		if ((byte & 0x80) == 0)
+			return true;
+	}
+
+	return false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -80,6 +80,10 @@ public:
 	using ActivityHistory		= Array<char,			NAME_COUNT>;
 #endif
 
+	HFSM_IF_PROFILER(using Profiler = typename Args::Profiler);
+	HFSM_IF_STATISTICS(using Statistics = typename Args::Statistics);
+	HFSM_IF_TIMERS(using Timers = typename Args::Timers);
+
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 public:
@@ -152,6 +156,16 @@ public:
 	template <typename TEvent>
 	HFSM_INLINE void react(const TEvent& event);
 
+	// Same as react() on every event in turn, transitions requested while reacting
+	//  to an event are processed before the next one is dispatched
+	//  The control is built once for the whole batch
+	template <typename TEvent>
+	HFSM_INLINE void reactBatch(const TEvent* const events,
+								const size_t count);
+
+	template <LongIndex NCapacity, typename... TEvents>
+	HFSM_INLINE void reactBatch(const EventBufferT<NCapacity, TEvents...>& buffer);
+
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 	HFSM_INLINE bool isActive   (const StateID stateId) const	{ return _registry.isActive   (stateId);	}
@@ -197,16 +211,32 @@ public:
 	template <typename TState>
 	HFSM_INLINE void schedule ()								{ schedule (stateId<TState>());				}
 
+#ifdef HFSM_ENABLE_PAYLOADS
+	// With all payload slots taken, asserts and doesn't request the transition
+	template <typename TPayload>
+	HFSM_INLINE void changeTo (const StateID stateId, const TPayload& payload);
+
+	template <typename TState, typename TPayload>
+	HFSM_INLINE void changeTo (const TPayload& payload)		{ changeTo (stateId<TState>(), payload);	}
+#endif
+
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 #ifdef HFSM_ENABLE_STRUCTURE_REPORT
-	const Structure&	   structure()		 const				{ return _structure;						}
-	const ActivityHistory& activityHistory() const				{ return _activityHistory;					}
+	// Fill 'entries' with names and prefixes shared by all instances of the machine type,
+	//  and the activity of this instance as of the last refresh
+	void structure(Structure& entries) const;
+
+	// Consecutive refreshes each state stayed active (positive) or inactive (negative) for,
+	//  counted lazily from the refresh at which the state last changed
+	const ActivityHistory& activityHistory() const;
 #endif
 
 #ifdef HFSM_ENABLE_TRANSITION_HISTORY
 	using TransitionHistory		= Array<Transition, COMPO_REGIONS * 4>;
 
+	// Transitions made by the last update() / react() / reactBatch(), empty if there were none
+	//  Holds up to 'COMPO_REGIONS * 4' transitions, asserts on more
 	const TransitionHistory& transitionHistory() const			{ return _transitionHistory;				}
 
 	void replayTransition (const Transition& transition)		{ replayTransitions(&transition, 1);		}
@@ -215,6 +245,58 @@ public:
 
 	void reset();
 
+	// Check if update() has anything to do: pending requests, plans, armed timers,
+	//  coroutine tasks waiting for ticks or active states overriding update()
+	//  Machines reporting false can be skipped by update() until they get an event or a request
+	bool needsUpdate() const;
+
+	// Bumped every time the set of active states may have changed,
+	//  lets observers skip re-scanning isActive() between transitions
+	HFSM_INLINE uint32_t activityEpoch() const					{ return _activityEpoch;					}
+
+#ifdef HFSM_ENABLE_POOL_INDEX
+	using ActivityChanges		= ActivityChangesT<STATE_COUNT>;
+
+	// States entered or exited since the last clearActivityChanges(), used by PoolT's state index
+	HFSM_INLINE const ActivityChanges& activityChanges() const	{ return _planData.indexChanges;			}
+	HFSM_INLINE void clearActivityChanges()						{ _planData.indexChanges.clear();			}
+#endif
+
+#ifdef HFSM_ENABLE_UPDATE_PERIODS
+	// Update the region only on every 'period'-th update() while it's active
+	//  'phase' delays the first update within the period,
+	//  stagger it across instances to spread the load over ticks
+	//  react() and transitions are not affected
+	void setUpdatePeriod(const RegionID regionId,
+						 const uint16_t period,
+						 const uint16_t phase = 0)				{ _planData.updatePeriods.set(regionId, period, phase);	}
+
+	template <typename TRegion>
+	void setUpdatePeriod(const uint16_t period,
+						 const uint16_t phase = 0)				{ setUpdatePeriod(regionId<TRegion>(), period, phase);	}
+#endif
+
+#ifdef HFSM_ENABLE_PLAN_QUOTAS
+	// Reserve plan tasks for the region and cap it at that many,
+	//  INVALID_LONG_INDEX lifts the cap and the reservation
+	//  Quotas of all regions can't add up to more than the task capacity
+	void setPlanQuota(const RegionID regionId,
+					  const LongIndex quota)					{ _planData.planQuotas.setQuota(regionId, quota);		}
+
+	template <typename TRegion>
+	void setPlanQuota(const LongIndex quota)					{ setPlanQuota(regionId<TRegion>(), quota);				}
+
+	const PlanUsage& planUsage(const RegionID regionId) const	{ return _planData.planQuotas.regions[regionId];		}
+
+	template <typename TRegion>
+	const PlanUsage& planUsage() const							{ return planUsage(regionId<TRegion>());				}
+
+	// Largest number of task links in use at once, across all regions
+	LongIndex planHighWater() const								{ return _planData.planQuotas.highWater;				}
+
+	void resetPlanHighWater()									{ _planData.planQuotas.resetHighWater();				}
+#endif
+
 #ifdef HFSM_ENABLE_SERIALIZATION
 	// Buffer for serialization
 	//  Members:
@@ -234,10 +316,55 @@ public:
 	void attachLogger(Logger* const logger)						{ _logger = logger;							}
 #endif
 
+#ifdef HFSM_ENABLE_PROFILER
+	// Time state method calls into 'profiler', nullptr to stop
+	void attachProfiler(Profiler* const profiler)				{ _profiler = profiler;						}
+#endif
+
+#ifdef HFSM_ENABLE_STATISTICS
+	// Count transitions and state activity into 'statistics', nullptr to stop
+	void attachStatistics(Statistics* const statistics);
+#endif
+
+#ifdef HFSM_ENABLE_PARALLEL
+	// Run ParallelOrthogonal<> sub-states on 'executor', nullptr to run them in sequence
+	void attachExecutor(ExecutorInterface* const executor)		{ _planData.executor = executor;			}
+#endif
+
+#ifdef HFSM_ENABLE_WATCHDOG
+	// Substitution round and oscillation counters, see WatchdogReport for details
+	const WatchdogReport& watchdogReport() const				{ return _watchdog.report();				}
+
+	void resetWatchdog()										{ _watchdog.reset();						}
+#endif
+
+#ifdef HFSM_ENABLE_TRANSITION_TRACE
+	// Record processed transitions into 'trace', tagged with 'instance'
+	//  See TransitionTrace for details
+	void attachTrace(TransitionTrace* const trace,
+					 const uint16_t instance = 0)				{ _trace = trace; _traceInstance = instance;	}
+
+	// Number of update() / react() calls, used as the trace timestamp
+	uint32_t tick() const										{ return _tick;								}
+#endif
+
 private:
+	struct BatchVisitor {
+		template <typename TEvent>
+		HFSM_INLINE void operator() (const TEvent& event)		{ root.dispatch(control, event);			}
+
+		R_& root;
+		FullControl& control;
+	};
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
 	void initialEnter();
 	void processTransitions();
 
+	template <typename TEvent>
+	HFSM_INLINE void dispatch(FullControl& control, const TEvent& event);
+
 	bool applyRequest (Control& control, const Request& request);
 	bool applyRequests(Control& control);
 
@@ -251,12 +378,33 @@ private:
 	bool cancelledByGuards(const Requests& pendingChanges);
 
 #ifdef HFSM_ENABLE_STRUCTURE_REPORT
-	void getStateNames();
+	// Built once per machine type, on the first instance construction
+	struct StructureReport {
+		StructureReport(const MaterialApex& apex);
+
+		StructureStateInfos stateInfos;
+		Prefixes prefixes;
+
+		Structure structure;
+		LongIndex entries[STATE_COUNT];			// 'structure' entry of each state, INVALID_LONG_INDEX if unnamed
+	};
+
+	static const StructureReport& structureReport(const MaterialApex& apex);
+
 	void udpateActivity();
 #endif
 
 	HFSM_IF_TRANSITION_HISTORY(void recordRequestsAs(const Method method));
 
+	HFSM_IF_TRANSITION_TRACE(void traceRequests(const Requests& requests, const Method method));
+
+	HFSM_IF_STATISTICS(void countRequests(const Requests& requests, const bool cancelled));
+
+	bool hasActiveUpdaters() const;
+
+	HFSM_IF_WATCHDOG(void watchRounds(const LongIndex rounds));
+	HFSM_IF_WATCHDOG(void watchRequests(const Requests& requests));
+
 private:
 	Context& _context;
 	RNG& _rng;
@@ -269,16 +417,34 @@ private:
 	MaterialApex _apex;
 
 #ifdef HFSM_ENABLE_STRUCTURE_REPORT
-	Prefixes _prefixes;
-	StructureStateInfos _stateInfos;
+	const StructureReport& _structureReport;
+
+	uint32_t _activityTick = 0;					// udpateActivity() calls
+	uint32_t _activitySince[NAME_COUNT];		// '_activityTick' before the entry last changed
+	BitArray<ShortIndex, NAME_COUNT> _activityBits;
 
-	Structure _structure;
-	ActivityHistory _activityHistory;
+	mutable ActivityHistory _activityHistory;
 #endif
 
 	HFSM_IF_TRANSITION_HISTORY(TransitionHistory _transitionHistory);
 
+	// Active configuration changed since the last needsUpdate() check
+	mutable bool _updatersDirty = true;
+	mutable bool _hasUpdaters	= false;
+
+	uint32_t _activityEpoch = 0;
+
+#ifdef HFSM_ENABLE_TRANSITION_TRACE
+	TransitionTrace* _trace = nullptr;
+	uint16_t _traceInstance = 0;
+	uint32_t _tick = 0;
+#endif
+
 	HFSM_IF_LOGGER(Logger* _logger);
+	HFSM_IF_PROFILER(Profiler* _profiler = nullptr);
+	HFSM_IF_STATISTICS(Statistics* _statistics = nullptr);
+	HFSM_IF_WATCHDOG(detail::Watchdog _watchdog);
+	HFSM_IF_TIMERS(Timers _timers);
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -299,12 +465,15 @@ template <typename TN_,
 		  typename TR_,
 		  LongIndex NS,
 		  LongIndex NT,
+		  typename TL_,
+		  LongIndex NP,
+		  LongIndex NA,
 		  typename TApex>
-class RW_	   <::hfsm2::ConfigT<::hfsm2::EmptyContext, TN_, TU_, TR_, NS, NT>, TApex> final
-	: public R_<::hfsm2::ConfigT<::hfsm2::EmptyContext, TN_, TU_, TR_, NS, NT>, TApex>
+class RW_	   <::hfsm2::ConfigT<::hfsm2::EmptyContext, TN_, TU_, TR_, NS, NT, TL_, NP, NA>, TApex> final
+	: public R_<::hfsm2::ConfigT<::hfsm2::EmptyContext, TN_, TU_, TR_, NS, NT, TL_, NP, NA>, TApex>
 	, ::hfsm2::EmptyContext
 {
-	using Config_	= ::hfsm2::ConfigT<::hfsm2::EmptyContext, TN_, TU_, TR_, NS, NT>;
+	using Config_	= ::hfsm2::ConfigT<::hfsm2::EmptyContext, TN_, TU_, TR_, NS, NT, TL_, NP, NA>;
 	using Context	= typename Config_::Context;
 	using RNG		= typename Config_::RNG;
 	using Logger	= typename Config_::Logger;
@@ -327,12 +496,15 @@ template <typename TC_,
 		  typename TU_,
 		  LongIndex NS,
 		  LongIndex NT,
+		  typename TL_,
+		  LongIndex NP,
+		  LongIndex NA,
 		  typename TApex>
-class RW_	   <::hfsm2::ConfigT<TC_, TN_, TU_, ::hfsm2::RandomT<TU_>, NS, NT>, TApex> final
-	: public R_<::hfsm2::ConfigT<TC_, TN_, TU_, ::hfsm2::RandomT<TU_>, NS, NT>, TApex>
+class RW_	   <::hfsm2::ConfigT<TC_, TN_, TU_, ::hfsm2::RandomT<TU_>, NS, NT, TL_, NP, NA>, TApex> final
+	: public R_<::hfsm2::ConfigT<TC_, TN_, TU_, ::hfsm2::RandomT<TU_>, NS, NT, TL_, NP, NA>, TApex>
 	, ::hfsm2::RandomT<TU_>
 {
-	using Config_	= ::hfsm2::ConfigT<TC_, TN_, TU_, ::hfsm2::RandomT<TU_>, NS, NT>;
+	using Config_	= ::hfsm2::ConfigT<TC_, TN_, TU_, ::hfsm2::RandomT<TU_>, NS, NT, TL_, NP, NA>;
 	using Context	= typename Config_::Context;
 	using RNG		= typename Config_::RNG;
 	using Logger	= typename Config_::Logger;
@@ -355,13 +527,16 @@ template <typename TN_,
 		  typename TU_,
 		  LongIndex NS,
 		  LongIndex NT,
+		  typename TL_,
+		  LongIndex NP,
+		  LongIndex NA,
 		  typename TApex>
-class RW_	   <::hfsm2::ConfigT<::hfsm2::EmptyContext, TN_, TU_, ::hfsm2::RandomT<TU_>, NS, NT>, TApex> final
-	: public R_<::hfsm2::ConfigT<::hfsm2::EmptyContext, TN_, TU_, ::hfsm2::RandomT<TU_>, NS, NT>, TApex>
+class RW_	   <::hfsm2::ConfigT<::hfsm2::EmptyContext, TN_, TU_, ::hfsm2::RandomT<TU_>, NS, NT, TL_, NP, NA>, TApex> final
+	: public R_<::hfsm2::ConfigT<::hfsm2::EmptyContext, TN_, TU_, ::hfsm2::RandomT<TU_>, NS, NT, TL_, NP, NA>, TApex>
 	, ::hfsm2::EmptyContext
 	, ::hfsm2::RandomT<TU_>
 {
-	using Config_	= ::hfsm2::ConfigT<::hfsm2::EmptyContext, TN_, TU_, ::hfsm2::RandomT<TU_>, NS, NT>;
+	using Config_	= ::hfsm2::ConfigT<::hfsm2::EmptyContext, TN_, TU_, ::hfsm2::RandomT<TU_>, NS, NT, TL_, NP, NA>;
 	using Context	= typename Config_::Context;
 	using RNG		= typename Config_::RNG;
 	using Logger	= typename Config_::Logger;
@@ -10,10 +10,16 @@ R_<TG, TA>::R_(Context& context,
 	: _context{context}
 	, _rng{rng}
 	HFSM_IF_LOGGER(, _logger{logger})
+	HFSM_IF_STRUCTURE(, _structureReport{structureReport(_apex)})
 {
 	_apex.deepRegister(_registry, Parent{});
 
-	HFSM_IF_STRUCTURE(getStateNames());
+#ifdef HFSM_ENABLE_STRUCTURE_REPORT
+	for (LongIndex i = 0; i < _structureReport.structure.count(); ++i) {
+		_activitySince[i] = 0;
+		_activityHistory.append((char) 0);
+	}
+#endif
 
 	initialEnter();
 }
@@ -26,7 +32,10 @@ R_<TG, TA>::~R_() {
 						_rng,
 						_registry,
 						_planData,
-						HFSM_LOGGER_OR(_logger, nullptr)};
+						HFSM_LOGGER_OR(_logger, nullptr)
+						HFSM_IF_PROFILER(, _profiler)
+						HFSM_IF_STATISTICS(, _statistics)
+						HFSM_IF_TIMERS(, _timers)};
 
 	_apex.deepExit	  (control);
 	_apex.deepDestruct(control);
@@ -39,12 +48,21 @@ R_<TG, TA>::~R_() {
 template <typename TG, typename TA>
 void
 R_<TG, TA>::update() {
+	HFSM_IF_TRANSITION_TRACE(++_tick);
+	HFSM_IF_STATISTICS(if (_statistics) _statistics->advance());
+	HFSM_IF_WATCHDOG(_watchdog.tick());
+	HFSM_IF_TRANSITION_HISTORY(_transitionHistory.clear());
+	HFSM_IF_TIMERS(_timers.advance(_requests, _registry));
+
 	FullControl control(_context,
 						_rng,
 						_registry,
 						_planData,
 						_requests,
-						HFSM_LOGGER_OR(_logger, nullptr));
+						HFSM_LOGGER_OR(_logger, nullptr)
+						HFSM_IF_PROFILER(, _profiler)
+						HFSM_IF_STATISTICS(, _statistics)
+						HFSM_IF_TIMERS(, _timers));
 
 	_apex.deepUpdate(control);
 
@@ -62,12 +80,78 @@ template <typename TG, typename TA>
 template <typename TEvent>
 void
 R_<TG, TA>::react(const TEvent& event) {
+	HFSM_IF_TRANSITION_HISTORY(_transitionHistory.clear());
+
 	FullControl control{_context,
 						_rng,
 						_registry,
 						_planData,
 						_requests,
-						HFSM_LOGGER_OR(_logger, nullptr)};
+						HFSM_LOGGER_OR(_logger, nullptr)
+						HFSM_IF_PROFILER(, _profiler)
+						HFSM_IF_STATISTICS(, _statistics)
+						HFSM_IF_TIMERS(, _timers)};
+
+	dispatch(control, event);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+template <typename TEvent>
+void
+R_<TG, TA>::reactBatch(const TEvent* const events,
+					   const size_t count)
+{
+	HFSM_IF_TRANSITION_HISTORY(_transitionHistory.clear());
+
+	FullControl control{_context,
+						_rng,
+						_registry,
+						_planData,
+						_requests,
+						HFSM_LOGGER_OR(_logger, nullptr)
+						HFSM_IF_PROFILER(, _profiler)
+						HFSM_IF_STATISTICS(, _statistics)
+						HFSM_IF_TIMERS(, _timers)};
+
+	for (size_t i = 0; i < count; ++i)
+		dispatch(control, events[i]);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+template <LongIndex NCapacity, typename... TEvents>
+void
+R_<TG, TA>::reactBatch(const EventBufferT<NCapacity, TEvents...>& buffer) {
+	HFSM_IF_TRANSITION_HISTORY(_transitionHistory.clear());
+
+	FullControl control{_context,
+						_rng,
+						_registry,
+						_planData,
+						_requests,
+						HFSM_LOGGER_OR(_logger, nullptr)
+						HFSM_IF_PROFILER(, _profiler)
+						HFSM_IF_STATISTICS(, _statistics)
+						HFSM_IF_TIMERS(, _timers)};
+
+	BatchVisitor visitor{*this, control};
+	buffer.visit(visitor);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+template <typename TEvent>
+void
+R_<TG, TA>::dispatch(FullControl& control,
+					 const TEvent& event)
+{
+	HFSM_IF_TRANSITION_TRACE(++_tick);
+	HFSM_IF_STATISTICS(if (_statistics) _statistics->advance());
+	HFSM_IF_WATCHDOG(_watchdog.tick());
 
 	_apex.deepReact(control, event);
 
@@ -91,6 +175,22 @@ R_<TG, TA>::changeTo(const StateID stateId) {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+#ifdef HFSM_ENABLE_PAYLOADS
+
+template <typename TG, typename TA>
+template <typename TPayload>
+void
+R_<TG, TA>::changeTo(const StateID stateId,
+					 const TPayload& payload)
+{
+	if (HFSM_CHECKED(_planData.payloads.stage(stateId, payload)))
+		changeTo(stateId);
+}
+
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
 template <typename TG, typename TA>
 void
 R_<TG, TA>::restart(const StateID stateId) {
@@ -155,12 +255,17 @@ R_<TG, TA>::replayTransitions(const Transition* const transitions,
 							_rng,
 							_registry,
 							_planData,
-							HFSM_LOGGER_OR(_logger, nullptr)};
+							HFSM_LOGGER_OR(_logger, nullptr)
+							HFSM_IF_PROFILER(, _profiler)
+							HFSM_IF_STATISTICS(, _statistics)
+							HFSM_IF_TIMERS(, _timers)};
 
 		if (applyRequests(control, transitions, count)) {
 			_apex.deepChangeToRequested(control);
 
 			_registry.clearRequests();
+			_updatersDirty = true;
+			++_activityEpoch;
 
 			HFSM_IF_ASSERT(_planData.verifyPlans());
 		}
@@ -180,7 +285,10 @@ R_<TG, TA>::reset() {
 						_rng,
 						_registry,
 						_planData,
-						HFSM_LOGGER_OR(_logger, nullptr)};
+						HFSM_LOGGER_OR(_logger, nullptr)
+						HFSM_IF_PROFILER(, _profiler)
+						HFSM_IF_STATISTICS(, _statistics)
+						HFSM_IF_TIMERS(, _timers)};
 
 	_apex.deepExit	   (control);
 	_apex.deepDestruct (control);
@@ -190,6 +298,9 @@ R_<TG, TA>::reset() {
 	_apex.deepRequestChange(control);
 	_apex.deepConstruct(control);
 	_apex.deepEnter	   (control);
+
+	_updatersDirty = true;
+	++_activityEpoch;
 }
 
 //------------------------------------------------------------------------------
@@ -213,7 +324,10 @@ R_<TG, TA>::load(const SerialBuffer& buffer) {
 						_rng,
 						_registry,
 						_planData,
-						HFSM_LOGGER_OR(_logger, nullptr)};
+						HFSM_LOGGER_OR(_logger, nullptr)
+						HFSM_IF_PROFILER(, _profiler)
+						HFSM_IF_STATISTICS(, _statistics)
+						HFSM_IF_TIMERS(, _timers)};
 
 	_apex.deepExit	   (control);
 	_apex.deepDestruct (control);
@@ -223,12 +337,48 @@ R_<TG, TA>::load(const SerialBuffer& buffer) {
 
 	_apex.deepConstruct(control);
 	_apex.deepEnter	   (control);
+
+	_updatersDirty = true;
+	++_activityEpoch;
 }
 
 #endif
 
 //------------------------------------------------------------------------------
 
+template <typename TG, typename TA>
+bool
+R_<TG, TA>::needsUpdate() const {
+	if (_requests.count() || _planData.hasPlans())
+		return true;
+
+	HFSM_IF_TIMERS(if (!_timers.empty()) return true);
+	HFSM_IF_COROUTINES(if (_planData.coroutines.needsUpdate()) return true);
+
+	if (_updatersDirty) {
+		_hasUpdaters = hasActiveUpdaters();
+		_updatersDirty = false;
+	}
+
+	return _hasUpdaters;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+bool
+R_<TG, TA>::hasActiveUpdaters() const {
+	using UpdateMask = UpdateMaskT<FullControl, StateList>;
+
+	for (StateID s = 0; s < STATE_COUNT; ++s)
+		if (UpdateMask::HAS_UPDATE[s] && isActive(s))
+			return true;
+
+	return false;
+}
+
+//------------------------------------------------------------------------------
+
 template <typename TG, typename TA>
 void
 R_<TG, TA>::initialEnter() {
@@ -244,7 +394,10 @@ R_<TG, TA>::initialEnter() {
 						_rng,
 						_registry,
 						_planData,
-						HFSM_LOGGER_OR(_logger, nullptr)};
+						HFSM_LOGGER_OR(_logger, nullptr)
+						HFSM_IF_PROFILER(, _profiler)
+						HFSM_IF_STATISTICS(, _statistics)
+						HFSM_IF_TIMERS(, _timers)};
 
 	_apex.deepRequestChange(control);
 
@@ -287,8 +440,6 @@ void
 R_<TG, TA>::processTransitions() {
 	HFSM_ASSERT(_requests.count());
 
-	HFSM_IF_TRANSITION_HISTORY(_transitionHistory.clear());
-
 	RegistryBackUp undo;
 	HFSM_IF_TRANSITION_HISTORY(TransitionHistory undoTransitionHistory);
 
@@ -298,11 +449,15 @@ R_<TG, TA>::processTransitions() {
 						_rng,
 						_registry,
 						_planData,
-						HFSM_LOGGER_OR(_logger, nullptr)};
+						HFSM_LOGGER_OR(_logger, nullptr)
+						HFSM_IF_PROFILER(, _profiler)
+						HFSM_IF_STATISTICS(, _statistics)
+						HFSM_IF_TIMERS(, _timers)};
 
 	bool changesMade = false;
 
-	for (LongIndex i = 0;
+	LongIndex i = 0;
+	for (;
 		i < SUBSTITUTION_LIMIT && _requests.count();
 		++i)
 	{
@@ -313,23 +468,43 @@ R_<TG, TA>::processTransitions() {
 			lastRequests = _requests;
 			_requests.clear();
 
+			HFSM_IF_PAYLOADS(const uint16_t round = _planData.payloads.seal());
+
 			if (cancelledByGuards(lastRequests)) {
 				restore(_registry, undo);
 				HFSM_IF_TRANSITION_HISTORY(_transitionHistory = undoTransitionHistory);
-			} else
+				HFSM_IF_STATISTICS(countRequests(lastRequests, true));
+				HFSM_IF_PAYLOADS(_planData.payloads.discard(round));
+			} else {
+				HFSM_IF_TRANSITION_TRACE(traceRequests(lastRequests, Method::NONE));
+				HFSM_IF_STATISTICS(countRequests(lastRequests, false));
+				HFSM_IF_WATCHDOG(watchRequests(lastRequests));
+
 				changesMade = true;
-		} else
+			}
+		} else {
+			HFSM_IF_TRANSITION_TRACE(traceRequests(_requests, Method::NONE));
+
 			_requests.clear();
+
+			HFSM_IF_PAYLOADS(_planData.payloads.discard(_planData.payloads.seal()));
+		}
 	}
 
+	HFSM_IF_WATCHDOG(watchRounds(i));
+
 	if (changesMade) {
 		_apex.deepChangeToRequested(control);
 
 		_registry.clearRequests();
+		_updatersDirty = true;
+		++_activityEpoch;
 
 		HFSM_IF_ASSERT(_planData.verifyPlans());
 	}
 
+	HFSM_IF_PAYLOADS(_planData.payloads.clear());
+
 	HFSM_IF_STRUCTURE(udpateActivity());
 }
 
@@ -414,7 +589,10 @@ R_<TG, TA>::cancelledByEntryGuards(const Requests& pendingRequests) {
 							  _planData,
 							  _requests,
 							  pendingRequests,
-							  HFSM_LOGGER_OR(_logger, nullptr)};
+							  HFSM_LOGGER_OR(_logger, nullptr)
+							  HFSM_IF_PROFILER(, _profiler)
+							  HFSM_IF_STATISTICS(, _statistics)
+							  HFSM_IF_TIMERS(, _timers)};
 
 	if (_apex.deepEntryGuard(guardControl)) {
 		HFSM_IF_TRANSITION_HISTORY(recordRequestsAs(Method::ENTRY_GUARD));
@@ -435,14 +613,19 @@ R_<TG, TA>::cancelledByGuards(const Requests& pendingRequests) {
 							  _planData,
 							  _requests,
 							  pendingRequests,
-							  HFSM_LOGGER_OR(_logger, nullptr)};
+							  HFSM_LOGGER_OR(_logger, nullptr)
+							  HFSM_IF_PROFILER(, _profiler)
+							  HFSM_IF_STATISTICS(, _statistics)
+							  HFSM_IF_TIMERS(, _timers)};
 
 	if (_apex.deepForwardExitGuard(guardControl)) {
 		HFSM_IF_TRANSITION_HISTORY(recordRequestsAs(Method::EXIT_GUARD));
+		HFSM_IF_TRANSITION_TRACE(traceRequests(pendingRequests, Method::EXIT_GUARD));
 
 		return true;
 	} else if (_apex.deepForwardEntryGuard(guardControl)) {
 		HFSM_IF_TRANSITION_HISTORY(recordRequestsAs(Method::ENTRY_GUARD));
+		HFSM_IF_TRANSITION_TRACE(traceRequests(pendingRequests, Method::ENTRY_GUARD));
 
 		return true;
 	} else
@@ -454,15 +637,16 @@ R_<TG, TA>::cancelledByGuards(const Requests& pendingRequests) {
 #ifdef HFSM_ENABLE_STRUCTURE_REPORT
 
 template <typename TG, typename TA>
-void
-R_<TG, TA>::getStateNames() {
-	_stateInfos.clear();
-	_apex.deepGetNames((LongIndex) -1, StructureStateInfo::COMPOSITE, 0, _stateInfos);
+R_<TG, TA>::StructureReport::StructureReport(const MaterialApex& apex) {
+	apex.deepGetNames((LongIndex) -1, StructureStateInfo::COMPOSITE, 0, stateInfos);
+
+	for (LongIndex s = 0; s < STATE_COUNT; ++s)
+		entries[s] = INVALID_LONG_INDEX;
 
 	LongIndex margin = (LongIndex) -1;
-	for (LongIndex s = 0; s < _stateInfos.count(); ++s) {
-		const auto& state = _stateInfos[s];
-		auto& prefix      = _prefixes[s];
+	for (LongIndex s = 0; s < stateInfos.count(); ++s) {
+		const auto& state = stateInfos[s];
+		auto& prefix      = prefixes[s];
 
 		if (margin > state.depth && state.name[0] != '\0')
 			margin = state.depth;
@@ -480,7 +664,7 @@ R_<TG, TA>::getStateNames() {
 				prefix[d - 1] = L' ';
 
 			for (auto r = s; r > state.parent; --r) {
-				auto& prefixAbove = _prefixes[r - 1];
+				auto& prefixAbove = prefixes[r - 1];
 
 				switch (prefixAbove[mark]) {
 				case L' ':
@@ -499,17 +683,16 @@ R_<TG, TA>::getStateNames() {
 	if (margin > 0)
 		margin -= 1;
 
-	_structure.clear();
-	for (LongIndex s = 0; s < _stateInfos.count(); ++s) {
-		const auto& state = _stateInfos[s];
-		auto& prefix = _prefixes[s];
+	for (LongIndex s = 0; s < stateInfos.count(); ++s) {
+		const auto& state = stateInfos[s];
+		auto& prefix = prefixes[s];
 		const LongIndex space = state.depth * 2;
 
 		if (state.name[0] != L'\0') {
-			_structure.append(StructureEntry{false, &prefix[margin * 2], state.name});
-			_activityHistory.append((char) 0);
-		} else if (s + 1 < _stateInfos.count()) {
-			auto& nextPrefix = _prefixes[s + 1];
+			entries[s] = structure.count();
+			structure.append(StructureEntry{false, &prefix[margin * 2], state.name});
+		} else if (s + 1 < stateInfos.count()) {
+			auto& nextPrefix = prefixes[s + 1];
 
 			if (s > 0)
 				for (LongIndex c = 0; c <= space; ++c)
@@ -531,29 +714,70 @@ R_<TG, TA>::getStateNames() {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+template <typename TG, typename TA>
+const typename R_<TG, TA>::StructureReport&
+R_<TG, TA>::structureReport(const MaterialApex& apex) {
+	static const StructureReport report{apex};
+
+	return report;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+void
+R_<TG, TA>::structure(Structure& entries) const {
+	entries.clear();
+
+	for (LongIndex i = 0; i < _structureReport.structure.count(); ++i) {
+		StructureEntry entry = _structureReport.structure[i];
+		entry.isActive = _activityBits.get(i);
+
+		entries.append(entry);
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+const typename R_<TG, TA>::ActivityHistory&
+R_<TG, TA>::activityHistory() const {
+	for (LongIndex i = 0; i < _activityHistory.count(); ++i) {
+		const uint32_t streak = _activityTick - _activitySince[i];
+
+		if (_activityBits.get(i))
+			_activityHistory[i] = streak < INT8_MAX ? (char)  streak : (char) INT8_MAX;
+		else
+			_activityHistory[i] = streak < 128		? (char) -(int) streak : (char) INT8_MIN;
+	}
+
+	return _activityHistory;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
 template <typename TG, typename TA>
 void
 R_<TG, TA>::udpateActivity() {
-	for (LongIndex s = 0, i = 0; s < _stateInfos.count(); ++s)
-		if (_stateInfos[s].name[0] != L'\0') {
-			_structure[i].isActive = isActive(s);
+	++_activityTick;
 
-			auto& activity = _activityHistory[i];
+	auto& changes = _planData.activityChanges;
 
-			if (_structure[i].isActive) {
-				if (activity < 0)
-					activity = +1;
-				else
-					activity = activity < INT8_MAX ? activity + 1 : activity;
-			} else {
-				if (activity > 0)
-					activity = -1;
-				else
-					activity = activity > INT8_MIN ? activity - 1 : activity;
-			}
+	for (LongIndex c = 0; c < changes.states.count(); ++c) {
+		const StateID stateId = changes.states[c];
+		const LongIndex i = _structureReport.entries[stateId];
 
-			++i;
+		if (i != INVALID_LONG_INDEX && isActive(stateId) != _activityBits.get(i)) {
+			if (_activityBits.get(i))
+				_activityBits.reset(i);
+			else
+				_activityBits.set(i);
+
+			_activitySince[i] = _activityTick - 1;
 		}
+	}
+
+	changes.clear();
 }
 
 #endif
@@ -566,7 +790,96 @@ template <typename TG, typename TA>
 void
 R_<TG, TA>::recordRequestsAs(const Method method) {
 	for (const auto& request : _requests)
-		_transitionHistory.append(Transition{request, method});
+		if (HFSM_CHECKED(_transitionHistory.count() < TransitionHistory::CAPACITY))
+			_transitionHistory.append(Transition{request, method});
+}
+
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_TRANSITION_TRACE
+
+template <typename TG, typename TA>
+void
+R_<TG, TA>::traceRequests(const Requests& requests,
+						  const Method method)
+{
+	if (_trace)
+		for (const auto& request : requests)
+			_trace->record(TraceRecord{_tick,
+									   _traceInstance,
+									   request.origin,
+									   request.stateId,
+									   convert(request.type),
+									   method});
+}
+
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_STATISTICS
+
+template <typename TG, typename TA>
+void
+R_<TG, TA>::attachStatistics(Statistics* const statistics) {
+	_statistics = statistics;
+
+	if (_statistics)
+		for (StateID s = 0; s < STATE_COUNT; ++s)
+			if (isActive(s))
+				_statistics->recordEnter(s);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+void
+R_<TG, TA>::countRequests(const Requests& requests,
+						  const bool cancelled)
+{
+	if (_statistics)
+		for (const auto& request : requests)
+			if (request.type != Request::SCHEDULE) {
+				if (cancelled)
+					_statistics->recordCancelled(request.stateId);
+				else
+					_statistics->recordTransition(request.origin, request.stateId);
+			}
+}
+
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_WATCHDOG
+
+template <typename TG, typename TA>
+void
+R_<TG, TA>::watchRounds(const LongIndex rounds) {
+	if (_watchdog.recordRounds(rounds, _requests.count() != 0)) {
+		HFSM_IF_LOGGER(if (_logger) _logger->recordWatchdogEvent(_context,
+																 WatchdogEvent::SUBSTITUTION_LIMIT,
+																 INVALID_STATE_ID,
+																 INVALID_STATE_ID));
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+void
+R_<TG, TA>::watchRequests(const Requests& requests) {
+	for (const auto& request : requests)
+		if (request.type != Request::SCHEDULE &&
+			_watchdog.recordTransition(request.origin, request.stateId))
+		{
+			HFSM_IF_LOGGER(if (_logger) _logger->recordWatchdogEvent(_context,
+																	 WatchdogEvent::OSCILLATION,
+																	 request.origin,
+																	 request.stateId));
+		}
 }
 
 #endif
@@ -13,18 +13,24 @@ class ControlT {
 	template <typename, typename, Strategy, typename, typename...>
 	friend struct C_;
 
-	template <typename, typename, typename, typename...>
+	template <typename, typename, Execution, typename, typename...>
 	friend struct O_;
 
 	template <typename, typename>
 	friend class R_;
 
+	template <typename>
+	friend class RuntimeR_;
+
 	using Args			= TArgs;
 
 protected:
 	using Context		= typename Args::Context;
 	using RNG			= typename Args::RNG;
 	using Logger		= typename Args::Logger;
+	HFSM_IF_PROFILER(using Profiler = typename Args::Profiler);
+	HFSM_IF_STATISTICS(using Statistics = typename Args::Statistics);
+	HFSM_IF_TIMERS(using Timers = typename Args::Timers);
 	using StateList		= typename Args::StateList;
 	using RegionList	= typename Args::RegionList;
 
@@ -50,12 +56,18 @@ protected:
 						 RNG& rng,
 						 Registry& registry,
 						 PlanData& planData,
-						 Logger* const HFSM_IF_LOGGER(logger))
+						 Logger* const HFSM_IF_LOGGER(logger)
+						 HFSM_IF_PROFILER(, Profiler* const profiler)
+						 HFSM_IF_STATISTICS(, Statistics* const statistics)
+						 HFSM_IF_TIMERS(, Timers& timers))
 		: _context{context}
 		, _rng{rng}
 		, _registry{registry}
 		, _planData{planData}
 		HFSM_IF_LOGGER(, _logger{logger})
+		HFSM_IF_PROFILER(, _profiler{profiler})
+		HFSM_IF_STATISTICS(, _statistics{statistics})
+		HFSM_IF_TIMERS(, _timers{timers})
 	{}
 
 
@@ -99,11 +111,30 @@ public:
 	template <typename TRegion>
 	HFSM_INLINE ConstPlan plan() const						{ return ConstPlan{_planData, regionId<TRegion>()};	}
 
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_COROUTINES
+	// Frame allocator of CoTask coroutines taking this control as an argument
+	HFSM_INLINE CoroutineArena& coroutineArena() {
+		HFSM_IF_PARALLEL(HFSM_ASSERT(!_planData.forked));
+
+		return _planData.coroutines.arena();
+	}
+#endif
+
 protected:
 #if defined HFSM_ENABLE_LOG_INTERFACE || defined HFSM_ENABLE_VERBOSE_DEBUG_LOG
 	HFSM_INLINE Logger* logger()							{ return _logger;									}
 #endif
 
+#ifdef HFSM_ENABLE_PROFILER
+	HFSM_INLINE Profiler* profiler()						{ return _profiler;									}
+#endif
+
+#ifdef HFSM_ENABLE_STATISTICS
+	HFSM_INLINE Statistics* statistics()					{ return _statistics;								}
+#endif
+
 protected:
 	Context& _context;
 	RNG& _rng;
@@ -111,6 +142,9 @@ protected:
 	PlanData& _planData;
 	RegionID _regionId = 0;
 	HFSM_IF_LOGGER(Logger* _logger);
+	HFSM_IF_PROFILER(Profiler* _profiler);
+	HFSM_IF_STATISTICS(Statistics* _statistics);
+	HFSM_IF_TIMERS(Timers& _timers);
 };
 
 //------------------------------------------------------------------------------
@@ -125,12 +159,15 @@ class PlanControlT
 	template <typename, typename, Strategy, typename, typename...>
 	friend struct C_;
 
-	template <typename, typename, typename, typename...>
+	template <typename, typename, Execution, typename, typename...>
 	friend struct O_;
 
 	template <typename, typename>
 	friend class R_;
 
+	template <typename>
+	friend class RuntimeR_;
+
 	using Args			= TArgs;
 
 protected:
@@ -181,6 +218,10 @@ protected:
 	HFSM_INLINE void setRegion  (const RegionID id, const StateID index, const LongIndex size);
 	HFSM_INLINE void resetRegion(const RegionID id, const StateID index, const LongIndex size);
 
+#ifdef HFSM_ENABLE_TIMERS
+	HFSM_INLINE void setTimer(const Request::Type type, const StateID id, const uint32_t ticks);
+#endif
+
 public:
 	using Control::stateId;
 	using Control::regionId;
@@ -208,10 +249,70 @@ public:
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+#ifdef HFSM_ENABLE_TIMERS
+	// Request a transition on behalf of the current state after 'ticks' update() calls
+	//  Each state owns a single timer, arming it again replaces the previous one
+	//  The timer is cancelled when the state exits
+	HFSM_INLINE void changeAfter   (const StateID id, const uint32_t ticks)	{ setTimer(Request::CHANGE,	 id, ticks);	}
+	HFSM_INLINE void restartAfter  (const StateID id, const uint32_t ticks)	{ setTimer(Request::RESTART,	 id, ticks);	}
+	HFSM_INLINE void resumeAfter   (const StateID id, const uint32_t ticks)	{ setTimer(Request::RESUME,	 id, ticks);	}
+	HFSM_INLINE void utilizeAfter  (const StateID id, const uint32_t ticks)	{ setTimer(Request::UTILIZE,	 id, ticks);	}
+	HFSM_INLINE void randomizeAfter(const StateID id, const uint32_t ticks)	{ setTimer(Request::RANDOMIZE, id, ticks);	}
+
+	template <typename T>
+	HFSM_INLINE void changeAfter   (const uint32_t ticks)	{ changeAfter	(Control::template stateId<T>(), ticks);	}
+
+	template <typename T>
+	HFSM_INLINE void restartAfter  (const uint32_t ticks)	{ restartAfter	(Control::template stateId<T>(), ticks);	}
+
+	template <typename T>
+	HFSM_INLINE void resumeAfter   (const uint32_t ticks)	{ resumeAfter	(Control::template stateId<T>(), ticks);	}
+
+	template <typename T>
+	HFSM_INLINE void utilizeAfter  (const uint32_t ticks)	{ utilizeAfter	(Control::template stateId<T>(), ticks);	}
+
+	template <typename T>
+	HFSM_INLINE void randomizeAfter(const uint32_t ticks)	{ randomizeAfter(Control::template stateId<T>(), ticks);	}
+
+	HFSM_INLINE void cancelTimer();
+
+	HFSM_INLINE bool isTimerPending() const					{ return _timers.pending(_originId);				}
+
+	// Ticks left until the current state's timer fires, 0 if it isn't armed
+	HFSM_INLINE uint32_t timerRemaining() const				{ return _timers.remaining(_originId);				}
+#endif
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_PAYLOADS
+	// Payload of the pending transition into the current state,
+	//  readable from entryGuard() and enter()
+	//  nullptr if there is none, or it was sent with a different type
+	template <typename TPayload>
+	HFSM_INLINE const TPayload* payload() const	{ return _planData.payloads.template find<TPayload>(_originId);	}
+#endif
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_COROUTINES
+	using Control::coroutineArena;
+
+	// Attach 'task' to the current state, replacing the one it had
+	//  The task runs up to its first co_await right away, and is destroyed when the state exits
+	//  Its completion counts as succeed() of the state, reported from the next update() / react() of the state
+	//  Returns false if the task's frame didn't fit into the arena
+	HFSM_INLINE bool spawn(CoTask&& task);
+
+	HFSM_INLINE bool isTaskRunning() const					{ return _planData.coroutines.running(_originId);					}
+#endif
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
 protected:
 	using Control::_planData;
 	using Control::_regionId;
 	HFSM_IF_LOGGER(using Control::_logger);
+	HFSM_IF_TIMERS(using Control::_timers);
 
 	StateID _originId = 0;
 	StateID _regionIndex = 0;
@@ -231,12 +332,15 @@ class FullControlT
 	template <typename, typename, Strategy, typename, typename...>
 	friend struct C_;
 
-	template <typename, typename, typename, typename...>
+	template <typename, typename, Execution, typename, typename...>
 	friend struct O_;
 
 	template <typename, typename>
 	friend class R_;
 
+	template <typename>
+	friend class RuntimeR_;
+
 	using Args			= TArgs;
 
 protected:
@@ -245,6 +349,9 @@ protected:
 	using typename PlanControl::Context;
 	using typename PlanControl::RNG;
 	using typename PlanControl::Logger;
+	HFSM_IF_PROFILER(using typename PlanControl::Profiler);
+	HFSM_IF_STATISTICS(using typename PlanControl::Statistics);
+	HFSM_IF_TIMERS(using typename PlanControl::Timers);
 	using typename PlanControl::StateList;
 	using typename PlanControl::RegionList;
 	using typename PlanControl::PlanData;
@@ -255,6 +362,16 @@ protected:
 	using Registry		= RegistryT<Args>;
 	using Requests		= RequestsT<Args::COMPO_REGIONS>;
 
+#ifdef HFSM_ENABLE_PARALLEL
+	using TasksBits		= BitArray<StateID, StateList::SIZE>;
+
+	// Task statuses set by a ParallelOrthogonal<> sub-state while it runs
+	struct ProngTasks {
+		TasksBits successes;
+		TasksBits failures;
+	};
+#endif
+
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 	struct Lock {
@@ -271,11 +388,33 @@ protected:
 							 Registry& registry,
 							 PlanData& planData,
 							 Requests& requests,
-							 Logger* const logger)
-		: PlanControl{context, rng, registry, planData, logger}
+							 Logger* const logger
+							 HFSM_IF_PROFILER(, Profiler* const profiler)
+							 HFSM_IF_STATISTICS(, Statistics* const statistics)
+							 HFSM_IF_TIMERS(, Timers& timers))
+		: PlanControl{context, rng, registry, planData, logger
+					  HFSM_IF_PROFILER(, profiler)
+					  HFSM_IF_STATISTICS(, statistics)
+					  HFSM_IF_TIMERS(, timers)}
 		, _requests{requests}
 	{}
 
+#ifdef HFSM_ENABLE_PARALLEL
+	// Control of a ParallelOrthogonal<> sub-state, collecting into its own buffers
+	HFSM_INLINE FullControlT(const FullControlT& control,
+							 Requests& requests,
+							 ProngTasks& tasks)
+		: PlanControl{control}
+		, _requests{requests}
+		, _locked{control._locked}
+		, _prongTasks{&tasks}
+	{}
+#endif
+
+	HFSM_INLINE void setSucceeded(const StateID stateId);
+	HFSM_INLINE void setFailed	 (const StateID stateId);
+	HFSM_INLINE bool hasSucceeded(const StateID stateId) const;
+
 	template <typename TState>
 	Status updatePlan(TState& headState, const Status subStatus);
 
@@ -327,6 +466,19 @@ public:
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+#ifdef HFSM_ENABLE_PAYLOADS
+	// Transition carrying 'payload' to the destination, copied inline into a slot
+	//  sized by ConfigT<>::PayloadSizeN<>, dropped if the transition is cancelled
+	//  With all slots taken, asserts and doesn't request the transition
+	template <typename TPayload>
+	HFSM_INLINE void changeTo (const StateID id, const TPayload& payload);
+
+	template <typename T, typename TPayload>
+	HFSM_INLINE void changeTo (const TPayload& payload)		{ changeTo (PlanControl::template stateId<T>(), payload);	}
+#endif
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
 	HFSM_INLINE void succeed();
 	HFSM_INLINE void fail();
 
@@ -344,6 +496,8 @@ protected:
 
 	Requests& _requests;
 	bool _locked = false;
+
+	HFSM_IF_PARALLEL(ProngTasks* const _prongTasks = nullptr);
 };
 
 //------------------------------------------------------------------------------
@@ -358,12 +512,18 @@ class GuardControlT final
 	template <typename, typename>
 	friend class R_;
 
+	template <typename>
+	friend class RuntimeR_;
+
 	using Args			= TArgs;
 	using FullControl	= FullControlT<Args>;
 
 	using typename FullControl::Context;
 	using typename FullControl::RNG;
 	using typename FullControl::Logger;
+	HFSM_IF_PROFILER(using typename FullControl::Profiler);
+	HFSM_IF_STATISTICS(using typename FullControl::Statistics);
+	HFSM_IF_TIMERS(using typename FullControl::Timers);
 	using typename FullControl::StateList;
 	using typename FullControl::RegionList;
 	using typename FullControl::PlanData;
@@ -382,8 +542,14 @@ private:
 							  PlanData& planData,
 							  Requests& requests,
 							  const Requests& pendingChanges,
-							  Logger* const logger)
-		: FullControl{context, rng, registry, planData, requests, logger}
+							  Logger* const logger
+							  HFSM_IF_PROFILER(, Profiler* const profiler)
+							  HFSM_IF_STATISTICS(, Statistics* const statistics)
+							  HFSM_IF_TIMERS(, Timers& timers))
+		: FullControl{context, rng, registry, planData, requests, logger
+					  HFSM_IF_PROFILER(, profiler)
+					  HFSM_IF_STATISTICS(, statistics)
+					  HFSM_IF_TIMERS(, timers)}
 		, _pending{pendingChanges}
 	{}
 
@@ -135,6 +135,51 @@ PlanControlT<TArgs>::resetRegion(const RegionID id, //-V524
 	_regionSize	 = size;
 }
 
+//------------------------------------------------------------------------------
+
+#ifdef HFSM_ENABLE_TIMERS
+
+// The timer wheel is shared, ParallelOrthogonal<> sub-states can't touch it
+
+template <typename TArgs>
+void
+PlanControlT<TArgs>::setTimer(const Request::Type type,
+							  const StateID id,
+							  const uint32_t ticks)
+{
+	HFSM_IF_PARALLEL(HFSM_ASSERT(!_planData.forked));
+
+	_timers.set(_originId, type, id, ticks);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TArgs>
+void
+PlanControlT<TArgs>::cancelTimer() {
+	HFSM_IF_PARALLEL(HFSM_ASSERT(!_planData.forked));
+
+	_timers.cancel(_originId);
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+
+#ifdef HFSM_ENABLE_COROUTINES
+
+// Replacing a task frees its frame back into the shared arena
+
+template <typename TArgs>
+bool
+PlanControlT<TArgs>::spawn(CoTask&& task) {
+	HFSM_IF_PARALLEL(HFSM_ASSERT(!_planData.forked));
+
+	return _planData.coroutines.spawn(_originId, std::move(task));
+}
+
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 
 template <typename TArgs>
@@ -155,6 +200,48 @@ FullControlT<TArgs>::Lock::~Lock() {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+template <typename TArgs>
+void
+FullControlT<TArgs>::setSucceeded(const StateID stateId) {
+#ifdef HFSM_ENABLE_PARALLEL
+	if (_prongTasks) {
+		_prongTasks->successes.set(stateId);
+
+		return;
+	}
+#endif
+
+	_planData.tasksSuccesses.set(stateId);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TArgs>
+void
+FullControlT<TArgs>::setFailed(const StateID stateId) {
+#ifdef HFSM_ENABLE_PARALLEL
+	if (_prongTasks) {
+		_prongTasks->failures.set(stateId);
+
+		return;
+	}
+#endif
+
+	_planData.tasksFailures.set(stateId);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TArgs>
+bool
+FullControlT<TArgs>::hasSucceeded(const StateID stateId) const {
+	HFSM_IF_PARALLEL(if (_prongTasks && _prongTasks->successes.get(stateId)) return true);
+
+	return _planData.tasksSuccesses.get(stateId);
+}
+
+//------------------------------------------------------------------------------
+
 template <typename TArgs>
 template <typename TState>
 Status
@@ -176,10 +263,36 @@ FullControlT<TArgs>::updatePlan(TState& headState,
 		return buildPlanStatus<State>();
 	} else if (subStatus.result == Status::SUCCESS) {
 		if (Plan p = plan(_regionId)) {
+#ifdef HFSM_ENABLE_STATIC_PLANS
+			auto& entry = _planData.staticPlans.entries[_regionId];
+
+			if (entry.tasks) {
+				for (; entry.cursor < entry.count; ++entry.cursor) {
+					const StaticTask& task = entry.tasks[entry.cursor];
+
+					if (hasSucceeded(task.origin)) {
+						HFSM_ASSERT(isActive(task.origin));
+
+						Origin origin{*this, STATE_ID};
+
+						changeTo(task.destination);
+					} else
+						break;
+				}
+
+				if (entry.cursor == entry.count)
+					_planData.staticPlans.clear(_regionId);
+
+				return Status{};
+			}
+#endif
+
+			// tasks are removed once done, so the first one is always the next pending,
+			//  and success bits are reset on exit, so they imply the origin is active
 			for (auto it = p.first(); it; ++it) {
-				if (isActive(it->origin) &&
-					_planData.tasksSuccesses.get(it->origin))
-				{
+				if (hasSucceeded(it->origin)) {
+					HFSM_ASSERT(isActive(it->origin));
+
 					Origin origin{*this, STATE_ID};
 
 					changeTo(it->destination);
@@ -215,13 +328,13 @@ FullControlT<TArgs>::buildPlanStatus() {
 		break;
 
 	case Status::SUCCESS:
-		_planData.tasksSuccesses.template set<STATE_ID>();
+		setSucceeded(STATE_ID);
 
 		HFSM_LOG_PLAN_STATUS(context(), _regionId, StatusEvent::SUCCEEDED);
 		break;
 
 	case Status::FAILURE:
-		_planData.tasksFailures.template set<STATE_ID>();
+		setFailed(STATE_ID);
 
 		HFSM_LOG_PLAN_STATUS(context(), _regionId, StatusEvent::FAILED);
 		break;
@@ -239,7 +352,7 @@ template <typename TArgs>
 void
 FullControlT<TArgs>::changeTo(const StateID stateId) {
 	if (!_locked) {
-		_requests.append(Request{Request::Type::CHANGE, stateId});
+		_requests.append(Request{Request::Type::CHANGE, stateId, _originId});
 
 		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
 			_status.outerTransition = true;
@@ -248,13 +361,31 @@ FullControlT<TArgs>::changeTo(const StateID stateId) {
 	}
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_PAYLOADS
+
+template <typename TArgs>
+template <typename TPayload>
+void
+FullControlT<TArgs>::changeTo(const StateID stateId,
+							  const TPayload& payload)
+{
+	HFSM_IF_PARALLEL(HFSM_ASSERT(!_prongTasks));
+
+	if (!_locked && HFSM_CHECKED(_planData.payloads.stage(stateId, payload)))
+		changeTo(stateId);
+}
+
+#endif
+
 //------------------------------------------------------------------------------
 
 template <typename TArgs>
 void
 FullControlT<TArgs>::restart(const StateID stateId) {
 	if (!_locked) {
-		_requests.append(Request{Request::Type::RESTART, stateId});
+		_requests.append(Request{Request::Type::RESTART, stateId, _originId});
 
 		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
 			_status.outerTransition = true;
@@ -269,7 +400,7 @@ template <typename TArgs>
 void
 FullControlT<TArgs>::resume(const StateID stateId) {
 	if (!_locked) {
-		_requests.append(Request{Request::Type::RESUME, stateId});
+		_requests.append(Request{Request::Type::RESUME, stateId, _originId});
 
 		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
 			_status.outerTransition = true;
@@ -284,7 +415,7 @@ template <typename TArgs>
 void
 FullControlT<TArgs>::utilize(const StateID stateId) {
 	if (!_locked) {
-		_requests.append(Request{Request::Type::UTILIZE, stateId});
+		_requests.append(Request{Request::Type::UTILIZE, stateId, _originId});
 
 		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
 			_status.outerTransition = true;
@@ -299,7 +430,7 @@ template <typename TArgs>
 void
 FullControlT<TArgs>::randomize(const StateID stateId) {
 	if (!_locked) {
-		_requests.append(Request{Request::Type::RANDOMIZE, stateId});
+		_requests.append(Request{Request::Type::RANDOMIZE, stateId, _originId});
 
 		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
 			_status.outerTransition = true;
@@ -313,7 +444,7 @@ FullControlT<TArgs>::randomize(const StateID stateId) {
 template <typename TArgs>
 void
 FullControlT<TArgs>::schedule(const StateID stateId) {
-	_requests.append(Request{Request::Type::SCHEDULE, stateId});
+	_requests.append(Request{Request::Type::SCHEDULE, stateId, _originId});
 
 	HFSM_LOG_TRANSITION(context(), _originId, TransitionType::SCHEDULE, stateId);
 }
@@ -325,13 +456,13 @@ void
 FullControlT<TArgs>::succeed() {
 	_status.result = Status::SUCCESS;
 
-	_planData.tasksSuccesses.set(_originId);
+	setSucceeded(_originId);
 
 	// TODO: promote taskSuccess all the way up for all regions without plans
 	if (_regionId < RegionList::SIZE && !_planData.planExists.get(_regionId)) {
 		HFSM_ASSERT(_regionIndex < StateList::SIZE);
 
-		_planData.tasksSuccesses.set(_regionIndex);
+		setSucceeded(_regionIndex);
 	}
 
 	HFSM_LOG_TASK_STATUS(context(), _regionId, _originId, StatusEvent::SUCCEEDED);
@@ -344,13 +475,13 @@ void
 FullControlT<TArgs>::fail() {
 	_status.result = Status::FAILURE;
 
-	_planData.tasksFailures.set(_originId);
+	setFailed(_originId);
 
 	// TODO: promote taskFailure all the way up for all regions without plans
 	if (_regionId < RegionList::SIZE && !_planData.planExists.get(_regionId)) {
 		HFSM_ASSERT(_regionIndex < StateList::SIZE);
 
-		_planData.tasksFailures.set(_regionIndex);
+		setFailed(_regionIndex);
 	}
 
 	HFSM_LOG_TASK_STATUS(context(), _regionId, _originId, StatusEvent::FAILED);
@@ -0,0 +1,229 @@
+#pragma once
+
+#ifdef HFSM_ENABLE_COROUTINES
+
+namespace hfsm2 {
+
+namespace detail {
+
+template <LongIndex, LongIndex>
+class CoroutinesT;
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+// First fit frame allocator over a fixed buffer owned by the machine
+//  Free blocks are kept sorted by address and merged with their neighbours
+
+class CoroutineArena {
+	struct alignas(std::max_align_t) Header {
+		CoroutineArena* arena;
+		size_t size;
+	};
+
+	struct Block {
+		size_t size;
+		Block* next;
+	};
+
+public:
+	static constexpr size_t ALIGNMENT = alignof(std::max_align_t);
+
+	HFSM_INLINE void attach(void* const buffer, const size_t size);
+
+	// nullptr if no free block is large enough
+	HFSM_INLINE void* allocate(const size_t size);
+
+	static HFSM_INLINE void deallocate(void* const pointer);
+
+	HFSM_INLINE size_t used() const										{ return _used;							}
+	HFSM_INLINE size_t capacity() const									{ return _capacity;						}
+
+private:
+	HFSM_INLINE void release(Header* const header);
+
+private:
+	Block* _free = nullptr;
+	size_t _capacity = 0;
+	size_t _used = 0;
+};
+
+//------------------------------------------------------------------------------
+
+// Return type of state coroutines, attached to a state with PlanControl::spawn()
+//  One of the coroutine's arguments has to be a control, its frame is allocated
+//  from the machine's arena instead of the heap
+//  The control argument is only used for the allocation, don't access it after the first co_await
+
+class CoTask {
+	template <LongIndex, LongIndex>
+	friend class detail::CoroutinesT;
+
+public:
+	struct promise_type;
+	using Handle = std::coroutine_handle<promise_type>;
+
+	HFSM_INLINE CoTask() = default;
+
+	HFSM_INLINE CoTask(CoTask&& other) noexcept
+		: _handle{other._handle}
+	{
+		other._handle = nullptr;
+	}
+
+	CoTask(const CoTask&) = delete;
+	CoTask& operator = (const CoTask&) = delete;
+
+	HFSM_INLINE ~CoTask()												{ if (_handle) _handle.destroy();		}
+
+	// false if the frame didn't fit into the arena
+	HFSM_INLINE explicit operator bool() const							{ return (bool) _handle;				}
+
+private:
+	HFSM_INLINE explicit CoTask(const Handle handle)
+		: _handle{handle}
+	{}
+
+	Handle _handle;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+namespace detail {
+
+template <typename T>
+concept CoroutineArenaSource = requires(T& argument) { argument.coroutineArena(); };
+
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct CoTask::promise_type {
+	enum class Wait : uint8_t {
+		NONE,
+		TICKS,
+		EVENT,
+	};
+
+	HFSM_INLINE CoTask get_return_object() noexcept						{ return CoTask{Handle::from_promise(*this)};	}
+	static HFSM_INLINE CoTask get_return_object_on_allocation_failure() noexcept	{ return CoTask{};		}
+
+	HFSM_INLINE std::suspend_always initial_suspend() noexcept			{ return {};							}
+	HFSM_INLINE std::suspend_always final_suspend() noexcept			{ return {};							}
+
+	HFSM_INLINE void return_void() noexcept								{}
+	HFSM_INLINE void unhandled_exception() noexcept						{ std::terminate();						}
+
+	template <typename... TArgs>
+	static HFSM_INLINE void* operator new(const size_t size, TArgs&... args) noexcept;
+
+	static HFSM_INLINE void operator delete(void* const pointer) noexcept	{ CoroutineArena::deallocate(pointer);	}
+
+	// matches operator new() above
+	template <typename... TArgs>
+	static HFSM_INLINE void operator delete(void* const pointer, TArgs&...) noexcept	{ CoroutineArena::deallocate(pointer);	}
+
+	Wait wait = Wait::NONE;
+	uint32_t ticks = 0;
+	const void* eventType = nullptr;
+	const void* event = nullptr;
+	bool reported = false;
+};
+
+//------------------------------------------------------------------------------
+
+struct TicksAwaiter {
+	HFSM_INLINE bool await_ready() const noexcept						{ return ticks == 0;					}
+	HFSM_INLINE void await_suspend(const CoTask::Handle handle) const noexcept;
+	HFSM_INLINE void await_resume() const noexcept						{}
+
+	uint32_t ticks;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TEvent>
+struct EventAwaiterT {
+	HFSM_INLINE bool await_ready() const noexcept						{ return false;							}
+	HFSM_INLINE void await_suspend(const CoTask::Handle handle) noexcept;
+	HFSM_INLINE TEvent await_resume() const;
+
+	const CoTask::promise_type* promise = nullptr;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+// Resume on the next update() of the task's state
+HFSM_INLINE TicksAwaiter nextTick()										{ return TicksAwaiter{1};				}
+
+// Resume after 'ticks' update() calls of the task's state, in the same units as timers
+HFSM_INLINE TicksAwaiter timeout(const uint32_t ticks)					{ return TicksAwaiter{ticks};			}
+
+// Resume with a copy of the next 'TEvent' react()-ed by the task's state
+template <typename TEvent>
+HFSM_INLINE EventAwaiterT<TEvent> event()								{ return EventAwaiterT<TEvent>{};		}
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+// Coroutine tasks of the machine's states, a single one per state
+
+template <LongIndex NArenaSize, LongIndex NStateCount>
+class CoroutinesT {
+	using Handle  = CoTask::Handle;
+	using Wait	  = CoTask::promise_type::Wait;
+
+public:
+	static constexpr LongIndex ARENA_SIZE  = NArenaSize;
+	static constexpr LongIndex STATE_COUNT = NStateCount;
+
+	static_assert(ARENA_SIZE > 0, "Set the arena size with ConfigT<>::CoroutineArenaN<>");
+
+	HFSM_INLINE CoroutinesT()											{ _arena.attach(_storage, ARENA_SIZE);	}
+	HFSM_INLINE ~CoroutinesT();
+
+	CoroutinesT(const CoroutinesT&) = delete;
+	CoroutinesT& operator = (const CoroutinesT&) = delete;
+
+	HFSM_INLINE		  CoroutineArena& arena()							{ return _arena;						}
+	HFSM_INLINE const CoroutineArena& arena() const						{ return _arena;						}
+
+	// Replaces the task of 'stateId' and runs it up to its first co_await
+	//  Returns false for a task which failed to allocate
+	HFSM_INLINE bool spawn(const StateID stateId, CoTask&& task);
+
+	// Resume the task of 'stateId' if it's waiting for ticks,
+	//  returns true once after it completes
+	HFSM_INLINE bool update(const StateID stateId);
+
+	// Resume the task of 'stateId' if it's waiting for 'TEvent',
+	//  returns true once after it completes
+	template <typename TEvent>
+	HFSM_INLINE bool react(const StateID stateId, const TEvent& event);
+
+	HFSM_INLINE void destroy(const StateID stateId);
+
+	HFSM_INLINE bool running(const StateID stateId) const;
+
+	// Any task waiting for ticks, or completed and not yet reported
+	HFSM_INLINE bool needsUpdate() const;
+
+private:
+	HFSM_INLINE bool report(const StateID stateId);
+
+private:
+	alignas(std::max_align_t) unsigned char _storage[ARENA_SIZE];
+	CoroutineArena _arena;
+	Handle _handles[STATE_COUNT];
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+#include "coroutines.inl"
+
+#endif
@@ -0,0 +1,304 @@
+namespace hfsm2 {
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline
+void
+CoroutineArena::attach(void* const buffer,
+					   const size_t size)
+{
+	HFSM_ASSERT(reinterpret_cast<uintptr_t>(buffer) % ALIGNMENT == 0);
+
+	_capacity = size - size % ALIGNMENT;
+	_used	  = 0;
+	_free	  = _capacity >= sizeof(Header) + ALIGNMENT ?
+					new (buffer) Block{_capacity, nullptr} : nullptr;
+}
+
+//------------------------------------------------------------------------------
+
+inline
+void*
+CoroutineArena::allocate(const size_t size) {
+	const size_t required = (sizeof(Header) + size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+
+	for (Block** link = &_free; *link; link = &(*link)->next) {
+		Block* const block = *link;
+
+		if (block->size < required)
+			continue;
+
+		size_t taken = block->size;
+
+		// split, unless the rest can't hold a frame
+		if (block->size - required >= sizeof(Header) + ALIGNMENT) {
+			*link = new (reinterpret_cast<unsigned char*>(block) + required)
+						Block{block->size - required, block->next};
+			taken = required;
+		} else
+			*link = block->next;
+
+		_used += taken;
+
+		return new (block) Header{this, taken} + 1;
+	}
+
+	return nullptr;
+}
+
+//------------------------------------------------------------------------------
+
+inline
+void
+CoroutineArena::deallocate(void* const pointer) {
+	HFSM_ASSERT(pointer);
+
+	Header* const header = static_cast<Header*>(pointer) - 1;
+	header->arena->release(header);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+inline
+void
+CoroutineArena::release(Header* const header) {
+	const size_t size = header->size;
+	HFSM_ASSERT(_used >= size);
+	_used -= size;
+
+	Block* const block = new (header) Block{size, nullptr};
+
+	Block* prev = nullptr;
+	Block* next = _free;
+
+	for (; next && next < block; next = next->next)
+		prev = next;
+
+	if (next && reinterpret_cast<unsigned char*>(block) + block->size ==
+				reinterpret_cast<unsigned char*>(next))
+	{
+		block->size += next->size;
+		block->next  = next->next;
+	} else
+		block->next  = next;
+
+	if (prev && reinterpret_cast<unsigned char*>(prev) + prev->size ==
+				reinterpret_cast<unsigned char*>(block))
+	{
+		prev->size += block->size;
+		prev->next  = block->next;
+	} else if (prev)
+		prev->next = block;
+	else
+		_free = block;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename... TArgs>
+void*
+CoTask::promise_type::operator new(const size_t size,
+								   TArgs&... args) noexcept
+{
+	static_assert((detail::CoroutineArenaSource<TArgs> || ...),
+				  "CoTask coroutines need a control argument to allocate from the machine's arena");
+
+	CoroutineArena* arena = nullptr;
+
+	([&] {
+		if constexpr (detail::CoroutineArenaSource<TArgs>)
+			if (!arena)
+				arena = &args.coroutineArena();
+	}(), ...);
+
+	return arena->allocate(size);
+}
+
+//------------------------------------------------------------------------------
+
+inline
+void
+TicksAwaiter::await_suspend(const CoTask::Handle handle) const noexcept {
+	CoTask::promise_type& promise = handle.promise();
+
+	promise.wait  = CoTask::promise_type::Wait::TICKS;
+	promise.ticks = ticks;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TEvent>
+void
+EventAwaiterT<TEvent>::await_suspend(const CoTask::Handle handle) noexcept {
+	CoTask::promise_type& state = handle.promise();
+
+	state.wait		= CoTask::promise_type::Wait::EVENT;
+	state.eventType = &detail::TypeTagT<TEvent>::TAG;
+	state.event		= nullptr;
+
+	promise = &state;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TEvent>
+TEvent
+EventAwaiterT<TEvent>::await_resume() const {
+	HFSM_ASSERT(promise && promise->event);
+
+	return *static_cast<const TEvent*>(promise->event);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+template <LongIndex NA, LongIndex NS>
+CoroutinesT<NA, NS>::~CoroutinesT() {
+	for (Handle& handle : _handles)
+		if (handle)
+			handle.destroy();
+}
+
+//------------------------------------------------------------------------------
+
+template <LongIndex NA, LongIndex NS>
+bool
+CoroutinesT<NA, NS>::spawn(const StateID stateId,
+						   CoTask&& task)
+{
+	HFSM_ASSERT(stateId < STATE_COUNT);
+
+	destroy(stateId);
+
+	if (!task)
+		return false;
+
+	Handle& handle = _handles[stateId];
+	handle = task._handle;
+	task._handle = nullptr;
+
+	handle.resume();
+
+	return true;
+}
+
+//------------------------------------------------------------------------------
+
+template <LongIndex NA, LongIndex NS>
+bool
+CoroutinesT<NA, NS>::update(const StateID stateId) {
+	HFSM_ASSERT(stateId < STATE_COUNT);
+
+	const Handle handle = _handles[stateId];
+
+	if (!handle)
+		return false;
+
+	CoTask::promise_type& promise = handle.promise();
+
+	if (!handle.done() &&
+		promise.wait == Wait::TICKS &&
+		--promise.ticks == 0)
+	{
+		promise.wait = Wait::NONE;
+		handle.resume();
+	}
+
+	return report(stateId);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NA, LongIndex NS>
+template <typename TEvent>
+bool
+CoroutinesT<NA, NS>::react(const StateID stateId,
+						   const TEvent& event)
+{
+	HFSM_ASSERT(stateId < STATE_COUNT);
+
+	const Handle handle = _handles[stateId];
+
+	if (!handle)
+		return false;
+
+	CoTask::promise_type& promise = handle.promise();
+
+	if (!handle.done() &&
+		promise.wait == Wait::EVENT &&
+		promise.eventType == &TypeTagT<TEvent>::TAG)
+	{
+		promise.wait  = Wait::NONE;
+		promise.event = &event;
+		handle.resume();
+	}
+
+	return report(stateId);
+}
+
+//------------------------------------------------------------------------------
+
+template <LongIndex NA, LongIndex NS>
+void
+CoroutinesT<NA, NS>::destroy(const StateID stateId) {
+	HFSM_ASSERT(stateId < STATE_COUNT);
+
+	Handle& handle = _handles[stateId];
+
+	if (handle) {
+		handle.destroy();
+		handle = nullptr;
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NA, LongIndex NS>
+bool
+CoroutinesT<NA, NS>::running(const StateID stateId) const {
+	HFSM_ASSERT(stateId < STATE_COUNT);
+
+	const Handle handle = _handles[stateId];
+
+	return handle && !handle.done();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NA, LongIndex NS>
+bool
+CoroutinesT<NA, NS>::needsUpdate() const {
+	for (const Handle& handle : _handles)
+		if (handle) {
+			const CoTask::promise_type& promise = handle.promise();
+
+			if (handle.done() ?
+					!promise.reported :
+					promise.wait == Wait::TICKS)
+				return true;
+		}
+
+	return false;
+}
+
+//------------------------------------------------------------------------------
+
+template <LongIndex NA, LongIndex NS>
+bool
+CoroutinesT<NA, NS>::report(const StateID stateId) {
+	const Handle handle = _handles[stateId];
+	CoTask::promise_type& promise = handle.promise();
+
+	if (!handle.done() || promise.reported)
+		return false;
+
+	promise.reported = true;
+
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+namespace hfsm2 {
+
+#ifdef HFSM_ENABLE_PARALLEL
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Runs the sub-states of ParallelOrthogonal<> regions, attached with R_::attachExecutor()
+//  Without an executor, the sub-states run one after another on the calling thread
+//  Each sub-state collects its transitions and task statuses separately,
+//  merged in sub-state order once all of them complete,
+//  so the outcome doesn't depend on the order they run in
+//  While they run, sub-states (and everything below them) must not:
+//   - edit plans, or have plans of their own in progress
+//   - arm or cancel timers, or attach payloads to transitions
+//   - spawn coroutine tasks
+//   - write to the context, unless the writes are synchronized by the user
+//  Attached logger, profiler and statistics are called concurrently too
+//  Plan edits, timers, payloads and tasks are asserted with HFSM_ENABLE_ASSERT
+
+struct ExecutorInterface {
+	using Job = void (*)(void* const argument, const LongIndex index);
+
+	// Call 'job(argument, index)' once for each 'index' in [0, count),
+	//  in any order and on any threads, and return once all calls complete
+	virtual void execute(const Job job,
+						 void* const argument,
+						 const LongIndex count) = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+#endif
+
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#ifdef HFSM_ENABLE_PAYLOADS
+
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Transition payloads, stored inline and keyed by the destination state
+//  Each payload is tagged with the transition round it was requested in,
+//  a round cancelled by guards drops its own payloads and nothing else
+
+template <LongIndex NSize, LongIndex NCapacity>
+class PayloadsT {
+public:
+	static constexpr LongIndex SIZE		= NSize;
+	static constexpr LongIndex CAPACITY = NCapacity;
+
+private:
+	using Storage = typename std::aligned_storage<SIZE>::type;
+
+	struct Entry {
+		Storage storage;
+		const void* type;
+		StateID stateId;
+		uint16_t round;
+	};
+
+public:
+	// Replaces the payload already staged for 'stateId', returns false if out of entries
+	template <typename TPayload>
+	HFSM_INLINE bool stage(const StateID stateId, const TPayload& payload);
+
+	// nullptr if nothing is staged for 'stateId', or the payload type differs
+	template <typename TPayload>
+	HFSM_INLINE const TPayload* find(const StateID stateId) const;
+
+	// Close the current round, returns its number
+	HFSM_INLINE uint16_t seal()									{ return _round++;						}
+
+	HFSM_INLINE void discard(const uint16_t round);
+
+	HFSM_INLINE void clear()									{ _count = 0; _round = 0;				}
+
+	HFSM_INLINE LongIndex count() const							{ return _count;						}
+
+private:
+	HFSM_INLINE LongIndex index(const StateID stateId) const;
+
+private:
+	Entry _entries[CAPACITY];
+	LongIndex _count = 0;
+	uint16_t _round = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+#include "payloads.inl"
+
+#endif
@@ -0,0 +1,76 @@
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <LongIndex NS, LongIndex NC>
+template <typename TPayload>
+bool
+PayloadsT<NS, NC>::stage(const StateID stateId,
+						 const TPayload& payload)
+{
+	static_assert(sizeof (TPayload) <= SIZE,				"Payload doesn't fit, increase ConfigT<>::PayloadSizeN<>");
+	static_assert(alignof(TPayload) <= alignof(Storage),	"Payload is over-aligned");
+	static_assert(std::is_trivially_destructible<TPayload>::value, "Payloads are never destroyed");
+
+	LongIndex i = index(stateId);
+
+	if (i == INVALID_LONG_INDEX) {
+		if (_count == CAPACITY)
+			return false;
+
+		i = _count++;
+	}
+
+	Entry& entry = _entries[i];
+
+	new (&entry.storage) TPayload{payload};
+	entry.type	  = &TypeTagT<TPayload>::TAG;
+	entry.stateId = stateId;
+	entry.round	  = _round;
+
+	return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NS, LongIndex NC>
+template <typename TPayload>
+const TPayload*
+PayloadsT<NS, NC>::find(const StateID stateId) const {
+	const LongIndex i = index(stateId);
+
+	if (i != INVALID_LONG_INDEX && _entries[i].type == &TypeTagT<TPayload>::TAG)
+		return reinterpret_cast<const TPayload*>(&_entries[i].storage);
+	else
+		return nullptr;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NS, LongIndex NC>
+void
+PayloadsT<NS, NC>::discard(const uint16_t round) {
+	for (LongIndex i = 0; i < _count; )
+		if (_entries[i].round == round)
+			_entries[i] = _entries[--_count];
+		else
+			++i;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NS, LongIndex NC>
+LongIndex
+PayloadsT<NS, NC>::index(const StateID stateId) const {
+	for (LongIndex i = 0; i < _count; ++i)
+		if (_entries[i].stateId == stateId)
+			return i;
+
+	return INVALID_LONG_INDEX;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
@@ -100,6 +100,7 @@ public:
 
 private:
 	const PlanData& _planData;
+	const RegionID _regionId;
 	const Bounds& _bounds;
 };
 
@@ -224,6 +225,15 @@ public:
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+#ifdef HFSM_ENABLE_STATIC_PLANS
+	// Replace the plan with a PlanTemplate<>, O(1) and without using task links
+	//  Tasks of a template plan aren't visited by first()
+	template <typename TPlanTemplate>
+	HFSM_INLINE void apply();
+#endif
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
 	HFSM_INLINE Iterator first()			{ return Iterator{*this};								}
 
 private:
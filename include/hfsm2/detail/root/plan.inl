@@ -68,6 +68,7 @@ ConstPlanT<TArgs>::ConstPlanT(const PlanData& planData,
 							  const RegionID regionId)
 
 	: _planData{planData}
+	, _regionId{regionId}
 	, _bounds{planData.tasksBounds[regionId]}
 {}
 
@@ -75,6 +76,8 @@ ConstPlanT<TArgs>::ConstPlanT(const PlanData& planData,
 
 template <typename TArgs>
 ConstPlanT<TArgs>::operator bool() const {
+	HFSM_IF_STATIC_PLANS(if (_planData.staticPlans.active(_regionId)) return true);
+
 	if (_bounds.first < TASK_CAPACITY) {
 		HFSM_ASSERT(_bounds.last < TASK_CAPACITY);
 		return true;
@@ -151,6 +154,8 @@ PlanT<TArgs>::PlanT(PlanData& planData,
 
 template <typename TArgs>
 PlanT<TArgs>::operator bool() const {
+	HFSM_IF_STATIC_PLANS(if (_planData.staticPlans.active(_regionId)) return true);
+
 	if (_bounds.first < TASK_CAPACITY) {
 		HFSM_ASSERT(_bounds.last < TASK_CAPACITY);
 		return true;
@@ -168,11 +173,18 @@ PlanT<TArgs>::append(const TransitionType transitionType,
 					 const StateID origin,
 					 const StateID destination)
 {
+	HFSM_IF_PARALLEL(HFSM_ASSERT(!_planData.forked));
+
 	_planData.planExists.set(_regionId);
 
+	HFSM_IF_PLAN_QUOTAS(if (!_planData.planQuotas.acquire(_regionId)) return false);
+
 	const TaskIndex index = _planData.taskLinks.emplace(transitionType, origin, destination);
-	if (index == TaskLinks::INVALID)
+	if (index == TaskLinks::INVALID) {
+		HFSM_IF_PLAN_QUOTAS(_planData.planQuotas.refuse(_regionId));
+
 		return false;
+	}
 
 	if (_bounds.first < TaskLinks::CAPACITY) {
 		HFSM_ASSERT(_bounds.last < TaskLinks::CAPACITY);
@@ -200,8 +212,11 @@ PlanT<TArgs>::append(const TransitionType transitionType,
 template <typename TArgs>
 void
 PlanT<TArgs>::clear() {
+	HFSM_IF_STATIC_PLANS(_planData.staticPlans.clear(_regionId));
+
 	if (_bounds.first < TaskLinks::CAPACITY) {
 		HFSM_ASSERT(_bounds.last < TaskLinks::CAPACITY);
+		HFSM_IF_PARALLEL(HFSM_ASSERT(!_planData.forked));
 
 		for (LongIndex index = _bounds.first;
 			 index != INVALID_LONG_INDEX;
@@ -217,6 +232,7 @@ PlanT<TArgs>::clear() {
 			const LongIndex next = task.next;
 
 			_planData.taskLinks.remove(index);
+			HFSM_IF_PLAN_QUOTAS(_planData.planQuotas.release(_regionId));
 
 			index = next;
 		}
@@ -230,6 +246,28 @@ PlanT<TArgs>::clear() {
 
 //------------------------------------------------------------------------------
 
+#ifdef HFSM_ENABLE_STATIC_PLANS
+
+template <typename TArgs>
+template <typename TPlanTemplate>
+void
+PlanT<TArgs>::apply() {
+	using StaticPlan = StaticPlanT<StateList, TPlanTemplate>;
+
+	clear();
+
+	auto& entry = _planData.staticPlans.entries[_regionId];
+	entry.tasks	 = StaticPlan::TASKS;
+	entry.count	 = (uint16_t) StaticPlan::COUNT;
+	entry.cursor = 0;
+
+	_planData.planExists.set(_regionId);
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+
 template <typename TArgs>
 void
 PlanT<TArgs>::remove(const LongIndex task) {
@@ -238,6 +276,7 @@ PlanT<TArgs>::remove(const LongIndex task) {
 				_bounds.last  < TaskLinks::CAPACITY);
 
 	HFSM_ASSERT(task < TaskLinks::CAPACITY);
+	HFSM_IF_PARALLEL(HFSM_ASSERT(!_planData.forked));
 
 	const TaskLink& curr = _planData.taskLinks[task];
 
@@ -258,6 +297,7 @@ PlanT<TArgs>::remove(const LongIndex task) {
 	}
 
 	_planData.taskLinks.remove(task);
+	HFSM_IF_PLAN_QUOTAS(_planData.planQuotas.release(_regionId));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
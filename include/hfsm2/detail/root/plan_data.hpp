@@ -34,6 +34,187 @@ struct Bounds {
 
 //------------------------------------------------------------------------------
 
+#ifdef HFSM_ENABLE_UPDATE_PERIODS
+
+// Per-region update() rate divisors
+//  A region with period N is updated on every N-th update() while it's active
+
+template <LongIndex NRegionCount>
+struct UpdatePeriodsT {
+	struct Entry {
+		uint16_t period	   = 1;
+		uint16_t countdown = 1;
+	};
+
+	HFSM_INLINE void set(const RegionID regionId,
+						 const uint16_t period,
+						 const uint16_t phase)
+	{
+		HFSM_ASSERT(regionId < NRegionCount);
+
+		Entry& entry = entries[regionId];
+		entry.period	= period ? period : 1;
+		entry.countdown = (uint16_t) (phase % entry.period + 1);
+	}
+
+	HFSM_INLINE bool isDue(const RegionID regionId) {
+		Entry& entry = entries[regionId];
+
+		if (--entry.countdown)
+			return false;
+
+		entry.countdown = entry.period;
+
+		return true;
+	}
+
+	Entry entries[NRegionCount];
+};
+
+#endif
+
+//------------------------------------------------------------------------------
+
+#ifdef HFSM_ENABLE_PLAN_QUOTAS
+
+// Task link usage of a single region
+//  quota		- Links reserved for the region and the most it may hold at once,
+//				  INVALID_LONG_INDEX if unlimited
+//  count		- Links currently held
+//  highWater	- Largest 'count' seen since the last reset
+//  overflows	- Appends refused, either over the quota or with the shared list full
+
+struct PlanUsage {
+	LongIndex quota		= INVALID_LONG_INDEX;
+	LongIndex count		= 0;
+	LongIndex highWater	= 0;
+	LongIndex overflows	= 0;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+// Per-region task link quotas over the shared TaskLinks list
+//  Quotas are reserved: regions without one share what's left of the list
+//  after every quota, so they can't eat into a capped region's links
+
+template <LongIndex NRegionCount, LongIndex NTaskCapacity>
+struct PlanQuotasT {
+	static constexpr LongIndex TASK_CAPACITY = NTaskCapacity;
+
+	HFSM_INLINE void setQuota(const RegionID regionId,
+							  const LongIndex quota)
+	{
+		HFSM_ASSERT(regionId < NRegionCount);
+
+		PlanUsage& usage = regions[regionId];
+
+		if (usage.quota != INVALID_LONG_INDEX) {
+			reserved	-= usage.quota;
+			cappedCount -= usage.count;
+		}
+
+		usage.quota = quota;
+
+		if (usage.quota != INVALID_LONG_INDEX) {
+			reserved	+= usage.quota;
+			cappedCount += usage.count;
+		}
+
+		// quotas can't reserve more links than the list holds
+		HFSM_ASSERT(reserved <= TASK_CAPACITY);
+	}
+
+	HFSM_INLINE bool acquire(const RegionID regionId) {
+		PlanUsage& usage = regions[regionId];
+
+		const bool capped = usage.quota != INVALID_LONG_INDEX;
+
+		if (capped ?
+				usage.count >= usage.quota :
+				count - cappedCount + reserved >= TASK_CAPACITY)
+		{
+			++usage.overflows;
+
+			return false;
+		}
+
+		if (usage.highWater < ++usage.count)
+			usage.highWater = usage.count;
+
+		if (capped)
+			++cappedCount;
+
+		if (highWater < ++count)
+			highWater = count;
+
+		return true;
+	}
+
+	HFSM_INLINE void release(const RegionID regionId) {
+		PlanUsage& usage = regions[regionId];
+		HFSM_ASSERT(usage.count && count);
+
+		--usage.count;
+		--count;
+
+		if (usage.quota != INVALID_LONG_INDEX)
+			--cappedCount;
+	}
+
+	// The shared list turned out to be full after acquire()
+	HFSM_INLINE void refuse(const RegionID regionId) {
+		release(regionId);
+
+		++regions[regionId].overflows;
+	}
+
+	HFSM_INLINE void resetHighWater() {
+		for (LongIndex i = 0; i < NRegionCount; ++i)
+			regions[i].highWater = regions[i].count;
+
+		highWater = count;
+	}
+
+	PlanUsage regions[NRegionCount];
+
+	LongIndex count		  = 0;
+	LongIndex highWater	  = 0;
+	LongIndex reserved	  = 0;		// sum of the quotas
+	LongIndex cappedCount = 0;		// links held by regions with a quota
+};
+
+#endif
+
+//------------------------------------------------------------------------------
+
+#if defined HFSM_ENABLE_STRUCTURE_REPORT || defined HFSM_ENABLE_POOL_INDEX
+
+// States entered or exited since the list was last cleared, each listed once
+
+template <LongIndex NStateCount>
+struct ActivityChangesT {
+	HFSM_INLINE void mark(const StateID stateId) {
+		if (!marked.get(stateId)) {
+			marked.set(stateId);
+			states.append(stateId);
+		}
+	}
+
+	HFSM_INLINE void clear() {
+		for (LongIndex i = 0; i < states.count(); ++i)
+			marked.reset(states[i]);
+
+		states.clear();
+	}
+
+	BitArray<StateID, NStateCount> marked;
+	Array<StateID, NStateCount> states;
+};
+
+#endif
+
+//------------------------------------------------------------------------------
+
 template <typename,
 		  typename,
 		  typename,
@@ -86,6 +267,20 @@ struct PlanDataT<ArgsT<TContext,
 	TasksBits tasksFailures;
 	RegionBits planExists;
 
+	HFSM_IF_STATIC_PLANS(StaticPlansT<REGION_COUNT> staticPlans);
+	HFSM_IF_PLAN_QUOTAS(PlanQuotasT<REGION_COUNT, TASK_CAPACITY> planQuotas);
+	HFSM_IF_UPDATE_PERIODS(UpdatePeriodsT<REGION_COUNT> updatePeriods);
+	HFSM_IF_PAYLOADS(PayloadsT<TConfig::PAYLOAD_SIZE, REGION_COUNT * 2> payloads);
+	HFSM_IF_STRUCTURE(ActivityChangesT<StateList::SIZE> activityChanges);
+	HFSM_IF_POOL_INDEX(ActivityChangesT<StateList::SIZE> indexChanges);		// consumed by PoolT's state index
+	HFSM_IF_COROUTINES(CoroutinesT<TConfig::COROUTINE_ARENA_SIZE, StateList::SIZE> coroutines);
+
+	HFSM_IF_PARALLEL(ExecutorInterface* executor = nullptr);
+	HFSM_IF_PARALLEL(HFSM_IF_ASSERT(bool forked = false));		// ParallelOrthogonal<> sub-states are running
+
+	// Any region holding tasks not yet completed
+	HFSM_INLINE bool hasPlans() const;
+
 #ifdef HFSM_ENABLE_ASSERT
 	void verifyPlans() const;
 	LongIndex verifyPlan(const RegionID stateId) const;
@@ -111,6 +306,17 @@ struct PlanDataT<ArgsT<TContext,
 					   0,
 					   NTaskCapacity>>
 {
+	HFSM_IF_UPDATE_PERIODS(UpdatePeriodsT<TRegionList::SIZE> updatePeriods);
+	HFSM_IF_PAYLOADS(PayloadsT<TConfig::PAYLOAD_SIZE, TRegionList::SIZE * 2> payloads);
+	HFSM_IF_STRUCTURE(ActivityChangesT<TStateList::SIZE> activityChanges);
+	HFSM_IF_POOL_INDEX(ActivityChangesT<TStateList::SIZE> indexChanges);
+	HFSM_IF_COROUTINES(CoroutinesT<TConfig::COROUTINE_ARENA_SIZE, TStateList::SIZE> coroutines);
+
+	HFSM_IF_PARALLEL(ExecutorInterface* executor = nullptr);
+	HFSM_IF_PARALLEL(HFSM_IF_ASSERT(bool forked = false));
+
+	HFSM_INLINE bool hasPlans() const							{ return false;							}
+
 #ifdef HFSM_ENABLE_ASSERT
 	void verifyPlans() const													{}
 	LongIndex verifyPlan(const RegionID) const					{ return 0;		}
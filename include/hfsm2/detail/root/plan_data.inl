@@ -3,6 +3,25 @@ namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
+// 'planExists' stays set after a plan completes, check the tasks themselves
+
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, LongIndex NSB, LongIndex NTC>
+bool
+PlanDataT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, NSB, NTC>>::hasPlans() const {
+	if (taskLinks.count())
+		return true;
+
+#ifdef HFSM_ENABLE_STATIC_PLANS
+	for (RegionID id = 0; id < REGION_COUNT; ++id)
+		if (staticPlans.active(id))
+			return true;
+#endif
+
+	return false;
+}
+
+//------------------------------------------------------------------------------
+
 #ifdef HFSM_ENABLE_ASSERT
 
 template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, LongIndex NSB, LongIndex NTC>
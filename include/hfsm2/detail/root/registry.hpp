@@ -12,6 +12,11 @@ enum Strategy {
 	RandomUtil,
 };
 
+enum Execution {
+	Sequential,
+	Parallel,
+};
+
 ////////////////////////////////////////////////////////////////////////////////
 
 #pragma pack(push, 1)
@@ -58,15 +63,18 @@ struct Request {
 	HFSM_INLINE Request() = default;
 
 	HFSM_INLINE Request(const Type type_,
-						const StateID stateId_)
+						const StateID stateId_,
+						const StateID origin_ = INVALID_STATE_ID)
 		: type{type_}
 		, stateId{stateId_}
+		, origin{origin_}
 	{
 		HFSM_ASSERT(type_ < Type::COUNT);
 	}
 
 	Type type = CHANGE;
 	StateID stateId = INVALID_STATE_ID;
+	StateID origin	= INVALID_STATE_ID;
 };
 
 template <ShortIndex NCount>
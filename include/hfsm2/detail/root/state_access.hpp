@@ -147,10 +147,11 @@ struct Accessor<T, const CS_<TN, TA, TG, NI, TS>> {
 template <typename T,
 		  typename TN,
 		  typename TA,
+		  Execution EX,
 		  typename TH,
 		  typename... TS>
-struct Accessor<T,		 O_<TN, TA, TH, TS...>> {
-	using Host =		 O_<TN, TA, TH, TS...>;
+struct Accessor<T,		 O_<TN, TA, EX, TH, TS...>> {
+	using Host =		 O_<TN, TA, EX, TH, TS...>;
 
 	HFSM_INLINE		  T& get()			{ return Accessor<T,	   typename Host::SubStates>{host._subStates}.get();	}
 
@@ -162,10 +163,11 @@ struct Accessor<T,		 O_<TN, TA, TH, TS...>> {
 template <typename T,
 		  typename TN,
 		  typename TA,
+		  Execution EX,
 		  typename TH,
 		  typename... TS>
-struct Accessor<T, const O_<TN, TA, TH, TS...>> {
-	using Host =   const O_<TN, TA, TH, TS...>;
+struct Accessor<T, const O_<TN, TA, EX, TH, TS...>> {
+	using Host =   const O_<TN, TA, EX, TH, TS...>;
 
 	HFSM_INLINE const T& get() const	{ return Accessor<T, const typename Host::SubStates>{host._subStates}.get();	}
 
@@ -177,9 +179,10 @@ struct Accessor<T, const O_<TN, TA, TH, TS...>> {
 template <typename T,
 		  typename TN,
 		  typename TA,
+		  Execution EX,
 		  typename... TS>
-struct Accessor<T,		 O_<TN, TA,  T, TS...>> {
-	using Host =		 O_<TN, TA,  T, TS...>;
+struct Accessor<T,		 O_<TN, TA, EX,  T, TS...>> {
+	using Host =		 O_<TN, TA, EX,  T, TS...>;
 
 	HFSM_INLINE		  T& get()			{ return host._headState._headBox.get();	}
 
@@ -191,9 +194,10 @@ struct Accessor<T,		 O_<TN, TA,  T, TS...>> {
 template <typename T,
 		  typename TN,
 		  typename TA,
+		  Execution EX,
 		  typename... TS>
-struct Accessor<T, const O_<TN, TA,  T, TS...>> {
-	using Host =   const O_<TN, TA,  T, TS...>;
+struct Accessor<T, const O_<TN, TA, EX,  T, TS...>> {
+	using Host =   const O_<TN, TA, EX,  T, TS...>;
 
 	HFSM_INLINE const T& get() const	{ return host._headState._headBox.get();	}
 
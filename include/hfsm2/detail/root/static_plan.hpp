@@ -0,0 +1,122 @@
+#pragma once
+
+#ifdef HFSM_ENABLE_STATIC_PLANS
+
+namespace hfsm2 {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Plan tasks declared as types, see PlanT::apply<>()
+
+template <typename TOrigin, typename TDestination>
+struct Change {
+	using Origin	  = TOrigin;
+	using Destination = TDestination;
+
+	static constexpr TransitionType TYPE = TransitionType::CHANGE;
+};
+
+template <typename TOrigin, typename TDestination>
+struct Restart {
+	using Origin	  = TOrigin;
+	using Destination = TDestination;
+
+	static constexpr TransitionType TYPE = TransitionType::RESTART;
+};
+
+template <typename TOrigin, typename TDestination>
+struct Resume {
+	using Origin	  = TOrigin;
+	using Destination = TDestination;
+
+	static constexpr TransitionType TYPE = TransitionType::RESUME;
+};
+
+template <typename TOrigin, typename TDestination>
+struct Utilize {
+	using Origin	  = TOrigin;
+	using Destination = TDestination;
+
+	static constexpr TransitionType TYPE = TransitionType::UTILIZE;
+};
+
+template <typename TOrigin, typename TDestination>
+struct Randomize {
+	using Origin	  = TOrigin;
+	using Destination = TDestination;
+
+	static constexpr TransitionType TYPE = TransitionType::RANDOMIZE;
+};
+
+template <typename TOrigin, typename TDestination>
+struct Schedule {
+	using Origin	  = TOrigin;
+	using Destination = TDestination;
+
+	static constexpr TransitionType TYPE = TransitionType::SCHEDULE;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename... TTasks>
+struct PlanTemplate {
+	static_assert(sizeof...(TTasks) > 0, "Empty plan template");
+};
+
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct StaticTask {
+	TransitionType type;
+	StateID origin;
+	StateID destination;
+};
+
+//------------------------------------------------------------------------------
+
+// Read-only task table of a plan template, one per machine state list
+//  and shared by every instance
+
+template <typename, typename>
+struct StaticPlanT;
+
+template <typename TStateList, typename... TTasks>
+struct StaticPlanT<TStateList, PlanTemplate<TTasks...>> {
+	static constexpr LongIndex COUNT = sizeof...(TTasks);
+
+	static const StaticTask TASKS[COUNT];
+};
+
+template <typename TStateList, typename... TTasks>
+const StaticTask StaticPlanT<TStateList, PlanTemplate<TTasks...>>::TASKS[COUNT] = {
+	StaticTask{TTasks::TYPE,
+			   (StateID) TStateList::template index<typename TTasks::Origin>(),
+			   (StateID) TStateList::template index<typename TTasks::Destination>()}...
+};
+
+//------------------------------------------------------------------------------
+
+// Per-region reference to the applied plan template and the progress through it
+
+template <LongIndex NRegionCount>
+struct StaticPlansT {
+	struct Entry {
+		const StaticTask* tasks = nullptr;
+		uint16_t count	= 0;
+		uint16_t cursor	= 0;
+	};
+
+	HFSM_INLINE bool active(const RegionID regionId) const		{ return entries[regionId].tasks != nullptr;		}
+
+	HFSM_INLINE void clear(const RegionID regionId)				{ entries[regionId] = Entry{};					}
+
+	Entry entries[NRegionCount];
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+#endif
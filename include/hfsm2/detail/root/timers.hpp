@@ -0,0 +1,90 @@
+#pragma once
+
+#ifdef HFSM_ENABLE_TIMERS
+
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Hierarchical timing wheel with one timer slot per state
+//  Time is counted in ticks, advanced once per R_::update()
+//  Each level holds 64 slots of intrusive timer lists, the slot occupancy is
+//  kept in a bitmask so an idle tick costs a single bit test
+//  Expired timers turn into transition requests issued on behalf of their origin state
+
+template <LongIndex NStateCount>
+class TimerWheelT {
+public:
+	static constexpr LongIndex STATE_COUNT = NStateCount;
+
+	static constexpr unsigned SLOT_BITS	= 6;
+	static constexpr unsigned SLOTS		= 1u << SLOT_BITS;
+	static constexpr unsigned LEVELS	= 4;
+
+	// Longest supported delay, longer ones are clamped
+	static constexpr uint32_t MAX_DELAY = (1u << (SLOT_BITS * LEVELS)) - 1;
+
+	HFSM_INLINE TimerWheelT();
+
+	// Arm (or re-arm) the timer of 'origin' to request 'type' transition to 'target'
+	//  on the 'delay'-th tick from now, 'delay' of 0 is treated as 1
+	HFSM_INLINE void set(const StateID origin,
+						 const Request::Type type,
+						 const StateID target,
+						 const uint32_t delay);
+
+	HFSM_INLINE void cancel(const StateID origin);
+
+	HFSM_INLINE bool pending(const StateID origin) const;
+
+	// Ticks left until the timer of 'origin' fires, 0 if it isn't armed
+	HFSM_INLINE uint32_t remaining(const StateID origin) const;
+
+	HFSM_INLINE bool empty() const							{ return _armed == 0;							}
+
+	HFSM_INLINE uint32_t now() const						{ return _now;									}
+
+	// Advance time by one tick, appending requests of expired timers into 'requests'
+	//  Timers that don't fit into 'requests' are postponed till the next tick
+	//  Timers of origins no longer active in 'registry' are dropped,
+	//  e.g. armed from entryGuard() of a state whose entry got cancelled
+	template <typename TRequests, typename TRegistry>
+	HFSM_INLINE void advance(TRequests& requests,
+							 const TRegistry& registry);
+
+private:
+	struct Timer {
+		uint32_t deadline;
+		StateID target;
+		StateID prev;
+		StateID next;
+		uint8_t type;
+		uint8_t level;		// INVALID_LEVEL when not armed
+		uint8_t slot;
+	};
+
+	static constexpr uint8_t INVALID_LEVEL = 0xFF;
+
+	HFSM_INLINE void link  (const StateID origin);
+	HFSM_INLINE void unlink(const StateID origin);
+
+	HFSM_INLINE void cascade(const unsigned level);
+
+private:
+	Timer _timers[STATE_COUNT];
+	StateID _heads[LEVELS][SLOTS];
+	uint64_t _occupied[LEVELS];
+
+	uint32_t _now = 0;
+	LongIndex _armed = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+#include "timers.inl"
+
+#endif
@@ -0,0 +1,187 @@
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <LongIndex NSC>
+TimerWheelT<NSC>::TimerWheelT() {
+	for (LongIndex i = 0; i < STATE_COUNT; ++i)
+		_timers[i].level = INVALID_LEVEL;
+
+	for (unsigned l = 0; l < LEVELS; ++l) {
+		for (unsigned s = 0; s < SLOTS; ++s)
+			_heads[l][s] = INVALID_STATE_ID;
+
+		_occupied[l] = 0;
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NSC>
+void
+TimerWheelT<NSC>::set(const StateID origin,
+					  const Request::Type type,
+					  const StateID target,
+					  const uint32_t delay)
+{
+	HFSM_ASSERT(origin < STATE_COUNT);
+	HFSM_ASSERT(target < STATE_COUNT);
+
+	cancel(origin);
+
+	Timer& timer = _timers[origin];
+	timer.deadline = _now + (delay == 0 ? 1 : delay < MAX_DELAY ? delay : MAX_DELAY);
+	timer.target   = target;
+	timer.type	   = (uint8_t) type;
+
+	link(origin);
+	++_armed;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NSC>
+void
+TimerWheelT<NSC>::cancel(const StateID origin) {
+	HFSM_ASSERT(origin < STATE_COUNT);
+
+	if (_timers[origin].level != INVALID_LEVEL) {
+		unlink(origin);
+		--_armed;
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NSC>
+bool
+TimerWheelT<NSC>::pending(const StateID origin) const {
+	HFSM_ASSERT(origin < STATE_COUNT);
+
+	return _timers[origin].level != INVALID_LEVEL;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NSC>
+uint32_t
+TimerWheelT<NSC>::remaining(const StateID origin) const {
+	return pending(origin) ? _timers[origin].deadline - _now : 0;
+}
+
+//------------------------------------------------------------------------------
+
+template <LongIndex NSC>
+template <typename TRequests, typename TRegistry>
+void
+TimerWheelT<NSC>::advance(TRequests& requests,
+						  const TRegistry& registry)
+{
+	++_now;
+
+	if (!_armed)
+		return;
+
+	for (unsigned l = LEVELS - 1; l > 0; --l)
+		if ((_now & ((1u << (SLOT_BITS * l)) - 1)) == 0)
+			cascade(l);
+
+	const unsigned slot = _now & (SLOTS - 1);
+
+	while (_occupied[0] & (1ull << slot)) {
+		const StateID origin = _heads[0][slot];
+		Timer& timer = _timers[origin];
+
+		unlink(origin);
+
+		if (!registry.isActive(origin))
+			--_armed;
+		else if (requests.count() < requests.CAPACITY) {
+			requests.append(Request{(Request::Type) timer.type, timer.target, origin});
+			--_armed;
+		} else {
+			// re-linked into the next slot, out of this loop's reach
+			timer.deadline = _now + 1;
+			link(origin);
+		}
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <LongIndex NSC>
+void
+TimerWheelT<NSC>::link(const StateID origin) {
+	Timer& timer = _timers[origin];
+
+	const uint32_t delta = timer.deadline - _now;
+
+	unsigned level = 0;
+	while (level < LEVELS - 1 && delta >= (1u << (SLOT_BITS * (level + 1))))
+		++level;
+
+	const unsigned slot = (timer.deadline >> (SLOT_BITS * level)) & (SLOTS - 1);
+
+	StateID& head = _heads[level][slot];
+
+	timer.level = (uint8_t) level;
+	timer.slot	= (uint8_t) slot;
+	timer.prev	= INVALID_STATE_ID;
+	timer.next	= head;
+
+	if (head != INVALID_STATE_ID)
+		_timers[head].prev = origin;
+
+	head = origin;
+	_occupied[level] |= 1ull << slot;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NSC>
+void
+TimerWheelT<NSC>::unlink(const StateID origin) {
+	Timer& timer = _timers[origin];
+	HFSM_ASSERT(timer.level < LEVELS);
+
+	if (timer.prev != INVALID_STATE_ID)
+		_timers[timer.prev].next = timer.next;
+	else {
+		_heads[timer.level][timer.slot] = timer.next;
+
+		if (timer.next == INVALID_STATE_ID)
+			_occupied[timer.level] &= ~(1ull << timer.slot);
+	}
+
+	if (timer.next != INVALID_STATE_ID)
+		_timers[timer.next].prev = timer.prev;
+
+	timer.level = INVALID_LEVEL;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NSC>
+void
+TimerWheelT<NSC>::cascade(const unsigned level) {
+	const unsigned slot = (_now >> (SLOT_BITS * level)) & (SLOTS - 1);
+
+	StateID origin = _heads[level][slot];
+
+	_heads[level][slot] = INVALID_STATE_ID;
+	_occupied[level] &= ~(1ull << slot);
+
+	while (origin != INVALID_STATE_ID) {
+		const StateID next = _timers[origin].next;
+
+		link(origin);
+
+		origin = next;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
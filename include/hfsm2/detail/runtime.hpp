@@ -0,0 +1,453 @@
+#pragma once
+
+namespace hfsm2 {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Region headed by a state added to a runtime layout, NONE for leaf states
+
+enum class RuntimeRegion : uint8_t {
+	NONE,
+	COMPOSITE,
+	RESUMABLE,
+	UTILITARIAN,
+	ORTHOGONAL,
+};
+
+//------------------------------------------------------------------------------
+
+// Event passed to react() callbacks of runtime machines,
+//  as<TEvent>() returns nullptr for events of other types
+
+class RuntimeEvent {
+public:
+	template <typename TEvent>
+	HFSM_INLINE explicit RuntimeEvent(const TEvent& event)
+		: _type{&detail::TypeTagT<TEvent>::TAG}
+		, _event{&event}
+	{}
+
+	template <typename TEvent>
+	HFSM_INLINE const TEvent* as() const {
+		return _type == &detail::TypeTagT<TEvent>::TAG ?
+			static_cast<const TEvent*>(_event) : nullptr;
+	}
+
+private:
+	const char* const _type;
+	const void* const _event;
+};
+
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <LongIndex NSize>
+struct RuntimeListT {
+	static constexpr LongIndex SIZE = NSize;
+};
+
+//------------------------------------------------------------------------------
+
+// Callbacks of a single state, receiving its id first
+//  Missing ones are skipped, a missing utility() counts as 1
+
+template <typename TArgs>
+struct RuntimeCallbacksT {
+	using Utility		= typename TArgs::Utility;
+
+	using Control		= ControlT	   <TArgs>;
+	using PlanControl	= PlanControlT <TArgs>;
+	using FullControl	= FullControlT <TArgs>;
+	using GuardControl	= GuardControlT<TArgs>;
+
+	using Score			= Utility (*)(const StateID, const Control&);
+	using Guard			= void	  (*)(const StateID, GuardControl&);
+	using Transition	= void	  (*)(const StateID, PlanControl&);
+	using Update		= void	  (*)(const StateID, FullControl&);
+	using React			= void	  (*)(const StateID, const RuntimeEvent&, FullControl&);
+
+	Score	   utility		 = nullptr;
+	Guard	   entryGuard	 = nullptr;
+	Transition enter		 = nullptr;
+	Transition reenter		 = nullptr;
+	Update	   update		 = nullptr;
+	React	   react		 = nullptr;
+	Guard	   exitGuard	 = nullptr;
+	Transition exit			 = nullptr;
+	Update	   planSucceeded = nullptr;
+	Update	   planFailed	 = nullptr;
+};
+
+//------------------------------------------------------------------------------
+
+// Hierarchy of a runtime machine, flattened into per-state and per-region tables
+//  States are added depth-first: the root first with 'INVALID_STATE_ID' as its parent,
+//  then each state under the last added region, or any of its ancestors
+//  State and region ids, fork ids and orthogonal units come out the same
+//  as for the compiled machine with the same hierarchy
+//  A layout is shared by any number of machines, and has to outlive them
+
+template <typename TF>
+class RuntimeLayoutT {
+	template <typename>
+	friend class RuntimeR_;
+
+	using Info			= TF;
+	using Callbacks		= typename Info::Callbacks;
+
+	static constexpr LongIndex  STATE_COUNT	  = Info::STATE_COUNT;
+	static constexpr ShortIndex COMPO_REGIONS = Info::COMPO_REGIONS;
+	static constexpr ShortIndex ORTHO_REGIONS = Info::ORTHO_REGIONS;
+	static constexpr ShortIndex ORTHO_UNITS	  = Info::ORTHO_UNITS;
+	static constexpr ShortIndex REGION_COUNT  = Info::REGION_COUNT;
+
+	template <typename T>
+	using StateTable	= StaticArray<T, STATE_COUNT>;
+
+	template <typename T>
+	using RegionTable	= StaticArray<T, REGION_COUNT>;
+
+public:
+	// Returns the id of the new state,
+	//  INVALID_STATE_ID if it breaks the depth-first order or doesn't fit
+	StateID add(const StateID parent,
+				const RuntimeRegion region = RuntimeRegion::NONE,
+				const Callbacks& callbacks = Callbacks{});
+
+	// Fill in the fork table once all states are added,
+	//  false if a region is left without sub-states or orthogonal units run out
+	bool build();
+
+	HFSM_INLINE bool built() const										{ return _built;						}
+
+	HFSM_INLINE LongIndex stateCount() const							{ return _stateCount;					}
+	HFSM_INLINE ShortIndex regionCount() const							{ return _regionCount;					}
+
+	// Region headed by 'stateId', INVALID_REGION_ID for leaf states
+	HFSM_INLINE RegionID regionId(const StateID stateId) const			{ return _regions[stateId];				}
+
+private:
+	StateTable<Parent>					 _parents;
+	StateTable<StateID>					 _owners;
+	StateTable<LongIndex>				 _sizes;
+	StateTable<RegionID>				 _regions;
+
+	StateTable<typename Callbacks::Score>	   _utilities	  {nullptr};
+	StateTable<typename Callbacks::Guard>	   _entryGuards	  {nullptr};
+	StateTable<typename Callbacks::Transition> _enters		  {nullptr};
+	StateTable<typename Callbacks::Transition> _reenters	  {nullptr};
+	StateTable<typename Callbacks::Update>	   _updates		  {nullptr};
+	StateTable<typename Callbacks::React>	   _reacts		  {nullptr};
+	StateTable<typename Callbacks::Guard>	   _exitGuards	  {nullptr};
+	StateTable<typename Callbacks::Transition> _exits		  {nullptr};
+	StateTable<typename Callbacks::Update>	   _planSucceeded {nullptr};
+	StateTable<typename Callbacks::Update>	   _planFailed	  {nullptr};
+
+	RegionTable<StateID>				 _heads;
+	RegionTable<RuntimeRegion>			 _types;
+	RegionTable<ForkID>					 _forks;
+	RegionTable<ShortIndex>				 _widths;
+	RegionTable<LongIndex>				 _firstProngs;
+	RegionTable<ShortIndex>				 _units;
+
+	// sub-states of each region, in prong order
+	StateTable<StateID>					 _prongs;
+
+	LongIndex  _stateCount	= 0;
+	ShortIndex _regionCount = 0;
+	ShortIndex _compoCount	= 0;
+	ShortIndex _orthoCount	= 0;
+	bool _built = false;
+};
+
+//------------------------------------------------------------------------------
+
+template <typename TRegistry, bool NOrthogonal>
+struct RuntimeForksT {
+	using Bits = typename TRegistry::OrthoBits;
+
+	static HFSM_INLINE Bits requested(TRegistry& registry,
+									  const ForkID forkId)		{ return registry.requestedOrthoFork(forkId);		}
+
+	static HFSM_INLINE void attach(TRegistry& registry,
+								   const ShortIndex index,
+								   const Parent parent,
+								   const Units units)
+	{
+		registry.orthoParents[index] = parent;
+		registry.orthoUnits	 [index] = units;
+	}
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TRegistry>
+struct RuntimeForksT<TRegistry, false> {
+	struct Bits {
+		HFSM_INLINE explicit operator bool() const						{ return false;							}
+
+		HFSM_INLINE void clear()										{}
+		HFSM_INLINE bool get(const ShortIndex) const					{ return false;							}
+	};
+
+	static HFSM_INLINE Bits requested(TRegistry&, const ForkID)			{ HFSM_BREAK(); return Bits{};			}
+
+	static HFSM_INLINE void attach(TRegistry&, const ShortIndex, const Parent, const Units)	{ HFSM_BREAK();		}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Machine running a RuntimeLayoutT hierarchy with the semantics of compiled machines:
+//  composite, resumable, utilitarian and orthogonal regions, guards and plans,
+//  reported to the same logger interface
+//  Registry, plans and controls are the ones compiled machines use,
+//  only the traversal walks the layout tables instead of the type hierarchy
+//  Not supported: random regions, parallel orthogonal regions, coroutines,
+//  payloads, static plans, serialization, structure report, profiler and statistics
+
+template <typename TF>
+class RuntimeR_ {
+	using Info					= TF;
+	using Config_				= typename Info::Config_;
+	using Context				= typename Info::Context;
+	using Utility				= typename Config_::Utility;
+	using RNG					= typename Config_::RNG;
+	using Logger				= typename Config_::Logger;
+	using UP					= typename Config_::UP;
+
+	using Args					= typename Info::Args;
+	using Layout				= typename Info::Layout;
+
+	static constexpr LongIndex SUBSTITUTION_LIMIT = Info::SUBSTITUTION_LIMIT;
+
+	using Registry				= RegistryT<Args>;
+	using RegistryBackUp		= typename Registry::BackUp;
+	using Forks					= RuntimeForksT<Registry, (Info::ORTHO_REGIONS > 0)>;
+	using ForkBits				= typename Forks::Bits;
+
+	using Control				= ControlT<Args>;
+
+	using PlanControl			= PlanControlT<Args>;
+	using PlanData				= PlanDataT   <Args>;
+
+	using FullControl			= FullControlT<Args>;
+	using Requests				= typename FullControl::Requests;
+
+	using GuardControl			= GuardControlT<Args>;
+
+	using ScopedOrigin			= typename PlanControl::Origin;
+	using ScopedRegion			= typename PlanControl::Region;
+	using ControlLock			= typename FullControl::Lock;
+
+public:
+	static constexpr LongIndex  STATE_COUNT		  = Info::STATE_COUNT;
+	static constexpr ShortIndex COMPO_REGIONS	  = Info::COMPO_REGIONS;
+	static constexpr ShortIndex ORTHO_REGIONS	  = Info::ORTHO_REGIONS;
+	static constexpr ShortIndex ORTHO_UNITS		  = Info::ORTHO_UNITS;
+	static constexpr ShortIndex REGION_COUNT	  = Info::REGION_COUNT;
+
+	HFSM_IF_TIMERS(using Timers = typename Args::Timers);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+public:
+	RuntimeR_(const Layout& layout,
+			  Context& context
+			  HFSM_IF_LOGGER(, Logger* const logger = nullptr));
+
+	~RuntimeR_();
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	void update();
+
+	template <typename TEvent>
+	HFSM_INLINE void react(const TEvent& event);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE bool isActive   (const StateID stateId) const	{ return _registry.isActive   (stateId);	}
+	HFSM_INLINE bool isResumable(const StateID stateId) const	{ return _registry.isResumable(stateId);	}
+
+	HFSM_INLINE bool isScheduled(const StateID stateId) const	{ return isResumable(stateId);				}
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE void changeTo(const StateID stateId);
+	HFSM_INLINE void restart (const StateID stateId);
+	HFSM_INLINE void resume	 (const StateID stateId);
+	HFSM_INLINE void utilize (const StateID stateId);
+	HFSM_INLINE void schedule(const StateID stateId);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE const Layout& layout() const					{ return _layout;							}
+
+#if defined HFSM_ENABLE_LOG_INTERFACE || defined HFSM_ENABLE_VERBOSE_DEBUG_LOG
+	void attachLogger(Logger* const logger)						{ _logger = logger;							}
+#endif
+
+	//----------------------------------------------------------------------
+
+private:
+	void initialEnter();
+	void processTransitions();
+
+	bool applyRequest(Control& control, const Request& request);
+	bool applyRequests(Control& control);
+
+	bool cancelledByEntryGuards(const Requests& pendingRequests);
+	bool cancelledByGuards(const Requests& pendingRequests);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE StateID prong(const RegionID regionId, const ShortIndex index) const;
+
+	HFSM_INLINE ShortIndex& compoRequested(const RegionID regionId);
+	HFSM_INLINE ShortIndex& compoActive	  (const RegionID regionId);
+	HFSM_INLINE ShortIndex& compoResumable(const RegionID regionId);
+
+	HFSM_INLINE ForkBits	orthoRequested(const RegionID regionId);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	// callbacks of a single state, the same as the head of a region
+
+	HFSM_INLINE bool	stateEntryGuard	  (GuardControl& control, const StateID stateId);
+	HFSM_INLINE void	stateConstruct	  (PlanControl&	 control, const StateID stateId);
+	HFSM_INLINE void	stateEnter		  (PlanControl&	 control, const StateID stateId);
+	HFSM_INLINE void	stateReenter	  (PlanControl&	 control, const StateID stateId);
+	HFSM_INLINE Status	stateUpdate		  (FullControl&	 control, const StateID stateId);
+	HFSM_INLINE Status	stateReact		  (FullControl&	 control, const StateID stateId, const RuntimeEvent& event);
+	HFSM_INLINE bool	stateExitGuard	  (GuardControl& control, const StateID stateId);
+	HFSM_INLINE void	stateExit		  (PlanControl&	 control, const StateID stateId);
+	HFSM_INLINE void	stateDestruct	  (PlanControl&	 control, const StateID stateId);
+	HFSM_INLINE void	statePlanSucceeded(FullControl&	 control, const StateID stateId);
+	HFSM_INLINE void	statePlanFailed	  (FullControl&	 control, const StateID stateId);
+	HFSM_INLINE UP		stateReport		  (Control&		 control, const StateID stateId);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	bool	deepForwardEntryGuard(GuardControl& control, const StateID stateId);
+	bool	deepEntryGuard		 (GuardControl& control, const StateID stateId);
+
+	void	deepConstruct		 (PlanControl&	control, const StateID stateId);
+
+	void	deepEnter			 (PlanControl&	control, const StateID stateId);
+	void	deepReenter			 (PlanControl&	control, const StateID stateId);
+
+	Status	deepUpdate			 (FullControl&	control, const StateID stateId);
+	Status	deepReact			 (FullControl&	control, const StateID stateId, const RuntimeEvent& event);
+
+	bool	deepForwardExitGuard (GuardControl& control, const StateID stateId);
+	bool	deepExitGuard		 (GuardControl& control, const StateID stateId);
+
+	void	deepExit			 (PlanControl&	control, const StateID stateId);
+
+	void	deepDestruct		 (PlanControl&	control, const StateID stateId);
+
+	void	deepForwardActive	 (Control&		control, const StateID stateId, const Request::Type request);
+	void	deepForwardRequest	 (Control&		control, const StateID stateId, const Request::Type request);
+
+	void	deepRequest			 (Control&		control, const StateID stateId, const Request::Type request);
+	void	deepRequestChange	 (Control&		control, const StateID stateId);
+	void	deepRequestRemain	 (Control&		control, const StateID stateId);
+	void	deepRequestRestart	 (Control&		control, const StateID stateId);
+	void	deepRequestResume	 (Control&		control, const StateID stateId);
+	void	deepRequestUtilize	 (Control&		control, const StateID stateId);
+
+	UP		deepReportChange	 (Control&		control, const StateID stateId);
+	UP		deepReportUtilize	 (Control&		control, const StateID stateId);
+
+	void	deepChangeToRequested(PlanControl&	control, const StateID stateId);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	Status	subUpdate			 (FullControl&	control, const RegionID regionId);
+	Status	subReact			 (FullControl&	control, const RegionID regionId, const RuntimeEvent& event);
+
+	UP		subReportChange		 (Control&		control, const RegionID regionId);
+	UP		subReportUtilize	 (Control&		control, const RegionID regionId);
+
+	Status	updatePlan			 (FullControl&	control, const StateID headId, const Status subStatus);
+	Status	buildPlanStatus		 (FullControl&	control, const StateID headId);
+
+	//----------------------------------------------------------------------
+
+private:
+	const Layout& _layout;
+
+	Context& _context;
+
+	// only handed to the controls, runtime layouts have no random regions
+	RNG _rng{0};
+
+	Registry _registry;
+	PlanData _planData;
+
+	Requests _requests;
+
+	HFSM_IF_LOGGER(Logger* _logger);
+	HFSM_IF_TIMERS(Timers _timers);
+};
+
+//------------------------------------------------------------------------------
+
+template <typename TConfig,
+		  LongIndex NStates,
+		  ShortIndex NCompo,
+		  ShortIndex NOrtho,
+		  ShortIndex NUnits>
+struct RuntimeF_ final {
+	using Config_		= TConfig;
+	using Context		= typename Config_::Context;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	static constexpr LongIndex  SUBSTITUTION_LIMIT = Config_::SUBSTITUTION_LIMIT;
+
+	static constexpr LongIndex  STATE_COUNT		= NStates;
+	static constexpr ShortIndex COMPO_REGIONS	= NCompo;
+	static constexpr ShortIndex ORTHO_REGIONS	= NOrtho;
+	static constexpr ShortIndex ORTHO_UNITS		= NUnits;
+	static constexpr ShortIndex REGION_COUNT	= COMPO_REGIONS + ORTHO_REGIONS;
+
+	static constexpr LongIndex  TASK_CAPACITY	= Config_::TASK_CAPACITY != INVALID_LONG_INDEX ?
+													  Config_::TASK_CAPACITY : STATE_COUNT * 2;
+
+	static_assert(STATE_COUNT < (ShortIndex) -1, "Too many states in the hierarchy. Change 'ShortIndex' type.");
+	static_assert(COMPO_REGIONS > 0, "Runtime machines need at least one composite region");
+	static_assert(ORTHO_UNITS >= ORTHO_REGIONS, "Each orthogonal region needs at least one unit");
+
+	using StateList		= RuntimeListT<STATE_COUNT>;
+	using RegionList	= RuntimeListT<REGION_COUNT>;
+
+	using Args			= ArgsT<Context,
+								Config_,
+								StateList,
+								RegionList,
+								COMPO_REGIONS,
+								ORTHO_REGIONS,
+								ORTHO_UNITS,
+								0,
+								TASK_CAPACITY>;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	using Instance		= RuntimeR_<RuntimeF_>;
+	using Layout		= RuntimeLayoutT<RuntimeF_>;
+	using Callbacks		= RuntimeCallbacksT<Args>;
+	using Event			= RuntimeEvent;
+
+	using Control		= ControlT	   <Args>;
+	using PlanControl	= PlanControlT <Args>;
+	using FullControl	= FullControlT <Args>;
+	using GuardControl	= GuardControlT<Args>;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+#include "runtime.inl"
@@ -0,0 +1,1683 @@
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TF>
+StateID
+RuntimeLayoutT<TF>::add(const StateID parent,
+						const RuntimeRegion region,
+						const Callbacks& callbacks)
+{
+	HFSM_ASSERT(!_built);
+
+	if (_built || _stateCount >= STATE_COUNT)
+		return INVALID_STATE_ID;
+
+	const StateID stateId = (StateID) _stateCount;
+
+	if (parent == INVALID_STATE_ID) {
+		if (stateId != 0 || region == RuntimeRegion::NONE)
+			return INVALID_STATE_ID;
+	} else if (parent >= stateId ||
+			   _regions[parent] == INVALID_REGION_ID ||
+			   parent + _sizes[parent] != stateId)
+		return INVALID_STATE_ID;
+
+	if (region != RuntimeRegion::NONE) {
+		if (_regionCount >= REGION_COUNT)
+			return INVALID_STATE_ID;
+
+		if (region == RuntimeRegion::ORTHOGONAL ?
+				_orthoCount >= ORTHO_REGIONS :
+				_compoCount >= COMPO_REGIONS)
+			return INVALID_STATE_ID;
+	}
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	if (parent != INVALID_STATE_ID) {
+		const RegionID owner = _regions[parent];
+
+		_parents[stateId] = Parent{_forks[owner], _widths[owner]};
+		++_widths[owner];
+
+		for (StateID s = parent; s != INVALID_STATE_ID; s = _owners[s])
+			++_sizes[s];
+	} else
+		_parents[stateId] = Parent{};
+
+	_owners [stateId] = parent;
+	_sizes  [stateId] = 1;
+
+	if (region != RuntimeRegion::NONE) {
+		const RegionID regionId = _regionCount++;
+
+		_heads [regionId] = stateId;
+		_types [regionId] = region;
+		_widths[regionId] = 0;
+		_forks [regionId] = region == RuntimeRegion::ORTHOGONAL ?
+								(ForkID) -++_orthoCount :
+								(ForkID)  ++_compoCount;
+
+		_regions[stateId] = regionId;
+	} else
+		_regions[stateId] = INVALID_REGION_ID;
+
+	_utilities	  [stateId] = callbacks.utility;
+	_entryGuards  [stateId] = callbacks.entryGuard;
+	_enters		  [stateId] = callbacks.enter;
+	_reenters	  [stateId] = callbacks.reenter;
+	_updates	  [stateId] = callbacks.update;
+	_reacts		  [stateId] = callbacks.react;
+	_exitGuards	  [stateId] = callbacks.exitGuard;
+	_exits		  [stateId] = callbacks.exit;
+	_planSucceeded[stateId] = callbacks.planSucceeded;
+	_planFailed	  [stateId] = callbacks.planFailed;
+
+	++_stateCount;
+
+	return stateId;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TF>
+bool
+RuntimeLayoutT<TF>::build() {
+	HFSM_ASSERT(!_built);
+
+	if (_built || _stateCount == 0)
+		return false;
+
+	LongIndex  first = 0;
+	ShortIndex units = 0;
+
+	for (RegionID r = 0; r < _regionCount; ++r) {
+		if (_widths[r] == 0)
+			return false;
+
+		_firstProngs[r] = first;
+		first += _widths[r];
+
+		if (_types[r] == RuntimeRegion::ORTHOGONAL) {
+			_units[r] = units;
+			units += (_widths[r] + 7) / 8;
+
+			if (units > ORTHO_UNITS)
+				return false;
+		}
+	}
+
+	for (StateID s = 1; s < _stateCount; ++s)
+		_prongs[_firstProngs[_regions[_owners[s]]] + _parents[s].prong] = s;
+
+	_built = true;
+
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TF>
+RuntimeR_<TF>::RuntimeR_(const Layout& layout,
+						 Context& context
+						 HFSM_IF_LOGGER(, Logger* const logger))
+	: _layout{layout}
+	, _context{context}
+	HFSM_IF_LOGGER(, _logger{logger})
+{
+	HFSM_ASSERT(_layout._built);
+
+	for (StateID s = 0; s < _layout._stateCount; ++s)
+		_registry.stateParents[s] = _layout._parents[s];
+
+	for (RegionID r = 0; r < _layout._regionCount; ++r) {
+		const ForkID forkId = _layout._forks[r];
+		const Parent parent = _layout._parents[_layout._heads[r]];
+
+		if (forkId > 0)
+			_registry.compoParents[forkId - 1] = parent;
+		else
+			Forks::attach(_registry,
+						  (ShortIndex) (-forkId - 1),
+						  parent,
+						  Units{_layout._units[r], _layout._widths[r]});
+	}
+
+	initialEnter();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+RuntimeR_<TF>::~RuntimeR_() {
+	PlanControl control{_context,
+						_rng,
+						_registry,
+						_planData,
+						HFSM_LOGGER_OR(_logger, nullptr)
+						HFSM_IF_PROFILER(, nullptr)
+						HFSM_IF_STATISTICS(, nullptr)
+						HFSM_IF_TIMERS(, _timers)};
+
+	deepExit	(control, 0);
+	deepDestruct(control, 0);
+
+	HFSM_IF_ASSERT(_planData.verifyPlans());
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TF>
+void
+RuntimeR_<TF>::update() {
+	HFSM_IF_TIMERS(_timers.advance(_requests, _registry));
+
+	FullControl control{_context,
+						_rng,
+						_registry,
+						_planData,
+						_requests,
+						HFSM_LOGGER_OR(_logger, nullptr)
+						HFSM_IF_PROFILER(, nullptr)
+						HFSM_IF_STATISTICS(, nullptr)
+						HFSM_IF_TIMERS(, _timers)};
+
+	deepUpdate(control, 0);
+
+	HFSM_IF_ASSERT(_planData.verifyPlans());
+
+	if (_requests.count())
+		processTransitions();
+
+	_requests.clear();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+template <typename TEvent>
+void
+RuntimeR_<TF>::react(const TEvent& event) {
+	const RuntimeEvent runtimeEvent{event};
+
+	FullControl control{_context,
+						_rng,
+						_registry,
+						_planData,
+						_requests,
+						HFSM_LOGGER_OR(_logger, nullptr)
+						HFSM_IF_PROFILER(, nullptr)
+						HFSM_IF_STATISTICS(, nullptr)
+						HFSM_IF_TIMERS(, _timers)};
+
+	deepReact(control, 0, runtimeEvent);
+
+	HFSM_IF_ASSERT(_planData.verifyPlans());
+
+	if (_requests.count())
+		processTransitions();
+
+	_requests.clear();
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TF>
+void
+RuntimeR_<TF>::changeTo(const StateID stateId) {
+	_requests.append(Request{Request::Type::CHANGE, stateId});
+
+	HFSM_LOG_TRANSITION(_context, INVALID_STATE_ID, TransitionType::CHANGE, stateId);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+void
+RuntimeR_<TF>::restart(const StateID stateId) {
+	_requests.append(Request{Request::Type::RESTART, stateId});
+
+	HFSM_LOG_TRANSITION(_context, INVALID_STATE_ID, TransitionType::RESTART, stateId);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+void
+RuntimeR_<TF>::resume(const StateID stateId) {
+	_requests.append(Request{Request::Type::RESUME, stateId});
+
+	HFSM_LOG_TRANSITION(_context, INVALID_STATE_ID, TransitionType::RESUME, stateId);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+void
+RuntimeR_<TF>::utilize(const StateID stateId) {
+	_requests.append(Request{Request::Type::UTILIZE, stateId});
+
+	HFSM_LOG_TRANSITION(_context, INVALID_STATE_ID, TransitionType::UTILIZE, stateId);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+void
+RuntimeR_<TF>::schedule(const StateID stateId) {
+	_requests.append(Request{Request::Type::SCHEDULE, stateId});
+
+	HFSM_LOG_TRANSITION(_context, INVALID_STATE_ID, TransitionType::SCHEDULE, stateId);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TF>
+void
+RuntimeR_<TF>::initialEnter() {
+	HFSM_ASSERT(_requests.count() == 0);
+
+	RegistryBackUp undo;
+	Requests lastRequests;
+
+	PlanControl control{_context,
+						_rng,
+						_registry,
+						_planData,
+						HFSM_LOGGER_OR(_logger, nullptr)
+						HFSM_IF_PROFILER(, nullptr)
+						HFSM_IF_STATISTICS(, nullptr)
+						HFSM_IF_TIMERS(, _timers)};
+
+	deepRequestChange(control, 0);
+
+	cancelledByEntryGuards(_requests);
+
+	for (LongIndex i = 0;
+		 i < SUBSTITUTION_LIMIT && _requests.count();
+		 ++i)
+	{
+		backup(_registry, undo);
+
+		if (applyRequests(control)) {
+			lastRequests = _requests;
+			_requests.clear();
+
+			if (cancelledByEntryGuards(lastRequests))
+				restore(_registry, undo);
+		} else
+			_requests.clear();
+	}
+	HFSM_ASSERT(_requests.count() == 0);
+
+	deepConstruct(control, 0);
+	deepEnter	 (control, 0);
+
+	_registry.clearRequests();
+
+	HFSM_IF_ASSERT(_planData.verifyPlans());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+void
+RuntimeR_<TF>::processTransitions() {
+	HFSM_ASSERT(_requests.count());
+
+	RegistryBackUp undo;
+	Requests lastRequests;
+
+	PlanControl control{_context,
+						_rng,
+						_registry,
+						_planData,
+						HFSM_LOGGER_OR(_logger, nullptr)
+						HFSM_IF_PROFILER(, nullptr)
+						HFSM_IF_STATISTICS(, nullptr)
+						HFSM_IF_TIMERS(, _timers)};
+
+	bool changesMade = false;
+
+	for (LongIndex i = 0;
+		i < SUBSTITUTION_LIMIT && _requests.count();
+		++i)
+	{
+		backup(_registry, undo);
+
+		if (applyRequests(control)) {
+			lastRequests = _requests;
+			_requests.clear();
+
+			HFSM_IF_PAYLOADS(const uint16_t round = _planData.payloads.seal());
+
+			if (cancelledByGuards(lastRequests)) {
+				restore(_registry, undo);
+				HFSM_IF_PAYLOADS(_planData.payloads.discard(round));
+			} else
+				changesMade = true;
+		} else {
+			_requests.clear();
+
+			HFSM_IF_PAYLOADS(_planData.payloads.discard(_planData.payloads.seal()));
+		}
+	}
+
+	if (changesMade) {
+		deepChangeToRequested(control, 0);
+
+		_registry.clearRequests();
+
+		HFSM_IF_ASSERT(_planData.verifyPlans());
+	}
+
+	HFSM_IF_PAYLOADS(_planData.payloads.clear());
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TF>
+bool
+RuntimeR_<TF>::applyRequest(Control& control,
+							const Request& request)
+{
+	switch (request.type) {
+	case Request::CHANGE:
+	case Request::RESTART:
+	case Request::RESUME:
+	case Request::UTILIZE:
+		if (_registry.requestImmediate(request))
+			deepForwardActive(control, 0, request.type);
+		else
+			deepRequest		 (control, 0, request.type);
+
+		return true;
+
+	case Request::SCHEDULE:
+		_registry.requestScheduled(request.stateId);
+
+		return false;
+
+	default:
+		// no random regions in runtime layouts
+		HFSM_BREAK();
+
+		return false;
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+bool
+RuntimeR_<TF>::applyRequests(Control& control) {
+	bool changesMade = false;
+
+	for (const Request& request : _requests)
+		changesMade |= applyRequest(control, request);
+
+	return changesMade;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TF>
+bool
+RuntimeR_<TF>::cancelledByEntryGuards(const Requests& pendingRequests) {
+	GuardControl guardControl{_context,
+							  _rng,
+							  _registry,
+							  _planData,
+							  _requests,
+							  pendingRequests,
+							  HFSM_LOGGER_OR(_logger, nullptr)
+							  HFSM_IF_PROFILER(, nullptr)
+							  HFSM_IF_STATISTICS(, nullptr)
+							  HFSM_IF_TIMERS(, _timers)};
+
+	return deepEntryGuard(guardControl, 0);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+bool
+RuntimeR_<TF>::cancelledByGuards(const Requests& pendingRequests) {
+	GuardControl guardControl{_context,
+							  _rng,
+							  _registry,
+							  _planData,
+							  _requests,
+							  pendingRequests,
+							  HFSM_LOGGER_OR(_logger, nullptr)
+							  HFSM_IF_PROFILER(, nullptr)
+							  HFSM_IF_STATISTICS(, nullptr)
+							  HFSM_IF_TIMERS(, _timers)};
+
+	return deepForwardExitGuard (guardControl, 0) ||
+		   deepForwardEntryGuard(guardControl, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TF>
+StateID
+RuntimeR_<TF>::prong(const RegionID regionId,
+					 const ShortIndex index) const
+{
+	HFSM_ASSERT(index < _layout._widths[regionId]);
+
+	return _layout._prongs[_layout._firstProngs[regionId] + index];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+ShortIndex&
+RuntimeR_<TF>::compoRequested(const RegionID regionId) {
+	HFSM_ASSERT(_layout._forks[regionId] > 0);
+
+	return _registry.compoRequested[_layout._forks[regionId] - 1];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+ShortIndex&
+RuntimeR_<TF>::compoActive(const RegionID regionId) {
+	HFSM_ASSERT(_layout._forks[regionId] > 0);
+
+	return _registry.compoActive[_layout._forks[regionId] - 1];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+ShortIndex&
+RuntimeR_<TF>::compoResumable(const RegionID regionId) {
+	HFSM_ASSERT(_layout._forks[regionId] > 0);
+
+	return _registry.compoResumable[_layout._forks[regionId] - 1];
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+typename RuntimeR_<TF>::ForkBits
+RuntimeR_<TF>::orthoRequested(const RegionID regionId) {
+	HFSM_ASSERT(_layout._forks[regionId] < 0);
+
+	return Forks::requested(_registry, _layout._forks[regionId]);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TF>
+bool
+RuntimeR_<TF>::stateEntryGuard(GuardControl& control,
+							   const StateID stateId)
+{
+	const auto callback = _layout._entryGuards[stateId];
+	HFSM_LOG_RUNTIME_METHOD(callback, stateId, Method::ENTRY_GUARD);
+
+	ScopedOrigin origin{control, stateId};
+
+	const bool cancelledBefore = control._cancelled;
+
+	if (callback)
+		callback(stateId, control);
+
+	return !cancelledBefore && control._cancelled;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+void
+RuntimeR_<TF>::stateConstruct(PlanControl& HFSM_IF_ASSERT(control),
+							  const StateID stateId)
+{
+	HFSM_ASSERT(!control._planData.tasksSuccesses.get(stateId));
+	HFSM_ASSERT(!control._planData.tasksFailures .get(stateId));
+
+	HFSM_LOG_RUNTIME_METHOD(_layout._enters[stateId], stateId, Method::CONSTRUCT);
+	(void) stateId;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+void
+RuntimeR_<TF>::stateEnter(PlanControl& control,
+						  const StateID stateId)
+{
+	const auto callback = _layout._enters[stateId];
+	HFSM_LOG_RUNTIME_METHOD(callback, stateId, Method::ENTER);
+
+	ScopedOrigin origin{control, stateId};
+
+	if (callback)
+		callback(stateId, control);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+void
+RuntimeR_<TF>::stateReenter(PlanControl& control,
+							const StateID stateId)
+{
+	HFSM_ASSERT(!control._planData.tasksSuccesses.get(stateId));
+	HFSM_ASSERT(!control._planData.tasksFailures .get(stateId));
+
+	const auto callback = _layout._reenters[stateId];
+	HFSM_LOG_RUNTIME_METHOD(callback, stateId, Method::REENTER);
+
+	ScopedOrigin origin{control, stateId};
+
+	if (callback)
+		callback(stateId, control);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+Status
+RuntimeR_<TF>::stateUpdate(FullControl& control,
+						   const StateID stateId)
+{
+	const auto callback = _layout._updates[stateId];
+	HFSM_LOG_RUNTIME_METHOD(callback, stateId, Method::UPDATE);
+
+	ScopedOrigin origin{control, stateId};
+
+	if (callback)
+		callback(stateId, control);
+
+	return control._status;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+Status
+RuntimeR_<TF>::stateReact(FullControl& control,
+						  const StateID stateId,
+						  const RuntimeEvent& event)
+{
+	const auto callback = _layout._reacts[stateId];
+	HFSM_LOG_RUNTIME_METHOD(callback, stateId, Method::REACT);
+
+	ScopedOrigin origin{control, stateId};
+
+	if (callback)
+		callback(stateId, event, control);
+
+	return control._status;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+bool
+RuntimeR_<TF>::stateExitGuard(GuardControl& control,
+							  const StateID stateId)
+{
+	const auto callback = _layout._exitGuards[stateId];
+	HFSM_LOG_RUNTIME_METHOD(callback, stateId, Method::EXIT_GUARD);
+
+	ScopedOrigin origin{control, stateId};
+
+	const bool cancelledBefore = control._cancelled;
+
+	if (callback)
+		callback(stateId, control);
+
+	return !cancelledBefore && control._cancelled;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+void
+RuntimeR_<TF>::stateExit(PlanControl& control,
+						 const StateID stateId)
+{
+	const auto callback = _layout._exits[stateId];
+	HFSM_LOG_RUNTIME_METHOD(callback, stateId, Method::EXIT);
+
+	ScopedOrigin origin{control, stateId};
+
+	if (callback)
+		callback(stateId, control);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+void
+RuntimeR_<TF>::stateDestruct(PlanControl& control,
+							 const StateID stateId)
+{
+	HFSM_LOG_RUNTIME_METHOD(_layout._exits[stateId], stateId, Method::DESTRUCT);
+
+	HFSM_IF_TIMERS(control._timers.cancel(stateId));
+
+	control._planData.tasksSuccesses.reset(stateId);
+	control._planData.tasksFailures .reset(stateId);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+void
+RuntimeR_<TF>::statePlanSucceeded(FullControl& control,
+								  const StateID stateId)
+{
+	const auto callback = _layout._planSucceeded[stateId];
+	HFSM_LOG_RUNTIME_METHOD(callback, stateId, Method::PLAN_SUCCEEDED);
+
+	ScopedOrigin origin{control, stateId};
+
+	if (callback)
+		callback(stateId, control);
+	else
+		control.succeed();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+void
+RuntimeR_<TF>::statePlanFailed(FullControl& control,
+							   const StateID stateId)
+{
+	const auto callback = _layout._planFailed[stateId];
+	HFSM_LOG_RUNTIME_METHOD(callback, stateId, Method::PLAN_FAILED);
+
+	ScopedOrigin origin{control, stateId};
+
+	if (callback)
+		callback(stateId, control);
+	else
+		control.fail();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+typename RuntimeR_<TF>::UP
+RuntimeR_<TF>::stateReport(Control& control,
+						   const StateID stateId)
+{
+	const auto callback = _layout._utilities[stateId];
+	HFSM_LOG_RUNTIME_METHOD(callback, stateId, Method::UTILITY);
+
+	const Utility utility = callback ?
+		callback(stateId, static_cast<const Control&>(control)) : Utility{1.0f};
+
+	return {utility, _layout._parents[stateId].prong};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TF>
+bool
+RuntimeR_<TF>::deepForwardEntryGuard(GuardControl& control,
+									 const StateID stateId)
+{
+	const RegionID regionId = _layout._regions[stateId];
+
+	if (regionId == INVALID_REGION_ID)
+		return false;
+
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL) {
+		const ForkBits requested = orthoRequested(regionId);
+
+		ScopedRegion region{control, regionId, stateId, _layout._sizes[stateId]};
+
+		bool cancelled = false;
+
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			if (!requested || requested.get(i))
+				cancelled |= deepForwardEntryGuard(control, prong(regionId, i));
+
+		return cancelled;
+	} else {
+		const ShortIndex active	   = compoActive   (regionId);
+		const ShortIndex requested = compoRequested(regionId);
+
+		ScopedRegion region{control, regionId, stateId, _layout._sizes[stateId]};
+
+		if (requested == INVALID_SHORT_INDEX)
+			return deepForwardEntryGuard(control, prong(regionId, active));
+		else
+			return deepEntryGuard		(control, prong(regionId, requested));
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+bool
+RuntimeR_<TF>::deepEntryGuard(GuardControl& control,
+							  const StateID stateId)
+{
+	const RegionID regionId = _layout._regions[stateId];
+
+	if (regionId == INVALID_REGION_ID)
+		return stateEntryGuard(control, stateId);
+
+	ScopedRegion region{control, regionId, stateId, _layout._sizes[stateId]};
+
+	if (stateEntryGuard(control, stateId))
+		return true;
+
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL) {
+		bool cancelled = false;
+
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			cancelled |= deepEntryGuard(control, prong(regionId, i));
+
+		return cancelled;
+	} else
+		return deepEntryGuard(control, prong(regionId, compoRequested(regionId)));
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TF>
+void
+RuntimeR_<TF>::deepConstruct(PlanControl& control,
+							 const StateID stateId)
+{
+	const RegionID regionId = _layout._regions[stateId];
+
+	if (regionId == INVALID_REGION_ID)
+		return stateConstruct(control, stateId);
+
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL) {
+		orthoRequested(regionId).clear();
+
+		stateConstruct(control, stateId);
+
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			deepConstruct(control, prong(regionId, i));
+	} else {
+		ShortIndex& active	  = compoActive   (regionId);
+		ShortIndex& resumable = compoResumable(regionId);
+		ShortIndex& requested = compoRequested(regionId);
+
+		HFSM_ASSERT(active	  == INVALID_SHORT_INDEX);
+		HFSM_ASSERT(requested != INVALID_SHORT_INDEX);
+
+		active	  = requested;
+
+		if (requested == resumable)
+			resumable = INVALID_SHORT_INDEX;
+
+		requested = INVALID_SHORT_INDEX;
+
+		stateConstruct(control, stateId);
+		deepConstruct (control, prong(regionId, active));
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TF>
+void
+RuntimeR_<TF>::deepEnter(PlanControl& control,
+						 const StateID stateId)
+{
+	const RegionID regionId = _layout._regions[stateId];
+
+	if (regionId == INVALID_REGION_ID)
+		return stateEnter(control, stateId);
+
+	ScopedRegion region{control, regionId, stateId, _layout._sizes[stateId]};
+
+	stateEnter(control, stateId);
+
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL)
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			deepEnter(control, prong(regionId, i));
+	else
+		deepEnter(control, prong(regionId, compoActive(regionId)));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+void
+RuntimeR_<TF>::deepReenter(PlanControl& control,
+						   const StateID stateId)
+{
+	const RegionID regionId = _layout._regions[stateId];
+
+	if (regionId == INVALID_REGION_ID)
+		return stateReenter(control, stateId);
+
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL) {
+		orthoRequested(regionId).clear();
+
+		ScopedRegion region{control, regionId, stateId, _layout._sizes[stateId]};
+
+		stateReenter(control, stateId);
+
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			deepReenter(control, prong(regionId, i));
+	} else {
+		ShortIndex& active	  = compoActive   (regionId);
+		ShortIndex& resumable = compoResumable(regionId);
+		ShortIndex& requested = compoRequested(regionId);
+
+		HFSM_ASSERT(active	  != INVALID_SHORT_INDEX &&
+					requested != INVALID_SHORT_INDEX);
+
+		ScopedRegion region{control, regionId, stateId, _layout._sizes[stateId]};
+
+		stateReenter(control, stateId);
+
+		if (active == requested)
+			deepReenter(control, prong(regionId, active));
+		else {
+			deepExit   (control, prong(regionId, active));
+
+			active	  = requested;
+
+			if (requested == resumable)
+				resumable = INVALID_SHORT_INDEX;
+
+			deepEnter  (control, prong(regionId, active));
+		}
+
+		requested = INVALID_SHORT_INDEX;
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TF>
+Status
+RuntimeR_<TF>::deepUpdate(FullControl& control,
+						  const StateID stateId)
+{
+	const RegionID regionId = _layout._regions[stateId];
+
+	if (regionId == INVALID_REGION_ID)
+		return stateUpdate(control, stateId);
+
+	HFSM_IF_UPDATE_PERIODS(if (!_planData.updatePeriods.isDue(regionId)) return Status{});
+
+	ScopedRegion outer{control, regionId, stateId, _layout._sizes[stateId]};
+
+	if (const Status headStatus = stateUpdate(control, stateId)) {
+		ControlLock lock{control};
+		subUpdate(control, regionId);
+
+		return headStatus;
+	} else {
+		const Status subStatus = subUpdate(control, regionId);
+
+		if (subStatus.outerTransition)
+			return _layout._types[regionId] == RuntimeRegion::ORTHOGONAL ?
+				subStatus : Status{Status::NONE, true};
+
+		ScopedRegion inner{control, regionId, stateId, _layout._sizes[stateId]};
+
+		return subStatus && _planData.planExists.get(regionId) ?
+			updatePlan(control, stateId, subStatus) : subStatus;
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+Status
+RuntimeR_<TF>::deepReact(FullControl& control,
+						 const StateID stateId,
+						 const RuntimeEvent& event)
+{
+	const RegionID regionId = _layout._regions[stateId];
+
+	if (regionId == INVALID_REGION_ID)
+		return stateReact(control, stateId, event);
+
+	ScopedRegion outer{control, regionId, stateId, _layout._sizes[stateId]};
+
+	if (const Status headStatus = stateReact(control, stateId, event)) {
+		ControlLock lock{control};
+		subReact(control, regionId, event);
+
+		return headStatus;
+	} else {
+		const Status subStatus = subReact(control, regionId, event);
+
+		if (subStatus.outerTransition)
+			return subStatus;
+
+		ScopedRegion inner{control, regionId, stateId, _layout._sizes[stateId]};
+
+		return subStatus && _planData.planExists.get(regionId) ?
+			updatePlan(control, stateId, subStatus) : subStatus;
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TF>
+bool
+RuntimeR_<TF>::deepForwardExitGuard(GuardControl& control,
+									const StateID stateId)
+{
+	const RegionID regionId = _layout._regions[stateId];
+
+	if (regionId == INVALID_REGION_ID)
+		return false;
+
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL) {
+		const ForkBits requested = orthoRequested(regionId);
+
+		ScopedRegion region{control, regionId, stateId, _layout._sizes[stateId]};
+
+		bool cancelled = false;
+
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			if (!requested || requested.get(i))
+				cancelled |= deepForwardExitGuard(control, prong(regionId, i));
+
+		return cancelled;
+	} else {
+		const ShortIndex active = compoActive(regionId);
+		HFSM_ASSERT(active != INVALID_SHORT_INDEX);
+
+		ScopedRegion region{control, regionId, stateId, _layout._sizes[stateId]};
+
+		if (compoRequested(regionId) == INVALID_SHORT_INDEX)
+			return deepForwardExitGuard(control, prong(regionId, active));
+		else
+			return deepExitGuard	   (control, prong(regionId, active));
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+bool
+RuntimeR_<TF>::deepExitGuard(GuardControl& control,
+							 const StateID stateId)
+{
+	const RegionID regionId = _layout._regions[stateId];
+
+	if (regionId == INVALID_REGION_ID)
+		return stateExitGuard(control, stateId);
+
+	ScopedRegion region{control, regionId, stateId, _layout._sizes[stateId]};
+
+	if (stateExitGuard(control, stateId))
+		return true;
+
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL) {
+		bool cancelled = false;
+
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			cancelled |= deepExitGuard(control, prong(regionId, i));
+
+		return cancelled;
+	} else
+		return deepExitGuard(control, prong(regionId, compoActive(regionId)));
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TF>
+void
+RuntimeR_<TF>::deepExit(PlanControl& control,
+						const StateID stateId)
+{
+	const RegionID regionId = _layout._regions[stateId];
+
+	if (regionId == INVALID_REGION_ID)
+		return stateExit(control, stateId);
+
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL)
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			deepExit(control, prong(regionId, i));
+	else
+		deepExit(control, prong(regionId, compoActive(regionId)));
+
+	stateExit(control, stateId);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TF>
+void
+RuntimeR_<TF>::deepDestruct(PlanControl& control,
+							const StateID stateId)
+{
+	const RegionID regionId = _layout._regions[stateId];
+
+	if (regionId == INVALID_REGION_ID)
+		return stateDestruct(control, stateId);
+
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL) {
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			deepDestruct(control, prong(regionId, i));
+
+		stateDestruct(control, stateId);
+	} else {
+		ShortIndex& active	  = compoActive   (regionId);
+		ShortIndex& resumable = compoResumable(regionId);
+
+		HFSM_ASSERT(active != INVALID_SHORT_INDEX);
+
+		deepDestruct (control, prong(regionId, active));
+		stateDestruct(control, stateId);
+
+		resumable = active;
+		active	  = INVALID_SHORT_INDEX;
+
+		auto plan = control.plan(regionId);
+		plan.clear();
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TF>
+void
+RuntimeR_<TF>::deepForwardActive(Control& control,
+								 const StateID stateId,
+								 const Request::Type request)
+{
+	const RegionID regionId = _layout._regions[stateId];
+
+	if (regionId == INVALID_REGION_ID)
+		return;
+
+	HFSM_ASSERT(control._registry.isActive(stateId));
+
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL) {
+		const ForkBits requested = orthoRequested(regionId);
+		HFSM_ASSERT(!!requested);
+
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i) {
+			const Request::Type local = requested.get(i) ?
+				request : Request::REMAIN;
+
+			deepForwardActive(control, prong(regionId, i), local);
+		}
+	} else {
+		const ShortIndex requested = compoRequested(regionId);
+
+		if (requested == INVALID_SHORT_INDEX)
+			deepForwardActive (control, prong(regionId, compoActive(regionId)), request);
+		else
+			deepForwardRequest(control, prong(regionId, requested), request);
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+void
+RuntimeR_<TF>::deepForwardRequest(Control& control,
+								  const StateID stateId,
+								  const Request::Type request)
+{
+	const RegionID regionId = _layout._regions[stateId];
+
+	if (regionId == INVALID_REGION_ID)
+		return;
+
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL) {
+		const ForkBits requested = orthoRequested(regionId);
+
+		if (requested)
+			for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i) {
+				const Request::Type local = requested.get(i) ?
+					request : Request::REMAIN;
+
+				deepForwardRequest(control, prong(regionId, i), local);
+			}
+		else
+			deepRequest(control, stateId, request);
+	} else {
+		const ShortIndex requested = compoRequested(regionId);
+
+		if (requested == INVALID_SHORT_INDEX)
+			deepRequest		  (control, stateId, request);
+		else
+			deepForwardRequest(control, prong(regionId, requested), request);
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TF>
+void
+RuntimeR_<TF>::deepRequest(Control& control,
+						   const StateID stateId,
+						   const Request::Type request)
+{
+	switch (request) {
+	case Request::REMAIN:
+		deepRequestRemain (control, stateId);
+		break;
+
+	case Request::CHANGE:
+		deepRequestChange (control, stateId);
+		break;
+
+	case Request::RESTART:
+		deepRequestRestart(control, stateId);
+		break;
+
+	case Request::RESUME:
+		deepRequestResume (control, stateId);
+		break;
+
+	case Request::UTILIZE:
+		deepRequestUtilize(control, stateId);
+		break;
+
+	default:
+		HFSM_BREAK();
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+void
+RuntimeR_<TF>::deepRequestChange(Control& control,
+								 const StateID stateId)
+{
+	const RegionID regionId = _layout._regions[stateId];
+
+	if (regionId == INVALID_REGION_ID)
+		return;
+
+	switch (_layout._types[regionId]) {
+	case RuntimeRegion::COMPOSITE:
+		compoRequested(regionId) = 0;
+
+		deepRequestChange(control, prong(regionId, 0));
+		break;
+
+	case RuntimeRegion::RESUMABLE:
+	{
+		const ShortIndex  resumable = compoResumable(regionId);
+			  ShortIndex& requested = compoRequested(regionId);
+
+		requested = (resumable != INVALID_SHORT_INDEX) ?
+			resumable : 0;
+
+		deepRequestChange(control, prong(regionId, requested));
+		break;
+	}
+
+	case RuntimeRegion::UTILITARIAN:
+	{
+		const UP s = subReportChange(control, regionId);
+		HFSM_ASSERT(s.prong != INVALID_SHORT_INDEX);
+
+		ShortIndex& requested = compoRequested(regionId);
+		requested = s.prong;
+
+		HFSM_LOG_UTILITY_RESOLUTION(control.context(), stateId, requested, s.utility);
+		break;
+	}
+
+	case RuntimeRegion::ORTHOGONAL:
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			deepRequestChange(control, prong(regionId, i));
+		break;
+
+	default:
+		HFSM_BREAK();
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+void
+RuntimeR_<TF>::deepRequestRemain(Control& control,
+								 const StateID stateId)
+{
+	const RegionID regionId = _layout._regions[stateId];
+
+	if (regionId == INVALID_REGION_ID)
+		return;
+
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL)
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			deepRequestRemain(control, prong(regionId, i));
+	else {
+		if (compoActive(regionId) == INVALID_SHORT_INDEX)
+			compoRequested(regionId) = 0;
+
+		deepRequestRemain(control, prong(regionId, 0));
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+void
+RuntimeR_<TF>::deepRequestRestart(Control& control,
+								  const StateID stateId)
+{
+	const RegionID regionId = _layout._regions[stateId];
+
+	if (regionId == INVALID_REGION_ID)
+		return;
+
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL)
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			deepRequestRestart(control, prong(regionId, i));
+	else {
+		compoRequested(regionId) = 0;
+
+		deepRequestRestart(control, prong(regionId, 0));
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+void
+RuntimeR_<TF>::deepRequestResume(Control& control,
+								 const StateID stateId)
+{
+	const RegionID regionId = _layout._regions[stateId];
+
+	if (regionId == INVALID_REGION_ID)
+		return;
+
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL)
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			deepRequestResume(control, prong(regionId, i));
+	else {
+		const ShortIndex  resumable = compoResumable(regionId);
+			  ShortIndex& requested = compoRequested(regionId);
+
+		requested = (resumable != INVALID_SHORT_INDEX) ?
+			resumable : 0;
+
+		deepRequestResume(control, prong(regionId, requested));
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+void
+RuntimeR_<TF>::deepRequestUtilize(Control& control,
+								  const StateID stateId)
+{
+	const RegionID regionId = _layout._regions[stateId];
+
+	if (regionId == INVALID_REGION_ID)
+		return;
+
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL)
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			deepRequestUtilize(control, prong(regionId, i));
+	else {
+		const UP s = subReportUtilize(control, regionId);
+
+		ShortIndex& requested = compoRequested(regionId);
+		requested = s.prong;
+
+		HFSM_LOG_UTILITY_RESOLUTION(control.context(), stateId, requested, s.utility);
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TF>
+typename RuntimeR_<TF>::UP
+RuntimeR_<TF>::deepReportChange(Control& control,
+								const StateID stateId)
+{
+	const RegionID regionId = _layout._regions[stateId];
+
+	if (regionId == INVALID_REGION_ID)
+		return stateReport(control, stateId);
+
+	switch (_layout._types[regionId]) {
+	case RuntimeRegion::COMPOSITE:
+	{
+		compoRequested(regionId) = 0;
+
+		const UP h = stateReport	 (control, stateId);
+		const UP s = deepReportChange(control, prong(regionId, 0));
+
+		return {
+			h.utility * s.utility,
+			h.prong
+		};
+	}
+
+	case RuntimeRegion::RESUMABLE:
+	{
+		const ShortIndex  resumable = compoResumable(regionId);
+			  ShortIndex& requested = compoRequested(regionId);
+
+		requested = (resumable != INVALID_SHORT_INDEX) ?
+			resumable : 0;
+
+		const UP h = stateReport	 (control, stateId);
+		const UP s = deepReportChange(control, prong(regionId, requested));
+
+		return {
+			h.utility * s.utility,
+			h.prong
+		};
+	}
+
+	case RuntimeRegion::UTILITARIAN:
+	{
+		const UP h = stateReport	(control, stateId);
+		const UP s = subReportChange(control, regionId);
+
+		ShortIndex& requested = compoRequested(regionId);
+		requested = s.prong;
+
+		HFSM_LOG_UTILITY_RESOLUTION(control.context(), stateId, requested, s.utility);
+
+		return {
+			h.utility * s.utility,
+			h.prong
+		};
+	}
+
+	case RuntimeRegion::ORTHOGONAL:
+	{
+		const UP h = stateReport(control, stateId);
+
+		Utility s = Utility{0.0f};
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			s += deepReportChange(control, prong(regionId, i)).utility;
+
+		const Utility sub = s / _layout._widths[regionId];
+
+		HFSM_LOG_UTILITY_RESOLUTION(control.context(), stateId, INVALID_STATE_ID, sub);
+
+		return {
+			h.utility * sub,
+			h.prong
+		};
+	}
+
+	default:
+		HFSM_BREAK();
+
+		return {};
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+typename RuntimeR_<TF>::UP
+RuntimeR_<TF>::deepReportUtilize(Control& control,
+								 const StateID stateId)
+{
+	const RegionID regionId = _layout._regions[stateId];
+
+	if (regionId == INVALID_REGION_ID)
+		return stateReport(control, stateId);
+
+	const UP h = stateReport(control, stateId);
+
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL) {
+		Utility s = Utility{0.0f};
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			s += deepReportUtilize(control, prong(regionId, i)).utility;
+
+		const Utility sub = s / _layout._widths[regionId];
+
+		HFSM_LOG_UTILITY_RESOLUTION(control.context(), stateId, INVALID_STATE_ID, sub);
+
+		return {
+			h.utility * sub,
+			h.prong
+		};
+	} else {
+		const UP s = subReportUtilize(control, regionId);
+
+		ShortIndex& requested = compoRequested(regionId);
+		requested = s.prong;
+
+		HFSM_LOG_UTILITY_RESOLUTION(control.context(), stateId, requested, s.utility);
+
+		return {
+			h.utility * s.utility,
+			h.prong
+		};
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TF>
+void
+RuntimeR_<TF>::deepChangeToRequested(PlanControl& control,
+									 const StateID stateId)
+{
+	const RegionID regionId = _layout._regions[stateId];
+
+	if (regionId == INVALID_REGION_ID)
+		return;
+
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL) {
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			deepChangeToRequested(control, prong(regionId, i));
+
+		return;
+	}
+
+	ShortIndex& active	  = compoActive	  (regionId);
+	ShortIndex& resumable = compoResumable(regionId);
+	ShortIndex& requested = compoRequested(regionId);
+
+	HFSM_ASSERT(active != INVALID_SHORT_INDEX);
+
+	if (requested == INVALID_SHORT_INDEX)
+		deepChangeToRequested(control, prong(regionId, active));
+	else if (requested != active) {
+		deepExit	 (control, prong(regionId, active));
+		deepDestruct (control, prong(regionId, active));
+
+		resumable = active;
+		active	  = requested;
+		requested = INVALID_SHORT_INDEX;
+
+		deepConstruct(control, prong(regionId, active));
+		deepEnter	 (control, prong(regionId, active));
+	} else if (_registry.compoRemains.get((ShortIndex) (_layout._forks[regionId] - 1))) {
+		deepExit	 (control, prong(regionId, active));
+		deepDestruct (control, prong(regionId, active));
+
+		requested = INVALID_SHORT_INDEX;
+
+		deepConstruct(control, prong(regionId, active));
+		deepEnter	 (control, prong(regionId, active));
+	} else {
+		requested = INVALID_SHORT_INDEX;
+
+		// no reconstruction on reenter() by design
+		deepReenter	 (control, prong(regionId, active));
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TF>
+Status
+RuntimeR_<TF>::subUpdate(FullControl& control,
+						 const RegionID regionId)
+{
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL) {
+		Status status;
+
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			status = combine(status, deepUpdate(control, prong(regionId, i)));
+
+		return status;
+	} else {
+		const ShortIndex active = compoActive(regionId);
+		HFSM_ASSERT(active != INVALID_SHORT_INDEX);
+
+		return deepUpdate(control, prong(regionId, active));
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+Status
+RuntimeR_<TF>::subReact(FullControl& control,
+						const RegionID regionId,
+						const RuntimeEvent& event)
+{
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL) {
+		Status status;
+
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			status = combine(status, deepReact(control, prong(regionId, i), event));
+
+		return status;
+	} else {
+		const ShortIndex active = compoActive(regionId);
+		HFSM_ASSERT(active != INVALID_SHORT_INDEX);
+
+		return deepReact(control, prong(regionId, active), event);
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+typename RuntimeR_<TF>::UP
+RuntimeR_<TF>::subReportChange(Control& control,
+							   const RegionID regionId)
+{
+	UP best = deepReportChange(control, prong(regionId, 0));
+
+	// the first of equal prongs wins
+	for (ShortIndex i = 1; i < _layout._widths[regionId]; ++i) {
+		const UP s = deepReportChange(control, prong(regionId, i));
+
+		if (best.utility < s.utility)
+			best = s;
+	}
+
+	return best;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+typename RuntimeR_<TF>::UP
+RuntimeR_<TF>::subReportUtilize(Control& control,
+								const RegionID regionId)
+{
+	UP best = deepReportUtilize(control, prong(regionId, 0));
+
+	for (ShortIndex i = 1; i < _layout._widths[regionId]; ++i) {
+		const UP s = deepReportUtilize(control, prong(regionId, i));
+
+		if (best.utility < s.utility)
+			best = s;
+	}
+
+	return best;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TF>
+Status
+RuntimeR_<TF>::updatePlan(FullControl& control,
+						  const StateID headId,
+						  const Status subStatus)
+{
+	HFSM_ASSERT(subStatus);
+
+	if (subStatus.result == Status::FAILURE) {
+		control._status.result = Status::FAILURE;
+		statePlanFailed(control, headId);
+
+		if (auto p = control.plan(control._regionId))
+			p.clear();
+
+		return buildPlanStatus(control, headId);
+	} else if (subStatus.result == Status::SUCCESS) {
+		if (auto p = control.plan(control._regionId)) {
+			for (auto it = p.first(); it; ++it) {
+				if (control.hasSucceeded(it->origin)) {
+					HFSM_ASSERT(control.isActive(it->origin));
+
+					ScopedOrigin origin{control, headId};
+
+					control.changeTo(it->destination);
+
+					it.remove();
+				} else
+					break;
+			}
+
+			return Status{};
+		} else {
+			control._status.result = Status::SUCCESS;
+			statePlanSucceeded(control, headId);
+
+			return buildPlanStatus(control, headId);
+		}
+	} else
+		return Status{};
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+Status
+RuntimeR_<TF>::buildPlanStatus(FullControl& control,
+							   const StateID headId)
+{
+	switch (control._status.result) {
+	case Status::NONE:
+		HFSM_BREAK();
+		break;
+
+	case Status::SUCCESS:
+		control.setSucceeded(headId);
+
+		HFSM_LOG_PLAN_STATUS(_context, control._regionId, StatusEvent::SUCCEEDED);
+		break;
+
+	case Status::FAILURE:
+		control.setFailed(headId);
+
+		HFSM_LOG_PLAN_STATUS(_context, control._regionId, StatusEvent::FAILED);
+		break;
+
+	default:
+		HFSM_BREAK();
+	}
+
+	return {control._status.result};
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
@@ -0,0 +1,228 @@
+#pragma once
+
+namespace hfsm2 {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Machine of any SchedulerT<> type, stays valid until the machine is removed
+//  'generation' tells a removed machine from a newer one in the same slot
+
+struct SchedulerHandle {
+	static constexpr uint16_t INVALID = UINT16_MAX;
+
+	HFSM_INLINE bool operator == (const SchedulerHandle other) const {
+		return type == other.type && slot == other.slot && generation == other.generation;
+	}
+
+	HFSM_INLINE bool operator != (const SchedulerHandle other) const	{ return !operator == (other);			}
+
+	uint16_t type = INVALID;
+	uint16_t slot = INVALID;
+	uint32_t generation = 0;
+};
+
+namespace detail {
+
+//------------------------------------------------------------------------------
+
+// Machines of a single type, constructed in place in a contiguous slot array
+//  Machines never move, the dense list keeps live slots for iteration
+
+template <typename TInstance, uint32_t NCapacity>
+class SchedulerPoolT {
+public:
+	using Instance = TInstance;
+
+	static constexpr uint32_t CAPACITY = NCapacity;
+	static constexpr uint16_t INVALID  = SchedulerHandle::INVALID;
+
+	static_assert(CAPACITY < INVALID, "Scheduler capacity is limited to 65534 machines per type");
+
+	HFSM_INLINE SchedulerPoolT();
+	HFSM_INLINE ~SchedulerPoolT();
+
+	SchedulerPoolT(const SchedulerPoolT&) = delete;
+	SchedulerPoolT& operator = (const SchedulerPoolT&) = delete;
+
+	// Slot of the new machine, INVALID if the pool is full
+	template <typename... TArgs>
+	HFSM_INLINE uint16_t emplace(TArgs&&... args);
+
+	HFSM_INLINE void remove(const uint16_t slot);
+
+	HFSM_INLINE bool contains(const uint16_t slot,
+							  const uint32_t generation) const;
+
+	HFSM_INLINE uint32_t generation(const uint16_t slot) const			{ return _generations[slot];			}
+
+	HFSM_INLINE		  Instance& operator[] (const uint16_t slot)		{ return *instance(slot);				}
+	HFSM_INLINE const Instance& operator[] (const uint16_t slot) const	{ return *instance(slot);				}
+
+	HFSM_INLINE uint32_t count() const									{ return _count;						}
+
+	HFSM_INLINE void update();
+
+	template <typename TEvent>
+	HFSM_INLINE void react(const TEvent& event);
+
+	template <typename TFunction>
+	HFSM_INLINE void forEach(TFunction&& function);
+
+private:
+	HFSM_INLINE		  Instance* instance(const uint16_t slot)			{ return reinterpret_cast<		Instance*>(&_storage[slot]);	}
+	HFSM_INLINE const Instance* instance(const uint16_t slot) const		{ return reinterpret_cast<const Instance*>(&_storage[slot]);	}
+
+private:
+	using Storage = typename std::aligned_storage<sizeof(Instance), alignof(Instance)>::type;
+
+	Storage _storage[CAPACITY];
+	uint32_t _generations[CAPACITY];		// bumped on remove()
+
+	uint16_t _dense[CAPACITY];				// live slots, in update order
+	uint16_t _denseIndices[CAPACITY];		// position in '_dense', INVALID if the slot is empty
+
+	uint16_t _free[CAPACITY];
+	uint16_t _freeCount = 0;
+
+	uint16_t _used = 0;						// high-water mark of slots
+	uint16_t _count = 0;
+};
+
+//------------------------------------------------------------------------------
+
+// One pool per machine type, 'NIndex' being the type's position in the scheduler
+
+template <uint32_t, LongIndex, typename...>
+struct SchedulerPoolsT;
+
+template <uint32_t NCapacity, LongIndex NIndex, typename TInstance, typename... TRest>
+struct SchedulerPoolsT<NCapacity, NIndex, TInstance, TRest...>
+	: SchedulerPoolsT<NCapacity, NIndex + 1, TRest...>
+{
+	using Next = SchedulerPoolsT<NCapacity, NIndex + 1, TRest...>;
+	using Pool = SchedulerPoolT<TInstance, NCapacity>;
+
+	using Next::pool;
+
+	HFSM_INLINE		  Pool& pool(const TypeTagT<TInstance>)				{ return _pool;							}
+	HFSM_INLINE const Pool& pool(const TypeTagT<TInstance>) const		{ return _pool;							}
+
+	HFSM_INLINE bool remove(const SchedulerHandle handle);
+	HFSM_INLINE bool contains(const SchedulerHandle handle) const;
+
+	HFSM_INLINE uint32_t count() const									{ return _pool.count() + Next::count();	}
+
+	HFSM_INLINE void update()											{ _pool.update(); Next::update();		}
+
+	template <typename TEvent>
+	HFSM_INLINE void react(const TEvent& event)							{ _pool.react(event); Next::react(event);	}
+
+	template <typename TEvent>
+	HFSM_INLINE bool react(const SchedulerHandle handle,
+						   const TEvent& event);
+
+	Pool _pool;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <uint32_t NCapacity, LongIndex NIndex>
+struct SchedulerPoolsT<NCapacity, NIndex> {
+	HFSM_INLINE void pool() const										{}
+
+	HFSM_INLINE bool remove(const SchedulerHandle) const				{ return false;							}
+	HFSM_INLINE bool contains(const SchedulerHandle) const				{ return false;							}
+
+	HFSM_INLINE uint32_t count() const									{ return 0;								}
+
+	HFSM_INLINE void update()											{}
+
+	template <typename TEvent>
+	HFSM_INLINE void react(const TEvent&)								{}
+
+	template <typename TEvent>
+	HFSM_INLINE bool react(const SchedulerHandle, const TEvent&)		{ return false;							}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+
+// Owns machines of several types, one contiguous pool per type
+//  update() and react() walk the pools type by type,
+//  calling each machine type's own R_::update() / R_::react() without virtual dispatch
+//  Handles address machines of any type, e.g. to route events between them
+//  Machines can't be added or removed while the scheduler is updating or reacting
+//  Storage is sized by 'NCapacity' machines of every type,
+//  large schedulers are best allocated on the heap
+
+template <uint32_t NCapacity, typename... TInstances>
+class SchedulerT {
+	using Types = detail::ITL_<TInstances...>;
+	using Pools = detail::SchedulerPoolsT<NCapacity, 0, TInstances...>;
+
+public:
+	using Handle = SchedulerHandle;
+
+	static constexpr uint32_t  CAPACITY	  = NCapacity;
+	static constexpr LongIndex TYPE_COUNT = sizeof...(TInstances);
+
+	static_assert(TYPE_COUNT > 0,						"Scheduler needs at least one machine type");
+	static_assert(TYPE_COUNT < SchedulerHandle::INVALID, "Too many machine types");
+
+	template <typename TInstance>
+	static constexpr LongIndex typeIndex()								{ return Types::template index<TInstance>();	}
+
+	// Construct a 'TInstance' machine with 'args', returns an invalid handle if its pool is full
+	template <typename TInstance, typename... TArgs>
+	HFSM_INLINE Handle emplace(TArgs&&... args);
+
+	// Returns false for a stale handle
+	HFSM_INLINE bool remove(const Handle handle)						{ return _pools.remove(handle);			}
+
+	HFSM_INLINE bool contains(const Handle handle) const				{ return _pools.contains(handle);		}
+
+	// nullptr for a stale handle or a machine of another type
+	template <typename TInstance>
+	HFSM_INLINE		  TInstance* get(const Handle handle);
+
+	template <typename TInstance>
+	HFSM_INLINE const TInstance* get(const Handle handle) const;
+
+	HFSM_INLINE uint32_t count() const									{ return _pools.count();				}
+
+	template <typename TInstance>
+	HFSM_INLINE uint32_t count() const									{ return pool<TInstance>().count();		}
+
+	// Update every machine, type by type
+	HFSM_INLINE void update()											{ _pools.update();						}
+
+	// React on every machine, type by type
+	template <typename TEvent>
+	HFSM_INLINE void react(const TEvent& event)							{ _pools.react(event);					}
+
+	// React on a single machine, returns false for a stale handle
+	template <typename TEvent>
+	HFSM_INLINE bool react(const Handle handle,
+						   const TEvent& event)							{ return _pools.react(handle, event);	}
+
+	// Call 'function(TInstance&)' on every 'TInstance' machine
+	template <typename TInstance, typename TFunction>
+	HFSM_INLINE void forEach(TFunction&& function)		{ pool<TInstance>().forEach(std::forward<TFunction>(function));	}
+
+private:
+	template <typename TInstance>
+	HFSM_INLINE		  detail::SchedulerPoolT<TInstance, CAPACITY>& pool()		{ return _pools.pool(detail::TypeTagT<TInstance>{});	}
+
+	template <typename TInstance>
+	HFSM_INLINE const detail::SchedulerPoolT<TInstance, CAPACITY>& pool() const	{ return _pools.pool(detail::TypeTagT<TInstance>{});	}
+
+private:
+	Pools _pools;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+
+#include "scheduler.inl"
@@ -0,0 +1,199 @@
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TI, uint32_t NC>
+SchedulerPoolT<TI, NC>::SchedulerPoolT() {
+	for (uint32_t i = 0; i < CAPACITY; ++i) {
+		_generations[i]	 = 0;
+		_denseIndices[i] = INVALID;
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TI, uint32_t NC>
+SchedulerPoolT<TI, NC>::~SchedulerPoolT() {
+	for (uint16_t i = 0; i < _count; ++i)
+		instance(_dense[i])->~Instance();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TI, uint32_t NC>
+template <typename... TArgs>
+uint16_t
+SchedulerPoolT<TI, NC>::emplace(TArgs&&... args) {
+	uint16_t slot;
+
+	if (_freeCount)
+		slot = _free[--_freeCount];
+	else if (_used < CAPACITY)
+		slot = _used++;
+	else
+		return INVALID;
+
+	new (&_storage[slot]) Instance(std::forward<TArgs>(args)...);
+
+	_denseIndices[slot] = _count;
+	_dense[_count++] = slot;
+
+	return slot;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TI, uint32_t NC>
+void
+SchedulerPoolT<TI, NC>::remove(const uint16_t slot) {
+	HFSM_ASSERT(slot < _used && _denseIndices[slot] != INVALID);
+
+	instance(slot)->~Instance();
+	++_generations[slot];
+
+	const uint16_t index = _denseIndices[slot];
+	const uint16_t last = _dense[--_count];
+
+	_dense[index] = last;
+	_denseIndices[last] = index;
+	_denseIndices[slot] = INVALID;
+
+	_free[_freeCount++] = slot;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TI, uint32_t NC>
+bool
+SchedulerPoolT<TI, NC>::contains(const uint16_t slot,
+								 const uint32_t generation) const
+{
+	return slot < _used
+		&& _denseIndices[slot] != INVALID
+		&& _generations[slot] == generation;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TI, uint32_t NC>
+void
+SchedulerPoolT<TI, NC>::update() {
+	for (uint16_t i = 0; i < _count; ++i)
+		instance(_dense[i])->update();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TI, uint32_t NC>
+template <typename TEvent>
+void
+SchedulerPoolT<TI, NC>::react(const TEvent& event) {
+	for (uint16_t i = 0; i < _count; ++i)
+		instance(_dense[i])->react(event);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TI, uint32_t NC>
+template <typename TFunction>
+void
+SchedulerPoolT<TI, NC>::forEach(TFunction&& function) {
+	for (uint16_t i = 0; i < _count; ++i)
+		function(*instance(_dense[i]));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <uint32_t NC, LongIndex NI, typename TI, typename... TR>
+bool
+SchedulerPoolsT<NC, NI, TI, TR...>::remove(const SchedulerHandle handle) {
+	if (handle.type != NI)
+		return Next::remove(handle);
+
+	if (!_pool.contains(handle.slot, handle.generation))
+		return false;
+
+	_pool.remove(handle.slot);
+
+	return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <uint32_t NC, LongIndex NI, typename TI, typename... TR>
+bool
+SchedulerPoolsT<NC, NI, TI, TR...>::contains(const SchedulerHandle handle) const {
+	return handle.type == NI ?
+		_pool.contains(handle.slot, handle.generation) :
+		Next::contains(handle);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <uint32_t NC, LongIndex NI, typename TI, typename... TR>
+template <typename TEvent>
+bool
+SchedulerPoolsT<NC, NI, TI, TR...>::react(const SchedulerHandle handle,
+										  const TEvent& event)
+{
+	if (handle.type != NI)
+		return Next::react(handle, event);
+
+	if (!_pool.contains(handle.slot, handle.generation))
+		return false;
+
+	_pool[handle.slot].react(event);
+
+	return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+
+template <uint32_t NC, typename... TI>
+template <typename TInstance, typename... TArgs>
+SchedulerHandle
+SchedulerT<NC, TI...>::emplace(TArgs&&... args) {
+	detail::SchedulerPoolT<TInstance, CAPACITY>& typePool = pool<TInstance>();
+
+	const uint16_t slot = typePool.emplace(std::forward<TArgs>(args)...);
+	if (slot == SchedulerHandle::INVALID)
+		return Handle{};
+
+	Handle handle;
+	handle.type		  = (uint16_t) typeIndex<TInstance>();
+	handle.slot		  = slot;
+	handle.generation = typePool.generation(slot);
+
+	return handle;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <uint32_t NC, typename... TI>
+template <typename TInstance>
+TInstance*
+SchedulerT<NC, TI...>::get(const Handle handle) {
+	detail::SchedulerPoolT<TInstance, CAPACITY>& typePool = pool<TInstance>();
+
+	return handle.type == typeIndex<TInstance>() && typePool.contains(handle.slot, handle.generation) ?
+		&typePool[handle.slot] : nullptr;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <uint32_t NC, typename... TI>
+template <typename TInstance>
+const TInstance*
+SchedulerT<NC, TI...>::get(const Handle handle) const {
+	const detail::SchedulerPoolT<TInstance, CAPACITY>& typePool = pool<TInstance>();
+
+	return handle.type == typeIndex<TInstance>() && typePool.contains(handle.slot, handle.generation) ?
+		&typePool[handle.slot] : nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
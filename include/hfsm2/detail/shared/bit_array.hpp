@@ -91,6 +91,9 @@ public:
 
 	HFSM_INLINE void clear();
 
+	// Check if any bit is set
+	HFSM_INLINE explicit operator bool() const;
+
 	template <ShortIndex NIndex>
 	HFSM_INLINE bool get() const;
 
@@ -102,7 +105,7 @@ public:
 
 	HFSM_INLINE bool get  (const Index index) const;
 	HFSM_INLINE void set  (const Index index);
-	//HFSM_INLINE void reset(const Index index);
+	HFSM_INLINE void reset(const Index index);
 
 	template <ShortIndex NUnit, ShortIndex NWidth>
 	HFSM_INLINE		 Bits bits();
@@ -194,6 +194,17 @@ BitArray<TI, NC>::get() const {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+template <typename TI, ShortIndex NC>
+BitArray<TI, NC>::operator bool() const {
+	for (const Unit& unit: _storage)
+		if (unit)
+			return true;
+
+	return false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
 template <typename TI, ShortIndex NC>
 template <ShortIndex NIndex>
 void
@@ -254,17 +265,17 @@ BitArray<TI, NC>::set(const Index index) {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-//template <typename TI, ShortIndex NC>
-//void
-//BitArray<TI, NC>::reset(const Index index) {
-//	HFSM_ASSERT(index < CAPACITY);
-//
-//	const Index unit = index / (sizeof(Unit) * 8);
-//	const Index bit  = index % (sizeof(Unit) * 8);
-//	const Unit mask = 1 << bit;
-//
-//	_storage[unit] &= ~mask;
-//}
+template <typename TI, ShortIndex NC>
+void
+BitArray<TI, NC>::reset(const Index index) {
+	HFSM_ASSERT(index < CAPACITY);
+
+	const Index unit = index / (sizeof(Unit) * 8);
+	const Index bit  = index % (sizeof(Unit) * 8);
+	const Unit mask = 1 << bit;
+
+	_storage[unit] &= ~mask;
+}
 
 //------------------------------------------------------------------------------
 
@@ -0,0 +1,118 @@
+#pragma once
+
+namespace hfsm2 {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// How EventBufferT merges an event with the last queued one, if it's of the same type
+//  None	- every event is queued
+//  Latest	- the new event replaces the queued one
+//  Sum		- the new event is added to the queued one with 'operator +='
+//  Events of other types queued in between aren't merged across,
+//  so transitions they cause see the events on either side of them
+
+enum class Coalesce : uint8_t {
+	None,
+	Latest,
+	Sum,
+};
+
+// Per-event-type policy, specialize to opt in:
+//  template <> struct hfsm2::CoalesceT<Position> { static constexpr Coalesce VALUE = Coalesce::Latest; };
+
+template <typename TEvent>
+struct CoalesceT {
+	static constexpr Coalesce VALUE = Coalesce::None;
+};
+
+//------------------------------------------------------------------------------
+
+// Fixed-capacity queue of events of different types, in arrival order
+//  Every event takes a slot sized for the largest of 'TEvents',
+//  events are copied in and never destroyed, so they must be trivially destructible
+//  Events with a CoalesceT<> policy are merged with the last queued event of the same type
+//  Feed to R_::reactBatch() or flush() to dispatch the whole queue in one go
+
+template <LongIndex NCapacity, typename... TEvents>
+class EventBufferT {
+public:
+	using Index	 = LongIndex;
+	using Events = detail::ITL_<TEvents...>;
+
+	static constexpr Index CAPACITY = NCapacity;
+	static constexpr Index INVALID	= Index (-1);
+
+	static_assert(Events::SIZE <= (ShortIndex) -1, "Too many event types");
+
+private:
+	using Storage = typename std::aligned_union<0, TEvents...>::type;
+
+	struct Slot {
+		Storage storage;
+		ShortIndex type;
+	};
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	template <typename... Ts>
+	struct VisitT;
+
+	template <typename T, typename... Ts>
+	struct VisitT<T, Ts...> {
+		template <typename TVisitor>
+		static HFSM_INLINE void visit(const Slot& slot, TVisitor& visitor);
+	};
+
+	template <typename T>
+	struct VisitT<T> {
+		template <typename TVisitor>
+		static HFSM_INLINE void visit(const Slot& slot, TVisitor& visitor);
+	};
+
+	template <Coalesce NPolicy>
+	using CoalesceTag = std::integral_constant<Coalesce, NPolicy>;
+
+	template <typename TEvent>
+	static HFSM_INLINE void merge(TEvent&, const TEvent&, CoalesceTag<Coalesce::None>)	{}
+
+	template <typename TEvent>
+	static HFSM_INLINE void merge(TEvent& queued, const TEvent& event, CoalesceTag<Coalesce::Latest>);
+
+	template <typename TEvent>
+	static HFSM_INLINE void merge(TEvent& queued, const TEvent& event, CoalesceTag<Coalesce::Sum>);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+public:
+	HFSM_INLINE EventBufferT();
+
+	// Returns false if the buffer is full
+	template <typename TEvent>
+	HFSM_INLINE bool push(const TEvent& event);
+
+	HFSM_INLINE void clear();
+
+	HFSM_INLINE Index count() const								{ return _count;				}
+
+	// Events merged into queued ones since the last clear()
+	HFSM_INLINE Index coalesced() const							{ return _coalesced;			}
+
+	// Call 'visitor(const TEvent&)' for every event, in the order they were pushed
+	template <typename TVisitor>
+	HFSM_INLINE void visit(TVisitor& visitor) const;
+
+	// Dispatch the queue with 'machine.reactBatch()' and clear it
+	template <typename TMachine>
+	HFSM_INLINE void flush(TMachine& machine);
+
+private:
+	Slot _slots[CAPACITY];
+	Index _count = 0;
+	Index _coalesced = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+
+#include "event_buffer.inl"
@@ -0,0 +1,128 @@
+namespace hfsm2 {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <LongIndex NC, typename... TE>
+template <typename T, typename... Ts>
+template <typename TVisitor>
+void
+EventBufferT<NC, TE...>::VisitT<T, Ts...>::visit(const Slot& slot,
+												 TVisitor& visitor)
+{
+	if (slot.type == Events::template index<T>())
+		visitor(*reinterpret_cast<const T*>(&slot.storage));
+	else
+		VisitT<Ts...>::visit(slot, visitor);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NC, typename... TE>
+template <typename T>
+template <typename TVisitor>
+void
+EventBufferT<NC, TE...>::VisitT<T>::visit(const Slot& slot,
+										  TVisitor& visitor)
+{
+	HFSM_ASSERT(slot.type == Events::template index<T>());
+
+	visitor(*reinterpret_cast<const T*>(&slot.storage));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NC, typename... TE>
+template <typename TEvent>
+void
+EventBufferT<NC, TE...>::merge(TEvent& queued,
+							   const TEvent& event,
+							   CoalesceTag<Coalesce::Latest>)
+{
+	new (&queued) TEvent{event};
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NC, typename... TE>
+template <typename TEvent>
+void
+EventBufferT<NC, TE...>::merge(TEvent& queued,
+							   const TEvent& event,
+							   CoalesceTag<Coalesce::Sum>)
+{
+	queued += event;
+}
+
+//------------------------------------------------------------------------------
+
+template <LongIndex NC, typename... TE>
+EventBufferT<NC, TE...>::EventBufferT() {
+	clear();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NC, typename... TE>
+template <typename TEvent>
+bool
+EventBufferT<NC, TE...>::push(const TEvent& event) {
+	static_assert(Events::template contains<TEvent>(), "Event type not in the buffer's list");
+	static_assert(std::is_trivially_destructible<TEvent>::value, "Buffered events are never destroyed");
+
+	constexpr Coalesce POLICY = CoalesceT<TEvent>::VALUE;
+	constexpr ShortIndex TYPE = (ShortIndex) Events::template index<TEvent>();
+
+	if (POLICY != Coalesce::None && _count && _slots[_count - 1].type == TYPE) {
+		merge(*reinterpret_cast<TEvent*>(&_slots[_count - 1].storage),
+			  event,
+			  CoalesceTag<POLICY>{});
+
+		++_coalesced;
+
+		return true;
+	}
+
+	if (_count == CAPACITY)
+		return false;
+
+	Slot& slot = _slots[_count++];
+
+	new (&slot.storage) TEvent{event};
+	slot.type = TYPE;
+
+	return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NC, typename... TE>
+void
+EventBufferT<NC, TE...>::clear() {
+	_count = 0;
+	_coalesced = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NC, typename... TE>
+template <typename TVisitor>
+void
+EventBufferT<NC, TE...>::visit(TVisitor& visitor) const {
+	for (Index i = 0; i < _count; ++i)
+		VisitT<TE...>::visit(_slots[i], visitor);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NC, typename... TE>
+template <typename TMachine>
+void
+EventBufferT<NC, TE...>::flush(TMachine& machine) {
+	machine.reactBatch(*this);
+
+	clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -96,14 +96,23 @@
 		if (auto* const logger = control.logger())								\
 			logger->recordMethod(CONTEXT, STATE_ID, METHOD_ID)
 
+	#define HFSM_LOG_RUNTIME_METHOD(CALLBACK, STATE_ID, METHOD_ID)				\
+		if (_logger)															\
+			_logger->recordMethod(_context, STATE_ID, METHOD_ID)
+
 #elif defined HFSM_ENABLE_LOG_INTERFACE
 
 	#define HFSM_LOG_STATE_METHOD(METHOD, CONTEXT, METHOD_ID)					\
 		if (auto* const logger = control.logger())								\
 			log<decltype(METHOD)>(*logger, CONTEXT, METHOD_ID)
 
+	#define HFSM_LOG_RUNTIME_METHOD(CALLBACK, STATE_ID, METHOD_ID)				\
+		if (_logger && CALLBACK)												\
+			_logger->recordMethod(_context, STATE_ID, METHOD_ID)
+
 #else
 	#define HFSM_LOG_STATE_METHOD(METHOD, CONTEXT, METHOD_ID)
+	#define HFSM_LOG_RUNTIME_METHOD(CALLBACK, STATE_ID, METHOD_ID)
 #endif
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -124,6 +133,111 @@
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+#ifdef HFSM_ENABLE_TRANSITION_TRACE
+	#define HFSM_IF_TRANSITION_TRACE(...)							  __VA_ARGS__
+#else
+	#define HFSM_IF_TRANSITION_TRACE(...)
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_PROFILER
+	#define HFSM_IF_PROFILER(...)									  __VA_ARGS__
+
+	#define HFSM_PROFILE_STATE_METHOD(METHOD_ID)								\
+		ScopedProfiler scopedProfiler{control.profiler(), STATE_ID, METHOD_ID}
+#else
+	#define HFSM_IF_PROFILER(...)
+	#define HFSM_PROFILE_STATE_METHOD(METHOD_ID)
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_STATISTICS
+	#define HFSM_IF_STATISTICS(...)									  __VA_ARGS__
+
+	#define HFSM_RECORD_STATE_ACTIVITY(RECORD)									\
+		if (auto* const statistics = control.statistics())						\
+			statistics->RECORD(STATE_ID)
+#else
+	#define HFSM_IF_STATISTICS(...)
+	#define HFSM_RECORD_STATE_ACTIVITY(RECORD)
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_TIMERS
+	#define HFSM_IF_TIMERS(...)										  __VA_ARGS__
+#else
+	#define HFSM_IF_TIMERS(...)
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_UPDATE_PERIODS
+	#define HFSM_IF_UPDATE_PERIODS(...)								  __VA_ARGS__
+#else
+	#define HFSM_IF_UPDATE_PERIODS(...)
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_PAYLOADS
+	#define HFSM_IF_PAYLOADS(...)									  __VA_ARGS__
+#else
+	#define HFSM_IF_PAYLOADS(...)
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_STATIC_PLANS
+	#define HFSM_IF_STATIC_PLANS(...)								  __VA_ARGS__
+#else
+	#define HFSM_IF_STATIC_PLANS(...)
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_PLAN_QUOTAS
+	#define HFSM_IF_PLAN_QUOTAS(...)								  __VA_ARGS__
+#else
+	#define HFSM_IF_PLAN_QUOTAS(...)
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_POOL_INDEX
+	#define HFSM_IF_POOL_INDEX(...)									  __VA_ARGS__
+#else
+	#define HFSM_IF_POOL_INDEX(...)
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_WATCHDOG
+	#define HFSM_IF_WATCHDOG(...)									  __VA_ARGS__
+#else
+	#define HFSM_IF_WATCHDOG(...)
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_PARALLEL
+	#define HFSM_IF_PARALLEL(...)									  __VA_ARGS__
+#else
+	#define HFSM_IF_PARALLEL(...)
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_COROUTINES
+	#define HFSM_IF_COROUTINES(...)									  __VA_ARGS__
+#else
+	#define HFSM_IF_COROUTINES(...)
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
 #ifdef HFSM_ENABLE_SERIALIZATION
 	#define HFSM_IF_SERIALIZATION(...)								  __VA_ARGS__
 #else
@@ -287,6 +401,18 @@ TO convert(const TI& in) {
 	return out;
 }
 
+//------------------------------------------------------------------------------
+
+// Unique address per type, stands in for RTTI
+
+template <typename T>
+struct TypeTagT {
+	static const char TAG;
+};
+
+template <typename T>
+const char TypeTagT<T>::TAG = 0;
+
 ////////////////////////////////////////////////////////////////////////////////
 
 template <int>
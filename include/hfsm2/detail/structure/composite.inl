@@ -151,6 +151,8 @@ C_<TN, TA, SG, TH, TS...>::deepReenter(PlanControl& control) {
 template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
 Status
 C_<TN, TA, SG, TH, TS...>::deepUpdate(FullControl& control) {
+	HFSM_IF_UPDATE_PERIODS(if (!control._planData.updatePeriods.isDue(REGION_ID)) return Status{});
+
 	const ShortIndex active = compoActive(control);
 	HFSM_ASSERT(active != INVALID_SHORT_INDEX);
 
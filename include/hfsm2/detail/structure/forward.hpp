@@ -24,7 +24,7 @@ struct CSI_<TInitial>;
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename, typename...>
+template <Execution, typename, typename...>
 struct OI_;
 
 template <typename...>
@@ -51,9 +51,9 @@ struct WrapInfoT<	 CI_<SG, TH, TS...>> {
 	using Type =	 CI_<SG, TH, TS...>;
 };
 
-template <typename... TS>
-struct WrapInfoT<	 OI_<TS...>> {
-	using Type =	 OI_<TS...>;
+template <Execution EX, typename TH, typename... TS>
+struct WrapInfoT<	 OI_<EX, TH, TS...>> {
+	using Type =	 OI_<EX, TH, TS...>;
 };
 
 template <typename... TS>
@@ -182,8 +182,10 @@ struct OSI_<TInitial> {
 	static constexpr LongIndex  RESUMABLE_BITS	= Initial::RESUMABLE_BITS;
 };
 
-template <typename THead, typename... TSubStates>
+template <Execution TExecution, typename THead, typename... TSubStates>
 struct OI_ final {
+	static constexpr Execution EXECUTION = TExecution;
+
 	using Head				= THead;
 	using HeadInfo			= SI_<Head>;
 	using SubStates			= OSI_<TSubStates...>;
@@ -243,6 +245,10 @@ struct ArgsT final {
 #endif
 
 	HFSM_IF_STRUCTURE(using StructureStateInfos = Array<StructureStateInfo, STATE_COUNT>);
+
+	HFSM_IF_PROFILER(using Profiler = ProfilerT<STATE_COUNT>);
+	HFSM_IF_STATISTICS(using Statistics = StatisticsT<STATE_COUNT>);
+	HFSM_IF_TIMERS(using Timers = TimerWheelT<STATE_COUNT>);
 };
 
 //------------------------------------------------------------------------------
@@ -269,7 +275,7 @@ struct C_;
 template <typename, typename, Strategy, ShortIndex, typename...>
 struct CS_;
 
-template <typename, typename, typename, typename...>
+template <typename, typename, Execution, typename, typename...>
 struct O_;
 
 template <typename, typename, ShortIndex, typename...>
@@ -278,6 +284,9 @@ struct OS_;
 template <typename, typename>
 class RW_;
 
+template <typename, LongIndex, ShortIndex, ShortIndex, ShortIndex>
+struct RuntimeF_;
+
 //------------------------------------------------------------------------------
 
 template <typename, typename...>
@@ -298,14 +307,14 @@ struct MaterialT   <TN, TA, CI_<SG, TH,	TS...>> {
 	using Type = C_<TN, TA,     SG, TH,	TS...>;
 };
 
-template <typename TN, typename TA,				 typename... TS>
-struct MaterialT   <TN, TA, OI_<void,			  TS...>> {
-	using Type = O_<TN, TA,     StaticEmptyT<TA>, TS...>;
+template <typename TN, typename TA, Execution EX,				 typename... TS>
+struct MaterialT   <TN, TA, OI_<EX, void,		  TS...>> {
+	using Type = O_<TN, TA,     EX, StaticEmptyT<TA>, TS...>;
 };
 
-template <typename TN, typename TA, typename TH, typename... TS>
-struct MaterialT   <TN, TA, OI_<TH,				  TS...>> {
-	using Type = O_<TN, TA,     TH,				  TS...>;
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+struct MaterialT   <TN, TA, OI_<EX, TH,			  TS...>> {
+	using Type = O_<TN, TA,     EX, TH,				  TS...>;
 };
 
 template <typename TN, typename... TS>
@@ -420,9 +429,9 @@ struct InfoT<C_<TN, TA, SG, TH, TS...>> {
 	using Type = CI_<	SG, TH, TS...>;
 };
 
-template <typename TN, typename TA, typename TH, typename... TS>
-struct InfoT<O_<TN, TA, TH, TS...>> {
-	using Type = OI_<	TH, TS...>;
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+struct InfoT<O_<TN, TA, EX, TH, TS...>> {
+	using Type = OI_<	EX, TH, TS...>;
 };
 
 template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
@@ -48,6 +48,34 @@ public:
 	static constexpr RegionID regionId()	{ return (RegionID) RegionList::template index<T>();	}
 };
 
+//------------------------------------------------------------------------------
+// Compile-time check for injections overriding preUpdate()
+//  The default preUpdate() is declared in InjectionT<>,
+//  injections with an overloaded preUpdate() are assumed to override it
+
+template <typename T>
+struct IsInjectionT : std::false_type {};
+
+template <typename TArgs>
+struct IsInjectionT<InjectionT<TArgs>> : std::true_type {};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TContext, typename TInjection>
+struct HasPreUpdateT {
+	template <typename U>
+	static U* declaredIn(void (U::*)(TContext&));
+
+	template <typename U>
+	static constexpr bool test(decltype(declaredIn(&U::preUpdate)))
+	{ return !IsInjectionT<typename std::remove_pointer<decltype(declaredIn(&U::preUpdate))>::type>::value; }
+
+	template <typename>
+	static constexpr bool test(...)								{ return true;							}
+
+	static constexpr bool VALUE = test<TInjection>(nullptr);
+};
+
 //------------------------------------------------------------------------------
 
 template <typename...>
@@ -75,6 +103,9 @@ struct B_<TFirst, TRest...>
 	using TFirst::stateId;
 	using TFirst::regionId;
 
+	// Any of the injections does per-tick work in preUpdate()
+	static constexpr bool HAS_PRE_UPDATE = HasPreUpdateT<Context, TFirst>::VALUE || B_<TRest...>::HAS_PRE_UPDATE;
+
 	HFSM_INLINE void widePreEntryGuard(Context& context);
 
 	HFSM_INLINE void widePreEnter	  (Context& context);
@@ -112,6 +143,8 @@ struct B_<TFirst>
 	using TFirst::stateId;
 	using TFirst::regionId;
 
+	static constexpr bool HAS_PRE_UPDATE = HasPreUpdateT<Context, TFirst>::VALUE;
+
 	HFSM_INLINE Rank	rank			 (const Control&)			{ return Rank	   {0};	}
 
 	HFSM_INLINE Utility utility			 (const Control&)			{ return Utility{1.0f};	}
@@ -181,6 +214,53 @@ struct SB_
 template <typename TArgs>
 using StaticEmptyT = SB_<InjectionT<TArgs>>;
 
+//------------------------------------------------------------------------------
+// Compile-time check for states overriding update(), or injecting preUpdate()
+//  The default update() is declared in the single-injection B_<>,
+//  states with an ambiguous or overloaded update() are assumed to override it
+
+template <typename T>
+struct IsDefaultUpdateT : std::false_type {};
+
+template <typename TI>
+struct IsDefaultUpdateT<B_<TI>> : std::true_type {};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TFullControl, typename T>
+struct HasUpdateT {
+	template <typename U>
+	static U* declaredIn(void (U::*)(TFullControl&));
+
+	template <typename U>
+	static constexpr bool test(decltype(declaredIn(&U::update)))
+	{ return !IsDefaultUpdateT<typename std::remove_pointer<decltype(declaredIn(&U::update))>::type>::value; }
+
+	template <typename>
+	static constexpr bool test(...)								{ return true;							}
+
+	static constexpr bool VALUE = test<T>(nullptr) || T::HAS_PRE_UPDATE;
+};
+
+// headless regions
+template <typename TFullControl>
+struct HasUpdateT<TFullControl, void> {
+	static constexpr bool VALUE = false;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TFullControl, typename TStateList>
+struct UpdateMaskT;
+
+template <typename TFullControl, typename... TS>
+struct UpdateMaskT<TFullControl, ITL_<TS...>> {
+	static constexpr bool HAS_UPDATE[sizeof...(TS)] = { HasUpdateT<TFullControl, TS>::VALUE... };
+};
+
+template <typename TFullControl, typename... TS>
+constexpr bool UpdateMaskT<TFullControl, ITL_<TS...>>::HAS_UPDATE[sizeof...(TS)];
+
 ////////////////////////////////////////////////////////////////////////////////
 
 }
@@ -5,6 +5,7 @@ namespace detail {
 
 template <typename TIndices,
 		  typename TArgs,
+		  Execution TExecution,
 		  typename THead,
 		  typename... TSubStates>
 struct O_ final {
@@ -26,7 +27,7 @@ struct O_ final {
 
 	using Head			= THead;
 
-	using Info			= OI_<Head, TSubStates...>;
+	using Info			= OI_<TExecution, Head, TSubStates...>;
 	static constexpr ShortIndex WIDTH		= Info::WIDTH;
 	static constexpr ShortIndex REGION_SIZE	= Info::STATE_COUNT;
 	static constexpr ShortIndex ORTHO_UNITS	= Info::ORTHO_UNITS;
@@ -166,6 +167,41 @@ struct O_ final {
 
 	//----------------------------------------------------------------------
 
+	// Sub-states in sequence, or forked for Execution::Parallel
+	HFSM_INLINE Status	subUpdate			 (FullControl&	control);
+
+	template <typename TEvent>
+	HFSM_INLINE Status	subReact			 (FullControl&	control, const TEvent& event);
+
+#ifdef HFSM_ENABLE_PARALLEL
+	using Requests		= typename FullControl::Requests;
+	using ProngTasks	= typename FullControl::ProngTasks;
+
+	template <typename TEvent>
+	struct ForkT {
+		O_& region;
+		FullControl& control;
+		const TEvent* const event;
+
+		Requests requests[WIDTH];
+		ProngTasks tasks[WIDTH];
+		Status statuses[WIDTH];
+	};
+
+	template <typename TEvent>
+	Status fork(FullControl& control, const TEvent* const event);
+
+	template <typename TEvent>
+	static void runProng(void* const argument, const LongIndex prong);
+
+	HFSM_INLINE Status	prongStatus			 (FullControl&	control, const void*   /*update*/,	const ShortIndex prong);
+
+	template <typename TEvent>
+	HFSM_INLINE Status	prongStatus			 (FullControl&	control, const TEvent* const event,	const ShortIndex prong);
+#endif
+
+	//----------------------------------------------------------------------
+
 	HeadState _headState;
 	SubStates _subStates;
 };
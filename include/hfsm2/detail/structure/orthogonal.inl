@@ -3,9 +3,9 @@ namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepRegister(Registry& registry,
+O_<TN, TA, EX, TH, TS...>::deepRegister(Registry& registry,
 										const Parent parent)
 {
 	registry.orthoParents[ORTHO_INDEX] = parent;
@@ -17,9 +17,9 @@ O_<TN, TA, TH, TS...>::deepRegister(Registry& registry,
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 bool
-O_<TN, TA, TH, TS...>::deepForwardEntryGuard(GuardControl& control) {
+O_<TN, TA, EX, TH, TS...>::deepForwardEntryGuard(GuardControl& control) {
 	const ProngConstBits requested = orthoRequested(static_cast<const GuardControl&>(control));
 
 	ScopedRegion region{control, REGION_ID, HEAD_ID, REGION_SIZE};
@@ -32,9 +32,9 @@ O_<TN, TA, TH, TS...>::deepForwardEntryGuard(GuardControl& control) {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 bool
-O_<TN, TA, TH, TS...>::deepEntryGuard(GuardControl& control) {
+O_<TN, TA, EX, TH, TS...>::deepEntryGuard(GuardControl& control) {
 	ScopedRegion region{control, REGION_ID, HEAD_ID, REGION_SIZE};
 
 	return _headState.deepEntryGuard(control) ||
@@ -43,9 +43,9 @@ O_<TN, TA, TH, TS...>::deepEntryGuard(GuardControl& control) {
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepConstruct(PlanControl& control) {
+O_<TN, TA, EX, TH, TS...>::deepConstruct(PlanControl& control) {
 	ProngBits requested = orthoRequested(control);
 	requested.clear();
 
@@ -55,9 +55,9 @@ O_<TN, TA, TH, TS...>::deepConstruct(PlanControl& control) {
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepEnter(PlanControl& control) {
+O_<TN, TA, EX, TH, TS...>::deepEnter(PlanControl& control) {
 	ScopedRegion region{control, REGION_ID, HEAD_ID, REGION_SIZE};
 
 	_headState.deepEnter(control);
@@ -66,9 +66,9 @@ O_<TN, TA, TH, TS...>::deepEnter(PlanControl& control) {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepReenter(PlanControl& control) {
+O_<TN, TA, EX, TH, TS...>::deepReenter(PlanControl& control) {
 	ProngBits requested = orthoRequested(control);
 	requested.clear();
 
@@ -80,18 +80,20 @@ O_<TN, TA, TH, TS...>::deepReenter(PlanControl& control) {
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 Status
-O_<TN, TA, TH, TS...>::deepUpdate(FullControl& control) {
+O_<TN, TA, EX, TH, TS...>::deepUpdate(FullControl& control) {
+	HFSM_IF_UPDATE_PERIODS(if (!control._planData.updatePeriods.isDue(REGION_ID)) return Status{});
+
 	ScopedRegion outer{control, REGION_ID, HEAD_ID, REGION_SIZE};
 
 	if (const auto headStatus = _headState.deepUpdate(control)) {
 		ControlLock lock{control};
-		_subStates.wideUpdate(control);
+		subUpdate(control);
 
 		return headStatus;
 	} else {
-		const Status subStatus = _subStates.wideUpdate(control);
+		const Status subStatus = subUpdate(control);
 
 		if (subStatus.outerTransition)
 			return subStatus;
@@ -105,21 +107,21 @@ O_<TN, TA, TH, TS...>::deepUpdate(FullControl& control) {
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 template <typename TEvent>
 Status
-O_<TN, TA, TH, TS...>::deepReact(FullControl& control,
-								 const TEvent& event)
+O_<TN, TA, EX, TH, TS...>::deepReact(FullControl& control,
+									 const TEvent& event)
 {
 	ScopedRegion outer{control, REGION_ID, HEAD_ID, REGION_SIZE};
 
 	if (const auto headStatus = _headState.deepReact(control, event)) {
 		ControlLock lock{control};
-		_subStates.wideReact(control, event);
+		subReact(control, event);
 
 		return headStatus;
 	} else {
-		const Status subStatus = _subStates.wideReact(control, event);
+		const Status subStatus = subReact(control, event);
 
 		if (subStatus.outerTransition)
 			return subStatus;
@@ -133,9 +135,9 @@ O_<TN, TA, TH, TS...>::deepReact(FullControl& control,
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 bool
-O_<TN, TA, TH, TS...>::deepForwardExitGuard(GuardControl& control) {
+O_<TN, TA, EX, TH, TS...>::deepForwardExitGuard(GuardControl& control) {
 	const ProngConstBits requested = orthoRequested(static_cast<const GuardControl&>(control));
 
 	ScopedRegion region{control, REGION_ID, HEAD_ID, REGION_SIZE};
@@ -148,9 +150,9 @@ O_<TN, TA, TH, TS...>::deepForwardExitGuard(GuardControl& control) {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 bool
-O_<TN, TA, TH, TS...>::deepExitGuard(GuardControl& control) {
+O_<TN, TA, EX, TH, TS...>::deepExitGuard(GuardControl& control) {
 	ScopedRegion region{control, REGION_ID, HEAD_ID, REGION_SIZE};
 
 	return _headState.deepExitGuard(control) ||
@@ -159,28 +161,28 @@ O_<TN, TA, TH, TS...>::deepExitGuard(GuardControl& control) {
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepExit(PlanControl& control) {
+O_<TN, TA, EX, TH, TS...>::deepExit(PlanControl& control) {
 	_subStates.wideExit(control);
 	_headState.deepExit(control);
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepDestruct(PlanControl& control) {
+O_<TN, TA, EX, TH, TS...>::deepDestruct(PlanControl& control) {
 	_subStates.wideDestruct(control);
 	_headState.deepDestruct(control);
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepForwardActive(Control& control,
-										 const Request::Type request)
+O_<TN, TA, EX, TH, TS...>::deepForwardActive(Control& control,
+											 const Request::Type request)
 {
 	HFSM_ASSERT(control._registry.isActive(HEAD_ID));
 
@@ -192,10 +194,10 @@ O_<TN, TA, TH, TS...>::deepForwardActive(Control& control,
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepForwardRequest(Control& control,
-										  const Request::Type request)
+O_<TN, TA, EX, TH, TS...>::deepForwardRequest(Control& control,
+											  const Request::Type request)
 {
 	const ProngConstBits requested = orthoRequested(static_cast<const Control&>(control));
 
@@ -207,10 +209,10 @@ O_<TN, TA, TH, TS...>::deepForwardRequest(Control& control,
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepRequest(Control& control,
-								   const Request::Type request)
+O_<TN, TA, EX, TH, TS...>::deepRequest(Control& control,
+									   const Request::Type request)
 {
 	switch (request) {
 	case Request::REMAIN:
@@ -244,57 +246,57 @@ O_<TN, TA, TH, TS...>::deepRequest(Control& control,
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepRequestChange(Control& control) {
+O_<TN, TA, EX, TH, TS...>::deepRequestChange(Control& control) {
 	_subStates.wideRequestChange(control);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepRequestRemain(Registry& registry) {
+O_<TN, TA, EX, TH, TS...>::deepRequestRemain(Registry& registry) {
 	_subStates.wideRequestRemain(registry);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepRequestRestart(Registry& registry) {
+O_<TN, TA, EX, TH, TS...>::deepRequestRestart(Registry& registry) {
 	_subStates.wideRequestRestart(registry);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepRequestResume(Registry& registry) {
+O_<TN, TA, EX, TH, TS...>::deepRequestResume(Registry& registry) {
 	_subStates.wideRequestResume(registry);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepRequestUtilize(Control& control) {
+O_<TN, TA, EX, TH, TS...>::deepRequestUtilize(Control& control) {
 	_subStates.wideRequestUtilize(control);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepRequestRandomize(Control& control) {
+O_<TN, TA, EX, TH, TS...>::deepRequestRandomize(Control& control) {
 	_subStates.wideRequestRandomize(control);
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 typename TA::UP
-O_<TN, TA, TH, TS...>::deepReportChange(Control& control) {
+O_<TN, TA, EX, TH, TS...>::deepReportChange(Control& control) {
 	const UP	  h = _headState.deepReportChange(control);
 	const Utility s = _subStates.wideReportChange(control);
 
@@ -310,9 +312,9 @@ O_<TN, TA, TH, TS...>::deepReportChange(Control& control) {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 typename TA::UP
-O_<TN, TA, TH, TS...>::deepReportUtilize(Control& control) {
+O_<TN, TA, EX, TH, TS...>::deepReportUtilize(Control& control) {
 	const UP	  h = _headState.deepReportUtilize(control);
 	const Utility s = _subStates.wideReportUtilize(control);
 
@@ -328,17 +330,17 @@ O_<TN, TA, TH, TS...>::deepReportUtilize(Control& control) {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 typename TA::Rank
-O_<TN, TA, TH, TS...>::deepReportRank(Control& control) {
+O_<TN, TA, EX, TH, TS...>::deepReportRank(Control& control) {
 	return _headState.wrapRank(control);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 typename TA::Utility
-O_<TN, TA, TH, TS...>::deepReportRandomize(Control& control) {
+O_<TN, TA, EX, TH, TS...>::deepReportRandomize(Control& control) {
 	const Utility h = _headState.wrapUtility(control);
 	const Utility s = _subStates.wideReportRandomize(control);
 
@@ -351,9 +353,9 @@ O_<TN, TA, TH, TS...>::deepReportRandomize(Control& control) {
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepChangeToRequested(PlanControl& control) {
+O_<TN, TA, EX, TH, TS...>::deepChangeToRequested(PlanControl& control) {
 	_subStates.wideChangeToRequested(control);
 }
 
@@ -361,12 +363,12 @@ O_<TN, TA, TH, TS...>::deepChangeToRequested(PlanControl& control) {
 
 #ifdef HFSM_ENABLE_STRUCTURE_REPORT
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepGetNames(const LongIndex parent,
-									const RegionType region,
-									const ShortIndex depth,
-									StructureStateInfos& stateInfos) const
+O_<TN, TA, EX, TH, TS...>::deepGetNames(const LongIndex parent,
+										const RegionType region,
+										const ShortIndex depth,
+										StructureStateInfos& stateInfos) const
 {
 	_headState.deepGetNames(parent, region,			depth,	   stateInfos);
 	_subStates.wideGetNames(stateInfos.count() - 1, depth + 1, stateInfos);
@@ -378,46 +380,164 @@ O_<TN, TA, TH, TS...>::deepGetNames(const LongIndex parent,
 
 #ifdef HFSM_ENABLE_SERIALIZATION
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepSaveActive(const Registry& registry,
-									  WriteStream& stream) const
+O_<TN, TA, EX, TH, TS...>::deepSaveActive(const Registry& registry,
+										  WriteStream& stream) const
 {
 	_subStates.wideSaveActive(registry, stream);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepSaveResumable(const Registry& registry,
-										 WriteStream& stream) const
+O_<TN, TA, EX, TH, TS...>::deepSaveResumable(const Registry& registry,
+											 WriteStream& stream) const
 {
 	_subStates.wideSaveResumable(registry, stream);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepLoadRequested(Registry& registry,
-										 ReadStream& stream) const
+O_<TN, TA, EX, TH, TS...>::deepLoadRequested(Registry& registry,
+											 ReadStream& stream) const
 {
 	_subStates.wideLoadRequested(registry, stream);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 void
-O_<TN, TA, TH, TS...>::deepLoadResumable(Registry& registry,
-										 ReadStream& stream) const
+O_<TN, TA, EX, TH, TS...>::deepLoadResumable(Registry& registry,
+											 ReadStream& stream) const
 {
 	_subStates.wideLoadResumable(registry, stream);
 }
 
 #endif
 
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+Status
+O_<TN, TA, EX, TH, TS...>::subUpdate(FullControl& control) {
+#ifdef HFSM_ENABLE_PARALLEL
+	// nested parallel regions run in sequence within their sub-state
+	if (EX == Execution::Parallel && !control._prongTasks)
+		return fork(control, (const void*) nullptr);
+#endif
+
+	return _subStates.wideUpdate(control);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+template <typename TEvent>
+Status
+O_<TN, TA, EX, TH, TS...>::subReact(FullControl& control,
+									const TEvent& event)
+{
+#ifdef HFSM_ENABLE_PARALLEL
+	if (EX == Execution::Parallel && !control._prongTasks)
+		return fork(control, &event);
+#endif
+
+	return _subStates.wideReact(control, event);
+}
+
+//------------------------------------------------------------------------------
+
+#ifdef HFSM_ENABLE_PARALLEL
+
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+template <typename TEvent>
+Status
+O_<TN, TA, EX, TH, TS...>::fork(FullControl& control,
+								const TEvent* const event)
+{
+	ForkT<TEvent> fork{*this, control, event};
+
+	HFSM_IF_ASSERT(control._planData.forked = true);
+
+	if (ExecutorInterface* const executor = control._planData.executor)
+		executor->execute(&runProng<TEvent>, &fork, WIDTH);
+	else
+		for (LongIndex prong = 0; prong < WIDTH; ++prong)
+			runProng<TEvent>(&fork, prong);
+
+	HFSM_IF_ASSERT(control._planData.forked = false);
+
+	Status status;
+
+	for (ShortIndex prong = 0; prong < WIDTH; ++prong) {
+		for (const auto& request : fork.requests[prong])
+			control._requests.append(request);
+
+		const ProngTasks& tasks = fork.tasks[prong];
+
+		for (StateID stateId = HEAD_ID; stateId < HEAD_ID + REGION_SIZE; ++stateId) {
+			if (tasks.successes.get(stateId))
+				control.setSucceeded(stateId);
+
+			if (tasks.failures .get(stateId))
+				control.setFailed	(stateId);
+		}
+
+		status = combine(status, fork.statuses[prong]);
+	}
+
+	return status;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+template <typename TEvent>
+void
+O_<TN, TA, EX, TH, TS...>::runProng(void* const argument,
+									const LongIndex prong)
+{
+	HFSM_ASSERT(prong < WIDTH);
+
+	ForkT<TEvent>& fork = *static_cast<ForkT<TEvent>*>(argument);
+
+	FullControl control{fork.control,
+						fork.requests[prong],
+						fork.tasks[prong]};
+
+	fork.statuses[prong] = fork.region.prongStatus(control, fork.event, (ShortIndex) prong);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+Status
+O_<TN, TA, EX, TH, TS...>::prongStatus(FullControl& control,
+									   const void* /*update*/,
+									   const ShortIndex prong)
+{
+	return _subStates.wideUpdate(control, prong);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+template <typename TEvent>
+Status
+O_<TN, TA, EX, TH, TS...>::prongStatus(FullControl& control,
+									   const TEvent* const event,
+									   const ShortIndex prong)
+{
+	return _subStates.wideReact(control, *event, prong);
+}
+
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 
 }
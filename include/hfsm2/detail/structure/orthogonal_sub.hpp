@@ -88,6 +88,13 @@ struct OS_<TIndices, TArgs, NIndex, TInitial, TRemaining...> final {
 	template <typename TEvent>
 	HFSM_INLINE Status	wideReact			 (FullControl&	control, const TEvent& event);
 
+#ifdef HFSM_ENABLE_PARALLEL
+	HFSM_INLINE Status	wideUpdate			 (FullControl&	control,							const ShortIndex prong);
+
+	template <typename TEvent>
+	HFSM_INLINE Status	wideReact			 (FullControl&	control, const TEvent& event,		const ShortIndex prong);
+#endif
+
 	HFSM_INLINE bool	wideForwardExitGuard (GuardControl&	control,							const ProngConstBits prongs);
 	HFSM_INLINE bool	wideForwardExitGuard (GuardControl&	control);
 	HFSM_INLINE bool	wideExitGuard		 (GuardControl&	control);
@@ -219,6 +226,13 @@ struct OS_<TIndices, TArgs, NIndex, TInitial> final {
 	template <typename TEvent>
 	HFSM_INLINE Status	wideReact			 (FullControl&	control, const TEvent& event);
 
+#ifdef HFSM_ENABLE_PARALLEL
+	HFSM_INLINE Status	wideUpdate			 (FullControl&	control,							const ShortIndex prong);
+
+	template <typename TEvent>
+	HFSM_INLINE Status	wideReact			 (FullControl&	control, const TEvent& event,		const ShortIndex prong);
+#endif
+
 	HFSM_INLINE bool	wideForwardExitGuard (GuardControl&	control,							const ProngConstBits prongs);
 	HFSM_INLINE bool	wideForwardExitGuard (GuardControl&	control);
 	HFSM_INLINE bool	wideExitGuard		 (GuardControl&	control);
@@ -125,6 +125,36 @@ OS_<TN, TA, NI, TI, TR...>::wideReact(FullControl& control,
 
 //------------------------------------------------------------------------------
 
+#ifdef HFSM_ENABLE_PARALLEL
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+Status
+OS_<TN, TA, NI, TI, TR...>::wideUpdate(FullControl& control,
+									   const ShortIndex prong)
+{
+	return prong == PRONG_INDEX ?
+		initial	 .deepUpdate(control) :
+		remaining.wideUpdate(control, prong);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+template <typename TEvent>
+Status
+OS_<TN, TA, NI, TI, TR...>::wideReact(FullControl& control,
+									  const TEvent& event,
+									  const ShortIndex prong)
+{
+	return prong == PRONG_INDEX ?
+		initial	 .deepReact(control, event) :
+		remaining.wideReact(control, event, prong);
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+
 template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
 bool
 OS_<TN, TA, NI, TI, TR...>::wideForwardExitGuard(GuardControl& control,
@@ -83,6 +83,36 @@ OS_<TN, TA, NI, TI>::wideReact(FullControl& control,
 
 //------------------------------------------------------------------------------
 
+#ifdef HFSM_ENABLE_PARALLEL
+
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+Status
+OS_<TN, TA, NI, TI>::wideUpdate(FullControl& control,
+								const ShortIndex HFSM_IF_ASSERT(prong))
+{
+	HFSM_ASSERT(prong == PRONG_INDEX);
+
+	return initial.deepUpdate(control);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+template <typename TEvent>
+Status
+OS_<TN, TA, NI, TI>::wideReact(FullControl& control,
+							   const TEvent& event,
+							   const ShortIndex HFSM_IF_ASSERT(prong))
+{
+	HFSM_ASSERT(prong == PRONG_INDEX);
+
+	return initial.deepReact(control, event);
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+
 template <typename TN, typename TA, ShortIndex NI, typename TI>
 bool
 OS_<TN, TA, NI, TI>::wideForwardExitGuard(GuardControl& control,
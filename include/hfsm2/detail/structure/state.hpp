@@ -28,6 +28,11 @@ struct S_ final {
 	using Head			= THead;
 	using HeadBox		= Boxify<Head, TArgs>;
 
+#ifdef HFSM_ENABLE_PROFILER
+	using ScopedProfiler = ProfilerScope<typename TArgs::Profiler,
+										 !std::is_same<Head, StaticEmptyT<TArgs>>::value>;
+#endif
+
 	//----------------------------------------------------------------------
 
 #ifdef HFSM_EXPLICIT_MEMBER_SPECIALIZATION
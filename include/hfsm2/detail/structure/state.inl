@@ -52,6 +52,7 @@ S_<TN_, TA, TH>::deepEntryGuard(GuardControl& control) {
 	HFSM_LOG_STATE_METHOD(&Head::entryGuard,
 						  control.context(),
 						  Method::ENTRY_GUARD);
+	HFSM_PROFILE_STATE_METHOD(Method::ENTRY_GUARD);
 
 	ScopedOrigin origin{control, STATE_ID};
 
@@ -66,13 +67,16 @@ S_<TN_, TA, TH>::deepEntryGuard(GuardControl& control) {
 
 template <typename TN_, typename TA, typename TH>
 void
-S_<TN_, TA, TH>::deepConstruct(PlanControl& HFSM_IF_LOGGER(control)) {
+S_<TN_, TA, TH>::deepConstruct(PlanControl& control) {
 	HFSM_ASSERT(!control._planData.tasksSuccesses.template get<STATE_ID>());
 	HFSM_ASSERT(!control._planData.tasksFailures .template get<STATE_ID>());
 
 	HFSM_LOG_STATE_METHOD(&Head::enter,
 						  control.context(),
 						  Method::CONSTRUCT);
+	HFSM_PROFILE_STATE_METHOD(Method::CONSTRUCT);
+
+	HFSM_RECORD_STATE_ACTIVITY(recordEnter);
 
 	_headBox.construct();
 }
@@ -85,6 +89,9 @@ S_<TN_, TA, TH>::deepEnter(PlanControl& control) {
 	HFSM_LOG_STATE_METHOD(&Head::enter,
 						  control.context(),
 						  Method::ENTER);
+	HFSM_PROFILE_STATE_METHOD(Method::ENTER);
+	HFSM_IF_STRUCTURE(control._planData.activityChanges.mark(STATE_ID));
+	HFSM_IF_POOL_INDEX(control._planData.indexChanges.mark(STATE_ID));
 
 	ScopedOrigin origin{control, STATE_ID};
 
@@ -103,6 +110,7 @@ S_<TN_, TA, TH>::deepReenter(PlanControl& control) {
 	HFSM_LOG_STATE_METHOD(&Head::reenter,
 						  control.context(),
 						  Method::REENTER);
+	HFSM_PROFILE_STATE_METHOD(Method::REENTER);
 
 	ScopedOrigin origin{control, STATE_ID};
 
@@ -121,12 +129,15 @@ S_<TN_, TA, TH>::deepUpdate(FullControl& control) {
 	HFSM_LOG_STATE_METHOD(&Head::update,
 						  control.context(),
 						  Method::UPDATE);
+	HFSM_PROFILE_STATE_METHOD(Method::UPDATE);
 
 	ScopedOrigin origin{control, STATE_ID};
 
 	_headBox.get().widePreUpdate(control.context());
 	_headBox.get().		  update(control);
 
+	HFSM_IF_COROUTINES(if (control._planData.coroutines.update(STATE_ID)) control.succeed());
+
 	return control._status;
 }
 
@@ -142,12 +153,15 @@ S_<TN_, TA, TH>::deepReact(FullControl& control,
 	HFSM_LOG_STATE_METHOD(reaction,
 						  control.context(),
 						  Method::REACT);
+	HFSM_PROFILE_STATE_METHOD(Method::REACT);
 
 	ScopedOrigin origin{control, STATE_ID};
 
 	_headBox.get().widePreReact(event, control.context());
 	(_headBox.get().*reaction) (event, control);				//_headBox.get().react(event, control);
 
+	HFSM_IF_COROUTINES(if (control._planData.coroutines.react(STATE_ID, event)) control.succeed());
+
 	return control._status;
 }
 
@@ -159,6 +173,7 @@ S_<TN_, TA, TH>::deepExitGuard(GuardControl& control) {
 	HFSM_LOG_STATE_METHOD(&Head::exitGuard,
 						  control.context(),
 						  Method::EXIT_GUARD);
+	HFSM_PROFILE_STATE_METHOD(Method::EXIT_GUARD);
 
 	ScopedOrigin origin{control, STATE_ID};
 
@@ -178,6 +193,9 @@ S_<TN_, TA, TH>::deepExit(PlanControl& control) {
 	HFSM_LOG_STATE_METHOD(&Head::exit,
 						  control.context(),
 						  Method::EXIT);
+	HFSM_PROFILE_STATE_METHOD(Method::EXIT);
+	HFSM_IF_STRUCTURE(control._planData.activityChanges.mark(STATE_ID));
+	HFSM_IF_POOL_INDEX(control._planData.indexChanges.mark(STATE_ID));
 
 	ScopedOrigin origin{control, STATE_ID};
 
@@ -198,6 +216,12 @@ S_<TN_, TA, TH>::deepDestruct(PlanControl& control) {
 	HFSM_LOG_STATE_METHOD(&Head::exit,
 						  control.context(),
 						  Method::DESTRUCT);
+	HFSM_PROFILE_STATE_METHOD(Method::DESTRUCT);
+
+	HFSM_RECORD_STATE_ACTIVITY(recordExit);
+
+	HFSM_IF_TIMERS(control._timers.cancel(STATE_ID));
+	HFSM_IF_COROUTINES(control._planData.coroutines.destroy(STATE_ID));
 
 	_headBox.destruct();
 
@@ -213,6 +237,7 @@ S_<TN_, TA, TH>::wrapPlanSucceeded(FullControl& control) {
 	HFSM_LOG_STATE_METHOD(&Head::planSucceeded,
 						  control.context(),
 						  Method::PLAN_SUCCEEDED);
+	HFSM_PROFILE_STATE_METHOD(Method::PLAN_SUCCEEDED);
 
 	ScopedOrigin origin{control, STATE_ID};
 
@@ -227,6 +252,7 @@ S_<TN_, TA, TH>::wrapPlanFailed(FullControl& control) {
 	HFSM_LOG_STATE_METHOD(&Head::planFailed,
 						  control.context(),
 						  Method::PLAN_FAILED);
+	HFSM_PROFILE_STATE_METHOD(Method::PLAN_FAILED);
 
 	ScopedOrigin origin{control, STATE_ID};
 
@@ -241,6 +267,7 @@ S_<TN_, TA, TH>::wrapRank(Control& control) {
 	HFSM_LOG_STATE_METHOD(&Head::rank,
 						  control.context(),
 						  Method::RANK);
+	HFSM_PROFILE_STATE_METHOD(Method::RANK);
 
 	return _headBox.get().rank(static_cast<const Control&>(control));
 }
@@ -253,6 +280,7 @@ S_<TN_, TA, TH>::wrapUtility(Control& control) {
 	HFSM_LOG_STATE_METHOD(&Head::utility,
 						  control.context(),
 						  Method::UTILITY);
+	HFSM_PROFILE_STATE_METHOD(Method::UTILITY);
 
 	return _headBox.get().utility(static_cast<const Control&>(control));
 }
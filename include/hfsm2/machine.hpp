@@ -36,8 +36,38 @@
 #include <typeindex>
 #include <utility>			// std::conditional<>, move(), forward()
 
-#if defined _DEBUG && _MSC_VER
-	#include <intrin.h>		// __debugbreak()
+#if defined _MSC_VER && (defined _DEBUG || defined HFSM_PROFILER_RDTSC)
+	#include <intrin.h>		// __debugbreak(), __rdtsc()
+#endif
+
+#ifdef HFSM_ENABLE_COROUTINES
+	#ifndef __cpp_impl_coroutine
+		#error "HFSM_ENABLE_COROUTINES requires C++20 coroutine support"
+	#endif
+
+	#include <cstddef>		// max_align_t
+	#include <coroutine>
+	#include <exception>	// terminate()
+#endif
+
+#ifdef HFSM_ENABLE_POOL
+	#include <algorithm>	// sort()
+#endif
+
+#if defined HFSM_ENABLE_PROFILER || defined HFSM_ENABLE_POOL
+	#include <chrono>		// steady_clock
+#endif
+
+#ifdef HFSM_ENABLE_TRANSITION_TRACE
+	#include <atomic>
+#endif
+
+#if defined HFSM_ENABLE_PROFILER || defined HFSM_ENABLE_STATISTICS
+	#include <stdio.h>		// fopen(), fprintf()
+#endif
+
+#if defined HFSM_ENABLE_PROFILER && defined HFSM_PROFILER_RDTSC && !defined _MSC_VER
+	#include <x86intrin.h>	// __rdtsc()
 #endif
 
 #define HFSM_INLINE														  //inline
@@ -161,14 +191,23 @@ struct EmptyPayload {};
 		if (auto* const logger = control.logger())								\
 			logger->recordMethod(CONTEXT, STATE_ID, METHOD_ID)
 
+	#define HFSM_LOG_RUNTIME_METHOD(CALLBACK, STATE_ID, METHOD_ID)				\
+		if (_logger)															\
+			_logger->recordMethod(_context, STATE_ID, METHOD_ID)
+
 #elif defined HFSM_ENABLE_LOG_INTERFACE
 
 	#define HFSM_LOG_STATE_METHOD(METHOD, CONTEXT, METHOD_ID)					\
 		if (auto* const logger = control.logger())								\
 			log<decltype(METHOD)>(*logger, CONTEXT, METHOD_ID)
 
+	#define HFSM_LOG_RUNTIME_METHOD(CALLBACK, STATE_ID, METHOD_ID)				\
+		if (_logger && CALLBACK)												\
+			_logger->recordMethod(_context, STATE_ID, METHOD_ID)
+
 #else
 	#define HFSM_LOG_STATE_METHOD(METHOD, CONTEXT, METHOD_ID)
+	#define HFSM_LOG_RUNTIME_METHOD(CALLBACK, STATE_ID, METHOD_ID)
 #endif
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -189,6 +228,111 @@ struct EmptyPayload {};
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+#ifdef HFSM_ENABLE_TRANSITION_TRACE
+	#define HFSM_IF_TRANSITION_TRACE(...)							  __VA_ARGS__
+#else
+	#define HFSM_IF_TRANSITION_TRACE(...)
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_PROFILER
+	#define HFSM_IF_PROFILER(...)									  __VA_ARGS__
+
+	#define HFSM_PROFILE_STATE_METHOD(METHOD_ID)								\
+		ScopedProfiler scopedProfiler{control.profiler(), STATE_ID, METHOD_ID}
+#else
+	#define HFSM_IF_PROFILER(...)
+	#define HFSM_PROFILE_STATE_METHOD(METHOD_ID)
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_STATISTICS
+	#define HFSM_IF_STATISTICS(...)									  __VA_ARGS__
+
+	#define HFSM_RECORD_STATE_ACTIVITY(RECORD)									\
+		if (auto* const statistics = control.statistics())						\
+			statistics->RECORD(STATE_ID)
+#else
+	#define HFSM_IF_STATISTICS(...)
+	#define HFSM_RECORD_STATE_ACTIVITY(RECORD)
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_TIMERS
+	#define HFSM_IF_TIMERS(...)										  __VA_ARGS__
+#else
+	#define HFSM_IF_TIMERS(...)
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_UPDATE_PERIODS
+	#define HFSM_IF_UPDATE_PERIODS(...)								  __VA_ARGS__
+#else
+	#define HFSM_IF_UPDATE_PERIODS(...)
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_PAYLOADS
+	#define HFSM_IF_PAYLOADS(...)									  __VA_ARGS__
+#else
+	#define HFSM_IF_PAYLOADS(...)
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_STATIC_PLANS
+	#define HFSM_IF_STATIC_PLANS(...)								  __VA_ARGS__
+#else
+	#define HFSM_IF_STATIC_PLANS(...)
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_PLAN_QUOTAS
+	#define HFSM_IF_PLAN_QUOTAS(...)								  __VA_ARGS__
+#else
+	#define HFSM_IF_PLAN_QUOTAS(...)
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_POOL_INDEX
+	#define HFSM_IF_POOL_INDEX(...)									  __VA_ARGS__
+#else
+	#define HFSM_IF_POOL_INDEX(...)
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_WATCHDOG
+	#define HFSM_IF_WATCHDOG(...)									  __VA_ARGS__
+#else
+	#define HFSM_IF_WATCHDOG(...)
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_PARALLEL
+	#define HFSM_IF_PARALLEL(...)									  __VA_ARGS__
+#else
+	#define HFSM_IF_PARALLEL(...)
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_COROUTINES
+	#define HFSM_IF_COROUTINES(...)									  __VA_ARGS__
+#else
+	#define HFSM_IF_COROUTINES(...)
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
 #ifdef HFSM_ENABLE_SERIALIZATION
 	#define HFSM_IF_SERIALIZATION(...)								  __VA_ARGS__
 #else
@@ -352,6 +496,18 @@ TO convert(const TI& in) {
 	return out;
 }
 
+//------------------------------------------------------------------------------
+
+// Unique address per type, stands in for RTTI
+
+template <typename T>
+struct TypeTagT {
+	static const char TAG;
+};
+
+template <typename T>
+const char TypeTagT<T>::TAG = 0;
+
 ////////////////////////////////////////////////////////////////////////////////
 
 template <int>
@@ -773,6 +929,9 @@ public:
 
 	HFSM_INLINE void clear();
 
+	// Check if any bit is set
+	HFSM_INLINE explicit operator bool() const;
+
 	template <ShortIndex NIndex>
 	HFSM_INLINE bool get() const;
 
@@ -784,7 +943,7 @@ public:
 
 	HFSM_INLINE bool get  (const Index index) const;
 	HFSM_INLINE void set  (const Index index);
-	//HFSM_INLINE void reset(const Index index);
+	HFSM_INLINE void reset(const Index index);
 
 	template <ShortIndex NUnit, ShortIndex NWidth>
 	HFSM_INLINE		 Bits bits();
@@ -1009,6 +1168,17 @@ BitArray<TI, NC>::get() const {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
+template <typename TI, ShortIndex NC>
+BitArray<TI, NC>::operator bool() const {
+	for (const Unit& unit: _storage)
+		if (unit)
+			return true;
+
+	return false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
 template <typename TI, ShortIndex NC>
 template <ShortIndex NIndex>
 void
@@ -1069,17 +1239,17 @@ BitArray<TI, NC>::set(const Index index) {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-//template <typename TI, ShortIndex NC>
-//void
-//BitArray<TI, NC>::reset(const Index index) {
-//	HFSM_ASSERT(index < CAPACITY);
-//
-//	const Index unit = index / (sizeof(Unit) * 8);
-//	const Index bit  = index % (sizeof(Unit) * 8);
-//	const Unit mask = 1 << bit;
-//
-//	_storage[unit] &= ~mask;
-//}
+template <typename TI, ShortIndex NC>
+void
+BitArray<TI, NC>::reset(const Index index) {
+	HFSM_ASSERT(index < CAPACITY);
+
+	const Index unit = index / (sizeof(Unit) * 8);
+	const Index bit  = index % (sizeof(Unit) * 8);
+	const Unit mask = 1 << bit;
+
+	_storage[unit] &= ~mask;
+}
 
 //------------------------------------------------------------------------------
 
@@ -2097,6 +2267,250 @@ using SplitR = typename GreaterT<sizeof...(Ts) / 2, 0, Ts...>::Type;
 }
 }
 
+namespace hfsm2 {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// How EventBufferT merges an event with the last queued one, if it's of the same type
+//  None	- every event is queued
+//  Latest	- the new event replaces the queued one
+//  Sum		- the new event is added to the queued one with 'operator +='
+//  Events of other types queued in between aren't merged across,
+//  so transitions they cause see the events on either side of them
+
+enum class Coalesce : uint8_t {
+	None,
+	Latest,
+	Sum,
+};
+
+// Per-event-type policy, specialize to opt in:
+//  template <> struct hfsm2::CoalesceT<Position> { static constexpr Coalesce VALUE = Coalesce::Latest; };
+
+template <typename TEvent>
+struct CoalesceT {
+	static constexpr Coalesce VALUE = Coalesce::None;
+};
+
+//------------------------------------------------------------------------------
+
+// Fixed-capacity queue of events of different types, in arrival order
+//  Every event takes a slot sized for the largest of 'TEvents',
+//  events are copied in and never destroyed, so they must be trivially destructible
+//  Events with a CoalesceT<> policy are merged with the last queued event of the same type
+//  Feed to R_::reactBatch() or flush() to dispatch the whole queue in one go
+
+template <LongIndex NCapacity, typename... TEvents>
+class EventBufferT {
+public:
+	using Index	 = LongIndex;
+	using Events = detail::ITL_<TEvents...>;
+
+	static constexpr Index CAPACITY = NCapacity;
+	static constexpr Index INVALID	= Index (-1);
+
+	static_assert(Events::SIZE <= (ShortIndex) -1, "Too many event types");
+
+private:
+	using Storage = typename std::aligned_union<0, TEvents...>::type;
+
+	struct Slot {
+		Storage storage;
+		ShortIndex type;
+	};
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	template <typename... Ts>
+	struct VisitT;
+
+	template <typename T, typename... Ts>
+	struct VisitT<T, Ts...> {
+		template <typename TVisitor>
+		static HFSM_INLINE void visit(const Slot& slot, TVisitor& visitor);
+	};
+
+	template <typename T>
+	struct VisitT<T> {
+		template <typename TVisitor>
+		static HFSM_INLINE void visit(const Slot& slot, TVisitor& visitor);
+	};
+
+	template <Coalesce NPolicy>
+	using CoalesceTag = std::integral_constant<Coalesce, NPolicy>;
+
+	template <typename TEvent>
+	static HFSM_INLINE void merge(TEvent&, const TEvent&, CoalesceTag<Coalesce::None>)	{}
+
+	template <typename TEvent>
+	static HFSM_INLINE void merge(TEvent& queued, const TEvent& event, CoalesceTag<Coalesce::Latest>);
+
+	template <typename TEvent>
+	static HFSM_INLINE void merge(TEvent& queued, const TEvent& event, CoalesceTag<Coalesce::Sum>);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+public:
+	HFSM_INLINE EventBufferT();
+
+	// Returns false if the buffer is full
+	template <typename TEvent>
+	HFSM_INLINE bool push(const TEvent& event);
+
+	HFSM_INLINE void clear();
+
+	HFSM_INLINE Index count() const								{ return _count;				}
+
+	// Events merged into queued ones since the last clear()
+	HFSM_INLINE Index coalesced() const							{ return _coalesced;			}
+
+	// Call 'visitor(const TEvent&)' for every event, in the order they were pushed
+	template <typename TVisitor>
+	HFSM_INLINE void visit(TVisitor& visitor) const;
+
+	// Dispatch the queue with 'machine.reactBatch()' and clear it
+	template <typename TMachine>
+	HFSM_INLINE void flush(TMachine& machine);
+
+private:
+	Slot _slots[CAPACITY];
+	Index _count = 0;
+	Index _coalesced = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+
+namespace hfsm2 {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <LongIndex NC, typename... TE>
+template <typename T, typename... Ts>
+template <typename TVisitor>
+void
+EventBufferT<NC, TE...>::VisitT<T, Ts...>::visit(const Slot& slot,
+												 TVisitor& visitor)
+{
+	if (slot.type == Events::template index<T>())
+		visitor(*reinterpret_cast<const T*>(&slot.storage));
+	else
+		VisitT<Ts...>::visit(slot, visitor);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NC, typename... TE>
+template <typename T>
+template <typename TVisitor>
+void
+EventBufferT<NC, TE...>::VisitT<T>::visit(const Slot& slot,
+										  TVisitor& visitor)
+{
+	HFSM_ASSERT(slot.type == Events::template index<T>());
+
+	visitor(*reinterpret_cast<const T*>(&slot.storage));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NC, typename... TE>
+template <typename TEvent>
+void
+EventBufferT<NC, TE...>::merge(TEvent& queued,
+							   const TEvent& event,
+							   CoalesceTag<Coalesce::Latest>)
+{
+	new (&queued) TEvent{event};
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NC, typename... TE>
+template <typename TEvent>
+void
+EventBufferT<NC, TE...>::merge(TEvent& queued,
+							   const TEvent& event,
+							   CoalesceTag<Coalesce::Sum>)
+{
+	queued += event;
+}
+
+//------------------------------------------------------------------------------
+
+template <LongIndex NC, typename... TE>
+EventBufferT<NC, TE...>::EventBufferT() {
+	clear();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NC, typename... TE>
+template <typename TEvent>
+bool
+EventBufferT<NC, TE...>::push(const TEvent& event) {
+	static_assert(Events::template contains<TEvent>(), "Event type not in the buffer's list");
+	static_assert(std::is_trivially_destructible<TEvent>::value, "Buffered events are never destroyed");
+
+	constexpr Coalesce POLICY = CoalesceT<TEvent>::VALUE;
+	constexpr ShortIndex TYPE = (ShortIndex) Events::template index<TEvent>();
+
+	if (POLICY != Coalesce::None && _count && _slots[_count - 1].type == TYPE) {
+		merge(*reinterpret_cast<TEvent*>(&_slots[_count - 1].storage),
+			  event,
+			  CoalesceTag<POLICY>{});
+
+		++_coalesced;
+
+		return true;
+	}
+
+	if (_count == CAPACITY)
+		return false;
+
+	Slot& slot = _slots[_count++];
+
+	new (&slot.storage) TEvent{event};
+	slot.type = TYPE;
+
+	return true;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NC, typename... TE>
+void
+EventBufferT<NC, TE...>::clear() {
+	_count = 0;
+	_coalesced = 0;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NC, typename... TE>
+template <typename TVisitor>
+void
+EventBufferT<NC, TE...>::visit(TVisitor& visitor) const {
+	for (Index i = 0; i < _count; ++i)
+		VisitT<TE...>::visit(_slots[i], visitor);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <LongIndex NC, typename... TE>
+template <typename TMachine>
+void
+EventBufferT<NC, TE...>::flush(TMachine& machine) {
+	machine.reactBatch(*this);
+
+	clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -2140,6 +2554,13 @@ enum class StatusEvent : uint8_t {
 	COUNT
 };
 
+enum class WatchdogEvent : uint8_t {
+	SUBSTITUTION_LIMIT,
+	OSCILLATION,
+
+	COUNT
+};
+
 //------------------------------------------------------------------------------
 
 static inline
@@ -2211,6 +2632,21 @@ transitionName(const TransitionType transitionType) {
 	}
 }
 
+//------------------------------------------------------------------------------
+
+static inline
+const char*
+watchdogEventName(const WatchdogEvent event) {
+	switch (event) {
+	case WatchdogEvent::SUBSTITUTION_LIMIT:	return "substitutionLimit";
+	case WatchdogEvent::OSCILLATION:		return "oscillation";
+
+	default:
+		HFSM_BREAK();
+		return nullptr;
+	}
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 }
@@ -2232,6 +2668,7 @@ struct LoggerInterfaceT {
 	using RegionID		 = ::hfsm2::RegionID;
 	using TransitionType = ::hfsm2::TransitionType;
 	using StatusEvent	 = ::hfsm2::StatusEvent;
+	using WatchdogEvent	 = ::hfsm2::WatchdogEvent;
 
 	virtual void recordMethod(Context& /*context*/,
 							  const StateID /*origin*/,
@@ -2270,7 +2707,15 @@ struct LoggerInterfaceT {
 										const StateID /*prong*/,
 										const Utilty /*utilty*/)
 	{}
-};
+
+	// origin, target - the pair of states the machine oscillates between,
+	//					INVALID_STATE_ID for SUBSTITUTION_LIMIT
+	virtual void recordWatchdogEvent(Context& /*context*/,
+									 const WatchdogEvent /*event*/,
+									 const StateID /*origin*/,
+									 const StateID /*target*/)
+	{}
+};
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -2284,698 +2729,830 @@ using LoggerInterfaceT = void;
 
 using LoggerInterface = LoggerInterfaceT<>;
 
-}
+////////////////////////////////////////////////////////////////////////////////
 
-namespace hfsm2 {
-namespace detail {
+// Non-virtual logger policy with the same member functions as LoggerInterfaceT,
+//  select with ConfigT<>::LoggerT<EmptyLoggerT<..>>
+//  Custom policies can follow the same pattern and get their calls inlined
 
-////////////////////////////////////////////////////////////////////////////////
+template <typename TContext = EmptyContext,
+		  typename TUtilty = float>
+struct EmptyLoggerT {
+	using Context		 = TContext;
+	using Utilty		 = TUtilty;
 
-#pragma pack(push, 2)
+	using Method		 = ::hfsm2::Method;
+	using StateID		 = ::hfsm2::StateID;
+	using RegionID		 = ::hfsm2::RegionID;
+	using TransitionType = ::hfsm2::TransitionType;
+	using StatusEvent	 = ::hfsm2::StatusEvent;
+	using WatchdogEvent	 = ::hfsm2::WatchdogEvent;
 
-struct TaskLink {
-	HFSM_INLINE TaskLink(const TransitionType transitionType_,
-						 const StateID origin_,
-						 const StateID destination_)
-		: transitionType{transitionType_}
-		, origin{origin_}
-		, destination{destination_}
-		, next{INVALID_LONG_INDEX}
+	HFSM_INLINE void recordMethod(Context& /*context*/,
+								  const StateID /*origin*/,
+								  const Method /*method*/)
 	{}
 
-	TransitionType transitionType;
-	StateID origin		= INVALID_STATE_ID;
-	StateID destination	= INVALID_STATE_ID;
+	HFSM_INLINE void recordTransition(Context& /*context*/,
+									  const StateID /*origin*/,
+									  const TransitionType /*transitionType*/,
+									  const StateID /*target*/)
+	{}
 
-	LongIndex prev		= INVALID_LONG_INDEX;
-	LongIndex next		= INVALID_LONG_INDEX;
-};
+	HFSM_INLINE void recordTaskStatus(Context& /*context*/,
+									  const RegionID /*region*/,
+									  const StateID /*origin*/,
+									  const StatusEvent /*event*/)
+	{}
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	HFSM_INLINE void recordPlanStatus(Context& /*context*/,
+									  const RegionID /*region*/,
+									  const StatusEvent /*event*/)
+	{}
 
-struct Bounds {
-	LongIndex first		= INVALID_LONG_INDEX;
-	LongIndex last		= INVALID_LONG_INDEX;
-};
+	HFSM_INLINE void recordCancelledPending(Context& /*context*/,
+											const StateID /*origin*/)
+	{}
 
-#pragma pack(pop)
+	HFSM_INLINE void recordUtilityResolution(Context& /*context*/,
+											 const StateID /*head*/,
+											 const StateID /*prong*/,
+											 const Utilty /*utilty*/)
+	{}
 
-//------------------------------------------------------------------------------
+	HFSM_INLINE void recordRandomResolution(Context& /*context*/,
+											const StateID /*head*/,
+											const StateID /*prong*/,
+											const Utilty /*utilty*/)
+	{}
 
-template <typename,
-		  typename,
-		  typename,
-		  typename,
-		  LongIndex,
-		  LongIndex,
-		  LongIndex,
-		  LongIndex,
-		  LongIndex>
-struct ArgsT;
+	HFSM_INLINE void recordWatchdogEvent(Context& /*context*/,
+										 const WatchdogEvent /*event*/,
+										 const StateID /*origin*/,
+										 const StateID /*target*/)
+	{}
+};
 
-template <typename>
-struct PlanDataT;
+using EmptyLogger = EmptyLoggerT<>;
 
-//------------------------------------------------------------------------------
+}
 
-template <typename TContext,
-		  typename TConfig,
-		  typename TStateList,
-		  typename TRegionList,
-		  LongIndex NCompoCount,
-		  LongIndex NOrthoCount,
-		  LongIndex NOrthoUnits,
-		  LongIndex NSerialBits,
-		  LongIndex NTaskCapacity>
-struct PlanDataT<ArgsT<TContext,
-					   TConfig,
-					   TStateList,
-					   TRegionList,
-					   NCompoCount,
-					   NOrthoCount,
-					   NOrthoUnits,
-					   NSerialBits,
-					   NTaskCapacity>>
-{
-	using StateList		= TStateList;
-	using RegionList	= TRegionList;
+#ifdef HFSM_ENABLE_PROFILER
 
-	static constexpr ShortIndex REGION_COUNT  = RegionList::SIZE;
-	static constexpr ShortIndex TASK_CAPACITY = NTaskCapacity;
+namespace hfsm2 {
 
-	using TaskLinks		= List<TaskLink, TASK_CAPACITY>;
-	using TasksBounds	= Array<Bounds, RegionList::SIZE>;
-	using TasksBits		= BitArray<StateID, StateList::SIZE>;
-	using RegionBits	= BitArray<RegionID, RegionList::SIZE>;
+////////////////////////////////////////////////////////////////////////////////
 
-	TaskLinks taskLinks;
-	TasksBounds tasksBounds;
-	TasksBits tasksSuccesses;
-	TasksBits tasksFailures;
-	RegionBits planExists;
+// Timestamp source for the profiler
+//  CPU cycles (rdtsc) with HFSM_PROFILER_RDTSC defined, steady_clock nanoseconds otherwise
 
-#ifdef HFSM_ENABLE_ASSERT
-	void verifyPlans() const;
-	LongIndex verifyPlan(const RegionID stateId) const;
-#endif
+struct ProfilerClock {
+	static HFSM_INLINE uint64_t now();
 };
 
 //------------------------------------------------------------------------------
 
-template <typename TContext,
-		  typename TConfig,
-		  typename TStateList,
-		  typename TRegionList,
-		  LongIndex NOrthoCount,
-		  LongIndex NOrthoUnits,
-		  LongIndex NTaskCapacity>
-struct PlanDataT<ArgsT<TContext,
-					   TConfig,
-					   TStateList,
-					   TRegionList,
-					   0,
-					   NOrthoCount,
-					   NOrthoUnits,
-					   0,
-					   NTaskCapacity>>
-{
-#ifdef HFSM_ENABLE_ASSERT
-	void verifyPlans() const													{}
-	LongIndex verifyPlan(const RegionID) const					{ return 0;		}
-#endif
-};
+// Aggregated timings of a single state method
+//  Members:
+//   count		- Number of calls
+//   total		- Sum of call durations
+//   min, max	- Shortest and longest call durations
+//   histogram	- Bucket 0 counts calls shorter than 1 tick, bucket N - [2^(N-1), 2^N) ticks,
+//				  the last bucket collects everything longer
 
-////////////////////////////////////////////////////////////////////////////////
+struct ProfileEntry {
+	enum : unsigned { BUCKET_COUNT = 32 };
 
-}
-}
+	HFSM_INLINE void add(const uint64_t duration);
 
-namespace hfsm2 {
-namespace detail {
+	HFSM_INLINE uint64_t mean() const							{ return count ? total / count : 0;			}
 
-////////////////////////////////////////////////////////////////////////////////
+	uint64_t count = 0;
+	uint64_t total = 0;
+	uint64_t min = UINT64_MAX;
+	uint64_t max = 0;
+	uint32_t histogram[BUCKET_COUNT] = {};
+};
 
-#ifdef HFSM_ENABLE_ASSERT
+//------------------------------------------------------------------------------
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, LongIndex NSB, LongIndex NTC>
-void
-PlanDataT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, NSB, NTC>>::verifyPlans() const {
-	LongIndex planCount = 0;
-	for (RegionID id = 0; id < REGION_COUNT; ++id)
-		planCount += verifyPlan(id);
+// Single timed call, kept for the Chrome trace export
 
-	HFSM_ASSERT(taskLinks.count() == planCount);
-}
+struct ProfileEvent {
+	uint64_t start;
+	uint32_t duration;
+	StateID stateId;
+	Method method;
+};
 
 //------------------------------------------------------------------------------
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, LongIndex NSB, LongIndex NTC>
-LongIndex
-PlanDataT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, NSB, NTC>>::verifyPlan(const RegionID regionId) const {
-	LongIndex length = 0;
-	const Bounds& bounds = tasksBounds[regionId];
-
-	if (bounds.first != INVALID_LONG_INDEX) {
-		HFSM_ASSERT(bounds.last != INVALID_LONG_INDEX);
+// Per-state, per-method timing profiler
+//  Attach with R_::attachProfiler(), state methods are timed at the same points
+//  they're logged by HFSM_ENABLE_LOG_INTERFACE
 
-		for (auto slow = bounds.first, fast = slow; ; ) {
-			++length;
-			const TaskLink& task = taskLinks[slow];
+template <LongIndex NStateCount>
+class ProfilerT {
+public:
+	static constexpr LongIndex STATE_COUNT  = NStateCount;
+	static constexpr LongIndex METHOD_COUNT = (LongIndex) Method::COUNT;
 
-			if (slow != bounds.last) {
-				HFSM_ASSERT(task.next != INVALID_LONG_INDEX);
-				slow = task.next;
+	HFSM_INLINE void record(const StateID stateId,
+							const Method method,
+							const uint64_t start,
+							const uint64_t end);
 
-				// loop check
-				if (fast != INVALID_LONG_INDEX) {
-					fast = taskLinks[fast].next;
+	HFSM_INLINE const ProfileEntry& entry(const StateID stateId,
+										  const Method method) const;
 
-					if (fast != INVALID_LONG_INDEX) {
-						fast = taskLinks[fast].next;
-					}
+	HFSM_INLINE void clear();
 
-					HFSM_ASSERT(fast == INVALID_LONG_INDEX || slow != fast);
-				}
-			} else {
-				HFSM_ASSERT(task.next == INVALID_LONG_INDEX);
+	// Additionally keep individual calls in a ring buffer over 'events', needed for writeChromeTrace()
+	//  'capacity' must be a power of two
+	HFSM_INLINE void attachEvents(ProfileEvent* const events,
+								  const uint32_t capacity);
 
-				break;
-			}
-		};
-	} else
-		HFSM_ASSERT(bounds.last == INVALID_LONG_INDEX);
+	// Number of events currently held in the ring
+	HFSM_INLINE uint32_t eventCount() const;
 
-	return length;
-}
+	// Write a text table of all called state methods to 'path'
+	//  'names' - optional state names, indexed by StateID
+	bool writeReport(const char* const path,
+					 const char* const* const names = nullptr) const;
 
-#endif
+	// Write held events to 'path' in Chrome trace event format (chrome://tracing, Perfetto)
+	//  'ticksPerMicrosecond' - clock rate, 1000 for the default steady_clock
+	//  Returns false if no events were attached
+	bool writeChromeTrace(const char* const path,
+						  const char* const* const names = nullptr,
+						  const double ticksPerMicrosecond = 1000.0) const;
 
-////////////////////////////////////////////////////////////////////////////////
+private:
+	detail::StaticArray<ProfileEntry, STATE_COUNT * METHOD_COUNT> _entries;
 
-}
-}
-namespace hfsm2 {
-namespace detail {
+	ProfileEvent* _events = nullptr;
+	uint32_t _eventMask = 0;
+	uint32_t _eventHead = 0;
+	bool _eventsWrapped = false;
+};
 
 ////////////////////////////////////////////////////////////////////////////////
 
-#pragma pack(push, 1)
-
-struct Status {
-	enum Result {
-		NONE,
-		SUCCESS,
-		FAILURE
-	};
+namespace detail {
 
-	Result result = NONE;
-	bool outerTransition = false;
+// Times the enclosing scope, does nothing for states without a head
 
-	inline Status(const Result result_ = NONE,
-				  const bool outerTransition_ = false);
+template <typename TProfiler, bool NEnabled>
+struct ProfilerScope {
+	HFSM_INLINE ProfilerScope(TProfiler* const profiler_,
+							  const StateID stateId_,
+							  const Method method_)
+		: profiler{profiler_}
+		, start{profiler_ ? ProfilerClock::now() : 0}
+		, stateId{stateId_}
+		, method{method_}
+	{}
 
-	inline explicit operator bool() const { return result || outerTransition; }
+	HFSM_INLINE ~ProfilerScope() {
+		if (profiler)
+			profiler->record(stateId, method, start, ProfilerClock::now());
+	}
 
-	inline void clear();
+	TProfiler* const profiler;
+	const uint64_t start;
+	const StateID stateId;
+	const Method method;
 };
 
-#pragma pack(pop)
-
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-inline Status
-combine(const Status lhs, const Status rhs) {
-	const Status::Result result = lhs.result > rhs.result ?
-		lhs.result : rhs.result;
+template <typename TProfiler>
+struct ProfilerScope<TProfiler, false> {
+	HFSM_INLINE ProfilerScope(TProfiler* const,
+							  const StateID,
+							  const Method)
+	{}
+};
 
-	return {result, lhs.outerTransition || rhs.outerTransition};
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename TArgs>
-class ConstPlanT {
-	template <typename>
-	friend class ControlT;
+}
 
-	template <typename>
-	friend class PlanControlT;
+namespace hfsm2 {
 
-	template <typename>
-	friend class FullControlT;
+////////////////////////////////////////////////////////////////////////////////
 
-	template <typename>
-	friend class GuardControlT;
+inline
+uint64_t
+ProfilerClock::now() {
+#if defined HFSM_PROFILER_RDTSC
+	return __rdtsc();
+#else
+	return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+						  std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
 
-	using Args			= TArgs;
-	using Context		= typename Args::Context;
-	using StateList		= typename Args::StateList;
-	using RegionList	= typename Args::RegionList;
+////////////////////////////////////////////////////////////////////////////////
 
-	static constexpr LongIndex TASK_CAPACITY = Args::TASK_CAPACITY;
+inline
+void
+ProfileEntry::add(const uint64_t duration) {
+	++count;
+	total += duration;
 
-public:
-	using PlanData		= PlanDataT<Args>;
-	using TaskLinks		= typename PlanData::TaskLinks;
+	if (min > duration)
+		min = duration;
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	if (max < duration)
+		max = duration;
 
-	struct Iterator {
-		HFSM_INLINE Iterator(const ConstPlanT& plan);
+	unsigned bucket = 0;
+	for (uint64_t d = duration; d && bucket < BUCKET_COUNT - 1; d >>= 1)
+		++bucket;
 
-		HFSM_INLINE explicit operator bool() const;
+	++histogram[bucket];
+}
 
-		HFSM_INLINE void operator ++();
+////////////////////////////////////////////////////////////////////////////////
 
-		HFSM_INLINE const TaskLink& operator  *() const { return  _plan._planData.taskLinks[_curr];	}
-		HFSM_INLINE const TaskLink* operator ->() const { return &_plan._planData.taskLinks[_curr];	}
+template <LongIndex NSC>
+void
+ProfilerT<NSC>::record(const StateID stateId,
+					   const Method method,
+					   const uint64_t start,
+					   const uint64_t end)
+{
+	HFSM_ASSERT(stateId < STATE_COUNT);
+	HFSM_ASSERT(method  < Method::COUNT);
 
-		HFSM_INLINE LongIndex next() const;
+	const uint64_t duration = end > start ? end - start : 0;
 
-		const ConstPlanT& _plan;
-		LongIndex _curr;
-		LongIndex _next;
-	};
+	_entries[stateId * METHOD_COUNT + (LongIndex) method].add(duration);
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	if (_events) {
+		ProfileEvent& event = _events[_eventHead & _eventMask];
+		event.start	   = start;
+		event.duration = duration < UINT32_MAX ? (uint32_t) duration : UINT32_MAX;
+		event.stateId  = stateId;
+		event.method   = method;
 
-private:
-	HFSM_INLINE ConstPlanT(const PlanData& planData,
-						   const RegionID regionId);
+		if ((_eventHead & _eventMask) == _eventMask)
+			_eventsWrapped = true;
 
-	template <typename T>
-	static constexpr StateID  stateId()		{ return			StateList ::template index<T>();	}
+		++_eventHead;
+	}
+}
 
-	template <typename T>
-	static constexpr RegionID regionId()	{ return (RegionID) RegionList::template index<T>();	}
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-public:
-	HFSM_INLINE explicit operator bool() const;
+template <LongIndex NSC>
+const ProfileEntry&
+ProfilerT<NSC>::entry(const StateID stateId,
+					  const Method method) const
+{
+	HFSM_ASSERT(stateId < STATE_COUNT);
+	HFSM_ASSERT(method  < Method::COUNT);
 
-	HFSM_INLINE Iterator first()			{ return Iterator{*this};								}
+	return _entries[stateId * METHOD_COUNT + (LongIndex) method];
+}
 
-private:
-	const PlanData& _planData;
-	const Bounds& _bounds;
-};
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-////////////////////////////////////////////////////////////////////////////////
+template <LongIndex NSC>
+void
+ProfilerT<NSC>::clear() {
+	_entries.fill(ProfileEntry{});
 
-template <typename TArgs>
-class PlanT {
-	template <typename>
-	friend class PlanControlT;
+	_eventHead = 0;
+	_eventsWrapped = false;
+}
 
-	template <typename>
-	friend class FullControlT;
+//------------------------------------------------------------------------------
 
-	template <typename>
-	friend class GuardControlT;
+template <LongIndex NSC>
+void
+ProfilerT<NSC>::attachEvents(ProfileEvent* const events,
+							 const uint32_t capacity)
+{
+	HFSM_ASSERT(!events || (capacity && (capacity & (capacity - 1)) == 0));
 
-	using Args			= TArgs;
-	using Context		= typename Args::Context;
-	using StateList		= typename Args::StateList;
-	using RegionList	= typename Args::RegionList;
+	_events	   = events;
+	_eventMask = events ? capacity - 1 : 0;
+	_eventHead = 0;
+	_eventsWrapped = false;
+}
 
-	static constexpr LongIndex  TASK_CAPACITY	= Args::TASK_CAPACITY;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-public:
-	using PlanData		= PlanDataT<Args>;
-	using TaskLinks		= typename PlanData::TaskLinks;
-	using TaskIndex		= typename TaskLinks::Index;
+template <LongIndex NSC>
+uint32_t
+ProfilerT<NSC>::eventCount() const {
+	return !_events		  ? 0 :
+		   _eventsWrapped ? _eventMask + 1 : _eventHead;
+}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//------------------------------------------------------------------------------
 
-	struct Iterator {
-		HFSM_INLINE Iterator(PlanT& plan);
+template <LongIndex NSC>
+bool
+ProfilerT<NSC>::writeReport(const char* const path,
+							const char* const* const names) const
+{
+	FILE* const file = fopen(path, "w");
+	if (!file)
+		return false;
 
-		HFSM_INLINE explicit operator bool() const;
+	fprintf(file, "%-32s %-14s %12s %14s %10s %10s %10s  histogram (log2 bucket:count)\n",
+			"state", "method", "count", "total", "min", "mean", "max");
 
-		HFSM_INLINE void operator ++();
+	for (LongIndex s = 0; s < STATE_COUNT; ++s)
+		for (LongIndex m = 0; m < METHOD_COUNT; ++m) {
+			const ProfileEntry& e = _entries[s * METHOD_COUNT + m];
 
-		HFSM_INLINE		  TaskLink& operator  *()	    { return  _plan._planData.taskLinks[_curr];	}
-		HFSM_INLINE const TaskLink& operator  *() const { return  _plan._planData.taskLinks[_curr];	}
+			if (e.count) {
+				if (names && names[s])
+					fprintf(file, "%-32s ", names[s]);
+				else
+					fprintf(file, "%-32u ", (unsigned) s);
 
-		HFSM_INLINE		  TaskLink* operator ->()	    { return &_plan._planData.taskLinks[_curr];	}
-		HFSM_INLINE const TaskLink* operator ->() const { return &_plan._planData.taskLinks[_curr];	}
+				fprintf(file, "%-14s %12llu %14llu %10llu %10llu %10llu ",
+						methodName((Method) m),
+						(unsigned long long) e.count,
+						(unsigned long long) e.total,
+						(unsigned long long) e.min,
+						(unsigned long long) e.mean(),
+						(unsigned long long) e.max);
 
-		HFSM_INLINE void remove();
+				for (unsigned b = 0; b < ProfileEntry::BUCKET_COUNT; ++b)
+					if (e.histogram[b])
+						fprintf(file, " %u:%u", b, (unsigned) e.histogram[b]);
 
-		HFSM_INLINE LongIndex next() const;
+				fprintf(file, "\n");
+			}
+		}
 
-		PlanT& _plan;
-		LongIndex _curr;
-		LongIndex _next;
-	};
+	return fclose(file) == 0;
+}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-private:
-	HFSM_INLINE PlanT(PlanData& planData,
-					  const RegionID regionId);
+template <LongIndex NSC>
+bool
+ProfilerT<NSC>::writeChromeTrace(const char* const path,
+								 const char* const* const names,
+								 const double ticksPerMicrosecond) const
+{
+	if (!_events)
+		return false;
 
-	template <typename T>
-	static constexpr StateID  stateId()		{ return			StateList ::template index<T>();	}
+	FILE* const file = fopen(path, "w");
+	if (!file)
+		return false;
 
-	template <typename T>
-	static constexpr RegionID regionId()	{ return (RegionID) RegionList::template index<T>();	}
+	const uint32_t count = eventCount();
+	const uint32_t first = _eventHead - count;
 
-	bool append(const TransitionType transitionType,
-				const StateID origin,
-				const StateID destination);
+	fprintf(file, "{\"traceEvents\":[");
 
-public:
-	HFSM_INLINE explicit operator bool() const;
+	for (uint32_t i = 0; i < count; ++i) {
+		const ProfileEvent& event = _events[(first + i) & _eventMask];
 
-	HFSM_INLINE void clear();
+		fprintf(file, i ? ",\n" : "\n");
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+		if (names && names[event.stateId])
+			fprintf(file, "{\"name\":\"%s::%s\"", names[event.stateId], methodName(event.method));
+		else
+			fprintf(file, "{\"name\":\"%u::%s\"", (unsigned) event.stateId, methodName(event.method));
 
-	HFSM_INLINE bool change   (const StateID origin, const StateID destination)	{ return append(TransitionType::CHANGE,	   origin, destination); }
-	HFSM_INLINE bool restart  (const StateID origin, const StateID destination)	{ return append(TransitionType::RESTART,   origin, destination); }
-	HFSM_INLINE bool resume   (const StateID origin, const StateID destination)	{ return append(TransitionType::RESUME,	   origin, destination); }
-	HFSM_INLINE bool utilize  (const StateID origin, const StateID destination)	{ return append(TransitionType::UTILIZE,   origin, destination); }
-	HFSM_INLINE bool randomize(const StateID origin, const StateID destination)	{ return append(TransitionType::RANDOMIZE, origin, destination); }
-	HFSM_INLINE bool schedule (const StateID origin, const StateID destination)	{ return append(TransitionType::SCHEDULE,  origin, destination); }
+		fprintf(file, ",\"cat\":\"hfsm2\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":0,\"tid\":0}",
+				event.start	   / ticksPerMicrosecond,
+				event.duration / ticksPerMicrosecond);
+	}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	fprintf(file, "\n]}\n");
 
-	template <typename TOrigin>
-	HFSM_INLINE bool change   (const StateID destination)					{ return change   (stateId<TOrigin>(), destination);				}
+	return fclose(file) == 0;
+}
 
-	template <typename TOrigin>
-	HFSM_INLINE bool restart  (const StateID destination)					{ return restart  (stateId<TOrigin>(), destination);				}
+////////////////////////////////////////////////////////////////////////////////
 
-	template <typename TOrigin>
-	HFSM_INLINE bool resume   (const StateID destination)					{ return resume   (stateId<TOrigin>(), destination);				}
+}
 
-	template <typename TOrigin>
-	HFSM_INLINE bool utilize  (const StateID destination)					{ return utilize  (stateId<TOrigin>(), destination);				}
+#endif
 
-	template <typename TOrigin>
-	HFSM_INLINE bool randomize(const StateID destination)					{ return randomize(stateId<TOrigin>(), destination);				}
+#ifdef HFSM_ENABLE_STATISTICS
 
-	template <typename TOrigin>
-	HFSM_INLINE bool schedule (const StateID destination)					{ return schedule (stateId<TOrigin>(), destination);				}
+namespace hfsm2 {
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+////////////////////////////////////////////////////////////////////////////////
 
-	template <typename TOrigin, typename TDestination>
-	HFSM_INLINE bool change   ()											{ return change   (stateId<TOrigin>(), stateId<TDestination>());	}
+// Operational counters of a single machine instance
+//  Attach with R_::attachStatistics(), one per instance
+//  Time is measured in ticks - update() / react() calls of the attached machine
+//  Trivially copyable, so a snapshot is a plain copy
+//  merge() aggregates instances of a pool
 
-	template <typename TOrigin, typename TDestination>
-	HFSM_INLINE bool restart  ()											{ return restart  (stateId<TOrigin>(), stateId<TDestination>());	}
+template <LongIndex NStateCount>
+class StatisticsT {
+public:
+	static constexpr LongIndex STATE_COUNT = NStateCount;
 
-	template <typename TOrigin, typename TDestination>
-	HFSM_INLINE bool resume   ()											{ return resume   (stateId<TOrigin>(), stateId<TDestination>());	}
+	// Applied transitions, origin INVALID_STATE_ID stands for requests made from outside the machine
+	HFSM_INLINE uint32_t transitions(const StateID origin,
+									 const StateID destination) const;
 
-	template <typename TOrigin, typename TDestination>
-	HFSM_INLINE bool utilize  ()											{ return utilize  (stateId<TOrigin>(), stateId<TDestination>());	}
+	// Transitions into 'destination' cancelled by guards
+	HFSM_INLINE uint32_t cancelled(const StateID destination) const;
 
-	template <typename TOrigin, typename TDestination>
-	HFSM_INLINE bool randomize()											{ return randomize(stateId<TOrigin>(), stateId<TDestination>());	}
+	// Number of times the state was activated
+	HFSM_INLINE uint32_t visits(const StateID stateId) const;
 
-	template <typename TOrigin, typename TDestination>
-	HFSM_INLINE bool schedule ()											{ return schedule (stateId<TOrigin>(), stateId<TDestination>());	}
+	// Ticks spent in the state, including the ongoing visit
+	HFSM_INLINE uint64_t dwell(const StateID stateId) const;
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	HFSM_INLINE uint32_t tick() const							{ return _tick;								}
 
-	HFSM_INLINE Iterator first()			{ return Iterator{*this};								}
+	void merge(const StatisticsT& other);
 
-private:
-	void remove(const LongIndex task);
+	// Reset counters, keep tracking ongoing visits from the current tick
+	void clear();
+
+	// Write non-zero transition counts and per-state dwell times to 'path' as CSV
+	//  'names' - optional state names, indexed by StateID
+	bool writeCsv(const char* const path,
+				  const char* const* const names = nullptr) const;
+
+	//----------------------------------------------------------------------
+
+	HFSM_INLINE void advance()									{ ++_tick;									}
+
+	HFSM_INLINE void recordTransition(const StateID origin,
+									  const StateID destination);
+
+	HFSM_INLINE void recordCancelled (const StateID destination);
+
+	HFSM_INLINE void recordEnter(const StateID stateId);
+	HFSM_INLINE void recordExit (const StateID stateId);
 
 private:
-	PlanData& _planData;
-	const RegionID _regionId;
-	Bounds& _bounds;
+	struct Activity {
+		uint64_t dwell = 0;
+		uint32_t enteredAt = 0;
+		uint32_t visits = 0;
+		uint32_t cancelled = 0;
+		bool active = false;
+	};
+
+	// STATE_COUNT + 1 rows, the last one for external requests
+	detail::StaticArray<uint32_t, (STATE_COUNT + 1) * STATE_COUNT> _transitions{0u};
+	detail::StaticArray<Activity, STATE_COUNT> _activities;
+
+	uint32_t _tick = 0;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
 
-}
 }
 
 namespace hfsm2 {
-namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-Status::Status(const Result result_,
-			   const bool outerTransition_)
-	: result{result_}
-	, outerTransition{outerTransition_}
-{}
+template <LongIndex NSC>
+uint32_t
+StatisticsT<NSC>::transitions(const StateID origin,
+							  const StateID destination) const
+{
+	HFSM_ASSERT(origin < STATE_COUNT || origin == INVALID_STATE_ID);
+	HFSM_ASSERT(destination < STATE_COUNT);
 
-//------------------------------------------------------------------------------
+	const LongIndex row = origin < STATE_COUNT ? origin : STATE_COUNT;
 
-void
-Status::clear() {
-	result = NONE;
-	outerTransition = false;
+	return _transitions[row * STATE_COUNT + destination];
 }
 
-////////////////////////////////////////////////////////////////////////////////
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TArgs>
-ConstPlanT<TArgs>::Iterator::Iterator(const ConstPlanT& plan)
-	: _plan{plan}
-	, _curr{plan._bounds.first}
-{
-	_next = next();
+template <LongIndex NSC>
+uint32_t
+StatisticsT<NSC>::cancelled(const StateID destination) const {
+	HFSM_ASSERT(destination < STATE_COUNT);
+
+	return _activities[destination].cancelled;
 }
 
-//------------------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TArgs>
-ConstPlanT<TArgs>::Iterator::operator bool() const {
-	HFSM_ASSERT(_curr < ConstPlanT::TASK_CAPACITY || _curr == INVALID_LONG_INDEX);
+template <LongIndex NSC>
+uint32_t
+StatisticsT<NSC>::visits(const StateID stateId) const {
+	HFSM_ASSERT(stateId < STATE_COUNT);
 
-	return _curr < ConstPlanT::TASK_CAPACITY;
+	return _activities[stateId].visits;
 }
 
-//------------------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TArgs>
-void
-ConstPlanT<TArgs>::Iterator::operator ++() {
-	_curr = _next;
-	_next = next();
+template <LongIndex NSC>
+uint64_t
+StatisticsT<NSC>::dwell(const StateID stateId) const {
+	HFSM_ASSERT(stateId < STATE_COUNT);
+
+	const Activity& activity = _activities[stateId];
+
+	return activity.active ?
+		activity.dwell + (_tick - activity.enteredAt) :
+		activity.dwell;
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TArgs>
-LongIndex
-ConstPlanT<TArgs>::Iterator::next() const {
-	if (_curr < ConstPlanT::TASK_CAPACITY) {
-		const TaskLink& task = _plan._planData.taskLinks[_curr];
+template <LongIndex NSC>
+void
+StatisticsT<NSC>::merge(const StatisticsT& other) {
+	for (LongIndex i = 0; i < _transitions.count(); ++i)
+		_transitions[i] += other._transitions[i];
 
-		return task.next;
-	} else {
-		HFSM_ASSERT(_curr == INVALID_LONG_INDEX);
+	for (StateID s = 0; s < STATE_COUNT; ++s) {
+		Activity& activity = _activities[s];
+		const Activity& source = other._activities[s];
 
-		return INVALID_LONG_INDEX;
+		activity.dwell	   += other.dwell(s);
+		activity.visits	   += source.visits;
+		activity.cancelled += source.cancelled;
 	}
 }
 
-////////////////////////////////////////////////////////////////////////////////
-
-template <typename TArgs>
-ConstPlanT<TArgs>::ConstPlanT(const PlanData& planData,
-							  const RegionID regionId)
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	: _planData{planData}
-	, _bounds{planData.tasksBounds[regionId]}
-{}
+template <LongIndex NSC>
+void
+StatisticsT<NSC>::clear() {
+	_transitions.fill(0u);
 
-//------------------------------------------------------------------------------
+	for (StateID s = 0; s < STATE_COUNT; ++s) {
+		Activity& activity = _activities[s];
 
-template <typename TArgs>
-ConstPlanT<TArgs>::operator bool() const {
-	if (_bounds.first < TASK_CAPACITY) {
-		HFSM_ASSERT(_bounds.last < TASK_CAPACITY);
-		return true;
-	} else {
-		HFSM_ASSERT(_bounds.last == INVALID_LONG_INDEX);
-		return false;
+		activity.dwell	   = 0;
+		activity.enteredAt = _tick;
+		activity.visits	   = 0;
+		activity.cancelled = 0;
 	}
 }
 
-////////////////////////////////////////////////////////////////////////////////
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TArgs>
-PlanT<TArgs>::Iterator::Iterator(PlanT& plan)
-	: _plan{plan}
-	, _curr{plan._bounds.first}
+template <LongIndex NSC>
+bool
+StatisticsT<NSC>::writeCsv(const char* const path,
+						   const char* const* const names) const
 {
-	_next = next();
-}
+	FILE* const file = fopen(path, "w");
+	if (!file)
+		return false;
 
-//------------------------------------------------------------------------------
+	const auto writeName = [&](const StateID s) {
+		if (s == INVALID_STATE_ID)
+			fprintf(file, "external,");
+		else if (names && names[s])
+			fprintf(file, "%s,", names[s]);
+		else
+			fprintf(file, "%u,", (unsigned) s);
+	};
 
-template <typename TArgs>
-PlanT<TArgs>::Iterator::operator bool() const {
-	HFSM_ASSERT(_curr < PlanT::TASK_CAPACITY || _curr == INVALID_LONG_INDEX);
+	fprintf(file, "origin,destination,transitions\n");
 
-	return _curr < PlanT::TASK_CAPACITY;
+	for (LongIndex o = 0; o <= STATE_COUNT; ++o)
+		for (StateID d = 0; d < STATE_COUNT; ++d)
+			if (const uint32_t count = _transitions[o * STATE_COUNT + d]) {
+				writeName(o < STATE_COUNT ? (StateID) o : INVALID_STATE_ID);
+				writeName(d);
+				fprintf(file, "%u\n", (unsigned) count);
+			}
+
+	fprintf(file, "\nstate,visits,dwell,cancelled\n");
+
+	for (StateID s = 0; s < STATE_COUNT; ++s) {
+		writeName(s);
+		fprintf(file, "%u,%llu,%u\n",
+				(unsigned) _activities[s].visits,
+				(unsigned long long) dwell(s),
+				(unsigned) _activities[s].cancelled);
+	}
+
+	return fclose(file) == 0;
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TArgs>
+template <LongIndex NSC>
 void
-PlanT<TArgs>::Iterator::operator ++() {
-	_curr = _next;
-	_next = next();
+StatisticsT<NSC>::recordTransition(const StateID origin,
+								   const StateID destination)
+{
+	HFSM_ASSERT(origin < STATE_COUNT || origin == INVALID_STATE_ID);
+	HFSM_ASSERT(destination < STATE_COUNT);
+
+	const LongIndex row = origin < STATE_COUNT ? origin : STATE_COUNT;
+
+	++_transitions[row * STATE_COUNT + destination];
 }
 
-//------------------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TArgs>
+template <LongIndex NSC>
 void
-PlanT<TArgs>::Iterator::remove() {
-	_plan.remove(_curr);
+StatisticsT<NSC>::recordCancelled(const StateID destination) {
+	HFSM_ASSERT(destination < STATE_COUNT);
+
+	++_activities[destination].cancelled;
 }
 
-//------------------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TArgs>
-LongIndex
-PlanT<TArgs>::Iterator::next() const {
-	if (_curr < PlanT::TASK_CAPACITY) {
-		const TaskLink& task = _plan._planData.taskLinks[_curr];
+template <LongIndex NSC>
+void
+StatisticsT<NSC>::recordEnter(const StateID stateId) {
+	HFSM_ASSERT(stateId < STATE_COUNT);
 
-		return task.next;
-	} else {
-		HFSM_ASSERT(_curr == INVALID_LONG_INDEX);
+	Activity& activity = _activities[stateId];
 
-		return INVALID_LONG_INDEX;
+	if (!activity.active) {
+		activity.enteredAt = _tick;
+		activity.active	   = true;
+		++activity.visits;
 	}
 }
 
-////////////////////////////////////////////////////////////////////////////////
-
-template <typename TArgs>
-PlanT<TArgs>::PlanT(PlanData& planData,
-					const RegionID regionId)
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	: _planData{planData}
-	, _regionId{regionId}
-	, _bounds{planData.tasksBounds[regionId]}
-{}
+template <LongIndex NSC>
+void
+StatisticsT<NSC>::recordExit(const StateID stateId) {
+	HFSM_ASSERT(stateId < STATE_COUNT);
 
-//------------------------------------------------------------------------------
+	Activity& activity = _activities[stateId];
 
-template <typename TArgs>
-PlanT<TArgs>::operator bool() const {
-	if (_bounds.first < TASK_CAPACITY) {
-		HFSM_ASSERT(_bounds.last < TASK_CAPACITY);
-		return true;
-	} else {
-		HFSM_ASSERT(_bounds.last == INVALID_LONG_INDEX);
-		return false;
+	if (activity.active) {
+		activity.dwell += _tick - activity.enteredAt;
+		activity.active = false;
 	}
 }
 
-//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
 
-template <typename TArgs>
-bool
-PlanT<TArgs>::append(const TransitionType transitionType,
-					 const StateID origin,
-					 const StateID destination)
-{
-	_planData.planExists.set(_regionId);
+}
 
-	const TaskIndex index = _planData.taskLinks.emplace(transitionType, origin, destination);
-	if (index == TaskLinks::INVALID)
-		return false;
+#endif
 
-	if (_bounds.first < TaskLinks::CAPACITY) {
-		HFSM_ASSERT(_bounds.last < TaskLinks::CAPACITY);
+#ifdef HFSM_ENABLE_WATCHDOG
 
-		auto& last  = _planData.taskLinks[_bounds.last];
-		last.next = index;
+namespace hfsm2 {
 
-		auto& next = _planData.taskLinks[index];
-		next.prev  = _bounds.last;
+////////////////////////////////////////////////////////////////////////////////
 
-		_bounds.last = index;
-	} else {
-		HFSM_ASSERT(_bounds.first == INVALID_LONG_INDEX &&
-					_bounds.last  == INVALID_LONG_INDEX);
+// Counters of pathological transition patterns, see R_::watchdogReport()
+//  Members:
+//   ticks				- Number of update() / react() calls
+//   calls				- Number of calls that processed transitions
+//   rounds				- Substitution rounds over all calls
+//   maxRounds			- Most substitution rounds within a single call
+//   limitHits			- Calls that ran out of substitution rounds with requests still pending
+//   oscillations		- Transitions reverting an earlier one (A -> B -> A)
+//						  within Watchdog::WINDOW ticks
+//   oscillationOrigin,
+//   oscillationTarget	- States of the latest oscillating transition
+
+struct WatchdogReport {
+	uint32_t ticks = 0;
+	uint32_t calls = 0;
+	uint32_t rounds = 0;
+	uint32_t maxRounds = 0;
+	uint32_t limitHits = 0;
+	uint32_t oscillations = 0;
+
+	StateID oscillationOrigin = INVALID_STATE_ID;
+	StateID oscillationTarget = INVALID_STATE_ID;
+};
 
-		_bounds.first = index;
-		_bounds.last  = index;
-	}
+////////////////////////////////////////////////////////////////////////////////
+
+namespace detail {
+
+class Watchdog {
+public:
+	// Sliding window for oscillation detection, in ticks
+	enum : uint32_t { WINDOW = 4 };
+
+	HFSM_INLINE void tick()										{ ++_report.ticks;							}
+
+	// Returns true if the substitution limit was hit
+	HFSM_INLINE bool recordRounds(const LongIndex rounds,
+								  const bool requestsPending);
+
+	// Returns true if the transition reverts a recent one
+	HFSM_INLINE bool recordTransition(const StateID origin,
+									  const StateID target);
+
+	HFSM_INLINE const WatchdogReport& report() const			{ return _report;							}
+
+	HFSM_INLINE void reset();
+
+private:
+	struct Recent {
+		uint32_t tick;
+		StateID origin;
+		StateID target;
+	};
+
+	enum : unsigned { RECENT_CAPACITY = 8 };
+
+	WatchdogReport _report;
+
+	Recent _recent[RECENT_CAPACITY];
+	unsigned _recentCount = 0;
+	unsigned _recentHead = 0;
+};
 
-	return true;
 }
 
-//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
 
-template <typename TArgs>
-void
-PlanT<TArgs>::clear() {
-	if (_bounds.first < TaskLinks::CAPACITY) {
-		HFSM_ASSERT(_bounds.last < TaskLinks::CAPACITY);
+}
 
-		for (LongIndex index = _bounds.first;
-			 index != INVALID_LONG_INDEX;
-			 )
-		{
-			HFSM_ASSERT(index < TaskLinks::CAPACITY);
+namespace hfsm2 {
+namespace detail {
 
-			const auto& task = _planData.taskLinks[index];
-			HFSM_ASSERT(index == _bounds.first ?
-				   task.prev == INVALID_LONG_INDEX :
-				   task.prev <  TaskLinks::CAPACITY);
+////////////////////////////////////////////////////////////////////////////////
 
-			const LongIndex next = task.next;
+inline
+bool
+Watchdog::recordRounds(const LongIndex rounds,
+					   const bool requestsPending)
+{
+	++_report.calls;
+	_report.rounds += rounds;
 
-			_planData.taskLinks.remove(index);
+	if (_report.maxRounds < rounds)
+		_report.maxRounds = rounds;
 
-			index = next;
-		}
+	if (requestsPending)
+		++_report.limitHits;
 
-		_bounds.first = INVALID_LONG_INDEX;
-		_bounds.last  = INVALID_LONG_INDEX;
-	} else
-		HFSM_ASSERT(_bounds.first == INVALID_LONG_INDEX &&
-			   _bounds.last  == INVALID_LONG_INDEX);
+	return requestsPending;
 }
 
-//------------------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TArgs>
-void
-PlanT<TArgs>::remove(const LongIndex task) {
-	HFSM_ASSERT(_planData.planExists.get(_regionId) &&
-				_bounds.first < TaskLinks::CAPACITY &&
-				_bounds.last  < TaskLinks::CAPACITY);
+inline
+bool
+Watchdog::recordTransition(const StateID origin,
+						   const StateID target)
+{
+	if (origin == INVALID_STATE_ID || origin == target)
+		return false;
 
-	HFSM_ASSERT(task < TaskLinks::CAPACITY);
+	bool oscillating = false;
 
-	const TaskLink& curr = _planData.taskLinks[task];
+	for (unsigned i = 0; i < _recentCount; ++i) {
+		const Recent& recent = _recent[i];
 
-	if (curr.prev < TaskLinks::CAPACITY) {
-		TaskLink& prev = _planData.taskLinks[curr.prev];
-		prev.next = curr.next;
-	} else {
-		HFSM_ASSERT(_bounds.first == task);
-		_bounds.first = curr.next;
+		if (recent.origin == target &&
+			recent.target == origin &&
+			_report.ticks - recent.tick <= WINDOW)
+		{
+			oscillating = true;
+			break;
+		}
 	}
 
-	if (curr.next < TaskLinks::CAPACITY) {
-		TaskLink& next = _planData.taskLinks[curr.next];
-		next.prev = curr.prev;
-	} else {
-		HFSM_ASSERT(_bounds.last == task);
-		_bounds.last = curr.prev;
+	if (oscillating) {
+		++_report.oscillations;
+		_report.oscillationOrigin = origin;
+		_report.oscillationTarget = target;
 	}
 
-	_planData.taskLinks.remove(task);
+	_recent[_recentHead] = Recent{_report.ticks, origin, target};
+	_recentHead = (_recentHead + 1) % RECENT_CAPACITY;
+
+	if (_recentCount < RECENT_CAPACITY)
+		++_recentCount;
+
+	return oscillating;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+inline
+void
+Watchdog::reset() {
+	_report = WatchdogReport{};
+
+	_recentCount = 0;
+	_recentHead	 = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2983,1088 +3560,1156 @@ PlanT<TArgs>::remove(const LongIndex task) {
 }
 }
 
+#endif
+
+
 namespace hfsm2 {
-namespace detail {
 
-//------------------------------------------------------------------------------
+#ifdef HFSM_ENABLE_PARALLEL
 
-enum Strategy {
-	Composite,
-	Resumable,
-	Utilitarian,
-	RandomUtil,
+////////////////////////////////////////////////////////////////////////////////
+
+// Runs the sub-states of ParallelOrthogonal<> regions, attached with R_::attachExecutor()
+//  Without an executor, the sub-states run one after another on the calling thread
+//  Each sub-state collects its transitions and task statuses separately,
+//  merged in sub-state order once all of them complete,
+//  so the outcome doesn't depend on the order they run in
+//  While they run, sub-states (and everything below them) must not:
+//   - edit plans, or have plans of their own in progress
+//   - arm or cancel timers, or attach payloads to transitions
+//   - spawn coroutine tasks
+//   - write to the context, unless the writes are synchronized by the user
+//  Attached logger, profiler and statistics are called concurrently too
+//  Plan edits, timers, payloads and tasks are asserted with HFSM_ENABLE_ASSERT
+
+struct ExecutorInterface {
+	using Job = void (*)(void* const argument, const LongIndex index);
+
+	// Call 'job(argument, index)' once for each 'index' in [0, count),
+	//  in any order and on any threads, and return once all calls complete
+	virtual void execute(const Job job,
+						 void* const argument,
+						 const LongIndex count) = 0;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
 
-#pragma pack(push, 1)
-
-struct alignas(2 * sizeof(ShortIndex)) Parent {
-	HFSM_INLINE Parent() = default;
+#endif
 
-	HFSM_INLINE Parent(const ForkID forkId_)
-		: forkId{forkId_}
-	{}
+}
 
-	HFSM_INLINE Parent(const ForkID forkId_,
-					   const ShortIndex prong_)
-		: forkId{forkId_}
-		, prong{prong_}
-	{}
+#ifdef HFSM_ENABLE_PAYLOADS
 
-	HFSM_INLINE explicit operator bool() const {
-		return forkId != INVALID_FORK_ID &&
-			   prong  != INVALID_SHORT_INDEX;
-	}
+namespace hfsm2 {
+namespace detail {
 
-	ForkID	   forkId = INVALID_FORK_ID;
-	ShortIndex prong  = INVALID_SHORT_INDEX;
-};
+////////////////////////////////////////////////////////////////////////////////
 
-#pragma pack(pop)
+// Transition payloads, stored inline and keyed by the destination state
+//  Each payload is tagged with the transition round it was requested in,
+//  a round cancelled by guards drops its own payloads and nothing else
 
-////////////////////////////////////////////////////////////////////////////////
+template <LongIndex NSize, LongIndex NCapacity>
+class PayloadsT {
+public:
+	static constexpr LongIndex SIZE		= NSize;
+	static constexpr LongIndex CAPACITY = NCapacity;
 
-struct Request {
-	enum Type {
-		REMAIN,
-		CHANGE,
-		RESTART,
-		RESUME,
-		UTILIZE,
-		RANDOMIZE,
-		SCHEDULE,
+private:
+	using Storage = typename std::aligned_storage<SIZE>::type;
 
-		COUNT
+	struct Entry {
+		Storage storage;
+		const void* type;
+		StateID stateId;
+		uint16_t round;
 	};
 
-	HFSM_INLINE Request() = default;
+public:
+	// Replaces the payload already staged for 'stateId', returns false if out of entries
+	template <typename TPayload>
+	HFSM_INLINE bool stage(const StateID stateId, const TPayload& payload);
 
-	HFSM_INLINE Request(const Type type_,
-						const StateID stateId_)
-		: type{type_}
-		, stateId{stateId_}
-	{
-		HFSM_ASSERT(type_ < Type::COUNT);
-	}
+	// nullptr if nothing is staged for 'stateId', or the payload type differs
+	template <typename TPayload>
+	HFSM_INLINE const TPayload* find(const StateID stateId) const;
 
-	Type type = CHANGE;
-	StateID stateId = INVALID_STATE_ID;
-};
+	// Close the current round, returns its number
+	HFSM_INLINE uint16_t seal()									{ return _round++;						}
 
-template <ShortIndex NCount>
-using RequestsT = Array<Request, NCount>;
+	HFSM_INLINE void discard(const uint16_t round);
 
-////////////////////////////////////////////////////////////////////////////////
+	HFSM_INLINE void clear()									{ _count = 0; _round = 0;				}
 
-template <typename TRegistry>
-struct BackUpT {
-	using CompoForks = typename TRegistry::CompoForks;
-	using OrthoForks = typename TRegistry::OrthoForks;
+	HFSM_INLINE LongIndex count() const							{ return _count;						}
 
-	CompoForks compoRequested;
-	OrthoForks orthoRequested;
-	CompoForks compoResumable;
+private:
+	HFSM_INLINE LongIndex index(const StateID stateId) const;
+
+private:
+	Entry _entries[CAPACITY];
+	LongIndex _count = 0;
+	uint16_t _round = 0;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename,
-		  typename,
-		  typename,
-		  typename,
-		  LongIndex,
-		  LongIndex,
-		  LongIndex,
-		  LongIndex,
-		  LongIndex>
-struct ArgsT;
+}
+}
 
-template <typename>
-struct RegistryT;
+namespace hfsm2 {
+namespace detail {
 
-//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
 
-template <typename TContext,
-		  typename TConfig,
-		  typename TStateList,
-		  typename TRegionList,
-		  LongIndex NCompoCount,
-		  LongIndex NOrthoCount,
-		  LongIndex NOrthoUnits,
-		  LongIndex NSerialBits,
-		  LongIndex NTaskCapacity>
-struct RegistryT<ArgsT<TContext,
-					   TConfig,
-					   TStateList,
-					   TRegionList,
-					   NCompoCount,
-					   NOrthoCount,
-					   NOrthoUnits,
-					   NSerialBits,
-					   NTaskCapacity>>
+template <LongIndex NS, LongIndex NC>
+template <typename TPayload>
+bool
+PayloadsT<NS, NC>::stage(const StateID stateId,
+						 const TPayload& payload)
 {
-	using StateList		= TStateList;
-	using RegionList	= TRegionList;
+	static_assert(sizeof (TPayload) <= SIZE,				"Payload doesn't fit, increase ConfigT<>::PayloadSizeN<>");
+	static_assert(alignof(TPayload) <= alignof(Storage),	"Payload is over-aligned");
+	static_assert(std::is_trivially_destructible<TPayload>::value, "Payloads are never destroyed");
 
-	static constexpr LongIndex  STATE_COUNT		= StateList::SIZE;
-	static constexpr ShortIndex COMPO_REGIONS	= NCompoCount;
-	static constexpr ShortIndex ORTHO_REGIONS	= NOrthoCount;
-	static constexpr ShortIndex ORTHO_UNITS		= NOrthoUnits;
+	LongIndex i = index(stateId);
 
-	using StateParents	= StaticArray<Parent, STATE_COUNT>;
+	if (i == INVALID_LONG_INDEX) {
+		if (_count == CAPACITY)
+			return false;
 
-	using CompoParents	= StaticArray<Parent, COMPO_REGIONS>;
-	using OrthoParents	= StaticArray<Parent, ORTHO_REGIONS>;
-	using OrthoUnits	= StaticArray<Units,  ORTHO_UNITS>;
+		i = _count++;
+	}
 
-	using CompoForks	= StaticArray<ShortIndex, COMPO_REGIONS>;
-	using OrthoForks	= BitArray	 <ShortIndex, ORTHO_UNITS>;
-	using OrthoBits		= typename OrthoForks::Bits;
-	using CompoRemains	= BitArray	 <ShortIndex, COMPO_REGIONS>;
+	Entry& entry = _entries[i];
 
-	using BackUp		= BackUpT<RegistryT>;
+	new (&entry.storage) TPayload{payload};
+	entry.type	  = &TypeTagT<TPayload>::TAG;
+	entry.stateId = stateId;
+	entry.round	  = _round;
 
-	bool isActive		(const StateID stateId) const;
-	bool isResumable	(const StateID stateId) const;
+	return true;
+}
 
-	bool isPendingChange(const StateID stateId) const;
-	bool isPendingEnter	(const StateID stateId) const;
-	bool isPendingExit	(const StateID stateId) const;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	HFSM_INLINE const Parent&	  forkParent(const ForkID forkId) const;
+template <LongIndex NS, LongIndex NC>
+template <typename TPayload>
+const TPayload*
+PayloadsT<NS, NC>::find(const StateID stateId) const {
+	const LongIndex i = index(stateId);
 
-	HFSM_INLINE OrthoBits requestedOrthoFork(const ForkID forkId);
+	if (i != INVALID_LONG_INDEX && _entries[i].type == &TypeTagT<TPayload>::TAG)
+		return reinterpret_cast<const TPayload*>(&_entries[i].storage);
+	else
+		return nullptr;
+}
 
-	bool requestImmediate(const Request request);
-	void requestScheduled(const StateID stateId);
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	void clearRequests();
-	void reset();
+template <LongIndex NS, LongIndex NC>
+void
+PayloadsT<NS, NC>::discard(const uint16_t round) {
+	for (LongIndex i = 0; i < _count; )
+		if (_entries[i].round == round)
+			_entries[i] = _entries[--_count];
+		else
+			++i;
+}
 
-	StateParents stateParents;
-	CompoParents compoParents;
-	OrthoParents orthoParents;
-	OrthoUnits orthoUnits;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	CompoForks compoRequested{INVALID_SHORT_INDEX};
-	OrthoForks orthoRequested;
-	CompoForks compoActive	 {INVALID_SHORT_INDEX};
-	CompoForks compoResumable{INVALID_SHORT_INDEX};
+template <LongIndex NS, LongIndex NC>
+LongIndex
+PayloadsT<NS, NC>::index(const StateID stateId) const {
+	for (LongIndex i = 0; i < _count; ++i)
+		if (_entries[i].stateId == stateId)
+			return i;
 
-	CompoRemains compoRemains;
-};
+	return INVALID_LONG_INDEX;
+}
 
-//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
 
-template <typename TContext,
-		  typename TConfig,
-		  typename TStateList,
-		  typename TRegionList,
-		  LongIndex NCompoCount,
-		  LongIndex NSerialBits,
-		  LongIndex NTaskCapacity>
-struct RegistryT<ArgsT<TContext,
-					   TConfig,
-					   TStateList,
-					   TRegionList,
-					   NCompoCount,
-					   0,
-					   0,
-					   NSerialBits,
-					   NTaskCapacity>>
-{
-	using StateList		= TStateList;
-	using RegionList	= TRegionList;
+}
+}
 
-	static constexpr LongIndex  STATE_COUNT		= StateList::SIZE;
-	static constexpr ShortIndex COMPO_REGIONS	= NCompoCount;
+#endif
 
-	using StateParents	= StaticArray<Parent, STATE_COUNT>;
-	using CompoParents	= StaticArray<Parent, COMPO_REGIONS>;
+#ifdef HFSM_ENABLE_COROUTINES
 
-	using CompoForks	= StaticArray<ShortIndex, COMPO_REGIONS>;
-	using OrthoForks	= BitArray	 <ShortIndex, 0>;
-	using CompoRemains	= BitArray	 <ShortIndex, COMPO_REGIONS>;
+namespace hfsm2 {
 
-	using BackUp		= BackUpT<RegistryT>;
+namespace detail {
 
-	bool isActive		(const StateID stateId) const;
-	bool isResumable	(const StateID stateId) const;
+template <LongIndex, LongIndex>
+class CoroutinesT;
 
-	bool isPendingChange(const StateID stateId) const;
-	bool isPendingEnter	(const StateID stateId) const;
-	bool isPendingExit	(const StateID stateId) const;
+}
 
-	HFSM_INLINE const Parent& forkParent(const ForkID forkId) const;
+////////////////////////////////////////////////////////////////////////////////
 
-	bool requestImmediate(const Request request);
-	void requestScheduled(const StateID stateId);
+// First fit frame allocator over a fixed buffer owned by the machine
+//  Free blocks are kept sorted by address and merged with their neighbours
 
-	void clearRequests();
-	void reset();
+class CoroutineArena {
+	struct alignas(std::max_align_t) Header {
+		CoroutineArena* arena;
+		size_t size;
+	};
 
-	StateParents stateParents;
-	CompoParents compoParents;
+	struct Block {
+		size_t size;
+		Block* next;
+	};
 
-	CompoForks compoRequested{INVALID_SHORT_INDEX};
-	OrthoForks orthoRequested;
-	CompoForks compoActive	 {INVALID_SHORT_INDEX};
-	CompoForks compoResumable{INVALID_SHORT_INDEX};
+public:
+	static constexpr size_t ALIGNMENT = alignof(std::max_align_t);
 
-	CompoRemains compoRemains;
-};
+	HFSM_INLINE void attach(void* const buffer, const size_t size);
 
-////////////////////////////////////////////////////////////////////////////////
+	// nullptr if no free block is large enough
+	HFSM_INLINE void* allocate(const size_t size);
 
-template <typename TRegistry>
-void
-backup(const TRegistry& registry, BackUpT<TRegistry>& copy) {
-	overwrite(copy.compoRequested, registry.compoRequested);
-	overwrite(copy.orthoRequested, registry.orthoRequested);
-	overwrite(copy.compoResumable, registry.compoResumable);
-}
+	static HFSM_INLINE void deallocate(void* const pointer);
 
-//------------------------------------------------------------------------------
+	HFSM_INLINE size_t used() const										{ return _used;							}
+	HFSM_INLINE size_t capacity() const									{ return _capacity;						}
 
-template <typename TRegistry>
-void
-restore(TRegistry& registry, const BackUpT<TRegistry>& copy) {
-	overwrite(registry.compoRequested, copy.compoRequested);
-	overwrite(registry.orthoRequested, copy.orthoRequested);
-	overwrite(registry.compoResumable, copy.compoResumable);
-}
+private:
+	HFSM_INLINE void release(Header* const header);
 
-////////////////////////////////////////////////////////////////////////////////
+private:
+	Block* _free = nullptr;
+	size_t _capacity = 0;
+	size_t _used = 0;
+};
 
-}
-}
+//------------------------------------------------------------------------------
 
+// Return type of state coroutines, attached to a state with PlanControl::spawn()
+//  One of the coroutine's arguments has to be a control, its frame is allocated
+//  from the machine's arena instead of the heap
+//  The control argument is only used for the allocation, don't access it after the first co_await
 
-namespace hfsm2 {
-namespace detail {
+class CoTask {
+	template <LongIndex, LongIndex>
+	friend class detail::CoroutinesT;
 
-////////////////////////////////////////////////////////////////////////////////
+public:
+	struct promise_type;
+	using Handle = std::coroutine_handle<promise_type>;
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, LongIndex NSB, LongIndex NTC>
-bool
-RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, NSB, NTC>>::isActive(const StateID stateId) const {
-	if (HFSM_CHECKED(stateId < STATE_COUNT))
-		for (Parent parent = stateParents[stateId];
-			 parent;
-			 parent = forkParent(parent.forkId))
-		{
-			HFSM_ASSERT(parent.forkId != 0);
+	HFSM_INLINE CoTask() = default;
 
-			if (parent.forkId > 0)
-				return parent.prong == compoActive[parent.forkId - 1];
-		}
+	HFSM_INLINE CoTask(CoTask&& other) noexcept
+		: _handle{other._handle}
+	{
+		other._handle = nullptr;
+	}
 
-	return true;
-}
+	CoTask(const CoTask&) = delete;
+	CoTask& operator = (const CoTask&) = delete;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	HFSM_INLINE ~CoTask()												{ if (_handle) _handle.destroy();		}
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, LongIndex NSB, LongIndex NTC>
-bool
-RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, NSB, NTC>>::isResumable(const StateID stateId) const {
-	if (HFSM_CHECKED(stateId < STATE_COUNT))
-		for (Parent parent = stateParents[stateId];
-			 parent;
-			 parent = forkParent(parent.forkId))
-		{
-			HFSM_ASSERT(parent.forkId != 0);
+	// false if the frame didn't fit into the arena
+	HFSM_INLINE explicit operator bool() const							{ return (bool) _handle;				}
 
-			if (parent.forkId > 0)
-				return parent.prong == compoResumable[parent.forkId - 1];
-		}
+private:
+	HFSM_INLINE explicit CoTask(const Handle handle)
+		: _handle{handle}
+	{}
 
-	return false;
-}
+	Handle _handle;
+};
 
-//------------------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, LongIndex NSB, LongIndex NTC>
-bool
-RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, NSB, NTC>>::isPendingChange(const StateID stateId) const {
-	if (HFSM_CHECKED(stateId < STATE_COUNT))
-		for (Parent parent = stateParents[stateId];
-			 parent;
-			 parent = forkParent(parent.forkId))
-		{
-			HFSM_ASSERT(parent.forkId != 0);
+namespace detail {
 
-			if (parent.forkId > 0)
-				return compoRequested[parent.forkId - 1] !=
-					   compoActive	 [parent.forkId - 1];
-		}
+template <typename T>
+concept CoroutineArenaSource = requires(T& argument) { argument.coroutineArena(); };
 
-	return true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, LongIndex NSB, LongIndex NTC>
-bool
-RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, NSB, NTC>>::isPendingEnter(const StateID stateId) const {
-	if (HFSM_CHECKED(stateId < STATE_COUNT))
-		for (Parent parent = stateParents[stateId];
-			 parent;
-			 parent = forkParent(parent.forkId))
-		{
-			HFSM_ASSERT(parent.forkId != 0);
+struct CoTask::promise_type {
+	enum class Wait : uint8_t {
+		NONE,
+		TICKS,
+		EVENT,
+	};
 
-			if (parent.forkId > 0)
-				return parent.prong != compoActive	 [parent.forkId - 1] &&
-					   parent.prong == compoRequested[parent.forkId - 1];
-		}
+	HFSM_INLINE CoTask get_return_object() noexcept						{ return CoTask{Handle::from_promise(*this)};	}
+	static HFSM_INLINE CoTask get_return_object_on_allocation_failure() noexcept	{ return CoTask{};		}
 
-	return true;
-}
+	HFSM_INLINE std::suspend_always initial_suspend() noexcept			{ return {};							}
+	HFSM_INLINE std::suspend_always final_suspend() noexcept			{ return {};							}
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	HFSM_INLINE void return_void() noexcept								{}
+	HFSM_INLINE void unhandled_exception() noexcept						{ std::terminate();						}
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, LongIndex NSB, LongIndex NTC>
-bool
-RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, NSB, NTC>>::isPendingExit(const StateID stateId) const {
-	if (HFSM_CHECKED(stateId < STATE_COUNT))
-		for (Parent parent = stateParents[stateId];
-			 parent;
-			 parent = forkParent(parent.forkId))
-		{
-			HFSM_ASSERT(parent.forkId != 0);
+	template <typename... TArgs>
+	static HFSM_INLINE void* operator new(const size_t size, TArgs&... args) noexcept;
 
-			if (parent.forkId > 0)
-				return parent.prong == compoActive	 [parent.forkId - 1] &&
-					   parent.prong != compoRequested[parent.forkId - 1];
-		}
+	static HFSM_INLINE void operator delete(void* const pointer) noexcept	{ CoroutineArena::deallocate(pointer);	}
 
-	return true;
-}
+	// matches operator new() above
+	template <typename... TArgs>
+	static HFSM_INLINE void operator delete(void* const pointer, TArgs&...) noexcept	{ CoroutineArena::deallocate(pointer);	}
+
+	Wait wait = Wait::NONE;
+	uint32_t ticks = 0;
+	const void* eventType = nullptr;
+	const void* event = nullptr;
+	bool reported = false;
+};
 
 //------------------------------------------------------------------------------
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, LongIndex NSB, LongIndex NTC>
-const Parent&
-RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, NSB, NTC>>::forkParent(const ForkID forkId) const {
-	HFSM_ASSERT(forkId != 0);
+struct TicksAwaiter {
+	HFSM_INLINE bool await_ready() const noexcept						{ return ticks == 0;					}
+	HFSM_INLINE void await_suspend(const CoTask::Handle handle) const noexcept;
+	HFSM_INLINE void await_resume() const noexcept						{}
 
-	return forkId > 0 ?
-		compoParents[ forkId - 1] :
-		orthoParents[-forkId - 1];
-}
+	uint32_t ticks;
+};
 
-//------------------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, LongIndex NSB, LongIndex NTC>
-typename RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, NSB, NTC>>::OrthoBits
-RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, NSB, NTC>>::requestedOrthoFork(const ForkID forkId) {
-	HFSM_ASSERT(forkId < 0);
-	const Units& units = orthoUnits[-forkId - 1];
+template <typename TEvent>
+struct EventAwaiterT {
+	HFSM_INLINE bool await_ready() const noexcept						{ return false;							}
+	HFSM_INLINE void await_suspend(const CoTask::Handle handle) noexcept;
+	HFSM_INLINE TEvent await_resume() const;
 
-	return orthoRequested.bits(units);
-}
+	const CoTask::promise_type* promise = nullptr;
+};
 
-//------------------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, LongIndex NSB, LongIndex NTC>
-bool
-RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, NSB, NTC>>::requestImmediate(const Request request) {
-	if (request.stateId == 0)
-		return false;
-	else if (HFSM_CHECKED(request.stateId < STATE_COUNT)) {
-		Parent parent;
+// Resume on the next update() of the task's state
+HFSM_INLINE TicksAwaiter nextTick()										{ return TicksAwaiter{1};				}
 
-		for (parent = stateParents[request.stateId];
-			 parent;
-			 parent = forkParent(parent.forkId))
-		{
-			if (parent.forkId > 0) {
-				compoRequested[parent.forkId - 1] = parent.prong;
-				parent = forkParent(parent.forkId);
+// Resume after 'ticks' update() calls of the task's state, in the same units as timers
+HFSM_INLINE TicksAwaiter timeout(const uint32_t ticks)					{ return TicksAwaiter{ticks};			}
 
-				break;
-			} else if (parent.forkId < 0)
-				requestedOrthoFork(parent.forkId).set(parent.prong);
-			else
-				HFSM_BREAK();
-		}
+// Resume with a copy of the next 'TEvent' react()-ed by the task's state
+template <typename TEvent>
+HFSM_INLINE EventAwaiterT<TEvent> event()								{ return EventAwaiterT<TEvent>{};		}
 
-		for (; parent; parent = forkParent(parent.forkId)) {
-			if (parent.forkId > 0) {
-				compoRemains.set(parent.forkId - 1);
+////////////////////////////////////////////////////////////////////////////////
 
-				if (compoActive	  [parent.forkId - 1] != parent.prong)
-					compoRequested[parent.forkId - 1]  = parent.prong;
-				else {
-					parent = forkParent(parent.forkId);
-					break;
-				}
-			} else if (parent.forkId < 0)
-				requestedOrthoFork(parent.forkId).set(parent.prong);
-			else
-				HFSM_BREAK();
-		}
+namespace detail {
 
-		for (; parent; parent = forkParent(parent.forkId)) {
-			if (parent.forkId > 0)
-				compoRemains.set(parent.forkId - 1);
-			else if (parent.forkId < 0)
-				requestedOrthoFork(parent.forkId).set(parent.prong);
-			else
-				HFSM_BREAK();
-		}
-	}
+// Coroutine tasks of the machine's states, a single one per state
 
-	return true;
+template <LongIndex NArenaSize, LongIndex NStateCount>
+class CoroutinesT {
+	using Handle  = CoTask::Handle;
+	using Wait	  = CoTask::promise_type::Wait;
+
+public:
+	static constexpr LongIndex ARENA_SIZE  = NArenaSize;
+	static constexpr LongIndex STATE_COUNT = NStateCount;
+
+	static_assert(ARENA_SIZE > 0, "Set the arena size with ConfigT<>::CoroutineArenaN<>");
+
+	HFSM_INLINE CoroutinesT()											{ _arena.attach(_storage, ARENA_SIZE);	}
+	HFSM_INLINE ~CoroutinesT();
+
+	CoroutinesT(const CoroutinesT&) = delete;
+	CoroutinesT& operator = (const CoroutinesT&) = delete;
+
+	HFSM_INLINE		  CoroutineArena& arena()							{ return _arena;						}
+	HFSM_INLINE const CoroutineArena& arena() const						{ return _arena;						}
+
+	// Replaces the task of 'stateId' and runs it up to its first co_await
+	//  Returns false for a task which failed to allocate
+	HFSM_INLINE bool spawn(const StateID stateId, CoTask&& task);
+
+	// Resume the task of 'stateId' if it's waiting for ticks,
+	//  returns true once after it completes
+	HFSM_INLINE bool update(const StateID stateId);
+
+	// Resume the task of 'stateId' if it's waiting for 'TEvent',
+	//  returns true once after it completes
+	template <typename TEvent>
+	HFSM_INLINE bool react(const StateID stateId, const TEvent& event);
+
+	HFSM_INLINE void destroy(const StateID stateId);
+
+	HFSM_INLINE bool running(const StateID stateId) const;
+
+	// Any task waiting for ticks, or completed and not yet reported
+	HFSM_INLINE bool needsUpdate() const;
+
+private:
+	HFSM_INLINE bool report(const StateID stateId);
+
+private:
+	alignas(std::max_align_t) unsigned char _storage[ARENA_SIZE];
+	CoroutineArena _arena;
+	Handle _handles[STATE_COUNT];
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+namespace hfsm2 {
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, LongIndex NSB, LongIndex NTC>
+////////////////////////////////////////////////////////////////////////////////
+
+inline
 void
-RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, NSB, NTC>>::requestScheduled(const StateID stateId) {
-	if (HFSM_CHECKED(stateId < STATE_COUNT)) {
-		const Parent parent = stateParents[stateId];
+CoroutineArena::attach(void* const buffer,
+					   const size_t size)
+{
+	HFSM_ASSERT(reinterpret_cast<uintptr_t>(buffer) % ALIGNMENT == 0);
 
-		HFSM_ASSERT(parent.forkId != 0);
-		if (parent.forkId > 0)
-			compoResumable[parent.forkId - 1] = parent.prong;
-	}
+	_capacity = size - size % ALIGNMENT;
+	_used	  = 0;
+	_free	  = _capacity >= sizeof(Header) + ALIGNMENT ?
+					new (buffer) Block{_capacity, nullptr} : nullptr;
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, LongIndex NSB, LongIndex NTC>
-void
-RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, NSB, NTC>>::clearRequests() {
-	compoRequested.clear();
-	orthoRequested.clear();
-	compoRemains  .clear();
+inline
+void*
+CoroutineArena::allocate(const size_t size) {
+	const size_t required = (sizeof(Header) + size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+
+	for (Block** link = &_free; *link; link = &(*link)->next) {
+		Block* const block = *link;
+
+		if (block->size < required)
+			continue;
+
+		size_t taken = block->size;
+
+		// split, unless the rest can't hold a frame
+		if (block->size - required >= sizeof(Header) + ALIGNMENT) {
+			*link = new (reinterpret_cast<unsigned char*>(block) + required)
+						Block{block->size - required, block->next};
+			taken = required;
+		} else
+			*link = block->next;
+
+		_used += taken;
+
+		return new (block) Header{this, taken} + 1;
+	}
+
+	return nullptr;
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, LongIndex NSB, LongIndex NTC>
+inline
 void
-RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, NSB, NTC>>::reset() {
-	compoRequested.clear();
-	orthoRequested.clear();
-	compoActive	  .clear();
-	compoResumable.clear();
-	compoRemains  .clear();
+CoroutineArena::deallocate(void* const pointer) {
+	HFSM_ASSERT(pointer);
+
+	Header* const header = static_cast<Header*>(pointer) - 1;
+	header->arena->release(header);
 }
 
-////////////////////////////////////////////////////////////////////////////////
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NSB, LongIndex NTC>
-bool
-RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, NSB, NTC>>::isActive(const StateID stateId) const {
-	if (HFSM_CHECKED(stateId < STATE_COUNT)) {
-		if (Parent parent = stateParents[stateId]) {
-			HFSM_ASSERT(parent.forkId > 0);
+inline
+void
+CoroutineArena::release(Header* const header) {
+	const size_t size = header->size;
+	HFSM_ASSERT(_used >= size);
+	_used -= size;
 
-			return parent.prong == compoActive[parent.forkId - 1];
-		} else
-			return true;
-	}
+	Block* const block = new (header) Block{size, nullptr};
 
-	return false;
+	Block* prev = nullptr;
+	Block* next = _free;
+
+	for (; next && next < block; next = next->next)
+		prev = next;
+
+	if (next && reinterpret_cast<unsigned char*>(block) + block->size ==
+				reinterpret_cast<unsigned char*>(next))
+	{
+		block->size += next->size;
+		block->next  = next->next;
+	} else
+		block->next  = next;
+
+	if (prev && reinterpret_cast<unsigned char*>(prev) + prev->size ==
+				reinterpret_cast<unsigned char*>(block))
+	{
+		prev->size += block->size;
+		prev->next  = block->next;
+	} else if (prev)
+		prev->next = block;
+	else
+		_free = block;
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+////////////////////////////////////////////////////////////////////////////////
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NSB, LongIndex NTC>
-bool
-RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, NSB, NTC>>::isResumable(const StateID stateId) const {
-	if (HFSM_CHECKED(stateId < STATE_COUNT))
-		if (Parent parent = stateParents[stateId]) {
-			HFSM_ASSERT(parent.forkId > 0);
+template <typename... TArgs>
+void*
+CoTask::promise_type::operator new(const size_t size,
+								   TArgs&... args) noexcept
+{
+	static_assert((detail::CoroutineArenaSource<TArgs> || ...),
+				  "CoTask coroutines need a control argument to allocate from the machine's arena");
 
-			return parent.prong == compoResumable[parent.forkId - 1];
-		}
+	CoroutineArena* arena = nullptr;
 
-	return false;
+	([&] {
+		if constexpr (detail::CoroutineArenaSource<TArgs>)
+			if (!arena)
+				arena = &args.coroutineArena();
+	}(), ...);
+
+	return arena->allocate(size);
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NSB, LongIndex NTC>
-bool
-RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, NSB, NTC>>::isPendingChange(const StateID stateId) const {
-	if (HFSM_CHECKED(stateId < STATE_COUNT))
-		if (Parent parent = stateParents[stateId]) {
-			HFSM_ASSERT(parent.forkId > 0);
-
-			return compoRequested[parent.forkId - 1] !=
-				   compoActive	 [parent.forkId - 1];
-		}
+inline
+void
+TicksAwaiter::await_suspend(const CoTask::Handle handle) const noexcept {
+	CoTask::promise_type& promise = handle.promise();
 
-	return false;
+	promise.wait  = CoTask::promise_type::Wait::TICKS;
+	promise.ticks = ticks;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NSB, LongIndex NTC>
-bool
-RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, NSB, NTC>>::isPendingEnter(const StateID stateId) const {
-	if (HFSM_CHECKED(stateId < STATE_COUNT))
-		if (Parent parent = stateParents[stateId]) {
-			HFSM_ASSERT(parent.forkId > 0);
+template <typename TEvent>
+void
+EventAwaiterT<TEvent>::await_suspend(const CoTask::Handle handle) noexcept {
+	CoTask::promise_type& state = handle.promise();
 
-			return parent.prong != compoActive	 [parent.forkId - 1] &&
-				   parent.prong == compoRequested[parent.forkId - 1];
-		}
+	state.wait		= CoTask::promise_type::Wait::EVENT;
+	state.eventType = &detail::TypeTagT<TEvent>::TAG;
+	state.event		= nullptr;
 
-	return false;
+	promise = &state;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NSB, LongIndex NTC>
-bool
-RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, NSB, NTC>>::isPendingExit(const StateID stateId) const {
-	if (HFSM_CHECKED(stateId < STATE_COUNT))
-		if (Parent parent = stateParents[stateId]) {
-			HFSM_ASSERT(parent.forkId > 0);
-
-			return parent.prong == compoActive	 [parent.forkId - 1] &&
-				   parent.prong != compoRequested[parent.forkId - 1];
-		}
+template <typename TEvent>
+TEvent
+EventAwaiterT<TEvent>::await_resume() const {
+	HFSM_ASSERT(promise && promise->event);
 
-	return false;
+	return *static_cast<const TEvent*>(promise->event);
 }
 
-//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NSB, LongIndex NTC>
-const Parent&
-RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, NSB, NTC>>::forkParent(const ForkID forkId) const {
-	HFSM_ASSERT(forkId > 0);
+namespace detail {
 
-	return compoParents[forkId - 1];
+template <LongIndex NA, LongIndex NS>
+CoroutinesT<NA, NS>::~CoroutinesT() {
+	for (Handle& handle : _handles)
+		if (handle)
+			handle.destroy();
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NSB, LongIndex NTC>
+template <LongIndex NA, LongIndex NS>
 bool
-RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, NSB, NTC>>::requestImmediate(const Request request) {
-	if (request.stateId == 0)
+CoroutinesT<NA, NS>::spawn(const StateID stateId,
+						   CoTask&& task)
+{
+	HFSM_ASSERT(stateId < STATE_COUNT);
+
+	destroy(stateId);
+
+	if (!task)
 		return false;
-	else if (HFSM_CHECKED(request.stateId < STATE_COUNT)) {
-		Parent parent = stateParents[request.stateId];
 
-		if (HFSM_CHECKED(parent)) {
-			HFSM_ASSERT(parent.forkId > 0);
+	Handle& handle = _handles[stateId];
+	handle = task._handle;
+	task._handle = nullptr;
 
-			compoRequested[parent.forkId - 1] = parent.prong;
+	handle.resume();
 
-			for (parent = forkParent(parent.forkId);
-				 parent;
-				 parent = forkParent(parent.forkId))
-			{
-				HFSM_ASSERT(parent.forkId > 0);
-				compoRemains.set(parent.forkId - 1);
+	return true;
+}
 
-				if (compoActive	  [parent.forkId - 1] != parent.prong)
-					compoRequested[parent.forkId - 1]  = parent.prong;
-				else {
-					parent = forkParent(parent.forkId);
-					break;
-				}
-			}
+//------------------------------------------------------------------------------
 
-			for (; parent; parent = forkParent(parent.forkId)) {
-				HFSM_ASSERT(parent.forkId > 0);
-				compoRemains.set(parent.forkId - 1);
-			}
-		}
+template <LongIndex NA, LongIndex NS>
+bool
+CoroutinesT<NA, NS>::update(const StateID stateId) {
+	HFSM_ASSERT(stateId < STATE_COUNT);
+
+	const Handle handle = _handles[stateId];
+
+	if (!handle)
+		return false;
+
+	CoTask::promise_type& promise = handle.promise();
+
+	if (!handle.done() &&
+		promise.wait == Wait::TICKS &&
+		--promise.ticks == 0)
+	{
+		promise.wait = Wait::NONE;
+		handle.resume();
 	}
 
-	return true;
+	return report(stateId);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NSB, LongIndex NTC>
-void
-RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, NSB, NTC>>::requestScheduled(const StateID stateId) {
-	if (HFSM_CHECKED(stateId < STATE_COUNT)) {
-		const Parent parent = stateParents[stateId];
+template <LongIndex NA, LongIndex NS>
+template <typename TEvent>
+bool
+CoroutinesT<NA, NS>::react(const StateID stateId,
+						   const TEvent& event)
+{
+	HFSM_ASSERT(stateId < STATE_COUNT);
 
-		HFSM_ASSERT(parent.forkId > 0);
-		compoResumable[parent.forkId - 1] = parent.prong;
+	const Handle handle = _handles[stateId];
+
+	if (!handle)
+		return false;
+
+	CoTask::promise_type& promise = handle.promise();
+
+	if (!handle.done() &&
+		promise.wait == Wait::EVENT &&
+		promise.eventType == &TypeTagT<TEvent>::TAG)
+	{
+		promise.wait  = Wait::NONE;
+		promise.event = &event;
+		handle.resume();
 	}
+
+	return report(stateId);
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NSB, LongIndex NTC>
+template <LongIndex NA, LongIndex NS>
 void
-RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, NSB, NTC>>::clearRequests() {
-	compoRequested.clear();
-	orthoRequested.clear();
-	compoRemains  .clear();
-}
+CoroutinesT<NA, NS>::destroy(const StateID stateId) {
+	HFSM_ASSERT(stateId < STATE_COUNT);
 
-//------------------------------------------------------------------------------
+	Handle& handle = _handles[stateId];
 
-template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NSB, LongIndex NTC>
-void
-RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, NSB, NTC>>::reset() {
-	compoRequested.clear();
-	orthoRequested.clear();
-	compoActive	  .clear();
-	compoResumable.clear();
-	compoRemains  .clear();
+	if (handle) {
+		handle.destroy();
+		handle = nullptr;
+	}
 }
 
-////////////////////////////////////////////////////////////////////////////////
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-}
+template <LongIndex NA, LongIndex NS>
+bool
+CoroutinesT<NA, NS>::running(const StateID stateId) const {
+	HFSM_ASSERT(stateId < STATE_COUNT);
+
+	const Handle handle = _handles[stateId];
+
+	return handle && !handle.done();
 }
 
-namespace hfsm2 {
-namespace detail {
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-////////////////////////////////////////////////////////////////////////////////
+template <LongIndex NA, LongIndex NS>
+bool
+CoroutinesT<NA, NS>::needsUpdate() const {
+	for (const Handle& handle : _handles)
+		if (handle) {
+			const CoTask::promise_type& promise = handle.promise();
+
+			if (handle.done() ?
+					!promise.reported :
+					promise.wait == Wait::TICKS)
+				return true;
+		}
 
-template <typename TArgs>
-class ControlT {
-	template <typename, typename, typename>
-	friend struct S_;
+	return false;
+}
 
-	template <typename, typename, Strategy, typename, typename...>
-	friend struct C_;
+//------------------------------------------------------------------------------
 
-	template <typename, typename, typename, typename...>
-	friend struct O_;
+template <LongIndex NA, LongIndex NS>
+bool
+CoroutinesT<NA, NS>::report(const StateID stateId) {
+	const Handle handle = _handles[stateId];
+	CoTask::promise_type& promise = handle.promise();
 
-	template <typename, typename>
-	friend class R_;
+	if (!handle.done() || promise.reported)
+		return false;
 
-	using Args			= TArgs;
+	promise.reported = true;
 
-protected:
-	using Context		= typename Args::Context;
-	using RNG			= typename Args::RNG;
-	using Logger		= typename Args::Logger;
-	using StateList		= typename Args::StateList;
-	using RegionList	= typename Args::RegionList;
+	return true;
+}
 
-	using Registry		= RegistryT<Args>;
-	using PlanData		= PlanDataT<Args>;
-	using ConstPlan		= ConstPlanT<Args>;
+////////////////////////////////////////////////////////////////////////////////
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+}
+}
 
-	struct Region {
-		HFSM_INLINE Region(ControlT& control,
-						   const RegionID id);
+#endif
 
-		HFSM_INLINE ~Region();
+#ifdef HFSM_ENABLE_STATIC_PLANS
 
-		ControlT& control;
-		const RegionID prevId;
-	};
+namespace hfsm2 {
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+////////////////////////////////////////////////////////////////////////////////
 
-	HFSM_INLINE ControlT(Context& context,
-						 RNG& rng,
-						 Registry& registry,
-						 PlanData& planData,
-						 Logger* const HFSM_IF_LOGGER(logger))
-		: _context{context}
-		, _rng{rng}
-		, _registry{registry}
-		, _planData{planData}
-		HFSM_IF_LOGGER(, _logger{logger})
-	{}
+// Plan tasks declared as types, see PlanT::apply<>()
 
+template <typename TOrigin, typename TDestination>
+struct Change {
+	using Origin	  = TOrigin;
+	using Destination = TDestination;
 
-	HFSM_INLINE void setRegion(const RegionID id);
-	HFSM_INLINE void resetRegion(const RegionID id);
+	static constexpr TransitionType TYPE = TransitionType::CHANGE;
+};
 
-public:
-	template <typename T>
-	static constexpr StateID  stateId()					{ return			StateList ::template index<T>();	}
+template <typename TOrigin, typename TDestination>
+struct Restart {
+	using Origin	  = TOrigin;
+	using Destination = TDestination;
 
-	template <typename T>
-	static constexpr RegionID regionId()				{ return (RegionID) RegionList::template index<T>();	}
+	static constexpr TransitionType TYPE = TransitionType::RESTART;
+};
 
-	HFSM_INLINE Context& _()								{ return _context;									}
-	HFSM_INLINE Context& context()							{ return _context;									}
+template <typename TOrigin, typename TDestination>
+struct Resume {
+	using Origin	  = TOrigin;
+	using Destination = TDestination;
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	static constexpr TransitionType TYPE = TransitionType::RESUME;
+};
 
-	HFSM_INLINE bool isActive   (const StateID id) const	{ return _registry.isActive   (id);					}
-	HFSM_INLINE bool isResumable(const StateID id) const	{ return _registry.isResumable(id);					}
+template <typename TOrigin, typename TDestination>
+struct Utilize {
+	using Origin	  = TOrigin;
+	using Destination = TDestination;
 
-	HFSM_INLINE bool isScheduled(const StateID id) const	{ return isResumable(id);							}
+	static constexpr TransitionType TYPE = TransitionType::UTILIZE;
+};
 
-	template <typename TState>
-	HFSM_INLINE bool isActive() const						{ return isActive	(stateId<TState>());			}
+template <typename TOrigin, typename TDestination>
+struct Randomize {
+	using Origin	  = TOrigin;
+	using Destination = TDestination;
 
-	template <typename TState>
-	HFSM_INLINE bool isResumable() const					{ return isResumable(stateId<TState>());			}
+	static constexpr TransitionType TYPE = TransitionType::RANDOMIZE;
+};
 
-	template <typename TState>
-	HFSM_INLINE bool isScheduled() const					{ return isResumable(stateId<TState>());			}
+template <typename TOrigin, typename TDestination>
+struct Schedule {
+	using Origin	  = TOrigin;
+	using Destination = TDestination;
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	static constexpr TransitionType TYPE = TransitionType::SCHEDULE;
+};
 
-	HFSM_INLINE ConstPlan plan() const						{ return ConstPlan{_planData, _regionId};			}
-	HFSM_INLINE ConstPlan plan(const RegionID id) const		{ return ConstPlan{_planData, id};					}
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	template <typename TRegion>
-	HFSM_INLINE ConstPlan plan()							{ return ConstPlan{_planData, regionId<TRegion>()};	}
+template <typename... TTasks>
+struct PlanTemplate {
+	static_assert(sizeof...(TTasks) > 0, "Empty plan template");
+};
 
-	template <typename TRegion>
-	HFSM_INLINE ConstPlan plan() const						{ return ConstPlan{_planData, regionId<TRegion>()};	}
+namespace detail {
 
-protected:
-#if defined HFSM_ENABLE_LOG_INTERFACE || defined HFSM_ENABLE_VERBOSE_DEBUG_LOG
-	HFSM_INLINE Logger* logger()							{ return _logger;									}
-#endif
+////////////////////////////////////////////////////////////////////////////////
 
-protected:
-	Context& _context;
-	RNG& _rng;
-	Registry& _registry;
-	PlanData& _planData;
-	RegionID _regionId = 0;
-	HFSM_IF_LOGGER(Logger* _logger);
+struct StaticTask {
+	TransitionType type;
+	StateID origin;
+	StateID destination;
 };
 
 //------------------------------------------------------------------------------
 
-template <typename TArgs>
-class PlanControlT
-	: public ControlT<TArgs>
-{
-	template <typename, typename, typename>
-	friend struct S_;
+// Read-only task table of a plan template, one per machine state list
+//  and shared by every instance
 
-	template <typename, typename, Strategy, typename, typename...>
-	friend struct C_;
+template <typename, typename>
+struct StaticPlanT;
 
-	template <typename, typename, typename, typename...>
-	friend struct O_;
+template <typename TStateList, typename... TTasks>
+struct StaticPlanT<TStateList, PlanTemplate<TTasks...>> {
+	static constexpr LongIndex COUNT = sizeof...(TTasks);
 
-	template <typename, typename>
-	friend class R_;
+	static const StaticTask TASKS[COUNT];
+};
 
-	using Args			= TArgs;
+template <typename TStateList, typename... TTasks>
+const StaticTask StaticPlanT<TStateList, PlanTemplate<TTasks...>>::TASKS[COUNT] = {
+	StaticTask{TTasks::TYPE,
+			   (StateID) TStateList::template index<typename TTasks::Origin>(),
+			   (StateID) TStateList::template index<typename TTasks::Destination>()}...
+};
 
-protected:
-	using Control		= ControlT<Args>;
+//------------------------------------------------------------------------------
 
-	using typename Control::StateList;
-	using typename Control::RegionList;
-	using typename Control::PlanData;
-	using typename Control::ConstPlan;
+// Per-region reference to the applied plan template and the progress through it
 
-	using Plan			= PlanT<Args>;
+template <LongIndex NRegionCount>
+struct StaticPlansT {
+	struct Entry {
+		const StaticTask* tasks = nullptr;
+		uint16_t count	= 0;
+		uint16_t cursor	= 0;
+	};
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	HFSM_INLINE bool active(const RegionID regionId) const		{ return entries[regionId].tasks != nullptr;		}
 
-	struct Origin {
-		HFSM_INLINE Origin(PlanControlT& control_,
-						   const StateID id);
+	HFSM_INLINE void clear(const RegionID regionId)				{ entries[regionId] = Entry{};					}
 
-		HFSM_INLINE ~Origin();
+	Entry entries[NRegionCount];
+};
 
-		PlanControlT& control;
-		const StateID prevId;
-	};
+////////////////////////////////////////////////////////////////////////////////
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+}
+}
 
-	struct Region {
-		HFSM_INLINE Region(PlanControlT& control,
-						   const RegionID id,
-						   const StateID index,
-						   const LongIndex size);
+#endif
+namespace hfsm2 {
+namespace detail {
 
-		HFSM_INLINE ~Region();
+////////////////////////////////////////////////////////////////////////////////
 
-		PlanControlT& control;
-		const RegionID prevId;
-		const LongIndex prevIndex;
-		const LongIndex prevSize;
-	};
+#pragma pack(push, 2)
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+struct TaskLink {
+	HFSM_INLINE TaskLink(const TransitionType transitionType_,
+						 const StateID origin_,
+						 const StateID destination_)
+		: transitionType{transitionType_}
+		, origin{origin_}
+		, destination{destination_}
+		, next{INVALID_LONG_INDEX}
+	{}
 
-	using Control::Control;
+	TransitionType transitionType;
+	StateID origin		= INVALID_STATE_ID;
+	StateID destination	= INVALID_STATE_ID;
 
-	HFSM_INLINE void setOrigin  (const StateID id);
-	HFSM_INLINE void resetOrigin(const StateID id);
+	LongIndex prev		= INVALID_LONG_INDEX;
+	LongIndex next		= INVALID_LONG_INDEX;
+};
 
-	HFSM_INLINE void setRegion  (const RegionID id, const StateID index, const LongIndex size);
-	HFSM_INLINE void resetRegion(const RegionID id, const StateID index, const LongIndex size);
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-public:
-	using Control::stateId;
-	using Control::regionId;
+struct Bounds {
+	LongIndex first		= INVALID_LONG_INDEX;
+	LongIndex last		= INVALID_LONG_INDEX;
+};
 
-	using Control::_;
-	using Control::context;
+#pragma pack(pop)
 
-	using Control::isActive;
-	using Control::isResumable;
-	using Control::isScheduled;
+//------------------------------------------------------------------------------
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+#ifdef HFSM_ENABLE_UPDATE_PERIODS
 
-	HFSM_INLINE		 Plan plan()							{ return	  Plan{_planData, _regionId};			}
-	HFSM_INLINE ConstPlan plan() const						{ return ConstPlan{_planData, _regionId};			}
+// Per-region update() rate divisors
+//  A region with period N is updated on every N-th update() while it's active
 
-	HFSM_INLINE		 Plan plan(const RegionID id)			{ return	  Plan{_planData, id};					}
-	HFSM_INLINE ConstPlan plan(const RegionID id) const		{ return ConstPlan{_planData, id};					}
+template <LongIndex NRegionCount>
+struct UpdatePeriodsT {
+	struct Entry {
+		uint16_t period	   = 1;
+		uint16_t countdown = 1;
+	};
 
-	template <typename TRegion>
-	HFSM_INLINE		 Plan plan()		{ return	  Plan{_planData, Control::template regionId<TRegion>()};	}
+	HFSM_INLINE void set(const RegionID regionId,
+						 const uint16_t period,
+						 const uint16_t phase)
+	{
+		HFSM_ASSERT(regionId < NRegionCount);
 
-	template <typename TRegion>
-	HFSM_INLINE ConstPlan plan() const	{ return ConstPlan{_planData, Control::template regionId<TRegion>()};	}
+		Entry& entry = entries[regionId];
+		entry.period	= period ? period : 1;
+		entry.countdown = (uint16_t) (phase % entry.period + 1);
+	}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	HFSM_INLINE bool isDue(const RegionID regionId) {
+		Entry& entry = entries[regionId];
 
-protected:
-	using Control::_planData;
-	using Control::_regionId;
-	HFSM_IF_LOGGER(using Control::_logger);
+		if (--entry.countdown)
+			return false;
 
-	StateID _originId = 0;
-	StateID _regionIndex = 0;
-	LongIndex _regionSize = StateList::SIZE;
-	Status _status;
+		entry.countdown = entry.period;
+
+		return true;
+	}
+
+	Entry entries[NRegionCount];
 };
 
+#endif
+
 //------------------------------------------------------------------------------
 
-template <typename TArgs>
-class FullControlT
-	: public PlanControlT<TArgs>
-{
-	template <typename, typename, typename>
-	friend struct S_;
+#ifdef HFSM_ENABLE_PLAN_QUOTAS
 
-	template <typename, typename, Strategy, typename, typename...>
-	friend struct C_;
+// Task link usage of a single region
+//  quota		- Links reserved for the region and the most it may hold at once,
+//				  INVALID_LONG_INDEX if unlimited
+//  count		- Links currently held
+//  highWater	- Largest 'count' seen since the last reset
+//  overflows	- Appends refused, either over the quota or with the shared list full
 
-	template <typename, typename, typename, typename...>
-	friend struct O_;
+struct PlanUsage {
+	LongIndex quota		= INVALID_LONG_INDEX;
+	LongIndex count		= 0;
+	LongIndex highWater	= 0;
+	LongIndex overflows	= 0;
+};
 
-	template <typename, typename>
-	friend class R_;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	using Args			= TArgs;
+// Per-region task link quotas over the shared TaskLinks list
+//  Quotas are reserved: regions without one share what's left of the list
+//  after every quota, so they can't eat into a capped region's links
 
-protected:
-	using PlanControl	= PlanControlT<Args>;
+template <LongIndex NRegionCount, LongIndex NTaskCapacity>
+struct PlanQuotasT {
+	static constexpr LongIndex TASK_CAPACITY = NTaskCapacity;
 
-	using typename PlanControl::Context;
-	using typename PlanControl::RNG;
-	using typename PlanControl::Logger;
-	using typename PlanControl::StateList;
-	using typename PlanControl::RegionList;
-	using typename PlanControl::PlanData;
+	HFSM_INLINE void setQuota(const RegionID regionId,
+							  const LongIndex quota)
+	{
+		HFSM_ASSERT(regionId < NRegionCount);
 
-	using typename PlanControl::Plan;
-	using typename PlanControl::Origin;
+		PlanUsage& usage = regions[regionId];
 
-	using Registry		= RegistryT<Args>;
-	using Requests		= RequestsT<Args::COMPO_REGIONS>;
+		if (usage.quota != INVALID_LONG_INDEX) {
+			reserved	-= usage.quota;
+			cappedCount -= usage.count;
+		}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+		usage.quota = quota;
 
-	struct Lock {
-		HFSM_INLINE Lock(FullControlT& control_);
-		HFSM_INLINE ~Lock();
-
-		FullControlT* const control;
-	};
-
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-
-	HFSM_INLINE FullControlT(Context& context,
-							 RNG& rng,
-							 Registry& registry,
-							 PlanData& planData,
-							 Requests& requests,
-							 Logger* const logger)
-		: PlanControl{context, rng, registry, planData, logger}
-		, _requests{requests}
-	{}
-
-	template <typename TState>
-	Status updatePlan(TState& headState, const Status subStatus);
-
-	template <typename TState>
-	Status buildPlanStatus();
-
-public:
-	using PlanControl::stateId;
-	using PlanControl::regionId;
+		if (usage.quota != INVALID_LONG_INDEX) {
+			reserved	+= usage.quota;
+			cappedCount += usage.count;
+		}
 
-	using PlanControl::_;
-	using PlanControl::context;
+		// quotas can't reserve more links than the list holds
+		HFSM_ASSERT(reserved <= TASK_CAPACITY);
+	}
 
-	using PlanControl::isActive;
-	using PlanControl::isResumable;
-	using PlanControl::isScheduled;
+	HFSM_INLINE bool acquire(const RegionID regionId) {
+		PlanUsage& usage = regions[regionId];
 
-	using PlanControl::plan;
+		const bool capped = usage.quota != INVALID_LONG_INDEX;
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+		if (capped ?
+				usage.count >= usage.quota :
+				count - cappedCount + reserved >= TASK_CAPACITY)
+		{
+			++usage.overflows;
 
-	HFSM_INLINE void changeTo (const StateID id);
-	HFSM_INLINE void restart  (const StateID id);
-	HFSM_INLINE void resume	  (const StateID id);
-	HFSM_INLINE void utilize  (const StateID id);
-	HFSM_INLINE void randomize(const StateID id);
-	HFSM_INLINE void schedule (const StateID id);
+			return false;
+		}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-	// Clang trips over 'stateId<>()', so give it a hint it comes from ControlT<>
+		if (usage.highWater < ++usage.count)
+			usage.highWater = usage.count;
 
-	template <typename T>
-	HFSM_INLINE void changeTo ()							{ changeTo (PlanControl::template stateId<T>());	}
+		if (capped)
+			++cappedCount;
 
-	template <typename T>
-	HFSM_INLINE void restart  ()							{ restart  (PlanControl::template stateId<T>());	}
+		if (highWater < ++count)
+			highWater = count;
 
-	template <typename T>
-	HFSM_INLINE void resume   ()							{ resume   (PlanControl::template stateId<T>());	}
+		return true;
+	}
 
-	template <typename T>
-	HFSM_INLINE void utilize  ()							{ utilize  (PlanControl::template stateId<T>());	}
+	HFSM_INLINE void release(const RegionID regionId) {
+		PlanUsage& usage = regions[regionId];
+		HFSM_ASSERT(usage.count && count);
 
-	template <typename T>
-	HFSM_INLINE void randomize()							{ randomize(PlanControl::template stateId<T>());	}
+		--usage.count;
+		--count;
 
-	template <typename T>
-	HFSM_INLINE void schedule ()							{ schedule (PlanControl::template stateId<T>());	}
+		if (usage.quota != INVALID_LONG_INDEX)
+			--cappedCount;
+	}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	// The shared list turned out to be full after acquire()
+	HFSM_INLINE void refuse(const RegionID regionId) {
+		release(regionId);
 
-	HFSM_INLINE void succeed();
-	HFSM_INLINE void fail();
+		++regions[regionId].overflows;
+	}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	HFSM_INLINE void resetHighWater() {
+		for (LongIndex i = 0; i < NRegionCount; ++i)
+			regions[i].highWater = regions[i].count;
 
-protected:
-	using PlanControl::_planData;
-	using PlanControl::_regionId;
-	HFSM_IF_LOGGER(using PlanControl::_logger);
+		highWater = count;
+	}
 
-	using PlanControl::_originId;
-	using PlanControl::_regionIndex;
-	using PlanControl::_regionSize;
-	using PlanControl::_status;
+	PlanUsage regions[NRegionCount];
 
-	Requests& _requests;
-	bool _locked = false;
+	LongIndex count		  = 0;
+	LongIndex highWater	  = 0;
+	LongIndex reserved	  = 0;		// sum of the quotas
+	LongIndex cappedCount = 0;		// links held by regions with a quota
 };
 
-//------------------------------------------------------------------------------
+#endif
 
-template <typename TArgs>
-class GuardControlT final
-	: public FullControlT<TArgs>
-{
-	template <typename, typename, typename>
-	friend struct S_;
+//------------------------------------------------------------------------------
 
-	template <typename, typename>
-	friend class R_;
+#if defined HFSM_ENABLE_STRUCTURE_REPORT || defined HFSM_ENABLE_POOL_INDEX
 
-	using Args			= TArgs;
-	using FullControl	= FullControlT<Args>;
+// States entered or exited since the list was last cleared, each listed once
 
-	using typename FullControl::Context;
-	using typename FullControl::RNG;
-	using typename FullControl::Logger;
-	using typename FullControl::StateList;
-	using typename FullControl::RegionList;
-	using typename FullControl::PlanData;
+template <LongIndex NStateCount>
+struct ActivityChangesT {
+	HFSM_INLINE void mark(const StateID stateId) {
+		if (!marked.get(stateId)) {
+			marked.set(stateId);
+			states.append(stateId);
+		}
+	}
 
-	using typename FullControl::Registry;
+	HFSM_INLINE void clear() {
+		for (LongIndex i = 0; i < states.count(); ++i)
+			marked.reset(states[i]);
 
-protected:
-	using Requests		= RequestsT<Args::COMPO_REGIONS>;
+		states.clear();
+	}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	BitArray<StateID, NStateCount> marked;
+	Array<StateID, NStateCount> states;
+};
 
-private:
-	HFSM_INLINE GuardControlT(Context& context,
-							  RNG& rng,
-							  Registry& registry,
-							  PlanData& planData,
-							  Requests& requests,
-							  const Requests& pendingChanges,
-							  Logger* const logger)
-		: FullControl{context, rng, registry, planData, requests, logger}
-		, _pending{pendingChanges}
-	{}
+#endif
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//------------------------------------------------------------------------------
 
-public:
-	using FullControl::stateId;
-	using FullControl::regionId;
+template <typename,
+		  typename,
+		  typename,
+		  typename,
+		  LongIndex,
+		  LongIndex,
+		  LongIndex,
+		  LongIndex,
+		  LongIndex>
+struct ArgsT;
 
-	using FullControl::_;
-	using FullControl::context;
+template <typename>
+struct PlanDataT;
 
-	using FullControl::isActive;
-	using FullControl::isResumable;
-	using FullControl::isScheduled;
+//------------------------------------------------------------------------------
 
-	using FullControl::plan;
+template <typename TContext,
+		  typename TConfig,
+		  typename TStateList,
+		  typename TRegionList,
+		  LongIndex NCompoCount,
+		  LongIndex NOrthoCount,
+		  LongIndex NOrthoUnits,
+		  LongIndex NSerialBits,
+		  LongIndex NTaskCapacity>
+struct PlanDataT<ArgsT<TContext,
+					   TConfig,
+					   TStateList,
+					   TRegionList,
+					   NCompoCount,
+					   NOrthoCount,
+					   NOrthoUnits,
+					   NSerialBits,
+					   NTaskCapacity>>
+{
+	using StateList		= TStateList;
+	using RegionList	= TRegionList;
 
-	using FullControl::changeTo;
-	using FullControl::restart;
-	using FullControl::resume;
-	using FullControl::utilize;
-	using FullControl::randomize;
-	using FullControl::schedule;
-	using FullControl::succeed;
-	using FullControl::fail;
+	static constexpr ShortIndex REGION_COUNT  = RegionList::SIZE;
+	static constexpr ShortIndex TASK_CAPACITY = NTaskCapacity;
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	using TaskLinks		= List<TaskLink, TASK_CAPACITY>;
+	using TasksBounds	= Array<Bounds, RegionList::SIZE>;
+	using TasksBits		= BitArray<StateID, StateList::SIZE>;
+	using RegionBits	= BitArray<RegionID, RegionList::SIZE>;
 
-	HFSM_INLINE bool isPendingChange(const StateID id) const	{ return _registry.isPendingChange(id);	}
-	HFSM_INLINE bool isPendingEnter	(const StateID id) const	{ return _registry.isPendingEnter (id);	}
-	HFSM_INLINE bool isPendingExit	(const StateID id) const	{ return _registry.isPendingExit  (id);	}
+	TaskLinks taskLinks;
+	TasksBounds tasksBounds;
+	TasksBits tasksSuccesses;
+	TasksBits tasksFailures;
+	RegionBits planExists;
 
-	template <typename TState>
-	HFSM_INLINE bool isPendingChange()		{ return isPendingChange(FullControl::template stateId<TState>());	}
+	HFSM_IF_STATIC_PLANS(StaticPlansT<REGION_COUNT> staticPlans);
+	HFSM_IF_PLAN_QUOTAS(PlanQuotasT<REGION_COUNT, TASK_CAPACITY> planQuotas);
+	HFSM_IF_UPDATE_PERIODS(UpdatePeriodsT<REGION_COUNT> updatePeriods);
+	HFSM_IF_PAYLOADS(PayloadsT<TConfig::PAYLOAD_SIZE, REGION_COUNT * 2> payloads);
+	HFSM_IF_STRUCTURE(ActivityChangesT<StateList::SIZE> activityChanges);
+	HFSM_IF_POOL_INDEX(ActivityChangesT<StateList::SIZE> indexChanges);		// consumed by PoolT's state index
+	HFSM_IF_COROUTINES(CoroutinesT<TConfig::COROUTINE_ARENA_SIZE, StateList::SIZE> coroutines);
 
-	template <typename TState>
-	HFSM_INLINE bool isPendingEnter()		{ return isPendingEnter (FullControl::template stateId<TState>());	}
+	HFSM_IF_PARALLEL(ExecutorInterface* executor = nullptr);
+	HFSM_IF_PARALLEL(HFSM_IF_ASSERT(bool forked = false));		// ParallelOrthogonal<> sub-states are running
 
-	template <typename TState>
-	HFSM_INLINE bool isPendingExit()		{ return isPendingExit  (FullControl::template stateId<TState>());	}
+	// Any region holding tasks not yet completed
+	HFSM_INLINE bool hasPlans() const;
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+#ifdef HFSM_ENABLE_ASSERT
+	void verifyPlans() const;
+	LongIndex verifyPlan(const RegionID stateId) const;
+#endif
+};
 
-	HFSM_INLINE void cancelPendingTransitions();
+//------------------------------------------------------------------------------
 
-	HFSM_INLINE const Requests& pendingTransitions() const		{ return _pending;								}
+template <typename TContext,
+		  typename TConfig,
+		  typename TStateList,
+		  typename TRegionList,
+		  LongIndex NOrthoCount,
+		  LongIndex NOrthoUnits,
+		  LongIndex NTaskCapacity>
+struct PlanDataT<ArgsT<TContext,
+					   TConfig,
+					   TStateList,
+					   TRegionList,
+					   0,
+					   NOrthoCount,
+					   NOrthoUnits,
+					   0,
+					   NTaskCapacity>>
+{
+	HFSM_IF_UPDATE_PERIODS(UpdatePeriodsT<TRegionList::SIZE> updatePeriods);
+	HFSM_IF_PAYLOADS(PayloadsT<TConfig::PAYLOAD_SIZE, TRegionList::SIZE * 2> payloads);
+	HFSM_IF_STRUCTURE(ActivityChangesT<TStateList::SIZE> activityChanges);
+	HFSM_IF_POOL_INDEX(ActivityChangesT<TStateList::SIZE> indexChanges);
+	HFSM_IF_COROUTINES(CoroutinesT<TConfig::COROUTINE_ARENA_SIZE, TStateList::SIZE> coroutines);
 
-private:
-	HFSM_IF_LOGGER(using FullControl::_logger);
+	HFSM_IF_PARALLEL(ExecutorInterface* executor = nullptr);
+	HFSM_IF_PARALLEL(HFSM_IF_ASSERT(bool forked = false));
 
-	using FullControl::_registry;
-	using FullControl::_originId;
+	HFSM_INLINE bool hasPlans() const							{ return false;							}
 
-	bool _cancelled = false;
-	const Requests& _pending;
+#ifdef HFSM_ENABLE_ASSERT
+	void verifyPlans() const													{}
+	LongIndex verifyPlan(const RegionID) const					{ return 0;		}
+#endif
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -4077,1991 +4722,8095 @@ namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename TArgs>
-ControlT<TArgs>::Region::Region(ControlT& control_,
-								const RegionID id)
-	: control{control_}
-	, prevId{control._regionId}
-{
-	control.setRegion(id);
-}
+// 'planExists' stays set after a plan completes, check the tasks themselves
 
-//------------------------------------------------------------------------------
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, LongIndex NSB, LongIndex NTC>
+bool
+PlanDataT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, NSB, NTC>>::hasPlans() const {
+	if (taskLinks.count())
+		return true;
 
-template <typename TArgs>
-ControlT<TArgs>::Region::~Region() {
-	control.resetRegion(prevId);
+#ifdef HFSM_ENABLE_STATIC_PLANS
+	for (RegionID id = 0; id < REGION_COUNT; ++id)
+		if (staticPlans.active(id))
+			return true;
+#endif
+
+	return false;
 }
 
-////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
 
-template <typename TArgs>
+#ifdef HFSM_ENABLE_ASSERT
+
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, LongIndex NSB, LongIndex NTC>
 void
-ControlT<TArgs>::setRegion(const RegionID id) {
-	HFSM_ASSERT(_regionId <= id && id < RegionList::SIZE);
+PlanDataT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, NSB, NTC>>::verifyPlans() const {
+	LongIndex planCount = 0;
+	for (RegionID id = 0; id < REGION_COUNT; ++id)
+		planCount += verifyPlan(id);
 
-	_regionId = id;
+	HFSM_ASSERT(taskLinks.count() == planCount);
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TArgs>
-void
-ControlT<TArgs>::resetRegion(const RegionID id) { //-V524
-	HFSM_ASSERT(id <= _regionId && _regionId < RegionList::SIZE);
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, LongIndex NSB, LongIndex NTC>
+LongIndex
+PlanDataT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, NSB, NTC>>::verifyPlan(const RegionID regionId) const {
+	LongIndex length = 0;
+	const Bounds& bounds = tasksBounds[regionId];
 
-	_regionId = id;
-}
+	if (bounds.first != INVALID_LONG_INDEX) {
+		HFSM_ASSERT(bounds.last != INVALID_LONG_INDEX);
 
-////////////////////////////////////////////////////////////////////////////////
+		for (auto slow = bounds.first, fast = slow; ; ) {
+			++length;
+			const TaskLink& task = taskLinks[slow];
 
-template <typename TArgs>
-PlanControlT<TArgs>::Origin::Origin(PlanControlT& control_,
-									const StateID id)
-	: control{control_}
-	, prevId{control._originId}
-{
-	control.setOrigin(id);
-}
+			if (slow != bounds.last) {
+				HFSM_ASSERT(task.next != INVALID_LONG_INDEX);
+				slow = task.next;
 
-//------------------------------------------------------------------------------
+				// loop check
+				if (fast != INVALID_LONG_INDEX) {
+					fast = taskLinks[fast].next;
 
-template <typename TArgs>
-PlanControlT<TArgs>::Origin::~Origin() {
-	control.resetOrigin(prevId);
-}
+					if (fast != INVALID_LONG_INDEX) {
+						fast = taskLinks[fast].next;
+					}
 
-////////////////////////////////////////////////////////////////////////////////
+					HFSM_ASSERT(fast == INVALID_LONG_INDEX || slow != fast);
+				}
+			} else {
+				HFSM_ASSERT(task.next == INVALID_LONG_INDEX);
 
-template <typename TArgs>
-PlanControlT<TArgs>::Region::Region(PlanControlT& control_,
-									const RegionID id,
-									const StateID index,
-									const LongIndex size)
-	: control{control_}
-	, prevId{control._regionId}
-	, prevIndex{control._regionIndex}
-	, prevSize{control._regionSize}
-{
-	control.setRegion(id, index, size);
+				break;
+			}
+		};
+	} else
+		HFSM_ASSERT(bounds.last == INVALID_LONG_INDEX);
+
+	return length;
 }
 
-//------------------------------------------------------------------------------
+#endif
 
-template <typename TArgs>
-PlanControlT<TArgs>::Region::~Region() {
-	control.resetRegion(prevId, prevIndex, prevSize);
+////////////////////////////////////////////////////////////////////////////////
 
-	control._status.clear();
 }
+}
+namespace hfsm2 {
+namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename TArgs>
-void
-PlanControlT<TArgs>::setOrigin(const StateID id) {
-	HFSM_ASSERT(_regionId + _regionSize <= StateList::SIZE);
-	HFSM_ASSERT(_originId <= id && id < StateList::SIZE);
-
-	_originId = id;
-}
+#pragma pack(push, 1)
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+struct Status {
+	enum Result {
+		NONE,
+		SUCCESS,
+		FAILURE
+	};
 
-template <typename TArgs>
-void
-PlanControlT<TArgs>::resetOrigin(const StateID id) { //-V524
-	HFSM_ASSERT(_regionId + _regionSize <= StateList::SIZE);
-	HFSM_ASSERT(id <= _originId && _originId < StateList::SIZE);
+	Result result = NONE;
+	bool outerTransition = false;
 
-	_originId = id;
-}
+	inline Status(const Result result_ = NONE,
+				  const bool outerTransition_ = false);
 
-//------------------------------------------------------------------------------
+	inline explicit operator bool() const { return result || outerTransition; }
 
-template <typename TArgs>
-void
-PlanControlT<TArgs>::setRegion(const RegionID id,
-							   const StateID index,
-							   const LongIndex size)
-{
-	HFSM_ASSERT(_regionId <= id && id <  RegionList::SIZE);
-	HFSM_ASSERT(_regionIndex <= index && index + size <= _regionIndex + _regionSize);
+	inline void clear();
+};
 
-	_regionId	 = id;
-	_regionIndex = index;
-	_regionSize	 = size;
-}
+#pragma pack(pop)
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TArgs>
-void
-PlanControlT<TArgs>::resetRegion(const RegionID id, //-V524
-								 const StateID index,
-								 const LongIndex size)
-{
-	HFSM_ASSERT(id <= _regionId && _regionId < RegionList::SIZE);
-	HFSM_ASSERT(index <= _regionIndex && _regionIndex + _regionSize <= index + size);
+inline Status
+combine(const Status lhs, const Status rhs) {
+	const Status::Result result = lhs.result > rhs.result ?
+		lhs.result : rhs.result;
 
-	_regionId	 = id;
-	_regionIndex = index;
-	_regionSize	 = size;
+	return {result, lhs.outerTransition || rhs.outerTransition};
 }
 
 ////////////////////////////////////////////////////////////////////////////////
 
 template <typename TArgs>
-FullControlT<TArgs>::Lock::Lock(FullControlT& control_)
-	: control(!control_._locked ? &control_ : nullptr)
-{
-	if (control)
-		control->_locked = true;
-}
-
-//------------------------------------------------------------------------------
+class ConstPlanT {
+	template <typename>
+	friend class ControlT;
 
-template <typename TArgs>
-FullControlT<TArgs>::Lock::~Lock() {
-	if (control)
-		control->_locked = false;
-}
+	template <typename>
+	friend class PlanControlT;
 
-////////////////////////////////////////////////////////////////////////////////
+	template <typename>
+	friend class FullControlT;
 
-template <typename TArgs>
-template <typename TState>
-Status
-FullControlT<TArgs>::updatePlan(TState& headState,
-								const Status subStatus)
-{
-	using State = TState;
-	static constexpr StateID STATE_ID = State::STATE_ID;
+	template <typename>
+	friend class GuardControlT;
 
-	HFSM_ASSERT(subStatus);
+	using Args			= TArgs;
+	using Context		= typename Args::Context;
+	using StateList		= typename Args::StateList;
+	using RegionList	= typename Args::RegionList;
 
-	if (subStatus.result == Status::FAILURE) {
-		_status.result = Status::FAILURE;
-		headState.wrapPlanFailed(*this);
+	static constexpr LongIndex TASK_CAPACITY = Args::TASK_CAPACITY;
 
-		if (Plan p = plan(_regionId))
-			p.clear();
+public:
+	using PlanData		= PlanDataT<Args>;
+	using TaskLinks		= typename PlanData::TaskLinks;
 
-		return buildPlanStatus<State>();
-	} else if (subStatus.result == Status::SUCCESS) {
-		if (Plan p = plan(_regionId)) {
-			for (auto it = p.first(); it; ++it) {
-				if (isActive(it->origin) &&
-					_planData.tasksSuccesses.get(it->origin))
-				{
-					Origin origin{*this, STATE_ID};
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-					changeTo(it->destination);
+	struct Iterator {
+		HFSM_INLINE Iterator(const ConstPlanT& plan);
 
-					it.remove();
-				} else
-					break;
-			}
+		HFSM_INLINE explicit operator bool() const;
 
-			return Status{};
-		} else {
-			_status.result = Status::SUCCESS;
-			headState.wrapPlanSucceeded(*this);
+		HFSM_INLINE void operator ++();
 
-			return buildPlanStatus<State>();
-		}
-	} else
-		return Status{};
-}
+		HFSM_INLINE const TaskLink& operator  *() const { return  _plan._planData.taskLinks[_curr];	}
+		HFSM_INLINE const TaskLink* operator ->() const { return &_plan._planData.taskLinks[_curr];	}
 
-//------------------------------------------------------------------------------
+		HFSM_INLINE LongIndex next() const;
 
-template <typename TArgs>
-template <typename TState>
-Status
-FullControlT<TArgs>::buildPlanStatus() {
-	using State = TState;
-	static constexpr StateID STATE_ID = State::STATE_ID;
+		const ConstPlanT& _plan;
+		LongIndex _curr;
+		LongIndex _next;
+	};
 
-	switch (_status.result) {
-	case Status::NONE:
-		HFSM_BREAK();
-		break;
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	case Status::SUCCESS:
-		_planData.tasksSuccesses.template set<STATE_ID>();
+private:
+	HFSM_INLINE ConstPlanT(const PlanData& planData,
+						   const RegionID regionId);
 
-		HFSM_LOG_PLAN_STATUS(context(), _regionId, StatusEvent::SUCCEEDED);
-		break;
+	template <typename T>
+	static constexpr StateID  stateId()		{ return			StateList ::template index<T>();	}
 
-	case Status::FAILURE:
-		_planData.tasksFailures.template set<STATE_ID>();
+	template <typename T>
+	static constexpr RegionID regionId()	{ return (RegionID) RegionList::template index<T>();	}
 
-		HFSM_LOG_PLAN_STATUS(context(), _regionId, StatusEvent::FAILED);
-		break;
+public:
+	HFSM_INLINE explicit operator bool() const;
 
-	default:
-		HFSM_BREAK();
-	}
+	HFSM_INLINE Iterator first()			{ return Iterator{*this};								}
 
-	return {_status.result};
-}
+private:
+	const PlanData& _planData;
+	const RegionID _regionId;
+	const Bounds& _bounds;
+};
 
-//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
 
 template <typename TArgs>
-void
-FullControlT<TArgs>::changeTo(const StateID stateId) {
-	if (!_locked) {
-		_requests.append(Request{Request::Type::CHANGE, stateId});
+class PlanT {
+	template <typename>
+	friend class PlanControlT;
 
-		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
-			_status.outerTransition = true;
+	template <typename>
+	friend class FullControlT;
 
-		HFSM_LOG_TRANSITION(context(), _originId, TransitionType::CHANGE, stateId);
-	}
-}
+	template <typename>
+	friend class GuardControlT;
 
-//------------------------------------------------------------------------------
+	using Args			= TArgs;
+	using Context		= typename Args::Context;
+	using StateList		= typename Args::StateList;
+	using RegionList	= typename Args::RegionList;
 
-template <typename TArgs>
-void
-FullControlT<TArgs>::restart(const StateID stateId) {
-	if (!_locked) {
-		_requests.append(Request{Request::Type::RESTART, stateId});
+	static constexpr LongIndex  TASK_CAPACITY	= Args::TASK_CAPACITY;
 
-		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
-			_status.outerTransition = true;
+public:
+	using PlanData		= PlanDataT<Args>;
+	using TaskLinks		= typename PlanData::TaskLinks;
+	using TaskIndex		= typename TaskLinks::Index;
 
-		HFSM_LOG_TRANSITION(context(), _originId, TransitionType::RESTART, stateId);
-	}
-}
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-//------------------------------------------------------------------------------
+	struct Iterator {
+		HFSM_INLINE Iterator(PlanT& plan);
 
-template <typename TArgs>
-void
-FullControlT<TArgs>::resume(const StateID stateId) {
-	if (!_locked) {
-		_requests.append(Request{Request::Type::RESUME, stateId});
+		HFSM_INLINE explicit operator bool() const;
 
-		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
-			_status.outerTransition = true;
+		HFSM_INLINE void operator ++();
 
-		HFSM_LOG_TRANSITION(context(), _originId, TransitionType::RESUME, stateId);
-	}
-}
+		HFSM_INLINE		  TaskLink& operator  *()	    { return  _plan._planData.taskLinks[_curr];	}
+		HFSM_INLINE const TaskLink& operator  *() const { return  _plan._planData.taskLinks[_curr];	}
 
-//------------------------------------------------------------------------------
+		HFSM_INLINE		  TaskLink* operator ->()	    { return &_plan._planData.taskLinks[_curr];	}
+		HFSM_INLINE const TaskLink* operator ->() const { return &_plan._planData.taskLinks[_curr];	}
 
-template <typename TArgs>
-void
-FullControlT<TArgs>::utilize(const StateID stateId) {
-	if (!_locked) {
-		_requests.append(Request{Request::Type::UTILIZE, stateId});
+		HFSM_INLINE void remove();
 
-		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
-			_status.outerTransition = true;
+		HFSM_INLINE LongIndex next() const;
 
-		HFSM_LOG_TRANSITION(context(), _originId, TransitionType::UTILIZE, stateId);
-	}
-}
+		PlanT& _plan;
+		LongIndex _curr;
+		LongIndex _next;
+	};
 
-//------------------------------------------------------------------------------
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TArgs>
-void
-FullControlT<TArgs>::randomize(const StateID stateId) {
-	if (!_locked) {
-		_requests.append(Request{Request::Type::RANDOMIZE, stateId});
+private:
+	HFSM_INLINE PlanT(PlanData& planData,
+					  const RegionID regionId);
 
-		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
-			_status.outerTransition = true;
+	template <typename T>
+	static constexpr StateID  stateId()		{ return			StateList ::template index<T>();	}
 
-		HFSM_LOG_TRANSITION(context(), _originId, TransitionType::RANDOMIZE, stateId);
-	}
-}
+	template <typename T>
+	static constexpr RegionID regionId()	{ return (RegionID) RegionList::template index<T>();	}
 
-//------------------------------------------------------------------------------
+	bool append(const TransitionType transitionType,
+				const StateID origin,
+				const StateID destination);
 
-template <typename TArgs>
-void
-FullControlT<TArgs>::schedule(const StateID stateId) {
-	_requests.append(Request{Request::Type::SCHEDULE, stateId});
+public:
+	HFSM_INLINE explicit operator bool() const;
 
-	HFSM_LOG_TRANSITION(context(), _originId, TransitionType::SCHEDULE, stateId);
-}
+	HFSM_INLINE void clear();
 
-//------------------------------------------------------------------------------
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TArgs>
-void
-FullControlT<TArgs>::succeed() {
-	_status.result = Status::SUCCESS;
+	HFSM_INLINE bool change   (const StateID origin, const StateID destination)	{ return append(TransitionType::CHANGE,	   origin, destination); }
+	HFSM_INLINE bool restart  (const StateID origin, const StateID destination)	{ return append(TransitionType::RESTART,   origin, destination); }
+	HFSM_INLINE bool resume   (const StateID origin, const StateID destination)	{ return append(TransitionType::RESUME,	   origin, destination); }
+	HFSM_INLINE bool utilize  (const StateID origin, const StateID destination)	{ return append(TransitionType::UTILIZE,   origin, destination); }
+	HFSM_INLINE bool randomize(const StateID origin, const StateID destination)	{ return append(TransitionType::RANDOMIZE, origin, destination); }
+	HFSM_INLINE bool schedule (const StateID origin, const StateID destination)	{ return append(TransitionType::SCHEDULE,  origin, destination); }
 
-	_planData.tasksSuccesses.set(_originId);
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	// TODO: promote taskSuccess all the way up for all regions without plans
-	if (_regionId < RegionList::SIZE && !_planData.planExists.get(_regionId)) {
-		HFSM_ASSERT(_regionIndex < StateList::SIZE);
+	template <typename TOrigin>
+	HFSM_INLINE bool change   (const StateID destination)					{ return change   (stateId<TOrigin>(), destination);				}
 
-		_planData.tasksSuccesses.set(_regionIndex);
-	}
+	template <typename TOrigin>
+	HFSM_INLINE bool restart  (const StateID destination)					{ return restart  (stateId<TOrigin>(), destination);				}
 
-	HFSM_LOG_TASK_STATUS(context(), _regionId, _originId, StatusEvent::SUCCEEDED);
-}
+	template <typename TOrigin>
+	HFSM_INLINE bool resume   (const StateID destination)					{ return resume   (stateId<TOrigin>(), destination);				}
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	template <typename TOrigin>
+	HFSM_INLINE bool utilize  (const StateID destination)					{ return utilize  (stateId<TOrigin>(), destination);				}
 
-template <typename TArgs>
-void
-FullControlT<TArgs>::fail() {
-	_status.result = Status::FAILURE;
+	template <typename TOrigin>
+	HFSM_INLINE bool randomize(const StateID destination)					{ return randomize(stateId<TOrigin>(), destination);				}
+
+	template <typename TOrigin>
+	HFSM_INLINE bool schedule (const StateID destination)					{ return schedule (stateId<TOrigin>(), destination);				}
 
-	_planData.tasksFailures.set(_originId);
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	// TODO: promote taskFailure all the way up for all regions without plans
-	if (_regionId < RegionList::SIZE && !_planData.planExists.get(_regionId)) {
-		HFSM_ASSERT(_regionIndex < StateList::SIZE);
+	template <typename TOrigin, typename TDestination>
+	HFSM_INLINE bool change   ()											{ return change   (stateId<TOrigin>(), stateId<TDestination>());	}
 
-		_planData.tasksFailures.set(_regionIndex);
-	}
+	template <typename TOrigin, typename TDestination>
+	HFSM_INLINE bool restart  ()											{ return restart  (stateId<TOrigin>(), stateId<TDestination>());	}
 
-	HFSM_LOG_TASK_STATUS(context(), _regionId, _originId, StatusEvent::FAILED);
-}
+	template <typename TOrigin, typename TDestination>
+	HFSM_INLINE bool resume   ()											{ return resume   (stateId<TOrigin>(), stateId<TDestination>());	}
 
-////////////////////////////////////////////////////////////////////////////////
+	template <typename TOrigin, typename TDestination>
+	HFSM_INLINE bool utilize  ()											{ return utilize  (stateId<TOrigin>(), stateId<TDestination>());	}
 
-template <typename TArgs>
-void
-GuardControlT<TArgs>::cancelPendingTransitions() {
-	_cancelled = true;
+	template <typename TOrigin, typename TDestination>
+	HFSM_INLINE bool randomize()											{ return randomize(stateId<TOrigin>(), stateId<TDestination>());	}
 
-	HFSM_LOG_CANCELLED_PENDING(context(), _originId);
-}
+	template <typename TOrigin, typename TDestination>
+	HFSM_INLINE bool schedule ()											{ return schedule (stateId<TOrigin>(), stateId<TDestination>());	}
 
-////////////////////////////////////////////////////////////////////////////////
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-}
-}
+#ifdef HFSM_ENABLE_STATIC_PLANS
+	// Replace the plan with a PlanTemplate<>, O(1) and without using task links
+	//  Tasks of a template plan aren't visited by first()
+	template <typename TPlanTemplate>
+	HFSM_INLINE void apply();
+#endif
 
-namespace hfsm2 {
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-//------------------------------------------------------------------------------
+	HFSM_INLINE Iterator first()			{ return Iterator{*this};								}
 
-#ifdef HFSM_ENABLE_STRUCTURE_REPORT
+private:
+	void remove(const LongIndex task);
 
-struct StructureEntry {
-	bool isActive;
-	const wchar_t* prefix;
-	const char* name;
+private:
+	PlanData& _planData;
+	const RegionID _regionId;
+	Bounds& _bounds;
 };
 
-#endif
+////////////////////////////////////////////////////////////////////////////////
 
-//------------------------------------------------------------------------------
+}
+}
 
+namespace hfsm2 {
 namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-#ifdef HFSM_ENABLE_STRUCTURE_REPORT
+Status::Status(const Result result_,
+			   const bool outerTransition_)
+	: result{result_}
+	, outerTransition{outerTransition_}
+{}
 
-#pragma pack(push, 1)
+//------------------------------------------------------------------------------
 
-struct alignas(alignof(void*)) StructureStateInfo {
-	enum RegionType : ShortIndex {
-		COMPOSITE,
-		ORTHOGONAL,
-	};
+void
+Status::clear() {
+	result = NONE;
+	outerTransition = false;
+}
 
-	StructureStateInfo() = default;
+////////////////////////////////////////////////////////////////////////////////
 
-	HFSM_INLINE StructureStateInfo(const LongIndex parent_,
-								   const RegionType region_,
-								   const ShortIndex depth_,
-								   const char* const name_)
-		: name{name_}
-		, parent{parent_}
-		, region{region_}
-		, depth{depth_}
-	{}
+template <typename TArgs>
+ConstPlanT<TArgs>::Iterator::Iterator(const ConstPlanT& plan)
+	: _plan{plan}
+	, _curr{plan._bounds.first}
+{
+	_next = next();
+}
 
-	const char* name;
-	LongIndex parent;
-	RegionType region;
-	ShortIndex depth;
-};
+//------------------------------------------------------------------------------
 
-#pragma pack(pop)
+template <typename TArgs>
+ConstPlanT<TArgs>::Iterator::operator bool() const {
+	HFSM_ASSERT(_curr < ConstPlanT::TASK_CAPACITY || _curr == INVALID_LONG_INDEX);
 
-#endif
+	return _curr < ConstPlanT::TASK_CAPACITY;
+}
 
-////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
 
-#ifdef HFSM_ENABLE_TRANSITION_HISTORY
+template <typename TArgs>
+void
+ConstPlanT<TArgs>::Iterator::operator ++() {
+	_curr = _next;
+	_next = next();
+}
 
-TransitionType
-HFSM_INLINE convert(const Request::Type type) {
-	switch (type) {
-		case Request::CHANGE:
-			return TransitionType::CHANGE;
+//------------------------------------------------------------------------------
 
-		case Request::RESTART:
-			return TransitionType::RESTART;
+template <typename TArgs>
+LongIndex
+ConstPlanT<TArgs>::Iterator::next() const {
+	if (_curr < ConstPlanT::TASK_CAPACITY) {
+		const TaskLink& task = _plan._planData.taskLinks[_curr];
 
-		case Request::RESUME:
-			return TransitionType::RESUME;
+		return task.next;
+	} else {
+		HFSM_ASSERT(_curr == INVALID_LONG_INDEX);
 
-		case Request::UTILIZE:
-			return TransitionType::UTILIZE;
-
-		case Request::RANDOMIZE:
-			return TransitionType::RANDOMIZE;
-
-		case Request::SCHEDULE:
-			return TransitionType::SCHEDULE;
-
-		default:
-			HFSM_BREAK();
-			return TransitionType::CHANGE;
+		return INVALID_LONG_INDEX;
 	}
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-
-Request::Type
-HFSM_INLINE convert(const TransitionType type) {
-	switch (type) {
-	case TransitionType::CHANGE:
-		return Request::CHANGE;
-
-	case TransitionType::RESTART:
-		return Request::RESTART;
+////////////////////////////////////////////////////////////////////////////////
 
-	case TransitionType::RESUME:
-		return Request::RESUME;
+template <typename TArgs>
+ConstPlanT<TArgs>::ConstPlanT(const PlanData& planData,
+							  const RegionID regionId)
 
-	case TransitionType::UTILIZE:
-		return Request::UTILIZE;
+	: _planData{planData}
+	, _regionId{regionId}
+	, _bounds{planData.tasksBounds[regionId]}
+{}
 
-	case TransitionType::RANDOMIZE:
-		return Request::RANDOMIZE;
+//------------------------------------------------------------------------------
 
-	case TransitionType::SCHEDULE:
-		return Request::SCHEDULE;
+template <typename TArgs>
+ConstPlanT<TArgs>::operator bool() const {
+	HFSM_IF_STATIC_PLANS(if (_planData.staticPlans.active(_regionId)) return true);
 
-	default:
-		HFSM_BREAK();
-		return Request::CHANGE;
+	if (_bounds.first < TASK_CAPACITY) {
+		HFSM_ASSERT(_bounds.last < TASK_CAPACITY);
+		return true;
+	} else {
+		HFSM_ASSERT(_bounds.last == INVALID_LONG_INDEX);
+		return false;
 	}
 }
 
-#endif
+////////////////////////////////////////////////////////////////////////////////
 
+template <typename TArgs>
+PlanT<TArgs>::Iterator::Iterator(PlanT& plan)
+	: _plan{plan}
+	, _curr{plan._bounds.first}
+{
+	_next = next();
 }
 
 //------------------------------------------------------------------------------
 
-#ifdef HFSM_ENABLE_TRANSITION_HISTORY
+template <typename TArgs>
+PlanT<TArgs>::Iterator::operator bool() const {
+	HFSM_ASSERT(_curr < PlanT::TASK_CAPACITY || _curr == INVALID_LONG_INDEX);
 
-#pragma pack(push, 1)
+	return _curr < PlanT::TASK_CAPACITY;
+}
 
-struct alignas(4) Transition {
-	HFSM_INLINE Transition() = default;
+//------------------------------------------------------------------------------
 
-	HFSM_INLINE Transition(const detail::Request request,
-						   const Method method_)
-		: stateId{request.stateId}
-		, method{method_}
-		, transitionType{detail::convert(request.type)}
-	{
-		HFSM_ASSERT(method_ < Method::COUNT);
-	}
+template <typename TArgs>
+void
+PlanT<TArgs>::Iterator::operator ++() {
+	_curr = _next;
+	_next = next();
+}
 
-	HFSM_INLINE Transition(const StateID stateId_,
-						   const Method method_,
-						   const TransitionType transitionType_)
-		: stateId{stateId_}
-		, method{method_}
-		, transitionType{transitionType_}
-	{
-		HFSM_ASSERT(method_ < Method::COUNT);
-	}
+//------------------------------------------------------------------------------
 
-	detail::Request request() const		{ return detail::Request{detail::convert(transitionType), stateId};	}
+template <typename TArgs>
+void
+PlanT<TArgs>::Iterator::remove() {
+	_plan.remove(_curr);
+}
 
-	StateID stateId = INVALID_STATE_ID;
-	Method method;
-	TransitionType transitionType;
-};
+//------------------------------------------------------------------------------
 
-#pragma pack(pop)
+template <typename TArgs>
+LongIndex
+PlanT<TArgs>::Iterator::next() const {
+	if (_curr < PlanT::TASK_CAPACITY) {
+		const TaskLink& task = _plan._planData.taskLinks[_curr];
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+		return task.next;
+	} else {
+		HFSM_ASSERT(_curr == INVALID_LONG_INDEX);
 
-bool operator == (const Transition& l, const Transition& r) {
-	return l.stateId		== r.stateId
-		&& l.method			== r.method
-		&& l.transitionType	== r.transitionType;
+		return INVALID_LONG_INDEX;
+	}
 }
 
-#endif
-
 ////////////////////////////////////////////////////////////////////////////////
 
-}
-
+template <typename TArgs>
+PlanT<TArgs>::PlanT(PlanData& planData,
+					const RegionID regionId)
 
-namespace hfsm2 {
-namespace detail {
+	: _planData{planData}
+	, _regionId{regionId}
+	, _bounds{planData.tasksBounds[regionId]}
+{}
 
-////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
 
 template <typename TArgs>
-class InjectionT {
-	template <typename...>
-	friend struct B_;
+PlanT<TArgs>::operator bool() const {
+	HFSM_IF_STATIC_PLANS(if (_planData.staticPlans.active(_regionId)) return true);
 
-protected:
-	using Context		= typename TArgs::Context;
-	using Rank			= typename TArgs::Rank;
-	using Utility		= typename TArgs::Utility;
-	using StateList		= typename TArgs::StateList;
-	using RegionList	= typename TArgs::RegionList;
+	if (_bounds.first < TASK_CAPACITY) {
+		HFSM_ASSERT(_bounds.last < TASK_CAPACITY);
+		return true;
+	} else {
+		HFSM_ASSERT(_bounds.last == INVALID_LONG_INDEX);
+		return false;
+	}
+}
 
-	using Control		= ControlT<TArgs>;
+//------------------------------------------------------------------------------
 
-	using PlanControl	= PlanControlT<TArgs>;
-	using Plan			= PlanT<TArgs>;
+template <typename TArgs>
+bool
+PlanT<TArgs>::append(const TransitionType transitionType,
+					 const StateID origin,
+					 const StateID destination)
+{
+	HFSM_IF_PARALLEL(HFSM_ASSERT(!_planData.forked));
 
-	using FullControl	= FullControlT <TArgs>;
-	using GuardControl	= GuardControlT<TArgs>;
+	_planData.planExists.set(_regionId);
 
-public:
-	HFSM_INLINE void preEntryGuard(Context&)		{}
+	HFSM_IF_PLAN_QUOTAS(if (!_planData.planQuotas.acquire(_regionId)) return false);
 
-	HFSM_INLINE void preEnter	  (Context&)		{}
-	HFSM_INLINE void preReenter	  (Context&)		{}
+	const TaskIndex index = _planData.taskLinks.emplace(transitionType, origin, destination);
+	if (index == TaskLinks::INVALID) {
+		HFSM_IF_PLAN_QUOTAS(_planData.planQuotas.refuse(_regionId));
 
-	HFSM_INLINE void preUpdate	  (Context&)		{}
+		return false;
+	}
 
-	template <typename TEvent>
-	HFSM_INLINE void preReact	  (const TEvent&,
-								   Context&)		{}
+	if (_bounds.first < TaskLinks::CAPACITY) {
+		HFSM_ASSERT(_bounds.last < TaskLinks::CAPACITY);
 
-	HFSM_INLINE void preExitGuard (Context&)		{}
+		auto& last  = _planData.taskLinks[_bounds.last];
+		last.next = index;
 
-	HFSM_INLINE void postExit	  (Context&)		{}
+		auto& next = _planData.taskLinks[index];
+		next.prev  = _bounds.last;
 
-	template <typename T>
-	static constexpr StateID  stateId()		{ return			StateList ::template index<T>();	}
+		_bounds.last = index;
+	} else {
+		HFSM_ASSERT(_bounds.first == INVALID_LONG_INDEX &&
+					_bounds.last  == INVALID_LONG_INDEX);
 
-	template <typename T>
-	static constexpr RegionID regionId()	{ return (RegionID) RegionList::template index<T>();	}
-};
+		_bounds.first = index;
+		_bounds.last  = index;
+	}
+
+	return true;
+}
 
 //------------------------------------------------------------------------------
 
-template <typename...>
-struct B_;
+template <typename TArgs>
+void
+PlanT<TArgs>::clear() {
+	HFSM_IF_STATIC_PLANS(_planData.staticPlans.clear(_regionId));
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	if (_bounds.first < TaskLinks::CAPACITY) {
+		HFSM_ASSERT(_bounds.last < TaskLinks::CAPACITY);
+		HFSM_IF_PARALLEL(HFSM_ASSERT(!_planData.forked));
 
-template <typename TFirst, typename... TRest>
-struct B_<TFirst, TRest...>
-	: TFirst
-	, B_<TRest...>
-{
-	using typename TFirst::Context;
-	using typename TFirst::Rank;
-	using typename TFirst::Utility;
-	using typename TFirst::StateList;
-	using typename TFirst::RegionList;
+		for (LongIndex index = _bounds.first;
+			 index != INVALID_LONG_INDEX;
+			 )
+		{
+			HFSM_ASSERT(index < TaskLinks::CAPACITY);
 
-	using typename TFirst::Control;
-	using typename TFirst::PlanControl;
-	using typename TFirst::Plan;
-	using typename TFirst::FullControl;
-	using typename TFirst::GuardControl;
+			const auto& task = _planData.taskLinks[index];
+			HFSM_ASSERT(index == _bounds.first ?
+				   task.prev == INVALID_LONG_INDEX :
+				   task.prev <  TaskLinks::CAPACITY);
 
-	using TFirst::stateId;
-	using TFirst::regionId;
+			const LongIndex next = task.next;
 
-	HFSM_INLINE void widePreEntryGuard(Context& context);
+			_planData.taskLinks.remove(index);
+			HFSM_IF_PLAN_QUOTAS(_planData.planQuotas.release(_regionId));
 
-	HFSM_INLINE void widePreEnter	  (Context& context);
-	HFSM_INLINE void widePreReenter	  (Context& context);
+			index = next;
+		}
 
-	HFSM_INLINE void widePreUpdate	  (Context& context);
+		_bounds.first = INVALID_LONG_INDEX;
+		_bounds.last  = INVALID_LONG_INDEX;
+	} else
+		HFSM_ASSERT(_bounds.first == INVALID_LONG_INDEX &&
+			   _bounds.last  == INVALID_LONG_INDEX);
+}
 
-	template <typename TEvent>
-	HFSM_INLINE void widePreReact	  (const TEvent& event,
-									   Context& context);
+//------------------------------------------------------------------------------
 
-	HFSM_INLINE void widePreExitGuard (Context& context);
+#ifdef HFSM_ENABLE_STATIC_PLANS
 
-	HFSM_INLINE void widePostExit	  (Context& context);
-};
+template <typename TArgs>
+template <typename TPlanTemplate>
+void
+PlanT<TArgs>::apply() {
+	using StaticPlan = StaticPlanT<StateList, TPlanTemplate>;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	clear();
 
-template <typename TFirst>
-struct B_<TFirst>
-	: TFirst
-{
-	using typename TFirst::Context;
-	using typename TFirst::Rank;
-	using typename TFirst::Utility;
-	using typename TFirst::StateList;
-	using typename TFirst::RegionList;
-
-	using typename TFirst::Control;
-	using typename TFirst::PlanControl;
-	using typename TFirst::Plan;
-	using typename TFirst::FullControl;
-	using typename TFirst::GuardControl;
-
-	using TFirst::stateId;
-	using TFirst::regionId;
+	auto& entry = _planData.staticPlans.entries[_regionId];
+	entry.tasks	 = StaticPlan::TASKS;
+	entry.count	 = (uint16_t) StaticPlan::COUNT;
+	entry.cursor = 0;
 
-	HFSM_INLINE Rank	rank			 (const Control&)			{ return Rank	   {0};	}
+	_planData.planExists.set(_regionId);
+}
 
-	HFSM_INLINE Utility utility			 (const Control&)			{ return Utility{1.0f};	}
+#endif
 
-	HFSM_INLINE void	entryGuard		 (GuardControl&)			{}
+//------------------------------------------------------------------------------
 
-	HFSM_INLINE void	enter			 (PlanControl&)				{}
-	HFSM_INLINE void	reenter			 (PlanControl&)				{}
+template <typename TArgs>
+void
+PlanT<TArgs>::remove(const LongIndex task) {
+	HFSM_ASSERT(_planData.planExists.get(_regionId) &&
+				_bounds.first < TaskLinks::CAPACITY &&
+				_bounds.last  < TaskLinks::CAPACITY);
 
-	HFSM_INLINE void	update			 (FullControl&)				{}
+	HFSM_ASSERT(task < TaskLinks::CAPACITY);
+	HFSM_IF_PARALLEL(HFSM_ASSERT(!_planData.forked));
 
-	template <typename TEvent>
-	HFSM_INLINE void	react			 (const TEvent&,
-										  FullControl&)				{}
+	const TaskLink& curr = _planData.taskLinks[task];
 
-	HFSM_INLINE void	exitGuard		 (GuardControl&)			{}
+	if (curr.prev < TaskLinks::CAPACITY) {
+		TaskLink& prev = _planData.taskLinks[curr.prev];
+		prev.next = curr.next;
+	} else {
+		HFSM_ASSERT(_bounds.first == task);
+		_bounds.first = curr.next;
+	}
 
-	HFSM_INLINE void	exit			 (PlanControl&)				{}
+	if (curr.next < TaskLinks::CAPACITY) {
+		TaskLink& next = _planData.taskLinks[curr.next];
+		next.prev = curr.prev;
+	} else {
+		HFSM_ASSERT(_bounds.last == task);
+		_bounds.last = curr.prev;
+	}
 
-	HFSM_INLINE void	planSucceeded	 (FullControl& control)		{ control.succeed();	}
-	HFSM_INLINE void	planFailed		 (FullControl& control)		{ control.fail();		}
+	_planData.taskLinks.remove(task);
+	HFSM_IF_PLAN_QUOTAS(_planData.planQuotas.release(_regionId));
+}
 
-	HFSM_INLINE void	widePreEntryGuard(Context& context);
+////////////////////////////////////////////////////////////////////////////////
 
-	HFSM_INLINE void	widePreEnter	 (Context& context);
-	HFSM_INLINE void	widePreReenter   (Context& context);
+}
+}
 
-	HFSM_INLINE void	widePreUpdate	 (Context& context);
+namespace hfsm2 {
+namespace detail {
 
-	template <typename TEvent>
-	HFSM_INLINE void	widePreReact	 (const TEvent& event,
-					 					  Context& context);
+//------------------------------------------------------------------------------
 
-	HFSM_INLINE void	widePreExitGuard (Context& context);
+enum Strategy {
+	Composite,
+	Resumable,
+	Utilitarian,
+	RandomUtil,
+};
 
-	HFSM_INLINE void	widePostExit	 (Context& context);
+enum Execution {
+	Sequential,
+	Parallel,
 };
 
-//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
 
-template <typename TArgs>
-using EmptyT = B_<InjectionT<TArgs>>;
+#pragma pack(push, 1)
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+struct alignas(2 * sizeof(ShortIndex)) Parent {
+	HFSM_INLINE Parent() = default;
 
-struct Dynamic_ {};
+	HFSM_INLINE Parent(const ForkID forkId_)
+		: forkId{forkId_}
+	{}
 
-template <typename... TI>
-struct DB_
-	: Dynamic_
-	, B_<TI...>
-{};
+	HFSM_INLINE Parent(const ForkID forkId_,
+					   const ShortIndex prong_)
+		: forkId{forkId_}
+		, prong{prong_}
+	{}
 
-template <typename TArgs>
-using DynamicEmptyT = DB_<InjectionT<TArgs>>;
+	HFSM_INLINE explicit operator bool() const {
+		return forkId != INVALID_FORK_ID &&
+			   prong  != INVALID_SHORT_INDEX;
+	}
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	ForkID	   forkId = INVALID_FORK_ID;
+	ShortIndex prong  = INVALID_SHORT_INDEX;
+};
 
-struct Static_ {};
+#pragma pack(pop)
 
-template <typename... TI>
-struct SB_
-	: Static_
-	, B_<TI...>
-{};
+////////////////////////////////////////////////////////////////////////////////
 
-template <typename TArgs>
-using StaticEmptyT = SB_<InjectionT<TArgs>>;
+struct Request {
+	enum Type {
+		REMAIN,
+		CHANGE,
+		RESTART,
+		RESUME,
+		UTILIZE,
+		RANDOMIZE,
+		SCHEDULE,
 
-////////////////////////////////////////////////////////////////////////////////
+		COUNT
+	};
 
-}
-}
+	HFSM_INLINE Request() = default;
 
-namespace hfsm2 {
-namespace detail {
+	HFSM_INLINE Request(const Type type_,
+						const StateID stateId_,
+						const StateID origin_ = INVALID_STATE_ID)
+		: type{type_}
+		, stateId{stateId_}
+		, origin{origin_}
+	{
+		HFSM_ASSERT(type_ < Type::COUNT);
+	}
 
-////////////////////////////////////////////////////////////////////////////////
+	Type type = CHANGE;
+	StateID stateId = INVALID_STATE_ID;
+	StateID origin	= INVALID_STATE_ID;
+};
 
-template <typename TF, typename... TR>
-void
-B_<TF, TR...>::widePreEntryGuard(Context& context) {
-	TF::preEntryGuard(context);
-	B_<TR...>::widePreEntryGuard(context);
-}
+template <ShortIndex NCount>
+using RequestsT = Array<Request, NCount>;
 
-//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
 
-template <typename TF, typename... TR>
-void
-B_<TF, TR...>::widePreEnter(Context& context) {
-	TF::preEnter(context);
-	B_<TR...>::widePreEnter(context);
-}
+template <typename TRegistry>
+struct BackUpT {
+	using CompoForks = typename TRegistry::CompoForks;
+	using OrthoForks = typename TRegistry::OrthoForks;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	CompoForks compoRequested;
+	OrthoForks orthoRequested;
+	CompoForks compoResumable;
+};
 
-template <typename TF, typename... TR>
-void
-B_<TF, TR...>::widePreReenter(Context& context) {
-	TF::preReenter(context);
-	B_<TR...>::widePreReenter(context);
-}
+////////////////////////////////////////////////////////////////////////////////
 
-//------------------------------------------------------------------------------
+template <typename,
+		  typename,
+		  typename,
+		  typename,
+		  LongIndex,
+		  LongIndex,
+		  LongIndex,
+		  LongIndex,
+		  LongIndex>
+struct ArgsT;
 
-template <typename TF, typename... TR>
-void
-B_<TF, TR...>::widePreUpdate(Context& context) {
-	TF::preUpdate(context);
-	B_<TR...>::widePreUpdate(context);
-}
+template <typename>
+struct RegistryT;
 
 //------------------------------------------------------------------------------
 
-template <typename TF, typename... TR>
-template <typename TEvent>
-void
-B_<TF, TR...>::widePreReact(const TEvent& event,
-							Context& context)
+template <typename TContext,
+		  typename TConfig,
+		  typename TStateList,
+		  typename TRegionList,
+		  LongIndex NCompoCount,
+		  LongIndex NOrthoCount,
+		  LongIndex NOrthoUnits,
+		  LongIndex NSerialBits,
+		  LongIndex NTaskCapacity>
+struct RegistryT<ArgsT<TContext,
+					   TConfig,
+					   TStateList,
+					   TRegionList,
+					   NCompoCount,
+					   NOrthoCount,
+					   NOrthoUnits,
+					   NSerialBits,
+					   NTaskCapacity>>
 {
-	TF::preReact(event, context);
-	B_<TR...>::widePreReact(event, context);
-}
+	using StateList		= TStateList;
+	using RegionList	= TRegionList;
 
-//------------------------------------------------------------------------------
+	static constexpr LongIndex  STATE_COUNT		= StateList::SIZE;
+	static constexpr ShortIndex COMPO_REGIONS	= NCompoCount;
+	static constexpr ShortIndex ORTHO_REGIONS	= NOrthoCount;
+	static constexpr ShortIndex ORTHO_UNITS		= NOrthoUnits;
 
-template <typename TF, typename... TR>
-void
-B_<TF, TR...>::widePreExitGuard(Context& context) {
-	TF::preExitGuard(context);
-	B_<TR...>::widePreExitGuard(context);
-}
+	using StateParents	= StaticArray<Parent, STATE_COUNT>;
 
-//------------------------------------------------------------------------------
+	using CompoParents	= StaticArray<Parent, COMPO_REGIONS>;
+	using OrthoParents	= StaticArray<Parent, ORTHO_REGIONS>;
+	using OrthoUnits	= StaticArray<Units,  ORTHO_UNITS>;
 
-template <typename TF, typename... TR>
-void
-B_<TF, TR...>::widePostExit(Context& context) {
-	TF::postExit(context);
-	B_<TR...>::widePostExit(context);
-}
+	using CompoForks	= StaticArray<ShortIndex, COMPO_REGIONS>;
+	using OrthoForks	= BitArray	 <ShortIndex, ORTHO_UNITS>;
+	using OrthoBits		= typename OrthoForks::Bits;
+	using CompoRemains	= BitArray	 <ShortIndex, COMPO_REGIONS>;
 
-////////////////////////////////////////////////////////////////////////////////
-
-template <typename TF>
-void
-B_<TF>::widePreEntryGuard(Context& context) {
-	TF::preEntryGuard(context);
-}
-
-//------------------------------------------------------------------------------
-
-template <typename TF>
-void
-B_<TF>::widePreEnter(Context& context) {
-	TF::preEnter(context);
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-
-template <typename TF>
-void
-B_<TF>::widePreReenter(Context& context) {
-	TF::preReenter(context);
-}
-
-//------------------------------------------------------------------------------
-
-template <typename TF>
-void
-B_<TF>::widePreUpdate(Context& context) {
-	TF::preUpdate(context);
-}
-
-//------------------------------------------------------------------------------
-
-template <typename TF>
-template <typename TEvent>
-void
-B_<TF>::widePreReact(const TEvent& event,
-					 Context& context)
-{
-	TF::preReact(event, context);
-}
+	using BackUp		= BackUpT<RegistryT>;
 
-//------------------------------------------------------------------------------
+	bool isActive		(const StateID stateId) const;
+	bool isResumable	(const StateID stateId) const;
 
-template <typename TF>
-void
-B_<TF>::widePreExitGuard(Context& context) {
-	TF::preExitGuard(context);
-}
+	bool isPendingChange(const StateID stateId) const;
+	bool isPendingEnter	(const StateID stateId) const;
+	bool isPendingExit	(const StateID stateId) const;
 
-//------------------------------------------------------------------------------
+	HFSM_INLINE const Parent&	  forkParent(const ForkID forkId) const;
 
-template <typename TF>
-void
-B_<TF>::widePostExit(Context& context) {
-	TF::postExit(context);
-}
+	HFSM_INLINE OrthoBits requestedOrthoFork(const ForkID forkId);
 
-////////////////////////////////////////////////////////////////////////////////
+	bool requestImmediate(const Request request);
+	void requestScheduled(const StateID stateId);
 
-}
-}
+	void clearRequests();
+	void reset();
 
-namespace hfsm2 {
+	StateParents stateParents;
+	CompoParents compoParents;
+	OrthoParents orthoParents;
+	OrthoUnits orthoUnits;
 
-//------------------------------------------------------------------------------
+	CompoForks compoRequested{INVALID_SHORT_INDEX};
+	OrthoForks orthoRequested;
+	CompoForks compoActive	 {INVALID_SHORT_INDEX};
+	CompoForks compoResumable{INVALID_SHORT_INDEX};
 
-template <typename>
-struct Guard {
-	template <typename TArgs>
-	static void execute(hfsm2::detail::GuardControlT<TArgs>&) {}
+	CompoRemains compoRemains;
 };
 
 //------------------------------------------------------------------------------
 
-namespace detail {
-
-//------------------------------------------------------------------------------
-
-HFSM_IF_DEBUG(struct None {});
-
-////////////////////////////////////////////////////////////////////////////////
-
-template <typename T, typename TArgs>
-struct DBox final {
-	static constexpr bool isBare()								{ return false;					}
-
-	union {
-		T t_;
-	};
-
-	HFSM_INLINE  DBox() {}
-	HFSM_INLINE ~DBox() {}
+template <typename TContext,
+		  typename TConfig,
+		  typename TStateList,
+		  typename TRegionList,
+		  LongIndex NCompoCount,
+		  LongIndex NSerialBits,
+		  LongIndex NTaskCapacity>
+struct RegistryT<ArgsT<TContext,
+					   TConfig,
+					   TStateList,
+					   TRegionList,
+					   NCompoCount,
+					   0,
+					   0,
+					   NSerialBits,
+					   NTaskCapacity>>
+{
+	using StateList		= TStateList;
+	using RegionList	= TRegionList;
 
-	HFSM_INLINE void guard(GuardControlT<TArgs>& control)		{ Guard<T>::execute(control);	}
+	static constexpr LongIndex  STATE_COUNT		= StateList::SIZE;
+	static constexpr ShortIndex COMPO_REGIONS	= NCompoCount;
 
-	HFSM_INLINE void construct();
-	HFSM_INLINE void destruct();
+	using StateParents	= StaticArray<Parent, STATE_COUNT>;
+	using CompoParents	= StaticArray<Parent, COMPO_REGIONS>;
 
-	HFSM_INLINE		  T& get()							{ HFSM_ASSERT(initialized_); return t_;	}
-	HFSM_INLINE const T& get() const					{ HFSM_ASSERT(initialized_); return t_;	}
+	using CompoForks	= StaticArray<ShortIndex, COMPO_REGIONS>;
+	using OrthoForks	= BitArray	 <ShortIndex, 0>;
+	using CompoRemains	= BitArray	 <ShortIndex, COMPO_REGIONS>;
 
-	HFSM_IF_ASSERT(bool initialized_ = false);
+	using BackUp		= BackUpT<RegistryT>;
 
-	HFSM_IF_DEBUG(const std::type_index TYPE = typeid(T));
-};
+	bool isActive		(const StateID stateId) const;
+	bool isResumable	(const StateID stateId) const;
 
-////////////////////////////////////////////////////////////////////////////////
+	bool isPendingChange(const StateID stateId) const;
+	bool isPendingEnter	(const StateID stateId) const;
+	bool isPendingExit	(const StateID stateId) const;
 
-template <typename T, typename TArgs>
-struct SBox final {
-	static constexpr bool isBare()	{ return std::is_base_of<T, StaticEmptyT<TArgs>>::value;	}
+	HFSM_INLINE const Parent& forkParent(const ForkID forkId) const;
 
-	T t_;
+	bool requestImmediate(const Request request);
+	void requestScheduled(const StateID stateId);
 
-	HFSM_INLINE void guard(GuardControlT<TArgs>& control);
+	void clearRequests();
+	void reset();
 
-	HFSM_INLINE void construct()																{}
-	HFSM_INLINE void destruct()																	{}
+	StateParents stateParents;
+	CompoParents compoParents;
 
-	HFSM_INLINE		  T& get()									{ return t_;					}
-	HFSM_INLINE const T& get() const							{ return t_;					}
+	CompoForks compoRequested{INVALID_SHORT_INDEX};
+	OrthoForks orthoRequested;
+	CompoForks compoActive	 {INVALID_SHORT_INDEX};
+	CompoForks compoResumable{INVALID_SHORT_INDEX};
 
-	HFSM_IF_DEBUG(const std::type_index TYPE = isBare() ? typeid(None) : typeid(T));
+	CompoRemains compoRemains;
 };
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename T, typename TArgs>
-struct BoxifyT final {
-	using Type = typename std::conditional<
-					 std::is_base_of<Dynamic_, T>::value,
-					 DBox<T, TArgs>,
-					 SBox<T, TArgs>
-				 >::type;
-};
+template <typename TRegistry>
+void
+backup(const TRegistry& registry, BackUpT<TRegistry>& copy) {
+	overwrite(copy.compoRequested, registry.compoRequested);
+	overwrite(copy.orthoRequested, registry.orthoRequested);
+	overwrite(copy.compoResumable, registry.compoResumable);
+}
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//------------------------------------------------------------------------------
 
-template <typename T, typename TArgs>
-using Boxify = typename BoxifyT<T, TArgs>::Type;
+template <typename TRegistry>
+void
+restore(TRegistry& registry, const BackUpT<TRegistry>& copy) {
+	overwrite(registry.compoRequested, copy.compoRequested);
+	overwrite(registry.orthoRequested, copy.orthoRequested);
+	overwrite(registry.compoResumable, copy.compoResumable);
+}
 
-//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
 
 }
 }
 
+
 namespace hfsm2 {
 namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename T, typename TA>
-void
-DBox<T, TA>::construct() {
-	HFSM_ASSERT(!initialized_);
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, LongIndex NSB, LongIndex NTC>
+bool
+RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, NSB, NTC>>::isActive(const StateID stateId) const {
+	if (HFSM_CHECKED(stateId < STATE_COUNT))
+		for (Parent parent = stateParents[stateId];
+			 parent;
+			 parent = forkParent(parent.forkId))
+		{
+			HFSM_ASSERT(parent.forkId != 0);
 
-	new(&t_) T{};
+			if (parent.forkId > 0)
+				return parent.prong == compoActive[parent.forkId - 1];
+		}
 
-	HFSM_IF_ASSERT(initialized_ = true);
+	return true;
 }
 
-//------------------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename T, typename TA>
-void
-DBox<T, TA>::destruct() {
-	HFSM_ASSERT(initialized_);
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, LongIndex NSB, LongIndex NTC>
+bool
+RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, NSB, NTC>>::isResumable(const StateID stateId) const {
+	if (HFSM_CHECKED(stateId < STATE_COUNT))
+		for (Parent parent = stateParents[stateId];
+			 parent;
+			 parent = forkParent(parent.forkId))
+		{
+			HFSM_ASSERT(parent.forkId != 0);
 
-	t_.~T();
+			if (parent.forkId > 0)
+				return parent.prong == compoResumable[parent.forkId - 1];
+		}
 
-	HFSM_IF_ASSERT(initialized_ = false);
+	return false;
 }
 
-////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
 
-template <typename T, typename TA>
-void
-SBox<T, TA>::guard(GuardControlT<TA>& control) {
-	t_.widePreEntryGuard(control.context());
-	t_.		  entryGuard(control);
-}
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, LongIndex NSB, LongIndex NTC>
+bool
+RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, NSB, NTC>>::isPendingChange(const StateID stateId) const {
+	if (HFSM_CHECKED(stateId < STATE_COUNT))
+		for (Parent parent = stateParents[stateId];
+			 parent;
+			 parent = forkParent(parent.forkId))
+		{
+			HFSM_ASSERT(parent.forkId != 0);
 
-////////////////////////////////////////////////////////////////////////////////
+			if (parent.forkId > 0)
+				return compoRequested[parent.forkId - 1] !=
+					   compoActive	 [parent.forkId - 1];
+		}
 
+	return true;
 }
-}
-namespace hfsm2 {
-namespace detail {
 
-////////////////////////////////////////////////////////////////////////////////
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TIndices,
-		  typename TArgs,
-		  typename THead>
-struct S_ final {
-	static constexpr auto STATE_ID	 = TIndices::STATE_ID;
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, LongIndex NSB, LongIndex NTC>
+bool
+RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, NSB, NTC>>::isPendingEnter(const StateID stateId) const {
+	if (HFSM_CHECKED(stateId < STATE_COUNT))
+		for (Parent parent = stateParents[stateId];
+			 parent;
+			 parent = forkParent(parent.forkId))
+		{
+			HFSM_ASSERT(parent.forkId != 0);
 
-	using Context		= typename TArgs::Context;
-	using Rank			= typename TArgs::Rank;
-	using Utility		= typename TArgs::Utility;
-	using UP			= typename TArgs::UP;
-	using Logger		= typename TArgs::Logger;
+			if (parent.forkId > 0)
+				return parent.prong != compoActive	 [parent.forkId - 1] &&
+					   parent.prong == compoRequested[parent.forkId - 1];
+		}
 
-	using Control		= ControlT<TArgs>;
-	using Registry		= RegistryT<TArgs>;
-	using StateParents	= typename Registry::StateParents;
+	return true;
+}
 
-	using PlanControl	= PlanControlT<TArgs>;
-	using ScopedOrigin	= typename PlanControl::Origin;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	using FullControl	= FullControlT <TArgs>;
-	using GuardControl	= GuardControlT<TArgs>;
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, LongIndex NSB, LongIndex NTC>
+bool
+RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, NSB, NTC>>::isPendingExit(const StateID stateId) const {
+	if (HFSM_CHECKED(stateId < STATE_COUNT))
+		for (Parent parent = stateParents[stateId];
+			 parent;
+			 parent = forkParent(parent.forkId))
+		{
+			HFSM_ASSERT(parent.forkId != 0);
 
-	using Head			= THead;
-	using HeadBox		= Boxify<Head, TArgs>;
+			if (parent.forkId > 0)
+				return parent.prong == compoActive	 [parent.forkId - 1] &&
+					   parent.prong != compoRequested[parent.forkId - 1];
+		}
 
-	//----------------------------------------------------------------------
+	return true;
+}
 
-#ifdef HFSM_EXPLICIT_MEMBER_SPECIALIZATION
-#ifdef __clang__
-	#pragma clang diagnostic push
-	#pragma clang diagnostic ignored "-Wnull-dereference"
-#endif
+//------------------------------------------------------------------------------
 
-	template <typename T>
-	struct Accessor {
-		HFSM_INLINE static		 T&	   get(		 S_&  )			{ HFSM_BREAK(); return *reinterpret_cast<T*>(0);		}
-		HFSM_INLINE static const T&	   get(const S_&  )			{ HFSM_BREAK(); return *reinterpret_cast<T*>(0);		}
-	};
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, LongIndex NSB, LongIndex NTC>
+const Parent&
+RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, NSB, NTC>>::forkParent(const ForkID forkId) const {
+	HFSM_ASSERT(forkId != 0);
 
-#ifdef __clang__
-	#pragma clang diagnostic pop
-#endif
+	return forkId > 0 ?
+		compoParents[ forkId - 1] :
+		orthoParents[-forkId - 1];
+}
 
-	template <>
-	struct Accessor<Head> {
-		HFSM_INLINE static		 Head& get(		 S_& s)			{ return s._headBox.get();								}
-		HFSM_INLINE static const Head& get(const S_& s)			{ return s._headBox.get();								}
-	};
+//------------------------------------------------------------------------------
 
-	template <typename T>
-	HFSM_INLINE		  T& access()								{ return Accessor<T>::get(*this);						}
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, LongIndex NSB, LongIndex NTC>
+typename RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, NSB, NTC>>::OrthoBits
+RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, NSB, NTC>>::requestedOrthoFork(const ForkID forkId) {
+	HFSM_ASSERT(forkId < 0);
+	const Units& units = orthoUnits[-forkId - 1];
 
-	template <typename T>
-	HFSM_INLINE const T& access() const							{ return Accessor<T>::get(*this);						}
-#endif
+	return orthoRequested.bits(units);
+}
 
-	//----------------------------------------------------------------------
+//------------------------------------------------------------------------------
 
-	HFSM_INLINE Parent	stateParent			 (Control& control)	{ return control._registry.stateParents[STATE_ID];		}
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, LongIndex NSB, LongIndex NTC>
+bool
+RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, NSB, NTC>>::requestImmediate(const Request request) {
+	if (request.stateId == 0)
+		return false;
+	else if (HFSM_CHECKED(request.stateId < STATE_COUNT)) {
+		Parent parent;
 
-	HFSM_INLINE void	deepRegister		 (Registry& registry, const Parent parent);
+		for (parent = stateParents[request.stateId];
+			 parent;
+			 parent = forkParent(parent.forkId))
+		{
+			if (parent.forkId > 0) {
+				compoRequested[parent.forkId - 1] = parent.prong;
+				parent = forkParent(parent.forkId);
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+				break;
+			} else if (parent.forkId < 0)
+				requestedOrthoFork(parent.forkId).set(parent.prong);
+			else
+				HFSM_BREAK();
+		}
 
-	HFSM_INLINE bool	deepForwardEntryGuard(GuardControl&)					{ return false;	}
-	HFSM_INLINE bool	deepEntryGuard		 (GuardControl&	control);
+		for (; parent; parent = forkParent(parent.forkId)) {
+			if (parent.forkId > 0) {
+				compoRemains.set(parent.forkId - 1);
 
-	HFSM_INLINE void	deepConstruct		 (PlanControl&  control);
+				if (compoActive	  [parent.forkId - 1] != parent.prong)
+					compoRequested[parent.forkId - 1]  = parent.prong;
+				else {
+					parent = forkParent(parent.forkId);
+					break;
+				}
+			} else if (parent.forkId < 0)
+				requestedOrthoFork(parent.forkId).set(parent.prong);
+			else
+				HFSM_BREAK();
+		}
 
-	HFSM_INLINE void	deepEnter			 (PlanControl&	control);
-	HFSM_INLINE void	deepReenter			 (PlanControl&	control);
+		for (; parent; parent = forkParent(parent.forkId)) {
+			if (parent.forkId > 0)
+				compoRemains.set(parent.forkId - 1);
+			else if (parent.forkId < 0)
+				requestedOrthoFork(parent.forkId).set(parent.prong);
+			else
+				HFSM_BREAK();
+		}
+	}
 
-	HFSM_INLINE Status	deepUpdate			 (FullControl&	control);
+	return true;
+}
 
-	template <typename TEvent>
-	HFSM_INLINE Status	deepReact			 (FullControl&	control, const TEvent& event);
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	HFSM_INLINE bool	deepForwardExitGuard (GuardControl&)					{ return false; }
-	HFSM_INLINE bool	deepExitGuard		 (GuardControl&	control);
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, LongIndex NSB, LongIndex NTC>
+void
+RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, NSB, NTC>>::requestScheduled(const StateID stateId) {
+	if (HFSM_CHECKED(stateId < STATE_COUNT)) {
+		const Parent parent = stateParents[stateId];
 
-	HFSM_INLINE void	deepExit			 (PlanControl&	control);
+		HFSM_ASSERT(parent.forkId != 0);
+		if (parent.forkId > 0)
+			compoResumable[parent.forkId - 1] = parent.prong;
+	}
+}
 
-	HFSM_INLINE void	deepDestruct		 (PlanControl&  control);
+//------------------------------------------------------------------------------
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, LongIndex NSB, LongIndex NTC>
+void
+RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, NSB, NTC>>::clearRequests() {
+	compoRequested.clear();
+	orthoRequested.clear();
+	compoRemains  .clear();
+}
 
-	HFSM_INLINE void	wrapPlanSucceeded	 (FullControl&	control);
-	HFSM_INLINE void	wrapPlanFailed		 (FullControl&	control);
-	HFSM_INLINE Rank	wrapRank			 (Control& control);
-	HFSM_INLINE Utility	wrapUtility			 (Control& control);
+//------------------------------------------------------------------------------
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NOC, LongIndex NOU, LongIndex NSB, LongIndex NTC>
+void
+RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, NOC, NOU, NSB, NTC>>::reset() {
+	compoRequested.clear();
+	orthoRequested.clear();
+	compoActive	  .clear();
+	compoResumable.clear();
+	compoRemains  .clear();
+}
 
-	HFSM_INLINE void	deepForwardActive	 (Control&, const Request::Type)					{}
-	HFSM_INLINE void	deepForwardRequest	 (Control&, const Request::Type)					{}
+////////////////////////////////////////////////////////////////////////////////
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NSB, LongIndex NTC>
+bool
+RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, NSB, NTC>>::isActive(const StateID stateId) const {
+	if (HFSM_CHECKED(stateId < STATE_COUNT)) {
+		if (Parent parent = stateParents[stateId]) {
+			HFSM_ASSERT(parent.forkId > 0);
 
-	HFSM_INLINE void	deepRequestChange	 (Control&)											{}
-	HFSM_INLINE void	deepRequestRemain	 (Registry&)										{}
-	HFSM_INLINE void	deepRequestRestart	 (Registry&)										{}
-	HFSM_INLINE void	deepRequestResume	 (Registry&)										{}
-	HFSM_INLINE void	deepRequestUtilize	 (Control&)											{}
-	HFSM_INLINE void	deepRequestRandomize (Control&)											{}
+			return parent.prong == compoActive[parent.forkId - 1];
+		} else
+			return true;
+	}
 
-	HFSM_INLINE UP		deepReportChange	 (Control& control);
-	HFSM_INLINE UP		deepReportUtilize	 (Control& control);
-	HFSM_INLINE Rank	deepReportRank		 (Control& control);
-	HFSM_INLINE Utility	deepReportRandomize	 (Control& control);
+	return false;
+}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	HFSM_INLINE void	deepChangeToRequested(Control&)											{}
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NSB, LongIndex NTC>
+bool
+RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, NSB, NTC>>::isResumable(const StateID stateId) const {
+	if (HFSM_CHECKED(stateId < STATE_COUNT))
+		if (Parent parent = stateParents[stateId]) {
+			HFSM_ASSERT(parent.forkId > 0);
 
-	//------------------------------------------------------------------------------
+			return parent.prong == compoResumable[parent.forkId - 1];
+		}
 
-#if defined _DEBUG || defined HFSM_ENABLE_STRUCTURE_REPORT || defined HFSM_ENABLE_LOG_INTERFACE
+	return false;
+}
 
-	static constexpr LongIndex NAME_COUNT = HeadBox::isBare() ? 0 : 1;
+//------------------------------------------------------------------------------
 
-#endif
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NSB, LongIndex NTC>
+bool
+RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, NSB, NTC>>::isPendingChange(const StateID stateId) const {
+	if (HFSM_CHECKED(stateId < STATE_COUNT))
+		if (Parent parent = stateParents[stateId]) {
+			HFSM_ASSERT(parent.forkId > 0);
 
-	//----------------------------------------------------------------------
+			return compoRequested[parent.forkId - 1] !=
+				   compoActive	 [parent.forkId - 1];
+		}
 
-#ifdef HFSM_ENABLE_STRUCTURE_REPORT
-	using StructureStateInfos = typename TArgs::StructureStateInfos;
-	using RegionType		  = typename StructureStateInfo::RegionType;
+	return false;
+}
 
-	static const char* name();
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	void deepGetNames(const LongIndex parent,
-					  const RegionType region,
-					  const ShortIndex depth,
-					  StructureStateInfos& stateInfos) const;
-#endif
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NSB, LongIndex NTC>
+bool
+RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, NSB, NTC>>::isPendingEnter(const StateID stateId) const {
+	if (HFSM_CHECKED(stateId < STATE_COUNT))
+		if (Parent parent = stateParents[stateId]) {
+			HFSM_ASSERT(parent.forkId > 0);
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+			return parent.prong != compoActive	 [parent.forkId - 1] &&
+				   parent.prong == compoRequested[parent.forkId - 1];
+		}
 
-#ifdef HFSM_ENABLE_SERIALIZATION
-	using WriteStream	= typename TArgs::WriteStream;
-	using ReadStream	= typename TArgs::ReadStream;
+	return false;
+}
 
-	HFSM_INLINE void	deepSaveActive	 (const Registry&, WriteStream&) const					{}
-	HFSM_INLINE void	deepSaveResumable(const Registry&, WriteStream&) const					{}
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	HFSM_INLINE void	deepLoadRequested(		Registry&, ReadStream& ) const					{}
-	HFSM_INLINE void	deepLoadResumable(		Registry&, ReadStream& ) const					{}
-#endif
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NSB, LongIndex NTC>
+bool
+RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, NSB, NTC>>::isPendingExit(const StateID stateId) const {
+	if (HFSM_CHECKED(stateId < STATE_COUNT))
+		if (Parent parent = stateParents[stateId]) {
+			HFSM_ASSERT(parent.forkId > 0);
 
-	//----------------------------------------------------------------------
+			return parent.prong == compoActive	 [parent.forkId - 1] &&
+				   parent.prong != compoRequested[parent.forkId - 1];
+		}
 
-#ifdef HFSM_ENABLE_LOG_INTERFACE
+	return false;
+}
 
-	template <typename>
-	struct Traits_;
+//------------------------------------------------------------------------------
 
-	template <typename TR_, typename TH_, typename... TAs_>
-	struct Traits_<TR_(TH_::*)(TAs_...)> {
-		using Host = TH_;
-	};
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NSB, LongIndex NTC>
+const Parent&
+RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, NSB, NTC>>::forkParent(const ForkID forkId) const {
+	HFSM_ASSERT(forkId > 0);
 
-	template <typename TM_>
-	using Host_			= typename Traits_<TM_>::Host;
+	return compoParents[forkId - 1];
+}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//------------------------------------------------------------------------------
 
-	using Empty			= EmptyT<TArgs>;
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NSB, LongIndex NTC>
+bool
+RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, NSB, NTC>>::requestImmediate(const Request request) {
+	if (request.stateId == 0)
+		return false;
+	else if (HFSM_CHECKED(request.stateId < STATE_COUNT)) {
+		Parent parent = stateParents[request.stateId];
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+		if (HFSM_CHECKED(parent)) {
+			HFSM_ASSERT(parent.forkId > 0);
 
-	template <typename TMethodType>
-	typename std::enable_if<
-				 std::is_same<
-					 Host_<TMethodType>,
-					 Empty
-				 >::value
-			 >::type
-	log(Logger&,
-		Context&,
-		const Method) const
-	{}
+			compoRequested[parent.forkId - 1] = parent.prong;
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+			for (parent = forkParent(parent.forkId);
+				 parent;
+				 parent = forkParent(parent.forkId))
+			{
+				HFSM_ASSERT(parent.forkId > 0);
+				compoRemains.set(parent.forkId - 1);
 
-	template <typename TMethodType>
-	typename std::enable_if<
-				 !std::is_same<
-					 Host_<TMethodType>,
-					 Empty
-				 >::value
-			 >::type
-	log(Logger& logger,
-		Context& context,
-		const Method method) const
-	{
-		logger.recordMethod(context, STATE_ID, method);
+				if (compoActive	  [parent.forkId - 1] != parent.prong)
+					compoRequested[parent.forkId - 1]  = parent.prong;
+				else {
+					parent = forkParent(parent.forkId);
+					break;
+				}
+			}
+
+			for (; parent; parent = forkParent(parent.forkId)) {
+				HFSM_ASSERT(parent.forkId > 0);
+				compoRemains.set(parent.forkId - 1);
+			}
+		}
 	}
 
-#endif
+	return true;
+}
 
-	//----------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	// TODO: account for boxing
-	//
-	// if you see..
-	// VS	 - error C2079: 'hfsm2::detail::S_<...>::_head' uses undefined struct 'Blah'
-	// Clang - error : field has incomplete type 'hfsm2::detail::S_<...>::Head' (aka 'Blah')
-	//
-	// .. add definition for the state 'Blah'
-	HeadBox _headBox;
-};
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NSB, LongIndex NTC>
+void
+RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, NSB, NTC>>::requestScheduled(const StateID stateId) {
+	if (HFSM_CHECKED(stateId < STATE_COUNT)) {
+		const Parent parent = stateParents[stateId];
+
+		HFSM_ASSERT(parent.forkId > 0);
+		compoResumable[parent.forkId - 1] = parent.prong;
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NSB, LongIndex NTC>
+void
+RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, NSB, NTC>>::clearRequests() {
+	compoRequested.clear();
+	orthoRequested.clear();
+	compoRemains  .clear();
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TC, typename TG, typename TSL, typename TRL, LongIndex NCC, LongIndex NSB, LongIndex NTC>
+void
+RegistryT<ArgsT<TC, TG, TSL, TRL, NCC, 0, 0, NSB, NTC>>::reset() {
+	compoRequested.clear();
+	orthoRequested.clear();
+	compoActive	  .clear();
+	compoResumable.clear();
+	compoRemains  .clear();
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
 }
 }
 
+#ifdef HFSM_ENABLE_TIMERS
+
 namespace hfsm2 {
 namespace detail {
 
-//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
 
-template <StateID NS, typename TA, typename TH>
-struct RegisterT {
-	using StateParents	= StaticArray<Parent, TA::STATE_COUNT>;
-	using StateList		= typename TA::StateList;
+// Hierarchical timing wheel with one timer slot per state
+//  Time is counted in ticks, advanced once per R_::update()
+//  Each level holds 64 slots of intrusive timer lists, the slot occupancy is
+//  kept in a bitmask so an idle tick costs a single bit test
+//  Expired timers turn into transition requests issued on behalf of their origin state
 
-	static constexpr StateID STATE_ID = NS;
+template <LongIndex NStateCount>
+class TimerWheelT {
+public:
+	static constexpr LongIndex STATE_COUNT = NStateCount;
 
-	static HFSM_INLINE
-	void
-	execute(StateParents& stateParents,
-			const Parent parent)
-	{
-		static constexpr auto HEAD_ID = StateList::template index<TH>();
-		StaticAssertEquality<STATE_ID, HEAD_ID>();
+	static constexpr unsigned SLOT_BITS	= 6;
+	static constexpr unsigned SLOTS		= 1u << SLOT_BITS;
+	static constexpr unsigned LEVELS	= 4;
 
-		stateParents[STATE_ID] = parent;
-	}
-};
+	// Longest supported delay, longer ones are clamped
+	static constexpr uint32_t MAX_DELAY = (1u << (SLOT_BITS * LEVELS)) - 1;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	HFSM_INLINE TimerWheelT();
 
-template <StateID NS, typename TA>
-struct RegisterT<NS, TA, StaticEmptyT<TA>> {
-	using StateParents	= StaticArray<Parent, TA::STATE_COUNT>;
+	// Arm (or re-arm) the timer of 'origin' to request 'type' transition to 'target'
+	//  on the 'delay'-th tick from now, 'delay' of 0 is treated as 1
+	HFSM_INLINE void set(const StateID origin,
+						 const Request::Type type,
+						 const StateID target,
+						 const uint32_t delay);
 
-	static HFSM_INLINE
-	void
-	execute(StateParents&, const Parent) {}
-};
+	HFSM_INLINE void cancel(const StateID origin);
 
-////////////////////////////////////////////////////////////////////////////////
+	HFSM_INLINE bool pending(const StateID origin) const;
 
-template <typename TN_, typename TA, typename TH>
-void
-S_<TN_, TA, TH>::deepRegister(Registry& registry,
-							  const Parent parent)
-{
-	using Register = RegisterT<STATE_ID, TA, Head>;
-	Register::execute(registry.stateParents, parent);
-}
+	// Ticks left until the timer of 'origin' fires, 0 if it isn't armed
+	HFSM_INLINE uint32_t remaining(const StateID origin) const;
 
-//------------------------------------------------------------------------------
+	HFSM_INLINE bool empty() const							{ return _armed == 0;							}
 
-template <typename TN_, typename TA, typename TH>
-bool
-S_<TN_, TA, TH>::deepEntryGuard(GuardControl& control) {
-	HFSM_LOG_STATE_METHOD(&Head::entryGuard,
-						  control.context(),
-						  Method::ENTRY_GUARD);
+	HFSM_INLINE uint32_t now() const						{ return _now;									}
 
-	ScopedOrigin origin{control, STATE_ID};
+	// Advance time by one tick, appending requests of expired timers into 'requests'
+	//  Timers that don't fit into 'requests' are postponed till the next tick
+	//  Timers of origins no longer active in 'registry' are dropped,
+	//  e.g. armed from entryGuard() of a state whose entry got cancelled
+	template <typename TRequests, typename TRegistry>
+	HFSM_INLINE void advance(TRequests& requests,
+							 const TRegistry& registry);
 
-	const bool cancelledBefore = control._cancelled;
+private:
+	struct Timer {
+		uint32_t deadline;
+		StateID target;
+		StateID prev;
+		StateID next;
+		uint8_t type;
+		uint8_t level;		// INVALID_LEVEL when not armed
+		uint8_t slot;
+	};
 
-	_headBox.guard(control);
+	static constexpr uint8_t INVALID_LEVEL = 0xFF;
+
+	HFSM_INLINE void link  (const StateID origin);
+	HFSM_INLINE void unlink(const StateID origin);
+
+	HFSM_INLINE void cascade(const unsigned level);
+
+private:
+	Timer _timers[STATE_COUNT];
+	StateID _heads[LEVELS][SLOTS];
+	uint64_t _occupied[LEVELS];
+
+	uint32_t _now = 0;
+	LongIndex _armed = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////
 
-	return !cancelledBefore && control._cancelled;
+}
 }
 
-//------------------------------------------------------------------------------
+namespace hfsm2 {
+namespace detail {
 
-template <typename TN_, typename TA, typename TH>
-void
-S_<TN_, TA, TH>::deepConstruct(PlanControl& HFSM_IF_LOGGER(control)) {
-	HFSM_ASSERT(!control._planData.tasksSuccesses.template get<STATE_ID>());
-	HFSM_ASSERT(!control._planData.tasksFailures .template get<STATE_ID>());
+////////////////////////////////////////////////////////////////////////////////
 
-	HFSM_LOG_STATE_METHOD(&Head::enter,
-						  control.context(),
-						  Method::CONSTRUCT);
+template <LongIndex NSC>
+TimerWheelT<NSC>::TimerWheelT() {
+	for (LongIndex i = 0; i < STATE_COUNT; ++i)
+		_timers[i].level = INVALID_LEVEL;
 
-	_headBox.construct();
+	for (unsigned l = 0; l < LEVELS; ++l) {
+		for (unsigned s = 0; s < SLOTS; ++s)
+			_heads[l][s] = INVALID_STATE_ID;
+
+		_occupied[l] = 0;
+	}
 }
 
-//------------------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN_, typename TA, typename TH>
+template <LongIndex NSC>
 void
-S_<TN_, TA, TH>::deepEnter(PlanControl& control) {
-	HFSM_LOG_STATE_METHOD(&Head::enter,
-						  control.context(),
-						  Method::ENTER);
+TimerWheelT<NSC>::set(const StateID origin,
+					  const Request::Type type,
+					  const StateID target,
+					  const uint32_t delay)
+{
+	HFSM_ASSERT(origin < STATE_COUNT);
+	HFSM_ASSERT(target < STATE_COUNT);
 
-	ScopedOrigin origin{control, STATE_ID};
+	cancel(origin);
 
-	_headBox.get().widePreEnter(control.context());
-	_headBox.get().		  enter(control);
+	Timer& timer = _timers[origin];
+	timer.deadline = _now + (delay == 0 ? 1 : delay < MAX_DELAY ? delay : MAX_DELAY);
+	timer.target   = target;
+	timer.type	   = (uint8_t) type;
+
+	link(origin);
+	++_armed;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN_, typename TA, typename TH>
+template <LongIndex NSC>
 void
-S_<TN_, TA, TH>::deepReenter(PlanControl& control) {
-	HFSM_ASSERT(!control._planData.tasksSuccesses.template get<STATE_ID>());
-	HFSM_ASSERT(!control._planData.tasksFailures .template get<STATE_ID>());
+TimerWheelT<NSC>::cancel(const StateID origin) {
+	HFSM_ASSERT(origin < STATE_COUNT);
 
-	HFSM_LOG_STATE_METHOD(&Head::reenter,
-						  control.context(),
-						  Method::REENTER);
+	if (_timers[origin].level != INVALID_LEVEL) {
+		unlink(origin);
+		--_armed;
+	}
+}
 
-	ScopedOrigin origin{control, STATE_ID};
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	_headBox.destruct ();
-	_headBox.construct();
+template <LongIndex NSC>
+bool
+TimerWheelT<NSC>::pending(const StateID origin) const {
+	HFSM_ASSERT(origin < STATE_COUNT);
 
-	_headBox.get().widePreReenter(control.context());
-	_headBox.get().		  reenter(control);
+	return _timers[origin].level != INVALID_LEVEL;
 }
 
-//------------------------------------------------------------------------------
-
-template <typename TN_, typename TA, typename TH>
-Status
-S_<TN_, TA, TH>::deepUpdate(FullControl& control) {
-	HFSM_LOG_STATE_METHOD(&Head::update,
-						  control.context(),
-						  Method::UPDATE);
-
-	ScopedOrigin origin{control, STATE_ID};
-
-	_headBox.get().widePreUpdate(control.context());
-	_headBox.get().		  update(control);
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	return control._status;
+template <LongIndex NSC>
+uint32_t
+TimerWheelT<NSC>::remaining(const StateID origin) const {
+	return pending(origin) ? _timers[origin].deadline - _now : 0;
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TN_, typename TA, typename TH>
-template <typename TEvent>
-Status
-S_<TN_, TA, TH>::deepReact(FullControl& control,
-						   const TEvent& event)
+template <LongIndex NSC>
+template <typename TRequests, typename TRegistry>
+void
+TimerWheelT<NSC>::advance(TRequests& requests,
+						  const TRegistry& registry)
 {
-	auto reaction = static_cast<void(Head::*)(const TEvent&, FullControl&)>(&Head::react);
-	HFSM_LOG_STATE_METHOD(reaction,
-						  control.context(),
-						  Method::REACT);
-
-	ScopedOrigin origin{control, STATE_ID};
-
-	_headBox.get().widePreReact(event, control.context());
-	(_headBox.get().*reaction) (event, control);				//_headBox.get().react(event, control);
-
-	return control._status;
-}
+	++_now;
 
-//------------------------------------------------------------------------------
+	if (!_armed)
+		return;
 
-template <typename TN_, typename TA, typename TH>
-bool
-S_<TN_, TA, TH>::deepExitGuard(GuardControl& control) {
-	HFSM_LOG_STATE_METHOD(&Head::exitGuard,
-						  control.context(),
-						  Method::EXIT_GUARD);
+	for (unsigned l = LEVELS - 1; l > 0; --l)
+		if ((_now & ((1u << (SLOT_BITS * l)) - 1)) == 0)
+			cascade(l);
 
-	ScopedOrigin origin{control, STATE_ID};
+	const unsigned slot = _now & (SLOTS - 1);
 
-	const bool cancelledBefore = control._cancelled;
+	while (_occupied[0] & (1ull << slot)) {
+		const StateID origin = _heads[0][slot];
+		Timer& timer = _timers[origin];
 
-	_headBox.get().widePreExitGuard(control.context());
-	_headBox.get().		  exitGuard(control);
+		unlink(origin);
 
-	return !cancelledBefore && control._cancelled;
+		if (!registry.isActive(origin))
+			--_armed;
+		else if (requests.count() < requests.CAPACITY) {
+			requests.append(Request{(Request::Type) timer.type, timer.target, origin});
+			--_armed;
+		} else {
+			// re-linked into the next slot, out of this loop's reach
+			timer.deadline = _now + 1;
+			link(origin);
+		}
+	}
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TN_, typename TA, typename TH>
+template <LongIndex NSC>
 void
-S_<TN_, TA, TH>::deepExit(PlanControl& control) {
-	HFSM_LOG_STATE_METHOD(&Head::exit,
-						  control.context(),
-						  Method::EXIT);
+TimerWheelT<NSC>::link(const StateID origin) {
+	Timer& timer = _timers[origin];
 
-	ScopedOrigin origin{control, STATE_ID};
+	const uint32_t delta = timer.deadline - _now;
 
-	// if you see..
-	// VS	 - error C2039:  'exit': is not a member of 'Blah'
-	// Clang - error : no member named 'exit' in 'Blah'
-	//
-	// .. inherit state 'Blah' from hfsm2::Machine::Instance::State
-	_headBox.get().		   exit(control);
-	_headBox.get().widePostExit(control.context());
-}
+	unsigned level = 0;
+	while (level < LEVELS - 1 && delta >= (1u << (SLOT_BITS * (level + 1))))
+		++level;
 
-//------------------------------------------------------------------------------
+	const unsigned slot = (timer.deadline >> (SLOT_BITS * level)) & (SLOTS - 1);
 
-template <typename TN_, typename TA, typename TH>
-void
-S_<TN_, TA, TH>::deepDestruct(PlanControl& control) {
-	HFSM_LOG_STATE_METHOD(&Head::exit,
-						  control.context(),
-						  Method::DESTRUCT);
+	StateID& head = _heads[level][slot];
 
-	_headBox.destruct();
+	timer.level = (uint8_t) level;
+	timer.slot	= (uint8_t) slot;
+	timer.prev	= INVALID_STATE_ID;
+	timer.next	= head;
 
-	control._planData.tasksSuccesses.template reset<STATE_ID>();
-	control._planData.tasksFailures .template reset<STATE_ID>();
+	if (head != INVALID_STATE_ID)
+		_timers[head].prev = origin;
+
+	head = origin;
+	_occupied[level] |= 1ull << slot;
 }
 
-//------------------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN_, typename TA, typename TH>
+template <LongIndex NSC>
 void
-S_<TN_, TA, TH>::wrapPlanSucceeded(FullControl& control) {
-	HFSM_LOG_STATE_METHOD(&Head::planSucceeded,
-						  control.context(),
-						  Method::PLAN_SUCCEEDED);
+TimerWheelT<NSC>::unlink(const StateID origin) {
+	Timer& timer = _timers[origin];
+	HFSM_ASSERT(timer.level < LEVELS);
 
-	ScopedOrigin origin{control, STATE_ID};
+	if (timer.prev != INVALID_STATE_ID)
+		_timers[timer.prev].next = timer.next;
+	else {
+		_heads[timer.level][timer.slot] = timer.next;
 
-	_headBox.get().planSucceeded(control);
+		if (timer.next == INVALID_STATE_ID)
+			_occupied[timer.level] &= ~(1ull << timer.slot);
+	}
+
+	if (timer.next != INVALID_STATE_ID)
+		_timers[timer.next].prev = timer.prev;
+
+	timer.level = INVALID_LEVEL;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN_, typename TA, typename TH>
+template <LongIndex NSC>
 void
-S_<TN_, TA, TH>::wrapPlanFailed(FullControl& control) {
-	HFSM_LOG_STATE_METHOD(&Head::planFailed,
-						  control.context(),
-						  Method::PLAN_FAILED);
+TimerWheelT<NSC>::cascade(const unsigned level) {
+	const unsigned slot = (_now >> (SLOT_BITS * level)) & (SLOTS - 1);
 
-	ScopedOrigin origin{control, STATE_ID};
+	StateID origin = _heads[level][slot];
 
-	_headBox.get().planFailed(control);
-}
+	_heads[level][slot] = INVALID_STATE_ID;
+	_occupied[level] &= ~(1ull << slot);
 
-//------------------------------------------------------------------------------
+	while (origin != INVALID_STATE_ID) {
+		const StateID next = _timers[origin].next;
 
-template <typename TN_, typename TA, typename TH>
-typename S_<TN_, TA, TH>::Rank
-S_<TN_, TA, TH>::wrapRank(Control& control) {
-	HFSM_LOG_STATE_METHOD(&Head::rank,
-						  control.context(),
-						  Method::RANK);
+		link(origin);
 
-	return _headBox.get().rank(static_cast<const Control&>(control));
+		origin = next;
+	}
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-
-template <typename TN_, typename TA, typename TH>
-typename S_<TN_, TA, TH>::Utility
-S_<TN_, TA, TH>::wrapUtility(Control& control) {
-	HFSM_LOG_STATE_METHOD(&Head::utility,
-						  control.context(),
-						  Method::UTILITY);
+////////////////////////////////////////////////////////////////////////////////
 
-	return _headBox.get().utility(static_cast<const Control&>(control));
+}
 }
 
-//------------------------------------------------------------------------------
-
-template <typename TN_, typename TA, typename TH>
-typename S_<TN_, TA, TH>::UP
-S_<TN_, TA, TH>::deepReportChange(Control& control) {
-	const Utility utility = wrapUtility(control);
+#endif
 
-	const Parent parent = stateParent(control);
+namespace hfsm2 {
+namespace detail {
 
-	return {utility, parent.prong};
-}
+////////////////////////////////////////////////////////////////////////////////
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template <typename TArgs>
+class ControlT {
+	template <typename, typename, typename>
+	friend struct S_;
 
-template <typename TN_, typename TA, typename TH>
-typename S_<TN_, TA, TH>::UP
-S_<TN_, TA, TH>::deepReportUtilize(Control& control) {
-	const Utility utility = wrapUtility(control);
-	const Parent  parent  = stateParent(control);
+	template <typename, typename, Strategy, typename, typename...>
+	friend struct C_;
 
-	return {utility, parent.prong};
-}
+	template <typename, typename, Execution, typename, typename...>
+	friend struct O_;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	template <typename, typename>
+	friend class R_;
 
-template <typename TN_, typename TA, typename TH>
-typename S_<TN_, TA, TH>::Rank
-S_<TN_, TA, TH>::deepReportRank(Control& control) {
-	return wrapRank(control);
-}
+	template <typename>
+	friend class RuntimeR_;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	using Args			= TArgs;
 
-template <typename TN_, typename TA, typename TH>
-typename S_<TN_, TA, TH>::Utility
-S_<TN_, TA, TH>::deepReportRandomize(Control& control) {
-	return wrapUtility(control);
-}
+protected:
+	using Context		= typename Args::Context;
+	using RNG			= typename Args::RNG;
+	using Logger		= typename Args::Logger;
+	HFSM_IF_PROFILER(using Profiler = typename Args::Profiler);
+	HFSM_IF_STATISTICS(using Statistics = typename Args::Statistics);
+	HFSM_IF_TIMERS(using Timers = typename Args::Timers);
+	using StateList		= typename Args::StateList;
+	using RegionList	= typename Args::RegionList;
 
-//------------------------------------------------------------------------------
+	using Registry		= RegistryT<Args>;
+	using PlanData		= PlanDataT<Args>;
+	using ConstPlan		= ConstPlanT<Args>;
 
-#ifdef HFSM_ENABLE_STRUCTURE_REPORT
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN_, typename TA, typename TH>
-const char*
-S_<TN_, TA, TH>::name() {
-	if (HeadBox::isBare())
-		return "";
-	else {
-		const std::type_index type = typeid(Head);
-		const char* const raw = type.name();
+	struct Region {
+		HFSM_INLINE Region(ControlT& control,
+						   const RegionID id);
 
-	#if defined(_MSC_VER)
+		HFSM_INLINE ~Region();
 
-		auto first =
-			raw[0] == 's' ? 7 : // Struct
-			raw[0] == 'c' ? 6 : // Class
-							0;
+		ControlT& control;
+		const RegionID prevId;
+	};
 
-		for (auto c = first; raw[c]; ++c)
-			if (raw[c] == ':')
-				first = c + 1;
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-		return raw + first;
+	HFSM_INLINE ControlT(Context& context,
+						 RNG& rng,
+						 Registry& registry,
+						 PlanData& planData,
+						 Logger* const HFSM_IF_LOGGER(logger)
+						 HFSM_IF_PROFILER(, Profiler* const profiler)
+						 HFSM_IF_STATISTICS(, Statistics* const statistics)
+						 HFSM_IF_TIMERS(, Timers& timers))
+		: _context{context}
+		, _rng{rng}
+		, _registry{registry}
+		, _planData{planData}
+		HFSM_IF_LOGGER(, _logger{logger})
+		HFSM_IF_PROFILER(, _profiler{profiler})
+		HFSM_IF_STATISTICS(, _statistics{statistics})
+		HFSM_IF_TIMERS(, _timers{timers})
+	{}
 
-	#elif defined(__clang__) || defined(__GNUC__) || defined(__GNUG__)
 
-		return raw;
+	HFSM_INLINE void setRegion(const RegionID id);
+	HFSM_INLINE void resetRegion(const RegionID id);
 
-	#else
+public:
+	template <typename T>
+	static constexpr StateID  stateId()					{ return			StateList ::template index<T>();	}
 
-		return raw;
+	template <typename T>
+	static constexpr RegionID regionId()				{ return (RegionID) RegionList::template index<T>();	}
 
-	#endif
-	}
-}
+	HFSM_INLINE Context& _()								{ return _context;									}
+	HFSM_INLINE Context& context()							{ return _context;									}
 
-//------------------------------------------------------------------------------
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN_, typename TA, typename TH>
-void
-S_<TN_, TA, TH>::deepGetNames(const LongIndex parent,
-							  const RegionType region,
-							  const ShortIndex depth,
-							  StructureStateInfos& _stateInfos) const
-{
-	_stateInfos.append(StructureStateInfo{parent, region, depth, name()});
-}
+	HFSM_INLINE bool isActive   (const StateID id) const	{ return _registry.isActive   (id);					}
+	HFSM_INLINE bool isResumable(const StateID id) const	{ return _registry.isResumable(id);					}
 
-#endif
+	HFSM_INLINE bool isScheduled(const StateID id) const	{ return isResumable(id);							}
 
-///////////////////////////////////////////////////////////////////////////////
+	template <typename TState>
+	HFSM_INLINE bool isActive() const						{ return isActive	(stateId<TState>());			}
 
-}
-}
+	template <typename TState>
+	HFSM_INLINE bool isResumable() const					{ return isResumable(stateId<TState>());			}
 
-namespace hfsm2 {
-namespace detail {
+	template <typename TState>
+	HFSM_INLINE bool isScheduled() const					{ return isResumable(stateId<TState>());			}
 
-////////////////////////////////////////////////////////////////////////////////
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename>
-struct SI_;
+	HFSM_INLINE ConstPlan plan() const						{ return ConstPlan{_planData, _regionId};			}
+	HFSM_INLINE ConstPlan plan(const RegionID id) const		{ return ConstPlan{_planData, id};					}
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	template <typename TRegion>
+	HFSM_INLINE ConstPlan plan()							{ return ConstPlan{_planData, regionId<TRegion>()};	}
 
-template <Strategy, typename, typename...>
-struct CI_;
-
-template <typename...>
-struct CSI_;
+	template <typename TRegion>
+	HFSM_INLINE ConstPlan plan() const						{ return ConstPlan{_planData, regionId<TRegion>()};	}
 
-template <typename TInitial, typename... TRemaining>
-struct CSI_<TInitial, TRemaining...>;
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TInitial>
-struct CSI_<TInitial>;
+#ifdef HFSM_ENABLE_COROUTINES
+	// Frame allocator of CoTask coroutines taking this control as an argument
+	HFSM_INLINE CoroutineArena& coroutineArena() {
+		HFSM_IF_PARALLEL(HFSM_ASSERT(!_planData.forked));
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+		return _planData.coroutines.arena();
+	}
+#endif
 
-template <typename, typename...>
-struct OI_;
+protected:
+#if defined HFSM_ENABLE_LOG_INTERFACE || defined HFSM_ENABLE_VERBOSE_DEBUG_LOG
+	HFSM_INLINE Logger* logger()							{ return _logger;									}
+#endif
 
-template <typename...>
-struct OSI_;
+#ifdef HFSM_ENABLE_PROFILER
+	HFSM_INLINE Profiler* profiler()						{ return _profiler;									}
+#endif
 
-template <typename TInitial, typename... TRemaining>
-struct OSI_<TInitial, TRemaining...>;
+#ifdef HFSM_ENABLE_STATISTICS
+	HFSM_INLINE Statistics* statistics()					{ return _statistics;								}
+#endif
 
-template <typename TInitial>
-struct OSI_<TInitial>;
+protected:
+	Context& _context;
+	RNG& _rng;
+	Registry& _registry;
+	PlanData& _planData;
+	RegionID _regionId = 0;
+	HFSM_IF_LOGGER(Logger* _logger);
+	HFSM_IF_PROFILER(Profiler* _profiler);
+	HFSM_IF_STATISTICS(Statistics* _statistics);
+	HFSM_IF_TIMERS(Timers& _timers);
+};
 
 //------------------------------------------------------------------------------
 
-template <typename...>
-struct WrapInfoT;
+template <typename TArgs>
+class PlanControlT
+	: public ControlT<TArgs>
+{
+	template <typename, typename, typename>
+	friend struct S_;
 
-template <typename TH>
-struct WrapInfoT<	 TH> {
-	using Type = SI_<TH>;
-};
+	template <typename, typename, Strategy, typename, typename...>
+	friend struct C_;
 
-template <Strategy SG, typename TH, typename... TS>
-struct WrapInfoT<	 CI_<SG, TH, TS...>> {
-	using Type =	 CI_<SG, TH, TS...>;
-};
+	template <typename, typename, Execution, typename, typename...>
+	friend struct O_;
 
-template <typename... TS>
-struct WrapInfoT<	 OI_<TS...>> {
-	using Type =	 OI_<TS...>;
-};
+	template <typename, typename>
+	friend class R_;
 
-template <typename... TS>
-using WrapInfo = typename WrapInfoT<TS...>::Type;
+	template <typename>
+	friend class RuntimeR_;
 
-//------------------------------------------------------------------------------
+	using Args			= TArgs;
 
-template <typename THead>
-struct SI_ final {
-	using Head				= THead;
-	using StateList			= ITL_<Head>;
-	using RegionList		= ITL_<>;
+protected:
+	using Control		= ControlT<Args>;
 
-	static constexpr ShortIndex WIDTH			= 1;
-	static constexpr LongIndex  REVERSE_DEPTH	= 1;
-	static constexpr ShortIndex COMPO_REGIONS	= 0;
-	static constexpr LongIndex  COMPO_PRONGS	= 0;
-	static constexpr ShortIndex ORTHO_REGIONS	= 0;
-	static constexpr ShortIndex ORTHO_UNITS		= 0;
+	using typename Control::StateList;
+	using typename Control::RegionList;
+	using typename Control::PlanData;
+	using typename Control::ConstPlan;
 
-	static constexpr LongIndex  ACTIVE_BITS		= 0;
-	static constexpr LongIndex  RESUMABLE_BITS	= 0;
+	using Plan			= PlanT<Args>;
 
-	static constexpr LongIndex  STATE_COUNT		= StateList::SIZE;
-	static constexpr ShortIndex REGION_COUNT	= RegionList::SIZE;
-};
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	struct Origin {
+		HFSM_INLINE Origin(PlanControlT& control_,
+						   const StateID id);
 
-template <typename TInitial, typename... TRemaining>
-struct CSI_<TInitial, TRemaining...> {
-	using Initial			= WrapInfo<TInitial>;
-	using Remaining			= CSI_<TRemaining...>;
-	using StateList			= Merge<typename Initial::StateList,  typename Remaining::StateList>;
-	using RegionList		= Merge<typename Initial::RegionList, typename Remaining::RegionList>;
+		HFSM_INLINE ~Origin();
 
-	static constexpr LongIndex  REVERSE_DEPTH	= Max<Initial::REVERSE_DEPTH,	Remaining::REVERSE_DEPTH>::VALUE;
-	static constexpr ShortIndex COMPO_REGIONS	=	  Initial::COMPO_REGIONS  + Remaining::COMPO_REGIONS;
-	static constexpr LongIndex  COMPO_PRONGS	=	  Initial::COMPO_PRONGS   + Remaining::COMPO_PRONGS;
-	static constexpr ShortIndex ORTHO_REGIONS	=	  Initial::ORTHO_REGIONS  + Remaining::ORTHO_REGIONS;
-	static constexpr ShortIndex ORTHO_UNITS		=	  Initial::ORTHO_UNITS    + Remaining::ORTHO_UNITS;
+		PlanControlT& control;
+		const StateID prevId;
+	};
 
-	static constexpr LongIndex  ACTIVE_BITS		= Max<Initial::ACTIVE_BITS,		Remaining::ACTIVE_BITS>::VALUE;
-	static constexpr LongIndex  RESUMABLE_BITS	=	  Initial::RESUMABLE_BITS + Remaining::RESUMABLE_BITS;
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	static constexpr LongIndex  STATE_COUNT		= StateList::SIZE;
-	static constexpr ShortIndex REGION_COUNT	= RegionList::SIZE;
-};
+	struct Region {
+		HFSM_INLINE Region(PlanControlT& control,
+						   const RegionID id,
+						   const StateID index,
+						   const LongIndex size);
 
-template <typename TInitial>
-struct CSI_<TInitial> {
-	using Initial			= WrapInfo<TInitial>;
-	using StateList			= typename Initial::StateList;
-	using RegionList		= typename Initial::RegionList;
+		HFSM_INLINE ~Region();
 
-	static constexpr LongIndex  REVERSE_DEPTH	= Initial::REVERSE_DEPTH;
-	static constexpr ShortIndex COMPO_REGIONS	= Initial::COMPO_REGIONS;
-	static constexpr LongIndex  COMPO_PRONGS	= Initial::COMPO_PRONGS;
-	static constexpr ShortIndex ORTHO_REGIONS	= Initial::ORTHO_REGIONS;
-	static constexpr ShortIndex ORTHO_UNITS		= Initial::ORTHO_UNITS;
+		PlanControlT& control;
+		const RegionID prevId;
+		const LongIndex prevIndex;
+		const LongIndex prevSize;
+	};
 
-	static constexpr LongIndex  ACTIVE_BITS		= Initial::ACTIVE_BITS;
-	static constexpr LongIndex  RESUMABLE_BITS	= Initial::RESUMABLE_BITS;
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	static constexpr LongIndex  STATE_COUNT		= StateList::SIZE;
-	static constexpr ShortIndex REGION_COUNT	= RegionList::SIZE;
-};
+	using Control::Control;
 
-template <Strategy TStrategy, typename THead, typename... TSubStates>
-struct CI_ final {
-	static constexpr Strategy STRATEGY = TStrategy;
+	HFSM_INLINE void setOrigin  (const StateID id);
+	HFSM_INLINE void resetOrigin(const StateID id);
 
-	using Head				= THead;
-	using HeadInfo			= SI_<Head>;
-	using SubStates			= CSI_<TSubStates...>;
-	using StateList			= Merge<typename HeadInfo::StateList, typename SubStates::StateList>;
-	using RegionList		= Merge<typename HeadInfo::StateList, typename SubStates::RegionList>;
+	HFSM_INLINE void setRegion  (const RegionID id, const StateID index, const LongIndex size);
+	HFSM_INLINE void resetRegion(const RegionID id, const StateID index, const LongIndex size);
 
-	static constexpr ShortIndex	WIDTH			= sizeof...(TSubStates);
-	static constexpr LongIndex	REVERSE_DEPTH	= SubStates::REVERSE_DEPTH + 1;
-	static constexpr ShortIndex	COMPO_REGIONS	= SubStates::COMPO_REGIONS + 1;
-	static constexpr LongIndex	COMPO_PRONGS	= SubStates::COMPO_PRONGS + WIDTH;
-	static constexpr ShortIndex	ORTHO_REGIONS	= SubStates::ORTHO_REGIONS;
-	static constexpr ShortIndex	ORTHO_UNITS		= SubStates::ORTHO_UNITS;
+#ifdef HFSM_ENABLE_TIMERS
+	HFSM_INLINE void setTimer(const Request::Type type, const StateID id, const uint32_t ticks);
+#endif
 
-	static constexpr LongIndex	WIDTH_BITS		= bitWidth(WIDTH);
-	static constexpr LongIndex  ACTIVE_BITS		= SubStates::ACTIVE_BITS	+ WIDTH_BITS;
-	static constexpr LongIndex  RESUMABLE_BITS	= SubStates::RESUMABLE_BITS + WIDTH_BITS + 1;
+public:
+	using Control::stateId;
+	using Control::regionId;
 
-	static constexpr LongIndex	STATE_COUNT		= StateList::SIZE;
-	static constexpr ShortIndex	REGION_COUNT	= RegionList::SIZE;
-};
+	using Control::_;
+	using Control::context;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	using Control::isActive;
+	using Control::isResumable;
+	using Control::isScheduled;
 
-template <typename TInitial, typename... TRemaining>
-struct OSI_<TInitial, TRemaining...> {
-	using Initial			= WrapInfo<TInitial>;
-	using Remaining			= OSI_<TRemaining...>;
-	using StateList			= Merge<typename Initial::StateList,  typename Remaining::StateList>;
-	using RegionList		= Merge<typename Initial::RegionList, typename Remaining::RegionList>;
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	static constexpr LongIndex  REVERSE_DEPTH	= Max<Initial::REVERSE_DEPTH,	Remaining::REVERSE_DEPTH>::VALUE;
-	static constexpr ShortIndex COMPO_REGIONS	=	  Initial::COMPO_REGIONS  + Remaining::COMPO_REGIONS;
-	static constexpr LongIndex  COMPO_PRONGS	=	  Initial::COMPO_PRONGS   + Remaining::COMPO_PRONGS;
-	static constexpr ShortIndex ORTHO_REGIONS	=	  Initial::ORTHO_REGIONS  + Remaining::ORTHO_REGIONS;
-	static constexpr ShortIndex ORTHO_UNITS		=	  Initial::ORTHO_UNITS    + Remaining::ORTHO_UNITS;
+	HFSM_INLINE		 Plan plan()							{ return	  Plan{_planData, _regionId};			}
+	HFSM_INLINE ConstPlan plan() const						{ return ConstPlan{_planData, _regionId};			}
 
-	static constexpr LongIndex  ACTIVE_BITS		=	  Initial::ACTIVE_BITS    + Remaining::ACTIVE_BITS;
-	static constexpr LongIndex  RESUMABLE_BITS	=	  Initial::RESUMABLE_BITS + Remaining::RESUMABLE_BITS;
-};
+	HFSM_INLINE		 Plan plan(const RegionID id)			{ return	  Plan{_planData, id};					}
+	HFSM_INLINE ConstPlan plan(const RegionID id) const		{ return ConstPlan{_planData, id};					}
 
-template <typename TInitial>
-struct OSI_<TInitial> {
-	using Initial			= WrapInfo<TInitial>;
-	using StateList			= typename Initial::StateList;
-	using RegionList		= typename Initial::RegionList;
+	template <typename TRegion>
+	HFSM_INLINE		 Plan plan()		{ return	  Plan{_planData, Control::template regionId<TRegion>()};	}
 
-	static constexpr LongIndex  REVERSE_DEPTH	= Initial::REVERSE_DEPTH;
-	static constexpr ShortIndex COMPO_REGIONS	= Initial::COMPO_REGIONS;
-	static constexpr LongIndex  COMPO_PRONGS	= Initial::COMPO_PRONGS;
-	static constexpr ShortIndex ORTHO_REGIONS	= Initial::ORTHO_REGIONS;
-	static constexpr ShortIndex ORTHO_UNITS		= Initial::ORTHO_UNITS;
+	template <typename TRegion>
+	HFSM_INLINE ConstPlan plan() const	{ return ConstPlan{_planData, Control::template regionId<TRegion>()};	}
 
-	static constexpr LongIndex  ACTIVE_BITS		= Initial::ACTIVE_BITS;
-	static constexpr LongIndex  RESUMABLE_BITS	= Initial::RESUMABLE_BITS;
-};
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename THead, typename... TSubStates>
-struct OI_ final {
-	using Head				= THead;
-	using HeadInfo			= SI_<Head>;
-	using SubStates			= OSI_<TSubStates...>;
-	using StateList			= Merge<typename HeadInfo::StateList, typename SubStates::StateList>;
-	using RegionList		= Merge<typename HeadInfo::StateList, typename SubStates::RegionList>;
+#ifdef HFSM_ENABLE_TIMERS
+	// Request a transition on behalf of the current state after 'ticks' update() calls
+	//  Each state owns a single timer, arming it again replaces the previous one
+	//  The timer is cancelled when the state exits
+	HFSM_INLINE void changeAfter   (const StateID id, const uint32_t ticks)	{ setTimer(Request::CHANGE,	 id, ticks);	}
+	HFSM_INLINE void restartAfter  (const StateID id, const uint32_t ticks)	{ setTimer(Request::RESTART,	 id, ticks);	}
+	HFSM_INLINE void resumeAfter   (const StateID id, const uint32_t ticks)	{ setTimer(Request::RESUME,	 id, ticks);	}
+	HFSM_INLINE void utilizeAfter  (const StateID id, const uint32_t ticks)	{ setTimer(Request::UTILIZE,	 id, ticks);	}
+	HFSM_INLINE void randomizeAfter(const StateID id, const uint32_t ticks)	{ setTimer(Request::RANDOMIZE, id, ticks);	}
 
-	static constexpr ShortIndex WIDTH			= sizeof...(TSubStates);
-	static constexpr LongIndex  REVERSE_DEPTH	= SubStates::REVERSE_DEPTH + 1;
-	static constexpr ShortIndex COMPO_REGIONS	= SubStates::COMPO_REGIONS;
-	static constexpr LongIndex  COMPO_PRONGS	= SubStates::COMPO_PRONGS;
-	static constexpr ShortIndex ORTHO_REGIONS	= SubStates::ORTHO_REGIONS + 1;
-	static constexpr ShortIndex ORTHO_UNITS		= SubStates::ORTHO_UNITS + (WIDTH + 7) / 8;
+	template <typename T>
+	HFSM_INLINE void changeAfter   (const uint32_t ticks)	{ changeAfter	(Control::template stateId<T>(), ticks);	}
 
-	static constexpr LongIndex  ACTIVE_BITS		= SubStates::ACTIVE_BITS;
-	static constexpr LongIndex  RESUMABLE_BITS	= SubStates::RESUMABLE_BITS;
+	template <typename T>
+	HFSM_INLINE void restartAfter  (const uint32_t ticks)	{ restartAfter	(Control::template stateId<T>(), ticks);	}
 
-	static constexpr LongIndex  STATE_COUNT		= StateList::SIZE;
-	static constexpr ShortIndex REGION_COUNT	= RegionList::SIZE;
-};
+	template <typename T>
+	HFSM_INLINE void resumeAfter   (const uint32_t ticks)	{ resumeAfter	(Control::template stateId<T>(), ticks);	}
 
-////////////////////////////////////////////////////////////////////////////////
+	template <typename T>
+	HFSM_INLINE void utilizeAfter  (const uint32_t ticks)	{ utilizeAfter	(Control::template stateId<T>(), ticks);	}
 
-template <typename TContext,
-		  typename TConfig,
-		  typename TStateList,
-		  typename TRegionList,
-		  LongIndex NCompoCount,
-		  LongIndex NOrthoCount,
-		  LongIndex NOrthoUnits,
-		  LongIndex NSerialBits,
-		  LongIndex NTaskCapacity>
-struct ArgsT final {
-	using Context	 = TContext;
+	template <typename T>
+	HFSM_INLINE void randomizeAfter(const uint32_t ticks)	{ randomizeAfter(Control::template stateId<T>(), ticks);	}
 
-	using Config_	 = TConfig;
-	using Rank		 = typename Config_::Rank;
-	using Utility	 = typename Config_::Utility;
-	using RNG		 = typename Config_::RNG;
-	using UP		 = typename Config_::UP;
-	using Logger	 = typename Config_::Logger;
+	HFSM_INLINE void cancelTimer();
+
+	HFSM_INLINE bool isTimerPending() const					{ return _timers.pending(_originId);				}
+
+	// Ticks left until the current state's timer fires, 0 if it isn't armed
+	HFSM_INLINE uint32_t timerRemaining() const				{ return _timers.remaining(_originId);				}
+#endif
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_PAYLOADS
+	// Payload of the pending transition into the current state,
+	//  readable from entryGuard() and enter()
+	//  nullptr if there is none, or it was sent with a different type
+	template <typename TPayload>
+	HFSM_INLINE const TPayload* payload() const	{ return _planData.payloads.template find<TPayload>(_originId);	}
+#endif
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_COROUTINES
+	using Control::coroutineArena;
+
+	// Attach 'task' to the current state, replacing the one it had
+	//  The task runs up to its first co_await right away, and is destroyed when the state exits
+	//  Its completion counts as succeed() of the state, reported from the next update() / react() of the state
+	//  Returns false if the task's frame didn't fit into the arena
+	HFSM_INLINE bool spawn(CoTask&& task);
+
+	HFSM_INLINE bool isTaskRunning() const					{ return _planData.coroutines.running(_originId);					}
+#endif
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+protected:
+	using Control::_planData;
+	using Control::_regionId;
+	HFSM_IF_LOGGER(using Control::_logger);
+	HFSM_IF_TIMERS(using Control::_timers);
+
+	StateID _originId = 0;
+	StateID _regionIndex = 0;
+	LongIndex _regionSize = StateList::SIZE;
+	Status _status;
+};
+
+//------------------------------------------------------------------------------
+
+template <typename TArgs>
+class FullControlT
+	: public PlanControlT<TArgs>
+{
+	template <typename, typename, typename>
+	friend struct S_;
+
+	template <typename, typename, Strategy, typename, typename...>
+	friend struct C_;
+
+	template <typename, typename, Execution, typename, typename...>
+	friend struct O_;
+
+	template <typename, typename>
+	friend class R_;
+
+	template <typename>
+	friend class RuntimeR_;
+
+	using Args			= TArgs;
+
+protected:
+	using PlanControl	= PlanControlT<Args>;
+
+	using typename PlanControl::Context;
+	using typename PlanControl::RNG;
+	using typename PlanControl::Logger;
+	HFSM_IF_PROFILER(using typename PlanControl::Profiler);
+	HFSM_IF_STATISTICS(using typename PlanControl::Statistics);
+	HFSM_IF_TIMERS(using typename PlanControl::Timers);
+	using typename PlanControl::StateList;
+	using typename PlanControl::RegionList;
+	using typename PlanControl::PlanData;
+
+	using typename PlanControl::Plan;
+	using typename PlanControl::Origin;
+
+	using Registry		= RegistryT<Args>;
+	using Requests		= RequestsT<Args::COMPO_REGIONS>;
+
+#ifdef HFSM_ENABLE_PARALLEL
+	using TasksBits		= BitArray<StateID, StateList::SIZE>;
+
+	// Task statuses set by a ParallelOrthogonal<> sub-state while it runs
+	struct ProngTasks {
+		TasksBits successes;
+		TasksBits failures;
+	};
+#endif
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	struct Lock {
+		HFSM_INLINE Lock(FullControlT& control_);
+		HFSM_INLINE ~Lock();
+
+		FullControlT* const control;
+	};
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE FullControlT(Context& context,
+							 RNG& rng,
+							 Registry& registry,
+							 PlanData& planData,
+							 Requests& requests,
+							 Logger* const logger
+							 HFSM_IF_PROFILER(, Profiler* const profiler)
+							 HFSM_IF_STATISTICS(, Statistics* const statistics)
+							 HFSM_IF_TIMERS(, Timers& timers))
+		: PlanControl{context, rng, registry, planData, logger
+					  HFSM_IF_PROFILER(, profiler)
+					  HFSM_IF_STATISTICS(, statistics)
+					  HFSM_IF_TIMERS(, timers)}
+		, _requests{requests}
+	{}
+
+#ifdef HFSM_ENABLE_PARALLEL
+	// Control of a ParallelOrthogonal<> sub-state, collecting into its own buffers
+	HFSM_INLINE FullControlT(const FullControlT& control,
+							 Requests& requests,
+							 ProngTasks& tasks)
+		: PlanControl{control}
+		, _requests{requests}
+		, _locked{control._locked}
+		, _prongTasks{&tasks}
+	{}
+#endif
+
+	HFSM_INLINE void setSucceeded(const StateID stateId);
+	HFSM_INLINE void setFailed	 (const StateID stateId);
+	HFSM_INLINE bool hasSucceeded(const StateID stateId) const;
+
+	template <typename TState>
+	Status updatePlan(TState& headState, const Status subStatus);
+
+	template <typename TState>
+	Status buildPlanStatus();
+
+public:
+	using PlanControl::stateId;
+	using PlanControl::regionId;
+
+	using PlanControl::_;
+	using PlanControl::context;
+
+	using PlanControl::isActive;
+	using PlanControl::isResumable;
+	using PlanControl::isScheduled;
+
+	using PlanControl::plan;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE void changeTo (const StateID id);
+	HFSM_INLINE void restart  (const StateID id);
+	HFSM_INLINE void resume	  (const StateID id);
+	HFSM_INLINE void utilize  (const StateID id);
+	HFSM_INLINE void randomize(const StateID id);
+	HFSM_INLINE void schedule (const StateID id);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	// Clang trips over 'stateId<>()', so give it a hint it comes from ControlT<>
+
+	template <typename T>
+	HFSM_INLINE void changeTo ()							{ changeTo (PlanControl::template stateId<T>());	}
+
+	template <typename T>
+	HFSM_INLINE void restart  ()							{ restart  (PlanControl::template stateId<T>());	}
+
+	template <typename T>
+	HFSM_INLINE void resume   ()							{ resume   (PlanControl::template stateId<T>());	}
+
+	template <typename T>
+	HFSM_INLINE void utilize  ()							{ utilize  (PlanControl::template stateId<T>());	}
+
+	template <typename T>
+	HFSM_INLINE void randomize()							{ randomize(PlanControl::template stateId<T>());	}
+
+	template <typename T>
+	HFSM_INLINE void schedule ()							{ schedule (PlanControl::template stateId<T>());	}
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_PAYLOADS
+	// Transition carrying 'payload' to the destination, copied inline into a slot
+	//  sized by ConfigT<>::PayloadSizeN<>, dropped if the transition is cancelled
+	//  With all slots taken, asserts and doesn't request the transition
+	template <typename TPayload>
+	HFSM_INLINE void changeTo (const StateID id, const TPayload& payload);
+
+	template <typename T, typename TPayload>
+	HFSM_INLINE void changeTo (const TPayload& payload)		{ changeTo (PlanControl::template stateId<T>(), payload);	}
+#endif
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE void succeed();
+	HFSM_INLINE void fail();
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+protected:
+	using PlanControl::_planData;
+	using PlanControl::_regionId;
+	HFSM_IF_LOGGER(using PlanControl::_logger);
+
+	using PlanControl::_originId;
+	using PlanControl::_regionIndex;
+	using PlanControl::_regionSize;
+	using PlanControl::_status;
+
+	Requests& _requests;
+	bool _locked = false;
+
+	HFSM_IF_PARALLEL(ProngTasks* const _prongTasks = nullptr);
+};
+
+//------------------------------------------------------------------------------
+
+template <typename TArgs>
+class GuardControlT final
+	: public FullControlT<TArgs>
+{
+	template <typename, typename, typename>
+	friend struct S_;
+
+	template <typename, typename>
+	friend class R_;
+
+	template <typename>
+	friend class RuntimeR_;
+
+	using Args			= TArgs;
+	using FullControl	= FullControlT<Args>;
+
+	using typename FullControl::Context;
+	using typename FullControl::RNG;
+	using typename FullControl::Logger;
+	HFSM_IF_PROFILER(using typename FullControl::Profiler);
+	HFSM_IF_STATISTICS(using typename FullControl::Statistics);
+	HFSM_IF_TIMERS(using typename FullControl::Timers);
+	using typename FullControl::StateList;
+	using typename FullControl::RegionList;
+	using typename FullControl::PlanData;
+
+	using typename FullControl::Registry;
+
+protected:
+	using Requests		= RequestsT<Args::COMPO_REGIONS>;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+private:
+	HFSM_INLINE GuardControlT(Context& context,
+							  RNG& rng,
+							  Registry& registry,
+							  PlanData& planData,
+							  Requests& requests,
+							  const Requests& pendingChanges,
+							  Logger* const logger
+							  HFSM_IF_PROFILER(, Profiler* const profiler)
+							  HFSM_IF_STATISTICS(, Statistics* const statistics)
+							  HFSM_IF_TIMERS(, Timers& timers))
+		: FullControl{context, rng, registry, planData, requests, logger
+					  HFSM_IF_PROFILER(, profiler)
+					  HFSM_IF_STATISTICS(, statistics)
+					  HFSM_IF_TIMERS(, timers)}
+		, _pending{pendingChanges}
+	{}
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+public:
+	using FullControl::stateId;
+	using FullControl::regionId;
+
+	using FullControl::_;
+	using FullControl::context;
+
+	using FullControl::isActive;
+	using FullControl::isResumable;
+	using FullControl::isScheduled;
+
+	using FullControl::plan;
+
+	using FullControl::changeTo;
+	using FullControl::restart;
+	using FullControl::resume;
+	using FullControl::utilize;
+	using FullControl::randomize;
+	using FullControl::schedule;
+	using FullControl::succeed;
+	using FullControl::fail;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE bool isPendingChange(const StateID id) const	{ return _registry.isPendingChange(id);	}
+	HFSM_INLINE bool isPendingEnter	(const StateID id) const	{ return _registry.isPendingEnter (id);	}
+	HFSM_INLINE bool isPendingExit	(const StateID id) const	{ return _registry.isPendingExit  (id);	}
+
+	template <typename TState>
+	HFSM_INLINE bool isPendingChange()		{ return isPendingChange(FullControl::template stateId<TState>());	}
+
+	template <typename TState>
+	HFSM_INLINE bool isPendingEnter()		{ return isPendingEnter (FullControl::template stateId<TState>());	}
+
+	template <typename TState>
+	HFSM_INLINE bool isPendingExit()		{ return isPendingExit  (FullControl::template stateId<TState>());	}
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE void cancelPendingTransitions();
+
+	HFSM_INLINE const Requests& pendingTransitions() const		{ return _pending;								}
+
+private:
+	HFSM_IF_LOGGER(using FullControl::_logger);
+
+	using FullControl::_registry;
+	using FullControl::_originId;
+
+	bool _cancelled = false;
+	const Requests& _pending;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TArgs>
+ControlT<TArgs>::Region::Region(ControlT& control_,
+								const RegionID id)
+	: control{control_}
+	, prevId{control._regionId}
+{
+	control.setRegion(id);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TArgs>
+ControlT<TArgs>::Region::~Region() {
+	control.resetRegion(prevId);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TArgs>
+void
+ControlT<TArgs>::setRegion(const RegionID id) {
+	HFSM_ASSERT(_regionId <= id && id < RegionList::SIZE);
+
+	_regionId = id;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TArgs>
+void
+ControlT<TArgs>::resetRegion(const RegionID id) { //-V524
+	HFSM_ASSERT(id <= _regionId && _regionId < RegionList::SIZE);
+
+	_regionId = id;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TArgs>
+PlanControlT<TArgs>::Origin::Origin(PlanControlT& control_,
+									const StateID id)
+	: control{control_}
+	, prevId{control._originId}
+{
+	control.setOrigin(id);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TArgs>
+PlanControlT<TArgs>::Origin::~Origin() {
+	control.resetOrigin(prevId);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TArgs>
+PlanControlT<TArgs>::Region::Region(PlanControlT& control_,
+									const RegionID id,
+									const StateID index,
+									const LongIndex size)
+	: control{control_}
+	, prevId{control._regionId}
+	, prevIndex{control._regionIndex}
+	, prevSize{control._regionSize}
+{
+	control.setRegion(id, index, size);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TArgs>
+PlanControlT<TArgs>::Region::~Region() {
+	control.resetRegion(prevId, prevIndex, prevSize);
+
+	control._status.clear();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TArgs>
+void
+PlanControlT<TArgs>::setOrigin(const StateID id) {
+	HFSM_ASSERT(_regionId + _regionSize <= StateList::SIZE);
+	HFSM_ASSERT(_originId <= id && id < StateList::SIZE);
+
+	_originId = id;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TArgs>
+void
+PlanControlT<TArgs>::resetOrigin(const StateID id) { //-V524
+	HFSM_ASSERT(_regionId + _regionSize <= StateList::SIZE);
+	HFSM_ASSERT(id <= _originId && _originId < StateList::SIZE);
+
+	_originId = id;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TArgs>
+void
+PlanControlT<TArgs>::setRegion(const RegionID id,
+							   const StateID index,
+							   const LongIndex size)
+{
+	HFSM_ASSERT(_regionId <= id && id <  RegionList::SIZE);
+	HFSM_ASSERT(_regionIndex <= index && index + size <= _regionIndex + _regionSize);
+
+	_regionId	 = id;
+	_regionIndex = index;
+	_regionSize	 = size;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TArgs>
+void
+PlanControlT<TArgs>::resetRegion(const RegionID id, //-V524
+								 const StateID index,
+								 const LongIndex size)
+{
+	HFSM_ASSERT(id <= _regionId && _regionId < RegionList::SIZE);
+	HFSM_ASSERT(index <= _regionIndex && _regionIndex + _regionSize <= index + size);
+
+	_regionId	 = id;
+	_regionIndex = index;
+	_regionSize	 = size;
+}
+
+//------------------------------------------------------------------------------
+
+#ifdef HFSM_ENABLE_TIMERS
+
+// The timer wheel is shared, ParallelOrthogonal<> sub-states can't touch it
+
+template <typename TArgs>
+void
+PlanControlT<TArgs>::setTimer(const Request::Type type,
+							  const StateID id,
+							  const uint32_t ticks)
+{
+	HFSM_IF_PARALLEL(HFSM_ASSERT(!_planData.forked));
+
+	_timers.set(_originId, type, id, ticks);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TArgs>
+void
+PlanControlT<TArgs>::cancelTimer() {
+	HFSM_IF_PARALLEL(HFSM_ASSERT(!_planData.forked));
+
+	_timers.cancel(_originId);
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+
+#ifdef HFSM_ENABLE_COROUTINES
+
+// Replacing a task frees its frame back into the shared arena
+
+template <typename TArgs>
+bool
+PlanControlT<TArgs>::spawn(CoTask&& task) {
+	HFSM_IF_PARALLEL(HFSM_ASSERT(!_planData.forked));
+
+	return _planData.coroutines.spawn(_originId, std::move(task));
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TArgs>
+FullControlT<TArgs>::Lock::Lock(FullControlT& control_)
+	: control(!control_._locked ? &control_ : nullptr)
+{
+	if (control)
+		control->_locked = true;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TArgs>
+FullControlT<TArgs>::Lock::~Lock() {
+	if (control)
+		control->_locked = false;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TArgs>
+void
+FullControlT<TArgs>::setSucceeded(const StateID stateId) {
+#ifdef HFSM_ENABLE_PARALLEL
+	if (_prongTasks) {
+		_prongTasks->successes.set(stateId);
+
+		return;
+	}
+#endif
+
+	_planData.tasksSuccesses.set(stateId);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TArgs>
+void
+FullControlT<TArgs>::setFailed(const StateID stateId) {
+#ifdef HFSM_ENABLE_PARALLEL
+	if (_prongTasks) {
+		_prongTasks->failures.set(stateId);
+
+		return;
+	}
+#endif
+
+	_planData.tasksFailures.set(stateId);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TArgs>
+bool
+FullControlT<TArgs>::hasSucceeded(const StateID stateId) const {
+	HFSM_IF_PARALLEL(if (_prongTasks && _prongTasks->successes.get(stateId)) return true);
+
+	return _planData.tasksSuccesses.get(stateId);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TArgs>
+template <typename TState>
+Status
+FullControlT<TArgs>::updatePlan(TState& headState,
+								const Status subStatus)
+{
+	using State = TState;
+	static constexpr StateID STATE_ID = State::STATE_ID;
+
+	HFSM_ASSERT(subStatus);
+
+	if (subStatus.result == Status::FAILURE) {
+		_status.result = Status::FAILURE;
+		headState.wrapPlanFailed(*this);
+
+		if (Plan p = plan(_regionId))
+			p.clear();
+
+		return buildPlanStatus<State>();
+	} else if (subStatus.result == Status::SUCCESS) {
+		if (Plan p = plan(_regionId)) {
+#ifdef HFSM_ENABLE_STATIC_PLANS
+			auto& entry = _planData.staticPlans.entries[_regionId];
+
+			if (entry.tasks) {
+				for (; entry.cursor < entry.count; ++entry.cursor) {
+					const StaticTask& task = entry.tasks[entry.cursor];
+
+					if (hasSucceeded(task.origin)) {
+						HFSM_ASSERT(isActive(task.origin));
+
+						Origin origin{*this, STATE_ID};
+
+						changeTo(task.destination);
+					} else
+						break;
+				}
+
+				if (entry.cursor == entry.count)
+					_planData.staticPlans.clear(_regionId);
+
+				return Status{};
+			}
+#endif
+
+			// tasks are removed once done, so the first one is always the next pending,
+			//  and success bits are reset on exit, so they imply the origin is active
+			for (auto it = p.first(); it; ++it) {
+				if (hasSucceeded(it->origin)) {
+					HFSM_ASSERT(isActive(it->origin));
+
+					Origin origin{*this, STATE_ID};
+
+					changeTo(it->destination);
+
+					it.remove();
+				} else
+					break;
+			}
+
+			return Status{};
+		} else {
+			_status.result = Status::SUCCESS;
+			headState.wrapPlanSucceeded(*this);
+
+			return buildPlanStatus<State>();
+		}
+	} else
+		return Status{};
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TArgs>
+template <typename TState>
+Status
+FullControlT<TArgs>::buildPlanStatus() {
+	using State = TState;
+	static constexpr StateID STATE_ID = State::STATE_ID;
+
+	switch (_status.result) {
+	case Status::NONE:
+		HFSM_BREAK();
+		break;
+
+	case Status::SUCCESS:
+		setSucceeded(STATE_ID);
+
+		HFSM_LOG_PLAN_STATUS(context(), _regionId, StatusEvent::SUCCEEDED);
+		break;
+
+	case Status::FAILURE:
+		setFailed(STATE_ID);
+
+		HFSM_LOG_PLAN_STATUS(context(), _regionId, StatusEvent::FAILED);
+		break;
+
+	default:
+		HFSM_BREAK();
+	}
+
+	return {_status.result};
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TArgs>
+void
+FullControlT<TArgs>::changeTo(const StateID stateId) {
+	if (!_locked) {
+		_requests.append(Request{Request::Type::CHANGE, stateId, _originId});
+
+		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
+			_status.outerTransition = true;
+
+		HFSM_LOG_TRANSITION(context(), _originId, TransitionType::CHANGE, stateId);
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_PAYLOADS
+
+template <typename TArgs>
+template <typename TPayload>
+void
+FullControlT<TArgs>::changeTo(const StateID stateId,
+							  const TPayload& payload)
+{
+	HFSM_IF_PARALLEL(HFSM_ASSERT(!_prongTasks));
+
+	if (!_locked && HFSM_CHECKED(_planData.payloads.stage(stateId, payload)))
+		changeTo(stateId);
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+
+template <typename TArgs>
+void
+FullControlT<TArgs>::restart(const StateID stateId) {
+	if (!_locked) {
+		_requests.append(Request{Request::Type::RESTART, stateId, _originId});
+
+		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
+			_status.outerTransition = true;
+
+		HFSM_LOG_TRANSITION(context(), _originId, TransitionType::RESTART, stateId);
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TArgs>
+void
+FullControlT<TArgs>::resume(const StateID stateId) {
+	if (!_locked) {
+		_requests.append(Request{Request::Type::RESUME, stateId, _originId});
+
+		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
+			_status.outerTransition = true;
+
+		HFSM_LOG_TRANSITION(context(), _originId, TransitionType::RESUME, stateId);
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TArgs>
+void
+FullControlT<TArgs>::utilize(const StateID stateId) {
+	if (!_locked) {
+		_requests.append(Request{Request::Type::UTILIZE, stateId, _originId});
+
+		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
+			_status.outerTransition = true;
+
+		HFSM_LOG_TRANSITION(context(), _originId, TransitionType::UTILIZE, stateId);
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TArgs>
+void
+FullControlT<TArgs>::randomize(const StateID stateId) {
+	if (!_locked) {
+		_requests.append(Request{Request::Type::RANDOMIZE, stateId, _originId});
+
+		if (_regionIndex + _regionSize <= stateId || stateId < _regionIndex)
+			_status.outerTransition = true;
+
+		HFSM_LOG_TRANSITION(context(), _originId, TransitionType::RANDOMIZE, stateId);
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TArgs>
+void
+FullControlT<TArgs>::schedule(const StateID stateId) {
+	_requests.append(Request{Request::Type::SCHEDULE, stateId, _originId});
+
+	HFSM_LOG_TRANSITION(context(), _originId, TransitionType::SCHEDULE, stateId);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TArgs>
+void
+FullControlT<TArgs>::succeed() {
+	_status.result = Status::SUCCESS;
+
+	setSucceeded(_originId);
+
+	// TODO: promote taskSuccess all the way up for all regions without plans
+	if (_regionId < RegionList::SIZE && !_planData.planExists.get(_regionId)) {
+		HFSM_ASSERT(_regionIndex < StateList::SIZE);
+
+		setSucceeded(_regionIndex);
+	}
+
+	HFSM_LOG_TASK_STATUS(context(), _regionId, _originId, StatusEvent::SUCCEEDED);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TArgs>
+void
+FullControlT<TArgs>::fail() {
+	_status.result = Status::FAILURE;
+
+	setFailed(_originId);
+
+	// TODO: promote taskFailure all the way up for all regions without plans
+	if (_regionId < RegionList::SIZE && !_planData.planExists.get(_regionId)) {
+		HFSM_ASSERT(_regionIndex < StateList::SIZE);
+
+		setFailed(_regionIndex);
+	}
+
+	HFSM_LOG_TASK_STATUS(context(), _regionId, _originId, StatusEvent::FAILED);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TArgs>
+void
+GuardControlT<TArgs>::cancelPendingTransitions() {
+	_cancelled = true;
+
+	HFSM_LOG_CANCELLED_PENDING(context(), _originId);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+namespace hfsm2 {
+
+//------------------------------------------------------------------------------
+
+#ifdef HFSM_ENABLE_STRUCTURE_REPORT
+
+struct StructureEntry {
+	bool isActive;
+	const wchar_t* prefix;
+	const char* name;
+};
+
+#endif
+
+//------------------------------------------------------------------------------
+
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef HFSM_ENABLE_STRUCTURE_REPORT
+
+#pragma pack(push, 1)
+
+struct alignas(alignof(void*)) StructureStateInfo {
+	enum RegionType : ShortIndex {
+		COMPOSITE,
+		ORTHOGONAL,
+	};
+
+	StructureStateInfo() = default;
+
+	HFSM_INLINE StructureStateInfo(const LongIndex parent_,
+								   const RegionType region_,
+								   const ShortIndex depth_,
+								   const char* const name_)
+		: name{name_}
+		, parent{parent_}
+		, region{region_}
+		, depth{depth_}
+	{}
+
+	const char* name;
+	LongIndex parent;
+	RegionType region;
+	ShortIndex depth;
+};
+
+#pragma pack(pop)
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+#if defined HFSM_ENABLE_TRANSITION_HISTORY || defined HFSM_ENABLE_TRANSITION_TRACE
+
+inline
+TransitionType
+convert(const Request::Type type) {
+	switch (type) {
+		case Request::CHANGE:
+			return TransitionType::CHANGE;
+
+		case Request::RESTART:
+			return TransitionType::RESTART;
+
+		case Request::RESUME:
+			return TransitionType::RESUME;
+
+		case Request::UTILIZE:
+			return TransitionType::UTILIZE;
+
+		case Request::RANDOMIZE:
+			return TransitionType::RANDOMIZE;
+
+		case Request::SCHEDULE:
+			return TransitionType::SCHEDULE;
+
+		default:
+			HFSM_BREAK();
+			return TransitionType::CHANGE;
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+inline
+Request::Type
+convert(const TransitionType type) {
+	switch (type) {
+	case TransitionType::CHANGE:
+		return Request::CHANGE;
+
+	case TransitionType::RESTART:
+		return Request::RESTART;
+
+	case TransitionType::RESUME:
+		return Request::RESUME;
+
+	case TransitionType::UTILIZE:
+		return Request::UTILIZE;
+
+	case TransitionType::RANDOMIZE:
+		return Request::RANDOMIZE;
+
+	case TransitionType::SCHEDULE:
+		return Request::SCHEDULE;
+
+	default:
+		HFSM_BREAK();
+		return Request::CHANGE;
+	}
+}
+
+#endif
+
+}
+
+//------------------------------------------------------------------------------
+
+#ifdef HFSM_ENABLE_TRANSITION_HISTORY
+
+#pragma pack(push, 1)
+
+struct alignas(4) Transition {
+	HFSM_INLINE Transition() = default;
+
+	HFSM_INLINE Transition(const detail::Request request,
+						   const Method method_)
+		: stateId{request.stateId}
+		, method{method_}
+		, transitionType{detail::convert(request.type)}
+	{
+		HFSM_ASSERT(method_ < Method::COUNT);
+	}
+
+	HFSM_INLINE Transition(const StateID stateId_,
+						   const Method method_,
+						   const TransitionType transitionType_)
+		: stateId{stateId_}
+		, method{method_}
+		, transitionType{transitionType_}
+	{
+		HFSM_ASSERT(method_ < Method::COUNT);
+	}
+
+	detail::Request request() const		{ return detail::Request{detail::convert(transitionType), stateId};	}
+
+	StateID stateId = INVALID_STATE_ID;
+	Method method;
+	TransitionType transitionType;
+};
+
+#pragma pack(pop)
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+inline
+bool
+operator == (const Transition& l, const Transition& r) {
+	return l.stateId		== r.stateId
+		&& l.method			== r.method
+		&& l.transitionType	== r.transitionType;
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+
+#ifdef HFSM_ENABLE_TRANSITION_TRACE
+
+namespace hfsm2 {
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Single trace entry, one per request processed by a machine
+//  Members:
+//   tick			- Value of the machine's update() / react() counter
+//   instance		- Id passed to attachTrace(), tells machines sharing a trace apart
+//   origin			- State that issued the request, INVALID_STATE_ID for external requests
+//   target			- Destination state
+//   transitionType	- Type of the request
+//   method			- NONE if the transition was applied,
+//					  ENTRY_GUARD / EXIT_GUARD if it was cancelled by the respective guard
+
+struct alignas(4) TraceRecord {
+	uint32_t tick;
+	uint16_t instance;
+	StateID origin;
+	StateID target;
+	TransitionType transitionType;
+	Method method;
+};
+
+static_assert(sizeof(TraceRecord) == 12, "TraceRecord layout is a part of the trace file format");
+
+//------------------------------------------------------------------------------
+
+// Header written by TransitionTrace::flush(), followed by 'count' records
+
+struct TraceHeader {
+	enum : uint32_t { MAGIC	  = 0x52544648 }; // 'HFTR'
+	enum : uint16_t { VERSION = 1 };
+
+	uint32_t magic;
+	uint16_t version;
+	uint16_t recordSize;
+	uint64_t count;
+};
+
+static_assert(sizeof(TraceHeader) == 16, "TraceHeader layout is a part of the trace file format");
+
+//------------------------------------------------------------------------------
+
+// Ring buffer slot, the record is kept in relaxed atomic words
+//  'stamp' is odd while record() is writing the slot and even once it's written,
+//  telling flush() if the record changed while it was being copied
+
+struct TraceSlot {
+	enum : uint32_t { WORDS = sizeof(TraceRecord) / sizeof(uint32_t) };
+
+	std::atomic<uint32_t> stamp{0};
+	std::atomic<uint32_t> words[WORDS];
+};
+
+static_assert(sizeof(TraceRecord) % sizeof(uint32_t) == 0, "TraceRecord needs to fit TraceSlot words");
+
+//------------------------------------------------------------------------------
+
+// Ring buffer of trace records over external storage
+//  Intended to be used one per thread, shared by all the machines updated on it
+//  Recording is wait-free, flush() may be called from a different thread,
+//  records overwritten while flush() copies them are left out
+
+class TransitionTrace {
+public:
+	// 'capacity' must be a power of two
+	HFSM_INLINE TransitionTrace(TraceSlot* const slots,
+								const uint32_t capacity);
+
+	HFSM_INLINE void record(const TraceRecord& record);
+
+	HFSM_INLINE uint32_t capacity() const						{ return _mask + 1;							}
+
+	// Number of records currently held in the ring
+	HFSM_INLINE uint32_t count() const;
+
+	// Size of the buffer needed by flush() to write out all held records
+	HFSM_INLINE size_t flushSize() const;
+
+	// Write the header followed by held records in chronological order into 'buffer'
+	//  (e.g. a memory-mapped file view), return the number of bytes written,
+	//  or 0 if 'size' can't fit the header
+	size_t flush(void* const buffer,
+				 const size_t size) const;
+
+	HFSM_INLINE void clear();
+
+private:
+	// 'stamp' of the slot holding record number 'n' once it's written
+	static HFSM_INLINE uint32_t writtenStamp(const uint32_t n)	{ return 2 * n + 2;							}
+
+private:
+	TraceSlot* const _slots;
+	const uint32_t _mask;
+
+	std::atomic<uint32_t> _head{0};
+	std::atomic<bool> _wrapped{false};
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <uint32_t NCapacity>
+class TransitionTraceT
+	: public TransitionTrace
+{
+	static_assert(NCapacity && (NCapacity & (NCapacity - 1)) == 0, "Trace capacity needs to be a power of two");
+
+public:
+	HFSM_INLINE TransitionTraceT()
+		: TransitionTrace{_storage, NCapacity}
+	{}
+
+private:
+	TraceSlot _storage[NCapacity];
+};
+
+//------------------------------------------------------------------------------
+
+// Read-only view of a buffer written by TransitionTrace::flush()
+
+class TraceReader {
+public:
+	HFSM_INLINE TraceReader(const void* const data,
+							const size_t size);
+
+	HFSM_INLINE bool valid() const								{ return _records != nullptr;				}
+
+	HFSM_INLINE uint64_t count() const							{ return _count;							}
+	HFSM_INLINE const TraceRecord* records() const				{ return _records;							}
+
+	HFSM_INLINE const TraceRecord& operator[] (const uint64_t i) const;
+
+private:
+	const TraceRecord* _records = nullptr;
+	uint64_t _count = 0;
+};
+
+//------------------------------------------------------------------------------
+
+#ifdef HFSM_ENABLE_TRANSITION_HISTORY
+
+// Re-apply the transitions recorded for machine 'instance' via replayTransitions(),
+//  one call per recorded tick, cancelled transitions are skipped
+//  'machine' needs to start from the same state the traced one started from
+//  Returns the number of transitions replayed
+
+template <typename TMachine>
+uint64_t
+replayTrace(TMachine& machine,
+			const TraceRecord* const records,
+			const uint64_t count,
+			const uint16_t instance = 0);
+
+template <typename TMachine>
+HFSM_INLINE
+uint64_t
+replayTrace(TMachine& machine,
+			const TraceReader& reader,
+			const uint16_t instance = 0)
+{
+	return replayTrace(machine, reader.records(), reader.count(), instance);
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+
+namespace hfsm2 {
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline
+TransitionTrace::TransitionTrace(TraceSlot* const slots,
+								 const uint32_t capacity)
+	: _slots{slots}
+	, _mask{capacity - 1}
+{
+	HFSM_ASSERT(slots);
+	HFSM_ASSERT(capacity && (capacity & (capacity - 1)) == 0);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+inline
+void
+TransitionTrace::record(const TraceRecord& record) {
+	const uint32_t head = _head.load(std::memory_order_relaxed);
+	TraceSlot& slot = _slots[head & _mask];
+
+	uint32_t words[TraceSlot::WORDS];
+	memcpy(words, &record, sizeof(TraceRecord));
+
+	// the odd stamp has to be visible before any of the new words
+	slot.stamp.store(writtenStamp(head) - 1, std::memory_order_relaxed);
+	std::atomic_thread_fence(std::memory_order_release);
+
+	for (uint32_t w = 0; w < TraceSlot::WORDS; ++w)
+		slot.words[w].store(words[w], std::memory_order_relaxed);
+
+	slot.stamp.store(writtenStamp(head), std::memory_order_release);
+
+	if ((head & _mask) == _mask)
+		_wrapped.store(true, std::memory_order_relaxed);
+
+	_head.store(head + 1, std::memory_order_release);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+inline
+uint32_t
+TransitionTrace::count() const {
+	const uint32_t head = _head.load(std::memory_order_acquire);
+
+	return _wrapped.load(std::memory_order_relaxed) ? capacity() : head;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+inline
+size_t
+TransitionTrace::flushSize() const {
+	return sizeof(TraceHeader) + sizeof(TraceRecord) * count();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+inline
+size_t
+TransitionTrace::flush(void* const buffer,
+					   const size_t size) const
+{
+	if (!HFSM_CHECKED(buffer) || size < sizeof(TraceHeader))
+		return 0;
+
+	const uint32_t head = _head.load(std::memory_order_acquire);
+	const uint32_t held = _wrapped.load(std::memory_order_relaxed) ? capacity() : head;
+	const uint32_t fits = (uint32_t) ((size - sizeof(TraceHeader)) / sizeof(TraceRecord));
+
+	const uint32_t taken = held < fits ? held : fits;
+	const uint32_t first = head - taken;
+
+	char* const records = static_cast<char*>(buffer) + sizeof(TraceHeader);
+	uint32_t count = 0;
+
+	for (uint32_t n = first; n != head; ++n) {
+		const TraceSlot& slot = _slots[n & _mask];
+
+		// already overwritten by newer records
+		const uint32_t stamp = slot.stamp.load(std::memory_order_acquire);
+		if (stamp != writtenStamp(n))
+			continue;
+
+		uint32_t words[TraceSlot::WORDS];
+		for (uint32_t w = 0; w < TraceSlot::WORDS; ++w)
+			words[w] = slot.words[w].load(std::memory_order_relaxed);
+
+		// overwritten while copying
+		std::atomic_thread_fence(std::memory_order_acquire);
+		if (slot.stamp.load(std::memory_order_relaxed) != stamp)
+			continue;
+
+		memcpy(records + sizeof(TraceRecord) * count++, words, sizeof(TraceRecord));
+	}
+
+	TraceHeader header;
+	header.magic	  = TraceHeader::MAGIC;
+	header.version	  = TraceHeader::VERSION;
+	header.recordSize = (uint16_t) sizeof(TraceRecord);
+	header.count	  = count;
+
+	memcpy(buffer, &header, sizeof(TraceHeader));
+
+	return sizeof(TraceHeader) + sizeof(TraceRecord) * count;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+inline
+void
+TransitionTrace::clear() {
+	_wrapped.store(false, std::memory_order_relaxed);
+	_head	.store(0,	  std::memory_order_release);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+inline
+TraceReader::TraceReader(const void* const data,
+						 const size_t size)
+{
+	if (HFSM_CHECKED(data) && size >= sizeof(TraceHeader)) {
+		TraceHeader header;
+		memcpy(&header, data, sizeof(TraceHeader));
+
+		if (header.magic	  == TraceHeader::MAGIC	  &&
+			header.version	  == TraceHeader::VERSION &&
+			header.recordSize == sizeof(TraceRecord)  &&
+			header.count	  <= (size - sizeof(TraceHeader)) / sizeof(TraceRecord))
+		{
+			_records = reinterpret_cast<const TraceRecord*>(static_cast<const char*>(data) + sizeof(TraceHeader));
+			_count	 = header.count;
+		}
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+inline
+const TraceRecord&
+TraceReader::operator[] (const uint64_t i) const {
+	HFSM_ASSERT(i < _count);
+
+	return _records[i];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef HFSM_ENABLE_TRANSITION_HISTORY
+
+template <typename TMachine>
+uint64_t
+replayTrace(TMachine& machine,
+			const TraceRecord* const records,
+			const uint64_t count,
+			const uint16_t instance)
+{
+	using Transitions = typename TMachine::TransitionHistory;
+
+	Transitions transitions;
+	uint32_t tick = 0;
+	uint64_t replayed = 0;
+
+	for (uint64_t i = 0; i < count; ++i) {
+		const TraceRecord& record = records[i];
+
+		if (record.instance != instance || record.method != Method::NONE)
+			continue;
+
+		if (transitions.count() &&
+			(record.tick != tick || transitions.count() == Transitions::CAPACITY))
+		{
+			machine.replayTransitions(&transitions[0], transitions.count());
+			transitions.clear();
+		}
+
+		tick = record.tick;
+		transitions.append(Transition{record.target, Method::NONE, record.transitionType});
+		++replayed;
+	}
+
+	if (transitions.count())
+		machine.replayTransitions(&transitions[0], transitions.count());
+
+	return replayed;
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+
+#endif
+
+
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TArgs>
+class InjectionT {
+	template <typename...>
+	friend struct B_;
+
+protected:
+	using Context		= typename TArgs::Context;
+	using Rank			= typename TArgs::Rank;
+	using Utility		= typename TArgs::Utility;
+	using StateList		= typename TArgs::StateList;
+	using RegionList	= typename TArgs::RegionList;
+
+	using Control		= ControlT<TArgs>;
+
+	using PlanControl	= PlanControlT<TArgs>;
+	using Plan			= PlanT<TArgs>;
+
+	using FullControl	= FullControlT <TArgs>;
+	using GuardControl	= GuardControlT<TArgs>;
+
+public:
+	HFSM_INLINE void preEntryGuard(Context&)		{}
+
+	HFSM_INLINE void preEnter	  (Context&)		{}
+	HFSM_INLINE void preReenter	  (Context&)		{}
+
+	HFSM_INLINE void preUpdate	  (Context&)		{}
+
+	template <typename TEvent>
+	HFSM_INLINE void preReact	  (const TEvent&,
+								   Context&)		{}
+
+	HFSM_INLINE void preExitGuard (Context&)		{}
+
+	HFSM_INLINE void postExit	  (Context&)		{}
+
+	template <typename T>
+	static constexpr StateID  stateId()		{ return			StateList ::template index<T>();	}
+
+	template <typename T>
+	static constexpr RegionID regionId()	{ return (RegionID) RegionList::template index<T>();	}
+};
+
+//------------------------------------------------------------------------------
+// Compile-time check for injections overriding preUpdate()
+//  The default preUpdate() is declared in InjectionT<>,
+//  injections with an overloaded preUpdate() are assumed to override it
+
+template <typename T>
+struct IsInjectionT : std::false_type {};
+
+template <typename TArgs>
+struct IsInjectionT<InjectionT<TArgs>> : std::true_type {};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TContext, typename TInjection>
+struct HasPreUpdateT {
+	template <typename U>
+	static U* declaredIn(void (U::*)(TContext&));
+
+	template <typename U>
+	static constexpr bool test(decltype(declaredIn(&U::preUpdate)))
+	{ return !IsInjectionT<typename std::remove_pointer<decltype(declaredIn(&U::preUpdate))>::type>::value; }
+
+	template <typename>
+	static constexpr bool test(...)								{ return true;							}
+
+	static constexpr bool VALUE = test<TInjection>(nullptr);
+};
+
+//------------------------------------------------------------------------------
+
+template <typename...>
+struct B_;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TFirst, typename... TRest>
+struct B_<TFirst, TRest...>
+	: TFirst
+	, B_<TRest...>
+{
+	using typename TFirst::Context;
+	using typename TFirst::Rank;
+	using typename TFirst::Utility;
+	using typename TFirst::StateList;
+	using typename TFirst::RegionList;
+
+	using typename TFirst::Control;
+	using typename TFirst::PlanControl;
+	using typename TFirst::Plan;
+	using typename TFirst::FullControl;
+	using typename TFirst::GuardControl;
+
+	using TFirst::stateId;
+	using TFirst::regionId;
+
+	// Any of the injections does per-tick work in preUpdate()
+	static constexpr bool HAS_PRE_UPDATE = HasPreUpdateT<Context, TFirst>::VALUE || B_<TRest...>::HAS_PRE_UPDATE;
+
+	HFSM_INLINE void widePreEntryGuard(Context& context);
+
+	HFSM_INLINE void widePreEnter	  (Context& context);
+	HFSM_INLINE void widePreReenter	  (Context& context);
+
+	HFSM_INLINE void widePreUpdate	  (Context& context);
+
+	template <typename TEvent>
+	HFSM_INLINE void widePreReact	  (const TEvent& event,
+									   Context& context);
+
+	HFSM_INLINE void widePreExitGuard (Context& context);
+
+	HFSM_INLINE void widePostExit	  (Context& context);
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TFirst>
+struct B_<TFirst>
+	: TFirst
+{
+	using typename TFirst::Context;
+	using typename TFirst::Rank;
+	using typename TFirst::Utility;
+	using typename TFirst::StateList;
+	using typename TFirst::RegionList;
+
+	using typename TFirst::Control;
+	using typename TFirst::PlanControl;
+	using typename TFirst::Plan;
+	using typename TFirst::FullControl;
+	using typename TFirst::GuardControl;
+
+	using TFirst::stateId;
+	using TFirst::regionId;
+
+	static constexpr bool HAS_PRE_UPDATE = HasPreUpdateT<Context, TFirst>::VALUE;
+
+	HFSM_INLINE Rank	rank			 (const Control&)			{ return Rank	   {0};	}
+
+	HFSM_INLINE Utility utility			 (const Control&)			{ return Utility{1.0f};	}
+
+	HFSM_INLINE void	entryGuard		 (GuardControl&)			{}
+
+	HFSM_INLINE void	enter			 (PlanControl&)				{}
+	HFSM_INLINE void	reenter			 (PlanControl&)				{}
+
+	HFSM_INLINE void	update			 (FullControl&)				{}
+
+	template <typename TEvent>
+	HFSM_INLINE void	react			 (const TEvent&,
+										  FullControl&)				{}
+
+	HFSM_INLINE void	exitGuard		 (GuardControl&)			{}
+
+	HFSM_INLINE void	exit			 (PlanControl&)				{}
+
+	HFSM_INLINE void	planSucceeded	 (FullControl& control)		{ control.succeed();	}
+	HFSM_INLINE void	planFailed		 (FullControl& control)		{ control.fail();		}
+
+	HFSM_INLINE void	widePreEntryGuard(Context& context);
+
+	HFSM_INLINE void	widePreEnter	 (Context& context);
+	HFSM_INLINE void	widePreReenter   (Context& context);
+
+	HFSM_INLINE void	widePreUpdate	 (Context& context);
+
+	template <typename TEvent>
+	HFSM_INLINE void	widePreReact	 (const TEvent& event,
+					 					  Context& context);
+
+	HFSM_INLINE void	widePreExitGuard (Context& context);
+
+	HFSM_INLINE void	widePostExit	 (Context& context);
+};
+
+//------------------------------------------------------------------------------
+
+template <typename TArgs>
+using EmptyT = B_<InjectionT<TArgs>>;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct Dynamic_ {};
+
+template <typename... TI>
+struct DB_
+	: Dynamic_
+	, B_<TI...>
+{};
+
+template <typename TArgs>
+using DynamicEmptyT = DB_<InjectionT<TArgs>>;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct Static_ {};
+
+template <typename... TI>
+struct SB_
+	: Static_
+	, B_<TI...>
+{};
+
+template <typename TArgs>
+using StaticEmptyT = SB_<InjectionT<TArgs>>;
+
+//------------------------------------------------------------------------------
+// Compile-time check for states overriding update(), or injecting preUpdate()
+//  The default update() is declared in the single-injection B_<>,
+//  states with an ambiguous or overloaded update() are assumed to override it
+
+template <typename T>
+struct IsDefaultUpdateT : std::false_type {};
+
+template <typename TI>
+struct IsDefaultUpdateT<B_<TI>> : std::true_type {};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TFullControl, typename T>
+struct HasUpdateT {
+	template <typename U>
+	static U* declaredIn(void (U::*)(TFullControl&));
+
+	template <typename U>
+	static constexpr bool test(decltype(declaredIn(&U::update)))
+	{ return !IsDefaultUpdateT<typename std::remove_pointer<decltype(declaredIn(&U::update))>::type>::value; }
+
+	template <typename>
+	static constexpr bool test(...)								{ return true;							}
+
+	static constexpr bool VALUE = test<T>(nullptr) || T::HAS_PRE_UPDATE;
+};
+
+// headless regions
+template <typename TFullControl>
+struct HasUpdateT<TFullControl, void> {
+	static constexpr bool VALUE = false;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TFullControl, typename TStateList>
+struct UpdateMaskT;
+
+template <typename TFullControl, typename... TS>
+struct UpdateMaskT<TFullControl, ITL_<TS...>> {
+	static constexpr bool HAS_UPDATE[sizeof...(TS)] = { HasUpdateT<TFullControl, TS>::VALUE... };
+};
+
+template <typename TFullControl, typename... TS>
+constexpr bool UpdateMaskT<TFullControl, ITL_<TS...>>::HAS_UPDATE[sizeof...(TS)];
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TF, typename... TR>
+void
+B_<TF, TR...>::widePreEntryGuard(Context& context) {
+	TF::preEntryGuard(context);
+	B_<TR...>::widePreEntryGuard(context);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TF, typename... TR>
+void
+B_<TF, TR...>::widePreEnter(Context& context) {
+	TF::preEnter(context);
+	B_<TR...>::widePreEnter(context);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF, typename... TR>
+void
+B_<TF, TR...>::widePreReenter(Context& context) {
+	TF::preReenter(context);
+	B_<TR...>::widePreReenter(context);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TF, typename... TR>
+void
+B_<TF, TR...>::widePreUpdate(Context& context) {
+	TF::preUpdate(context);
+	B_<TR...>::widePreUpdate(context);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TF, typename... TR>
+template <typename TEvent>
+void
+B_<TF, TR...>::widePreReact(const TEvent& event,
+							Context& context)
+{
+	TF::preReact(event, context);
+	B_<TR...>::widePreReact(event, context);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TF, typename... TR>
+void
+B_<TF, TR...>::widePreExitGuard(Context& context) {
+	TF::preExitGuard(context);
+	B_<TR...>::widePreExitGuard(context);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TF, typename... TR>
+void
+B_<TF, TR...>::widePostExit(Context& context) {
+	TF::postExit(context);
+	B_<TR...>::widePostExit(context);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TF>
+void
+B_<TF>::widePreEntryGuard(Context& context) {
+	TF::preEntryGuard(context);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TF>
+void
+B_<TF>::widePreEnter(Context& context) {
+	TF::preEnter(context);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+void
+B_<TF>::widePreReenter(Context& context) {
+	TF::preReenter(context);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TF>
+void
+B_<TF>::widePreUpdate(Context& context) {
+	TF::preUpdate(context);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TF>
+template <typename TEvent>
+void
+B_<TF>::widePreReact(const TEvent& event,
+					 Context& context)
+{
+	TF::preReact(event, context);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TF>
+void
+B_<TF>::widePreExitGuard(Context& context) {
+	TF::preExitGuard(context);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TF>
+void
+B_<TF>::widePostExit(Context& context) {
+	TF::postExit(context);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+namespace hfsm2 {
+
+//------------------------------------------------------------------------------
+
+template <typename>
+struct Guard {
+	template <typename TArgs>
+	static void execute(hfsm2::detail::GuardControlT<TArgs>&) {}
+};
+
+//------------------------------------------------------------------------------
+
+namespace detail {
+
+//------------------------------------------------------------------------------
+
+HFSM_IF_DEBUG(struct None {});
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename T, typename TArgs>
+struct DBox final {
+	static constexpr bool isBare()								{ return false;					}
+
+	union {
+		T t_;
+	};
+
+	HFSM_INLINE  DBox() {}
+	HFSM_INLINE ~DBox() {}
+
+	HFSM_INLINE void guard(GuardControlT<TArgs>& control)		{ Guard<T>::execute(control);	}
+
+	HFSM_INLINE void construct();
+	HFSM_INLINE void destruct();
+
+	HFSM_INLINE		  T& get()							{ HFSM_ASSERT(initialized_); return t_;	}
+	HFSM_INLINE const T& get() const					{ HFSM_ASSERT(initialized_); return t_;	}
+
+	HFSM_IF_ASSERT(bool initialized_ = false);
+
+	HFSM_IF_DEBUG(const std::type_index TYPE = typeid(T));
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename T, typename TArgs>
+struct SBox final {
+	static constexpr bool isBare()	{ return std::is_base_of<T, StaticEmptyT<TArgs>>::value;	}
+
+	T t_;
+
+	HFSM_INLINE void guard(GuardControlT<TArgs>& control);
+
+	HFSM_INLINE void construct()																{}
+	HFSM_INLINE void destruct()																	{}
+
+	HFSM_INLINE		  T& get()									{ return t_;					}
+	HFSM_INLINE const T& get() const							{ return t_;					}
+
+	HFSM_IF_DEBUG(const std::type_index TYPE = isBare() ? typeid(None) : typeid(T));
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename T, typename TArgs>
+struct BoxifyT final {
+	using Type = typename std::conditional<
+					 std::is_base_of<Dynamic_, T>::value,
+					 DBox<T, TArgs>,
+					 SBox<T, TArgs>
+				 >::type;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename T, typename TArgs>
+using Boxify = typename BoxifyT<T, TArgs>::Type;
+
+//------------------------------------------------------------------------------
+
+}
+}
+
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename T, typename TA>
+void
+DBox<T, TA>::construct() {
+	HFSM_ASSERT(!initialized_);
+
+	new(&t_) T{};
+
+	HFSM_IF_ASSERT(initialized_ = true);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename T, typename TA>
+void
+DBox<T, TA>::destruct() {
+	HFSM_ASSERT(initialized_);
+
+	t_.~T();
+
+	HFSM_IF_ASSERT(initialized_ = false);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename T, typename TA>
+void
+SBox<T, TA>::guard(GuardControlT<TA>& control) {
+	t_.widePreEntryGuard(control.context());
+	t_.		  entryGuard(control);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TIndices,
+		  typename TArgs,
+		  typename THead>
+struct S_ final {
+	static constexpr auto STATE_ID	 = TIndices::STATE_ID;
+
+	using Context		= typename TArgs::Context;
+	using Rank			= typename TArgs::Rank;
+	using Utility		= typename TArgs::Utility;
+	using UP			= typename TArgs::UP;
+	using Logger		= typename TArgs::Logger;
+
+	using Control		= ControlT<TArgs>;
+	using Registry		= RegistryT<TArgs>;
+	using StateParents	= typename Registry::StateParents;
+
+	using PlanControl	= PlanControlT<TArgs>;
+	using ScopedOrigin	= typename PlanControl::Origin;
+
+	using FullControl	= FullControlT <TArgs>;
+	using GuardControl	= GuardControlT<TArgs>;
+
+	using Head			= THead;
+	using HeadBox		= Boxify<Head, TArgs>;
+
+#ifdef HFSM_ENABLE_PROFILER
+	using ScopedProfiler = ProfilerScope<typename TArgs::Profiler,
+										 !std::is_same<Head, StaticEmptyT<TArgs>>::value>;
+#endif
+
+	//----------------------------------------------------------------------
+
+#ifdef HFSM_EXPLICIT_MEMBER_SPECIALIZATION
+#ifdef __clang__
+	#pragma clang diagnostic push
+	#pragma clang diagnostic ignored "-Wnull-dereference"
+#endif
+
+	template <typename T>
+	struct Accessor {
+		HFSM_INLINE static		 T&	   get(		 S_&  )			{ HFSM_BREAK(); return *reinterpret_cast<T*>(0);		}
+		HFSM_INLINE static const T&	   get(const S_&  )			{ HFSM_BREAK(); return *reinterpret_cast<T*>(0);		}
+	};
+
+#ifdef __clang__
+	#pragma clang diagnostic pop
+#endif
+
+	template <>
+	struct Accessor<Head> {
+		HFSM_INLINE static		 Head& get(		 S_& s)			{ return s._headBox.get();								}
+		HFSM_INLINE static const Head& get(const S_& s)			{ return s._headBox.get();								}
+	};
+
+	template <typename T>
+	HFSM_INLINE		  T& access()								{ return Accessor<T>::get(*this);						}
+
+	template <typename T>
+	HFSM_INLINE const T& access() const							{ return Accessor<T>::get(*this);						}
+#endif
+
+	//----------------------------------------------------------------------
+
+	HFSM_INLINE Parent	stateParent			 (Control& control)	{ return control._registry.stateParents[STATE_ID];		}
+
+	HFSM_INLINE void	deepRegister		 (Registry& registry, const Parent parent);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE bool	deepForwardEntryGuard(GuardControl&)					{ return false;	}
+	HFSM_INLINE bool	deepEntryGuard		 (GuardControl&	control);
+
+	HFSM_INLINE void	deepConstruct		 (PlanControl&  control);
+
+	HFSM_INLINE void	deepEnter			 (PlanControl&	control);
+	HFSM_INLINE void	deepReenter			 (PlanControl&	control);
+
+	HFSM_INLINE Status	deepUpdate			 (FullControl&	control);
+
+	template <typename TEvent>
+	HFSM_INLINE Status	deepReact			 (FullControl&	control, const TEvent& event);
+
+	HFSM_INLINE bool	deepForwardExitGuard (GuardControl&)					{ return false; }
+	HFSM_INLINE bool	deepExitGuard		 (GuardControl&	control);
+
+	HFSM_INLINE void	deepExit			 (PlanControl&	control);
+
+	HFSM_INLINE void	deepDestruct		 (PlanControl&  control);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE void	wrapPlanSucceeded	 (FullControl&	control);
+	HFSM_INLINE void	wrapPlanFailed		 (FullControl&	control);
+	HFSM_INLINE Rank	wrapRank			 (Control& control);
+	HFSM_INLINE Utility	wrapUtility			 (Control& control);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE void	deepForwardActive	 (Control&, const Request::Type)					{}
+	HFSM_INLINE void	deepForwardRequest	 (Control&, const Request::Type)					{}
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE void	deepRequestChange	 (Control&)											{}
+	HFSM_INLINE void	deepRequestRemain	 (Registry&)										{}
+	HFSM_INLINE void	deepRequestRestart	 (Registry&)										{}
+	HFSM_INLINE void	deepRequestResume	 (Registry&)										{}
+	HFSM_INLINE void	deepRequestUtilize	 (Control&)											{}
+	HFSM_INLINE void	deepRequestRandomize (Control&)											{}
+
+	HFSM_INLINE UP		deepReportChange	 (Control& control);
+	HFSM_INLINE UP		deepReportUtilize	 (Control& control);
+	HFSM_INLINE Rank	deepReportRank		 (Control& control);
+	HFSM_INLINE Utility	deepReportRandomize	 (Control& control);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE void	deepChangeToRequested(Control&)											{}
+
+	//------------------------------------------------------------------------------
+
+#if defined _DEBUG || defined HFSM_ENABLE_STRUCTURE_REPORT || defined HFSM_ENABLE_LOG_INTERFACE
+
+	static constexpr LongIndex NAME_COUNT = HeadBox::isBare() ? 0 : 1;
+
+#endif
+
+	//----------------------------------------------------------------------
+
+#ifdef HFSM_ENABLE_STRUCTURE_REPORT
+	using StructureStateInfos = typename TArgs::StructureStateInfos;
+	using RegionType		  = typename StructureStateInfo::RegionType;
+
+	static const char* name();
+
+	void deepGetNames(const LongIndex parent,
+					  const RegionType region,
+					  const ShortIndex depth,
+					  StructureStateInfos& stateInfos) const;
+#endif
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_SERIALIZATION
+	using WriteStream	= typename TArgs::WriteStream;
+	using ReadStream	= typename TArgs::ReadStream;
+
+	HFSM_INLINE void	deepSaveActive	 (const Registry&, WriteStream&) const					{}
+	HFSM_INLINE void	deepSaveResumable(const Registry&, WriteStream&) const					{}
+
+	HFSM_INLINE void	deepLoadRequested(		Registry&, ReadStream& ) const					{}
+	HFSM_INLINE void	deepLoadResumable(		Registry&, ReadStream& ) const					{}
+#endif
+
+	//----------------------------------------------------------------------
+
+#ifdef HFSM_ENABLE_LOG_INTERFACE
+
+	template <typename>
+	struct Traits_;
+
+	template <typename TR_, typename TH_, typename... TAs_>
+	struct Traits_<TR_(TH_::*)(TAs_...)> {
+		using Host = TH_;
+	};
+
+	template <typename TM_>
+	using Host_			= typename Traits_<TM_>::Host;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	using Empty			= EmptyT<TArgs>;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	template <typename TMethodType>
+	typename std::enable_if<
+				 std::is_same<
+					 Host_<TMethodType>,
+					 Empty
+				 >::value
+			 >::type
+	log(Logger&,
+		Context&,
+		const Method) const
+	{}
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	template <typename TMethodType>
+	typename std::enable_if<
+				 !std::is_same<
+					 Host_<TMethodType>,
+					 Empty
+				 >::value
+			 >::type
+	log(Logger& logger,
+		Context& context,
+		const Method method) const
+	{
+		logger.recordMethod(context, STATE_ID, method);
+	}
+
+#endif
+
+	//----------------------------------------------------------------------
+
+	// TODO: account for boxing
+	//
+	// if you see..
+	// VS	 - error C2079: 'hfsm2::detail::S_<...>::_head' uses undefined struct 'Blah'
+	// Clang - error : field has incomplete type 'hfsm2::detail::S_<...>::Head' (aka 'Blah')
+	//
+	// .. add definition for the state 'Blah'
+	HeadBox _headBox;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+namespace hfsm2 {
+namespace detail {
+
+//------------------------------------------------------------------------------
+
+template <StateID NS, typename TA, typename TH>
+struct RegisterT {
+	using StateParents	= StaticArray<Parent, TA::STATE_COUNT>;
+	using StateList		= typename TA::StateList;
+
+	static constexpr StateID STATE_ID = NS;
+
+	static HFSM_INLINE
+	void
+	execute(StateParents& stateParents,
+			const Parent parent)
+	{
+		static constexpr auto HEAD_ID = StateList::template index<TH>();
+		StaticAssertEquality<STATE_ID, HEAD_ID>();
+
+		stateParents[STATE_ID] = parent;
+	}
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <StateID NS, typename TA>
+struct RegisterT<NS, TA, StaticEmptyT<TA>> {
+	using StateParents	= StaticArray<Parent, TA::STATE_COUNT>;
+
+	static HFSM_INLINE
+	void
+	execute(StateParents&, const Parent) {}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TN_, typename TA, typename TH>
+void
+S_<TN_, TA, TH>::deepRegister(Registry& registry,
+							  const Parent parent)
+{
+	using Register = RegisterT<STATE_ID, TA, Head>;
+	Register::execute(registry.stateParents, parent);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN_, typename TA, typename TH>
+bool
+S_<TN_, TA, TH>::deepEntryGuard(GuardControl& control) {
+	HFSM_LOG_STATE_METHOD(&Head::entryGuard,
+						  control.context(),
+						  Method::ENTRY_GUARD);
+	HFSM_PROFILE_STATE_METHOD(Method::ENTRY_GUARD);
+
+	ScopedOrigin origin{control, STATE_ID};
+
+	const bool cancelledBefore = control._cancelled;
+
+	_headBox.guard(control);
+
+	return !cancelledBefore && control._cancelled;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN_, typename TA, typename TH>
+void
+S_<TN_, TA, TH>::deepConstruct(PlanControl& control) {
+	HFSM_ASSERT(!control._planData.tasksSuccesses.template get<STATE_ID>());
+	HFSM_ASSERT(!control._planData.tasksFailures .template get<STATE_ID>());
+
+	HFSM_LOG_STATE_METHOD(&Head::enter,
+						  control.context(),
+						  Method::CONSTRUCT);
+	HFSM_PROFILE_STATE_METHOD(Method::CONSTRUCT);
+
+	HFSM_RECORD_STATE_ACTIVITY(recordEnter);
+
+	_headBox.construct();
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN_, typename TA, typename TH>
+void
+S_<TN_, TA, TH>::deepEnter(PlanControl& control) {
+	HFSM_LOG_STATE_METHOD(&Head::enter,
+						  control.context(),
+						  Method::ENTER);
+	HFSM_PROFILE_STATE_METHOD(Method::ENTER);
+	HFSM_IF_STRUCTURE(control._planData.activityChanges.mark(STATE_ID));
+	HFSM_IF_POOL_INDEX(control._planData.indexChanges.mark(STATE_ID));
+
+	ScopedOrigin origin{control, STATE_ID};
+
+	_headBox.get().widePreEnter(control.context());
+	_headBox.get().		  enter(control);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN_, typename TA, typename TH>
+void
+S_<TN_, TA, TH>::deepReenter(PlanControl& control) {
+	HFSM_ASSERT(!control._planData.tasksSuccesses.template get<STATE_ID>());
+	HFSM_ASSERT(!control._planData.tasksFailures .template get<STATE_ID>());
+
+	HFSM_LOG_STATE_METHOD(&Head::reenter,
+						  control.context(),
+						  Method::REENTER);
+	HFSM_PROFILE_STATE_METHOD(Method::REENTER);
+
+	ScopedOrigin origin{control, STATE_ID};
+
+	_headBox.destruct ();
+	_headBox.construct();
+
+	_headBox.get().widePreReenter(control.context());
+	_headBox.get().		  reenter(control);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN_, typename TA, typename TH>
+Status
+S_<TN_, TA, TH>::deepUpdate(FullControl& control) {
+	HFSM_LOG_STATE_METHOD(&Head::update,
+						  control.context(),
+						  Method::UPDATE);
+	HFSM_PROFILE_STATE_METHOD(Method::UPDATE);
+
+	ScopedOrigin origin{control, STATE_ID};
+
+	_headBox.get().widePreUpdate(control.context());
+	_headBox.get().		  update(control);
+
+	HFSM_IF_COROUTINES(if (control._planData.coroutines.update(STATE_ID)) control.succeed());
+
+	return control._status;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN_, typename TA, typename TH>
+template <typename TEvent>
+Status
+S_<TN_, TA, TH>::deepReact(FullControl& control,
+						   const TEvent& event)
+{
+	auto reaction = static_cast<void(Head::*)(const TEvent&, FullControl&)>(&Head::react);
+	HFSM_LOG_STATE_METHOD(reaction,
+						  control.context(),
+						  Method::REACT);
+	HFSM_PROFILE_STATE_METHOD(Method::REACT);
+
+	ScopedOrigin origin{control, STATE_ID};
+
+	_headBox.get().widePreReact(event, control.context());
+	(_headBox.get().*reaction) (event, control);				//_headBox.get().react(event, control);
+
+	HFSM_IF_COROUTINES(if (control._planData.coroutines.react(STATE_ID, event)) control.succeed());
+
+	return control._status;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN_, typename TA, typename TH>
+bool
+S_<TN_, TA, TH>::deepExitGuard(GuardControl& control) {
+	HFSM_LOG_STATE_METHOD(&Head::exitGuard,
+						  control.context(),
+						  Method::EXIT_GUARD);
+	HFSM_PROFILE_STATE_METHOD(Method::EXIT_GUARD);
+
+	ScopedOrigin origin{control, STATE_ID};
+
+	const bool cancelledBefore = control._cancelled;
+
+	_headBox.get().widePreExitGuard(control.context());
+	_headBox.get().		  exitGuard(control);
+
+	return !cancelledBefore && control._cancelled;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN_, typename TA, typename TH>
+void
+S_<TN_, TA, TH>::deepExit(PlanControl& control) {
+	HFSM_LOG_STATE_METHOD(&Head::exit,
+						  control.context(),
+						  Method::EXIT);
+	HFSM_PROFILE_STATE_METHOD(Method::EXIT);
+	HFSM_IF_STRUCTURE(control._planData.activityChanges.mark(STATE_ID));
+	HFSM_IF_POOL_INDEX(control._planData.indexChanges.mark(STATE_ID));
+
+	ScopedOrigin origin{control, STATE_ID};
+
+	// if you see..
+	// VS	 - error C2039:  'exit': is not a member of 'Blah'
+	// Clang - error : no member named 'exit' in 'Blah'
+	//
+	// .. inherit state 'Blah' from hfsm2::Machine::Instance::State
+	_headBox.get().		   exit(control);
+	_headBox.get().widePostExit(control.context());
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN_, typename TA, typename TH>
+void
+S_<TN_, TA, TH>::deepDestruct(PlanControl& control) {
+	HFSM_LOG_STATE_METHOD(&Head::exit,
+						  control.context(),
+						  Method::DESTRUCT);
+	HFSM_PROFILE_STATE_METHOD(Method::DESTRUCT);
+
+	HFSM_RECORD_STATE_ACTIVITY(recordExit);
+
+	HFSM_IF_TIMERS(control._timers.cancel(STATE_ID));
+	HFSM_IF_COROUTINES(control._planData.coroutines.destroy(STATE_ID));
+
+	_headBox.destruct();
+
+	control._planData.tasksSuccesses.template reset<STATE_ID>();
+	control._planData.tasksFailures .template reset<STATE_ID>();
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN_, typename TA, typename TH>
+void
+S_<TN_, TA, TH>::wrapPlanSucceeded(FullControl& control) {
+	HFSM_LOG_STATE_METHOD(&Head::planSucceeded,
+						  control.context(),
+						  Method::PLAN_SUCCEEDED);
+	HFSM_PROFILE_STATE_METHOD(Method::PLAN_SUCCEEDED);
+
+	ScopedOrigin origin{control, STATE_ID};
+
+	_headBox.get().planSucceeded(control);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN_, typename TA, typename TH>
+void
+S_<TN_, TA, TH>::wrapPlanFailed(FullControl& control) {
+	HFSM_LOG_STATE_METHOD(&Head::planFailed,
+						  control.context(),
+						  Method::PLAN_FAILED);
+	HFSM_PROFILE_STATE_METHOD(Method::PLAN_FAILED);
+
+	ScopedOrigin origin{control, STATE_ID};
+
+	_headBox.get().planFailed(control);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN_, typename TA, typename TH>
+typename S_<TN_, TA, TH>::Rank
+S_<TN_, TA, TH>::wrapRank(Control& control) {
+	HFSM_LOG_STATE_METHOD(&Head::rank,
+						  control.context(),
+						  Method::RANK);
+	HFSM_PROFILE_STATE_METHOD(Method::RANK);
+
+	return _headBox.get().rank(static_cast<const Control&>(control));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN_, typename TA, typename TH>
+typename S_<TN_, TA, TH>::Utility
+S_<TN_, TA, TH>::wrapUtility(Control& control) {
+	HFSM_LOG_STATE_METHOD(&Head::utility,
+						  control.context(),
+						  Method::UTILITY);
+	HFSM_PROFILE_STATE_METHOD(Method::UTILITY);
+
+	return _headBox.get().utility(static_cast<const Control&>(control));
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN_, typename TA, typename TH>
+typename S_<TN_, TA, TH>::UP
+S_<TN_, TA, TH>::deepReportChange(Control& control) {
+	const Utility utility = wrapUtility(control);
+
+	const Parent parent = stateParent(control);
+
+	return {utility, parent.prong};
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN_, typename TA, typename TH>
+typename S_<TN_, TA, TH>::UP
+S_<TN_, TA, TH>::deepReportUtilize(Control& control) {
+	const Utility utility = wrapUtility(control);
+	const Parent  parent  = stateParent(control);
+
+	return {utility, parent.prong};
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN_, typename TA, typename TH>
+typename S_<TN_, TA, TH>::Rank
+S_<TN_, TA, TH>::deepReportRank(Control& control) {
+	return wrapRank(control);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN_, typename TA, typename TH>
+typename S_<TN_, TA, TH>::Utility
+S_<TN_, TA, TH>::deepReportRandomize(Control& control) {
+	return wrapUtility(control);
+}
+
+//------------------------------------------------------------------------------
+
+#ifdef HFSM_ENABLE_STRUCTURE_REPORT
+
+template <typename TN_, typename TA, typename TH>
+const char*
+S_<TN_, TA, TH>::name() {
+	if (HeadBox::isBare())
+		return "";
+	else {
+		const std::type_index type = typeid(Head);
+		const char* const raw = type.name();
+
+	#if defined(_MSC_VER)
+
+		auto first =
+			raw[0] == 's' ? 7 : // Struct
+			raw[0] == 'c' ? 6 : // Class
+							0;
+
+		for (auto c = first; raw[c]; ++c)
+			if (raw[c] == ':')
+				first = c + 1;
+
+		return raw + first;
+
+	#elif defined(__clang__) || defined(__GNUC__) || defined(__GNUG__)
+
+		return raw;
+
+	#else
+
+		return raw;
+
+	#endif
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN_, typename TA, typename TH>
+void
+S_<TN_, TA, TH>::deepGetNames(const LongIndex parent,
+							  const RegionType region,
+							  const ShortIndex depth,
+							  StructureStateInfos& _stateInfos) const
+{
+	_stateInfos.append(StructureStateInfo{parent, region, depth, name()});
+}
+
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename>
+struct SI_;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <Strategy, typename, typename...>
+struct CI_;
+
+template <typename...>
+struct CSI_;
+
+template <typename TInitial, typename... TRemaining>
+struct CSI_<TInitial, TRemaining...>;
+
+template <typename TInitial>
+struct CSI_<TInitial>;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <Execution, typename, typename...>
+struct OI_;
+
+template <typename...>
+struct OSI_;
+
+template <typename TInitial, typename... TRemaining>
+struct OSI_<TInitial, TRemaining...>;
+
+template <typename TInitial>
+struct OSI_<TInitial>;
+
+//------------------------------------------------------------------------------
+
+template <typename...>
+struct WrapInfoT;
+
+template <typename TH>
+struct WrapInfoT<	 TH> {
+	using Type = SI_<TH>;
+};
+
+template <Strategy SG, typename TH, typename... TS>
+struct WrapInfoT<	 CI_<SG, TH, TS...>> {
+	using Type =	 CI_<SG, TH, TS...>;
+};
+
+template <Execution EX, typename TH, typename... TS>
+struct WrapInfoT<	 OI_<EX, TH, TS...>> {
+	using Type =	 OI_<EX, TH, TS...>;
+};
+
+template <typename... TS>
+using WrapInfo = typename WrapInfoT<TS...>::Type;
+
+//------------------------------------------------------------------------------
+
+template <typename THead>
+struct SI_ final {
+	using Head				= THead;
+	using StateList			= ITL_<Head>;
+	using RegionList		= ITL_<>;
+
+	static constexpr ShortIndex WIDTH			= 1;
+	static constexpr LongIndex  REVERSE_DEPTH	= 1;
+	static constexpr ShortIndex COMPO_REGIONS	= 0;
+	static constexpr LongIndex  COMPO_PRONGS	= 0;
+	static constexpr ShortIndex ORTHO_REGIONS	= 0;
+	static constexpr ShortIndex ORTHO_UNITS		= 0;
+
+	static constexpr LongIndex  ACTIVE_BITS		= 0;
+	static constexpr LongIndex  RESUMABLE_BITS	= 0;
+
+	static constexpr LongIndex  STATE_COUNT		= StateList::SIZE;
+	static constexpr ShortIndex REGION_COUNT	= RegionList::SIZE;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TInitial, typename... TRemaining>
+struct CSI_<TInitial, TRemaining...> {
+	using Initial			= WrapInfo<TInitial>;
+	using Remaining			= CSI_<TRemaining...>;
+	using StateList			= Merge<typename Initial::StateList,  typename Remaining::StateList>;
+	using RegionList		= Merge<typename Initial::RegionList, typename Remaining::RegionList>;
+
+	static constexpr LongIndex  REVERSE_DEPTH	= Max<Initial::REVERSE_DEPTH,	Remaining::REVERSE_DEPTH>::VALUE;
+	static constexpr ShortIndex COMPO_REGIONS	=	  Initial::COMPO_REGIONS  + Remaining::COMPO_REGIONS;
+	static constexpr LongIndex  COMPO_PRONGS	=	  Initial::COMPO_PRONGS   + Remaining::COMPO_PRONGS;
+	static constexpr ShortIndex ORTHO_REGIONS	=	  Initial::ORTHO_REGIONS  + Remaining::ORTHO_REGIONS;
+	static constexpr ShortIndex ORTHO_UNITS		=	  Initial::ORTHO_UNITS    + Remaining::ORTHO_UNITS;
+
+	static constexpr LongIndex  ACTIVE_BITS		= Max<Initial::ACTIVE_BITS,		Remaining::ACTIVE_BITS>::VALUE;
+	static constexpr LongIndex  RESUMABLE_BITS	=	  Initial::RESUMABLE_BITS + Remaining::RESUMABLE_BITS;
+
+	static constexpr LongIndex  STATE_COUNT		= StateList::SIZE;
+	static constexpr ShortIndex REGION_COUNT	= RegionList::SIZE;
+};
+
+template <typename TInitial>
+struct CSI_<TInitial> {
+	using Initial			= WrapInfo<TInitial>;
+	using StateList			= typename Initial::StateList;
+	using RegionList		= typename Initial::RegionList;
+
+	static constexpr LongIndex  REVERSE_DEPTH	= Initial::REVERSE_DEPTH;
+	static constexpr ShortIndex COMPO_REGIONS	= Initial::COMPO_REGIONS;
+	static constexpr LongIndex  COMPO_PRONGS	= Initial::COMPO_PRONGS;
+	static constexpr ShortIndex ORTHO_REGIONS	= Initial::ORTHO_REGIONS;
+	static constexpr ShortIndex ORTHO_UNITS		= Initial::ORTHO_UNITS;
+
+	static constexpr LongIndex  ACTIVE_BITS		= Initial::ACTIVE_BITS;
+	static constexpr LongIndex  RESUMABLE_BITS	= Initial::RESUMABLE_BITS;
+
+	static constexpr LongIndex  STATE_COUNT		= StateList::SIZE;
+	static constexpr ShortIndex REGION_COUNT	= RegionList::SIZE;
+};
+
+template <Strategy TStrategy, typename THead, typename... TSubStates>
+struct CI_ final {
+	static constexpr Strategy STRATEGY = TStrategy;
+
+	using Head				= THead;
+	using HeadInfo			= SI_<Head>;
+	using SubStates			= CSI_<TSubStates...>;
+	using StateList			= Merge<typename HeadInfo::StateList, typename SubStates::StateList>;
+	using RegionList		= Merge<typename HeadInfo::StateList, typename SubStates::RegionList>;
+
+	static constexpr ShortIndex	WIDTH			= sizeof...(TSubStates);
+	static constexpr LongIndex	REVERSE_DEPTH	= SubStates::REVERSE_DEPTH + 1;
+	static constexpr ShortIndex	COMPO_REGIONS	= SubStates::COMPO_REGIONS + 1;
+	static constexpr LongIndex	COMPO_PRONGS	= SubStates::COMPO_PRONGS + WIDTH;
+	static constexpr ShortIndex	ORTHO_REGIONS	= SubStates::ORTHO_REGIONS;
+	static constexpr ShortIndex	ORTHO_UNITS		= SubStates::ORTHO_UNITS;
+
+	static constexpr LongIndex	WIDTH_BITS		= bitWidth(WIDTH);
+	static constexpr LongIndex  ACTIVE_BITS		= SubStates::ACTIVE_BITS	+ WIDTH_BITS;
+	static constexpr LongIndex  RESUMABLE_BITS	= SubStates::RESUMABLE_BITS + WIDTH_BITS + 1;
+
+	static constexpr LongIndex	STATE_COUNT		= StateList::SIZE;
+	static constexpr ShortIndex	REGION_COUNT	= RegionList::SIZE;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TInitial, typename... TRemaining>
+struct OSI_<TInitial, TRemaining...> {
+	using Initial			= WrapInfo<TInitial>;
+	using Remaining			= OSI_<TRemaining...>;
+	using StateList			= Merge<typename Initial::StateList,  typename Remaining::StateList>;
+	using RegionList		= Merge<typename Initial::RegionList, typename Remaining::RegionList>;
+
+	static constexpr LongIndex  REVERSE_DEPTH	= Max<Initial::REVERSE_DEPTH,	Remaining::REVERSE_DEPTH>::VALUE;
+	static constexpr ShortIndex COMPO_REGIONS	=	  Initial::COMPO_REGIONS  + Remaining::COMPO_REGIONS;
+	static constexpr LongIndex  COMPO_PRONGS	=	  Initial::COMPO_PRONGS   + Remaining::COMPO_PRONGS;
+	static constexpr ShortIndex ORTHO_REGIONS	=	  Initial::ORTHO_REGIONS  + Remaining::ORTHO_REGIONS;
+	static constexpr ShortIndex ORTHO_UNITS		=	  Initial::ORTHO_UNITS    + Remaining::ORTHO_UNITS;
+
+	static constexpr LongIndex  ACTIVE_BITS		=	  Initial::ACTIVE_BITS    + Remaining::ACTIVE_BITS;
+	static constexpr LongIndex  RESUMABLE_BITS	=	  Initial::RESUMABLE_BITS + Remaining::RESUMABLE_BITS;
+};
+
+template <typename TInitial>
+struct OSI_<TInitial> {
+	using Initial			= WrapInfo<TInitial>;
+	using StateList			= typename Initial::StateList;
+	using RegionList		= typename Initial::RegionList;
+
+	static constexpr LongIndex  REVERSE_DEPTH	= Initial::REVERSE_DEPTH;
+	static constexpr ShortIndex COMPO_REGIONS	= Initial::COMPO_REGIONS;
+	static constexpr LongIndex  COMPO_PRONGS	= Initial::COMPO_PRONGS;
+	static constexpr ShortIndex ORTHO_REGIONS	= Initial::ORTHO_REGIONS;
+	static constexpr ShortIndex ORTHO_UNITS		= Initial::ORTHO_UNITS;
+
+	static constexpr LongIndex  ACTIVE_BITS		= Initial::ACTIVE_BITS;
+	static constexpr LongIndex  RESUMABLE_BITS	= Initial::RESUMABLE_BITS;
+};
+
+template <Execution TExecution, typename THead, typename... TSubStates>
+struct OI_ final {
+	static constexpr Execution EXECUTION = TExecution;
+
+	using Head				= THead;
+	using HeadInfo			= SI_<Head>;
+	using SubStates			= OSI_<TSubStates...>;
+	using StateList			= Merge<typename HeadInfo::StateList, typename SubStates::StateList>;
+	using RegionList		= Merge<typename HeadInfo::StateList, typename SubStates::RegionList>;
+
+	static constexpr ShortIndex WIDTH			= sizeof...(TSubStates);
+	static constexpr LongIndex  REVERSE_DEPTH	= SubStates::REVERSE_DEPTH + 1;
+	static constexpr ShortIndex COMPO_REGIONS	= SubStates::COMPO_REGIONS;
+	static constexpr LongIndex  COMPO_PRONGS	= SubStates::COMPO_PRONGS;
+	static constexpr ShortIndex ORTHO_REGIONS	= SubStates::ORTHO_REGIONS + 1;
+	static constexpr ShortIndex ORTHO_UNITS		= SubStates::ORTHO_UNITS + (WIDTH + 7) / 8;
+
+	static constexpr LongIndex  ACTIVE_BITS		= SubStates::ACTIVE_BITS;
+	static constexpr LongIndex  RESUMABLE_BITS	= SubStates::RESUMABLE_BITS;
+
+	static constexpr LongIndex  STATE_COUNT		= StateList::SIZE;
+	static constexpr ShortIndex REGION_COUNT	= RegionList::SIZE;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TContext,
+		  typename TConfig,
+		  typename TStateList,
+		  typename TRegionList,
+		  LongIndex NCompoCount,
+		  LongIndex NOrthoCount,
+		  LongIndex NOrthoUnits,
+		  LongIndex NSerialBits,
+		  LongIndex NTaskCapacity>
+struct ArgsT final {
+	using Context	 = TContext;
+
+	using Config_	 = TConfig;
+	using Rank		 = typename Config_::Rank;
+	using Utility	 = typename Config_::Utility;
+	using RNG		 = typename Config_::RNG;
+	using UP		 = typename Config_::UP;
+	using Logger	 = typename Config_::Logger;
+
+	using StateList	 = TStateList;
+	using RegionList = TRegionList;
+
+	static constexpr LongIndex  STATE_COUNT	  = StateList::SIZE;
+	static constexpr ShortIndex COMPO_REGIONS = NCompoCount;
+	static constexpr ShortIndex ORTHO_REGIONS = NOrthoCount;
+	static constexpr ShortIndex ORTHO_UNITS	  = NOrthoUnits;
+	static constexpr ShortIndex SERIAL_BITS	  = NSerialBits;
+
+	static constexpr LongIndex  TASK_CAPACITY = NTaskCapacity;
+
+#ifdef HFSM_ENABLE_SERIALIZATION
+	using SerialBuffer			= StreamBuffer	<SERIAL_BITS>;
+	using WriteStream			= BitWriteStream<SERIAL_BITS>;
+	using ReadStream			= BitReadStream	<SERIAL_BITS>;
+#endif
+
+	HFSM_IF_STRUCTURE(using StructureStateInfos = Array<StructureStateInfo, STATE_COUNT>);
+
+	HFSM_IF_PROFILER(using Profiler = ProfilerT<STATE_COUNT>);
+	HFSM_IF_STATISTICS(using Statistics = StatisticsT<STATE_COUNT>);
+	HFSM_IF_TIMERS(using Timers = TimerWheelT<STATE_COUNT>);
+};
+
+//------------------------------------------------------------------------------
+
+template <StateID NStateID,
+		  ShortIndex NCompoIndex,
+		  ShortIndex NOrthoIndex,
+		  ShortIndex NOrthoUnit>
+struct I_ {
+	static constexpr StateID	STATE_ID	 = NStateID;
+	static constexpr ShortIndex COMPO_INDEX	 = NCompoIndex;
+	static constexpr ShortIndex ORTHO_INDEX	 = NOrthoIndex;
+	static constexpr ShortIndex ORTHO_UNIT	 = NOrthoUnit;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename, typename, typename>
+struct S_;
+
+template <typename, typename, Strategy, typename, typename...>
+struct C_;
+
+template <typename, typename, Strategy, ShortIndex, typename...>
+struct CS_;
+
+template <typename, typename, Execution, typename, typename...>
+struct O_;
+
+template <typename, typename, ShortIndex, typename...>
+struct OS_;
+
+template <typename, typename>
+class RW_;
+
+template <typename, LongIndex, ShortIndex, ShortIndex, ShortIndex>
+struct RuntimeF_;
+
+//------------------------------------------------------------------------------
+
+template <typename, typename...>
+struct MaterialT;
+
+template <typename TN, typename TA, typename TH>
+struct MaterialT   <TN, TA, TH> {
+	using Type = S_<TN, TA, TH>;
+};
+
+template <typename TN, typename TA, Strategy SG, 			  typename... TS>
+struct MaterialT   <TN, TA, CI_<SG, void,             TS...>> {
+	using Type = C_<TN, TA,     SG, StaticEmptyT<TA>, TS...>;
+};
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+struct MaterialT   <TN, TA, CI_<SG, TH,	TS...>> {
+	using Type = C_<TN, TA,     SG, TH,	TS...>;
+};
+
+template <typename TN, typename TA, Execution EX,				 typename... TS>
+struct MaterialT   <TN, TA, OI_<EX, void,		  TS...>> {
+	using Type = O_<TN, TA,     EX, StaticEmptyT<TA>, TS...>;
+};
+
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+struct MaterialT   <TN, TA, OI_<EX, TH,			  TS...>> {
+	using Type = O_<TN, TA,     EX, TH,				  TS...>;
+};
+
+template <typename TN, typename... TS>
+using Material = typename MaterialT<TN, TS...>::Type;
+
+//------------------------------------------------------------------------------
+
+template <typename TConfig,
+		  typename TApex>
+struct RF_ final {
+	using Config_		= TConfig;
+	using Context		= typename Config_::Context;
+	using Apex			= TApex;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	static constexpr LongIndex SUBSTITUTION_LIMIT= Config_::SUBSTITUTION_LIMIT;
+
+	static constexpr LongIndex TASK_CAPACITY	 = Config_::TASK_CAPACITY != INVALID_LONG_INDEX ?
+													   Config_::TASK_CAPACITY : Apex::COMPO_PRONGS * 2;
+
+	static constexpr ShortIndex COMPO_REGIONS	 = Apex::COMPO_REGIONS;
+	static constexpr ShortIndex ORTHO_REGIONS	 = Apex::ORTHO_REGIONS;
+	static constexpr ShortIndex ORTHO_UNITS		 = Apex::ORTHO_UNITS;
+
+	static constexpr LongIndex  ACTIVE_BITS		 = Apex::ACTIVE_BITS;
+	static constexpr LongIndex  RESUMABLE_BITS	 = Apex::RESUMABLE_BITS;
+
+	using StateList		= typename Apex::StateList;
+	using RegionList	= typename Apex::RegionList;
+
+	using Args			= ArgsT<Context,
+								Config_,
+								StateList,
+								RegionList,
+								COMPO_REGIONS,
+								ORTHO_REGIONS,
+								ORTHO_UNITS,
+								ACTIVE_BITS + RESUMABLE_BITS,
+								TASK_CAPACITY>;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	using Instance		= RW_<Config_, Apex>;
+
+	using Control		= ControlT	   <Args>;
+	using FullControl	= FullControlT <Args>;
+	using GuardControl	= GuardControlT<Args>;
+
+	using Injection		= InjectionT<Args>;
+
+	//----------------------------------------------------------------------
+
+	using DynamicState	= DynamicEmptyT<Args>;
+
+	template <typename... TInjections>
+	using DynamicStateT	= DB_<TInjections...>;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	using StaticState	= StaticEmptyT<Args>;
+
+	template <typename... TInjections>
+	using StaticStateT	= SB_<TInjections...>;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	using State			= StaticState;
+
+	template <typename... TInjections>
+	using StateT		= StaticStateT<TInjections...>;
+
+	//----------------------------------------------------------------------
+
+	template <typename T>
+	static constexpr bool contains() {
+		return StateList::template index<T>() != INVALID_LONG_INDEX;
+	}
+
+	template <typename T>
+	static constexpr StateID  stateId()		{ return			StateList ::template index<T>();	}
+
+	template <typename T>
+	static constexpr RegionID regionId()	{ return (RegionID) RegionList::template index<T>();	}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
+struct CSubMaterialT;
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+struct CSubMaterialT<TN, TA, SG, NI, ITL_<TS...>> {
+	using Type = CS_<TN, TA, SG, NI,	  TS...>;
+};
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+using CSubMaterial = typename CSubMaterialT<TN, TA, SG, NI, TS...>::Type;
+
+//------------------------------------------------------------------------------
+
+template <typename...>
+struct InfoT;
+
+template <typename TN, typename TA, typename TH>
+struct InfoT<S_<TN, TA, TH>> {
+	using Type = SI_<	TH>;
+};
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+struct InfoT<C_<TN, TA, SG, TH, TS...>> {
+	using Type = CI_<	SG, TH, TS...>;
+};
+
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+struct InfoT<O_<TN, TA, EX, TH, TS...>> {
+	using Type = OI_<	EX, TH, TS...>;
+};
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+struct InfoT<CS_<TN, TA, SG, NI, TS...>> {
+	using Type = CSI_<			 TS...>;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TIndices,
+		  typename TArgs,
+		  Strategy TStrategy,
+		  ShortIndex NIndex,
+		  typename... TStates>
+struct CS_ final {
+	static_assert(sizeof...(TStates) >= 2, "");
+
+	using Indices		= TIndices;
+	static constexpr StateID	INITIAL_ID	= Indices::STATE_ID;
+	static constexpr ShortIndex COMPO_INDEX	= Indices::COMPO_INDEX;
+	static constexpr ShortIndex ORTHO_INDEX	= Indices::ORTHO_INDEX;
+	static constexpr ShortIndex ORTHO_UNIT	= Indices::ORTHO_UNIT;
+
+	static constexpr Strategy	STRATEGY	= TStrategy;
+
+	static constexpr ShortIndex REGION_ID	= COMPO_INDEX + ORTHO_INDEX;
+	static constexpr ShortIndex PRONG_INDEX	= NIndex;
+
+	using Args			= TArgs;
+	using Rank			= typename Args::Rank;
+	using Utility		= typename Args::Utility;
+	using UP			= typename Args::UP;
+	using StateList		= typename Args::StateList;
+	using RegionList	= typename Args::RegionList;
+
+	using Registry		= RegistryT<Args>;
+	using StateParents	= typename Registry::StateParents;
+
+	using Control		= ControlT	   <Args>;
+	using PlanControl	= PlanControlT <Args>;
+	using FullControl	= FullControlT <Args>;
+	using GuardControl	= GuardControlT<Args>;
+
+	static constexpr ShortIndex L_PRONG = PRONG_INDEX;
+
+	using LStates		= SplitL<TStates...>;
+	using LHalf			= CSubMaterial<I_<INITIAL_ID,
+										  COMPO_INDEX,
+										  ORTHO_INDEX,
+										  ORTHO_UNIT>,
+									   Args,
+									   STRATEGY,
+									   L_PRONG,
+									   LStates>;
+	using LHalfInfo		= typename InfoT<LHalf>::Type;
+
+	static constexpr ShortIndex R_PRONG = PRONG_INDEX + LStates::SIZE;
+
+	using RStates		= SplitR<TStates...>;
+	using RHalf			= CSubMaterial<I_<INITIAL_ID  + LHalfInfo::STATE_COUNT,
+										  COMPO_INDEX + LHalfInfo::COMPO_REGIONS,
+										  ORTHO_INDEX + LHalfInfo::ORTHO_REGIONS,
+										  ORTHO_UNIT  + LHalfInfo::ORTHO_UNITS>,
+									   Args,
+									   STRATEGY,
+									   R_PRONG,
+									   RStates>;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_EXPLICIT_MEMBER_SPECIALIZATION
+	template <typename T>
+	HFSM_INLINE		  T& access();
+
+	template <typename T>
+	HFSM_INLINE const T& access() const;
+#endif
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE void	wideRegister				  (Registry& registry, const Parent parent);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE bool	wideForwardEntryGuard		  (GuardControl& control,								const ShortIndex prong);
+	HFSM_INLINE bool	wideEntryGuard				  (GuardControl& control,								const ShortIndex prong);
+
+	HFSM_INLINE void	wideConstruct				  (PlanControl&  control,								const ShortIndex prong);
+
+	HFSM_INLINE void	wideEnter					  (PlanControl&  control,								const ShortIndex prong);
+	HFSM_INLINE void	wideReenter					  (PlanControl&  control,								const ShortIndex prong);
+
+	HFSM_INLINE Status	wideUpdate					  (FullControl&  control,								const ShortIndex prong);
+
+	template <typename TEvent>
+	HFSM_INLINE Status	wideReact					  (FullControl&  control, const TEvent& event,			const ShortIndex prong);
+
+	HFSM_INLINE bool	wideForwardExitGuard		  (GuardControl& control,								const ShortIndex prong);
+	HFSM_INLINE bool	wideExitGuard				  (GuardControl& control,								const ShortIndex prong);
+
+	HFSM_INLINE void	wideExit					  (PlanControl&  control,								const ShortIndex prong);
+
+	HFSM_INLINE void	wideDestruct				  (PlanControl&  control,								const ShortIndex prong);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE void	wideForwardActive			  (Control& control,	 const Request::Type request,	const ShortIndex prong);
+	HFSM_INLINE void	wideForwardRequest			  (Control& control,	 const Request::Type request,	const ShortIndex prong);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_EXPLICIT_MEMBER_SPECIALIZATION
+
+	template <Strategy = STRATEGY>
+	HFSM_INLINE void	wideRequestChange			  (Control& control,									const ShortIndex = INVALID_SHORT_INDEX);
+
+	template <>
+	HFSM_INLINE void	wideRequestChange<Composite>  (Control& control,									const ShortIndex)		{ wideRequestChangeComposite(control);			}
+
+	template <>
+	HFSM_INLINE	void	wideRequestChange<Resumable>  (Control& control,									const ShortIndex prong)	{ wideRequestChangeResumable(control, prong);	}
+
+#else
+
+	HFSM_INLINE void	wideRequestChange			  (Control& control,									const ShortIndex = INVALID_SHORT_INDEX);
+
+#endif
+
+	HFSM_INLINE void	wideRequestChangeComposite	  (Control& control);
+	HFSM_INLINE void	wideRequestChangeResumable	  (Control& control,									const ShortIndex prong);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE void	wideRequestRemain			  (Registry& registry);
+	HFSM_INLINE void	wideRequestRestart			  (Registry& registry);
+	HFSM_INLINE void	wideRequestResume			  (Registry& registry,									const ShortIndex prong);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE UP		wideReportChangeComposite	  (Control& control);
+	HFSM_INLINE UP		wideReportChangeResumable	  (Control& control,									const ShortIndex prong);
+	HFSM_INLINE UP		wideReportChangeUtilitarian	  (Control& control);
+	HFSM_INLINE Utility	wideReportChangeRandom		  (Control& control,	 Utility* const options, const Rank* const ranks, const Rank top);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE UP		wideReportUtilize			  (Control& control);
+	HFSM_INLINE Rank	wideReportRank				  (Control& control,	 Rank*	  const ranks);
+	HFSM_INLINE Utility	wideReportRandomize			  (Control& control,	 Utility* const options, const Rank* const ranks, const Rank top);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE void	wideChangeToRequested		  (PlanControl& control, const ShortIndex prong);
+
+	//----------------------------------------------------------------------
+
+#ifdef HFSM_ENABLE_STRUCTURE_REPORT
+	using StructureStateInfos = typename Args::StructureStateInfos;
+	using RegionType		  = typename StructureStateInfo::RegionType;
+
+	static constexpr LongIndex NAME_COUNT = LHalf::NAME_COUNT + RHalf::NAME_COUNT;
+
+	void wideGetNames(const LongIndex parent,
+					  const RegionType region,
+					  const ShortIndex depth,
+					  StructureStateInfos& stateInfos) const;
+#endif
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_SERIALIZATION
+	using WriteStream	= typename Args::WriteStream;
+	using ReadStream	= typename Args::ReadStream;
+
+	HFSM_INLINE void	wideSaveActive	 (const Registry& registry, WriteStream& stream, const ShortIndex prong) const;
+	HFSM_INLINE void	wideSaveResumable(const Registry& registry, WriteStream& stream						   ) const;
+
+	HFSM_INLINE void	wideLoadRequested(		Registry& registry, ReadStream&  stream, const ShortIndex prong) const;
+	HFSM_INLINE void	wideLoadResumable(		Registry& registry, ReadStream&  stream						   ) const;
+#endif
+
+	//----------------------------------------------------------------------
+
+	LHalf lHalf;
+	RHalf rHalf;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TIndices,
+		  typename TArgs,
+		  Strategy TStrategy,
+		  ShortIndex NIndex,
+		  typename TState>
+struct CS_<TIndices, TArgs, TStrategy, NIndex, TState> final {
+	using Indices		= TIndices;
+	static constexpr StateID	INITIAL_ID	= Indices::STATE_ID;
+	static constexpr ShortIndex COMPO_INDEX	= Indices::COMPO_INDEX;
+	static constexpr ShortIndex ORTHO_INDEX	= Indices::ORTHO_INDEX;
+	static constexpr ShortIndex ORTHO_UNIT	= Indices::ORTHO_UNIT;
+
+	static constexpr Strategy	STRATEGY	= TStrategy;
+
+	static constexpr ShortIndex REGION_ID	= COMPO_INDEX + ORTHO_INDEX;
+	static constexpr ShortIndex PRONG_INDEX	= NIndex;
+
+	using Args			= TArgs;
+	using Rank			= typename Args::Rank;
+	using Utility		= typename Args::Utility;
+	using UP			= typename Args::UP;
+	using StateList		= typename Args::StateList;
+	using RegionList	= typename Args::RegionList;
+
+	using Registry	= RegistryT<Args>;
+	using StateParents	= typename Registry::StateParents;
+
+	using Control		= ControlT	   <Args>;
+	using PlanControl	= PlanControlT <Args>;
+	using FullControl	= FullControlT <Args>;
+	using GuardControl	= GuardControlT<Args>;
+
+	using State			= Material<I_<INITIAL_ID,
+									  COMPO_INDEX,
+									  ORTHO_INDEX,
+									  ORTHO_UNIT>,
+								   Args,
+								   TState>;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_EXPLICIT_MEMBER_SPECIALIZATION
+	template <typename T>
+	HFSM_INLINE		  T& access()					  { return state.template access<T>();	}
+
+	template <typename T>
+	HFSM_INLINE const T& access() const				  { return state.template access<T>();	}
+#endif
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE void	wideRegister				  (Registry& registry, const Parent parent);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE bool	wideForwardEntryGuard		  (GuardControl& control,								const ShortIndex prong);
+	HFSM_INLINE bool	wideEntryGuard				  (GuardControl& control,								const ShortIndex prong);
+
+	HFSM_INLINE void	wideConstruct				  (PlanControl& control,								const ShortIndex prong);
+
+	HFSM_INLINE void	wideEnter					  (PlanControl& control,								const ShortIndex prong);
+	HFSM_INLINE void	wideReenter					  (PlanControl& control,								const ShortIndex prong);
+
+	HFSM_INLINE Status	wideUpdate					  (FullControl& control,								const ShortIndex prong);
+
+	template <typename TEvent>
+	HFSM_INLINE Status	wideReact					  (FullControl& control, const TEvent& event,			const ShortIndex prong);
+
+	HFSM_INLINE bool	wideForwardExitGuard		  (GuardControl& control,								const ShortIndex prong);
+	HFSM_INLINE bool	wideExitGuard				  (GuardControl& control,								const ShortIndex prong);
+
+	HFSM_INLINE void	wideExit					  (PlanControl& control,								const ShortIndex prong);
+
+	HFSM_INLINE void	wideDestruct				  (PlanControl& control,								const ShortIndex prong);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE void	wideForwardActive			  (Control& control,	 const Request::Type request,	const ShortIndex prong);
+	HFSM_INLINE void	wideForwardRequest			  (Control& control,	 const Request::Type request,	const ShortIndex prong);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE void	wideRequestChangeComposite	  (Control& control);
+	HFSM_INLINE void	wideRequestChangeResumable	  (Control& control,	 								const ShortIndex prong);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE void	wideRequestRemain			  (Registry& registry);
+	HFSM_INLINE void	wideRequestRestart			  (Registry& registry);
+	HFSM_INLINE void	wideRequestResume			  (Registry& registry,									const ShortIndex prong);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE UP		wideReportChangeComposite	  (Control& control);
+	HFSM_INLINE UP		wideReportChangeResumable	  (Control& control,									const ShortIndex prong);
+	HFSM_INLINE UP		wideReportChangeUtilitarian	  (Control& control);
+	HFSM_INLINE Utility	wideReportChangeRandom		  (Control& control,	 Utility* const options, const Rank* const ranks, const Rank top);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE UP		wideReportUtilize			  (Control& control);
+	HFSM_INLINE Rank	wideReportRank				  (Control& control,	 Rank*	  const ranks);
+	HFSM_INLINE Utility	wideReportRandomize			  (Control& control,	 Utility* const options, const Rank* const ranks, const Rank top);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE void	wideChangeToRequested		  (PlanControl& control,								const ShortIndex prong);
+
+	//----------------------------------------------------------------------
+
+#ifdef HFSM_ENABLE_STRUCTURE_REPORT
+	using StructureStateInfos = typename Args::StructureStateInfos;
+	using RegionType		  = typename StructureStateInfo::RegionType;
+
+	static constexpr LongIndex NAME_COUNT = State::NAME_COUNT;
+
+	void wideGetNames(const LongIndex parent,
+					  const RegionType region,
+					  const ShortIndex depth,
+					  StructureStateInfos& stateInfos) const;
+#endif
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_SERIALIZATION
+	using WriteStream	= typename Args::WriteStream;
+	using ReadStream	= typename Args::ReadStream;
+
+	HFSM_INLINE void	wideSaveActive	 (const Registry& registry, WriteStream& stream, const ShortIndex prong) const;
+	HFSM_INLINE void	wideSaveResumable(const Registry& registry, WriteStream& stream						   ) const;
+
+	HFSM_INLINE void	wideLoadRequested(		Registry& registry, ReadStream&  stream, const ShortIndex prong) const;
+	HFSM_INLINE void	wideLoadResumable(		Registry& registry, ReadStream&  stream						   ) const;
+#endif
+
+	//----------------------------------------------------------------------
+
+	State state;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef HFSM_EXPLICIT_MEMBER_SPECIALIZATION
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+template <typename T>
+T&
+CS_<TN, TA, SG, NI, TS...>::access() {
+	return LHalfInfo::StateList::template contains<T>() ?
+		lHalf.template access<T>() :
+		rHalf.template access<T>();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+template <typename T>
+const T&
+CS_<TN, TA, SG, NI, TS...>::access() const {
+	return LHalfInfo::StateList::template contains<T>() ?
+		lHalf.template access<T>() :
+		rHalf.template access<T>();
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+void
+CS_<TN, TA, SG, NI, TS...>::wideRegister(Registry& registry,
+										 const Parent parent)
+{
+	lHalf.wideRegister(registry, Parent{parent.forkId, L_PRONG});
+	rHalf.wideRegister(registry, Parent{parent.forkId, R_PRONG});
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+bool
+CS_<TN, TA, SG, NI, TS...>::wideForwardEntryGuard(GuardControl& control,
+												  const ShortIndex prong)
+{
+	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
+
+	if (prong < R_PRONG)
+		return lHalf.wideForwardEntryGuard(control, prong);
+	else
+		return rHalf.wideForwardEntryGuard(control, prong);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+bool
+CS_<TN, TA, SG, NI, TS...>::wideEntryGuard(GuardControl& control,
+										   const ShortIndex prong)
+{
+	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
+
+	if (prong < R_PRONG)
+		return lHalf.wideEntryGuard(control, prong);
+	else
+		return rHalf.wideEntryGuard(control, prong);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+void
+CS_<TN, TA, SG, NI, TS...>::wideConstruct(PlanControl& control,
+										  const ShortIndex prong)
+{
+	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
+
+	if (prong < R_PRONG)
+		lHalf.wideConstruct(control, prong);
+	else
+		rHalf.wideConstruct(control, prong);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+void
+CS_<TN, TA, SG, NI, TS...>::wideEnter(PlanControl& control,
+									  const ShortIndex prong)
+{
+	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
+
+	if (prong < R_PRONG)
+		lHalf.wideEnter(control, prong);
+	else
+		rHalf.wideEnter(control, prong);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+void
+CS_<TN, TA, SG, NI, TS...>::wideReenter(PlanControl& control,
+										const ShortIndex prong)
+{
+	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
+
+	if (prong < R_PRONG)
+		lHalf.wideReenter(control, prong);
+	else
+		rHalf.wideReenter(control, prong);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+Status
+CS_<TN, TA, SG, NI, TS...>::wideUpdate(FullControl& control,
+									   const ShortIndex prong)
+{
+	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
+
+	return prong < R_PRONG ?
+		lHalf.wideUpdate(control, prong) :
+		rHalf.wideUpdate(control, prong);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+template <typename TEvent>
+Status
+CS_<TN, TA, SG, NI, TS...>::wideReact(FullControl& control,
+									  const TEvent& event,
+									  const ShortIndex prong)
+{
+	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
+
+	return prong < R_PRONG ?
+		lHalf.wideReact(control, event, prong) :
+		rHalf.wideReact(control, event, prong);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+bool
+CS_<TN, TA, SG, NI, TS...>::wideForwardExitGuard(GuardControl& control,
+												 const ShortIndex prong)
+{
+	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
+
+	if (prong < R_PRONG)
+		return lHalf.wideForwardExitGuard(control, prong);
+	else
+		return rHalf.wideForwardExitGuard(control, prong);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+bool
+CS_<TN, TA, SG, NI, TS...>::wideExitGuard(GuardControl& control,
+										  const ShortIndex prong)
+{
+	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
+
+	if (prong < R_PRONG)
+		return lHalf.wideExitGuard(control, prong);
+	else
+		return rHalf.wideExitGuard(control, prong);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+void
+CS_<TN, TA, SG, NI, TS...>::wideExit(PlanControl& control,
+									 const ShortIndex prong)
+{
+	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
+
+	if (prong < R_PRONG)
+		lHalf.wideExit(control, prong);
+	else
+		rHalf.wideExit(control, prong);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+void
+CS_<TN, TA, SG, NI, TS...>::wideDestruct(PlanControl& control,
+										 const ShortIndex prong)
+{
+	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
+
+	if (prong < R_PRONG)
+		lHalf.wideDestruct(control, prong);
+	else
+		rHalf.wideDestruct(control, prong);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+void
+CS_<TN, TA, SG, NI, TS...>::wideForwardActive(Control& control,
+											  const Request::Type request,
+											  const ShortIndex prong)
+{
+	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
+
+	if (prong < R_PRONG)
+		lHalf.wideForwardActive(control, request, prong);
+	else
+		rHalf.wideForwardActive(control, request, prong);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+void
+CS_<TN, TA, SG, NI, TS...>::wideForwardRequest(Control& control,
+											   const Request::Type request,
+											   const ShortIndex prong)
+{
+	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
+
+	if (prong < R_PRONG)
+		lHalf.wideForwardRequest(control, request, prong);
+	else
+		rHalf.wideForwardRequest(control, request, prong);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+void
+CS_<TN, TA, SG, NI, TS...>::wideRequestChangeComposite(Control& control) {
+	lHalf.wideRequestChangeComposite(control);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+void
+CS_<TN, TA, SG, NI, TS...>::wideRequestChangeResumable(Control& control,
+													   const ShortIndex prong)
+{
+	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
+
+	if (prong < R_PRONG)
+		lHalf.wideRequestChangeResumable(control, prong);
+	else
+		rHalf.wideRequestChangeResumable(control, prong);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+void
+CS_<TN, TA, SG, NI, TS...>::wideRequestRemain(Registry& registry) {
+	lHalf.wideRequestRemain(registry);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+void
+CS_<TN, TA, SG, NI, TS...>::wideRequestRestart(Registry& registry) {
+	lHalf.wideRequestRestart(registry);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+void
+CS_<TN, TA, SG, NI, TS...>::wideRequestResume(Registry& registry,
+											  const ShortIndex prong)
+{
+	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
+
+	if (prong < R_PRONG)
+		lHalf.wideRequestResume(registry, prong);
+	else
+		rHalf.wideRequestResume(registry, prong);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+typename TA::UP
+CS_<TN, TA, SG, NI, TS...>::wideReportUtilize(Control& control) {
+	const UP l = lHalf.wideReportUtilize(control);
+	const UP r = rHalf.wideReportUtilize(control);
+
+	return l.utility >= r.utility ?
+		l : r;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+typename TA::Rank
+CS_<TN, TA, SG, NI, TS...>::wideReportRank(Control& control,
+										   Rank* const ranks)
+{
+	HFSM_ASSERT(ranks);
+
+	const Rank l = lHalf.wideReportRank(control, ranks);
+	const Rank r = rHalf.wideReportRank(control, ranks + LStates::SIZE);
+
+	return l > r?
+		l : r;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+typename TA::Utility
+CS_<TN, TA, SG, NI, TS...>::wideReportRandomize(Control& control,
+												Utility* const options,
+												const Rank* const ranks,
+												const Rank top)
+{
+	HFSM_ASSERT(options && ranks);
+
+	const Utility l = lHalf.wideReportRandomize(control, options,				  ranks,				 top);
+	const Utility r = rHalf.wideReportRandomize(control, options + LStates::SIZE, ranks + LStates::SIZE, top);
+
+	return { l + r };
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+typename TA::UP
+CS_<TN, TA, SG, NI, TS...>::wideReportChangeComposite(Control& control) {
+	return lHalf.wideReportChangeComposite(control);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+typename TA::UP
+CS_<TN, TA, SG, NI, TS...>::wideReportChangeResumable(Control& control,
+													  const ShortIndex prong)
+{
+	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
+
+	if (prong < R_PRONG)
+		return lHalf.wideReportChangeResumable(control, prong);
+	else
+		return rHalf.wideReportChangeResumable(control, prong);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+typename TA::UP
+CS_<TN, TA, SG, NI, TS...>::wideReportChangeUtilitarian(Control& control) {
+	const UP l = lHalf.wideReportChangeUtilitarian(control);
+	const UP r = rHalf.wideReportChangeUtilitarian(control);
+
+	return l.utility >= r.utility ?
+		l : r;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+typename TA::Utility
+CS_<TN, TA, SG, NI, TS...>::wideReportChangeRandom(Control& control,
+												   Utility* const options,
+												   const Rank* const ranks,
+												   const Rank top)
+{
+	HFSM_ASSERT(options && ranks);
+
+	const Utility l = lHalf.wideReportChangeRandom(control, options,				 ranks,					top);
+	const Utility r = rHalf.wideReportChangeRandom(control, options + LStates::SIZE, ranks + LStates::SIZE, top);
+
+	return { l + r };
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+void
+CS_<TN, TA, SG, NI, TS...>::wideChangeToRequested(PlanControl& control,
+												  const ShortIndex prong)
+{
+	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
+
+	if (prong < R_PRONG)
+		lHalf.wideChangeToRequested(control, prong);
+	else
+		rHalf.wideChangeToRequested(control, prong);
+}
+
+//------------------------------------------------------------------------------
+
+#ifdef HFSM_ENABLE_STRUCTURE_REPORT
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+void
+CS_<TN, TA, SG, NI, TS...>::wideGetNames(const LongIndex parent,
+										 const RegionType /*region*/,
+										 const ShortIndex depth,
+										 StructureStateInfos& _stateInfos) const
+{
+	lHalf.wideGetNames(parent, StructureStateInfo::COMPOSITE, depth, _stateInfos);
+	rHalf.wideGetNames(parent, StructureStateInfo::COMPOSITE, depth, _stateInfos);
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+
+#ifdef HFSM_ENABLE_SERIALIZATION
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+void
+CS_<TN, TA, SG, NI, TS...>::wideSaveActive(const Registry& registry,
+										   WriteStream& stream,
+										   const ShortIndex prong) const
+{
+	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
+
+	if (prong < R_PRONG) {
+		lHalf.wideSaveActive   (registry, stream, prong);
+		rHalf.wideSaveResumable(registry, stream);
+	} else {
+		lHalf.wideSaveResumable(registry, stream);
+		rHalf.wideSaveActive   (registry, stream, prong);
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+void
+CS_<TN, TA, SG, NI, TS...>::wideSaveResumable(const Registry& registry,
+											  WriteStream& stream) const
+{
+	lHalf.wideSaveResumable(registry, stream);
+	rHalf.wideSaveResumable(registry, stream);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+void
+CS_<TN, TA, SG, NI, TS...>::wideLoadRequested(Registry& registry,
+											  ReadStream& stream,
+											  const ShortIndex prong) const
+{
+	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
+
+	if (prong < R_PRONG) {
+		lHalf.wideLoadRequested(registry, stream, prong);
+		rHalf.wideLoadResumable(registry, stream);
+	} else {
+		lHalf.wideLoadResumable(registry, stream);
+		rHalf.wideLoadRequested(registry, stream, prong);
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+void
+CS_<TN, TA, SG, NI, TS...>::wideLoadResumable(Registry& registry,
+											  ReadStream& stream) const
+{
+	lHalf.wideLoadResumable(registry, stream);
+	rHalf.wideLoadResumable(registry, stream);
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
+void
+CS_<TN, TA, SG, NI, T>::wideRegister(Registry& registry,
+									 const Parent parent)
+{
+	state.deepRegister(registry, Parent{parent.forkId, PRONG_INDEX});
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
+bool
+CS_<TN, TA, SG, NI, T>::wideForwardEntryGuard(GuardControl& control,
+											  const ShortIndex HFSM_IF_ASSERT(prong))
+{
+	HFSM_ASSERT(prong == PRONG_INDEX);
+
+	return state.deepForwardEntryGuard(control);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
+bool
+CS_<TN, TA, SG, NI, T>::wideEntryGuard(GuardControl& control,
+									   const ShortIndex HFSM_IF_ASSERT(prong))
+{
+	HFSM_ASSERT(prong == PRONG_INDEX);
+
+	return state.deepEntryGuard(control);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
+void
+CS_<TN, TA, SG, NI, T>::wideConstruct(PlanControl& control,
+									  const ShortIndex HFSM_IF_ASSERT(prong))
+{
+	HFSM_ASSERT(prong == PRONG_INDEX);
+
+	state.deepConstruct(control);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
+void
+CS_<TN, TA, SG, NI, T>::wideEnter(PlanControl& control,
+								  const ShortIndex HFSM_IF_ASSERT(prong))
+{
+	HFSM_ASSERT(prong == PRONG_INDEX);
+
+	state.deepEnter(control);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
+void
+CS_<TN, TA, SG, NI, T>::wideReenter(PlanControl& control,
+									const ShortIndex HFSM_IF_ASSERT(prong))
+{
+	HFSM_ASSERT(prong == PRONG_INDEX);
+
+	state.deepReenter(control);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
+Status
+CS_<TN, TA, SG, NI, T>::wideUpdate(FullControl& control,
+								   const ShortIndex HFSM_IF_ASSERT(prong))
+{
+	HFSM_ASSERT(prong == PRONG_INDEX);
+
+	return state.deepUpdate(control);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
+template <typename TEvent>
+Status
+CS_<TN, TA, SG, NI, T>::wideReact(FullControl& control,
+								  const TEvent& event,
+								  const ShortIndex HFSM_IF_ASSERT(prong))
+{
+	HFSM_ASSERT(prong == PRONG_INDEX);
+
+	return state.deepReact(control, event);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
+bool
+CS_<TN, TA, SG, NI, T>::wideForwardExitGuard(GuardControl& control,
+											 const ShortIndex HFSM_IF_ASSERT(prong))
+{
+	HFSM_ASSERT(prong == PRONG_INDEX);
+
+	return state.deepForwardExitGuard(control);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
+bool
+CS_<TN, TA, SG, NI, T>::wideExitGuard(GuardControl& control,
+									  const ShortIndex HFSM_IF_ASSERT(prong))
+{
+	HFSM_ASSERT(prong == PRONG_INDEX);
+
+	return state.deepExitGuard(control);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
+void
+CS_<TN, TA, SG, NI, T>::wideExit(PlanControl& control,
+								 const ShortIndex HFSM_IF_ASSERT(prong))
+{
+	HFSM_ASSERT(prong == PRONG_INDEX);
+
+	state.deepExit(control);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
+void
+CS_<TN, TA, SG, NI, T>::wideDestruct(PlanControl& control,
+									 const ShortIndex HFSM_IF_ASSERT(prong))
+{
+	HFSM_ASSERT(prong == PRONG_INDEX);
+
+	state.deepDestruct(control);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
+void
+CS_<TN, TA, SG, NI, T>::wideForwardActive(Control& control,
+										  const Request::Type request,
+										  const ShortIndex HFSM_IF_ASSERT(prong))
+{
+	HFSM_ASSERT(prong == PRONG_INDEX);
+
+	state.deepForwardActive(control, request);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
+void
+CS_<TN, TA, SG, NI, T>::wideForwardRequest(Control& control,
+										   const Request::Type request,
+										   const ShortIndex HFSM_IF_ASSERT(prong))
+{
+	HFSM_ASSERT(prong == PRONG_INDEX);
+
+	state.deepForwardRequest(control, request);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
+void
+CS_<TN, TA, SG, NI, T>::wideRequestChangeComposite(Control& control) {
+	state.deepRequestChange(control);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
+void
+CS_<TN, TA, SG, NI, T>::wideRequestChangeResumable(Control& control,
+												   const ShortIndex HFSM_IF_ASSERT(prong))
+{
+	HFSM_ASSERT(prong == PRONG_INDEX);
+
+	state.deepRequestChange(control);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
+void
+CS_<TN, TA, SG, NI, T>::wideRequestRemain(Registry& registry) {
+	state.deepRequestRemain(registry);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
+void
+CS_<TN, TA, SG, NI, T>::wideRequestRestart(Registry& registry) {
+	state.deepRequestRestart(registry);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
+void
+CS_<TN, TA, SG, NI, T>::wideRequestResume(Registry& registry,
+										  const ShortIndex HFSM_IF_ASSERT(prong))
+{
+	HFSM_ASSERT(prong == PRONG_INDEX);
+
+	state.deepRequestResume(registry);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
+typename TA::UP
+CS_<TN, TA, SG, NI, T>::wideReportUtilize(Control& control) {
+	return state.deepReportUtilize(control);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
+typename TA::Rank
+CS_<TN, TA, SG, NI, T>::wideReportRank(Control& control,
+									   Rank* const ranks)
+{
+	HFSM_ASSERT(ranks);
+
+	*ranks = state.deepReportRank(control);
+
+	return *ranks;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
+typename TA::Utility
+CS_<TN, TA, SG, NI, T>::wideReportRandomize(Control& control,
+											Utility* const options,
+											const Rank* const ranks,
+											const Rank top)
+{
+	HFSM_ASSERT(options && ranks);
+
+	*options = (*ranks == top) ?
+		state.deepReportRandomize(control) : Utility{0.0f};
+
+	return *options;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
+typename TA::UP
+CS_<TN, TA, SG, NI, T>::wideReportChangeComposite(Control& control) {
+	return state.deepReportChange(control);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
+typename TA::UP
+CS_<TN, TA, SG, NI, T>::wideReportChangeResumable(Control& control,
+												  const ShortIndex HFSM_IF_ASSERT(prong))
+{
+	HFSM_ASSERT(prong == PRONG_INDEX);
+
+	return state.deepReportChange(control);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
+typename TA::UP
+CS_<TN, TA, SG, NI, T>::wideReportChangeUtilitarian(Control& control) {
+	return state.deepReportChange(control);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
+typename TA::Utility
+CS_<TN, TA, SG, NI, T>::wideReportChangeRandom(Control& control,
+											   Utility* const options,
+											   const Rank* const ranks,
+											   const Rank top)
+{
+	HFSM_ASSERT(options && ranks);
+
+	*options = (*ranks == top) ?
+		state.deepReportChange(control).utility : Utility{0.0f};
+
+	return *options;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
+void
+CS_<TN, TA, SG, NI, T>::wideChangeToRequested(PlanControl& control,
+											  const ShortIndex HFSM_IF_ASSERT(prong))
+{
+	HFSM_ASSERT(prong == PRONG_INDEX);
+
+	state.deepChangeToRequested(control);
+}
+
+//------------------------------------------------------------------------------
+
+#ifdef HFSM_ENABLE_STRUCTURE_REPORT
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
+void
+CS_<TN, TA, SG, NI, T>::wideGetNames(const LongIndex parent,
+									 const RegionType /*region*/,
+									 const ShortIndex depth,
+									 StructureStateInfos& _stateInfos) const
+{
+	state.deepGetNames(parent, StructureStateInfo::COMPOSITE, depth, _stateInfos);
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+
+#ifdef HFSM_ENABLE_SERIALIZATION
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
+void
+CS_<TN, TA, SG, NI, T>::wideSaveActive(const Registry& registry,
+									   WriteStream& stream,
+									   const ShortIndex HFSM_IF_ASSERT(prong)) const
+{
+	HFSM_ASSERT(prong == PRONG_INDEX);
+
+	state.deepSaveActive(registry, stream);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
+void
+CS_<TN, TA, SG, NI, T>::wideSaveResumable(const Registry& registry,
+										  WriteStream& stream) const
+{
+	state.deepSaveResumable(registry, stream);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
+void
+CS_<TN, TA, SG, NI, T>::wideLoadRequested(Registry& registry,
+										  ReadStream& stream,
+										  const ShortIndex HFSM_IF_ASSERT(prong)) const
+{
+	HFSM_ASSERT(prong == PRONG_INDEX);
+
+	state.deepLoadRequested(registry, stream);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
+void
+CS_<TN, TA, SG, NI, T>::wideLoadResumable(Registry& registry,
+										  ReadStream& stream) const
+{
+	state.deepLoadResumable(registry, stream);
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TIndices,
+		  typename TArgs,
+		  Strategy TStrategy,
+		  typename THead,
+		  typename... TSubStates>
+struct C_ final {
+	using Indices		= TIndices;
+	static constexpr StateID	HEAD_ID		= Indices::STATE_ID;
+	static constexpr ShortIndex COMPO_INDEX	= Indices::COMPO_INDEX;
+	static constexpr ShortIndex ORTHO_INDEX	= Indices::ORTHO_INDEX;
+	static constexpr ShortIndex ORTHO_UNIT	= Indices::ORTHO_UNIT;
+
+	static constexpr Strategy	STRATEGY	= TStrategy;
+
+	static constexpr ShortIndex REGION_ID	= COMPO_INDEX + ORTHO_INDEX;
+	static constexpr ForkID		COMPO_ID	= COMPO_INDEX + 1;
+
+	using Args			= TArgs;
+	using Rank			= typename Args::Rank;
+	using Utility		= typename Args::Utility;
+	using UP			= typename Args::UP;
+	using StateList		= typename Args::StateList;
+	using RegionList	= typename Args::RegionList;
+
+	using Registry		= RegistryT<Args>;
+	using StateParents	= typename Registry::StateParents;
+
+	using Control		= ControlT<Args>;
+
+	using PlanControl	= PlanControlT<Args>;
+	using ScopedOrigin	= typename PlanControl::Origin;
+	using ScopedRegion	= typename PlanControl::Region;
+	using Plan			= PlanT<Args>;
+
+	using FullControl	= FullControlT<Args>;
+	using ControlLock	= typename FullControl::Lock;
+
+	using GuardControl	= GuardControlT<Args>;
+
+	using Head			= THead;
+
+	using HeadState		= S_<Indices, Args, Head>;
+
+	using SubStates		= CS_<I_<HEAD_ID + 1,
+								 COMPO_INDEX + 1,
+								 ORTHO_INDEX,
+								 ORTHO_UNIT>,
+							  Args,
+							  STRATEGY,
+							  0,
+							  TSubStates...>;
+
+	using Info			= CI_<STRATEGY, Head, TSubStates...>;
+	static constexpr ShortIndex WIDTH		= Info::WIDTH;
+	static constexpr ShortIndex WIDTH_BITS	= Info::WIDTH_BITS;
+	static constexpr ShortIndex STATE_COUNT	= Info::STATE_COUNT;
+
+	//----------------------------------------------------------------------
+
+#ifdef HFSM_EXPLICIT_MEMBER_SPECIALIZATION
+	template <typename T>
+	struct Accessor {
+		HFSM_INLINE static		 T&	   get(		 C_& c)								{ return c._subStates.template access<T>();		}
+		HFSM_INLINE static const T&	   get(const C_& c)								{ return c._subStates.template access<T>();		}
+	};
+
+	template <>
+	struct Accessor<Head> {
+		HFSM_INLINE static		 Head& get(		 C_& c)								{ return c._headState._headBox.get();			}
+		HFSM_INLINE static const Head& get(const C_& c)								{ return c._headState._headBox.get();			}
+	};
+
+	template <typename T>
+	HFSM_INLINE		  T&	access()												{ return Accessor<T>::get(*this);				}
+
+	template <typename T>
+	HFSM_INLINE const T&	access() const											{ return Accessor<T>::get(*this);				}
+#endif
+
+	//----------------------------------------------------------------------
+
+	HFSM_INLINE		  ShortIndex& compoRequested(	   Registry& registry) const	{ return registry.compoRequested[COMPO_INDEX];	}
+	HFSM_INLINE const ShortIndex& compoRequested(const Registry& registry) const	{ return registry.compoRequested[COMPO_INDEX];	}
+
+	HFSM_INLINE		  ShortIndex& compoActive   (	   Registry& registry) const	{ return registry.compoActive	[COMPO_INDEX];	}
+	HFSM_INLINE const ShortIndex& compoActive   (const Registry& registry) const	{ return registry.compoActive	[COMPO_INDEX];	}
+
+	HFSM_INLINE		  ShortIndex& compoResumable(	   Registry& registry) const	{ return registry.compoResumable[COMPO_INDEX];	}
+	HFSM_INLINE const ShortIndex& compoResumable(const Registry& registry) const	{ return registry.compoResumable[COMPO_INDEX];	}
+
+	HFSM_INLINE		  ShortIndex& compoRequested(	   Control& control) const		{ return compoRequested(control._registry);		}
+	HFSM_INLINE const ShortIndex& compoRequested(const Control& control) const		{ return compoRequested(control._registry);		}
+
+	HFSM_INLINE		  ShortIndex& compoActive   (	   Control& control) const		{ return compoActive   (control._registry);		}
+	HFSM_INLINE const ShortIndex& compoActive   (const Control& control) const		{ return compoActive   (control._registry);		}
+
+	HFSM_INLINE		  ShortIndex& compoResumable(	   Control& control) const		{ return compoResumable(control._registry);		}
+	HFSM_INLINE const ShortIndex& compoResumable(const Control& control) const		{ return compoResumable(control._registry);		}
+
+	HFSM_INLINE		  ShortIndex  resolveRandom (Control& control,
+												 const Utility(& options)[Info::WIDTH], const Utility sum,
+												 const Rank	  (& ranks)  [Info::WIDTH], const Rank	  top) const;
+
+	HFSM_INLINE bool	compoRemain					  (Control& control)	{ return control._registry.compoRemains.template get<COMPO_INDEX>(); }
+
+	HFSM_INLINE void	deepRegister				  (Registry& registry, const Parent parent);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE bool	deepForwardEntryGuard		  (GuardControl& control);
+	HFSM_INLINE bool	deepEntryGuard				  (GuardControl& control);
+
+	HFSM_INLINE void	deepConstruct				  (PlanControl& control);
+
+	HFSM_INLINE void	deepEnter					  (PlanControl&  control);
+	HFSM_INLINE void	deepReenter					  (PlanControl&  control);
+
+	HFSM_INLINE Status	deepUpdate					  (FullControl&  control);
+
+	template <typename TEvent>
+	HFSM_INLINE Status	deepReact					  (FullControl&  control, const TEvent& event);
+
+	HFSM_INLINE bool	deepForwardExitGuard		  (GuardControl& control);
+	HFSM_INLINE bool	deepExitGuard				  (GuardControl& control);
+
+	HFSM_INLINE void	deepExit					  (PlanControl&  control);
+
+	HFSM_INLINE void	deepDestruct				  (PlanControl&  control);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE void	deepForwardActive			  (Control& control, const Request::Type request);
+	HFSM_INLINE void	deepForwardRequest			  (Control& control, const Request::Type request);
+
+	HFSM_INLINE void	deepRequest					  (Control& control, const Request::Type request);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_EXPLICIT_MEMBER_SPECIALIZATION
+
+	template <Strategy = STRATEGY>
+	HFSM_INLINE void	deepRequestChange			  (Control& control, const ShortIndex = INVALID_SHORT_INDEX);
+
+	template <>
+	HFSM_INLINE void	deepRequestChange<Composite>  (Control& control, const ShortIndex)	{ deepRequestChangeComposite  (control); }
+
+	template <>
+	HFSM_INLINE void	deepRequestChange<Resumable>  (Control& control, const ShortIndex)	{ deepRequestChangeResumable  (control); }
+
+	template <>
+	HFSM_INLINE void	deepRequestChange<Utilitarian>(Control& control, const ShortIndex)	{ deepRequestChangeUtilitarian(control); }
+
+	template <>
+	HFSM_INLINE void	deepRequestChange<RandomUtil> (Control& control, const ShortIndex)	{ deepRequestChangeRandom	  (control); }
+
+#else
+
+	HFSM_INLINE void	deepRequestChange			  (Control& control);
+
+#endif
+
+	HFSM_INLINE void	deepRequestChangeComposite	  (Control& control);
+	HFSM_INLINE void	deepRequestChangeResumable	  (Control& control);
+	HFSM_INLINE void	deepRequestChangeUtilitarian  (Control& control);
+	HFSM_INLINE void	deepRequestChangeRandom		  (Control& control);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE void	deepRequestRemain			  (Registry& registry);
+	HFSM_INLINE void	deepRequestRestart			  (Registry& registry);
+	HFSM_INLINE void	deepRequestResume			  (Registry& registry);
+	HFSM_INLINE void	deepRequestUtilize			  (Control& control);
+	HFSM_INLINE void	deepRequestRandomize		  (Control& control);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_EXPLICIT_MEMBER_SPECIALIZATION
+
+	template <Strategy = STRATEGY>
+	HFSM_INLINE UP		deepReportChange			  (Control& control);
+
+	template <>
+	HFSM_INLINE UP		deepReportChange<Composite>   (Control& control)	{ return deepReportChangeComposite  (control); }
+
+	template <>
+	HFSM_INLINE UP		deepReportChange<Resumable>   (Control& control)	{ return deepReportChangeResumable  (control); }
+
+	template <>
+	HFSM_INLINE UP		deepReportChange<Utilitarian> (Control& control)	{ return deepReportChangeUtilitarian(control); }
+
+	template <>
+	HFSM_INLINE UP		deepReportChange<RandomUtil>  (Control& control)	{ return deepReportChangeRandom		(control); }
+
+#else
+
+	HFSM_INLINE UP		deepReportChange			  (Control& control);
+
+#endif
+
+	HFSM_INLINE UP		deepReportChangeComposite	  (Control& control);
+	HFSM_INLINE UP		deepReportChangeResumable	  (Control& control);
+	HFSM_INLINE UP		deepReportChangeUtilitarian   (Control& control);
+	HFSM_INLINE UP		deepReportChangeRandom		  (Control& control);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE UP		deepReportUtilize			  (Control& control);
+	HFSM_INLINE Rank	deepReportRank				  (Control& control);
+	HFSM_INLINE Utility	deepReportRandomize			  (Control& control);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE void	deepChangeToRequested		  (PlanControl& control);
+
+	//----------------------------------------------------------------------
+
+#ifdef HFSM_ENABLE_STRUCTURE_REPORT
+	using StructureStateInfos = typename Args::StructureStateInfos;
+	using RegionType		  = typename StructureStateInfo::RegionType;
+
+	static constexpr LongIndex NAME_COUNT = HeadState::NAME_COUNT + SubStates::NAME_COUNT;
+
+	void deepGetNames(const LongIndex parent,
+					  const RegionType region,
+					  const ShortIndex depth,
+					  StructureStateInfos& stateInfos) const;
+#endif
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_SERIALIZATION
+	using WriteStream	= typename Args::WriteStream;
+	using ReadStream	= typename Args::ReadStream;
+
+	HFSM_INLINE void	deepSaveActive	 (const Registry& registry, WriteStream& stream) const;
+	HFSM_INLINE void	deepSaveResumable(const Registry& registry, WriteStream& stream) const;
+
+	HFSM_INLINE void	deepLoadRequested(		Registry& registry, ReadStream&  stream) const;
+	HFSM_INLINE void	deepLoadResumable(		Registry& registry, ReadStream&  stream) const;
+#endif
+
+	//----------------------------------------------------------------------
+
+	HeadState _headState;
+	SubStates _subStates;
+
+	HFSM_IF_DEBUG(static constexpr Info _info = Info{});
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+ShortIndex
+C_<TN, TA, SG, TH, TS...>::resolveRandom(Control& control,
+										 const Utility(& options)[Info::WIDTH],
+										 const Utility sum,
+										 const Rank(& ranks)[Info::WIDTH],
+										 const Rank top) const
+{
+	const Utility random = control._rng.next();
+	HFSM_ASSERT(0.0f <= random && random < 1.0f);
+
+	Utility cursor = random * sum;
+
+	for (ShortIndex i = 0; i < count(ranks); ++i)
+		if (ranks[i] == top) {
+			HFSM_ASSERT(options[i] >= 0.0f);
+
+			if (cursor >= options[i])
+				cursor -= options[i];
+			else {
+				HFSM_LOG_RANDOM_RESOLUTION(control.context(), HEAD_ID, i, random);
+
+				return i;
+			}
+		}
+
+	HFSM_BREAK();
+	return INVALID_SHORT_INDEX;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+void
+C_<TN, TA, SG, TH, TS...>::deepRegister(Registry& registry,
+										const Parent parent)
+{
+	registry.compoParents[COMPO_INDEX] = parent;
+
+	_headState.deepRegister(registry, parent);
+	_subStates.wideRegister(registry, Parent{COMPO_ID});
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+bool
+C_<TN, TA, SG, TH, TS...>::deepForwardEntryGuard(GuardControl& control) {
+	const ShortIndex active	   = compoActive   (control);
+	const ShortIndex requested = compoRequested(control);
+
+	HFSM_ASSERT(active != INVALID_SHORT_INDEX);
+
+	ScopedRegion region{control, REGION_ID, HEAD_ID, STATE_COUNT};
+
+	if (requested == INVALID_SHORT_INDEX)
+		return _subStates.wideForwardEntryGuard(control, active);
+	else
+		return _subStates.wideEntryGuard	   (control, requested);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+bool
+C_<TN, TA, SG, TH, TS...>::deepEntryGuard(GuardControl& control) {
+	const ShortIndex requested = compoRequested(control);
+	HFSM_ASSERT(requested != INVALID_SHORT_INDEX);
+
+	ScopedRegion region{control, REGION_ID, HEAD_ID, STATE_COUNT};
+
+	return _headState.deepEntryGuard(control) ||
+		   _subStates.wideEntryGuard(control, requested);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+void
+C_<TN, TA, SG, TH, TS...>::deepConstruct(PlanControl& control) {
+	ShortIndex& active	  = compoActive   (control);
+	ShortIndex& resumable = compoResumable(control);
+	ShortIndex& requested = compoRequested(control);
+
+	HFSM_ASSERT(active	  == INVALID_SHORT_INDEX);
+	HFSM_ASSERT(requested != INVALID_SHORT_INDEX);
+
+	active	  = requested;
+
+	if (requested == resumable)
+		resumable = INVALID_SHORT_INDEX;
+
+	requested = INVALID_SHORT_INDEX;
+
+	_headState.deepConstruct(control);
+	_subStates.wideConstruct(control, active);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+void
+C_<TN, TA, SG, TH, TS...>::deepEnter(PlanControl& control) {
+	const ShortIndex& active = compoActive(control);
+
+	ScopedRegion region{control, REGION_ID, HEAD_ID, STATE_COUNT};
+
+	_headState.deepEnter(control);
+	_subStates.wideEnter(control, active);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+void
+C_<TN, TA, SG, TH, TS...>::deepReenter(PlanControl& control) {
+	ShortIndex& active	  = compoActive   (control);
+	ShortIndex& resumable = compoResumable(control);
+	ShortIndex& requested = compoRequested(control);
+
+	HFSM_ASSERT(active	  != INVALID_SHORT_INDEX &&
+				requested != INVALID_SHORT_INDEX);
+
+	ScopedRegion region{control, REGION_ID, HEAD_ID, STATE_COUNT};
+
+	_headState.deepReenter(control);
+
+	if (active == requested)
+		_subStates.wideReenter(control, active);
+	else {
+		_subStates.wideExit	  (control, active);
+
+		active	  = requested;
+
+		if (requested == resumable)
+			resumable = INVALID_SHORT_INDEX;
+
+		_subStates.wideEnter  (control, active);
+	}
+
+	requested = INVALID_SHORT_INDEX;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+Status
+C_<TN, TA, SG, TH, TS...>::deepUpdate(FullControl& control) {
+	HFSM_IF_UPDATE_PERIODS(if (!control._planData.updatePeriods.isDue(REGION_ID)) return Status{});
+
+	const ShortIndex active = compoActive(control);
+	HFSM_ASSERT(active != INVALID_SHORT_INDEX);
+
+	ScopedRegion outer{control, REGION_ID, HEAD_ID, STATE_COUNT};
+
+	if (const Status headStatus = _headState.deepUpdate(control)) {
+		ControlLock lock{control};
+		_subStates.wideUpdate(control, active);
+
+		return headStatus;
+	} else {
+		const Status subStatus = _subStates.wideUpdate(control, active);
+
+		if (subStatus.outerTransition)
+			return Status{Status::NONE, true};
+
+		ScopedRegion inner{control, REGION_ID, HEAD_ID, STATE_COUNT};
+
+		return subStatus && control._planData.planExists.template get<REGION_ID>() ?
+			control.updatePlan(_headState, subStatus) : subStatus;
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+template <typename TEvent>
+Status
+C_<TN, TA, SG, TH, TS...>::deepReact(FullControl& control,
+									 const TEvent& event)
+{
+	const ShortIndex active = compoActive(control);
+	HFSM_ASSERT(active != INVALID_SHORT_INDEX);
+
+	ScopedRegion outer{control, REGION_ID, HEAD_ID, STATE_COUNT};
+
+	if (const Status headStatus = _headState.deepReact(control, event)) {
+		ControlLock lock{control};
+		_subStates.wideReact(control, event, active);
+
+		return headStatus;
+	} else {
+		const Status subStatus = _subStates.wideReact(control, event, active);
+
+		if (subStatus.outerTransition)
+			return subStatus;
+
+		ScopedRegion inner{control, REGION_ID, HEAD_ID, STATE_COUNT};
+
+		return subStatus && control._planData.planExists.template get<REGION_ID>() ?
+			control.updatePlan(_headState, subStatus) : subStatus;
+	}
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+bool
+C_<TN, TA, SG, TH, TS...>::deepForwardExitGuard(GuardControl& control) {
+	const ShortIndex active = compoActive(control);
+	HFSM_ASSERT(active != INVALID_SHORT_INDEX);
+
+	ScopedRegion region{control, REGION_ID, HEAD_ID, STATE_COUNT};
+
+	if (compoRequested(control) == INVALID_SHORT_INDEX)
+		return _subStates.wideForwardExitGuard(control, active);
+	else
+		return _subStates.wideExitGuard		  (control, active);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+bool
+C_<TN, TA, SG, TH, TS...>::deepExitGuard(GuardControl& control) {
+	const ShortIndex active = compoActive(control);
+	HFSM_ASSERT(active != INVALID_SHORT_INDEX);
+
+	ScopedRegion region{control, REGION_ID, HEAD_ID, STATE_COUNT};
+
+	return _headState.deepExitGuard(control) ||
+		   _subStates.wideExitGuard(control, active);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+void
+C_<TN, TA, SG, TH, TS...>::deepExit(PlanControl& control) {
+	ShortIndex& active	  = compoActive   (control);
+	HFSM_ASSERT(active != INVALID_SHORT_INDEX);
+
+	_subStates.wideExit(control, active);
+	_headState.deepExit(control);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+void
+C_<TN, TA, SG, TH, TS...>::deepDestruct(PlanControl& control) {
+	ShortIndex& active	  = compoActive   (control);
+	ShortIndex& resumable = compoResumable(control);
+
+	HFSM_ASSERT(active != INVALID_SHORT_INDEX);
+
+	_subStates.wideDestruct(control, active);
+	_headState.deepDestruct(control);
+
+	resumable = active;
+	active	  = INVALID_SHORT_INDEX;
+
+	auto plan = control.plan(REGION_ID);
+	plan.clear();
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+void
+C_<TN, TA, SG, TH, TS...>::deepForwardActive(Control& control,
+											 const Request::Type request)
+{
+	HFSM_ASSERT(control._registry.isActive(HEAD_ID));
+
+	const ShortIndex requested = compoRequested(control);
+
+	if (requested == INVALID_SHORT_INDEX) {
+		const ShortIndex active = compoActive(control);
+
+		_subStates.wideForwardActive (control, request, active);
+	} else
+		_subStates.wideForwardRequest(control, request, requested);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+void
+C_<TN, TA, SG, TH, TS...>::deepForwardRequest(Control& control,
+											  const Request::Type request)
+{
+	const ShortIndex requested = compoRequested(control);
+
+	if (requested == INVALID_SHORT_INDEX)
+		deepRequest					 (control, request);
+	else
+		_subStates.wideForwardRequest(control, request, requested);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+void
+C_<TN, TA, SG, TH, TS...>::deepRequest(Control& control,
+									   const Request::Type request)
+{
+	switch (request) {
+	case Request::REMAIN:
+		deepRequestRemain	(control._registry);
+		break;
+
+	case Request::CHANGE:
+		deepRequestChange	(control);
+		break;
+
+	case Request::RESTART:
+		deepRequestRestart	(control._registry);
+		break;
+
+	case Request::RESUME:
+		deepRequestResume	(control._registry);
+		break;
+
+	case Request::UTILIZE:
+		deepRequestUtilize	(control);
+		break;
+
+	case Request::RANDOMIZE:
+		deepRequestRandomize(control);
+		break;
+
+	default:
+		HFSM_BREAK();
+	}
+}
+
+//------------------------------------------------------------------------------
+
+#ifndef HFSM_EXPLICIT_MEMBER_SPECIALIZATION
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+void
+C_<TN, TA, SG, TH, TS...>::deepRequestChange(Control& control)
+{
+	switch (STRATEGY) {
+	case Strategy::Composite:
+		deepRequestChangeComposite  (control);
+		break;
+
+	case Strategy::Resumable:
+		deepRequestChangeResumable  (control);
+		break;
+
+	case Strategy::Utilitarian:
+		deepRequestChangeUtilitarian(control);
+		break;
+
+	case Strategy::RandomUtil:
+		deepRequestChangeRandom		(control);
+		break;
+
+	default:
+		HFSM_BREAK();
+	}
+}
+
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+void
+C_<TN, TA, SG, TH, TS...>::deepRequestChangeComposite(Control& control) {
+	ShortIndex& requested = compoRequested(control);
+
+	requested = 0;
+
+	_subStates.wideRequestChangeComposite(control);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+void
+C_<TN, TA, SG, TH, TS...>::deepRequestChangeResumable(Control& control) {
+	const ShortIndex  resumable = compoResumable(control);
+		  ShortIndex& requested = compoRequested(control);
+
+	requested = (resumable != INVALID_SHORT_INDEX) ?
+		resumable : 0;
+
+	_subStates.wideRequestChangeResumable(control, requested);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+void
+C_<TN, TA, SG, TH, TS...>::deepRequestChangeUtilitarian(Control& control) {
+	const UP s = _subStates.wideReportChangeUtilitarian(control);
+	HFSM_ASSERT(s.prong != INVALID_SHORT_INDEX);
+
+	ShortIndex& requested = compoRequested(control);
+	requested = s.prong;
+
+	HFSM_LOG_UTILITY_RESOLUTION(control.context(), HEAD_ID, requested, s.utility);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+void
+C_<TN, TA, SG, TH, TS...>::deepRequestChangeRandom(Control& control) {
+	Rank ranks[Info::WIDTH];
+	Rank top = _subStates.wideReportRank(control, ranks);
+
+	Utility options[Info::WIDTH];
+	const UP sum = _subStates.wideReportChangeRandom(control, options, ranks, top);
+
+	ShortIndex& requested = compoRequested(control);
+	requested = resolveRandom(control, options, sum.utility, ranks, top);
+	HFSM_ASSERT(requested < Info::WIDTH);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+void
+C_<TN, TA, SG, TH, TS...>::deepRequestRemain(Registry& registry) {
+	const ShortIndex  active	= compoActive   (registry);
+		  ShortIndex& requested = compoRequested(registry);
+
+	if (active == INVALID_SHORT_INDEX)
+		requested = 0;
+
+	_subStates.wideRequestRemain(registry);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+void
+C_<TN, TA, SG, TH, TS...>::deepRequestRestart(Registry& registry) {
+	ShortIndex& requested = compoRequested(registry);
+
+	requested = 0;
+
+	_subStates.wideRequestRestart(registry);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+void
+C_<TN, TA, SG, TH, TS...>::deepRequestResume(Registry& registry) {
+	const ShortIndex  resumable = compoResumable(registry);
+		  ShortIndex& requested = compoRequested(registry);
+
+	requested = (resumable != INVALID_SHORT_INDEX) ?
+		resumable : 0;
+
+	_subStates.wideRequestResume(registry, requested);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+void
+C_<TN, TA, SG, TH, TS...>::deepRequestUtilize(Control& control) {
+	const UP s = _subStates.wideReportUtilize(control);
+
+	ShortIndex& requested = compoRequested(control);
+	requested = s.prong;
+
+	HFSM_LOG_UTILITY_RESOLUTION(control.context(), HEAD_ID, requested, s.utility);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+void
+C_<TN, TA, SG, TH, TS...>::deepRequestRandomize(Control& control) {
+	Rank ranks[Info::WIDTH];
+	Rank top = _subStates.wideReportRank(control, ranks);
+
+	Utility options[Info::WIDTH];
+	const Utility sum = _subStates.wideReportRandomize(control, options, ranks, top);
+
+	ShortIndex& requested = compoRequested(control);
+	requested = resolveRandom(control, options, sum, ranks, top);
+	HFSM_ASSERT(requested < Info::WIDTH);
+}
+
+//------------------------------------------------------------------------------
+
+#ifndef HFSM_EXPLICIT_MEMBER_SPECIALIZATION
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+typename TA::UP
+C_<TN, TA, SG, TH, TS...>::deepReportChange(Control& control) {
+	switch (STRATEGY) {
+	case Strategy::Composite:
+		return deepReportChangeComposite  (control);
+
+	case Strategy::Resumable:
+		return deepReportChangeResumable  (control);
+
+	case Strategy::Utilitarian:
+		return deepReportChangeUtilitarian(control);
+
+	case Strategy::RandomUtil:
+		return deepReportChangeRandom	  (control);
+
+	default:
+		HFSM_BREAK();
+		return {};
+	}
+}
+
+#endif
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+typename TA::UP
+C_<TN, TA, SG, TH, TS...>::deepReportChangeComposite(Control& control) {
+	ShortIndex& requested = compoRequested(control);
+	requested = 0;
+
+	const UP h = _headState.deepReportChange(control);
+	const UP s = _subStates.wideReportChangeComposite(control);
+
+	return {
+		h.utility * s.utility,
+		h.prong
+	};
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+typename TA::UP
+C_<TN, TA, SG, TH, TS...>::deepReportChangeResumable(Control& control) {
+	const ShortIndex  resumable = compoResumable(control);
+		  ShortIndex& requested = compoRequested(control);
+
+	requested = (resumable != INVALID_SHORT_INDEX) ?
+		resumable : 0;
+
+	const UP h = _headState.deepReportChange(control);
+	const UP s = _subStates.wideReportChangeResumable(control, requested);
+
+	return {
+		h.utility * s.utility,
+		h.prong
+	};
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+typename TA::UP
+C_<TN, TA, SG, TH, TS...>::deepReportChangeUtilitarian(Control& control) {
+	const UP h = _headState.deepReportChange(control);
+	const UP s = _subStates.wideReportChangeUtilitarian(control);
+
+	ShortIndex& requested = compoRequested(control);
+	requested = s.prong;
+
+	HFSM_LOG_UTILITY_RESOLUTION(control.context(), HEAD_ID, requested, s.utility);
+
+	return {
+		h.utility * s.utility,
+		h.prong
+	};
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+typename TA::UP
+C_<TN, TA, SG, TH, TS...>::deepReportChangeRandom(Control& control) {
+	const UP h = _headState.deepReportChange(control);
+
+	Rank ranks[Info::WIDTH];
+	Rank top = _subStates.wideReportRank(control, ranks);
+
+	Utility options[Info::WIDTH];
+	const UP sum = _subStates.wideReportChangeRandom(control, options, ranks, top);
+
+	ShortIndex& requested = compoRequested(control);
+	requested = resolveRandom(control, options, sum.utility, ranks, top);
+	HFSM_ASSERT(requested < Info::WIDTH);
+
+	return {
+		h.utility * options[requested],
+		h.prong
+	};
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+typename TA::UP
+C_<TN, TA, SG, TH, TS...>::deepReportUtilize(Control& control) {
+	const UP h = _headState.deepReportUtilize(control);
+	const UP s = _subStates.wideReportUtilize(control);
+
+	ShortIndex& requested = compoRequested(control);
+	requested = s.prong;
+
+	HFSM_LOG_UTILITY_RESOLUTION(control.context(), HEAD_ID, requested, s.utility);
+
+	return {
+		h.utility * s.utility,
+		h.prong
+	};
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+typename TA::Rank
+C_<TN, TA, SG, TH, TS...>::deepReportRank(Control& control) {
+	return _headState.wrapRank(control);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+typename TA::Utility
+C_<TN, TA, SG, TH, TS...>::deepReportRandomize(Control& control) {
+	const Utility h = _headState.wrapUtility(control);
+
+	Rank ranks[Info::WIDTH];
+	Rank top = _subStates.wideReportRank(control, ranks);
+
+	Utility options[Info::WIDTH];
+	const Utility sum = _subStates.wideReportRandomize(control, options, ranks, top);
+
+	ShortIndex& requested = compoRequested(control);
+	requested = resolveRandom(control, options, sum, ranks, top);
+	HFSM_ASSERT(requested < Info::WIDTH);
+
+	return h * options[requested];
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+void
+C_<TN, TA, SG, TH, TS...>::deepChangeToRequested(PlanControl& control) {
+	ShortIndex& active	  = compoActive	  (control);
+	ShortIndex& resumable = compoResumable(control);
+	ShortIndex& requested = compoRequested(control);
+
+	HFSM_ASSERT(active != INVALID_SHORT_INDEX);
+
+	if (requested == INVALID_SHORT_INDEX)
+		_subStates.wideChangeToRequested(control, active);
+	else if (requested != active) {
+		_subStates.wideExit		(control, active);
+		_subStates.wideDestruct	(control, active);
+
+		resumable = active;
+		active	  = requested;
+		requested = INVALID_SHORT_INDEX;
+
+		_subStates.wideConstruct(control, active);
+		_subStates.wideEnter	(control, active);
+	} else if (compoRemain(control)) {
+		_subStates.wideExit		(control, active);
+		_subStates.wideDestruct	(control, active);
+
+		requested = INVALID_SHORT_INDEX;
+
+		_subStates.wideConstruct(control, active);
+		_subStates.wideEnter	(control, active);
+	} else {
+		requested = INVALID_SHORT_INDEX;
+
+		// no reconstruction on reenter() by design
+
+		_subStates.wideReenter	(control, active);
+	}
+}
+
+//------------------------------------------------------------------------------
+
+#ifdef HFSM_ENABLE_STRUCTURE_REPORT
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+void
+C_<TN, TA, SG, TH, TS...>::deepGetNames(const LongIndex parent,
+										const RegionType region,
+										const ShortIndex depth,
+										StructureStateInfos& _stateInfos) const
+{
+	_headState.deepGetNames(parent,					 region,						depth,	   _stateInfos);
+	_subStates.wideGetNames(_stateInfos.count() - 1, StructureStateInfo::COMPOSITE, depth + 1, _stateInfos);
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+
+#ifdef HFSM_ENABLE_SERIALIZATION
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+void
+C_<TN, TA, SG, TH, TS...>::deepSaveActive(const Registry& registry,
+										  WriteStream& stream) const
+{
+	const ShortIndex active	   = compoActive   (registry);
+	const ShortIndex resumable = compoResumable(registry);
+
+	stream.template write<WIDTH_BITS>(active);
+
+	if (resumable != INVALID_SHORT_INDEX) {
+		stream.template write<1>(1);
+		stream.template write<WIDTH_BITS>(resumable);
+	} else
+		stream.template write<1>(0);
+
+	_subStates.wideSaveActive(registry,stream, active);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+void
+C_<TN, TA, SG, TH, TS...>::deepSaveResumable(const Registry& registry,
+											 WriteStream& stream) const
+{
+	const ShortIndex resumable = compoResumable(registry);
+
+	if (resumable != INVALID_SHORT_INDEX) {
+		stream.template write<1>(1);
+		stream.template write<WIDTH_BITS>(resumable);
+	} else
+		stream.template write<1>(0);
+
+	_subStates.wideSaveResumable(registry, stream);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+void
+C_<TN, TA, SG, TH, TS...>::deepLoadRequested(Registry& registry,
+											 ReadStream& stream) const
+{
+	ShortIndex& resumable = compoResumable(registry);
+	ShortIndex& requested = compoRequested(registry);
+
+	requested = stream.template read<WIDTH_BITS>();
+	HFSM_ASSERT(requested < WIDTH);
+
+	if (stream.template read<1>()) {
+		resumable = stream.template read<WIDTH_BITS>();
+		HFSM_ASSERT(resumable < WIDTH);
+	} else
+		resumable = INVALID_SHORT_INDEX;
+
+	_subStates.wideLoadRequested(registry, stream, requested);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+void
+C_<TN, TA, SG, TH, TS...>::deepLoadResumable(Registry& registry,
+											 ReadStream& stream) const
+{
+	ShortIndex& resumable = compoResumable(registry);
+
+	if (stream.template read<1>()) {
+		resumable = stream.template read<WIDTH_BITS>();
+		HFSM_ASSERT(resumable < WIDTH);
+	} else
+		resumable = INVALID_SHORT_INDEX;
+
+	_subStates.wideLoadResumable(registry, stream);
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename, typename, ShortIndex, typename...>
+struct OS_;
+
+//------------------------------------------------------------------------------
+
+template <typename TIndices,
+		  typename TArgs,
+		  ShortIndex NIndex,
+		  typename TInitial,
+		  typename... TRemaining>
+struct OS_<TIndices, TArgs, NIndex, TInitial, TRemaining...> final {
+	using Indices		= TIndices;
+	static constexpr StateID	INITIAL_ID	= Indices::STATE_ID;
+	static constexpr ShortIndex COMPO_INDEX	= Indices::COMPO_INDEX;
+	static constexpr ShortIndex ORTHO_INDEX	= Indices::ORTHO_INDEX;
+	static constexpr ShortIndex ORTHO_UNIT	= Indices::ORTHO_UNIT;
+
+	static constexpr ShortIndex PRONG_INDEX	= NIndex;
+
+	using Args			= TArgs;
+	using Rank			= typename Args::Rank;
+	using Utility		= typename Args::Utility;
+	using UP			= typename Args::UP;
+
+	using Registry		= RegistryT<Args>;
+	using StateParents	= typename Registry::StateParents;
+	using OrthoForks	= typename Registry::OrthoForks;
+	using ProngBits		= typename OrthoForks::Bits;
+	using ProngConstBits= typename OrthoForks::ConstBits;
+
+	using Control		= ControlT	   <Args>;
+	using PlanControl	= PlanControlT <Args>;
+	using FullControl	= FullControlT <Args>;
+	using GuardControl	= GuardControlT<Args>;
+
+	using Initial		= Material<I_<INITIAL_ID,
+									  COMPO_INDEX,
+									  ORTHO_INDEX,
+									  ORTHO_UNIT>,
+								   Args,
+								   TInitial>;
+
+	using InitialInfo	= WrapInfo<TInitial>;
+	using InitialStates	= typename InitialInfo::StateList;
+
+	using Remaining		= OS_<I_<INITIAL_ID  + InitialInfo::STATE_COUNT,
+								 COMPO_INDEX + InitialInfo::COMPO_REGIONS,
+								 ORTHO_INDEX + InitialInfo::ORTHO_REGIONS,
+								 ORTHO_UNIT  + InitialInfo::ORTHO_UNITS>,
+							  Args,
+							  PRONG_INDEX + 1,
+							  TRemaining...>;
+
+	using Info	= OSI_<TInitial, TRemaining...>;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_EXPLICIT_MEMBER_SPECIALIZATION
+	template <typename T>
+	HFSM_INLINE		  T& access();
+
+	template <typename T>
+	HFSM_INLINE const T& access() const;
+#endif
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE void	wideRegister		 (Registry& registry, const ForkID forkId);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE bool	wideForwardEntryGuard(GuardControl&	control,							const ProngConstBits prongs);
+	HFSM_INLINE bool	wideForwardEntryGuard(GuardControl&	control);
+	HFSM_INLINE bool	wideEntryGuard		 (GuardControl&	control);
+
+	HFSM_INLINE void	wideConstruct		 (PlanControl&	control);
+
+	HFSM_INLINE void	wideEnter			 (PlanControl&	control);
+	HFSM_INLINE void	wideReenter			 (PlanControl&	control);
+
+	HFSM_INLINE Status	wideUpdate			 (FullControl&	control);
+
+	template <typename TEvent>
+	HFSM_INLINE Status	wideReact			 (FullControl&	control, const TEvent& event);
+
+#ifdef HFSM_ENABLE_PARALLEL
+	HFSM_INLINE Status	wideUpdate			 (FullControl&	control,							const ShortIndex prong);
+
+	template <typename TEvent>
+	HFSM_INLINE Status	wideReact			 (FullControl&	control, const TEvent& event,		const ShortIndex prong);
+#endif
+
+	HFSM_INLINE bool	wideForwardExitGuard (GuardControl&	control,							const ProngConstBits prongs);
+	HFSM_INLINE bool	wideForwardExitGuard (GuardControl&	control);
+	HFSM_INLINE bool	wideExitGuard		 (GuardControl&	control);
+
+	HFSM_INLINE void	wideExit			 (PlanControl&	control);
+
+	HFSM_INLINE void	wideDestruct		 (PlanControl&  control);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE void	wideForwardActive	 (Control& control, const Request::Type request,	const ProngConstBits prongs);
+	HFSM_INLINE void	wideForwardRequest	 (Control& control, const Request::Type request,	const ProngConstBits prongs);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE void	wideRequestChange	 (Control& control);
+	HFSM_INLINE void	wideRequestRemain	 (Registry& registry);
+	HFSM_INLINE void	wideRequestRestart	 (Registry& registry);
+	HFSM_INLINE void	wideRequestResume	 (Registry& registry);
+	HFSM_INLINE void	wideRequestUtilize	 (Control& control);
+	HFSM_INLINE void	wideRequestRandomize (Control& control);
+
+	HFSM_INLINE Utility	wideReportChange	 (Control& control);
+	HFSM_INLINE Utility	wideReportUtilize	 (Control& control);
+	HFSM_INLINE Utility	wideReportRandomize	 (Control& control);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE void	wideChangeToRequested(PlanControl& control);
+
+	//----------------------------------------------------------------------
+
+#ifdef HFSM_ENABLE_STRUCTURE_REPORT
+	using StructureStateInfos = typename Args::StructureStateInfos;
+
+	static constexpr LongIndex NAME_COUNT	 = Initial::NAME_COUNT  + Remaining::NAME_COUNT;
+
+	void wideGetNames(const LongIndex parent,
+					  const ShortIndex depth,
+					  StructureStateInfos& stateInfos) const;
+#endif
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_SERIALIZATION
+	using WriteStream	= typename Args::WriteStream;
+	using ReadStream	= typename Args::ReadStream;
+
+	HFSM_INLINE void	wideSaveActive	 (const Registry& registry, WriteStream& stream) const;
+	HFSM_INLINE void	wideSaveResumable(const Registry& registry, WriteStream& stream) const;
+
+	HFSM_INLINE void	wideLoadRequested(		Registry& registry, ReadStream&  stream) const;
+	HFSM_INLINE void	wideLoadResumable(		Registry& registry, ReadStream&  stream) const;
+#endif
+
+	//----------------------------------------------------------------------
+
+	Initial initial;
+	Remaining remaining;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TIndices,
+		  typename TArgs,
+		  ShortIndex NIndex,
+		  typename TInitial>
+struct OS_<TIndices, TArgs, NIndex, TInitial> final {
+	using Indices		= TIndices;
+	static constexpr StateID	INITIAL_ID	= Indices::STATE_ID;
+	static constexpr ShortIndex COMPO_INDEX	= Indices::COMPO_INDEX;
+	static constexpr ShortIndex ORTHO_INDEX	= Indices::ORTHO_INDEX;
+	static constexpr ShortIndex ORTHO_UNIT	= Indices::ORTHO_UNIT;
+
+	static constexpr ShortIndex PRONG_INDEX	= NIndex;
+
+	using Args			= TArgs;
+	using Rank			= typename Args::Rank;
+	using Utility		= typename Args::Utility;
+	using UP			= typename Args::UP;
+
+	using Registry		= RegistryT<Args>;
+	using StateParents	= typename Registry::StateParents;
+	using OrthoForks	= typename Registry::OrthoForks;
+	using ProngBits		= typename OrthoForks::Bits;
+	using ProngConstBits= typename OrthoForks::ConstBits;
+
+	using Control		= ControlT	   <Args>;
+	using PlanControl	= PlanControlT <Args>;
+	using FullControl	= FullControlT <Args>;
+	using GuardControl	= GuardControlT<Args>;
+
+	using Initial		= Material<I_<INITIAL_ID,
+									  COMPO_INDEX,
+									  ORTHO_INDEX,
+									  ORTHO_UNIT>,
+								   Args,
+								   TInitial>;
+
+	using Info	= OSI_<TInitial>;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_EXPLICIT_MEMBER_SPECIALIZATION
+	template <typename T>
+	HFSM_INLINE		  T& access()			 { return initial.template access<T>();	}
+
+	template <typename T>
+	HFSM_INLINE const T& access() const		 { return initial.template access<T>();	}
+#endif
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE void	wideRegister		 (Registry& registry, const ForkID forkId);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE bool	wideForwardEntryGuard(GuardControl&	control,							const ProngConstBits prongs);
+	HFSM_INLINE bool	wideForwardEntryGuard(GuardControl&	control);
+	HFSM_INLINE bool	wideEntryGuard		 (GuardControl&	control);
+
+	HFSM_INLINE void	wideConstruct		 (PlanControl&	control);
+
+	HFSM_INLINE void	wideEnter			 (PlanControl&	control);
+	HFSM_INLINE void	wideReenter			 (PlanControl&	control);
+
+	HFSM_INLINE Status	wideUpdate			 (FullControl&	control);
+
+	template <typename TEvent>
+	HFSM_INLINE Status	wideReact			 (FullControl&	control, const TEvent& event);
+
+#ifdef HFSM_ENABLE_PARALLEL
+	HFSM_INLINE Status	wideUpdate			 (FullControl&	control,							const ShortIndex prong);
+
+	template <typename TEvent>
+	HFSM_INLINE Status	wideReact			 (FullControl&	control, const TEvent& event,		const ShortIndex prong);
+#endif
+
+	HFSM_INLINE bool	wideForwardExitGuard (GuardControl&	control,							const ProngConstBits prongs);
+	HFSM_INLINE bool	wideForwardExitGuard (GuardControl&	control);
+	HFSM_INLINE bool	wideExitGuard		 (GuardControl&	control);
+
+	HFSM_INLINE void	wideExit			 (PlanControl&	control);
+
+	HFSM_INLINE void	wideDestruct		 (PlanControl&  control);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE void	wideForwardActive	 (Control& control, const Request::Type request,	const ProngConstBits prongs);
+	HFSM_INLINE void	wideForwardRequest	 (Control& control, const Request::Type request,	const ProngConstBits prongs);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE void	wideRequestChange	 (Control& control);
+	HFSM_INLINE void	wideRequestRemain	 (Registry& registry);
+	HFSM_INLINE void	wideRequestRestart	 (Registry& registry);
+	HFSM_INLINE void	wideRequestResume	 (Registry& registry);
+	HFSM_INLINE void	wideRequestUtilize	 (Control& control);
+	HFSM_INLINE void	wideRequestRandomize (Control& control);
+
+	HFSM_INLINE Utility	wideReportChange	 (Control& control);
+	HFSM_INLINE Utility	wideReportUtilize	 (Control& control);
+	HFSM_INLINE Utility	wideReportRandomize	 (Control& control);
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	HFSM_INLINE void	wideChangeToRequested(PlanControl& control);
+
+	//----------------------------------------------------------------------
+
+#ifdef HFSM_ENABLE_STRUCTURE_REPORT
+	using StructureStateInfos = typename Args::StructureStateInfos;
+
+	static constexpr LongIndex NAME_COUNT	 = Initial::NAME_COUNT;
+
+	void wideGetNames(const LongIndex parent,
+					  const ShortIndex depth,
+					  StructureStateInfos& stateInfos) const;
+#endif
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+#ifdef HFSM_ENABLE_SERIALIZATION
+	using WriteStream	= typename Args::WriteStream;
+	using ReadStream	= typename Args::ReadStream;
+
+	HFSM_INLINE void	wideSaveActive	 (const Registry& registry, WriteStream& stream) const;
+	HFSM_INLINE void	wideSaveResumable(const Registry& registry, WriteStream& stream) const;
+
+	HFSM_INLINE void	wideLoadRequested(		Registry& registry, ReadStream&  stream) const;
+	HFSM_INLINE void	wideLoadResumable(		Registry& registry, ReadStream&  stream) const;
+#endif
+
+	//----------------------------------------------------------------------
+
+	Initial initial;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+#ifdef HFSM_EXPLICIT_MEMBER_SPECIALIZATION
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+template <typename T>
+T&
+OS_<TN, TA, NI, TI, TR...>::access() {
+	return InitialStates::template contains<T>() ?
+		initial  .template access<T>() :
+		remaining.template access<T>();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+template <typename T>
+const T&
+OS_<TN, TA, NI, TI, TR...>::access() const {
+	return InitialStates::template contains<T>() ?
+		initial  .template access<T>() :
+		remaining.template access<T>();
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+void
+OS_<TN, TA, NI, TI, TR...>::wideRegister(Registry& registry,
+										 const ForkID forkId)
+{
+	initial  .deepRegister(registry, Parent{forkId, PRONG_INDEX});
+	remaining.wideRegister(registry, forkId);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+bool
+OS_<TN, TA, NI, TI, TR...>::wideForwardEntryGuard(GuardControl& control,
+												  const ProngConstBits prongs)
+{
+	const bool i = prongs.get(PRONG_INDEX) ?
+				   initial  .deepForwardEntryGuard(control) : false;
+
+	const bool r = remaining.wideForwardEntryGuard(control, prongs);
+
+	return i || r;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+bool
+OS_<TN, TA, NI, TI, TR...>::wideForwardEntryGuard(GuardControl& control) {
+	const bool i = initial  .deepForwardEntryGuard(control);
+	const bool r = remaining.wideForwardEntryGuard(control);
+
+	return i || r;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+bool
+OS_<TN, TA, NI, TI, TR...>::wideEntryGuard(GuardControl& control) {
+	const bool i = initial  .deepEntryGuard(control);
+	const bool r = remaining.wideEntryGuard(control);
+
+	return i || r;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+void
+OS_<TN, TA, NI, TI, TR...>::wideConstruct(PlanControl& control) {
+	initial	 .deepConstruct(control);
+	remaining.wideConstruct(control);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+void
+OS_<TN, TA, NI, TI, TR...>::wideEnter(PlanControl& control) {
+	initial  .deepEnter(control);
+	remaining.wideEnter(control);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+void
+OS_<TN, TA, NI, TI, TR...>::wideReenter(PlanControl& control) {
+	initial  .deepReenter(control);
+	remaining.wideReenter(control);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+Status
+OS_<TN, TA, NI, TI, TR...>::wideUpdate(FullControl& control) {
+	const auto status =	   initial	.deepUpdate(control);
+	return combine(status, remaining.wideUpdate(control));
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+template <typename TEvent>
+Status
+OS_<TN, TA, NI, TI, TR...>::wideReact(FullControl& control,
+									  const TEvent& event)
+{
+	const auto status =	   initial	.deepReact(control, event);
+	return combine(status, remaining.wideReact(control, event));
+}
+
+//------------------------------------------------------------------------------
+
+#ifdef HFSM_ENABLE_PARALLEL
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+Status
+OS_<TN, TA, NI, TI, TR...>::wideUpdate(FullControl& control,
+									   const ShortIndex prong)
+{
+	return prong == PRONG_INDEX ?
+		initial	 .deepUpdate(control) :
+		remaining.wideUpdate(control, prong);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+template <typename TEvent>
+Status
+OS_<TN, TA, NI, TI, TR...>::wideReact(FullControl& control,
+									  const TEvent& event,
+									  const ShortIndex prong)
+{
+	return prong == PRONG_INDEX ?
+		initial	 .deepReact(control, event) :
+		remaining.wideReact(control, event, prong);
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+bool
+OS_<TN, TA, NI, TI, TR...>::wideForwardExitGuard(GuardControl& control,
+												 const ProngConstBits prongs)
+{
+	const bool i = prongs.get(PRONG_INDEX) ?
+				   initial  .deepForwardExitGuard(control) : false;
+
+	const bool r = remaining.wideForwardExitGuard(control, prongs);
+
+	return i || r;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+bool
+OS_<TN, TA, NI, TI, TR...>::wideForwardExitGuard(GuardControl& control) {
+	const bool i = initial  .deepForwardExitGuard(control);
+	const bool r = remaining.wideForwardExitGuard(control);
+
+	return i || r;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+bool
+OS_<TN, TA, NI, TI, TR...>::wideExitGuard(GuardControl& control) {
+	const bool i = initial  .deepExitGuard(control);
+	const bool r = remaining.wideExitGuard(control);
+
+	return i || r;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+void
+OS_<TN, TA, NI, TI, TR...>::wideExit(PlanControl& control) {
+	initial	 .deepExit(control);
+	remaining.wideExit(control);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+void
+OS_<TN, TA, NI, TI, TR...>::wideDestruct(PlanControl& control) {
+	initial	 .deepDestruct(control);
+	remaining.wideDestruct(control);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+void
+OS_<TN, TA, NI, TI, TR...>::wideForwardActive(Control& control,
+											  const Request::Type request,
+											  const ProngConstBits prongs)
+{
+	const Request::Type local = prongs.get(PRONG_INDEX) ?
+		request : Request::REMAIN;
+
+	initial	 .deepForwardActive(control, local);
+	remaining.wideForwardActive(control, request, prongs);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+void
+OS_<TN, TA, NI, TI, TR...>::wideForwardRequest(Control& control,
+											   const Request::Type request,
+											   const ProngConstBits prongs)
+{
+	const Request::Type local = prongs.get(PRONG_INDEX) ?
+		request : Request::REMAIN;
+
+	initial	 .deepForwardRequest(control, local);
+	remaining.wideForwardRequest(control, request, prongs);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+void
+OS_<TN, TA, NI, TI, TR...>::wideRequestChange(Control& control) {
+	initial  .deepRequestChange(control);
+	remaining.wideRequestChange(control);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+void
+OS_<TN, TA, NI, TI, TR...>::wideRequestRemain(Registry& registry) {
+	initial	 .deepRequestRemain(registry);
+	remaining.wideRequestRemain(registry);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+void
+OS_<TN, TA, NI, TI, TR...>::wideRequestRestart(Registry& registry) {
+	initial	 .deepRequestRestart(registry);
+	remaining.wideRequestRestart(registry);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+void
+OS_<TN, TA, NI, TI, TR...>::wideRequestResume(Registry& registry) {
+	initial	 .deepRequestResume(registry);
+	remaining.wideRequestResume(registry);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+void
+OS_<TN, TA, NI, TI, TR...>::wideRequestUtilize(Control& control) {
+	initial  .deepRequestUtilize(control);
+	remaining.wideRequestUtilize(control);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+void
+OS_<TN, TA, NI, TI, TR...>::wideRequestRandomize(Control& control) {
+	initial  .deepRequestRandomize(control);
+	remaining.wideRequestRandomize(control);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+typename TA::Utility
+OS_<TN, TA, NI, TI, TR...>::wideReportChange(Control& control) {
+	const UP	  i = initial  .deepReportChange(control);
+	const Utility r = remaining.wideReportChange(control);
+
+	return i.utility + r;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+typename TA::Utility
+OS_<TN, TA, NI, TI, TR...>::wideReportUtilize(Control& control) {
+	const UP	  i = initial  .deepReportUtilize(control);
+	const Utility r = remaining.wideReportUtilize(control);
+
+	return i.utility + r;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+typename TA::Utility
+OS_<TN, TA, NI, TI, TR...>::wideReportRandomize(Control& control) {
+	const Utility i = initial  .deepReportRandomize(control);
+	const Utility r = remaining.wideReportRandomize(control);
+
+	return i + r;
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+void
+OS_<TN, TA, NI, TI, TR...>::wideChangeToRequested(PlanControl& control) {
+	initial	 .deepChangeToRequested(control);
+	remaining.wideChangeToRequested(control);
+}
+
+//------------------------------------------------------------------------------
+
+#ifdef HFSM_ENABLE_STRUCTURE_REPORT
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+void
+OS_<TN, TA, NI, TI, TR...>::wideGetNames(const LongIndex parent,
+										 const ShortIndex depth,
+										 StructureStateInfos& stateInfos) const
+{
+	initial	 .deepGetNames(parent, StructureStateInfo::ORTHOGONAL, depth, stateInfos);
+	remaining.wideGetNames(parent,								   depth, stateInfos);
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+
+#ifdef HFSM_ENABLE_SERIALIZATION
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+void
+OS_<TN, TA, NI, TI, TR...>::wideSaveActive(const Registry& registry,
+										   WriteStream& stream) const
+{
+	initial	 .deepSaveActive(registry, stream);
+	remaining.wideSaveActive(registry, stream);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+void
+OS_<TN, TA, NI, TI, TR...>::wideSaveResumable(const Registry& registry,
+											  WriteStream& stream) const
+{
+	initial	 .deepSaveResumable(registry, stream);
+	remaining.wideSaveResumable(registry, stream);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+void
+OS_<TN, TA, NI, TI, TR...>::wideLoadRequested(Registry& registry,
+											  ReadStream& stream) const
+{
+	initial	 .deepLoadRequested(registry, stream);
+	remaining.wideLoadRequested(registry, stream);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+void
+OS_<TN, TA, NI, TI, TR...>::wideLoadResumable(Registry& registry,
+											  ReadStream& stream) const
+{
+	initial	 .deepLoadResumable(registry, stream);
+	remaining.wideLoadResumable(registry, stream);
+}
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+void
+OS_<TN, TA, NI, TI>::wideRegister(Registry& registry,
+									  const ForkID forkId)
+{
+	initial.deepRegister(registry, Parent{forkId, PRONG_INDEX});
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+bool
+OS_<TN, TA, NI, TI>::wideForwardEntryGuard(GuardControl& control,
+										   const ProngConstBits prongs)
+{
+	return prongs.get(PRONG_INDEX) ?
+		initial.deepForwardEntryGuard(control) : false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+bool
+OS_<TN, TA, NI, TI>::wideForwardEntryGuard(GuardControl& control) {
+	return initial.deepForwardEntryGuard(control);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+bool
+OS_<TN, TA, NI, TI>::wideEntryGuard(GuardControl& control) {
+	return initial.deepEntryGuard(control);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+void
+OS_<TN, TA, NI, TI>::wideConstruct(PlanControl& control) {
+	initial.deepConstruct(control);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+void
+OS_<TN, TA, NI, TI>::wideEnter(PlanControl& control) {
+	initial.deepEnter(control);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+void
+OS_<TN, TA, NI, TI>::wideReenter(PlanControl& control) {
+	initial.deepReenter(control);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+Status
+OS_<TN, TA, NI, TI>::wideUpdate(FullControl& control) {
+	return initial.deepUpdate(control);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+template <typename TEvent>
+Status
+OS_<TN, TA, NI, TI>::wideReact(FullControl& control,
+							   const TEvent& event)
+{
+	return initial.deepReact(control, event);
+}
+
+//------------------------------------------------------------------------------
+
+#ifdef HFSM_ENABLE_PARALLEL
+
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+Status
+OS_<TN, TA, NI, TI>::wideUpdate(FullControl& control,
+								const ShortIndex HFSM_IF_ASSERT(prong))
+{
+	HFSM_ASSERT(prong == PRONG_INDEX);
+
+	return initial.deepUpdate(control);
+}
 
-	using StateList	 = TStateList;
-	using RegionList = TRegionList;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	static constexpr LongIndex  STATE_COUNT	  = StateList::SIZE;
-	static constexpr ShortIndex COMPO_REGIONS = NCompoCount;
-	static constexpr ShortIndex ORTHO_REGIONS = NOrthoCount;
-	static constexpr ShortIndex ORTHO_UNITS	  = NOrthoUnits;
-	static constexpr ShortIndex SERIAL_BITS	  = NSerialBits;
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+template <typename TEvent>
+Status
+OS_<TN, TA, NI, TI>::wideReact(FullControl& control,
+							   const TEvent& event,
+							   const ShortIndex HFSM_IF_ASSERT(prong))
+{
+	HFSM_ASSERT(prong == PRONG_INDEX);
 
-	static constexpr LongIndex  TASK_CAPACITY = NTaskCapacity;
+	return initial.deepReact(control, event);
+}
 
-#ifdef HFSM_ENABLE_SERIALIZATION
-	using SerialBuffer			= StreamBuffer	<SERIAL_BITS>;
-	using WriteStream			= BitWriteStream<SERIAL_BITS>;
-	using ReadStream			= BitReadStream	<SERIAL_BITS>;
 #endif
 
-	HFSM_IF_STRUCTURE(using StructureStateInfos = Array<StructureStateInfo, STATE_COUNT>);
-};
-
 //------------------------------------------------------------------------------
 
-template <StateID NStateID,
-		  ShortIndex NCompoIndex,
-		  ShortIndex NOrthoIndex,
-		  ShortIndex NOrthoUnit>
-struct I_ {
-	static constexpr StateID	STATE_ID	 = NStateID;
-	static constexpr ShortIndex COMPO_INDEX	 = NCompoIndex;
-	static constexpr ShortIndex ORTHO_INDEX	 = NOrthoIndex;
-	static constexpr ShortIndex ORTHO_UNIT	 = NOrthoUnit;
-};
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+bool
+OS_<TN, TA, NI, TI>::wideForwardExitGuard(GuardControl& control,
+										  const ProngConstBits prongs)
+{
+	return prongs.get(PRONG_INDEX) ?
+		initial.deepForwardExitGuard(control) : false;
+}
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename, typename, typename>
-struct S_;
-
-template <typename, typename, Strategy, typename, typename...>
-struct C_;
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+bool
+OS_<TN, TA, NI, TI>::wideForwardExitGuard(GuardControl& control) {
+	return initial.deepForwardExitGuard(control);
+}
 
-template <typename, typename, Strategy, ShortIndex, typename...>
-struct CS_;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename, typename, typename, typename...>
-struct O_;
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+bool
+OS_<TN, TA, NI, TI>::wideExitGuard(GuardControl& control) {
+	return initial.deepExitGuard(control);
+}
 
-template <typename, typename, ShortIndex, typename...>
-struct OS_;
+//------------------------------------------------------------------------------
 
-template <typename, typename>
-class RW_;
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+void
+OS_<TN, TA, NI, TI>::wideExit(PlanControl& control) {
+	initial.deepExit(control);
+}
 
 //------------------------------------------------------------------------------
 
-template <typename, typename...>
-struct MaterialT;
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+void
+OS_<TN, TA, NI, TI>::wideDestruct(PlanControl& control) {
+	initial.deepDestruct(control);
+}
 
-template <typename TN, typename TA, typename TH>
-struct MaterialT   <TN, TA, TH> {
-	using Type = S_<TN, TA, TH>;
-};
+//------------------------------------------------------------------------------
 
-template <typename TN, typename TA, Strategy SG, 			  typename... TS>
-struct MaterialT   <TN, TA, CI_<SG, void,             TS...>> {
-	using Type = C_<TN, TA,     SG, StaticEmptyT<TA>, TS...>;
-};
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+void
+OS_<TN, TA, NI, TI>::wideForwardActive(Control& control,
+									   const Request::Type request,
+									   const ProngConstBits prongs)
+{
+	const Request::Type local = prongs.get(PRONG_INDEX) ?
+		request : Request::REMAIN;
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
-struct MaterialT   <TN, TA, CI_<SG, TH,	TS...>> {
-	using Type = C_<TN, TA,     SG, TH,	TS...>;
-};
+	initial.deepForwardActive(control, local);
+}
 
-template <typename TN, typename TA,				 typename... TS>
-struct MaterialT   <TN, TA, OI_<void,			  TS...>> {
-	using Type = O_<TN, TA,     StaticEmptyT<TA>, TS...>;
-};
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
-struct MaterialT   <TN, TA, OI_<TH,				  TS...>> {
-	using Type = O_<TN, TA,     TH,				  TS...>;
-};
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+void
+OS_<TN, TA, NI, TI>::wideForwardRequest(Control& control,
+										const Request::Type request,
+										const ProngConstBits prongs)
+{
+	const Request::Type local = prongs.get(PRONG_INDEX) ?
+		request : Request::REMAIN;
 
-template <typename TN, typename... TS>
-using Material = typename MaterialT<TN, TS...>::Type;
+	initial.deepForwardRequest(control, local);
+}
 
 //------------------------------------------------------------------------------
 
-template <typename TConfig,
-		  typename TApex>
-struct RF_ final {
-	using Config_		= TConfig;
-	using Context		= typename Config_::Context;
-	using Apex			= TApex;
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+void
+OS_<TN, TA, NI, TI>::wideRequestChange(Control& control) {
+	initial.deepRequestChange(control);
+}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	static constexpr LongIndex SUBSTITUTION_LIMIT= Config_::SUBSTITUTION_LIMIT;
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+void
+OS_<TN, TA, NI, TI>::wideRequestRemain(Registry& registry) {
+	initial.deepRequestRemain(registry);
+}
 
-	static constexpr LongIndex TASK_CAPACITY	 = Config_::TASK_CAPACITY != INVALID_LONG_INDEX ?
-													   Config_::TASK_CAPACITY : Apex::COMPO_PRONGS * 2;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	static constexpr ShortIndex COMPO_REGIONS	 = Apex::COMPO_REGIONS;
-	static constexpr ShortIndex ORTHO_REGIONS	 = Apex::ORTHO_REGIONS;
-	static constexpr ShortIndex ORTHO_UNITS		 = Apex::ORTHO_UNITS;
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+void
+OS_<TN, TA, NI, TI>::wideRequestRestart(Registry& registry) {
+	initial.deepRequestRestart(registry);
+}
 
-	static constexpr LongIndex  ACTIVE_BITS		 = Apex::ACTIVE_BITS;
-	static constexpr LongIndex  RESUMABLE_BITS	 = Apex::RESUMABLE_BITS;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	using StateList		= typename Apex::StateList;
-	using RegionList	= typename Apex::RegionList;
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+void
+OS_<TN, TA, NI, TI>::wideRequestResume(Registry& registry) {
+	initial.deepRequestResume(registry);
+}
 
-	using Args			= ArgsT<Context,
-								Config_,
-								StateList,
-								RegionList,
-								COMPO_REGIONS,
-								ORTHO_REGIONS,
-								ORTHO_UNITS,
-								ACTIVE_BITS + RESUMABLE_BITS,
-								TASK_CAPACITY>;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+void
+OS_<TN, TA, NI, TI>::wideRequestUtilize(Control& control) {
+	initial.deepRequestUtilize(control);
+}
 
-	using Instance		= RW_<Config_, Apex>;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	using Control		= ControlT	   <Args>;
-	using FullControl	= FullControlT <Args>;
-	using GuardControl	= GuardControlT<Args>;
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+void
+OS_<TN, TA, NI, TI>::wideRequestRandomize(Control& control) {
+	initial.deepRequestRandomize(control);
+}
 
-	using Injection		= InjectionT<Args>;
+//------------------------------------------------------------------------------
 
-	//----------------------------------------------------------------------
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+typename TA::Utility
+OS_<TN, TA, NI, TI>::wideReportChange(Control& control) {
+	const UP i = initial.deepReportChange(control);
 
-	using DynamicState	= DynamicEmptyT<Args>;
+	return i.utility;
+}
 
-	template <typename... TInjections>
-	using DynamicStateT	= DB_<TInjections...>;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+typename TA::Utility
+OS_<TN, TA, NI, TI>::wideReportUtilize(Control& control) {
+	const UP i = initial.deepReportUtilize(control);
 
-	using StaticState	= StaticEmptyT<Args>;
+	return i.utility;
+}
 
-	template <typename... TInjections>
-	using StaticStateT	= SB_<TInjections...>;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+typename TA::Utility
+OS_<TN, TA, NI, TI>::wideReportRandomize(Control& control) {
+	const Utility i = initial.deepReportRandomize(control);
 
-	using State			= StaticState;
+	return i;
+}
 
-	template <typename... TInjections>
-	using StateT		= StaticStateT<TInjections...>;
+//------------------------------------------------------------------------------
 
-	//----------------------------------------------------------------------
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+void
+OS_<TN, TA, NI, TI>::wideChangeToRequested(PlanControl& control) {
+	initial.deepChangeToRequested(control);
+}
 
-	template <typename T>
-	static constexpr bool contains() {
-		return StateList::template index<T>() != INVALID_LONG_INDEX;
-	}
+//------------------------------------------------------------------------------
 
-	template <typename T>
-	static constexpr StateID  stateId()		{ return			StateList ::template index<T>();	}
+#ifdef HFSM_ENABLE_STRUCTURE_REPORT
 
-	template <typename T>
-	static constexpr RegionID regionId()	{ return (RegionID) RegionList::template index<T>();	}
-};
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+void
+OS_<TN, TA, NI, TI>::wideGetNames(const LongIndex parent,
+								  const ShortIndex depth,
+								  StructureStateInfos& _stateInfos) const
+{
+	initial.deepGetNames(parent, StructureStateInfo::ORTHOGONAL, depth, _stateInfos);
+}
 
-////////////////////////////////////////////////////////////////////////////////
+#endif
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
-struct CSubMaterialT;
+//------------------------------------------------------------------------------
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
-struct CSubMaterialT<TN, TA, SG, NI, ITL_<TS...>> {
-	using Type = CS_<TN, TA, SG, NI,	  TS...>;
-};
+#ifdef HFSM_ENABLE_SERIALIZATION
+
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+void
+OS_<TN, TA, NI, TI>::wideSaveActive(const Registry& registry,
+									WriteStream& stream) const
+{
+	initial.deepSaveActive(registry, stream);
+}
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
-using CSubMaterial = typename CSubMaterialT<TN, TA, SG, NI, TS...>::Type;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-//------------------------------------------------------------------------------
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+void
+OS_<TN, TA, NI, TI>::wideSaveResumable(const Registry& registry,
+									   WriteStream& stream) const
+{
+	initial.deepSaveResumable(registry, stream);
+}
 
-template <typename...>
-struct InfoT;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH>
-struct InfoT<S_<TN, TA, TH>> {
-	using Type = SI_<	TH>;
-};
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+void
+OS_<TN, TA, NI, TI>::wideLoadRequested(Registry& registry,
+									   ReadStream& stream) const
+{
+	initial.deepLoadRequested(registry, stream);
+}
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
-struct InfoT<C_<TN, TA, SG, TH, TS...>> {
-	using Type = CI_<	SG, TH, TS...>;
-};
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
-struct InfoT<O_<TN, TA, TH, TS...>> {
-	using Type = OI_<	TH, TS...>;
-};
+template <typename TN, typename TA, ShortIndex NI, typename TI>
+void
+OS_<TN, TA, NI, TI>::wideLoadResumable(Registry& registry,
+									   ReadStream& stream) const
+{
+	initial.deepLoadResumable(registry, stream);
+}
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
-struct InfoT<CS_<TN, TA, SG, NI, TS...>> {
-	using Type = CSI_<			 TS...>;
-};
+#endif
 
 ////////////////////////////////////////////////////////////////////////////////
 
@@ -6074,22 +12823,18 @@ namespace detail {
 
 template <typename TIndices,
 		  typename TArgs,
-		  Strategy TStrategy,
-		  ShortIndex NIndex,
-		  typename... TStates>
-struct CS_ final {
-	static_assert(sizeof...(TStates) >= 2, "");
-
+		  Execution TExecution,
+		  typename THead,
+		  typename... TSubStates>
+struct O_ final {
 	using Indices		= TIndices;
-	static constexpr StateID	INITIAL_ID	= Indices::STATE_ID;
+	static constexpr StateID	HEAD_ID		= Indices::STATE_ID;
 	static constexpr ShortIndex COMPO_INDEX	= Indices::COMPO_INDEX;
 	static constexpr ShortIndex ORTHO_INDEX	= Indices::ORTHO_INDEX;
 	static constexpr ShortIndex ORTHO_UNIT	= Indices::ORTHO_UNIT;
 
-	static constexpr Strategy	STRATEGY	= TStrategy;
-
 	static constexpr ShortIndex REGION_ID	= COMPO_INDEX + ORTHO_INDEX;
-	static constexpr ShortIndex PRONG_INDEX	= NIndex;
+	static constexpr ForkID		ORTHO_ID	= (ForkID) -ORTHO_INDEX - 1;
 
 	using Args			= TArgs;
 	using Rank			= typename Args::Rank;
@@ -6098,5261 +12843,6081 @@ struct CS_ final {
 	using StateList		= typename Args::StateList;
 	using RegionList	= typename Args::RegionList;
 
+	using Head			= THead;
+
+	using Info			= OI_<TExecution, Head, TSubStates...>;
+	static constexpr ShortIndex WIDTH		= Info::WIDTH;
+	static constexpr ShortIndex REGION_SIZE	= Info::STATE_COUNT;
+	static constexpr ShortIndex ORTHO_UNITS	= Info::ORTHO_UNITS;
+
 	using Registry		= RegistryT<Args>;
 	using StateParents	= typename Registry::StateParents;
+	using OrthoForks	= typename Registry::OrthoForks;
+	using ProngBits		= typename OrthoForks::Bits;
+	using ProngConstBits= typename OrthoForks::ConstBits;
 
-	using Control		= ControlT	   <Args>;
-	using PlanControl	= PlanControlT <Args>;
-	using FullControl	= FullControlT <Args>;
-	using GuardControl	= GuardControlT<Args>;
+	using Control		= ControlT<Args>;
 
-	static constexpr ShortIndex L_PRONG = PRONG_INDEX;
+	using PlanControl	= PlanControlT<Args>;
+	using ScopedOrigin	= typename PlanControl::Origin;
+	using ScopedRegion	= typename PlanControl::Region;
 
-	using LStates		= SplitL<TStates...>;
-	using LHalf			= CSubMaterial<I_<INITIAL_ID,
-										  COMPO_INDEX,
-										  ORTHO_INDEX,
-										  ORTHO_UNIT>,
-									   Args,
-									   STRATEGY,
-									   L_PRONG,
-									   LStates>;
-	using LHalfInfo		= typename InfoT<LHalf>::Type;
+	using FullControl	= FullControlT<Args>;
+	using ControlLock	= typename FullControl::Lock;
 
-	static constexpr ShortIndex R_PRONG = PRONG_INDEX + LStates::SIZE;
+	using GuardControl	= GuardControlT<Args>;
 
-	using RStates		= SplitR<TStates...>;
-	using RHalf			= CSubMaterial<I_<INITIAL_ID  + LHalfInfo::STATE_COUNT,
-										  COMPO_INDEX + LHalfInfo::COMPO_REGIONS,
-										  ORTHO_INDEX + LHalfInfo::ORTHO_REGIONS,
-										  ORTHO_UNIT  + LHalfInfo::ORTHO_UNITS>,
-									   Args,
-									   STRATEGY,
-									   R_PRONG,
-									   RStates>;
+	using HeadState		= S_<Indices, Args, Head>;
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	using SubStates		= OS_<I_<HEAD_ID + 1,
+								 COMPO_INDEX,
+								 ORTHO_INDEX + 1,
+								 ORTHO_UNIT + (WIDTH + 7) / 8>,
+							  Args,
+							  0,
+							  TSubStates...>;
+
+	//----------------------------------------------------------------------
 
 #ifdef HFSM_EXPLICIT_MEMBER_SPECIALIZATION
 	template <typename T>
-	HFSM_INLINE		  T& access();
+	struct Accessor {
+		HFSM_INLINE static		 T&	   get(		 O_& o)							{ return o._subStates.template access<T>();	}
+		HFSM_INLINE static const T&	   get(const O_& o)							{ return o._subStates.template access<T>();	}
+	};
+
+	template <>
+	struct Accessor<Head> {
+		HFSM_INLINE static		 Head& get(		 O_& o)							{ return o._headState._headBox.get();		}
+		HFSM_INLINE static const Head& get(const O_& o)							{ return o._headState._headBox.get();		}
+	};
 
 	template <typename T>
-	HFSM_INLINE const T& access() const;
+	HFSM_INLINE		  T&	access()											{ return Accessor<T>::get(*this);			}
+
+	template <typename T>
+	HFSM_INLINE const T&	access() const										{ return Accessor<T>::get(*this);			}
 #endif
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	//----------------------------------------------------------------------
 
-	HFSM_INLINE void	wideRegister				  (Registry& registry, const Parent parent);
+	HFSM_INLINE ProngBits	   orthoRequested(		Registry& registry)			{ return registry.orthoRequested.template bits<ORTHO_UNIT, WIDTH>();	}
+	HFSM_INLINE ProngConstBits orthoRequested(const Registry& registry) const	{ return registry.orthoRequested.template bits<ORTHO_UNIT, WIDTH>();	}
+
+	HFSM_INLINE ProngBits	   orthoRequested(		Control& control)			{ return orthoRequested(control._registry);								}
+	HFSM_INLINE ProngConstBits orthoRequested(const Control& control) const		{ return orthoRequested(control._registry);								}
+
+	HFSM_INLINE void	deepRegister		 (Registry& registry, const Parent parent);
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	HFSM_INLINE bool	wideForwardEntryGuard		  (GuardControl& control,								const ShortIndex prong);
-	HFSM_INLINE bool	wideEntryGuard				  (GuardControl& control,								const ShortIndex prong);
+	HFSM_INLINE bool	deepForwardEntryGuard(GuardControl&	control);
+	HFSM_INLINE bool	deepEntryGuard		 (GuardControl&	control);
 
-	HFSM_INLINE void	wideConstruct				  (PlanControl&  control,								const ShortIndex prong);
+	HFSM_INLINE void	deepConstruct		 (PlanControl&	control);
 
-	HFSM_INLINE void	wideEnter					  (PlanControl&  control,								const ShortIndex prong);
-	HFSM_INLINE void	wideReenter					  (PlanControl&  control,								const ShortIndex prong);
+	HFSM_INLINE void	deepEnter			 (PlanControl&	control);
+	HFSM_INLINE void	deepReenter			 (PlanControl&	control);
 
-	HFSM_INLINE Status	wideUpdate					  (FullControl&  control,								const ShortIndex prong);
+	HFSM_INLINE Status	deepUpdate			 (FullControl&	control);
 
 	template <typename TEvent>
-	HFSM_INLINE Status	wideReact					  (FullControl&  control, const TEvent& event,			const ShortIndex prong);
+	HFSM_INLINE Status	deepReact			 (FullControl&	control, const TEvent& event);
 
-	HFSM_INLINE bool	wideForwardExitGuard		  (GuardControl& control,								const ShortIndex prong);
-	HFSM_INLINE bool	wideExitGuard				  (GuardControl& control,								const ShortIndex prong);
+	HFSM_INLINE bool	deepForwardExitGuard (GuardControl&	control);
+	HFSM_INLINE bool	deepExitGuard		 (GuardControl&	control);
 
-	HFSM_INLINE void	wideExit					  (PlanControl&  control,								const ShortIndex prong);
+	HFSM_INLINE void	deepExit			 (PlanControl&	control);
 
-	HFSM_INLINE void	wideDestruct				  (PlanControl&  control,								const ShortIndex prong);
+	HFSM_INLINE void	deepDestruct		 (PlanControl&  control);
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	HFSM_INLINE void	wideForwardActive			  (Control& control,	 const Request::Type request,	const ShortIndex prong);
-	HFSM_INLINE void	wideForwardRequest			  (Control& control,	 const Request::Type request,	const ShortIndex prong);
+	HFSM_INLINE void	deepForwardActive	 (Control& control, const Request::Type request);
+	HFSM_INLINE void	deepForwardRequest	 (Control& control, const Request::Type request);
+
+	HFSM_INLINE void	deepRequest			 (Control& control, const Request::Type request);
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-#ifdef HFSM_EXPLICIT_MEMBER_SPECIALIZATION
+	HFSM_INLINE void	deepRequestChange	 (Control& control);
+	HFSM_INLINE void	deepRequestRemain	 (Registry& registry);
+	HFSM_INLINE void	deepRequestRestart	 (Registry& registry);
+	HFSM_INLINE void	deepRequestResume	 (Registry& registry);
+	HFSM_INLINE void	deepRequestUtilize	 (Control& control);
+	HFSM_INLINE void	deepRequestRandomize (Control& control);
 
-	template <Strategy = STRATEGY>
-	HFSM_INLINE void	wideRequestChange			  (Control& control,									const ShortIndex = INVALID_SHORT_INDEX);
+	HFSM_INLINE UP		deepReportChange	 (Control& control);
+	HFSM_INLINE UP		deepReportUtilize	 (Control& control);
+	HFSM_INLINE Rank	deepReportRank		 (Control& control);
+	HFSM_INLINE Utility	deepReportRandomize	 (Control& control);
 
-	template <>
-	HFSM_INLINE void	wideRequestChange<Composite>  (Control& control,									const ShortIndex)		{ wideRequestChangeComposite(control);			}
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	template <>
-	HFSM_INLINE	void	wideRequestChange<Resumable>  (Control& control,									const ShortIndex prong)	{ wideRequestChangeResumable(control, prong);	}
+	HFSM_INLINE void	deepChangeToRequested(PlanControl& control);
 
-#else
+	//----------------------------------------------------------------------
 
-	HFSM_INLINE void	wideRequestChange			  (Control& control,									const ShortIndex = INVALID_SHORT_INDEX);
+#ifdef HFSM_ENABLE_STRUCTURE_REPORT
+	using StructureStateInfos = typename Args::StructureStateInfos;
+	using RegionType		  = typename StructureStateInfo::RegionType;
 
-#endif
+	static constexpr LongIndex NAME_COUNT	 = HeadState::NAME_COUNT  + SubStates::NAME_COUNT;
 
-	HFSM_INLINE void	wideRequestChangeComposite	  (Control& control);
-	HFSM_INLINE void	wideRequestChangeResumable	  (Control& control,									const ShortIndex prong);
+	void deepGetNames(const LongIndex parent,
+					  const RegionType region,
+					  const ShortIndex depth,
+					  StructureStateInfos& stateInfos) const;
+#endif
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	HFSM_INLINE void	wideRequestRemain			  (Registry& registry);
-	HFSM_INLINE void	wideRequestRestart			  (Registry& registry);
-	HFSM_INLINE void	wideRequestResume			  (Registry& registry,									const ShortIndex prong);
+#ifdef HFSM_ENABLE_SERIALIZATION
+	using WriteStream	= typename Args::WriteStream;
+	using ReadStream	= typename Args::ReadStream;
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	HFSM_INLINE void	deepSaveActive	 (const Registry& registry, WriteStream& stream) const;
+	HFSM_INLINE void	deepSaveResumable(const Registry& registry, WriteStream& stream) const;
 
-	HFSM_INLINE UP		wideReportChangeComposite	  (Control& control);
-	HFSM_INLINE UP		wideReportChangeResumable	  (Control& control,									const ShortIndex prong);
-	HFSM_INLINE UP		wideReportChangeUtilitarian	  (Control& control);
-	HFSM_INLINE Utility	wideReportChangeRandom		  (Control& control,	 Utility* const options, const Rank* const ranks, const Rank top);
+	HFSM_INLINE void	deepLoadRequested(		Registry& registry, ReadStream&  stream) const;
+	HFSM_INLINE void	deepLoadResumable(		Registry& registry, ReadStream&  stream) const;
+#endif
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	//----------------------------------------------------------------------
+
+	// Sub-states in sequence, or forked for Execution::Parallel
+	HFSM_INLINE Status	subUpdate			 (FullControl&	control);
+
+	template <typename TEvent>
+	HFSM_INLINE Status	subReact			 (FullControl&	control, const TEvent& event);
+
+#ifdef HFSM_ENABLE_PARALLEL
+	using Requests		= typename FullControl::Requests;
+	using ProngTasks	= typename FullControl::ProngTasks;
+
+	template <typename TEvent>
+	struct ForkT {
+		O_& region;
+		FullControl& control;
+		const TEvent* const event;
+
+		Requests requests[WIDTH];
+		ProngTasks tasks[WIDTH];
+		Status statuses[WIDTH];
+	};
+
+	template <typename TEvent>
+	Status fork(FullControl& control, const TEvent* const event);
+
+	template <typename TEvent>
+	static void runProng(void* const argument, const LongIndex prong);
+
+	HFSM_INLINE Status	prongStatus			 (FullControl&	control, const void*   /*update*/,	const ShortIndex prong);
+
+	template <typename TEvent>
+	HFSM_INLINE Status	prongStatus			 (FullControl&	control, const TEvent* const event,	const ShortIndex prong);
+#endif
+
+	//----------------------------------------------------------------------
+
+	HeadState _headState;
+	SubStates _subStates;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+}
+
+namespace hfsm2 {
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+void
+O_<TN, TA, EX, TH, TS...>::deepRegister(Registry& registry,
+										const Parent parent)
+{
+	registry.orthoParents[ORTHO_INDEX] = parent;
+	registry.orthoUnits[ORTHO_INDEX] = Units{ORTHO_UNIT, WIDTH};
 
-	HFSM_INLINE UP		wideReportUtilize			  (Control& control);
-	HFSM_INLINE Rank	wideReportRank				  (Control& control,	 Rank*	  const ranks);
-	HFSM_INLINE Utility	wideReportRandomize			  (Control& control,	 Utility* const options, const Rank* const ranks, const Rank top);
+	_headState.deepRegister(registry, parent);
+	_subStates.wideRegister(registry, ORTHO_ID);
+}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//------------------------------------------------------------------------------
 
-	HFSM_INLINE void	wideChangeToRequested		  (PlanControl& control, const ShortIndex prong);
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+bool
+O_<TN, TA, EX, TH, TS...>::deepForwardEntryGuard(GuardControl& control) {
+	const ProngConstBits requested = orthoRequested(static_cast<const GuardControl&>(control));
 
-	//----------------------------------------------------------------------
+	ScopedRegion region{control, REGION_ID, HEAD_ID, REGION_SIZE};
 
-#ifdef HFSM_ENABLE_STRUCTURE_REPORT
-	using StructureStateInfos = typename Args::StructureStateInfos;
-	using RegionType		  = typename StructureStateInfo::RegionType;
+	if (requested)
+		return _subStates.wideForwardEntryGuard(control, requested);
+	else
+		return _subStates.wideForwardEntryGuard(control);
+}
 
-	static constexpr LongIndex NAME_COUNT = LHalf::NAME_COUNT + RHalf::NAME_COUNT;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	void wideGetNames(const LongIndex parent,
-					  const RegionType region,
-					  const ShortIndex depth,
-					  StructureStateInfos& stateInfos) const;
-#endif
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+bool
+O_<TN, TA, EX, TH, TS...>::deepEntryGuard(GuardControl& control) {
+	ScopedRegion region{control, REGION_ID, HEAD_ID, REGION_SIZE};
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	return _headState.deepEntryGuard(control) ||
+		   _subStates.wideEntryGuard(control);
+}
 
-#ifdef HFSM_ENABLE_SERIALIZATION
-	using WriteStream	= typename Args::WriteStream;
-	using ReadStream	= typename Args::ReadStream;
+//------------------------------------------------------------------------------
 
-	HFSM_INLINE void	wideSaveActive	 (const Registry& registry, WriteStream& stream, const ShortIndex prong) const;
-	HFSM_INLINE void	wideSaveResumable(const Registry& registry, WriteStream& stream						   ) const;
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+void
+O_<TN, TA, EX, TH, TS...>::deepConstruct(PlanControl& control) {
+	ProngBits requested = orthoRequested(control);
+	requested.clear();
 
-	HFSM_INLINE void	wideLoadRequested(		Registry& registry, ReadStream&  stream, const ShortIndex prong) const;
-	HFSM_INLINE void	wideLoadResumable(		Registry& registry, ReadStream&  stream						   ) const;
-#endif
+	_headState.deepConstruct(control);
+	_subStates.wideConstruct(control);
+}
 
-	//----------------------------------------------------------------------
+//------------------------------------------------------------------------------
 
-	LHalf lHalf;
-	RHalf rHalf;
-};
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+void
+O_<TN, TA, EX, TH, TS...>::deepEnter(PlanControl& control) {
+	ScopedRegion region{control, REGION_ID, HEAD_ID, REGION_SIZE};
 
-////////////////////////////////////////////////////////////////////////////////
+	_headState.deepEnter(control);
+	_subStates.wideEnter(control);
+}
 
-template <typename TIndices,
-		  typename TArgs,
-		  Strategy TStrategy,
-		  ShortIndex NIndex,
-		  typename TState>
-struct CS_<TIndices, TArgs, TStrategy, NIndex, TState> final {
-	using Indices		= TIndices;
-	static constexpr StateID	INITIAL_ID	= Indices::STATE_ID;
-	static constexpr ShortIndex COMPO_INDEX	= Indices::COMPO_INDEX;
-	static constexpr ShortIndex ORTHO_INDEX	= Indices::ORTHO_INDEX;
-	static constexpr ShortIndex ORTHO_UNIT	= Indices::ORTHO_UNIT;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	static constexpr Strategy	STRATEGY	= TStrategy;
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+void
+O_<TN, TA, EX, TH, TS...>::deepReenter(PlanControl& control) {
+	ProngBits requested = orthoRequested(control);
+	requested.clear();
 
-	static constexpr ShortIndex REGION_ID	= COMPO_INDEX + ORTHO_INDEX;
-	static constexpr ShortIndex PRONG_INDEX	= NIndex;
+	ScopedRegion region{control, REGION_ID, HEAD_ID, REGION_SIZE};
 
-	using Args			= TArgs;
-	using Rank			= typename Args::Rank;
-	using Utility		= typename Args::Utility;
-	using UP			= typename Args::UP;
-	using StateList		= typename Args::StateList;
-	using RegionList	= typename Args::RegionList;
+	_headState.deepReenter(control);
+	_subStates.wideReenter(control);
+}
 
-	using Registry	= RegistryT<Args>;
-	using StateParents	= typename Registry::StateParents;
+//------------------------------------------------------------------------------
 
-	using Control		= ControlT	   <Args>;
-	using PlanControl	= PlanControlT <Args>;
-	using FullControl	= FullControlT <Args>;
-	using GuardControl	= GuardControlT<Args>;
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+Status
+O_<TN, TA, EX, TH, TS...>::deepUpdate(FullControl& control) {
+	HFSM_IF_UPDATE_PERIODS(if (!control._planData.updatePeriods.isDue(REGION_ID)) return Status{});
 
-	using State			= Material<I_<INITIAL_ID,
-									  COMPO_INDEX,
-									  ORTHO_INDEX,
-									  ORTHO_UNIT>,
-								   Args,
-								   TState>;
+	ScopedRegion outer{control, REGION_ID, HEAD_ID, REGION_SIZE};
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	if (const auto headStatus = _headState.deepUpdate(control)) {
+		ControlLock lock{control};
+		subUpdate(control);
 
-#ifdef HFSM_EXPLICIT_MEMBER_SPECIALIZATION
-	template <typename T>
-	HFSM_INLINE		  T& access()					  { return state.template access<T>();	}
+		return headStatus;
+	} else {
+		const Status subStatus = subUpdate(control);
 
-	template <typename T>
-	HFSM_INLINE const T& access() const				  { return state.template access<T>();	}
-#endif
+		if (subStatus.outerTransition)
+			return subStatus;
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+		ScopedRegion inner{control, REGION_ID, HEAD_ID, REGION_SIZE};
 
-	HFSM_INLINE void	wideRegister				  (Registry& registry, const Parent parent);
+		return subStatus && control._planData.planExists.template get<REGION_ID>() ?
+			control.updatePlan(_headState, subStatus) : subStatus;
+	}
+}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//------------------------------------------------------------------------------
 
-	HFSM_INLINE bool	wideForwardEntryGuard		  (GuardControl& control,								const ShortIndex prong);
-	HFSM_INLINE bool	wideEntryGuard				  (GuardControl& control,								const ShortIndex prong);
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+template <typename TEvent>
+Status
+O_<TN, TA, EX, TH, TS...>::deepReact(FullControl& control,
+									 const TEvent& event)
+{
+	ScopedRegion outer{control, REGION_ID, HEAD_ID, REGION_SIZE};
 
-	HFSM_INLINE void	wideConstruct				  (PlanControl& control,								const ShortIndex prong);
+	if (const auto headStatus = _headState.deepReact(control, event)) {
+		ControlLock lock{control};
+		subReact(control, event);
 
-	HFSM_INLINE void	wideEnter					  (PlanControl& control,								const ShortIndex prong);
-	HFSM_INLINE void	wideReenter					  (PlanControl& control,								const ShortIndex prong);
+		return headStatus;
+	} else {
+		const Status subStatus = subReact(control, event);
 
-	HFSM_INLINE Status	wideUpdate					  (FullControl& control,								const ShortIndex prong);
+		if (subStatus.outerTransition)
+			return subStatus;
 
-	template <typename TEvent>
-	HFSM_INLINE Status	wideReact					  (FullControl& control, const TEvent& event,			const ShortIndex prong);
+		ScopedRegion inner{control, REGION_ID, HEAD_ID, REGION_SIZE};
 
-	HFSM_INLINE bool	wideForwardExitGuard		  (GuardControl& control,								const ShortIndex prong);
-	HFSM_INLINE bool	wideExitGuard				  (GuardControl& control,								const ShortIndex prong);
+		return subStatus && control._planData.planExists.template get<REGION_ID>() ?
+			control.updatePlan(_headState, subStatus) : subStatus;
+	}
+}
 
-	HFSM_INLINE void	wideExit					  (PlanControl& control,								const ShortIndex prong);
+//------------------------------------------------------------------------------
 
-	HFSM_INLINE void	wideDestruct				  (PlanControl& control,								const ShortIndex prong);
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+bool
+O_<TN, TA, EX, TH, TS...>::deepForwardExitGuard(GuardControl& control) {
+	const ProngConstBits requested = orthoRequested(static_cast<const GuardControl&>(control));
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	ScopedRegion region{control, REGION_ID, HEAD_ID, REGION_SIZE};
 
-	HFSM_INLINE void	wideForwardActive			  (Control& control,	 const Request::Type request,	const ShortIndex prong);
-	HFSM_INLINE void	wideForwardRequest			  (Control& control,	 const Request::Type request,	const ShortIndex prong);
+	if (requested)
+		return _subStates.wideForwardExitGuard(control, requested);
+	else
+		return _subStates.wideForwardExitGuard(control);
+}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	HFSM_INLINE void	wideRequestChangeComposite	  (Control& control);
-	HFSM_INLINE void	wideRequestChangeResumable	  (Control& control,	 								const ShortIndex prong);
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+bool
+O_<TN, TA, EX, TH, TS...>::deepExitGuard(GuardControl& control) {
+	ScopedRegion region{control, REGION_ID, HEAD_ID, REGION_SIZE};
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	return _headState.deepExitGuard(control) ||
+		   _subStates.wideExitGuard(control);
+}
 
-	HFSM_INLINE void	wideRequestRemain			  (Registry& registry);
-	HFSM_INLINE void	wideRequestRestart			  (Registry& registry);
-	HFSM_INLINE void	wideRequestResume			  (Registry& registry,									const ShortIndex prong);
+//------------------------------------------------------------------------------
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+void
+O_<TN, TA, EX, TH, TS...>::deepExit(PlanControl& control) {
+	_subStates.wideExit(control);
+	_headState.deepExit(control);
+}
 
-	HFSM_INLINE UP		wideReportChangeComposite	  (Control& control);
-	HFSM_INLINE UP		wideReportChangeResumable	  (Control& control,									const ShortIndex prong);
-	HFSM_INLINE UP		wideReportChangeUtilitarian	  (Control& control);
-	HFSM_INLINE Utility	wideReportChangeRandom		  (Control& control,	 Utility* const options, const Rank* const ranks, const Rank top);
+//------------------------------------------------------------------------------
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+void
+O_<TN, TA, EX, TH, TS...>::deepDestruct(PlanControl& control) {
+	_subStates.wideDestruct(control);
+	_headState.deepDestruct(control);
+}
 
-	HFSM_INLINE UP		wideReportUtilize			  (Control& control);
-	HFSM_INLINE Rank	wideReportRank				  (Control& control,	 Rank*	  const ranks);
-	HFSM_INLINE Utility	wideReportRandomize			  (Control& control,	 Utility* const options, const Rank* const ranks, const Rank top);
+//------------------------------------------------------------------------------
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+void
+O_<TN, TA, EX, TH, TS...>::deepForwardActive(Control& control,
+											 const Request::Type request)
+{
+	HFSM_ASSERT(control._registry.isActive(HEAD_ID));
 
-	HFSM_INLINE void	wideChangeToRequested		  (PlanControl& control,								const ShortIndex prong);
+	const ProngConstBits requested = orthoRequested(static_cast<const Control&>(control));
+	HFSM_ASSERT(!!requested);
 
-	//----------------------------------------------------------------------
+	_subStates.wideForwardActive(control, request, requested);
+}
 
-#ifdef HFSM_ENABLE_STRUCTURE_REPORT
-	using StructureStateInfos = typename Args::StructureStateInfos;
-	using RegionType		  = typename StructureStateInfo::RegionType;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	static constexpr LongIndex NAME_COUNT = State::NAME_COUNT;
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+void
+O_<TN, TA, EX, TH, TS...>::deepForwardRequest(Control& control,
+											  const Request::Type request)
+{
+	const ProngConstBits requested = orthoRequested(static_cast<const Control&>(control));
 
-	void wideGetNames(const LongIndex parent,
-					  const RegionType region,
-					  const ShortIndex depth,
-					  StructureStateInfos& stateInfos) const;
-#endif
+	if (requested)
+		_subStates.wideForwardRequest(control, request, requested);
+	else
+		deepRequest					 (control, request);
+}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-#ifdef HFSM_ENABLE_SERIALIZATION
-	using WriteStream	= typename Args::WriteStream;
-	using ReadStream	= typename Args::ReadStream;
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+void
+O_<TN, TA, EX, TH, TS...>::deepRequest(Control& control,
+									   const Request::Type request)
+{
+	switch (request) {
+	case Request::REMAIN:
+		deepRequestRemain (control._registry);
+		break;
 
-	HFSM_INLINE void	wideSaveActive	 (const Registry& registry, WriteStream& stream, const ShortIndex prong) const;
-	HFSM_INLINE void	wideSaveResumable(const Registry& registry, WriteStream& stream						   ) const;
+	case Request::CHANGE:
+		deepRequestChange (control);
+		break;
 
-	HFSM_INLINE void	wideLoadRequested(		Registry& registry, ReadStream&  stream, const ShortIndex prong) const;
-	HFSM_INLINE void	wideLoadResumable(		Registry& registry, ReadStream&  stream						   ) const;
-#endif
+	case Request::RESTART:
+		deepRequestRestart(control._registry);
+		break;
 
-	//----------------------------------------------------------------------
+	case Request::RESUME:
+		deepRequestResume (control._registry);
+		break;
 
-	State state;
-};
+	case Request::UTILIZE:
+		deepRequestUtilize(control);
+		break;
 
-////////////////////////////////////////////////////////////////////////////////
+	case Request::RANDOMIZE:
+		deepRequestRandomize(control);
+		break;
 
+	default:
+		HFSM_BREAK();
+	}
 }
+
+//------------------------------------------------------------------------------
+
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+void
+O_<TN, TA, EX, TH, TS...>::deepRequestChange(Control& control) {
+	_subStates.wideRequestChange(control);
 }
 
-namespace hfsm2 {
-namespace detail {
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-////////////////////////////////////////////////////////////////////////////////
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+void
+O_<TN, TA, EX, TH, TS...>::deepRequestRemain(Registry& registry) {
+	_subStates.wideRequestRemain(registry);
+}
 
-#ifdef HFSM_EXPLICIT_MEMBER_SPECIALIZATION
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
-template <typename T>
-T&
-CS_<TN, TA, SG, NI, TS...>::access() {
-	return LHalfInfo::StateList::template contains<T>() ?
-		lHalf.template access<T>() :
-		rHalf.template access<T>();
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+void
+O_<TN, TA, EX, TH, TS...>::deepRequestRestart(Registry& registry) {
+	_subStates.wideRequestRestart(registry);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
-template <typename T>
-const T&
-CS_<TN, TA, SG, NI, TS...>::access() const {
-	return LHalfInfo::StateList::template contains<T>() ?
-		lHalf.template access<T>() :
-		rHalf.template access<T>();
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+void
+O_<TN, TA, EX, TH, TS...>::deepRequestResume(Registry& registry) {
+	_subStates.wideRequestResume(registry);
 }
 
-#endif
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-//------------------------------------------------------------------------------
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+void
+O_<TN, TA, EX, TH, TS...>::deepRequestUtilize(Control& control) {
+	_subStates.wideRequestUtilize(control);
+}
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 void
-CS_<TN, TA, SG, NI, TS...>::wideRegister(Registry& registry,
-										 const Parent parent)
-{
-	lHalf.wideRegister(registry, Parent{parent.forkId, L_PRONG});
-	rHalf.wideRegister(registry, Parent{parent.forkId, R_PRONG});
+O_<TN, TA, EX, TH, TS...>::deepRequestRandomize(Control& control) {
+	_subStates.wideRequestRandomize(control);
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
-bool
-CS_<TN, TA, SG, NI, TS...>::wideForwardEntryGuard(GuardControl& control,
-												  const ShortIndex prong)
-{
-	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+typename TA::UP
+O_<TN, TA, EX, TH, TS...>::deepReportChange(Control& control) {
+	const UP	  h = _headState.deepReportChange(control);
+	const Utility s = _subStates.wideReportChange(control);
 
-	if (prong < R_PRONG)
-		return lHalf.wideForwardEntryGuard(control, prong);
-	else
-		return rHalf.wideForwardEntryGuard(control, prong);
+	const Utility sub = s / WIDTH;
+
+	HFSM_LOG_UTILITY_RESOLUTION(control.context(), HEAD_ID, INVALID_STATE_ID, sub);
+
+	return {
+		h.utility * sub,
+		h.prong
+	};
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
-bool
-CS_<TN, TA, SG, NI, TS...>::wideEntryGuard(GuardControl& control,
-										   const ShortIndex prong)
-{
-	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
-
-	if (prong < R_PRONG)
-		return lHalf.wideEntryGuard(control, prong);
-	else
-		return rHalf.wideEntryGuard(control, prong);
-}
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+typename TA::UP
+O_<TN, TA, EX, TH, TS...>::deepReportUtilize(Control& control) {
+	const UP	  h = _headState.deepReportUtilize(control);
+	const Utility s = _subStates.wideReportUtilize(control);
 
-//------------------------------------------------------------------------------
+	const Utility sub = s / WIDTH;
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
-void
-CS_<TN, TA, SG, NI, TS...>::wideConstruct(PlanControl& control,
-										  const ShortIndex prong)
-{
-	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
+	HFSM_LOG_UTILITY_RESOLUTION(control.context(), HEAD_ID, INVALID_STATE_ID, sub);
 
-	if (prong < R_PRONG)
-		lHalf.wideConstruct(control, prong);
-	else
-		rHalf.wideConstruct(control, prong);
+	return {
+		h.utility * sub,
+		h.prong
+	};
 }
 
-//------------------------------------------------------------------------------
-
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
-void
-CS_<TN, TA, SG, NI, TS...>::wideEnter(PlanControl& control,
-									  const ShortIndex prong)
-{
-	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	if (prong < R_PRONG)
-		lHalf.wideEnter(control, prong);
-	else
-		rHalf.wideEnter(control, prong);
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+typename TA::Rank
+O_<TN, TA, EX, TH, TS...>::deepReportRank(Control& control) {
+	return _headState.wrapRank(control);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
-void
-CS_<TN, TA, SG, NI, TS...>::wideReenter(PlanControl& control,
-										const ShortIndex prong)
-{
-	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+typename TA::Utility
+O_<TN, TA, EX, TH, TS...>::deepReportRandomize(Control& control) {
+	const Utility h = _headState.wrapUtility(control);
+	const Utility s = _subStates.wideReportRandomize(control);
 
-	if (prong < R_PRONG)
-		lHalf.wideReenter(control, prong);
-	else
-		rHalf.wideReenter(control, prong);
+	const Utility sub = s / WIDTH;
+
+	HFSM_LOG_RANDOM_RESOLUTION(control.context(), HEAD_ID, INVALID_STATE_ID, sub);
+
+	return h * sub;
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
-Status
-CS_<TN, TA, SG, NI, TS...>::wideUpdate(FullControl& control,
-									   const ShortIndex prong)
-{
-	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
-
-	return prong < R_PRONG ?
-		lHalf.wideUpdate(control, prong) :
-		rHalf.wideUpdate(control, prong);
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+void
+O_<TN, TA, EX, TH, TS...>::deepChangeToRequested(PlanControl& control) {
+	_subStates.wideChangeToRequested(control);
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
-template <typename TEvent>
-Status
-CS_<TN, TA, SG, NI, TS...>::wideReact(FullControl& control,
-									  const TEvent& event,
-									  const ShortIndex prong)
-{
-	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
+#ifdef HFSM_ENABLE_STRUCTURE_REPORT
 
-	return prong < R_PRONG ?
-		lHalf.wideReact(control, event, prong) :
-		rHalf.wideReact(control, event, prong);
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+void
+O_<TN, TA, EX, TH, TS...>::deepGetNames(const LongIndex parent,
+										const RegionType region,
+										const ShortIndex depth,
+										StructureStateInfos& stateInfos) const
+{
+	_headState.deepGetNames(parent, region,			depth,	   stateInfos);
+	_subStates.wideGetNames(stateInfos.count() - 1, depth + 1, stateInfos);
 }
 
+#endif
+
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
-bool
-CS_<TN, TA, SG, NI, TS...>::wideForwardExitGuard(GuardControl& control,
-												 const ShortIndex prong)
-{
-	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
+#ifdef HFSM_ENABLE_SERIALIZATION
 
-	if (prong < R_PRONG)
-		return lHalf.wideForwardExitGuard(control, prong);
-	else
-		return rHalf.wideForwardExitGuard(control, prong);
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+void
+O_<TN, TA, EX, TH, TS...>::deepSaveActive(const Registry& registry,
+										  WriteStream& stream) const
+{
+	_subStates.wideSaveActive(registry, stream);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
-bool
-CS_<TN, TA, SG, NI, TS...>::wideExitGuard(GuardControl& control,
-										  const ShortIndex prong)
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+void
+O_<TN, TA, EX, TH, TS...>::deepSaveResumable(const Registry& registry,
+											 WriteStream& stream) const
 {
-	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
-
-	if (prong < R_PRONG)
-		return lHalf.wideExitGuard(control, prong);
-	else
-		return rHalf.wideExitGuard(control, prong);
+	_subStates.wideSaveResumable(registry, stream);
 }
 
-//------------------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 void
-CS_<TN, TA, SG, NI, TS...>::wideExit(PlanControl& control,
-									 const ShortIndex prong)
+O_<TN, TA, EX, TH, TS...>::deepLoadRequested(Registry& registry,
+											 ReadStream& stream) const
 {
-	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
-
-	if (prong < R_PRONG)
-		lHalf.wideExit(control, prong);
-	else
-		rHalf.wideExit(control, prong);
+	_subStates.wideLoadRequested(registry, stream);
 }
 
-//------------------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
 void
-CS_<TN, TA, SG, NI, TS...>::wideDestruct(PlanControl& control,
-										 const ShortIndex prong)
+O_<TN, TA, EX, TH, TS...>::deepLoadResumable(Registry& registry,
+											 ReadStream& stream) const
 {
-	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
-
-	if (prong < R_PRONG)
-		lHalf.wideDestruct(control, prong);
-	else
-		rHalf.wideDestruct(control, prong);
+	_subStates.wideLoadResumable(registry, stream);
 }
 
+#endif
+
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
-void
-CS_<TN, TA, SG, NI, TS...>::wideForwardActive(Control& control,
-											  const Request::Type request,
-											  const ShortIndex prong)
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+Status
+O_<TN, TA, EX, TH, TS...>::subUpdate(FullControl& control) {
+#ifdef HFSM_ENABLE_PARALLEL
+	// nested parallel regions run in sequence within their sub-state
+	if (EX == Execution::Parallel && !control._prongTasks)
+		return fork(control, (const void*) nullptr);
+#endif
+
+	return _subStates.wideUpdate(control);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+template <typename TEvent>
+Status
+O_<TN, TA, EX, TH, TS...>::subReact(FullControl& control,
+									const TEvent& event)
 {
-	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
+#ifdef HFSM_ENABLE_PARALLEL
+	if (EX == Execution::Parallel && !control._prongTasks)
+		return fork(control, &event);
+#endif
 
-	if (prong < R_PRONG)
-		lHalf.wideForwardActive(control, request, prong);
-	else
-		rHalf.wideForwardActive(control, request, prong);
+	return _subStates.wideReact(control, event);
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//------------------------------------------------------------------------------
+
+#ifdef HFSM_ENABLE_PARALLEL
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
-void
-CS_<TN, TA, SG, NI, TS...>::wideForwardRequest(Control& control,
-											   const Request::Type request,
-											   const ShortIndex prong)
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+template <typename TEvent>
+Status
+O_<TN, TA, EX, TH, TS...>::fork(FullControl& control,
+								const TEvent* const event)
 {
-	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
+	ForkT<TEvent> fork{*this, control, event};
 
-	if (prong < R_PRONG)
-		lHalf.wideForwardRequest(control, request, prong);
+	HFSM_IF_ASSERT(control._planData.forked = true);
+
+	if (ExecutorInterface* const executor = control._planData.executor)
+		executor->execute(&runProng<TEvent>, &fork, WIDTH);
 	else
-		rHalf.wideForwardRequest(control, request, prong);
-}
+		for (LongIndex prong = 0; prong < WIDTH; ++prong)
+			runProng<TEvent>(&fork, prong);
 
-//------------------------------------------------------------------------------
+	HFSM_IF_ASSERT(control._planData.forked = false);
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
-void
-CS_<TN, TA, SG, NI, TS...>::wideRequestChangeComposite(Control& control) {
-	lHalf.wideRequestChangeComposite(control);
+	Status status;
+
+	for (ShortIndex prong = 0; prong < WIDTH; ++prong) {
+		for (const auto& request : fork.requests[prong])
+			control._requests.append(request);
+
+		const ProngTasks& tasks = fork.tasks[prong];
+
+		for (StateID stateId = HEAD_ID; stateId < HEAD_ID + REGION_SIZE; ++stateId) {
+			if (tasks.successes.get(stateId))
+				control.setSucceeded(stateId);
+
+			if (tasks.failures .get(stateId))
+				control.setFailed	(stateId);
+		}
+
+		status = combine(status, fork.statuses[prong]);
+	}
+
+	return status;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+template <typename TEvent>
 void
-CS_<TN, TA, SG, NI, TS...>::wideRequestChangeResumable(Control& control,
-													   const ShortIndex prong)
+O_<TN, TA, EX, TH, TS...>::runProng(void* const argument,
+									const LongIndex prong)
 {
-	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
+	HFSM_ASSERT(prong < WIDTH);
 
-	if (prong < R_PRONG)
-		lHalf.wideRequestChangeResumable(control, prong);
-	else
-		rHalf.wideRequestChangeResumable(control, prong);
-}
+	ForkT<TEvent>& fork = *static_cast<ForkT<TEvent>*>(argument);
 
-//------------------------------------------------------------------------------
+	FullControl control{fork.control,
+						fork.requests[prong],
+						fork.tasks[prong]};
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
-void
-CS_<TN, TA, SG, NI, TS...>::wideRequestRemain(Registry& registry) {
-	lHalf.wideRequestRemain(registry);
+	fork.statuses[prong] = fork.region.prongStatus(control, fork.event, (ShortIndex) prong);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
-void
-CS_<TN, TA, SG, NI, TS...>::wideRequestRestart(Registry& registry) {
-	lHalf.wideRequestRestart(registry);
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+Status
+O_<TN, TA, EX, TH, TS...>::prongStatus(FullControl& control,
+									   const void* /*update*/,
+									   const ShortIndex prong)
+{
+	return _subStates.wideUpdate(control, prong);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
-void
-CS_<TN, TA, SG, NI, TS...>::wideRequestResume(Registry& registry,
-											  const ShortIndex prong)
+template <typename TN, typename TA, Execution EX, typename TH, typename... TS>
+template <typename TEvent>
+Status
+O_<TN, TA, EX, TH, TS...>::prongStatus(FullControl& control,
+									   const TEvent* const event,
+									   const ShortIndex prong)
 {
-	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
-
-	if (prong < R_PRONG)
-		lHalf.wideRequestResume(registry, prong);
-	else
-		rHalf.wideRequestResume(registry, prong);
+	return _subStates.wideReact(control, *event, prong);
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+#endif
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
-typename TA::UP
-CS_<TN, TA, SG, NI, TS...>::wideReportUtilize(Control& control) {
-	const UP l = lHalf.wideReportUtilize(control);
-	const UP r = rHalf.wideReportUtilize(control);
+////////////////////////////////////////////////////////////////////////////////
 
-	return l.utility >= r.utility ?
-		l : r;
 }
+}
+namespace hfsm2 {
+namespace detail {
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+#ifndef HFSM_EXPLICIT_MEMBER_SPECIALIZATION
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
-typename TA::Rank
-CS_<TN, TA, SG, NI, TS...>::wideReportRank(Control& control,
-										   Rank* const ranks)
-{
-	HFSM_ASSERT(ranks);
+//------------------------------------------------------------------------------
 
-	const Rank l = lHalf.wideReportRank(control, ranks);
-	const Rank r = rHalf.wideReportRank(control, ranks + LStates::SIZE);
+template <typename...>
+struct Accessor;
 
-	return l > r?
-		l : r;
-}
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename T,
+		  typename TN,
+		  typename TA,
+		  Strategy TG,
+		  typename TH,
+		  typename... TS>
+struct Accessor<T,		 C_<TN, TA, TG, TH, TS...>> {
+	using Host =		 C_<TN, TA, TG, TH, TS...>;
+
+	HFSM_INLINE		  T& get()			{ return Accessor<T,	   typename Host::SubStates>{host._subStates}.get();	}
+
+	Host& host;
+};
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
-typename TA::Utility
-CS_<TN, TA, SG, NI, TS...>::wideReportRandomize(Control& control,
-												Utility* const options,
-												const Rank* const ranks,
-												const Rank top)
-{
-	HFSM_ASSERT(options && ranks);
+template <typename T,
+		  typename TN,
+		  typename TA,
+		  Strategy TG,
+		  typename TH,
+		  typename... TS>
+struct Accessor<T, const C_<TN, TA, TG, TH, TS...>> {
+	using Host =   const C_<TN, TA, TG, TH, TS...>;
 
-	const Utility l = lHalf.wideReportRandomize(control, options,				  ranks,				 top);
-	const Utility r = rHalf.wideReportRandomize(control, options + LStates::SIZE, ranks + LStates::SIZE, top);
+	HFSM_INLINE const T& get() const	{ return Accessor<T, const typename Host::SubStates>{host._subStates}.get();	}
 
-	return { l + r };
-}
+	Host& host;
+};
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
-typename TA::UP
-CS_<TN, TA, SG, NI, TS...>::wideReportChangeComposite(Control& control) {
-	return lHalf.wideReportChangeComposite(control);
-}
+template <typename T,
+		  typename TN,
+		  typename TA,
+		  Strategy TG,
+		  typename... TS>
+struct Accessor<T,		 C_<TN, TA, TG,  T, TS...>> {
+	using Host =		 C_<TN, TA, TG,  T, TS...>;
+
+	HFSM_INLINE		  T& get()			{ return host._headState._headBox.get();	}
+
+	Host& host;
+};
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
-typename TA::UP
-CS_<TN, TA, SG, NI, TS...>::wideReportChangeResumable(Control& control,
-													  const ShortIndex prong)
-{
-	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
+template <typename T,
+		  typename TN,
+		  typename TA,
+		  Strategy TG,
+		  typename... TS>
+struct Accessor<T, const C_<TN, TA, TG,  T, TS...>> {
+	using Host =   const C_<TN, TA, TG,  T, TS...>;
 
-	if (prong < R_PRONG)
-		return lHalf.wideReportChangeResumable(control, prong);
-	else
-		return rHalf.wideReportChangeResumable(control, prong);
-}
+	HFSM_INLINE const T& get() const	{ return host._headState._headBox.get();	}
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	Host& host;
+};
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
-typename TA::UP
-CS_<TN, TA, SG, NI, TS...>::wideReportChangeUtilitarian(Control& control) {
-	const UP l = lHalf.wideReportChangeUtilitarian(control);
-	const UP r = rHalf.wideReportChangeUtilitarian(control);
+////////////////////////////////////////////////////////////////////////////////
 
-	return l.utility >= r.utility ?
-		l : r;
-}
+template <typename T,
+		  typename TN,
+		  typename TA,
+		  Strategy TG,
+		  ShortIndex NI,
+		  typename... TS>
+struct Accessor<T,		 CS_<TN, TA, TG, NI, TS...>> {
+	using Host =		 CS_<TN, TA, TG, NI, TS...>;
+
+	HFSM_INLINE		  T& get()		 {
+		return Host::LHalfInfo::StateList::template contains<T>() ?
+			Accessor<T,		  typename Host::LHalf>{host.lHalf}.get() :
+			Accessor<T,		  typename Host::RHalf>{host.rHalf}.get();
+	}
+
+	Host& host;
+};
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
-typename TA::Utility
-CS_<TN, TA, SG, NI, TS...>::wideReportChangeRandom(Control& control,
-												   Utility* const options,
-												   const Rank* const ranks,
-												   const Rank top)
-{
-	HFSM_ASSERT(options && ranks);
+template <typename T,
+		  typename TN,
+		  typename TA,
+		  Strategy TG,
+		  ShortIndex NI,
+		  typename... TS>
+struct Accessor<T, const CS_<TN, TA, TG, NI, TS...>> {
+	using Host =   const CS_<TN, TA, TG, NI, TS...>;
 
-	const Utility l = lHalf.wideReportChangeRandom(control, options,				 ranks,					top);
-	const Utility r = rHalf.wideReportChangeRandom(control, options + LStates::SIZE, ranks + LStates::SIZE, top);
+	HFSM_INLINE const T& get() const {
+		return Host::LHalfInfo::StateList::template contains<T>() ?
+			Accessor<T, const typename Host::LHalf>{host.lHalf}.get() :
+			Accessor<T, const typename Host::RHalf>{host.rHalf}.get();
+	}
 
-	return { l + r };
-}
+	Host& host;
+};
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
-void
-CS_<TN, TA, SG, NI, TS...>::wideChangeToRequested(PlanControl& control,
-												  const ShortIndex prong)
-{
-	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
+template <typename T,
+		  typename TN,
+		  typename TA,
+		  Strategy TG,
+		  ShortIndex NI,
+		  typename TS>
+struct Accessor<T,		 CS_<TN, TA, TG, NI, TS>> {
+	using Host =		 CS_<TN, TA, TG, NI, TS>;
+
+	HFSM_INLINE		  T& get()			{ return Accessor<T,	   typename Host::State>{host.state}.get();				}
+
+	Host& host;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename T,
+		  typename TN,
+		  typename TA,
+		  Strategy TG,
+		  ShortIndex NI,
+		  typename TS>
+struct Accessor<T, const CS_<TN, TA, TG, NI, TS>> {
+	using Host =   const CS_<TN, TA, TG, NI, TS>;
+
+	HFSM_INLINE const T& get() const	{ return Accessor<T, const typename Host::State>{host.state}.get();				}
+
+	Host& host;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename T,
+		  typename TN,
+		  typename TA,
+		  Execution EX,
+		  typename TH,
+		  typename... TS>
+struct Accessor<T,		 O_<TN, TA, EX, TH, TS...>> {
+	using Host =		 O_<TN, TA, EX, TH, TS...>;
+
+	HFSM_INLINE		  T& get()			{ return Accessor<T,	   typename Host::SubStates>{host._subStates}.get();	}
 
-	if (prong < R_PRONG)
-		lHalf.wideChangeToRequested(control, prong);
-	else
-		rHalf.wideChangeToRequested(control, prong);
-}
+	Host& host;
+};
 
-//------------------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-#ifdef HFSM_ENABLE_STRUCTURE_REPORT
+template <typename T,
+		  typename TN,
+		  typename TA,
+		  Execution EX,
+		  typename TH,
+		  typename... TS>
+struct Accessor<T, const O_<TN, TA, EX, TH, TS...>> {
+	using Host =   const O_<TN, TA, EX, TH, TS...>;
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
-void
-CS_<TN, TA, SG, NI, TS...>::wideGetNames(const LongIndex parent,
-										 const RegionType /*region*/,
-										 const ShortIndex depth,
-										 StructureStateInfos& _stateInfos) const
-{
-	lHalf.wideGetNames(parent, StructureStateInfo::COMPOSITE, depth, _stateInfos);
-	rHalf.wideGetNames(parent, StructureStateInfo::COMPOSITE, depth, _stateInfos);
-}
+	HFSM_INLINE const T& get() const	{ return Accessor<T, const typename Host::SubStates>{host._subStates}.get();	}
 
-#endif
+	Host& host;
+};
 
 //------------------------------------------------------------------------------
 
-#ifdef HFSM_ENABLE_SERIALIZATION
+template <typename T,
+		  typename TN,
+		  typename TA,
+		  Execution EX,
+		  typename... TS>
+struct Accessor<T,		 O_<TN, TA, EX,  T, TS...>> {
+	using Host =		 O_<TN, TA, EX,  T, TS...>;
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
-void
-CS_<TN, TA, SG, NI, TS...>::wideSaveActive(const Registry& registry,
-										   WriteStream& stream,
-										   const ShortIndex prong) const
-{
-	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
+	HFSM_INLINE		  T& get()			{ return host._headState._headBox.get();	}
 
-	if (prong < R_PRONG) {
-		lHalf.wideSaveActive   (registry, stream, prong);
-		rHalf.wideSaveResumable(registry, stream);
-	} else {
-		lHalf.wideSaveResumable(registry, stream);
-		rHalf.wideSaveActive   (registry, stream, prong);
-	}
-}
+	Host& host;
+};
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
-void
-CS_<TN, TA, SG, NI, TS...>::wideSaveResumable(const Registry& registry,
-											  WriteStream& stream) const
-{
-	lHalf.wideSaveResumable(registry, stream);
-	rHalf.wideSaveResumable(registry, stream);
-}
+template <typename T,
+		  typename TN,
+		  typename TA,
+		  Execution EX,
+		  typename... TS>
+struct Accessor<T, const O_<TN, TA, EX,  T, TS...>> {
+	using Host =   const O_<TN, TA, EX,  T, TS...>;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	HFSM_INLINE const T& get() const	{ return host._headState._headBox.get();	}
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
-void
-CS_<TN, TA, SG, NI, TS...>::wideLoadRequested(Registry& registry,
-											  ReadStream& stream,
-											  const ShortIndex prong) const
-{
-	HFSM_ASSERT(prong != INVALID_SHORT_INDEX);
+	Host& host;
+};
 
-	if (prong < R_PRONG) {
-		lHalf.wideLoadRequested(registry, stream, prong);
-		rHalf.wideLoadResumable(registry, stream);
-	} else {
-		lHalf.wideLoadResumable(registry, stream);
-		rHalf.wideLoadRequested(registry, stream, prong);
-	}
-}
+////////////////////////////////////////////////////////////////////////////////
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template <typename T,
+		  typename TN,
+		  typename TA,
+		  ShortIndex NI,
+		  typename... TS>
+struct Accessor<T,		 OS_<TN, TA, NI, TS...>> {
+	using Host =		 OS_<TN, TA, NI, TS...>;
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename... TS>
-void
-CS_<TN, TA, SG, NI, TS...>::wideLoadResumable(Registry& registry,
-											  ReadStream& stream) const
-{
-	lHalf.wideLoadResumable(registry, stream);
-	rHalf.wideLoadResumable(registry, stream);
-}
+	HFSM_INLINE		  T& get()		 {
+		return Host::InitialStates::template contains<T>() ?
+			Accessor<T,		  typename Host::Initial  >{host.initial  }.get() :
+			Accessor<T,		  typename Host::Remaining>{host.remaining}.get();
+	}
 
-#endif
+	Host& host;
+};
 
-////////////////////////////////////////////////////////////////////////////////
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-}
-}
-namespace hfsm2 {
-namespace detail {
+template <typename T,
+		  typename TN,
+		  typename TA,
+		  ShortIndex NI,
+		  typename... TS>
+struct Accessor<T, const OS_<TN, TA, NI, TS...>> {
+	using Host =   const OS_<TN, TA, NI, TS...>;
 
-////////////////////////////////////////////////////////////////////////////////
+	HFSM_INLINE const T& get() const {
+		return Host::InitialStates::template contains<T>() ?
+			Accessor<T, const typename Host::Initial  >{host.initial  }.get() :
+			Accessor<T, const typename Host::Remaining>{host.remaining}.get();
+	}
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
-void
-CS_<TN, TA, SG, NI, T>::wideRegister(Registry& registry,
-									 const Parent parent)
-{
-	state.deepRegister(registry, Parent{parent.forkId, PRONG_INDEX});
-}
+	Host& host;
+};
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
-bool
-CS_<TN, TA, SG, NI, T>::wideForwardEntryGuard(GuardControl& control,
-											  const ShortIndex HFSM_IF_ASSERT(prong))
-{
-	HFSM_ASSERT(prong == PRONG_INDEX);
-
-	return state.deepForwardEntryGuard(control);
-}
+template <typename T,
+		  typename TN,
+		  typename TA,
+		  ShortIndex NI,
+		  typename TS>
+struct Accessor<T,		 OS_<TN, TA, NI, TS>> {
+	using Host =		 OS_<TN, TA, NI, TS>;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	HFSM_INLINE		  T& get()			{ return Accessor<T,	   typename Host::Initial>{host.initial  }.get();	}
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
-bool
-CS_<TN, TA, SG, NI, T>::wideEntryGuard(GuardControl& control,
-									   const ShortIndex HFSM_IF_ASSERT(prong))
-{
-	HFSM_ASSERT(prong == PRONG_INDEX);
+	Host& host;
+};
 
-	return state.deepEntryGuard(control);
-}
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-//------------------------------------------------------------------------------
+template <typename T,
+		  typename TN,
+		  typename TA,
+		  ShortIndex NI,
+		  typename TS>
+struct Accessor<T, const OS_<TN, TA, NI, TS>> {
+	using Host =   const OS_<TN, TA, NI, TS>;
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
-void
-CS_<TN, TA, SG, NI, T>::wideConstruct(PlanControl& control,
-									  const ShortIndex HFSM_IF_ASSERT(prong))
-{
-	HFSM_ASSERT(prong == PRONG_INDEX);
+	HFSM_INLINE const T& get() const	{ return Accessor<T, const typename Host::Initial>{host.initial  }.get();	}
 
-	state.deepConstruct(control);
-}
+	Host& host;
+};
 
-//------------------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
-void
-CS_<TN, TA, SG, NI, T>::wideEnter(PlanControl& control,
-								  const ShortIndex HFSM_IF_ASSERT(prong))
-{
-	HFSM_ASSERT(prong == PRONG_INDEX);
 
-	state.deepEnter(control);
-}
+////////////////////////////////////////////////////////////////////////////////
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+#ifdef __clang__
+	#pragma clang diagnostic push
+	#pragma clang diagnostic ignored "-Wnull-dereference"
+#endif
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
-void
-CS_<TN, TA, SG, NI, T>::wideReenter(PlanControl& control,
-									const ShortIndex HFSM_IF_ASSERT(prong))
-{
-	HFSM_ASSERT(prong == PRONG_INDEX);
+template <typename T,
+		  typename TN,
+		  typename TA,
+		  typename TH>
+struct Accessor<T,		 S_<TN, TA, TH>> {
+	using Host =		 S_<TN, TA, TH>;
 
-	state.deepReenter(control);
-}
+	HFSM_INLINE		  T& get()			{ HFSM_BREAK(); return *reinterpret_cast<T*>(0);	}
 
-//------------------------------------------------------------------------------
+	Host& host;
+};
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
-Status
-CS_<TN, TA, SG, NI, T>::wideUpdate(FullControl& control,
-								   const ShortIndex HFSM_IF_ASSERT(prong))
-{
-	HFSM_ASSERT(prong == PRONG_INDEX);
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	return state.deepUpdate(control);
-}
+template <typename T,
+		  typename TN,
+		  typename TA,
+		  typename TH>
+struct Accessor<T, const S_<TN, TA, TH>> {
+	using Host =   const S_<TN, TA, TH>;
 
-//------------------------------------------------------------------------------
+	HFSM_INLINE const T& get() const	{ HFSM_BREAK(); return *reinterpret_cast<T*>(0);	}
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
-template <typename TEvent>
-Status
-CS_<TN, TA, SG, NI, T>::wideReact(FullControl& control,
-								  const TEvent& event,
-								  const ShortIndex HFSM_IF_ASSERT(prong))
-{
-	HFSM_ASSERT(prong == PRONG_INDEX);
+	Host& host;
+};
 
-	return state.deepReact(control, event);
-}
+#ifdef __clang__
+	#pragma clang diagnostic pop
+#endif
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
-bool
-CS_<TN, TA, SG, NI, T>::wideForwardExitGuard(GuardControl& control,
-											 const ShortIndex HFSM_IF_ASSERT(prong))
-{
-	HFSM_ASSERT(prong == PRONG_INDEX);
+template <typename T,
+		  typename TN,
+		  typename TA>
+struct Accessor<T,		 S_<TN, TA,  T>> {
+	using Host =		 S_<TN, TA,  T>;
 
-	return state.deepForwardExitGuard(control);
-}
+	HFSM_INLINE		  T& get()			{ return host._headBox.get();			}
+
+	Host& host;
+};
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
-bool
-CS_<TN, TA, SG, NI, T>::wideExitGuard(GuardControl& control,
-									  const ShortIndex HFSM_IF_ASSERT(prong))
-{
-	HFSM_ASSERT(prong == PRONG_INDEX);
+template <typename T,
+		  typename TN,
+		  typename TA>
+struct Accessor<T, const S_<TN, TA,  T>> {
+	using Host =   const S_<TN, TA,  T>;
 
-	return state.deepExitGuard(control);
-}
+	HFSM_INLINE const T& get() const	{ return host._headBox.get();			}
 
-//------------------------------------------------------------------------------
+	Host& host;
+};
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
-void
-CS_<TN, TA, SG, NI, T>::wideExit(PlanControl& control,
-								 const ShortIndex HFSM_IF_ASSERT(prong))
-{
-	HFSM_ASSERT(prong == PRONG_INDEX);
+////////////////////////////////////////////////////////////////////////////////
 
-	state.deepExit(control);
+#endif
+
+}
 }
 
-//------------------------------------------------------------------------------
+namespace hfsm2 {
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
-void
-CS_<TN, TA, SG, NI, T>::wideDestruct(PlanControl& control,
-									 const ShortIndex HFSM_IF_ASSERT(prong))
-{
-	HFSM_ASSERT(prong == PRONG_INDEX);
+//------------------------------------------------------------------------------
 
-	state.deepDestruct(control);
-}
+// TL_ - logger policy, any type providing LoggerInterfaceT's member functions
+//  'void' selects LoggerInterfaceT<Context, Utility>
+//  Calls into a non-virtual policy are dispatched statically,
+//  EmptyLoggerT compiles down to nothing
+// NP  - transition payload size in bytes, used with HFSM_ENABLE_PAYLOADS
+// NA  - coroutine frame arena size in bytes, used with HFSM_ENABLE_COROUTINES
 
-//------------------------------------------------------------------------------
+template <typename TC_ = EmptyContext,
+		  typename TN_ = char,
+		  typename TU_ = float,
+		  typename TG_ = ::hfsm2::RandomT<TU_>,
+		  LongIndex NS = 4,
+		  LongIndex NT = INVALID_LONG_INDEX,
+		  typename TL_ = void,
+		  LongIndex NP = 16,
+		  LongIndex NA = 1024>
+struct ConfigT {
+	using Context = TC_;
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
-void
-CS_<TN, TA, SG, NI, T>::wideForwardActive(Control& control,
-										  const Request::Type request,
-										  const ShortIndex HFSM_IF_ASSERT(prong))
-{
-	HFSM_ASSERT(prong == PRONG_INDEX);
+	using Rank	  = TN_;
+	using Utility = TU_;
+	using RNG	  = TG_;
+	using Logger  = typename std::conditional<std::is_same<TL_, void>::value,
+											  LoggerInterfaceT<Context, Utility>,
+											  TL_>::type;
 
-	state.deepForwardActive(control, request);
-}
+	static constexpr LongIndex SUBSTITUTION_LIMIT = NS;
+	static constexpr LongIndex TASK_CAPACITY	  = NT;
+	static constexpr LongIndex PAYLOAD_SIZE		  = NP;
+	static constexpr LongIndex COROUTINE_ARENA_SIZE = NA;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	template <typename T>
+	using ContextT			 = ConfigT<  T, TN_, TU_, TG_, NS, NT, TL_, NP, NA>;
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
-void
-CS_<TN, TA, SG, NI, T>::wideForwardRequest(Control& control,
-										   const Request::Type request,
-										   const ShortIndex HFSM_IF_ASSERT(prong))
-{
-	HFSM_ASSERT(prong == PRONG_INDEX);
+	template <typename T>
+	using RankT				 = ConfigT<TC_,   T, TU_, TG_, NS, NT, TL_, NP, NA>;
 
-	state.deepForwardRequest(control, request);
-}
+	template <typename T>
+	using UtilityT			 = ConfigT<TC_, TN_,   T, TG_, NS, NT, TL_, NP, NA>;
 
-//------------------------------------------------------------------------------
+	template <typename T>
+	using RandomT			 = ConfigT<TC_, TN_, TU_,   T, NS, NT, TL_, NP, NA>;
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
-void
-CS_<TN, TA, SG, NI, T>::wideRequestChangeComposite(Control& control) {
-	state.deepRequestChange(control);
-}
+	template <LongIndex N>
+	using SubstitutionLimitN = ConfigT<TC_, TN_, TU_, TG_,  N, NT, TL_, NP, NA>;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	template <LongIndex N>
+	using TaskCapacityN		 = ConfigT<TC_, TN_, TU_, TG_, NS,  N, TL_, NP, NA>;
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
-void
-CS_<TN, TA, SG, NI, T>::wideRequestChangeResumable(Control& control,
-												   const ShortIndex HFSM_IF_ASSERT(prong))
-{
-	HFSM_ASSERT(prong == PRONG_INDEX);
+	template <typename T>
+	using LoggerT			 = ConfigT<TC_, TN_, TU_, TG_, NS, NT,   T, NP, NA>;
 
-	state.deepRequestChange(control);
-}
+	template <LongIndex N>
+	using PayloadSizeN		 = ConfigT<TC_, TN_, TU_, TG_, NS, NT, TL_,  N, NA>;
 
-//------------------------------------------------------------------------------
+	template <LongIndex N>
+	using CoroutineArenaN	 = ConfigT<TC_, TN_, TU_, TG_, NS, NT, TL_, NP,  N>;
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
-void
-CS_<TN, TA, SG, NI, T>::wideRequestRemain(Registry& registry) {
-	state.deepRequestRemain(registry);
-}
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	struct UP {
+		HFSM_INLINE UP(const Utility utility_  = Utility{1.0f},
+					   const ShortIndex prong_ = INVALID_SHORT_INDEX)
+			: utility{utility_}
+			, prong{prong_}
+		{}
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
-void
-CS_<TN, TA, SG, NI, T>::wideRequestRestart(Registry& registry) {
-	state.deepRequestRestart(registry);
-}
+		Utility utility;
+		ShortIndex prong;
+	};
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+};
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
-void
-CS_<TN, TA, SG, NI, T>::wideRequestResume(Registry& registry,
-										  const ShortIndex HFSM_IF_ASSERT(prong))
-{
-	HFSM_ASSERT(prong == PRONG_INDEX);
+//------------------------------------------------------------------------------
 
-	state.deepRequestResume(registry);
-}
+using Config = ConfigT<>;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+namespace detail {
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
-typename TA::UP
-CS_<TN, TA, SG, NI, T>::wideReportUtilize(Control& control) {
-	return state.deepReportUtilize(control);
-}
+////////////////////////////////////////////////////////////////////////////////
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template <typename TConfig>
+struct M_ {
+	using Config_ = TConfig;
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
-typename TA::Rank
-CS_<TN, TA, SG, NI, T>::wideReportRank(Control& control,
-									   Rank* const ranks)
-{
-	HFSM_ASSERT(ranks);
+	//----------------------------------------------------------------------
 
-	*ranks = state.deepReportRank(control);
+	template <typename THead, typename... TSubStates>
+	using Composite			 = CI_<Strategy::Composite,	   THead, TSubStates...>;
 
-	return *ranks;
-}
+	template <				  typename... TSubStates>
+	using CompositePeers	 = CI_<Strategy::Composite,    void,  TSubStates...>;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
-typename TA::Utility
-CS_<TN, TA, SG, NI, T>::wideReportRandomize(Control& control,
-											Utility* const options,
-											const Rank* const ranks,
-											const Rank top)
-{
-	HFSM_ASSERT(options && ranks);
+	template <typename THead, typename... TSubStates>
+	using Resumable			  = CI_<Strategy::Resumable,   THead, TSubStates...>;
 
-	*options = (*ranks == top) ?
-		state.deepReportRandomize(control) : Utility{0.0f};
+	template <				  typename... TSubStates>
+	using ResumablePeers	  = CI_<Strategy::Resumable,   void,  TSubStates...>;
 
-	return *options;
-}
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-//------------------------------------------------------------------------------
+	template <typename THead, typename... TSubStates>
+	using Utilitarian		  = CI_<Strategy::Utilitarian, THead, TSubStates...>;
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
-typename TA::UP
-CS_<TN, TA, SG, NI, T>::wideReportChangeComposite(Control& control) {
-	return state.deepReportChange(control);
-}
+	template <				  typename... TSubStates>
+	using UtilitarianPeers	  = CI_<Strategy::Utilitarian, void,  TSubStates...>;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
-typename TA::UP
-CS_<TN, TA, SG, NI, T>::wideReportChangeResumable(Control& control,
-												  const ShortIndex HFSM_IF_ASSERT(prong))
-{
-	HFSM_ASSERT(prong == PRONG_INDEX);
+	template <typename THead, typename... TSubStates>
+	using Random			  = CI_<Strategy::RandomUtil,  THead, TSubStates...>;
 
-	return state.deepReportChange(control);
-}
+	template <				  typename... TSubStates>
+	using RandomPeers		  = CI_<Strategy::RandomUtil,  void,  TSubStates...>;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
-typename TA::UP
-CS_<TN, TA, SG, NI, T>::wideReportChangeUtilitarian(Control& control) {
-	return state.deepReportChange(control);
-}
+	template <typename THead, typename... TSubStates>
+	using Orthogonal		  = OI_<Execution::Sequential, THead, TSubStates...>;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	template <				  typename... TSubStates>
+	using OrthogonalPeers	  = OI_<Execution::Sequential, void,  TSubStates...>;
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
-typename TA::Utility
-CS_<TN, TA, SG, NI, T>::wideReportChangeRandom(Control& control,
-											   Utility* const options,
-											   const Rank* const ranks,
-											   const Rank top)
-{
-	HFSM_ASSERT(options && ranks);
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	*options = (*ranks == top) ?
-		state.deepReportChange(control).utility : Utility{0.0f};
+	// Sub-states update() and react() on the executor attached with R_::attachExecutor(),
+	//  see ExecutorInterface for the rules they have to follow
+	template <typename THead, typename... TSubStates>
+	using ParallelOrthogonal  = OI_<Execution::Parallel,   THead, TSubStates...>;
 
-	return *options;
-}
+	template <				  typename... TSubStates>
+	using ParallelOrthogonalPeers = OI_<Execution::Parallel, void, TSubStates...>;
 
-//------------------------------------------------------------------------------
+	//----------------------------------------------------------------------
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
-void
-CS_<TN, TA, SG, NI, T>::wideChangeToRequested(PlanControl& control,
-											  const ShortIndex HFSM_IF_ASSERT(prong))
-{
-	HFSM_ASSERT(prong == PRONG_INDEX);
+	template <typename THead, typename... TSubStates>
+	using Root				  = RF_<Config_, Composite  <THead, TSubStates...>>;
 
-	state.deepChangeToRequested(control);
-}
+	template <				  typename... TSubStates>
+	using PeerRoot			  = RF_<Config_, CompositePeers  <  TSubStates...>>;
 
-//------------------------------------------------------------------------------
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-#ifdef HFSM_ENABLE_STRUCTURE_REPORT
+	template <typename THead, typename... TSubStates>
+	using ResumableRoot		  = RF_<Config_, Resumable  <THead, TSubStates...>>;
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
-void
-CS_<TN, TA, SG, NI, T>::wideGetNames(const LongIndex parent,
-									 const RegionType /*region*/,
-									 const ShortIndex depth,
-									 StructureStateInfos& _stateInfos) const
-{
-	state.deepGetNames(parent, StructureStateInfo::COMPOSITE, depth, _stateInfos);
-}
+	template <				  typename... TSubStates>
+	using ResumablePeerRoot	  = RF_<Config_, ResumablePeers  <  TSubStates...>>;
 
-#endif
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-//------------------------------------------------------------------------------
+	template <typename THead, typename... TSubStates>
+	using UtilitarianRoot	  = RF_<Config_, Utilitarian<THead, TSubStates...>>;
 
-#ifdef HFSM_ENABLE_SERIALIZATION
+	template <				  typename... TSubStates>
+	using UtilitarianPeerRoot = RF_<Config_, UtilitarianPeers<  TSubStates...>>;
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
-void
-CS_<TN, TA, SG, NI, T>::wideSaveActive(const Registry& registry,
-									   WriteStream& stream,
-									   const ShortIndex HFSM_IF_ASSERT(prong)) const
-{
-	HFSM_ASSERT(prong == PRONG_INDEX);
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	state.deepSaveActive(registry, stream);
-}
+	template <typename THead, typename... TSubStates>
+	using RandomRoot		  = RF_<Config_, Random		<THead, TSubStates...>>;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	template <				  typename... TSubStates>
+	using RandomPeerRoot	  = RF_<Config_, RandomPeers	 <  TSubStates...>>;
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
-void
-CS_<TN, TA, SG, NI, T>::wideSaveResumable(const Registry& registry,
-										  WriteStream& stream) const
-{
-	state.deepSaveResumable(registry, stream);
-}
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	template <typename THead, typename... TSubStates>
+	using OrthogonalRoot	  = RF_<Config_, Orthogonal <THead, TSubStates...>>;
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
-void
-CS_<TN, TA, SG, NI, T>::wideLoadRequested(Registry& registry,
-										  ReadStream& stream,
-										  const ShortIndex HFSM_IF_ASSERT(prong)) const
-{
-	HFSM_ASSERT(prong == PRONG_INDEX);
+	template <				  typename... TSubStates>
+	using OrthogonalPeerRoot  = RF_<Config_, OrthogonalPeers <  TSubStates...>>;
 
-	state.deepLoadRequested(registry, stream);
-}
+	//----------------------------------------------------------------------
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	// Hierarchy described at run time with Runtime<>::Layout, see RuntimeLayoutT
+	//  NStates, NCompo, NOrtho - capacity in states, composite and orthogonal regions
+	//  NUnits - orthogonal prong bit bytes, one per 8 prongs of each orthogonal region
+	template <LongIndex NStates,
+			  ShortIndex NCompo,
+			  ShortIndex NOrtho = 0,
+			  ShortIndex NUnits = NOrtho>
+	using Runtime			  = RuntimeF_<Config_, NStates, NCompo, NOrtho, NUnits>;
+
+	//----------------------------------------------------------------------
+};
+
+////////////////////////////////////////////////////////////////////////////////
 
-template <typename TN, typename TA, Strategy SG, ShortIndex NI, typename T>
-void
-CS_<TN, TA, SG, NI, T>::wideLoadResumable(Registry& registry,
-										  ReadStream& stream) const
-{
-	state.deepLoadResumable(registry, stream);
 }
 
-#endif
+using Machine = detail::M_<Config>;
+
+template <typename TConfig>
+using MachineT = detail::M_<TConfig>;
 
 ////////////////////////////////////////////////////////////////////////////////
 
 }
-}
+
 namespace hfsm2 {
 namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename TIndices,
-		  typename TArgs,
-		  Strategy TStrategy,
-		  typename THead,
-		  typename... TSubStates>
-struct C_ final {
-	using Indices		= TIndices;
-	static constexpr StateID	HEAD_ID		= Indices::STATE_ID;
-	static constexpr ShortIndex COMPO_INDEX	= Indices::COMPO_INDEX;
-	static constexpr ShortIndex ORTHO_INDEX	= Indices::ORTHO_INDEX;
-	static constexpr ShortIndex ORTHO_UNIT	= Indices::ORTHO_UNIT;
+template <typename TConfig,
+		  typename TApex>
+class R_ {
+	using Config_				= TConfig;
+	using Context				= typename Config_::Context;
+	using Rank					= typename Config_::Rank;
+	using Utility				= typename Config_::Utility;
+	using RNG					= typename Config_::RNG;
+	using Logger				= typename Config_::Logger;
 
-	static constexpr Strategy	STRATEGY	= TStrategy;
+	using Apex					= TApex;
+	using ApexInfo				= WrapInfo<Apex>;
 
-	static constexpr ShortIndex REGION_ID	= COMPO_INDEX + ORTHO_INDEX;
-	static constexpr ForkID		COMPO_ID	= COMPO_INDEX + 1;
+	using Info					= RF_<Config_, Apex>;
+	using StateList				= typename Info::StateList;
+	using RegionList			= typename Info::RegionList;
 
-	using Args			= TArgs;
-	using Rank			= typename Args::Rank;
-	using Utility		= typename Args::Utility;
-	using UP			= typename Args::UP;
-	using StateList		= typename Args::StateList;
-	using RegionList	= typename Args::RegionList;
+	static constexpr LongIndex SUBSTITUTION_LIMIT = Info::SUBSTITUTION_LIMIT;
+	static constexpr LongIndex TASK_CAPACITY	  = Info::TASK_CAPACITY;
 
-	using Registry		= RegistryT<Args>;
-	using StateParents	= typename Registry::StateParents;
+public:
+	static constexpr LongIndex  REVERSE_DEPTH	  = ApexInfo::REVERSE_DEPTH;
+	static constexpr ShortIndex COMPO_REGIONS	  = ApexInfo::COMPO_REGIONS;
+	static constexpr LongIndex  COMPO_PRONGS	  = ApexInfo::COMPO_PRONGS;
+	static constexpr ShortIndex ORTHO_REGIONS	  = ApexInfo::ORTHO_REGIONS;
+	static constexpr ShortIndex ORTHO_UNITS		  = ApexInfo::ORTHO_UNITS;
 
-	using Control		= ControlT<Args>;
+	static constexpr LongIndex  ACTIVE_BITS		  = ApexInfo::ACTIVE_BITS;
+	static constexpr LongIndex  RESUMABLE_BITS	  = ApexInfo::RESUMABLE_BITS;
 
-	using PlanControl	= PlanControlT<Args>;
-	using ScopedOrigin	= typename PlanControl::Origin;
-	using ScopedRegion	= typename PlanControl::Region;
-	using Plan			= PlanT<Args>;
+	static constexpr LongIndex  STATE_COUNT		  = ApexInfo::STATE_COUNT;
+	static constexpr LongIndex  REGION_COUNT	  = ApexInfo::REGION_COUNT;
 
-	using FullControl	= FullControlT<Args>;
-	using ControlLock	= typename FullControl::Lock;
+	static_assert(STATE_COUNT <  (ShortIndex) -1, "Too many states in the hierarchy. Change 'ShortIndex' type.");
+	static_assert(STATE_COUNT == (ShortIndex) StateList::SIZE, "STATE_COUNT != StateList::SIZE");
 
-	using GuardControl	= GuardControlT<Args>;
+private:
+	using Args					= typename Info::Args;
 
-	using Head			= THead;
+	using Registry				= RegistryT<Args>;
+	using CompoForks			= typename Registry::CompoForks;
+	using RegistryBackUp		= typename Registry::BackUp;
 
-	using HeadState		= S_<Indices, Args, Head>;
+	using MaterialApex			= Material<I_<0, 0, 0, 0>, Args, Apex>;
 
-	using SubStates		= CS_<I_<HEAD_ID + 1,
-								 COMPO_INDEX + 1,
-								 ORTHO_INDEX,
-								 ORTHO_UNIT>,
-							  Args,
-							  STRATEGY,
-							  0,
-							  TSubStates...>;
+	using Control				= ControlT<Args>;
 
-	using Info			= CI_<STRATEGY, Head, TSubStates...>;
-	static constexpr ShortIndex WIDTH		= Info::WIDTH;
-	static constexpr ShortIndex WIDTH_BITS	= Info::WIDTH_BITS;
-	static constexpr ShortIndex STATE_COUNT	= Info::STATE_COUNT;
+	using PlanControl			= PlanControlT<Args>;
+	using PlanData				= PlanDataT   <Args>;
 
-	//----------------------------------------------------------------------
+	using FullControl			= FullControlT<Args>;
+	using Requests				= typename FullControl::Requests;
 
-#ifdef HFSM_EXPLICIT_MEMBER_SPECIALIZATION
-	template <typename T>
-	struct Accessor {
-		HFSM_INLINE static		 T&	   get(		 C_& c)								{ return c._subStates.template access<T>();		}
-		HFSM_INLINE static const T&	   get(const C_& c)								{ return c._subStates.template access<T>();		}
-	};
+	using GuardControl			= GuardControlT<Args>;
 
-	template <>
-	struct Accessor<Head> {
-		HFSM_INLINE static		 Head& get(		 C_& c)								{ return c._headState._headBox.get();			}
-		HFSM_INLINE static const Head& get(const C_& c)								{ return c._headState._headBox.get();			}
-	};
+#ifdef HFSM_ENABLE_STRUCTURE_REPORT
+	static constexpr LongIndex NAME_COUNT	  = MaterialApex::NAME_COUNT;
 
-	template <typename T>
-	HFSM_INLINE		  T&	access()												{ return Accessor<T>::get(*this);				}
+	using Prefix				= StaticArray<wchar_t, REVERSE_DEPTH * 2 + 2>;
+	using Prefixes				= StaticArray<Prefix, STATE_COUNT>;
 
-	template <typename T>
-	HFSM_INLINE const T&	access() const											{ return Accessor<T>::get(*this);				}
+	using StructureStateInfos	= typename Args::StructureStateInfos;
 #endif
 
-	//----------------------------------------------------------------------
+#ifdef HFSM_ENABLE_SERIALIZATION
+	using WriteStream			= typename Args::WriteStream;
+	using ReadStream			= typename Args::ReadStream;
+#endif
 
-	HFSM_INLINE		  ShortIndex& compoRequested(	   Registry& registry) const	{ return registry.compoRequested[COMPO_INDEX];	}
-	HFSM_INLINE const ShortIndex& compoRequested(const Registry& registry) const	{ return registry.compoRequested[COMPO_INDEX];	}
+public:
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	HFSM_INLINE		  ShortIndex& compoActive   (	   Registry& registry) const	{ return registry.compoActive	[COMPO_INDEX];	}
-	HFSM_INLINE const ShortIndex& compoActive   (const Registry& registry) const	{ return registry.compoActive	[COMPO_INDEX];	}
+#ifdef HFSM_ENABLE_STRUCTURE_REPORT
+	using Structure				= Array<StructureEntry, NAME_COUNT>;
+	using ActivityHistory		= Array<char,			NAME_COUNT>;
+#endif
 
-	HFSM_INLINE		  ShortIndex& compoResumable(	   Registry& registry) const	{ return registry.compoResumable[COMPO_INDEX];	}
-	HFSM_INLINE const ShortIndex& compoResumable(const Registry& registry) const	{ return registry.compoResumable[COMPO_INDEX];	}
+	HFSM_IF_PROFILER(using Profiler = typename Args::Profiler);
+	HFSM_IF_STATISTICS(using Statistics = typename Args::Statistics);
+	HFSM_IF_TIMERS(using Timers = typename Args::Timers);
 
-	HFSM_INLINE		  ShortIndex& compoRequested(	   Control& control) const		{ return compoRequested(control._registry);		}
-	HFSM_INLINE const ShortIndex& compoRequested(const Control& control) const		{ return compoRequested(control._registry);		}
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	HFSM_INLINE		  ShortIndex& compoActive   (	   Control& control) const		{ return compoActive   (control._registry);		}
-	HFSM_INLINE const ShortIndex& compoActive   (const Control& control) const		{ return compoActive   (control._registry);		}
+public:
+	explicit R_(Context& context,
+				RNG& rng
+				HFSM_IF_LOGGER(, Logger* const logger = nullptr));
 
-	HFSM_INLINE		  ShortIndex& compoResumable(	   Control& control) const		{ return compoResumable(control._registry);		}
-	HFSM_INLINE const ShortIndex& compoResumable(const Control& control) const		{ return compoResumable(control._registry);		}
+	~R_();
 
-	HFSM_INLINE		  ShortIndex  resolveRandom (Control& control,
-												 const Utility(& options)[Info::WIDTH], const Utility sum,
-												 const Rank	  (& ranks)  [Info::WIDTH], const Rank	  top) const;
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	HFSM_INLINE bool	compoRemain					  (Control& control)	{ return control._registry.compoRemains.template get<COMPO_INDEX>(); }
+	template <typename T>
+	static constexpr StateID  stateId()				{ return			StateList ::template index<T>();	}
 
-	HFSM_INLINE void	deepRegister				  (Registry& registry, const Parent parent);
+	template <typename T>
+	static constexpr RegionID regionId()			{ return (RegionID) RegionList::template index<T>();	}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	//----------------------------------------------------------------------
 
-	HFSM_INLINE bool	deepForwardEntryGuard		  (GuardControl& control);
-	HFSM_INLINE bool	deepEntryGuard				  (GuardControl& control);
+#ifdef HFSM_EXPLICIT_MEMBER_SPECIALIZATION
 
-	HFSM_INLINE void	deepConstruct				  (PlanControl& control);
+#ifdef _MSC_VER
+	#pragma warning(push)
+	#pragma warning(disable: 4348) // redefinition of default parameter: parameter 2
+#endif
 
-	HFSM_INLINE void	deepEnter					  (PlanControl&  control);
-	HFSM_INLINE void	deepReenter					  (PlanControl&  control);
+	template <typename T, bool = StateList::template contains<T>()>
+	struct Accessor;
 
-	HFSM_INLINE Status	deepUpdate					  (FullControl&  control);
+#ifdef _MSC_VER
+	#pragma warning(pop)
+#endif
 
-	template <typename TEvent>
-	HFSM_INLINE Status	deepReact					  (FullControl&  control, const TEvent& event);
+	template <typename T>
+	struct Accessor<T, true> {
+		HFSM_INLINE static		 T& get(	  MaterialApex& apex)	{ return apex.template access<T>();		}
+		HFSM_INLINE static const T& get(const MaterialApex& apex)	{ return apex.template access<T>();		}
+	};
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	HFSM_INLINE bool	deepForwardExitGuard		  (GuardControl& control);
-	HFSM_INLINE bool	deepExitGuard				  (GuardControl& control);
+	// if you see..
+	// VS	 - error C2027: use of undefined type 'hfsm2::detail::R_<..>::Accessor<T,false>'
+	// Clang - error : implicit instantiation of undefined template 'hfsm2::detail::R_<..>::Accessor<*, false>'
+	//
+	// .. you're trying to access() a type that is not present in the state machine hierarchy
 
-	HFSM_INLINE void	deepExit					  (PlanControl&  control);
+	template <typename T>
+	HFSM_INLINE		  T& access()									{ return Accessor<T>::get(_apex);		}
 
-	HFSM_INLINE void	deepDestruct				  (PlanControl&  control);
+	template <typename T>
+	HFSM_INLINE const T& access() const								{ return Accessor<T>::get(_apex);		}
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	HFSM_INLINE void	deepForwardActive			  (Control& control, const Request::Type request);
-	HFSM_INLINE void	deepForwardRequest			  (Control& control, const Request::Type request);
+#else
 
-	HFSM_INLINE void	deepRequest					  (Control& control, const Request::Type request);
+	template <typename T>
+	HFSM_INLINE		  T& access()					{ return Accessor<T,	   MaterialApex>{_apex}.get();	}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	template <typename T>
+	HFSM_INLINE const T& access() const				{ return Accessor<T, const MaterialApex>{_apex}.get();	}
 
-#ifdef HFSM_EXPLICIT_MEMBER_SPECIALIZATION
+#endif
 
-	template <Strategy = STRATEGY>
-	HFSM_INLINE void	deepRequestChange			  (Control& control, const ShortIndex = INVALID_SHORT_INDEX);
+	//----------------------------------------------------------------------
 
-	template <>
-	HFSM_INLINE void	deepRequestChange<Composite>  (Control& control, const ShortIndex)	{ deepRequestChangeComposite  (control); }
+	void update();
 
-	template <>
-	HFSM_INLINE void	deepRequestChange<Resumable>  (Control& control, const ShortIndex)	{ deepRequestChangeResumable  (control); }
+	template <typename TEvent>
+	HFSM_INLINE void react(const TEvent& event);
 
-	template <>
-	HFSM_INLINE void	deepRequestChange<Utilitarian>(Control& control, const ShortIndex)	{ deepRequestChangeUtilitarian(control); }
+	// Same as react() on every event in turn, transitions requested while reacting
+	//  to an event are processed before the next one is dispatched
+	//  The control is built once for the whole batch
+	template <typename TEvent>
+	HFSM_INLINE void reactBatch(const TEvent* const events,
+								const size_t count);
 
-	template <>
-	HFSM_INLINE void	deepRequestChange<RandomUtil> (Control& control, const ShortIndex)	{ deepRequestChangeRandom	  (control); }
+	template <LongIndex NCapacity, typename... TEvents>
+	HFSM_INLINE void reactBatch(const EventBufferT<NCapacity, TEvents...>& buffer);
 
-#else
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	HFSM_INLINE void	deepRequestChange			  (Control& control);
+	HFSM_INLINE bool isActive   (const StateID stateId) const	{ return _registry.isActive   (stateId);	}
+	HFSM_INLINE bool isResumable(const StateID stateId) const	{ return _registry.isResumable(stateId);	}
 
-#endif
+	HFSM_INLINE bool isScheduled(const StateID stateId) const	{ return isResumable(stateId);				}
 
-	HFSM_INLINE void	deepRequestChangeComposite	  (Control& control);
-	HFSM_INLINE void	deepRequestChangeResumable	  (Control& control);
-	HFSM_INLINE void	deepRequestChangeUtilitarian  (Control& control);
-	HFSM_INLINE void	deepRequestChangeRandom		  (Control& control);
+	template <typename TState>
+	HFSM_INLINE bool isActive   () const						{ return isActive	(stateId<TState>());	}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	template <typename TState>
+	HFSM_INLINE bool isResumable() const						{ return isResumable(stateId<TState>());	}
 
-	HFSM_INLINE void	deepRequestRemain			  (Registry& registry);
-	HFSM_INLINE void	deepRequestRestart			  (Registry& registry);
-	HFSM_INLINE void	deepRequestResume			  (Registry& registry);
-	HFSM_INLINE void	deepRequestUtilize			  (Control& control);
-	HFSM_INLINE void	deepRequestRandomize		  (Control& control);
+	template <typename TState>
+	HFSM_INLINE bool isScheduled() const						{ return isResumable<TState>();				}
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-#ifdef HFSM_EXPLICIT_MEMBER_SPECIALIZATION
-
-	template <Strategy = STRATEGY>
-	HFSM_INLINE UP		deepReportChange			  (Control& control);
-
-	template <>
-	HFSM_INLINE UP		deepReportChange<Composite>   (Control& control)	{ return deepReportChangeComposite  (control); }
+	HFSM_INLINE void changeTo (const StateID stateId);
+	HFSM_INLINE void restart  (const StateID stateId);
+	HFSM_INLINE void resume	  (const StateID stateId);
+	HFSM_INLINE void utilize  (const StateID stateId);
+	HFSM_INLINE void randomize(const StateID stateId);
+	HFSM_INLINE void schedule (const StateID stateId);
 
-	template <>
-	HFSM_INLINE UP		deepReportChange<Resumable>   (Control& control)	{ return deepReportChangeResumable  (control); }
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	template <>
-	HFSM_INLINE UP		deepReportChange<Utilitarian> (Control& control)	{ return deepReportChangeUtilitarian(control); }
+	template <typename TState>
+	HFSM_INLINE void changeTo ()								{ changeTo (stateId<TState>());				}
 
-	template <>
-	HFSM_INLINE UP		deepReportChange<RandomUtil>  (Control& control)	{ return deepReportChangeRandom		(control); }
+	template <typename TState>
+	HFSM_INLINE void restart  ()								{ restart  (stateId<TState>());				}
 
-#else
+	template <typename TState>
+	HFSM_INLINE void resume	  ()								{ resume   (stateId<TState>());				}
 
-	HFSM_INLINE UP		deepReportChange			  (Control& control);
+	template <typename TState>
+	HFSM_INLINE void utilize  ()								{ utilize  (stateId<TState>());				}
 
-#endif
+	template <typename TState>
+	HFSM_INLINE void randomize()								{ randomize(stateId<TState>());				}
 
-	HFSM_INLINE UP		deepReportChangeComposite	  (Control& control);
-	HFSM_INLINE UP		deepReportChangeResumable	  (Control& control);
-	HFSM_INLINE UP		deepReportChangeUtilitarian   (Control& control);
-	HFSM_INLINE UP		deepReportChangeRandom		  (Control& control);
+	template <typename TState>
+	HFSM_INLINE void schedule ()								{ schedule (stateId<TState>());				}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+#ifdef HFSM_ENABLE_PAYLOADS
+	// With all payload slots taken, asserts and doesn't request the transition
+	template <typename TPayload>
+	HFSM_INLINE void changeTo (const StateID stateId, const TPayload& payload);
 
-	HFSM_INLINE UP		deepReportUtilize			  (Control& control);
-	HFSM_INLINE Rank	deepReportRank				  (Control& control);
-	HFSM_INLINE Utility	deepReportRandomize			  (Control& control);
+	template <typename TState, typename TPayload>
+	HFSM_INLINE void changeTo (const TPayload& payload)		{ changeTo (stateId<TState>(), payload);	}
+#endif
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	HFSM_INLINE void	deepChangeToRequested		  (PlanControl& control);
+#ifdef HFSM_ENABLE_STRUCTURE_REPORT
+	// Fill 'entries' with names and prefixes shared by all instances of the machine type,
+	//  and the activity of this instance as of the last refresh
+	void structure(Structure& entries) const;
 
-	//----------------------------------------------------------------------
+	// Consecutive refreshes each state stayed active (positive) or inactive (negative) for,
+	//  counted lazily from the refresh at which the state last changed
+	const ActivityHistory& activityHistory() const;
+#endif
 
-#ifdef HFSM_ENABLE_STRUCTURE_REPORT
-	using StructureStateInfos = typename Args::StructureStateInfos;
-	using RegionType		  = typename StructureStateInfo::RegionType;
+#ifdef HFSM_ENABLE_TRANSITION_HISTORY
+	using TransitionHistory		= Array<Transition, COMPO_REGIONS * 4>;
 
-	static constexpr LongIndex NAME_COUNT = HeadState::NAME_COUNT + SubStates::NAME_COUNT;
+	// Transitions made by the last update() / react() / reactBatch(), empty if there were none
+	//  Holds up to 'COMPO_REGIONS * 4' transitions, asserts on more
+	const TransitionHistory& transitionHistory() const			{ return _transitionHistory;				}
 
-	void deepGetNames(const LongIndex parent,
-					  const RegionType region,
-					  const ShortIndex depth,
-					  StructureStateInfos& stateInfos) const;
+	void replayTransition (const Transition& transition)		{ replayTransitions(&transition, 1);		}
+	void replayTransitions(const Transition* const transitions, const uint64_t count);
 #endif
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	void reset();
 
-#ifdef HFSM_ENABLE_SERIALIZATION
-	using WriteStream	= typename Args::WriteStream;
-	using ReadStream	= typename Args::ReadStream;
+	// Check if update() has anything to do: pending requests, plans, armed timers,
+	//  coroutine tasks waiting for ticks or active states overriding update()
+	//  Machines reporting false can be skipped by update() until they get an event or a request
+	bool needsUpdate() const;
 
-	HFSM_INLINE void	deepSaveActive	 (const Registry& registry, WriteStream& stream) const;
-	HFSM_INLINE void	deepSaveResumable(const Registry& registry, WriteStream& stream) const;
+	// Bumped every time the set of active states may have changed,
+	//  lets observers skip re-scanning isActive() between transitions
+	HFSM_INLINE uint32_t activityEpoch() const					{ return _activityEpoch;					}
 
-	HFSM_INLINE void	deepLoadRequested(		Registry& registry, ReadStream&  stream) const;
-	HFSM_INLINE void	deepLoadResumable(		Registry& registry, ReadStream&  stream) const;
+#ifdef HFSM_ENABLE_POOL_INDEX
+	using ActivityChanges		= ActivityChangesT<STATE_COUNT>;
+
+	// States entered or exited since the last clearActivityChanges(), used by PoolT's state index
+	HFSM_INLINE const ActivityChanges& activityChanges() const	{ return _planData.indexChanges;			}
+	HFSM_INLINE void clearActivityChanges()						{ _planData.indexChanges.clear();			}
 #endif
 
-	//----------------------------------------------------------------------
+#ifdef HFSM_ENABLE_UPDATE_PERIODS
+	// Update the region only on every 'period'-th update() while it's active
+	//  'phase' delays the first update within the period,
+	//  stagger it across instances to spread the load over ticks
+	//  react() and transitions are not affected
+	void setUpdatePeriod(const RegionID regionId,
+						 const uint16_t period,
+						 const uint16_t phase = 0)				{ _planData.updatePeriods.set(regionId, period, phase);	}
 
-	HeadState _headState;
-	SubStates _subStates;
+	template <typename TRegion>
+	void setUpdatePeriod(const uint16_t period,
+						 const uint16_t phase = 0)				{ setUpdatePeriod(regionId<TRegion>(), period, phase);	}
+#endif
 
-	HFSM_IF_DEBUG(static constexpr Info _info = Info{});
-};
+#ifdef HFSM_ENABLE_PLAN_QUOTAS
+	// Reserve plan tasks for the region and cap it at that many,
+	//  INVALID_LONG_INDEX lifts the cap and the reservation
+	//  Quotas of all regions can't add up to more than the task capacity
+	void setPlanQuota(const RegionID regionId,
+					  const LongIndex quota)					{ _planData.planQuotas.setQuota(regionId, quota);		}
 
-////////////////////////////////////////////////////////////////////////////////
+	template <typename TRegion>
+	void setPlanQuota(const LongIndex quota)					{ setPlanQuota(regionId<TRegion>(), quota);				}
 
-}
-}
+	const PlanUsage& planUsage(const RegionID regionId) const	{ return _planData.planQuotas.regions[regionId];		}
 
-namespace hfsm2 {
-namespace detail {
+	template <typename TRegion>
+	const PlanUsage& planUsage() const							{ return planUsage(regionId<TRegion>());				}
 
-////////////////////////////////////////////////////////////////////////////////
+	// Largest number of task links in use at once, across all regions
+	LongIndex planHighWater() const								{ return _planData.planQuotas.highWater;				}
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
-ShortIndex
-C_<TN, TA, SG, TH, TS...>::resolveRandom(Control& control,
-										 const Utility(& options)[Info::WIDTH],
-										 const Utility sum,
-										 const Rank(& ranks)[Info::WIDTH],
-										 const Rank top) const
-{
-	const Utility random = control._rng.next();
-	HFSM_ASSERT(0.0f <= random && random < 1.0f);
+	void resetPlanHighWater()									{ _planData.planQuotas.resetHighWater();				}
+#endif
 
-	Utility cursor = random * sum;
+#ifdef HFSM_ENABLE_SERIALIZATION
+	// Buffer for serialization
+	//  Members:
+	//   bitSize - Number of payload bits used
+	//   payload - Serialized data
+	//  See https://doc.hfsm.dev/user-guide/debugging-and-tools/serialization
+	using SerialBuffer			= typename Args::SerialBuffer;
 
-	for (ShortIndex i = 0; i < count(ranks); ++i)
-		if (ranks[i] == top) {
-			HFSM_ASSERT(options[i] >= 0.0f);
+	// Serialize the structural configuration into 'buffer'
+	void save(		SerialBuffer& buffer) const;
 
-			if (cursor >= options[i])
-				cursor -= options[i];
-			else {
-				HFSM_LOG_RANDOM_RESOLUTION(control.context(), HEAD_ID, i, random);
+	// De-serialize the configuration and initialize the instance
+	void load(const SerialBuffer& buffer);
+#endif
 
-				return i;
-			}
-		}
+#if defined HFSM_ENABLE_LOG_INTERFACE || defined HFSM_ENABLE_VERBOSE_DEBUG_LOG
+	void attachLogger(Logger* const logger)						{ _logger = logger;							}
+#endif
 
-	HFSM_BREAK();
-	return INVALID_SHORT_INDEX;
-}
+#ifdef HFSM_ENABLE_PROFILER
+	// Time state method calls into 'profiler', nullptr to stop
+	void attachProfiler(Profiler* const profiler)				{ _profiler = profiler;						}
+#endif
 
-//------------------------------------------------------------------------------
+#ifdef HFSM_ENABLE_STATISTICS
+	// Count transitions and state activity into 'statistics', nullptr to stop
+	void attachStatistics(Statistics* const statistics);
+#endif
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
-void
-C_<TN, TA, SG, TH, TS...>::deepRegister(Registry& registry,
-										const Parent parent)
-{
-	registry.compoParents[COMPO_INDEX] = parent;
+#ifdef HFSM_ENABLE_PARALLEL
+	// Run ParallelOrthogonal<> sub-states on 'executor', nullptr to run them in sequence
+	void attachExecutor(ExecutorInterface* const executor)		{ _planData.executor = executor;			}
+#endif
 
-	_headState.deepRegister(registry, parent);
-	_subStates.wideRegister(registry, Parent{COMPO_ID});
-}
+#ifdef HFSM_ENABLE_WATCHDOG
+	// Substitution round and oscillation counters, see WatchdogReport for details
+	const WatchdogReport& watchdogReport() const				{ return _watchdog.report();				}
 
-//------------------------------------------------------------------------------
+	void resetWatchdog()										{ _watchdog.reset();						}
+#endif
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
-bool
-C_<TN, TA, SG, TH, TS...>::deepForwardEntryGuard(GuardControl& control) {
-	const ShortIndex active	   = compoActive   (control);
-	const ShortIndex requested = compoRequested(control);
+#ifdef HFSM_ENABLE_TRANSITION_TRACE
+	// Record processed transitions into 'trace', tagged with 'instance'
+	//  See TransitionTrace for details
+	void attachTrace(TransitionTrace* const trace,
+					 const uint16_t instance = 0)				{ _trace = trace; _traceInstance = instance;	}
 
-	HFSM_ASSERT(active != INVALID_SHORT_INDEX);
+	// Number of update() / react() calls, used as the trace timestamp
+	uint32_t tick() const										{ return _tick;								}
+#endif
 
-	ScopedRegion region{control, REGION_ID, HEAD_ID, STATE_COUNT};
+private:
+	struct BatchVisitor {
+		template <typename TEvent>
+		HFSM_INLINE void operator() (const TEvent& event)		{ root.dispatch(control, event);			}
 
-	if (requested == INVALID_SHORT_INDEX)
-		return _subStates.wideForwardEntryGuard(control, active);
-	else
-		return _subStates.wideEntryGuard	   (control, requested);
-}
+		R_& root;
+		FullControl& control;
+	};
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
-bool
-C_<TN, TA, SG, TH, TS...>::deepEntryGuard(GuardControl& control) {
-	const ShortIndex requested = compoRequested(control);
-	HFSM_ASSERT(requested != INVALID_SHORT_INDEX);
+	void initialEnter();
+	void processTransitions();
 
-	ScopedRegion region{control, REGION_ID, HEAD_ID, STATE_COUNT};
+	template <typename TEvent>
+	HFSM_INLINE void dispatch(FullControl& control, const TEvent& event);
 
-	return _headState.deepEntryGuard(control) ||
-		   _subStates.wideEntryGuard(control, requested);
-}
+	bool applyRequest (Control& control, const Request& request);
+	bool applyRequests(Control& control);
 
-//------------------------------------------------------------------------------
+#ifdef HFSM_ENABLE_TRANSITION_HISTORY
+	bool applyRequests(Control& control,
+					   const Transition* const transitions,
+					   const uint64_t count);
+#endif
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
-void
-C_<TN, TA, SG, TH, TS...>::deepConstruct(PlanControl& control) {
-	ShortIndex& active	  = compoActive   (control);
-	ShortIndex& resumable = compoResumable(control);
-	ShortIndex& requested = compoRequested(control);
+	bool cancelledByEntryGuards(const Requests& pendingChanges);
+	bool cancelledByGuards(const Requests& pendingChanges);
 
-	HFSM_ASSERT(active	  == INVALID_SHORT_INDEX);
-	HFSM_ASSERT(requested != INVALID_SHORT_INDEX);
+#ifdef HFSM_ENABLE_STRUCTURE_REPORT
+	// Built once per machine type, on the first instance construction
+	struct StructureReport {
+		StructureReport(const MaterialApex& apex);
 
-	active	  = requested;
+		StructureStateInfos stateInfos;
+		Prefixes prefixes;
 
-	if (requested == resumable)
-		resumable = INVALID_SHORT_INDEX;
+		Structure structure;
+		LongIndex entries[STATE_COUNT];			// 'structure' entry of each state, INVALID_LONG_INDEX if unnamed
+	};
+
+	static const StructureReport& structureReport(const MaterialApex& apex);
 
-	requested = INVALID_SHORT_INDEX;
+	void udpateActivity();
+#endif
 
-	_headState.deepConstruct(control);
-	_subStates.wideConstruct(control, active);
-}
+	HFSM_IF_TRANSITION_HISTORY(void recordRequestsAs(const Method method));
 
-//------------------------------------------------------------------------------
+	HFSM_IF_TRANSITION_TRACE(void traceRequests(const Requests& requests, const Method method));
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
-void
-C_<TN, TA, SG, TH, TS...>::deepEnter(PlanControl& control) {
-	const ShortIndex& active = compoActive(control);
+	HFSM_IF_STATISTICS(void countRequests(const Requests& requests, const bool cancelled));
 
-	ScopedRegion region{control, REGION_ID, HEAD_ID, STATE_COUNT};
+	bool hasActiveUpdaters() const;
 
-	_headState.deepEnter(control);
-	_subStates.wideEnter(control, active);
-}
+	HFSM_IF_WATCHDOG(void watchRounds(const LongIndex rounds));
+	HFSM_IF_WATCHDOG(void watchRequests(const Requests& requests));
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+private:
+	Context& _context;
+	RNG& _rng;
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
-void
-C_<TN, TA, SG, TH, TS...>::deepReenter(PlanControl& control) {
-	ShortIndex& active	  = compoActive   (control);
-	ShortIndex& resumable = compoResumable(control);
-	ShortIndex& requested = compoRequested(control);
+	Registry _registry;
+	PlanData _planData;
 
-	HFSM_ASSERT(active	  != INVALID_SHORT_INDEX &&
-				requested != INVALID_SHORT_INDEX);
+	Requests _requests;
 
-	ScopedRegion region{control, REGION_ID, HEAD_ID, STATE_COUNT};
+	MaterialApex _apex;
 
-	_headState.deepReenter(control);
+#ifdef HFSM_ENABLE_STRUCTURE_REPORT
+	const StructureReport& _structureReport;
 
-	if (active == requested)
-		_subStates.wideReenter(control, active);
-	else {
-		_subStates.wideExit	  (control, active);
+	uint32_t _activityTick = 0;					// udpateActivity() calls
+	uint32_t _activitySince[NAME_COUNT];		// '_activityTick' before the entry last changed
+	BitArray<ShortIndex, NAME_COUNT> _activityBits;
 
-		active	  = requested;
+	mutable ActivityHistory _activityHistory;
+#endif
 
-		if (requested == resumable)
-			resumable = INVALID_SHORT_INDEX;
+	HFSM_IF_TRANSITION_HISTORY(TransitionHistory _transitionHistory);
 
-		_subStates.wideEnter  (control, active);
-	}
+	// Active configuration changed since the last needsUpdate() check
+	mutable bool _updatersDirty = true;
+	mutable bool _hasUpdaters	= false;
 
-	requested = INVALID_SHORT_INDEX;
-}
+	uint32_t _activityEpoch = 0;
 
-//------------------------------------------------------------------------------
+#ifdef HFSM_ENABLE_TRANSITION_TRACE
+	TransitionTrace* _trace = nullptr;
+	uint16_t _traceInstance = 0;
+	uint32_t _tick = 0;
+#endif
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
-Status
-C_<TN, TA, SG, TH, TS...>::deepUpdate(FullControl& control) {
-	const ShortIndex active = compoActive(control);
-	HFSM_ASSERT(active != INVALID_SHORT_INDEX);
+	HFSM_IF_LOGGER(Logger* _logger);
+	HFSM_IF_PROFILER(Profiler* _profiler = nullptr);
+	HFSM_IF_STATISTICS(Statistics* _statistics = nullptr);
+	HFSM_IF_WATCHDOG(detail::Watchdog _watchdog);
+	HFSM_IF_TIMERS(Timers _timers);
+};
 
-	ScopedRegion outer{control, REGION_ID, HEAD_ID, STATE_COUNT};
+////////////////////////////////////////////////////////////////////////////////
 
-	if (const Status headStatus = _headState.deepUpdate(control)) {
-		ControlLock lock{control};
-		_subStates.wideUpdate(control, active);
+template <typename TConfig,
+		  typename TApex>
+class RW_ final
+	: public R_<TConfig, TApex>
+{
+public:
+	using R_<TConfig, TApex>::R_;
+};
 
-		return headStatus;
-	} else {
-		const Status subStatus = _subStates.wideUpdate(control, active);
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-		if (subStatus.outerTransition)
-			return Status{Status::NONE, true};
+template <typename TN_,
+		  typename TU_,
+		  typename TR_,
+		  LongIndex NS,
+		  LongIndex NT,
+		  typename TL_,
+		  LongIndex NP,
+		  LongIndex NA,
+		  typename TApex>
+class RW_	   <::hfsm2::ConfigT<::hfsm2::EmptyContext, TN_, TU_, TR_, NS, NT, TL_, NP, NA>, TApex> final
+	: public R_<::hfsm2::ConfigT<::hfsm2::EmptyContext, TN_, TU_, TR_, NS, NT, TL_, NP, NA>, TApex>
+	, ::hfsm2::EmptyContext
+{
+	using Config_	= ::hfsm2::ConfigT<::hfsm2::EmptyContext, TN_, TU_, TR_, NS, NT, TL_, NP, NA>;
+	using Context	= typename Config_::Context;
+	using RNG		= typename Config_::RNG;
+	using Logger	= typename Config_::Logger;
 
-		ScopedRegion inner{control, REGION_ID, HEAD_ID, STATE_COUNT};
+	using R			= R_<Config_, TApex>;
 
-		return subStatus && control._planData.planExists.template get<REGION_ID>() ?
-			control.updatePlan(_headState, subStatus) : subStatus;
-	}
-}
+public:
+	explicit HFSM_INLINE RW_(RNG& rng
+							 HFSM_IF_LOGGER(, Logger* const logger = nullptr))
+		: R{static_cast<Context&>(*this),
+			rng
+			HFSM_IF_LOGGER(, logger)}
+	{}
+};
 
-//------------------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
-template <typename TEvent>
-Status
-C_<TN, TA, SG, TH, TS...>::deepReact(FullControl& control,
-									 const TEvent& event)
+template <typename TC_,
+		  typename TN_,
+		  typename TU_,
+		  LongIndex NS,
+		  LongIndex NT,
+		  typename TL_,
+		  LongIndex NP,
+		  LongIndex NA,
+		  typename TApex>
+class RW_	   <::hfsm2::ConfigT<TC_, TN_, TU_, ::hfsm2::RandomT<TU_>, NS, NT, TL_, NP, NA>, TApex> final
+	: public R_<::hfsm2::ConfigT<TC_, TN_, TU_, ::hfsm2::RandomT<TU_>, NS, NT, TL_, NP, NA>, TApex>
+	, ::hfsm2::RandomT<TU_>
 {
-	const ShortIndex active = compoActive(control);
-	HFSM_ASSERT(active != INVALID_SHORT_INDEX);
+	using Config_	= ::hfsm2::ConfigT<TC_, TN_, TU_, ::hfsm2::RandomT<TU_>, NS, NT, TL_, NP, NA>;
+	using Context	= typename Config_::Context;
+	using RNG		= typename Config_::RNG;
+	using Logger	= typename Config_::Logger;
 
-	ScopedRegion outer{control, REGION_ID, HEAD_ID, STATE_COUNT};
+	using R			= R_<Config_, TApex>;
 
-	if (const Status headStatus = _headState.deepReact(control, event)) {
-		ControlLock lock{control};
-		_subStates.wideReact(control, event, active);
+public:
+	explicit HFSM_INLINE RW_(Context& context
+							 HFSM_IF_LOGGER(, Logger* const logger = nullptr))
+		: R{context,
+			static_cast<RNG&>(*this)
+			HFSM_IF_LOGGER(, logger)}
+		, RNG{0}
+	{}
+};
 
-		return headStatus;
-	} else {
-		const Status subStatus = _subStates.wideReact(control, event, active);
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-		if (subStatus.outerTransition)
-			return subStatus;
+template <typename TN_,
+		  typename TU_,
+		  LongIndex NS,
+		  LongIndex NT,
+		  typename TL_,
+		  LongIndex NP,
+		  LongIndex NA,
+		  typename TApex>
+class RW_	   <::hfsm2::ConfigT<::hfsm2::EmptyContext, TN_, TU_, ::hfsm2::RandomT<TU_>, NS, NT, TL_, NP, NA>, TApex> final
+	: public R_<::hfsm2::ConfigT<::hfsm2::EmptyContext, TN_, TU_, ::hfsm2::RandomT<TU_>, NS, NT, TL_, NP, NA>, TApex>
+	, ::hfsm2::EmptyContext
+	, ::hfsm2::RandomT<TU_>
+{
+	using Config_	= ::hfsm2::ConfigT<::hfsm2::EmptyContext, TN_, TU_, ::hfsm2::RandomT<TU_>, NS, NT, TL_, NP, NA>;
+	using Context	= typename Config_::Context;
+	using RNG		= typename Config_::RNG;
+	using Logger	= typename Config_::Logger;
 
-		ScopedRegion inner{control, REGION_ID, HEAD_ID, STATE_COUNT};
+	using R			= R_<Config_, TApex>;
 
-		return subStatus && control._planData.planExists.template get<REGION_ID>() ?
-			control.updatePlan(_headState, subStatus) : subStatus;
-	}
+public:
+	explicit HFSM_INLINE RW_(HFSM_IF_LOGGER(Logger* const logger = nullptr))
+		: R{static_cast<Context&>(*this),
+			static_cast<RNG&>(*this)
+			HFSM_IF_LOGGER(, logger)}
+		, RNG{0}
+	{}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
 }
 
-//------------------------------------------------------------------------------
+namespace hfsm2 {
+namespace detail {
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
-bool
-C_<TN, TA, SG, TH, TS...>::deepForwardExitGuard(GuardControl& control) {
-	const ShortIndex active = compoActive(control);
-	HFSM_ASSERT(active != INVALID_SHORT_INDEX);
+////////////////////////////////////////////////////////////////////////////////
 
-	ScopedRegion region{control, REGION_ID, HEAD_ID, STATE_COUNT};
+template <typename TG, typename TA>
+R_<TG, TA>::R_(Context& context,
+			   RNG& rng
+			   HFSM_IF_LOGGER(, Logger* const logger))
+	: _context{context}
+	, _rng{rng}
+	HFSM_IF_LOGGER(, _logger{logger})
+	HFSM_IF_STRUCTURE(, _structureReport{structureReport(_apex)})
+{
+	_apex.deepRegister(_registry, Parent{});
 
-	if (compoRequested(control) == INVALID_SHORT_INDEX)
-		return _subStates.wideForwardExitGuard(control, active);
-	else
-		return _subStates.wideExitGuard		  (control, active);
+#ifdef HFSM_ENABLE_STRUCTURE_REPORT
+	for (LongIndex i = 0; i < _structureReport.structure.count(); ++i) {
+		_activitySince[i] = 0;
+		_activityHistory.append((char) 0);
+	}
+#endif
+
+	initialEnter();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
-bool
-C_<TN, TA, SG, TH, TS...>::deepExitGuard(GuardControl& control) {
-	const ShortIndex active = compoActive(control);
-	HFSM_ASSERT(active != INVALID_SHORT_INDEX);
+template <typename TG, typename TA>
+R_<TG, TA>::~R_() {
+	PlanControl control{_context,
+						_rng,
+						_registry,
+						_planData,
+						HFSM_LOGGER_OR(_logger, nullptr)
+						HFSM_IF_PROFILER(, _profiler)
+						HFSM_IF_STATISTICS(, _statistics)
+						HFSM_IF_TIMERS(, _timers)};
 
-	ScopedRegion region{control, REGION_ID, HEAD_ID, STATE_COUNT};
+	_apex.deepExit	  (control);
+	_apex.deepDestruct(control);
 
-	return _headState.deepExitGuard(control) ||
-		   _subStates.wideExitGuard(control, active);
+	HFSM_IF_ASSERT(_planData.verifyPlans());
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+template <typename TG, typename TA>
 void
-C_<TN, TA, SG, TH, TS...>::deepExit(PlanControl& control) {
-	ShortIndex& active	  = compoActive   (control);
-	HFSM_ASSERT(active != INVALID_SHORT_INDEX);
+R_<TG, TA>::update() {
+	HFSM_IF_TRANSITION_TRACE(++_tick);
+	HFSM_IF_STATISTICS(if (_statistics) _statistics->advance());
+	HFSM_IF_WATCHDOG(_watchdog.tick());
+	HFSM_IF_TRANSITION_HISTORY(_transitionHistory.clear());
+	HFSM_IF_TIMERS(_timers.advance(_requests, _registry));
 
-	_subStates.wideExit(control, active);
-	_headState.deepExit(control);
-}
+	FullControl control(_context,
+						_rng,
+						_registry,
+						_planData,
+						_requests,
+						HFSM_LOGGER_OR(_logger, nullptr)
+						HFSM_IF_PROFILER(, _profiler)
+						HFSM_IF_STATISTICS(, _statistics)
+						HFSM_IF_TIMERS(, _timers));
 
-//------------------------------------------------------------------------------
+	_apex.deepUpdate(control);
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
-void
-C_<TN, TA, SG, TH, TS...>::deepDestruct(PlanControl& control) {
-	ShortIndex& active	  = compoActive   (control);
-	ShortIndex& resumable = compoResumable(control);
+	HFSM_IF_ASSERT(_planData.verifyPlans());
 
-	HFSM_ASSERT(active != INVALID_SHORT_INDEX);
+	if (_requests.count())
+		processTransitions();
 
-	_subStates.wideDestruct(control, active);
-	_headState.deepDestruct(control);
+	_requests.clear();
+}
 
-	resumable = active;
-	active	  = INVALID_SHORT_INDEX;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+template <typename TEvent>
+void
+R_<TG, TA>::react(const TEvent& event) {
+	HFSM_IF_TRANSITION_HISTORY(_transitionHistory.clear());
+
+	FullControl control{_context,
+						_rng,
+						_registry,
+						_planData,
+						_requests,
+						HFSM_LOGGER_OR(_logger, nullptr)
+						HFSM_IF_PROFILER(, _profiler)
+						HFSM_IF_STATISTICS(, _statistics)
+						HFSM_IF_TIMERS(, _timers)};
 
-	auto plan = control.plan(REGION_ID);
-	plan.clear();
+	dispatch(control, event);
 }
 
-//------------------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+template <typename TG, typename TA>
+template <typename TEvent>
 void
-C_<TN, TA, SG, TH, TS...>::deepForwardActive(Control& control,
-											 const Request::Type request)
+R_<TG, TA>::reactBatch(const TEvent* const events,
+					   const size_t count)
 {
-	HFSM_ASSERT(control._registry.isActive(HEAD_ID));
-
-	const ShortIndex requested = compoRequested(control);
+	HFSM_IF_TRANSITION_HISTORY(_transitionHistory.clear());
 
-	if (requested == INVALID_SHORT_INDEX) {
-		const ShortIndex active = compoActive(control);
+	FullControl control{_context,
+						_rng,
+						_registry,
+						_planData,
+						_requests,
+						HFSM_LOGGER_OR(_logger, nullptr)
+						HFSM_IF_PROFILER(, _profiler)
+						HFSM_IF_STATISTICS(, _statistics)
+						HFSM_IF_TIMERS(, _timers)};
 
-		_subStates.wideForwardActive (control, request, active);
-	} else
-		_subStates.wideForwardRequest(control, request, requested);
+	for (size_t i = 0; i < count; ++i)
+		dispatch(control, events[i]);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+template <typename TG, typename TA>
+template <LongIndex NCapacity, typename... TEvents>
 void
-C_<TN, TA, SG, TH, TS...>::deepForwardRequest(Control& control,
-											  const Request::Type request)
-{
-	const ShortIndex requested = compoRequested(control);
+R_<TG, TA>::reactBatch(const EventBufferT<NCapacity, TEvents...>& buffer) {
+	HFSM_IF_TRANSITION_HISTORY(_transitionHistory.clear());
 
-	if (requested == INVALID_SHORT_INDEX)
-		deepRequest					 (control, request);
-	else
-		_subStates.wideForwardRequest(control, request, requested);
+	FullControl control{_context,
+						_rng,
+						_registry,
+						_planData,
+						_requests,
+						HFSM_LOGGER_OR(_logger, nullptr)
+						HFSM_IF_PROFILER(, _profiler)
+						HFSM_IF_STATISTICS(, _statistics)
+						HFSM_IF_TIMERS(, _timers)};
+
+	BatchVisitor visitor{*this, control};
+	buffer.visit(visitor);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+template <typename TG, typename TA>
+template <typename TEvent>
 void
-C_<TN, TA, SG, TH, TS...>::deepRequest(Control& control,
-									   const Request::Type request)
+R_<TG, TA>::dispatch(FullControl& control,
+					 const TEvent& event)
 {
-	switch (request) {
-	case Request::REMAIN:
-		deepRequestRemain	(control._registry);
-		break;
-
-	case Request::CHANGE:
-		deepRequestChange	(control);
-		break;
-
-	case Request::RESTART:
-		deepRequestRestart	(control._registry);
-		break;
+	HFSM_IF_TRANSITION_TRACE(++_tick);
+	HFSM_IF_STATISTICS(if (_statistics) _statistics->advance());
+	HFSM_IF_WATCHDOG(_watchdog.tick());
 
-	case Request::RESUME:
-		deepRequestResume	(control._registry);
-		break;
+	_apex.deepReact(control, event);
 
-	case Request::UTILIZE:
-		deepRequestUtilize	(control);
-		break;
+	HFSM_IF_ASSERT(_planData.verifyPlans());
 
-	case Request::RANDOMIZE:
-		deepRequestRandomize(control);
-		break;
+	if (_requests.count())
+		processTransitions();
 
-	default:
-		HFSM_BREAK();
-	}
+	_requests.clear();
 }
 
 //------------------------------------------------------------------------------
 
-#ifndef HFSM_EXPLICIT_MEMBER_SPECIALIZATION
-
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+template <typename TG, typename TA>
 void
-C_<TN, TA, SG, TH, TS...>::deepRequestChange(Control& control)
-{
-	switch (STRATEGY) {
-	case Strategy::Composite:
-		deepRequestChangeComposite  (control);
-		break;
+R_<TG, TA>::changeTo(const StateID stateId) {
+	_requests.append(Request{Request::Type::CHANGE, stateId});
 
-	case Strategy::Resumable:
-		deepRequestChangeResumable  (control);
-		break;
+	HFSM_LOG_TRANSITION(_context, INVALID_STATE_ID, TransitionType::CHANGE, stateId);
+}
 
-	case Strategy::Utilitarian:
-		deepRequestChangeUtilitarian(control);
-		break;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	case Strategy::RandomUtil:
-		deepRequestChangeRandom		(control);
-		break;
+#ifdef HFSM_ENABLE_PAYLOADS
 
-	default:
-		HFSM_BREAK();
-	}
+template <typename TG, typename TA>
+template <typename TPayload>
+void
+R_<TG, TA>::changeTo(const StateID stateId,
+					 const TPayload& payload)
+{
+	if (HFSM_CHECKED(_planData.payloads.stage(stateId, payload)))
+		changeTo(stateId);
 }
 
 #endif
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+template <typename TG, typename TA>
 void
-C_<TN, TA, SG, TH, TS...>::deepRequestChangeComposite(Control& control) {
-	ShortIndex& requested = compoRequested(control);
-
-	requested = 0;
+R_<TG, TA>::restart(const StateID stateId) {
+	_requests.append(Request{Request::Type::RESTART, stateId});
 
-	_subStates.wideRequestChangeComposite(control);
+	HFSM_LOG_TRANSITION(_context, INVALID_STATE_ID, TransitionType::RESTART, stateId);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+template <typename TG, typename TA>
 void
-C_<TN, TA, SG, TH, TS...>::deepRequestChangeResumable(Control& control) {
-	const ShortIndex  resumable = compoResumable(control);
-		  ShortIndex& requested = compoRequested(control);
-
-	requested = (resumable != INVALID_SHORT_INDEX) ?
-		resumable : 0;
+R_<TG, TA>::resume(const StateID stateId) {
+	_requests.append(Request{Request::Type::RESUME, stateId});
 
-	_subStates.wideRequestChangeResumable(control, requested);
+	HFSM_LOG_TRANSITION(_context, INVALID_STATE_ID, TransitionType::RESUME, stateId);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+template <typename TG, typename TA>
 void
-C_<TN, TA, SG, TH, TS...>::deepRequestChangeUtilitarian(Control& control) {
-	const UP s = _subStates.wideReportChangeUtilitarian(control);
-	HFSM_ASSERT(s.prong != INVALID_SHORT_INDEX);
-
-	ShortIndex& requested = compoRequested(control);
-	requested = s.prong;
+R_<TG, TA>::utilize(const StateID stateId) {
+	_requests.append(Request{Request::Type::UTILIZE, stateId});
 
-	HFSM_LOG_UTILITY_RESOLUTION(control.context(), HEAD_ID, requested, s.utility);
+	HFSM_LOG_TRANSITION(_context, INVALID_STATE_ID, TransitionType::UTILIZE, stateId);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+template <typename TG, typename TA>
 void
-C_<TN, TA, SG, TH, TS...>::deepRequestChangeRandom(Control& control) {
-	Rank ranks[Info::WIDTH];
-	Rank top = _subStates.wideReportRank(control, ranks);
-
-	Utility options[Info::WIDTH];
-	const UP sum = _subStates.wideReportChangeRandom(control, options, ranks, top);
+R_<TG, TA>::randomize(const StateID stateId) {
+	_requests.append(Request{Request::Type::RANDOMIZE, stateId});
 
-	ShortIndex& requested = compoRequested(control);
-	requested = resolveRandom(control, options, sum.utility, ranks, top);
-	HFSM_ASSERT(requested < Info::WIDTH);
+	HFSM_LOG_TRANSITION(_context, INVALID_STATE_ID, TransitionType::RANDOMIZE, stateId);
 }
 
-//------------------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+template <typename TG, typename TA>
 void
-C_<TN, TA, SG, TH, TS...>::deepRequestRemain(Registry& registry) {
-	const ShortIndex  active	= compoActive   (registry);
-		  ShortIndex& requested = compoRequested(registry);
-
-	if (active == INVALID_SHORT_INDEX)
-		requested = 0;
+R_<TG, TA>::schedule(const StateID stateId) {
+	_requests.append(Request{Request::Type::SCHEDULE, stateId});
 
-	_subStates.wideRequestRemain(registry);
+	HFSM_LOG_TRANSITION(_context, INVALID_STATE_ID, TransitionType::SCHEDULE, stateId);
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//------------------------------------------------------------------------------
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+#ifdef HFSM_ENABLE_TRANSITION_HISTORY
+
+template <typename TG, typename TA>
 void
-C_<TN, TA, SG, TH, TS...>::deepRequestRestart(Registry& registry) {
-	ShortIndex& requested = compoRequested(registry);
+R_<TG, TA>::replayTransitions(const Transition* const transitions,
+							  const uint64_t count)
+{
+	if (HFSM_CHECKED(transitions && count)) {
+		HFSM_IF_TRANSITION_HISTORY(_transitionHistory.clear());
 
-	requested = 0;
+		PlanControl control{_context,
+							_rng,
+							_registry,
+							_planData,
+							HFSM_LOGGER_OR(_logger, nullptr)
+							HFSM_IF_PROFILER(, _profiler)
+							HFSM_IF_STATISTICS(, _statistics)
+							HFSM_IF_TIMERS(, _timers)};
 
-	_subStates.wideRequestRestart(registry);
+		if (applyRequests(control, transitions, count)) {
+			_apex.deepChangeToRequested(control);
+
+			_registry.clearRequests();
+			_updatersDirty = true;
+			++_activityEpoch;
+
+			HFSM_IF_ASSERT(_planData.verifyPlans());
+		}
+
+		HFSM_IF_STRUCTURE(udpateActivity());
+	}
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+#endif
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+//------------------------------------------------------------------------------
+
+template <typename TG, typename TA>
 void
-C_<TN, TA, SG, TH, TS...>::deepRequestResume(Registry& registry) {
-	const ShortIndex  resumable = compoResumable(registry);
-		  ShortIndex& requested = compoRequested(registry);
+R_<TG, TA>::reset() {
+	PlanControl control{_context,
+						_rng,
+						_registry,
+						_planData,
+						HFSM_LOGGER_OR(_logger, nullptr)
+						HFSM_IF_PROFILER(, _profiler)
+						HFSM_IF_STATISTICS(, _statistics)
+						HFSM_IF_TIMERS(, _timers)};
 
-	requested = (resumable != INVALID_SHORT_INDEX) ?
-		resumable : 0;
+	_apex.deepExit	   (control);
+	_apex.deepDestruct (control);
 
-	_subStates.wideRequestResume(registry, requested);
+	_registry.reset();
+
+	_apex.deepRequestChange(control);
+	_apex.deepConstruct(control);
+	_apex.deepEnter	   (control);
+
+	_updatersDirty = true;
+	++_activityEpoch;
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//------------------------------------------------------------------------------
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
-void
-C_<TN, TA, SG, TH, TS...>::deepRequestUtilize(Control& control) {
-	const UP s = _subStates.wideReportUtilize(control);
+#ifdef HFSM_ENABLE_SERIALIZATION
 
-	ShortIndex& requested = compoRequested(control);
-	requested = s.prong;
+template <typename TG, typename TA>
+void
+R_<TG, TA>::save(SerialBuffer& _buffer) const {
+	WriteStream stream{_buffer};
 
-	HFSM_LOG_UTILITY_RESOLUTION(control.context(), HEAD_ID, requested, s.utility);
+	_apex.deepSaveActive(_registry, stream);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
+template <typename TG, typename TA>
 void
-C_<TN, TA, SG, TH, TS...>::deepRequestRandomize(Control& control) {
-	Rank ranks[Info::WIDTH];
-	Rank top = _subStates.wideReportRank(control, ranks);
-
-	Utility options[Info::WIDTH];
-	const Utility sum = _subStates.wideReportRandomize(control, options, ranks, top);
+R_<TG, TA>::load(const SerialBuffer& buffer) {
+	PlanControl control{_context,
+						_rng,
+						_registry,
+						_planData,
+						HFSM_LOGGER_OR(_logger, nullptr)
+						HFSM_IF_PROFILER(, _profiler)
+						HFSM_IF_STATISTICS(, _statistics)
+						HFSM_IF_TIMERS(, _timers)};
 
-	ShortIndex& requested = compoRequested(control);
-	requested = resolveRandom(control, options, sum, ranks, top);
-	HFSM_ASSERT(requested < Info::WIDTH);
-}
+	_apex.deepExit	   (control);
+	_apex.deepDestruct (control);
 
-//------------------------------------------------------------------------------
+	ReadStream stream{buffer};
+	_apex.deepLoadRequested(_registry, stream);
 
-#ifndef HFSM_EXPLICIT_MEMBER_SPECIALIZATION
+	_apex.deepConstruct(control);
+	_apex.deepEnter	   (control);
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
-typename TA::UP
-C_<TN, TA, SG, TH, TS...>::deepReportChange(Control& control) {
-	switch (STRATEGY) {
-	case Strategy::Composite:
-		return deepReportChangeComposite  (control);
+	_updatersDirty = true;
+	++_activityEpoch;
+}
 
-	case Strategy::Resumable:
-		return deepReportChangeResumable  (control);
+#endif
 
-	case Strategy::Utilitarian:
-		return deepReportChangeUtilitarian(control);
+//------------------------------------------------------------------------------
 
-	case Strategy::RandomUtil:
-		return deepReportChangeRandom	  (control);
+template <typename TG, typename TA>
+bool
+R_<TG, TA>::needsUpdate() const {
+	if (_requests.count() || _planData.hasPlans())
+		return true;
 
-	default:
-		HFSM_BREAK();
-		return {};
+	HFSM_IF_TIMERS(if (!_timers.empty()) return true);
+	HFSM_IF_COROUTINES(if (_planData.coroutines.needsUpdate()) return true);
+
+	if (_updatersDirty) {
+		_hasUpdaters = hasActiveUpdaters();
+		_updatersDirty = false;
 	}
-}
 
-#endif
+	return _hasUpdaters;
+}
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
-typename TA::UP
-C_<TN, TA, SG, TH, TS...>::deepReportChangeComposite(Control& control) {
-	ShortIndex& requested = compoRequested(control);
-	requested = 0;
+template <typename TG, typename TA>
+bool
+R_<TG, TA>::hasActiveUpdaters() const {
+	using UpdateMask = UpdateMaskT<FullControl, StateList>;
 
-	const UP h = _headState.deepReportChange(control);
-	const UP s = _subStates.wideReportChangeComposite(control);
+	for (StateID s = 0; s < STATE_COUNT; ++s)
+		if (UpdateMask::HAS_UPDATE[s] && isActive(s))
+			return true;
 
-	return {
-		h.utility * s.utility,
-		h.prong
-	};
+	return false;
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//------------------------------------------------------------------------------
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
-typename TA::UP
-C_<TN, TA, SG, TH, TS...>::deepReportChangeResumable(Control& control) {
-	const ShortIndex  resumable = compoResumable(control);
-		  ShortIndex& requested = compoRequested(control);
+template <typename TG, typename TA>
+void
+R_<TG, TA>::initialEnter() {
+	HFSM_ASSERT(_requests.count() == 0);
+	HFSM_IF_TRANSITION_HISTORY(HFSM_ASSERT(_transitionHistory.count() == 0));
 
-	requested = (resumable != INVALID_SHORT_INDEX) ?
-		resumable : 0;
+	RegistryBackUp undo;
+	HFSM_IF_TRANSITION_HISTORY(TransitionHistory undoTransitionHistory);
 
-	const UP h = _headState.deepReportChange(control);
-	const UP s = _subStates.wideReportChangeResumable(control, requested);
+	Requests lastRequests;
 
-	return {
-		h.utility * s.utility,
-		h.prong
-	};
-}
+	PlanControl control{_context,
+						_rng,
+						_registry,
+						_planData,
+						HFSM_LOGGER_OR(_logger, nullptr)
+						HFSM_IF_PROFILER(, _profiler)
+						HFSM_IF_STATISTICS(, _statistics)
+						HFSM_IF_TIMERS(, _timers)};
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	_apex.deepRequestChange(control);
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
-typename TA::UP
-C_<TN, TA, SG, TH, TS...>::deepReportChangeUtilitarian(Control& control) {
-	const UP h = _headState.deepReportChange(control);
-	const UP s = _subStates.wideReportChangeUtilitarian(control);
+	cancelledByEntryGuards(_requests);
 
-	ShortIndex& requested = compoRequested(control);
-	requested = s.prong;
+	for (LongIndex i = 0;
+		 i < SUBSTITUTION_LIMIT && _requests.count();
+		 ++i)
+	{
+		backup(_registry, undo);
+		HFSM_IF_TRANSITION_HISTORY(undoTransitionHistory = _transitionHistory);
 
-	HFSM_LOG_UTILITY_RESOLUTION(control.context(), HEAD_ID, requested, s.utility);
+		if (applyRequests(control)) {
+			lastRequests = _requests;
+			_requests.clear();
 
-	return {
-		h.utility * s.utility,
-		h.prong
-	};
+			if (cancelledByEntryGuards(lastRequests)) {
+				restore(_registry, undo);
+				HFSM_IF_TRANSITION_HISTORY(_transitionHistory = undoTransitionHistory);
+			}
+		} else
+			_requests.clear();
+	}
+	HFSM_ASSERT(_requests.count() == 0);
+
+	_apex.deepConstruct(control);
+	_apex.deepEnter	   (control);
+
+	_registry.clearRequests();
+
+	HFSM_IF_ASSERT(_planData.verifyPlans());
+
+	HFSM_IF_STRUCTURE(udpateActivity());
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
-typename TA::UP
-C_<TN, TA, SG, TH, TS...>::deepReportChangeRandom(Control& control) {
-	const UP h = _headState.deepReportChange(control);
+template <typename TG, typename TA>
+void
+R_<TG, TA>::processTransitions() {
+	HFSM_ASSERT(_requests.count());
 
-	Rank ranks[Info::WIDTH];
-	Rank top = _subStates.wideReportRank(control, ranks);
+	RegistryBackUp undo;
+	HFSM_IF_TRANSITION_HISTORY(TransitionHistory undoTransitionHistory);
 
-	Utility options[Info::WIDTH];
-	const UP sum = _subStates.wideReportChangeRandom(control, options, ranks, top);
+	Requests lastRequests;
 
-	ShortIndex& requested = compoRequested(control);
-	requested = resolveRandom(control, options, sum.utility, ranks, top);
-	HFSM_ASSERT(requested < Info::WIDTH);
+	PlanControl control{_context,
+						_rng,
+						_registry,
+						_planData,
+						HFSM_LOGGER_OR(_logger, nullptr)
+						HFSM_IF_PROFILER(, _profiler)
+						HFSM_IF_STATISTICS(, _statistics)
+						HFSM_IF_TIMERS(, _timers)};
 
-	return {
-		h.utility * options[requested],
-		h.prong
-	};
-}
+	bool changesMade = false;
 
-//------------------------------------------------------------------------------
+	LongIndex i = 0;
+	for (;
+		i < SUBSTITUTION_LIMIT && _requests.count();
+		++i)
+	{
+		backup(_registry, undo);
+		HFSM_IF_TRANSITION_HISTORY(undoTransitionHistory = _transitionHistory);
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
-typename TA::UP
-C_<TN, TA, SG, TH, TS...>::deepReportUtilize(Control& control) {
-	const UP h = _headState.deepReportUtilize(control);
-	const UP s = _subStates.wideReportUtilize(control);
+		if (applyRequests(control)) {
+			lastRequests = _requests;
+			_requests.clear();
 
-	ShortIndex& requested = compoRequested(control);
-	requested = s.prong;
+			HFSM_IF_PAYLOADS(const uint16_t round = _planData.payloads.seal());
 
-	HFSM_LOG_UTILITY_RESOLUTION(control.context(), HEAD_ID, requested, s.utility);
+			if (cancelledByGuards(lastRequests)) {
+				restore(_registry, undo);
+				HFSM_IF_TRANSITION_HISTORY(_transitionHistory = undoTransitionHistory);
+				HFSM_IF_STATISTICS(countRequests(lastRequests, true));
+				HFSM_IF_PAYLOADS(_planData.payloads.discard(round));
+			} else {
+				HFSM_IF_TRANSITION_TRACE(traceRequests(lastRequests, Method::NONE));
+				HFSM_IF_STATISTICS(countRequests(lastRequests, false));
+				HFSM_IF_WATCHDOG(watchRequests(lastRequests));
 
-	return {
-		h.utility * s.utility,
-		h.prong
-	};
-}
+				changesMade = true;
+			}
+		} else {
+			HFSM_IF_TRANSITION_TRACE(traceRequests(_requests, Method::NONE));
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+			_requests.clear();
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
-typename TA::Rank
-C_<TN, TA, SG, TH, TS...>::deepReportRank(Control& control) {
-	return _headState.wrapRank(control);
-}
+			HFSM_IF_PAYLOADS(_planData.payloads.discard(_planData.payloads.seal()));
+		}
+	}
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	HFSM_IF_WATCHDOG(watchRounds(i));
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
-typename TA::Utility
-C_<TN, TA, SG, TH, TS...>::deepReportRandomize(Control& control) {
-	const Utility h = _headState.wrapUtility(control);
+	if (changesMade) {
+		_apex.deepChangeToRequested(control);
 
-	Rank ranks[Info::WIDTH];
-	Rank top = _subStates.wideReportRank(control, ranks);
+		_registry.clearRequests();
+		_updatersDirty = true;
+		++_activityEpoch;
 
-	Utility options[Info::WIDTH];
-	const Utility sum = _subStates.wideReportRandomize(control, options, ranks, top);
+		HFSM_IF_ASSERT(_planData.verifyPlans());
+	}
 
-	ShortIndex& requested = compoRequested(control);
-	requested = resolveRandom(control, options, sum, ranks, top);
-	HFSM_ASSERT(requested < Info::WIDTH);
+	HFSM_IF_PAYLOADS(_planData.payloads.clear());
 
-	return h * options[requested];
+	HFSM_IF_STRUCTURE(udpateActivity());
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
-void
-C_<TN, TA, SG, TH, TS...>::deepChangeToRequested(PlanControl& control) {
-	ShortIndex& active	  = compoActive	  (control);
-	ShortIndex& resumable = compoResumable(control);
-	ShortIndex& requested = compoRequested(control);
+template <typename TG, typename TA>
+bool
+R_<TG, TA>::applyRequest(Control& control,
+						 const Request& request)
+{
+	HFSM_IF_TRANSITION_HISTORY(_transitionHistory.append(Transition{request, Method::NONE}));
 
-	HFSM_ASSERT(active != INVALID_SHORT_INDEX);
+	switch (request.type) {
+	case Request::CHANGE:
+	case Request::RESTART:
+	case Request::RESUME:
+	case Request::UTILIZE:
+	case Request::RANDOMIZE:
+		if (_registry.requestImmediate(request))
+			_apex.deepForwardActive(control, request.type);
+		else
+			_apex.deepRequest	   (control, request.type);
 
-	if (requested == INVALID_SHORT_INDEX)
-		_subStates.wideChangeToRequested(control, active);
-	else if (requested != active) {
-		_subStates.wideExit		(control, active);
-		_subStates.wideDestruct	(control, active);
+		return true;
 
-		resumable = active;
-		active	  = requested;
-		requested = INVALID_SHORT_INDEX;
+	case Request::SCHEDULE:
+		_registry.requestScheduled(request.stateId);
 
-		_subStates.wideConstruct(control, active);
-		_subStates.wideEnter	(control, active);
-	} else if (compoRemain(control)) {
-		_subStates.wideExit		(control, active);
-		_subStates.wideDestruct	(control, active);
+		return false;
 
-		requested = INVALID_SHORT_INDEX;
+	default:
+		HFSM_BREAK();
 
-		_subStates.wideConstruct(control, active);
-		_subStates.wideEnter	(control, active);
-	} else {
-		requested = INVALID_SHORT_INDEX;
+		return false;
+	}
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+bool
+R_<TG, TA>::applyRequests(Control& control) {
+	bool changesMade = false;
 
-		// no reconstruction on reenter() by design
+	for (const Request& request : _requests)
+		changesMade |= applyRequest(control, request);
 
-		_subStates.wideReenter	(control, active);
-	}
+	return changesMade;
 }
 
-//------------------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-#ifdef HFSM_ENABLE_STRUCTURE_REPORT
+#ifdef HFSM_ENABLE_TRANSITION_HISTORY
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
-void
-C_<TN, TA, SG, TH, TS...>::deepGetNames(const LongIndex parent,
-										const RegionType region,
-										const ShortIndex depth,
-										StructureStateInfos& _stateInfos) const
+template <typename TG, typename TA>
+bool
+R_<TG, TA>::applyRequests(Control& control,
+						  const Transition* const transitions,
+						  const uint64_t count)
 {
-	_headState.deepGetNames(parent,					 region,						depth,	   _stateInfos);
-	_subStates.wideGetNames(_stateInfos.count() - 1, StructureStateInfo::COMPOSITE, depth + 1, _stateInfos);
+	if (HFSM_CHECKED(transitions && count)) {
+		bool changesMade = false;
+
+		for (uint64_t i = 0; i < count; ++i)
+			changesMade |= applyRequest(control, transitions[i].request());
+
+		return changesMade;
+	} else
+		return false;
 }
 
 #endif
 
 //------------------------------------------------------------------------------
 
-#ifdef HFSM_ENABLE_SERIALIZATION
-
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
-void
-C_<TN, TA, SG, TH, TS...>::deepSaveActive(const Registry& registry,
-										  WriteStream& stream) const
-{
-	const ShortIndex active	   = compoActive   (registry);
-	const ShortIndex resumable = compoResumable(registry);
+template <typename TG, typename TA>
+bool
+R_<TG, TA>::cancelledByEntryGuards(const Requests& pendingRequests) {
+	GuardControl guardControl{_context,
+							  _rng,
+							  _registry,
+							  _planData,
+							  _requests,
+							  pendingRequests,
+							  HFSM_LOGGER_OR(_logger, nullptr)
+							  HFSM_IF_PROFILER(, _profiler)
+							  HFSM_IF_STATISTICS(, _statistics)
+							  HFSM_IF_TIMERS(, _timers)};
 
-	stream.template write<WIDTH_BITS>(active);
+	if (_apex.deepEntryGuard(guardControl)) {
+		HFSM_IF_TRANSITION_HISTORY(recordRequestsAs(Method::ENTRY_GUARD));
 
-	if (resumable != INVALID_SHORT_INDEX) {
-		stream.template write<1>(1);
-		stream.template write<WIDTH_BITS>(resumable);
+		return true;
 	} else
-		stream.template write<1>(0);
-
-	_subStates.wideSaveActive(registry,stream, active);
+		return false;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
-void
-C_<TN, TA, SG, TH, TS...>::deepSaveResumable(const Registry& registry,
-											 WriteStream& stream) const
-{
-	const ShortIndex resumable = compoResumable(registry);
+template <typename TG, typename TA>
+bool
+R_<TG, TA>::cancelledByGuards(const Requests& pendingRequests) {
+	GuardControl guardControl{_context,
+							  _rng,
+							  _registry,
+							  _planData,
+							  _requests,
+							  pendingRequests,
+							  HFSM_LOGGER_OR(_logger, nullptr)
+							  HFSM_IF_PROFILER(, _profiler)
+							  HFSM_IF_STATISTICS(, _statistics)
+							  HFSM_IF_TIMERS(, _timers)};
 
-	if (resumable != INVALID_SHORT_INDEX) {
-		stream.template write<1>(1);
-		stream.template write<WIDTH_BITS>(resumable);
-	} else
-		stream.template write<1>(0);
+	if (_apex.deepForwardExitGuard(guardControl)) {
+		HFSM_IF_TRANSITION_HISTORY(recordRequestsAs(Method::EXIT_GUARD));
+		HFSM_IF_TRANSITION_TRACE(traceRequests(pendingRequests, Method::EXIT_GUARD));
 
-	_subStates.wideSaveResumable(registry, stream);
+		return true;
+	} else if (_apex.deepForwardEntryGuard(guardControl)) {
+		HFSM_IF_TRANSITION_HISTORY(recordRequestsAs(Method::ENTRY_GUARD));
+		HFSM_IF_TRANSITION_TRACE(traceRequests(pendingRequests, Method::ENTRY_GUARD));
+
+		return true;
+	} else
+		return false;
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//------------------------------------------------------------------------------
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
-void
-C_<TN, TA, SG, TH, TS...>::deepLoadRequested(Registry& registry,
-											 ReadStream& stream) const
-{
-	ShortIndex& resumable = compoResumable(registry);
-	ShortIndex& requested = compoRequested(registry);
+#ifdef HFSM_ENABLE_STRUCTURE_REPORT
 
-	requested = stream.template read<WIDTH_BITS>();
-	HFSM_ASSERT(requested < WIDTH);
+template <typename TG, typename TA>
+R_<TG, TA>::StructureReport::StructureReport(const MaterialApex& apex) {
+	apex.deepGetNames((LongIndex) -1, StructureStateInfo::COMPOSITE, 0, stateInfos);
 
-	if (stream.template read<1>()) {
-		resumable = stream.template read<WIDTH_BITS>();
-		HFSM_ASSERT(resumable < WIDTH);
-	} else
-		resumable = INVALID_SHORT_INDEX;
+	for (LongIndex s = 0; s < STATE_COUNT; ++s)
+		entries[s] = INVALID_LONG_INDEX;
 
-	_subStates.wideLoadRequested(registry, stream, requested);
-}
+	LongIndex margin = (LongIndex) -1;
+	for (LongIndex s = 0; s < stateInfos.count(); ++s) {
+		const auto& state = stateInfos[s];
+		auto& prefix      = prefixes[s];
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+		if (margin > state.depth && state.name[0] != '\0')
+			margin = state.depth;
 
-template <typename TN, typename TA, Strategy SG, typename TH, typename... TS>
-void
-C_<TN, TA, SG, TH, TS...>::deepLoadResumable(Registry& registry,
-											 ReadStream& stream) const
-{
-	ShortIndex& resumable = compoResumable(registry);
+		if (state.depth == 0)
+			prefix[0] = L'\0';
+		else {
+			const LongIndex mark = state.depth * 2 - 1;
 
-	if (stream.template read<1>()) {
-		resumable = stream.template read<WIDTH_BITS>();
-		HFSM_ASSERT(resumable < WIDTH);
-	} else
-		resumable = INVALID_SHORT_INDEX;
+			prefix[mark + 0] = state.region == StructureStateInfo::COMPOSITE ? L'└' : L'╙';
+			prefix[mark + 1] = L' ';
+			prefix[mark + 2] = L'\0';
 
-	_subStates.wideLoadResumable(registry, stream);
-}
+			for (auto d = mark; d > 0; --d)
+				prefix[d - 1] = L' ';
 
-#endif
+			for (auto r = s; r > state.parent; --r) {
+				auto& prefixAbove = prefixes[r - 1];
 
-////////////////////////////////////////////////////////////////////////////////
+				switch (prefixAbove[mark]) {
+				case L' ':
+					prefixAbove[mark] = state.region == StructureStateInfo::COMPOSITE ? L'│' : L'║';
+					break;
+				case L'└':
+					prefixAbove[mark] = L'├';
+					break;
+				case L'╙':
+					prefixAbove[mark] = L'╟';
+					break;
+				}
+			}
+		}
+	}
+	if (margin > 0)
+		margin -= 1;
+
+	for (LongIndex s = 0; s < stateInfos.count(); ++s) {
+		const auto& state = stateInfos[s];
+		auto& prefix = prefixes[s];
+		const LongIndex space = state.depth * 2;
+
+		if (state.name[0] != L'\0') {
+			entries[s] = structure.count();
+			structure.append(StructureEntry{false, &prefix[margin * 2], state.name});
+		} else if (s + 1 < stateInfos.count()) {
+			auto& nextPrefix = prefixes[s + 1];
+
+			if (s > 0)
+				for (LongIndex c = 0; c <= space; ++c)
+					nextPrefix[c] = prefix[c];
+
+			const LongIndex mark = space + 1;
 
+			switch (nextPrefix[mark]) {
+			case L'├':
+				nextPrefix[mark] = state.depth == margin ? L'┌' : L'┬';
+				break;
+			case L'╟':
+				nextPrefix[mark] = state.depth == margin ? L'╓' : L'╥';
+				break;
+			}
+		}
+	}
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TG, typename TA>
+const typename R_<TG, TA>::StructureReport&
+R_<TG, TA>::structureReport(const MaterialApex& apex) {
+	static const StructureReport report{apex};
+
+	return report;
 }
-namespace hfsm2 {
-namespace detail {
 
-////////////////////////////////////////////////////////////////////////////////
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename, typename, ShortIndex, typename...>
-struct OS_;
+template <typename TG, typename TA>
+void
+R_<TG, TA>::structure(Structure& entries) const {
+	entries.clear();
 
-//------------------------------------------------------------------------------
+	for (LongIndex i = 0; i < _structureReport.structure.count(); ++i) {
+		StructureEntry entry = _structureReport.structure[i];
+		entry.isActive = _activityBits.get(i);
 
-template <typename TIndices,
-		  typename TArgs,
-		  ShortIndex NIndex,
-		  typename TInitial,
-		  typename... TRemaining>
-struct OS_<TIndices, TArgs, NIndex, TInitial, TRemaining...> final {
-	using Indices		= TIndices;
-	static constexpr StateID	INITIAL_ID	= Indices::STATE_ID;
-	static constexpr ShortIndex COMPO_INDEX	= Indices::COMPO_INDEX;
-	static constexpr ShortIndex ORTHO_INDEX	= Indices::ORTHO_INDEX;
-	static constexpr ShortIndex ORTHO_UNIT	= Indices::ORTHO_UNIT;
+		entries.append(entry);
+	}
+}
 
-	static constexpr ShortIndex PRONG_INDEX	= NIndex;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	using Args			= TArgs;
-	using Rank			= typename Args::Rank;
-	using Utility		= typename Args::Utility;
-	using UP			= typename Args::UP;
+template <typename TG, typename TA>
+const typename R_<TG, TA>::ActivityHistory&
+R_<TG, TA>::activityHistory() const {
+	for (LongIndex i = 0; i < _activityHistory.count(); ++i) {
+		const uint32_t streak = _activityTick - _activitySince[i];
 
-	using Registry		= RegistryT<Args>;
-	using StateParents	= typename Registry::StateParents;
-	using OrthoForks	= typename Registry::OrthoForks;
-	using ProngBits		= typename OrthoForks::Bits;
-	using ProngConstBits= typename OrthoForks::ConstBits;
+		if (_activityBits.get(i))
+			_activityHistory[i] = streak < INT8_MAX ? (char)  streak : (char) INT8_MAX;
+		else
+			_activityHistory[i] = streak < 128		? (char) -(int) streak : (char) INT8_MIN;
+	}
 
-	using Control		= ControlT	   <Args>;
-	using PlanControl	= PlanControlT <Args>;
-	using FullControl	= FullControlT <Args>;
-	using GuardControl	= GuardControlT<Args>;
+	return _activityHistory;
+}
 
-	using Initial		= Material<I_<INITIAL_ID,
-									  COMPO_INDEX,
-									  ORTHO_INDEX,
-									  ORTHO_UNIT>,
-								   Args,
-								   TInitial>;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	using InitialInfo	= WrapInfo<TInitial>;
-	using InitialStates	= typename InitialInfo::StateList;
+template <typename TG, typename TA>
+void
+R_<TG, TA>::udpateActivity() {
+	++_activityTick;
 
-	using Remaining		= OS_<I_<INITIAL_ID  + InitialInfo::STATE_COUNT,
-								 COMPO_INDEX + InitialInfo::COMPO_REGIONS,
-								 ORTHO_INDEX + InitialInfo::ORTHO_REGIONS,
-								 ORTHO_UNIT  + InitialInfo::ORTHO_UNITS>,
-							  Args,
-							  PRONG_INDEX + 1,
-							  TRemaining...>;
+	auto& changes = _planData.activityChanges;
 
-	using Info	= OSI_<TInitial, TRemaining...>;
+	for (LongIndex c = 0; c < changes.states.count(); ++c) {
+		const StateID stateId = changes.states[c];
+		const LongIndex i = _structureReport.entries[stateId];
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+		if (i != INVALID_LONG_INDEX && isActive(stateId) != _activityBits.get(i)) {
+			if (_activityBits.get(i))
+				_activityBits.reset(i);
+			else
+				_activityBits.set(i);
 
-#ifdef HFSM_EXPLICIT_MEMBER_SPECIALIZATION
-	template <typename T>
-	HFSM_INLINE		  T& access();
+			_activitySince[i] = _activityTick - 1;
+		}
+	}
 
-	template <typename T>
-	HFSM_INLINE const T& access() const;
-#endif
+	changes.clear();
+}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+#endif
 
-	HFSM_INLINE void	wideRegister		 (Registry& registry, const ForkID forkId);
+//------------------------------------------------------------------------------
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+#ifdef HFSM_ENABLE_TRANSITION_HISTORY
 
-	HFSM_INLINE bool	wideForwardEntryGuard(GuardControl&	control,							const ProngConstBits prongs);
-	HFSM_INLINE bool	wideForwardEntryGuard(GuardControl&	control);
-	HFSM_INLINE bool	wideEntryGuard		 (GuardControl&	control);
+template <typename TG, typename TA>
+void
+R_<TG, TA>::recordRequestsAs(const Method method) {
+	for (const auto& request : _requests)
+		if (HFSM_CHECKED(_transitionHistory.count() < TransitionHistory::CAPACITY))
+			_transitionHistory.append(Transition{request, method});
+}
 
-	HFSM_INLINE void	wideConstruct		 (PlanControl&	control);
+#endif
 
-	HFSM_INLINE void	wideEnter			 (PlanControl&	control);
-	HFSM_INLINE void	wideReenter			 (PlanControl&	control);
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	HFSM_INLINE Status	wideUpdate			 (FullControl&	control);
+#ifdef HFSM_ENABLE_TRANSITION_TRACE
 
-	template <typename TEvent>
-	HFSM_INLINE Status	wideReact			 (FullControl&	control, const TEvent& event);
+template <typename TG, typename TA>
+void
+R_<TG, TA>::traceRequests(const Requests& requests,
+						  const Method method)
+{
+	if (_trace)
+		for (const auto& request : requests)
+			_trace->record(TraceRecord{_tick,
+									   _traceInstance,
+									   request.origin,
+									   request.stateId,
+									   convert(request.type),
+									   method});
+}
 
-	HFSM_INLINE bool	wideForwardExitGuard (GuardControl&	control,							const ProngConstBits prongs);
-	HFSM_INLINE bool	wideForwardExitGuard (GuardControl&	control);
-	HFSM_INLINE bool	wideExitGuard		 (GuardControl&	control);
+#endif
 
-	HFSM_INLINE void	wideExit			 (PlanControl&	control);
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	HFSM_INLINE void	wideDestruct		 (PlanControl&  control);
+#ifdef HFSM_ENABLE_STATISTICS
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template <typename TG, typename TA>
+void
+R_<TG, TA>::attachStatistics(Statistics* const statistics) {
+	_statistics = statistics;
 
-	HFSM_INLINE void	wideForwardActive	 (Control& control, const Request::Type request,	const ProngConstBits prongs);
-	HFSM_INLINE void	wideForwardRequest	 (Control& control, const Request::Type request,	const ProngConstBits prongs);
+	if (_statistics)
+		for (StateID s = 0; s < STATE_COUNT; ++s)
+			if (isActive(s))
+				_statistics->recordEnter(s);
+}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	HFSM_INLINE void	wideRequestChange	 (Control& control);
-	HFSM_INLINE void	wideRequestRemain	 (Registry& registry);
-	HFSM_INLINE void	wideRequestRestart	 (Registry& registry);
-	HFSM_INLINE void	wideRequestResume	 (Registry& registry);
-	HFSM_INLINE void	wideRequestUtilize	 (Control& control);
-	HFSM_INLINE void	wideRequestRandomize (Control& control);
+template <typename TG, typename TA>
+void
+R_<TG, TA>::countRequests(const Requests& requests,
+						  const bool cancelled)
+{
+	if (_statistics)
+		for (const auto& request : requests)
+			if (request.type != Request::SCHEDULE) {
+				if (cancelled)
+					_statistics->recordCancelled(request.stateId);
+				else
+					_statistics->recordTransition(request.origin, request.stateId);
+			}
+}
 
-	HFSM_INLINE Utility	wideReportChange	 (Control& control);
-	HFSM_INLINE Utility	wideReportUtilize	 (Control& control);
-	HFSM_INLINE Utility	wideReportRandomize	 (Control& control);
+#endif
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	HFSM_INLINE void	wideChangeToRequested(PlanControl& control);
+#ifdef HFSM_ENABLE_WATCHDOG
 
-	//----------------------------------------------------------------------
+template <typename TG, typename TA>
+void
+R_<TG, TA>::watchRounds(const LongIndex rounds) {
+	if (_watchdog.recordRounds(rounds, _requests.count() != 0)) {
+		HFSM_IF_LOGGER(if (_logger) _logger->recordWatchdogEvent(_context,
+																 WatchdogEvent::SUBSTITUTION_LIMIT,
+																 INVALID_STATE_ID,
+																 INVALID_STATE_ID));
+	}
+}
 
-#ifdef HFSM_ENABLE_STRUCTURE_REPORT
-	using StructureStateInfos = typename Args::StructureStateInfos;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	static constexpr LongIndex NAME_COUNT	 = Initial::NAME_COUNT  + Remaining::NAME_COUNT;
+template <typename TG, typename TA>
+void
+R_<TG, TA>::watchRequests(const Requests& requests) {
+	for (const auto& request : requests)
+		if (request.type != Request::SCHEDULE &&
+			_watchdog.recordTransition(request.origin, request.stateId))
+		{
+			HFSM_IF_LOGGER(if (_logger) _logger->recordWatchdogEvent(_context,
+																	 WatchdogEvent::OSCILLATION,
+																	 request.origin,
+																	 request.stateId));
+		}
+}
 
-	void wideGetNames(const LongIndex parent,
-					  const ShortIndex depth,
-					  StructureStateInfos& stateInfos) const;
 #endif
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+////////////////////////////////////////////////////////////////////////////////
 
-#ifdef HFSM_ENABLE_SERIALIZATION
-	using WriteStream	= typename Args::WriteStream;
-	using ReadStream	= typename Args::ReadStream;
+}
+}
 
-	HFSM_INLINE void	wideSaveActive	 (const Registry& registry, WriteStream& stream) const;
-	HFSM_INLINE void	wideSaveResumable(const Registry& registry, WriteStream& stream) const;
+#ifdef HFSM_ENABLE_POOL
 
-	HFSM_INLINE void	wideLoadRequested(		Registry& registry, ReadStream&  stream) const;
-	HFSM_INLINE void	wideLoadResumable(		Registry& registry, ReadStream&  stream) const;
-#endif
+namespace hfsm2 {
 
-	//----------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
 
-	Initial initial;
-	Remaining remaining;
-};
+// Default time source for PoolT::updateFor(), steady_clock nanoseconds
+//  Any type with 'static uint64_t now()' can replace it, e.g. one reading rdtsc
 
-////////////////////////////////////////////////////////////////////////////////
+struct PoolClock {
+	static HFSM_INLINE uint64_t now();
+};
 
-template <typename TIndices,
-		  typename TArgs,
-		  ShortIndex NIndex,
-		  typename TInitial>
-struct OS_<TIndices, TArgs, NIndex, TInitial> final {
-	using Indices		= TIndices;
-	static constexpr StateID	INITIAL_ID	= Indices::STATE_ID;
-	static constexpr ShortIndex COMPO_INDEX	= Indices::COMPO_INDEX;
-	static constexpr ShortIndex ORTHO_INDEX	= Indices::ORTHO_INDEX;
-	static constexpr ShortIndex ORTHO_UNIT	= Indices::ORTHO_UNIT;
+//------------------------------------------------------------------------------
 
-	static constexpr ShortIndex PRONG_INDEX	= NIndex;
+// Visiting orders for PoolT::updateFor()
+//  RoundRobinOrder	- resume from the first machine left out by the previous call
+//  StarvationOrder	- machines that waited longest go first
+//  Custom orders provide
+//   'float operator()(const uint32_t handle, const Instance& machine, const uint32_t staleness) const',
+//   higher values are updated first, e.g. inverse camera distance for LOD
 
-	using Args			= TArgs;
-	using Rank			= typename Args::Rank;
-	using Utility		= typename Args::Utility;
-	using UP			= typename Args::UP;
+struct RoundRobinOrder {};
 
-	using Registry		= RegistryT<Args>;
-	using StateParents	= typename Registry::StateParents;
-	using OrthoForks	= typename Registry::OrthoForks;
-	using ProngBits		= typename OrthoForks::Bits;
-	using ProngConstBits= typename OrthoForks::ConstBits;
+struct StarvationOrder {
+	template <typename TInstance>
+	HFSM_INLINE float operator() (const uint32_t /*handle*/,
+								  const TInstance& /*machine*/,
+								  const uint32_t staleness) const	{ return (float) staleness;				}
+};
 
-	using Control		= ControlT	   <Args>;
-	using PlanControl	= PlanControlT <Args>;
-	using FullControl	= FullControlT <Args>;
-	using GuardControl	= GuardControlT<Args>;
+//------------------------------------------------------------------------------
 
-	using Initial		= Material<I_<INITIAL_ID,
-									  COMPO_INDEX,
-									  ORTHO_INDEX,
-									  ORTHO_UNIT>,
-								   Args,
-								   TInitial>;
+// Scheduler for a pool of machines of the same type, available with HFSM_ENABLE_POOL
+//  Machines are owned by the caller and registered with add()
+//  Only awake machines are updated, a machine goes dormant once
+//  R_::needsUpdate() reports it has nothing left to do,
+//  and wakes up on react() through the pool, or on wake() / refresh()
+//  Storage is sized by 'NCapacity', large pools are best allocated on the heap
+//  Staleness counts pool updates since the machine was last updated
+//  With HFSM_ENABLE_POOL_INDEX, the pool also keeps a list of machines per active state,
+//  updated only for the states a machine entered or exited, see R_::activityChanges(),
+//  memory use is 'NCapacity * STATE_COUNT * 8' bytes
 
-	using Info	= OSI_<TInitial>;
+template <typename TInstance,
+		  uint32_t NCapacity,
+		  typename TClock = PoolClock>
+class PoolT {
+public:
+	using Instance = TInstance;
+	using Handle   = uint32_t;
+	using Clock	   = TClock;
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	static constexpr uint32_t CAPACITY		 = NCapacity;
+	static constexpr Handle	  INVALID_HANDLE = (Handle) -1;
 
-#ifdef HFSM_EXPLICIT_MEMBER_SPECIALIZATION
-	template <typename T>
-	HFSM_INLINE		  T& access()			 { return initial.template access<T>();	}
+#ifdef HFSM_ENABLE_POOL_INDEX
+	static constexpr LongIndex STATE_COUNT	 = Instance::STATE_COUNT;
 
-	template <typename T>
-	HFSM_INLINE const T& access() const		 { return initial.template access<T>();	}
-#endif
+	struct Members {
+		HFSM_INLINE const Handle* begin() const							{ return first;							}
+		HFSM_INLINE const Handle* end()	const							{ return first + size;					}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+		HFSM_INLINE uint32_t count() const								{ return size;							}
 
-	HFSM_INLINE void	wideRegister		 (Registry& registry, const ForkID forkId);
+		const Handle* first;
+		uint32_t size;
+	};
+#endif
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	HFSM_INLINE PoolT();
 
-	HFSM_INLINE bool	wideForwardEntryGuard(GuardControl&	control,							const ProngConstBits prongs);
-	HFSM_INLINE bool	wideForwardEntryGuard(GuardControl&	control);
-	HFSM_INLINE bool	wideEntryGuard		 (GuardControl&	control);
+	// Register 'machine', returns INVALID_HANDLE if the pool is full
+	HFSM_INLINE Handle add(Instance& machine);
+	HFSM_INLINE void remove(const Handle handle);
 
-	HFSM_INLINE void	wideConstruct		 (PlanControl&	control);
+	HFSM_INLINE		  Instance& operator[] (const Handle handle)		{ return *_machines[handle];			}
+	HFSM_INLINE const Instance& operator[] (const Handle handle) const	{ return *_machines[handle];			}
 
-	HFSM_INLINE void	wideEnter			 (PlanControl&	control);
-	HFSM_INLINE void	wideReenter			 (PlanControl&	control);
+	HFSM_INLINE uint32_t count() const									{ return _count;						}
+	HFSM_INLINE uint32_t awakeCount() const								{ return _awakeCount;					}
 
-	HFSM_INLINE Status	wideUpdate			 (FullControl&	control);
+	HFSM_INLINE bool isAwake(const Handle handle) const;
 
-	template <typename TEvent>
-	HFSM_INLINE Status	wideReact			 (FullControl&	control, const TEvent& event);
+	// Pool updates since the machine's last update, 1 for a machine updated every time
+	//  Stays at the pre-update value while the machine itself is being updated
+	HFSM_INLINE uint32_t staleness(const Handle handle) const;
 
-	HFSM_INLINE bool	wideForwardExitGuard (GuardControl&	control,							const ProngConstBits prongs);
-	HFSM_INLINE bool	wideForwardExitGuard (GuardControl&	control);
-	HFSM_INLINE bool	wideExitGuard		 (GuardControl&	control);
+	// Machine being updated right now, INVALID_HANDLE outside of update() / updateFor()
+	HFSM_INLINE Handle current() const									{ return _current;						}
 
-	HFSM_INLINE void	wideExit			 (PlanControl&	control);
+#ifdef HFSM_ENABLE_POOL_INDEX
+	// Machines with the state active, in no particular order
+	//  Invalidated by any pool call that can change a machine
+	HFSM_INLINE Members inState(const StateID stateId) const;
 
-	HFSM_INLINE void	wideDestruct		 (PlanControl&  control);
+	template <typename TState>
+	HFSM_INLINE Members inState() const			{ return inState(Instance::template stateId<TState>());	}
+#endif
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	// Update awake machines, putting idle ones to sleep
+	HFSM_INLINE void update();
 
-	HFSM_INLINE void	wideForwardActive	 (Control& control, const Request::Type request,	const ProngConstBits prongs);
-	HFSM_INLINE void	wideForwardRequest	 (Control& control, const Request::Type request,	const ProngConstBits prongs);
+	// Update awake machines in 'order' until 'budget' clock ticks are spent,
+	//  returns the number of machines updated
+	//  The clock is sampled after every 'checkInterval' machines,
+	//  so the budget can be overrun by up to 'checkInterval - 1' updates
+	template <typename TOrder = RoundRobinOrder>
+	HFSM_INLINE uint32_t updateFor(const uint64_t budget,
+								   const TOrder& order = TOrder{},
+								   const uint32_t checkInterval = 8);
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	// React on a single machine, waking it if needed
+	template <typename TEvent>
+	HFSM_INLINE void react(const Handle handle,
+						   const TEvent& event);
 
-	HFSM_INLINE void	wideRequestChange	 (Control& control);
-	HFSM_INLINE void	wideRequestRemain	 (Registry& registry);
-	HFSM_INLINE void	wideRequestRestart	 (Registry& registry);
-	HFSM_INLINE void	wideRequestResume	 (Registry& registry);
-	HFSM_INLINE void	wideRequestUtilize	 (Control& control);
-	HFSM_INLINE void	wideRequestRandomize (Control& control);
+	// React on every registered machine
+	template <typename TEvent>
+	HFSM_INLINE void react(const TEvent& event);
 
-	HFSM_INLINE Utility	wideReportChange	 (Control& control);
-	HFSM_INLINE Utility	wideReportUtilize	 (Control& control);
-	HFSM_INLINE Utility	wideReportRandomize	 (Control& control);
+	// Keep the machine awake until its next update()
+	HFSM_INLINE void wake(const Handle handle);
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	// Re-check the machine after changing it outside of the pool, e.g. after changeTo()
+	HFSM_INLINE void refresh(const Handle handle);
 
-	HFSM_INLINE void	wideChangeToRequested(PlanControl& control);
+private:
+	HFSM_INLINE void sleep(const Handle handle);
 
-	//----------------------------------------------------------------------
+	// Update a single machine, returns false if it went to sleep
+	HFSM_INLINE bool updateMachine(const Handle handle);
 
-#ifdef HFSM_ENABLE_STRUCTURE_REPORT
-	using StructureStateInfos = typename Args::StructureStateInfos;
+	HFSM_INLINE void arrange(const RoundRobinOrder& order);
 
-	static constexpr LongIndex NAME_COUNT	 = Initial::NAME_COUNT;
+	template <typename TOrder>
+	HFSM_INLINE void arrange(const TOrder& order);
 
-	void wideGetNames(const LongIndex parent,
-					  const ShortIndex depth,
-					  StructureStateInfos& stateInfos) const;
+#ifdef HFSM_ENABLE_POOL_INDEX
+	HFSM_INLINE void reindex(const Handle handle);
+	HFSM_INLINE void rescan(const Handle handle);
+	HFSM_INLINE void relist(const Handle handle, const StateID stateId);
+	HFSM_INLINE void enlist(const Handle handle, const StateID stateId);
+	HFSM_INLINE void delist(const Handle handle, const StateID stateId);
 #endif
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+private:
+	Instance* _machines[CAPACITY];
+	uint32_t _awakeIndices[CAPACITY];		// position in '_awake', INVALID_HANDLE if dormant
+	uint32_t _lastUpdates[CAPACITY];		// '_tick' of the last update
 
-#ifdef HFSM_ENABLE_SERIALIZATION
-	using WriteStream	= typename Args::WriteStream;
-	using ReadStream	= typename Args::ReadStream;
+	Handle _order[CAPACITY];				// visiting order of the current updateFor()
+	float _priorities[CAPACITY];
 
-	HFSM_INLINE void	wideSaveActive	 (const Registry& registry, WriteStream& stream) const;
-	HFSM_INLINE void	wideSaveResumable(const Registry& registry, WriteStream& stream) const;
+	Handle _awake[CAPACITY];
+	uint32_t _awakeCount = 0;
 
-	HFSM_INLINE void	wideLoadRequested(		Registry& registry, ReadStream&  stream) const;
-	HFSM_INLINE void	wideLoadResumable(		Registry& registry, ReadStream&  stream) const;
-#endif
+	Handle _free[CAPACITY];
+	uint32_t _freeCount = 0;
 
-	//----------------------------------------------------------------------
+	uint32_t _used = 0;						// high-water mark of handles
+	uint32_t _count = 0;
 
-	Initial initial;
+	uint32_t _tick = 0;
+	uint32_t _cursor = 0;					// RoundRobinOrder start, position in '_awake'
+	Handle _current = INVALID_HANDLE;
+
+#ifdef HFSM_ENABLE_POOL_INDEX
+	Handle _members[STATE_COUNT * CAPACITY];		// per-state lists, 'CAPACITY' slots each
+	uint32_t _memberCounts[STATE_COUNT];
+	uint32_t _positions[CAPACITY * STATE_COUNT];	// position in the state's list, INVALID_HANDLE if absent
+#endif
 };
 
 ////////////////////////////////////////////////////////////////////////////////
 
-}
 }
 
 namespace hfsm2 {
-namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-#ifdef HFSM_EXPLICIT_MEMBER_SPECIALIZATION
+inline
+uint64_t
+PoolClock::now() {
+	return (uint64_t) std::chrono::duration_cast<std::chrono::nanoseconds>(
+						  std::chrono::steady_clock::now().time_since_epoch()).count();
+}
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
-template <typename T>
-T&
-OS_<TN, TA, NI, TI, TR...>::access() {
-	return InitialStates::template contains<T>() ?
-		initial  .template access<T>() :
-		remaining.template access<T>();
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TI, uint32_t NC, typename TC>
+PoolT<TI, NC, TC>::PoolT() {
+	for (uint32_t i = 0; i < CAPACITY; ++i) {
+		_machines[i]	 = nullptr;
+		_awakeIndices[i] = INVALID_HANDLE;
+		_lastUpdates[i]	 = 0;
+	}
+
+#ifdef HFSM_ENABLE_POOL_INDEX
+	for (StateID s = 0; s < STATE_COUNT; ++s)
+		_memberCounts[s] = 0;
+
+	for (uint32_t i = 0; i < CAPACITY * STATE_COUNT; ++i)
+		_positions[i] = INVALID_HANDLE;
+#endif
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
-template <typename T>
-const T&
-OS_<TN, TA, NI, TI, TR...>::access() const {
-	return InitialStates::template contains<T>() ?
-		initial  .template access<T>() :
-		remaining.template access<T>();
-}
+template <typename TI, uint32_t NC, typename TC>
+typename PoolT<TI, NC, TC>::Handle
+PoolT<TI, NC, TC>::add(Instance& machine) {
+	Handle handle;
 
-#endif
+	if (_freeCount)
+		handle = _free[--_freeCount];
+	else if (_used < CAPACITY)
+		handle = _used++;
+	else
+		return INVALID_HANDLE;
 
-//------------------------------------------------------------------------------
+	_machines[handle] = &machine;
+	_lastUpdates[handle] = _tick;
+	++_count;
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
-void
-OS_<TN, TA, NI, TI, TR...>::wideRegister(Registry& registry,
-										 const ForkID forkId)
-{
-	initial  .deepRegister(registry, Parent{forkId, PRONG_INDEX});
-	remaining.wideRegister(registry, forkId);
+	HFSM_IF_POOL_INDEX(rescan(handle));
+
+	refresh(handle);
+
+	return handle;
 }
 
-//------------------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
-bool
-OS_<TN, TA, NI, TI, TR...>::wideForwardEntryGuard(GuardControl& control,
-												  const ProngConstBits prongs)
-{
-	const bool i = prongs.get(PRONG_INDEX) ?
-				   initial  .deepForwardEntryGuard(control) : false;
+template <typename TI, uint32_t NC, typename TC>
+void
+PoolT<TI, NC, TC>::remove(const Handle handle) {
+	HFSM_ASSERT(handle < _used && _machines[handle]);
 
-	const bool r = remaining.wideForwardEntryGuard(control, prongs);
+	sleep(handle);
+
+#ifdef HFSM_ENABLE_POOL_INDEX
+	for (StateID s = 0; s < STATE_COUNT; ++s)
+		if (_positions[handle * STATE_COUNT + s] != INVALID_HANDLE)
+			delist(handle, s);
+#endif
+
+	_machines[handle] = nullptr;
+	_free[_freeCount++] = handle;
+	--_count;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TI, uint32_t NC, typename TC>
+bool
+PoolT<TI, NC, TC>::isAwake(const Handle handle) const {
+	HFSM_ASSERT(handle < CAPACITY);
 
-	return i || r;
+	return _awakeIndices[handle] != INVALID_HANDLE;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
-bool
-OS_<TN, TA, NI, TI, TR...>::wideForwardEntryGuard(GuardControl& control) {
-	const bool i = initial  .deepForwardEntryGuard(control);
-	const bool r = remaining.wideForwardEntryGuard(control);
+template <typename TI, uint32_t NC, typename TC>
+uint32_t
+PoolT<TI, NC, TC>::staleness(const Handle handle) const {
+	HFSM_ASSERT(handle < CAPACITY);
 
-	return i || r;
+	return _tick - _lastUpdates[handle];
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
-bool
-OS_<TN, TA, NI, TI, TR...>::wideEntryGuard(GuardControl& control) {
-	const bool i = initial  .deepEntryGuard(control);
-	const bool r = remaining.wideEntryGuard(control);
+#ifdef HFSM_ENABLE_POOL_INDEX
 
-	return i || r;
+template <typename TI, uint32_t NC, typename TC>
+typename PoolT<TI, NC, TC>::Members
+PoolT<TI, NC, TC>::inState(const StateID stateId) const {
+	HFSM_ASSERT(stateId < STATE_COUNT);
+
+	return Members{_members + stateId * CAPACITY, _memberCounts[stateId]};
 }
 
+#endif
+
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+template <typename TI, uint32_t NC, typename TC>
 void
-OS_<TN, TA, NI, TI, TR...>::wideConstruct(PlanControl& control) {
-	initial	 .deepConstruct(control);
-	remaining.wideConstruct(control);
+PoolT<TI, NC, TC>::update() {
+	++_tick;
+
+	// the last awake machine takes the slot of a sleeping one, visit it next
+	for (uint32_t i = 0; i < _awakeCount; )
+		if (updateMachine(_awake[i]))
+			++i;
 }
 
-//------------------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
-void
-OS_<TN, TA, NI, TI, TR...>::wideEnter(PlanControl& control) {
-	initial  .deepEnter(control);
-	remaining.wideEnter(control);
+template <typename TI, uint32_t NC, typename TC>
+template <typename TOrder>
+uint32_t
+PoolT<TI, NC, TC>::updateFor(const uint64_t budget,
+							 const TOrder& order,
+							 const uint32_t checkInterval)
+{
+	HFSM_ASSERT(checkInterval);
+
+	++_tick;
+
+	const uint32_t total = _awakeCount;
+	if (total == 0)
+		return 0;
+
+	// '_order' is a snapshot, machines going to sleep don't disturb it
+	arrange(order);
+
+	const uint64_t start = Clock::now();
+
+	uint32_t i = 0;
+	for (uint32_t untilCheck = checkInterval; i < total; ) {
+		updateMachine(_order[i++]);
+
+		if (--untilCheck == 0) {
+			if (Clock::now() - start >= budget)
+				break;
+
+			untilCheck = checkInterval;
+		}
+	}
+
+	// start the next round-robin pass from the first machine left out
+	_cursor = 0;
+	if (i < total) {
+		const uint32_t index = _awakeIndices[_order[i]];
+
+		if (index != INVALID_HANDLE)
+			_cursor = index;
+	}
+
+	return i;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+template <typename TI, uint32_t NC, typename TC>
+template <typename TEvent>
 void
-OS_<TN, TA, NI, TI, TR...>::wideReenter(PlanControl& control) {
-	initial  .deepReenter(control);
-	remaining.wideReenter(control);
-}
+PoolT<TI, NC, TC>::react(const Handle handle,
+					 const TEvent& event)
+{
+	HFSM_ASSERT(handle < _used && _machines[handle]);
 
-//------------------------------------------------------------------------------
+	_machines[handle]->react(event);
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
-Status
-OS_<TN, TA, NI, TI, TR...>::wideUpdate(FullControl& control) {
-	const auto status =	   initial	.deepUpdate(control);
-	return combine(status, remaining.wideUpdate(control));
+	refresh(handle);
 }
 
-//------------------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+template <typename TI, uint32_t NC, typename TC>
 template <typename TEvent>
-Status
-OS_<TN, TA, NI, TI, TR...>::wideReact(FullControl& control,
-									  const TEvent& event)
-{
-	const auto status =	   initial	.deepReact(control, event);
-	return combine(status, remaining.wideReact(control, event));
+void
+PoolT<TI, NC, TC>::react(const TEvent& event) {
+	for (Handle handle = 0; handle < _used; ++handle)
+		if (_machines[handle])
+			react(handle, event);
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
-bool
-OS_<TN, TA, NI, TI, TR...>::wideForwardExitGuard(GuardControl& control,
-												 const ProngConstBits prongs)
-{
-	const bool i = prongs.get(PRONG_INDEX) ?
-				   initial  .deepForwardExitGuard(control) : false;
+template <typename TI, uint32_t NC, typename TC>
+void
+PoolT<TI, NC, TC>::wake(const Handle handle) {
+	HFSM_ASSERT(handle < _used && _machines[handle]);
 
-	const bool r = remaining.wideForwardExitGuard(control, prongs);
+	if (_awakeIndices[handle] == INVALID_HANDLE) {
+		_awakeIndices[handle] = _awakeCount;
+		_awake[_awakeCount++] = handle;
+	}
+}
 
-	return i || r;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TI, uint32_t NC, typename TC>
+void
+PoolT<TI, NC, TC>::refresh(const Handle handle) {
+	HFSM_ASSERT(handle < _used && _machines[handle]);
+
+	HFSM_IF_POOL_INDEX(reindex(handle));
+
+	if (_machines[handle]->needsUpdate())
+		wake(handle);
+	else
+		sleep(handle);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
-bool
-OS_<TN, TA, NI, TI, TR...>::wideForwardExitGuard(GuardControl& control) {
-	const bool i = initial  .deepForwardExitGuard(control);
-	const bool r = remaining.wideForwardExitGuard(control);
+template <typename TI, uint32_t NC, typename TC>
+void
+PoolT<TI, NC, TC>::sleep(const Handle handle) {
+	const uint32_t index = _awakeIndices[handle];
 
-	return i || r;
+	if (index != INVALID_HANDLE) {
+		const Handle last = _awake[--_awakeCount];
+
+		_awake[index] = last;
+		_awakeIndices[last] = index;
+		_awakeIndices[handle] = INVALID_HANDLE;
+	}
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+template <typename TI, uint32_t NC, typename TC>
 bool
-OS_<TN, TA, NI, TI, TR...>::wideExitGuard(GuardControl& control) {
-	const bool i = initial  .deepExitGuard(control);
-	const bool r = remaining.wideExitGuard(control);
+PoolT<TI, NC, TC>::updateMachine(const Handle handle) {
+	Instance& machine = *_machines[handle];
 
-	return i || r;
-}
+	_current = handle;
+	machine.update();
+	_current = INVALID_HANDLE;
 
-//------------------------------------------------------------------------------
+	_lastUpdates[handle] = _tick;
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
-void
-OS_<TN, TA, NI, TI, TR...>::wideExit(PlanControl& control) {
-	initial	 .deepExit(control);
-	remaining.wideExit(control);
-}
+	HFSM_IF_POOL_INDEX(reindex(handle));
 
-//------------------------------------------------------------------------------
+	if (machine.needsUpdate())
+		return true;
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
-void
-OS_<TN, TA, NI, TI, TR...>::wideDestruct(PlanControl& control) {
-	initial	 .deepDestruct(control);
-	remaining.wideDestruct(control);
+	sleep(handle);
+
+	return false;
 }
 
-//------------------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+template <typename TI, uint32_t NC, typename TC>
 void
-OS_<TN, TA, NI, TI, TR...>::wideForwardActive(Control& control,
-											  const Request::Type request,
-											  const ProngConstBits prongs)
-{
-	const Request::Type local = prongs.get(PRONG_INDEX) ?
-		request : Request::REMAIN;
+PoolT<TI, NC, TC>::arrange(const RoundRobinOrder& /*order*/) {
+	const uint32_t start = _cursor < _awakeCount ? _cursor : 0;
 
-	initial	 .deepForwardActive(control, local);
-	remaining.wideForwardActive(control, request, prongs);
+	uint32_t o = 0;
+	for (uint32_t i = start; i < _awakeCount; ++i)
+		_order[o++] = _awake[i];
+	for (uint32_t i = 0; i < start; ++i)
+		_order[o++] = _awake[i];
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+template <typename TI, uint32_t NC, typename TC>
+template <typename TOrder>
 void
-OS_<TN, TA, NI, TI, TR...>::wideForwardRequest(Control& control,
-											   const Request::Type request,
-											   const ProngConstBits prongs)
-{
-	const Request::Type local = prongs.get(PRONG_INDEX) ?
-		request : Request::REMAIN;
+PoolT<TI, NC, TC>::arrange(const TOrder& order) {
+	for (uint32_t i = 0; i < _awakeCount; ++i) {
+		const Handle handle = _awake[i];
 
-	initial	 .deepForwardRequest(control, local);
-	remaining.wideForwardRequest(control, request, prongs);
+		_order[i] = handle;
+		_priorities[handle] = order(handle, *_machines[handle], staleness(handle));
+	}
+
+	std::sort(_order,
+			  _order + _awakeCount,
+			  [this](const Handle l, const Handle r) { return _priorities[l] > _priorities[r]; });
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+#ifdef HFSM_ENABLE_POOL_INDEX
+
+template <typename TI, uint32_t NC, typename TC>
 void
-OS_<TN, TA, NI, TI, TR...>::wideRequestChange(Control& control) {
-	initial  .deepRequestChange(control);
-	remaining.wideRequestChange(control);
-}
+PoolT<TI, NC, TC>::reindex(const Handle handle) {
+	Instance& machine = *_machines[handle];
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	const typename Instance::ActivityChanges& changes = machine.activityChanges();
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
-void
-OS_<TN, TA, NI, TI, TR...>::wideRequestRemain(Registry& registry) {
-	initial	 .deepRequestRemain(registry);
-	remaining.wideRequestRemain(registry);
+	for (LongIndex c = 0; c < changes.states.count(); ++c)
+		relist(handle, changes.states[c]);
+
+	machine.clearActivityChanges();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+template <typename TI, uint32_t NC, typename TC>
 void
-OS_<TN, TA, NI, TI, TR...>::wideRequestRestart(Registry& registry) {
-	initial	 .deepRequestRestart(registry);
-	remaining.wideRequestRestart(registry);
+PoolT<TI, NC, TC>::rescan(const Handle handle) {
+	for (StateID s = 0; s < STATE_COUNT; ++s)
+		relist(handle, s);
+
+	_machines[handle]->clearActivityChanges();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+template <typename TI, uint32_t NC, typename TC>
 void
-OS_<TN, TA, NI, TI, TR...>::wideRequestResume(Registry& registry) {
-	initial	 .deepRequestResume(registry);
-	remaining.wideRequestResume(registry);
+PoolT<TI, NC, TC>::relist(const Handle handle,
+						  const StateID stateId)
+{
+	const bool listed = _positions[handle * STATE_COUNT + stateId] != INVALID_HANDLE;
+
+	if (_machines[handle]->isActive(stateId)) {
+		if (!listed)
+			enlist(handle, stateId);
+	} else {
+		if (listed)
+			delist(handle, stateId);
+	}
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+template <typename TI, uint32_t NC, typename TC>
 void
-OS_<TN, TA, NI, TI, TR...>::wideRequestUtilize(Control& control) {
-	initial  .deepRequestUtilize(control);
-	remaining.wideRequestUtilize(control);
+PoolT<TI, NC, TC>::enlist(const Handle handle,
+						  const StateID stateId)
+{
+	const uint32_t position = _memberCounts[stateId]++;
+
+	_members[stateId * CAPACITY + position] = handle;
+	_positions[handle * STATE_COUNT + stateId] = position;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
+template <typename TI, uint32_t NC, typename TC>
 void
-OS_<TN, TA, NI, TI, TR...>::wideRequestRandomize(Control& control) {
-	initial  .deepRequestRandomize(control);
-	remaining.wideRequestRandomize(control);
+PoolT<TI, NC, TC>::delist(const Handle handle,
+						  const StateID stateId)
+{
+	Handle* const members = _members + stateId * CAPACITY;
+
+	const uint32_t position = _positions[handle * STATE_COUNT + stateId];
+	const Handle last = members[--_memberCounts[stateId]];
+
+	members[position] = last;
+	_positions[last	  * STATE_COUNT + stateId] = position;
+	_positions[handle * STATE_COUNT + stateId] = INVALID_HANDLE;
 }
 
-//------------------------------------------------------------------------------
+#endif
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
-typename TA::Utility
-OS_<TN, TA, NI, TI, TR...>::wideReportChange(Control& control) {
-	const UP	  i = initial  .deepReportChange(control);
-	const Utility r = remaining.wideReportChange(control);
+////////////////////////////////////////////////////////////////////////////////
 
-	return i.utility + r;
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+#endif
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
-typename TA::Utility
-OS_<TN, TA, NI, TI, TR...>::wideReportUtilize(Control& control) {
-	const UP	  i = initial  .deepReportUtilize(control);
-	const Utility r = remaining.wideReportUtilize(control);
+namespace hfsm2 {
 
-	return i.utility + r;
-}
+////////////////////////////////////////////////////////////////////////////////
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// Machine of any SchedulerT<> type, stays valid until the machine is removed
+//  'generation' tells a removed machine from a newer one in the same slot
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
-typename TA::Utility
-OS_<TN, TA, NI, TI, TR...>::wideReportRandomize(Control& control) {
-	const Utility i = initial  .deepReportRandomize(control);
-	const Utility r = remaining.wideReportRandomize(control);
+struct SchedulerHandle {
+	static constexpr uint16_t INVALID = UINT16_MAX;
 
-	return i + r;
-}
+	HFSM_INLINE bool operator == (const SchedulerHandle other) const {
+		return type == other.type && slot == other.slot && generation == other.generation;
+	}
 
-//------------------------------------------------------------------------------
+	HFSM_INLINE bool operator != (const SchedulerHandle other) const	{ return !operator == (other);			}
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
-void
-OS_<TN, TA, NI, TI, TR...>::wideChangeToRequested(PlanControl& control) {
-	initial	 .deepChangeToRequested(control);
-	remaining.wideChangeToRequested(control);
-}
+	uint16_t type = INVALID;
+	uint16_t slot = INVALID;
+	uint32_t generation = 0;
+};
+
+namespace detail {
 
 //------------------------------------------------------------------------------
 
-#ifdef HFSM_ENABLE_STRUCTURE_REPORT
+// Machines of a single type, constructed in place in a contiguous slot array
+//  Machines never move, the dense list keeps live slots for iteration
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
-void
-OS_<TN, TA, NI, TI, TR...>::wideGetNames(const LongIndex parent,
-										 const ShortIndex depth,
-										 StructureStateInfos& stateInfos) const
-{
-	initial	 .deepGetNames(parent, StructureStateInfo::ORTHOGONAL, depth, stateInfos);
-	remaining.wideGetNames(parent,								   depth, stateInfos);
-}
+template <typename TInstance, uint32_t NCapacity>
+class SchedulerPoolT {
+public:
+	using Instance = TInstance;
 
-#endif
+	static constexpr uint32_t CAPACITY = NCapacity;
+	static constexpr uint16_t INVALID  = SchedulerHandle::INVALID;
+
+	static_assert(CAPACITY < INVALID, "Scheduler capacity is limited to 65534 machines per type");
+
+	HFSM_INLINE SchedulerPoolT();
+	HFSM_INLINE ~SchedulerPoolT();
+
+	SchedulerPoolT(const SchedulerPoolT&) = delete;
+	SchedulerPoolT& operator = (const SchedulerPoolT&) = delete;
+
+	// Slot of the new machine, INVALID if the pool is full
+	template <typename... TArgs>
+	HFSM_INLINE uint16_t emplace(TArgs&&... args);
+
+	HFSM_INLINE void remove(const uint16_t slot);
+
+	HFSM_INLINE bool contains(const uint16_t slot,
+							  const uint32_t generation) const;
+
+	HFSM_INLINE uint32_t generation(const uint16_t slot) const			{ return _generations[slot];			}
+
+	HFSM_INLINE		  Instance& operator[] (const uint16_t slot)		{ return *instance(slot);				}
+	HFSM_INLINE const Instance& operator[] (const uint16_t slot) const	{ return *instance(slot);				}
+
+	HFSM_INLINE uint32_t count() const									{ return _count;						}
+
+	HFSM_INLINE void update();
+
+	template <typename TEvent>
+	HFSM_INLINE void react(const TEvent& event);
+
+	template <typename TFunction>
+	HFSM_INLINE void forEach(TFunction&& function);
+
+private:
+	HFSM_INLINE		  Instance* instance(const uint16_t slot)			{ return reinterpret_cast<		Instance*>(&_storage[slot]);	}
+	HFSM_INLINE const Instance* instance(const uint16_t slot) const		{ return reinterpret_cast<const Instance*>(&_storage[slot]);	}
+
+private:
+	using Storage = typename std::aligned_storage<sizeof(Instance), alignof(Instance)>::type;
+
+	Storage _storage[CAPACITY];
+	uint32_t _generations[CAPACITY];		// bumped on remove()
+
+	uint16_t _dense[CAPACITY];				// live slots, in update order
+	uint16_t _denseIndices[CAPACITY];		// position in '_dense', INVALID if the slot is empty
+
+	uint16_t _free[CAPACITY];
+	uint16_t _freeCount = 0;
+
+	uint16_t _used = 0;						// high-water mark of slots
+	uint16_t _count = 0;
+};
 
 //------------------------------------------------------------------------------
 
-#ifdef HFSM_ENABLE_SERIALIZATION
+// One pool per machine type, 'NIndex' being the type's position in the scheduler
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
-void
-OS_<TN, TA, NI, TI, TR...>::wideSaveActive(const Registry& registry,
-										   WriteStream& stream) const
+template <uint32_t, LongIndex, typename...>
+struct SchedulerPoolsT;
+
+template <uint32_t NCapacity, LongIndex NIndex, typename TInstance, typename... TRest>
+struct SchedulerPoolsT<NCapacity, NIndex, TInstance, TRest...>
+	: SchedulerPoolsT<NCapacity, NIndex + 1, TRest...>
 {
-	initial	 .deepSaveActive(registry, stream);
-	remaining.wideSaveActive(registry, stream);
-}
+	using Next = SchedulerPoolsT<NCapacity, NIndex + 1, TRest...>;
+	using Pool = SchedulerPoolT<TInstance, NCapacity>;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	using Next::pool;
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
-void
-OS_<TN, TA, NI, TI, TR...>::wideSaveResumable(const Registry& registry,
-											  WriteStream& stream) const
-{
-	initial	 .deepSaveResumable(registry, stream);
-	remaining.wideSaveResumable(registry, stream);
-}
+	HFSM_INLINE		  Pool& pool(const TypeTagT<TInstance>)				{ return _pool;							}
+	HFSM_INLINE const Pool& pool(const TypeTagT<TInstance>) const		{ return _pool;							}
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	HFSM_INLINE bool remove(const SchedulerHandle handle);
+	HFSM_INLINE bool contains(const SchedulerHandle handle) const;
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
-void
-OS_<TN, TA, NI, TI, TR...>::wideLoadRequested(Registry& registry,
-											  ReadStream& stream) const
-{
-	initial	 .deepLoadRequested(registry, stream);
-	remaining.wideLoadRequested(registry, stream);
-}
+	HFSM_INLINE uint32_t count() const									{ return _pool.count() + Next::count();	}
+
+	HFSM_INLINE void update()											{ _pool.update(); Next::update();		}
+
+	template <typename TEvent>
+	HFSM_INLINE void react(const TEvent& event)							{ _pool.react(event); Next::react(event);	}
+
+	template <typename TEvent>
+	HFSM_INLINE bool react(const SchedulerHandle handle,
+						   const TEvent& event);
+
+	Pool _pool;
+};
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, ShortIndex NI, typename TI, typename... TR>
-void
-OS_<TN, TA, NI, TI, TR...>::wideLoadResumable(Registry& registry,
-											  ReadStream& stream) const
-{
-	initial	 .deepLoadResumable(registry, stream);
-	remaining.wideLoadResumable(registry, stream);
-}
+template <uint32_t NCapacity, LongIndex NIndex>
+struct SchedulerPoolsT<NCapacity, NIndex> {
+	HFSM_INLINE void pool() const										{}
 
-#endif
+	HFSM_INLINE bool remove(const SchedulerHandle) const				{ return false;							}
+	HFSM_INLINE bool contains(const SchedulerHandle) const				{ return false;							}
 
-////////////////////////////////////////////////////////////////////////////////
+	HFSM_INLINE uint32_t count() const									{ return 0;								}
 
-}
-}
-namespace hfsm2 {
-namespace detail {
+	HFSM_INLINE void update()											{}
+
+	template <typename TEvent>
+	HFSM_INLINE void react(const TEvent&)								{}
+
+	template <typename TEvent>
+	HFSM_INLINE bool react(const SchedulerHandle, const TEvent&)		{ return false;							}
+};
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename TN, typename TA, ShortIndex NI, typename TI>
-void
-OS_<TN, TA, NI, TI>::wideRegister(Registry& registry,
-									  const ForkID forkId)
-{
-	initial.deepRegister(registry, Parent{forkId, PRONG_INDEX});
 }
 
-//------------------------------------------------------------------------------
+// Owns machines of several types, one contiguous pool per type
+//  update() and react() walk the pools type by type,
+//  calling each machine type's own R_::update() / R_::react() without virtual dispatch
+//  Handles address machines of any type, e.g. to route events between them
+//  Machines can't be added or removed while the scheduler is updating or reacting
+//  Storage is sized by 'NCapacity' machines of every type,
+//  large schedulers are best allocated on the heap
 
-template <typename TN, typename TA, ShortIndex NI, typename TI>
-bool
-OS_<TN, TA, NI, TI>::wideForwardEntryGuard(GuardControl& control,
-										   const ProngConstBits prongs)
-{
-	return prongs.get(PRONG_INDEX) ?
-		initial.deepForwardEntryGuard(control) : false;
-}
+template <uint32_t NCapacity, typename... TInstances>
+class SchedulerT {
+	using Types = detail::ITL_<TInstances...>;
+	using Pools = detail::SchedulerPoolsT<NCapacity, 0, TInstances...>;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+public:
+	using Handle = SchedulerHandle;
 
-template <typename TN, typename TA, ShortIndex NI, typename TI>
-bool
-OS_<TN, TA, NI, TI>::wideForwardEntryGuard(GuardControl& control) {
-	return initial.deepForwardEntryGuard(control);
-}
+	static constexpr uint32_t  CAPACITY	  = NCapacity;
+	static constexpr LongIndex TYPE_COUNT = sizeof...(TInstances);
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	static_assert(TYPE_COUNT > 0,						"Scheduler needs at least one machine type");
+	static_assert(TYPE_COUNT < SchedulerHandle::INVALID, "Too many machine types");
 
-template <typename TN, typename TA, ShortIndex NI, typename TI>
-bool
-OS_<TN, TA, NI, TI>::wideEntryGuard(GuardControl& control) {
-	return initial.deepEntryGuard(control);
-}
+	template <typename TInstance>
+	static constexpr LongIndex typeIndex()								{ return Types::template index<TInstance>();	}
 
-//------------------------------------------------------------------------------
+	// Construct a 'TInstance' machine with 'args', returns an invalid handle if its pool is full
+	template <typename TInstance, typename... TArgs>
+	HFSM_INLINE Handle emplace(TArgs&&... args);
 
-template <typename TN, typename TA, ShortIndex NI, typename TI>
-void
-OS_<TN, TA, NI, TI>::wideConstruct(PlanControl& control) {
-	initial.deepConstruct(control);
-}
+	// Returns false for a stale handle
+	HFSM_INLINE bool remove(const Handle handle)						{ return _pools.remove(handle);			}
 
-//------------------------------------------------------------------------------
+	HFSM_INLINE bool contains(const Handle handle) const				{ return _pools.contains(handle);		}
 
-template <typename TN, typename TA, ShortIndex NI, typename TI>
-void
-OS_<TN, TA, NI, TI>::wideEnter(PlanControl& control) {
-	initial.deepEnter(control);
-}
+	// nullptr for a stale handle or a machine of another type
+	template <typename TInstance>
+	HFSM_INLINE		  TInstance* get(const Handle handle);
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	template <typename TInstance>
+	HFSM_INLINE const TInstance* get(const Handle handle) const;
 
-template <typename TN, typename TA, ShortIndex NI, typename TI>
-void
-OS_<TN, TA, NI, TI>::wideReenter(PlanControl& control) {
-	initial.deepReenter(control);
-}
+	HFSM_INLINE uint32_t count() const									{ return _pools.count();				}
 
-//------------------------------------------------------------------------------
+	template <typename TInstance>
+	HFSM_INLINE uint32_t count() const									{ return pool<TInstance>().count();		}
 
-template <typename TN, typename TA, ShortIndex NI, typename TI>
-Status
-OS_<TN, TA, NI, TI>::wideUpdate(FullControl& control) {
-	return initial.deepUpdate(control);
-}
+	// Update every machine, type by type
+	HFSM_INLINE void update()											{ _pools.update();						}
 
-//------------------------------------------------------------------------------
+	// React on every machine, type by type
+	template <typename TEvent>
+	HFSM_INLINE void react(const TEvent& event)							{ _pools.react(event);					}
 
-template <typename TN, typename TA, ShortIndex NI, typename TI>
-template <typename TEvent>
-Status
-OS_<TN, TA, NI, TI>::wideReact(FullControl& control,
-							   const TEvent& event)
-{
-	return initial.deepReact(control, event);
-}
+	// React on a single machine, returns false for a stale handle
+	template <typename TEvent>
+	HFSM_INLINE bool react(const Handle handle,
+						   const TEvent& event)							{ return _pools.react(handle, event);	}
 
-//------------------------------------------------------------------------------
+	// Call 'function(TInstance&)' on every 'TInstance' machine
+	template <typename TInstance, typename TFunction>
+	HFSM_INLINE void forEach(TFunction&& function)		{ pool<TInstance>().forEach(std::forward<TFunction>(function));	}
 
-template <typename TN, typename TA, ShortIndex NI, typename TI>
-bool
-OS_<TN, TA, NI, TI>::wideForwardExitGuard(GuardControl& control,
-										  const ProngConstBits prongs)
-{
-	return prongs.get(PRONG_INDEX) ?
-		initial.deepForwardExitGuard(control) : false;
-}
+private:
+	template <typename TInstance>
+	HFSM_INLINE		  detail::SchedulerPoolT<TInstance, CAPACITY>& pool()		{ return _pools.pool(detail::TypeTagT<TInstance>{});	}
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	template <typename TInstance>
+	HFSM_INLINE const detail::SchedulerPoolT<TInstance, CAPACITY>& pool() const	{ return _pools.pool(detail::TypeTagT<TInstance>{});	}
 
-template <typename TN, typename TA, ShortIndex NI, typename TI>
-bool
-OS_<TN, TA, NI, TI>::wideForwardExitGuard(GuardControl& control) {
-	return initial.deepForwardExitGuard(control);
-}
+private:
+	Pools _pools;
+};
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+////////////////////////////////////////////////////////////////////////////////
 
-template <typename TN, typename TA, ShortIndex NI, typename TI>
-bool
-OS_<TN, TA, NI, TI>::wideExitGuard(GuardControl& control) {
-	return initial.deepExitGuard(control);
 }
 
-//------------------------------------------------------------------------------
+namespace hfsm2 {
+namespace detail {
 
-template <typename TN, typename TA, ShortIndex NI, typename TI>
-void
-OS_<TN, TA, NI, TI>::wideExit(PlanControl& control) {
-	initial.deepExit(control);
+////////////////////////////////////////////////////////////////////////////////
+
+template <typename TI, uint32_t NC>
+SchedulerPoolT<TI, NC>::SchedulerPoolT() {
+	for (uint32_t i = 0; i < CAPACITY; ++i) {
+		_generations[i]	 = 0;
+		_denseIndices[i] = INVALID;
+	}
 }
 
-//------------------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, ShortIndex NI, typename TI>
-void
-OS_<TN, TA, NI, TI>::wideDestruct(PlanControl& control) {
-	initial.deepDestruct(control);
+template <typename TI, uint32_t NC>
+SchedulerPoolT<TI, NC>::~SchedulerPoolT() {
+	for (uint16_t i = 0; i < _count; ++i)
+		instance(_dense[i])->~Instance();
 }
 
-//------------------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, ShortIndex NI, typename TI>
-void
-OS_<TN, TA, NI, TI>::wideForwardActive(Control& control,
-									   const Request::Type request,
-									   const ProngConstBits prongs)
-{
-	const Request::Type local = prongs.get(PRONG_INDEX) ?
-		request : Request::REMAIN;
+template <typename TI, uint32_t NC>
+template <typename... TArgs>
+uint16_t
+SchedulerPoolT<TI, NC>::emplace(TArgs&&... args) {
+	uint16_t slot;
 
-	initial.deepForwardActive(control, local);
+	if (_freeCount)
+		slot = _free[--_freeCount];
+	else if (_used < CAPACITY)
+		slot = _used++;
+	else
+		return INVALID;
+
+	new (&_storage[slot]) Instance(std::forward<TArgs>(args)...);
+
+	_denseIndices[slot] = _count;
+	_dense[_count++] = slot;
+
+	return slot;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, ShortIndex NI, typename TI>
+template <typename TI, uint32_t NC>
 void
-OS_<TN, TA, NI, TI>::wideForwardRequest(Control& control,
-										const Request::Type request,
-										const ProngConstBits prongs)
-{
-	const Request::Type local = prongs.get(PRONG_INDEX) ?
-		request : Request::REMAIN;
+SchedulerPoolT<TI, NC>::remove(const uint16_t slot) {
+	HFSM_ASSERT(slot < _used && _denseIndices[slot] != INVALID);
 
-	initial.deepForwardRequest(control, local);
-}
+	instance(slot)->~Instance();
+	++_generations[slot];
 
-//------------------------------------------------------------------------------
+	const uint16_t index = _denseIndices[slot];
+	const uint16_t last = _dense[--_count];
 
-template <typename TN, typename TA, ShortIndex NI, typename TI>
-void
-OS_<TN, TA, NI, TI>::wideRequestChange(Control& control) {
-	initial.deepRequestChange(control);
+	_dense[index] = last;
+	_denseIndices[last] = index;
+	_denseIndices[slot] = INVALID;
+
+	_free[_freeCount++] = slot;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, ShortIndex NI, typename TI>
-void
-OS_<TN, TA, NI, TI>::wideRequestRemain(Registry& registry) {
-	initial.deepRequestRemain(registry);
+template <typename TI, uint32_t NC>
+bool
+SchedulerPoolT<TI, NC>::contains(const uint16_t slot,
+								 const uint32_t generation) const
+{
+	return slot < _used
+		&& _denseIndices[slot] != INVALID
+		&& _generations[slot] == generation;
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//------------------------------------------------------------------------------
 
-template <typename TN, typename TA, ShortIndex NI, typename TI>
+template <typename TI, uint32_t NC>
 void
-OS_<TN, TA, NI, TI>::wideRequestRestart(Registry& registry) {
-	initial.deepRequestRestart(registry);
+SchedulerPoolT<TI, NC>::update() {
+	for (uint16_t i = 0; i < _count; ++i)
+		instance(_dense[i])->update();
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, ShortIndex NI, typename TI>
+template <typename TI, uint32_t NC>
+template <typename TEvent>
 void
-OS_<TN, TA, NI, TI>::wideRequestResume(Registry& registry) {
-	initial.deepRequestResume(registry);
+SchedulerPoolT<TI, NC>::react(const TEvent& event) {
+	for (uint16_t i = 0; i < _count; ++i)
+		instance(_dense[i])->react(event);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, ShortIndex NI, typename TI>
+template <typename TI, uint32_t NC>
+template <typename TFunction>
 void
-OS_<TN, TA, NI, TI>::wideRequestUtilize(Control& control) {
-	initial.deepRequestUtilize(control);
+SchedulerPoolT<TI, NC>::forEach(TFunction&& function) {
+	for (uint16_t i = 0; i < _count; ++i)
+		function(*instance(_dense[i]));
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+////////////////////////////////////////////////////////////////////////////////
 
-template <typename TN, typename TA, ShortIndex NI, typename TI>
-void
-OS_<TN, TA, NI, TI>::wideRequestRandomize(Control& control) {
-	initial.deepRequestRandomize(control);
-}
+template <uint32_t NC, LongIndex NI, typename TI, typename... TR>
+bool
+SchedulerPoolsT<NC, NI, TI, TR...>::remove(const SchedulerHandle handle) {
+	if (handle.type != NI)
+		return Next::remove(handle);
 
-//------------------------------------------------------------------------------
+	if (!_pool.contains(handle.slot, handle.generation))
+		return false;
 
-template <typename TN, typename TA, ShortIndex NI, typename TI>
-typename TA::Utility
-OS_<TN, TA, NI, TI>::wideReportChange(Control& control) {
-	const UP i = initial.deepReportChange(control);
+	_pool.remove(handle.slot);
 
-	return i.utility;
+	return true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, ShortIndex NI, typename TI>
-typename TA::Utility
-OS_<TN, TA, NI, TI>::wideReportUtilize(Control& control) {
-	const UP i = initial.deepReportUtilize(control);
-
-	return i.utility;
+template <uint32_t NC, LongIndex NI, typename TI, typename... TR>
+bool
+SchedulerPoolsT<NC, NI, TI, TR...>::contains(const SchedulerHandle handle) const {
+	return handle.type == NI ?
+		_pool.contains(handle.slot, handle.generation) :
+		Next::contains(handle);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, ShortIndex NI, typename TI>
-typename TA::Utility
-OS_<TN, TA, NI, TI>::wideReportRandomize(Control& control) {
-	const Utility i = initial.deepReportRandomize(control);
+template <uint32_t NC, LongIndex NI, typename TI, typename... TR>
+template <typename TEvent>
+bool
+SchedulerPoolsT<NC, NI, TI, TR...>::react(const SchedulerHandle handle,
+										  const TEvent& event)
+{
+	if (handle.type != NI)
+		return Next::react(handle, event);
 
-	return i;
-}
+	if (!_pool.contains(handle.slot, handle.generation))
+		return false;
 
-//------------------------------------------------------------------------------
+	_pool[handle.slot].react(event);
 
-template <typename TN, typename TA, ShortIndex NI, typename TI>
-void
-OS_<TN, TA, NI, TI>::wideChangeToRequested(PlanControl& control) {
-	initial.deepChangeToRequested(control);
+	return true;
 }
 
-//------------------------------------------------------------------------------
-
-#ifdef HFSM_ENABLE_STRUCTURE_REPORT
-
-template <typename TN, typename TA, ShortIndex NI, typename TI>
-void
-OS_<TN, TA, NI, TI>::wideGetNames(const LongIndex parent,
-								  const ShortIndex depth,
-								  StructureStateInfos& _stateInfos) const
-{
-	initial.deepGetNames(parent, StructureStateInfo::ORTHOGONAL, depth, _stateInfos);
+////////////////////////////////////////////////////////////////////////////////
+
 }
 
-#endif
+template <uint32_t NC, typename... TI>
+template <typename TInstance, typename... TArgs>
+SchedulerHandle
+SchedulerT<NC, TI...>::emplace(TArgs&&... args) {
+	detail::SchedulerPoolT<TInstance, CAPACITY>& typePool = pool<TInstance>();
 
-//------------------------------------------------------------------------------
+	const uint16_t slot = typePool.emplace(std::forward<TArgs>(args)...);
+	if (slot == SchedulerHandle::INVALID)
+		return Handle{};
 
-#ifdef HFSM_ENABLE_SERIALIZATION
+	Handle handle;
+	handle.type		  = (uint16_t) typeIndex<TInstance>();
+	handle.slot		  = slot;
+	handle.generation = typePool.generation(slot);
 
-template <typename TN, typename TA, ShortIndex NI, typename TI>
-void
-OS_<TN, TA, NI, TI>::wideSaveActive(const Registry& registry,
-									WriteStream& stream) const
-{
-	initial.deepSaveActive(registry, stream);
+	return handle;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, ShortIndex NI, typename TI>
-void
-OS_<TN, TA, NI, TI>::wideSaveResumable(const Registry& registry,
-									   WriteStream& stream) const
-{
-	initial.deepSaveResumable(registry, stream);
-}
-
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template <uint32_t NC, typename... TI>
+template <typename TInstance>
+TInstance*
+SchedulerT<NC, TI...>::get(const Handle handle) {
+	detail::SchedulerPoolT<TInstance, CAPACITY>& typePool = pool<TInstance>();
 
-template <typename TN, typename TA, ShortIndex NI, typename TI>
-void
-OS_<TN, TA, NI, TI>::wideLoadRequested(Registry& registry,
-									   ReadStream& stream) const
-{
-	initial.deepLoadRequested(registry, stream);
+	return handle.type == typeIndex<TInstance>() && typePool.contains(handle.slot, handle.generation) ?
+		&typePool[handle.slot] : nullptr;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, ShortIndex NI, typename TI>
-void
-OS_<TN, TA, NI, TI>::wideLoadResumable(Registry& registry,
-									   ReadStream& stream) const
-{
-	initial.deepLoadResumable(registry, stream);
-}
+template <uint32_t NC, typename... TI>
+template <typename TInstance>
+const TInstance*
+SchedulerT<NC, TI...>::get(const Handle handle) const {
+	const detail::SchedulerPoolT<TInstance, CAPACITY>& typePool = pool<TInstance>();
 
-#endif
+	return handle.type == typeIndex<TInstance>() && typePool.contains(handle.slot, handle.generation) ?
+		&typePool[handle.slot] : nullptr;
+}
 
 ////////////////////////////////////////////////////////////////////////////////
 
 }
-}
+
+#ifdef HFSM_ENABLE_TRANSITION_HISTORY
+
 namespace hfsm2 {
-namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename TIndices,
-		  typename TArgs,
-		  typename THead,
-		  typename... TSubStates>
-struct O_ final {
-	using Indices		= TIndices;
-	static constexpr StateID	HEAD_ID		= Indices::STATE_ID;
-	static constexpr ShortIndex COMPO_INDEX	= Indices::COMPO_INDEX;
-	static constexpr ShortIndex ORTHO_INDEX	= Indices::ORTHO_INDEX;
-	static constexpr ShortIndex ORTHO_UNIT	= Indices::ORTHO_UNIT;
+// Stream of transitions from many machines, for any byte transport
+//  A frame per machine that transitioned:
+//   varint entity id, varint transition count,
+//   varint 'stateId << 3 | TransitionType' per transition
+//  Machines without transitions are left out,
+//  a transition into one of the first 16 states takes a single byte
+//  R_::transitionHistory() only holds the transitions of the last update() / react(),
+//  so frames are written after each of them
+
+template <LongIndex NCapacity>
+class ReplicationWriterT {
+public:
+	static constexpr LongIndex CAPACITY = NCapacity;
 
-	static constexpr ShortIndex REGION_ID	= COMPO_INDEX + ORTHO_INDEX;
-	static constexpr ForkID		ORTHO_ID	= (ForkID) -ORTHO_INDEX - 1;
+	// Append a frame with the machine's transition history,
+	//  returns false and leaves the stream intact if the frame doesn't fit
+	template <typename TMachine>
+	HFSM_INLINE bool write(const uint32_t entityId,
+						   const TMachine& machine);
 
-	using Args			= TArgs;
-	using Rank			= typename Args::Rank;
-	using Utility		= typename Args::Utility;
-	using UP			= typename Args::UP;
-	using StateList		= typename Args::StateList;
-	using RegionList	= typename Args::RegionList;
+	HFSM_INLINE bool write(const uint32_t entityId,
+						   const Transition* const transitions,
+						   const LongIndex count);
 
-	using Head			= THead;
+	HFSM_INLINE void clear()											{ _size = 0; _frames = 0;				}
 
-	using Info			= OI_<Head, TSubStates...>;
-	static constexpr ShortIndex WIDTH		= Info::WIDTH;
-	static constexpr ShortIndex REGION_SIZE	= Info::STATE_COUNT;
-	static constexpr ShortIndex ORTHO_UNITS	= Info::ORTHO_UNITS;
+	HFSM_INLINE const uint8_t* data() const								{ return _bytes;						}
+	HFSM_INLINE LongIndex size() const									{ return _size;							}
+	HFSM_INLINE LongIndex frameCount() const							{ return _frames;						}
 
-	using Registry		= RegistryT<Args>;
-	using StateParents	= typename Registry::StateParents;
-	using OrthoForks	= typename Registry::OrthoForks;
-	using ProngBits		= typename OrthoForks::Bits;
-	using ProngConstBits= typename OrthoForks::ConstBits;
+private:
+	HFSM_INLINE bool writeVarint(LongIndex& cursor,
+								 uint32_t value);
 
-	using Control		= ControlT<Args>;
+private:
+	uint8_t _bytes[CAPACITY];
+	LongIndex _size = 0;
+	LongIndex _frames = 0;
+};
 
-	using PlanControl	= PlanControlT<Args>;
-	using ScopedOrigin	= typename PlanControl::Origin;
-	using ScopedRegion	= typename PlanControl::Region;
+//------------------------------------------------------------------------------
 
-	using FullControl	= FullControlT<Args>;
-	using ControlLock	= typename FullControl::Lock;
+// Applies a stream written by ReplicationWriterT, doesn't copy the bytes
 
-	using GuardControl	= GuardControlT<Args>;
+class ReplicationReader {
+public:
+	HFSM_INLINE ReplicationReader(const uint8_t* const data,
+								  const size_t size);
 
-	using HeadState		= S_<Indices, Args, Head>;
+	// Replay every frame on the machine 'resolve(entityId)' points to,
+	//  frames resolved to nullptr are skipped
+	//  Returns the number of frames replayed, stops at the first malformed frame
+	template <typename TMachine, typename TResolve>
+	HFSM_INLINE uint32_t apply(TResolve&& resolve);
 
-	using SubStates		= OS_<I_<HEAD_ID + 1,
-								 COMPO_INDEX,
-								 ORTHO_INDEX + 1,
-								 ORTHO_UNIT + (WIDTH + 7) / 8>,
-							  Args,
-							  0,
-							  TSubStates...>;
+	HFSM_INLINE bool failed() const										{ return _failed;						}
+	HFSM_INLINE bool done() const										{ return _cursor == _end;				}
 
-	//----------------------------------------------------------------------
+private:
+	HFSM_INLINE bool readVarint(uint32_t& value);
 
-#ifdef HFSM_EXPLICIT_MEMBER_SPECIALIZATION
-	template <typename T>
-	struct Accessor {
-		HFSM_INLINE static		 T&	   get(		 O_& o)							{ return o._subStates.template access<T>();	}
-		HFSM_INLINE static const T&	   get(const O_& o)							{ return o._subStates.template access<T>();	}
-	};
+private:
+	const uint8_t* _cursor;
+	const uint8_t* const _end;
+	bool _failed = false;
+};
 
-	template <>
-	struct Accessor<Head> {
-		HFSM_INLINE static		 Head& get(		 O_& o)							{ return o._headState._headBox.get();		}
-		HFSM_INLINE static const Head& get(const O_& o)							{ return o._headState._headBox.get();		}
-	};
+////////////////////////////////////////////////////////////////////////////////
 
-	template <typename T>
-	HFSM_INLINE		  T&	access()											{ return Accessor<T>::get(*this);			}
+}
 
-	template <typename T>
-	HFSM_INLINE const T&	access() const										{ return Accessor<T>::get(*this);			}
-#endif
+namespace hfsm2 {
 
-	//----------------------------------------------------------------------
+////////////////////////////////////////////////////////////////////////////////
 
-	HFSM_INLINE ProngBits	   orthoRequested(		Registry& registry)			{ return registry.orthoRequested.template bits<ORTHO_UNIT, WIDTH>();	}
-	HFSM_INLINE ProngConstBits orthoRequested(const Registry& registry) const	{ return registry.orthoRequested.template bits<ORTHO_UNIT, WIDTH>();	}
+template <LongIndex NC>
+template <typename TMachine>
+bool
+ReplicationWriterT<NC>::write(const uint32_t entityId,
+							  const TMachine& machine)
+{
+	const auto& history = machine.transitionHistory();
 
-	HFSM_INLINE ProngBits	   orthoRequested(		Control& control)			{ return orthoRequested(control._registry);								}
-	HFSM_INLINE ProngConstBits orthoRequested(const Control& control) const		{ return orthoRequested(control._registry);								}
+	return history.count() == 0 ||
+		   write(entityId, &history[0], history.count());
+}
 
-	HFSM_INLINE void	deepRegister		 (Registry& registry, const Parent parent);
+//------------------------------------------------------------------------------
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template <LongIndex NC>
+bool
+ReplicationWriterT<NC>::write(const uint32_t entityId,
+							  const Transition* const transitions,
+							  const LongIndex count)
+{
+	if (count == 0)
+		return true;
 
-	HFSM_INLINE bool	deepForwardEntryGuard(GuardControl&	control);
-	HFSM_INLINE bool	deepEntryGuard		 (GuardControl&	control);
+	HFSM_ASSERT(transitions);
 
-	HFSM_INLINE void	deepConstruct		 (PlanControl&	control);
+	LongIndex cursor = _size;
 
-	HFSM_INLINE void	deepEnter			 (PlanControl&	control);
-	HFSM_INLINE void	deepReenter			 (PlanControl&	control);
+	if (!writeVarint(cursor, entityId) ||
+		!writeVarint(cursor, count))
+		return false;
 
-	HFSM_INLINE Status	deepUpdate			 (FullControl&	control);
+	for (LongIndex i = 0; i < count; ++i) {
+		const Transition& transition = transitions[i];
+		HFSM_ASSERT(transition.transitionType < TransitionType::COUNT);
 
-	template <typename TEvent>
-	HFSM_INLINE Status	deepReact			 (FullControl&	control, const TEvent& event);
+		if (!writeVarint(cursor, (uint32_t) transition.stateId << 3 |
+										  (uint32_t) transition.transitionType))
+			return false;
+	}
 
-	HFSM_INLINE bool	deepForwardExitGuard (GuardControl&	control);
-	HFSM_INLINE bool	deepExitGuard		 (GuardControl&	control);
+	_size = cursor;
+	++_frames;
 
-	HFSM_INLINE void	deepExit			 (PlanControl&	control);
+	return true;
+}
 
-	HFSM_INLINE void	deepDestruct		 (PlanControl&  control);
+//------------------------------------------------------------------------------
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template <LongIndex NC>
+bool
+ReplicationWriterT<NC>::writeVarint(LongIndex& cursor,
+									uint32_t value)
+{
+	do {
+		if (cursor >= CAPACITY)
+			return false;
 
-	HFSM_INLINE void	deepForwardActive	 (Control& control, const Request::Type request);
-	HFSM_INLINE void	deepForwardRequest	 (Control& control, const Request::Type request);
+		const uint8_t low = (uint8_t) (value & 0x7F);
+		value >>= 7;
 
-	HFSM_INLINE void	deepRequest			 (Control& control, const Request::Type request);
+		_bytes[cursor++] = value ? (uint8_t) (low | 0x80) : low;
+	} while (value);
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	return true;
+}
 
-	HFSM_INLINE void	deepRequestChange	 (Control& control);
-	HFSM_INLINE void	deepRequestRemain	 (Registry& registry);
-	HFSM_INLINE void	deepRequestRestart	 (Registry& registry);
-	HFSM_INLINE void	deepRequestResume	 (Registry& registry);
-	HFSM_INLINE void	deepRequestUtilize	 (Control& control);
-	HFSM_INLINE void	deepRequestRandomize (Control& control);
+////////////////////////////////////////////////////////////////////////////////
 
-	HFSM_INLINE UP		deepReportChange	 (Control& control);
-	HFSM_INLINE UP		deepReportUtilize	 (Control& control);
-	HFSM_INLINE Rank	deepReportRank		 (Control& control);
-	HFSM_INLINE Utility	deepReportRandomize	 (Control& control);
+inline
+ReplicationReader::ReplicationReader(const uint8_t* const data,
+									 const size_t size)
+	: _cursor{data}
+	, _end{data + size}
+{
+	HFSM_ASSERT(data || size == 0);
+}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//------------------------------------------------------------------------------
 
-	HFSM_INLINE void	deepChangeToRequested(PlanControl& control);
+template <typename TMachine, typename TResolve>
+uint32_t
+ReplicationReader::apply(TResolve&& resolve) {
+	constexpr LongIndex CAPACITY = TMachine::TransitionHistory::CAPACITY;
 
-	//----------------------------------------------------------------------
+	Transition transitions[CAPACITY];
+	uint32_t applied = 0;
 
-#ifdef HFSM_ENABLE_STRUCTURE_REPORT
-	using StructureStateInfos = typename Args::StructureStateInfos;
-	using RegionType		  = typename StructureStateInfo::RegionType;
+	while (!_failed && _cursor < _end) {
+		uint32_t entityId;
+		uint32_t count;
 
-	static constexpr LongIndex NAME_COUNT	 = HeadState::NAME_COUNT  + SubStates::NAME_COUNT;
+		if (!readVarint(entityId) ||
+			!readVarint(count) ||
+			count == 0 || count > CAPACITY)
+		{
+			_failed = true;
+			break;
+		}
 
-	void deepGetNames(const LongIndex parent,
-					  const RegionType region,
-					  const ShortIndex depth,
-					  StructureStateInfos& stateInfos) const;
-#endif
+		for (uint32_t i = 0; i < count; ++i) {
+			uint32_t packed;
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+			if (!readVarint(packed) ||
+				(packed >> 3) >= TMachine::STATE_COUNT ||
+				(packed &  7) >= (uint32_t) TransitionType::COUNT)
+			{
+				_failed = true;
+				return applied;
+			}
 
-#ifdef HFSM_ENABLE_SERIALIZATION
-	using WriteStream	= typename Args::WriteStream;
-	using ReadStream	= typename Args::ReadStream;
+			transitions[i] = Transition{(StateID) (packed >> 3),
+										Method::NONE,
+										(TransitionType) (packed & 7)};
+		}
 
-	HFSM_INLINE void	deepSaveActive	 (const Registry& registry, WriteStream& stream) const;
-	HFSM_INLINE void	deepSaveResumable(const Registry& registry, WriteStream& stream) const;
+		if (TMachine* const machine = resolve(entityId)) {
+			machine->replayTransitions(transitions, count);
+			++applied;
+		}
+	}
 
-	HFSM_INLINE void	deepLoadRequested(		Registry& registry, ReadStream&  stream) const;
-	HFSM_INLINE void	deepLoadResumable(		Registry& registry, ReadStream&  stream) const;
-#endif
+	return applied;
+}
 
-	//----------------------------------------------------------------------
+//------------------------------------------------------------------------------
 
-	HeadState _headState;
-	SubStates _subStates;
-};
+inline
+bool
+ReplicationReader::readVarint(uint32_t& value) {
+	value = 0;
 
-////////////////////////////////////////////////////////////////////////////////
+	for (unsigned shift = 0; shift < 35; shift += 7) {
+		if (_cursor >= _end)
+			return false;
+
+		const uint8_t byte = *_cursor++;
+		value |= (uint32_t) (byte & 0x7F) << shift;
+
+		if ((byte & 0x80) == 0)
+			return true;
+	}
 
+	return false;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+
 }
 
+#endif
+
 namespace hfsm2 {
-namespace detail {
 
 ////////////////////////////////////////////////////////////////////////////////
 
-template <typename TN, typename TA, typename TH, typename... TS>
-void
-O_<TN, TA, TH, TS...>::deepRegister(Registry& registry,
-										const Parent parent)
-{
-	registry.orthoParents[ORTHO_INDEX] = parent;
-	registry.orthoUnits[ORTHO_INDEX] = Units{ORTHO_UNIT, WIDTH};
+// Region headed by a state added to a runtime layout, NONE for leaf states
 
-	_headState.deepRegister(registry, parent);
-	_subStates.wideRegister(registry, ORTHO_ID);
-}
+enum class RuntimeRegion : uint8_t {
+	NONE,
+	COMPOSITE,
+	RESUMABLE,
+	UTILITARIAN,
+	ORTHOGONAL,
+};
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, typename TH, typename... TS>
-bool
-O_<TN, TA, TH, TS...>::deepForwardEntryGuard(GuardControl& control) {
-	const ProngConstBits requested = orthoRequested(static_cast<const GuardControl&>(control));
+// Event passed to react() callbacks of runtime machines,
+//  as<TEvent>() returns nullptr for events of other types
 
-	ScopedRegion region{control, REGION_ID, HEAD_ID, REGION_SIZE};
+class RuntimeEvent {
+public:
+	template <typename TEvent>
+	HFSM_INLINE explicit RuntimeEvent(const TEvent& event)
+		: _type{&detail::TypeTagT<TEvent>::TAG}
+		, _event{&event}
+	{}
 
-	if (requested)
-		return _subStates.wideForwardEntryGuard(control, requested);
-	else
-		return _subStates.wideForwardEntryGuard(control);
-}
+	template <typename TEvent>
+	HFSM_INLINE const TEvent* as() const {
+		return _type == &detail::TypeTagT<TEvent>::TAG ?
+			static_cast<const TEvent*>(_event) : nullptr;
+	}
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+private:
+	const char* const _type;
+	const void* const _event;
+};
 
-template <typename TN, typename TA, typename TH, typename... TS>
-bool
-O_<TN, TA, TH, TS...>::deepEntryGuard(GuardControl& control) {
-	ScopedRegion region{control, REGION_ID, HEAD_ID, REGION_SIZE};
+namespace detail {
+
+////////////////////////////////////////////////////////////////////////////////
+
+template <LongIndex NSize>
+struct RuntimeListT {
+	static constexpr LongIndex SIZE = NSize;
+};
+
+//------------------------------------------------------------------------------
+
+// Callbacks of a single state, receiving its id first
+//  Missing ones are skipped, a missing utility() counts as 1
+
+template <typename TArgs>
+struct RuntimeCallbacksT {
+	using Utility		= typename TArgs::Utility;
+
+	using Control		= ControlT	   <TArgs>;
+	using PlanControl	= PlanControlT <TArgs>;
+	using FullControl	= FullControlT <TArgs>;
+	using GuardControl	= GuardControlT<TArgs>;
 
-	return _headState.deepEntryGuard(control) ||
-		   _subStates.wideEntryGuard(control);
-}
+	using Score			= Utility (*)(const StateID, const Control&);
+	using Guard			= void	  (*)(const StateID, GuardControl&);
+	using Transition	= void	  (*)(const StateID, PlanControl&);
+	using Update		= void	  (*)(const StateID, FullControl&);
+	using React			= void	  (*)(const StateID, const RuntimeEvent&, FullControl&);
+
+	Score	   utility		 = nullptr;
+	Guard	   entryGuard	 = nullptr;
+	Transition enter		 = nullptr;
+	Transition reenter		 = nullptr;
+	Update	   update		 = nullptr;
+	React	   react		 = nullptr;
+	Guard	   exitGuard	 = nullptr;
+	Transition exit			 = nullptr;
+	Update	   planSucceeded = nullptr;
+	Update	   planFailed	 = nullptr;
+};
 
 //------------------------------------------------------------------------------
 
-template <typename TN, typename TA, typename TH, typename... TS>
-void
-O_<TN, TA, TH, TS...>::deepConstruct(PlanControl& control) {
-	ProngBits requested = orthoRequested(control);
-	requested.clear();
+// Hierarchy of a runtime machine, flattened into per-state and per-region tables
+//  States are added depth-first: the root first with 'INVALID_STATE_ID' as its parent,
+//  then each state under the last added region, or any of its ancestors
+//  State and region ids, fork ids and orthogonal units come out the same
+//  as for the compiled machine with the same hierarchy
+//  A layout is shared by any number of machines, and has to outlive them
 
-	_headState.deepConstruct(control);
-	_subStates.wideConstruct(control);
-}
+template <typename TF>
+class RuntimeLayoutT {
+	template <typename>
+	friend class RuntimeR_;
 
-//------------------------------------------------------------------------------
+	using Info			= TF;
+	using Callbacks		= typename Info::Callbacks;
 
-template <typename TN, typename TA, typename TH, typename... TS>
-void
-O_<TN, TA, TH, TS...>::deepEnter(PlanControl& control) {
-	ScopedRegion region{control, REGION_ID, HEAD_ID, REGION_SIZE};
+	static constexpr LongIndex  STATE_COUNT	  = Info::STATE_COUNT;
+	static constexpr ShortIndex COMPO_REGIONS = Info::COMPO_REGIONS;
+	static constexpr ShortIndex ORTHO_REGIONS = Info::ORTHO_REGIONS;
+	static constexpr ShortIndex ORTHO_UNITS	  = Info::ORTHO_UNITS;
+	static constexpr ShortIndex REGION_COUNT  = Info::REGION_COUNT;
 
-	_headState.deepEnter(control);
-	_subStates.wideEnter(control);
-}
+	template <typename T>
+	using StateTable	= StaticArray<T, STATE_COUNT>;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	template <typename T>
+	using RegionTable	= StaticArray<T, REGION_COUNT>;
 
-template <typename TN, typename TA, typename TH, typename... TS>
-void
-O_<TN, TA, TH, TS...>::deepReenter(PlanControl& control) {
-	ProngBits requested = orthoRequested(control);
-	requested.clear();
+public:
+	// Returns the id of the new state,
+	//  INVALID_STATE_ID if it breaks the depth-first order or doesn't fit
+	StateID add(const StateID parent,
+				const RuntimeRegion region = RuntimeRegion::NONE,
+				const Callbacks& callbacks = Callbacks{});
 
-	ScopedRegion region{control, REGION_ID, HEAD_ID, REGION_SIZE};
+	// Fill in the fork table once all states are added,
+	//  false if a region is left without sub-states or orthogonal units run out
+	bool build();
 
-	_headState.deepReenter(control);
-	_subStates.wideReenter(control);
-}
+	HFSM_INLINE bool built() const										{ return _built;						}
 
-//------------------------------------------------------------------------------
+	HFSM_INLINE LongIndex stateCount() const							{ return _stateCount;					}
+	HFSM_INLINE ShortIndex regionCount() const							{ return _regionCount;					}
 
-template <typename TN, typename TA, typename TH, typename... TS>
-Status
-O_<TN, TA, TH, TS...>::deepUpdate(FullControl& control) {
-	ScopedRegion outer{control, REGION_ID, HEAD_ID, REGION_SIZE};
+	// Region headed by 'stateId', INVALID_REGION_ID for leaf states
+	HFSM_INLINE RegionID regionId(const StateID stateId) const			{ return _regions[stateId];				}
 
-	if (const auto headStatus = _headState.deepUpdate(control)) {
-		ControlLock lock{control};
-		_subStates.wideUpdate(control);
+private:
+	StateTable<Parent>					 _parents;
+	StateTable<StateID>					 _owners;
+	StateTable<LongIndex>				 _sizes;
+	StateTable<RegionID>				 _regions;
+
+	StateTable<typename Callbacks::Score>	   _utilities	  {nullptr};
+	StateTable<typename Callbacks::Guard>	   _entryGuards	  {nullptr};
+	StateTable<typename Callbacks::Transition> _enters		  {nullptr};
+	StateTable<typename Callbacks::Transition> _reenters	  {nullptr};
+	StateTable<typename Callbacks::Update>	   _updates		  {nullptr};
+	StateTable<typename Callbacks::React>	   _reacts		  {nullptr};
+	StateTable<typename Callbacks::Guard>	   _exitGuards	  {nullptr};
+	StateTable<typename Callbacks::Transition> _exits		  {nullptr};
+	StateTable<typename Callbacks::Update>	   _planSucceeded {nullptr};
+	StateTable<typename Callbacks::Update>	   _planFailed	  {nullptr};
+
+	RegionTable<StateID>				 _heads;
+	RegionTable<RuntimeRegion>			 _types;
+	RegionTable<ForkID>					 _forks;
+	RegionTable<ShortIndex>				 _widths;
+	RegionTable<LongIndex>				 _firstProngs;
+	RegionTable<ShortIndex>				 _units;
+
+	// sub-states of each region, in prong order
+	StateTable<StateID>					 _prongs;
+
+	LongIndex  _stateCount	= 0;
+	ShortIndex _regionCount = 0;
+	ShortIndex _compoCount	= 0;
+	ShortIndex _orthoCount	= 0;
+	bool _built = false;
+};
 
-		return headStatus;
-	} else {
-		const Status subStatus = _subStates.wideUpdate(control);
+//------------------------------------------------------------------------------
 
-		if (subStatus.outerTransition)
-			return subStatus;
+template <typename TRegistry, bool NOrthogonal>
+struct RuntimeForksT {
+	using Bits = typename TRegistry::OrthoBits;
 
-		ScopedRegion inner{control, REGION_ID, HEAD_ID, REGION_SIZE};
+	static HFSM_INLINE Bits requested(TRegistry& registry,
+									  const ForkID forkId)		{ return registry.requestedOrthoFork(forkId);		}
 
-		return subStatus && control._planData.planExists.template get<REGION_ID>() ?
-			control.updatePlan(_headState, subStatus) : subStatus;
+	static HFSM_INLINE void attach(TRegistry& registry,
+								   const ShortIndex index,
+								   const Parent parent,
+								   const Units units)
+	{
+		registry.orthoParents[index] = parent;
+		registry.orthoUnits	 [index] = units;
 	}
-}
+};
 
-//------------------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
-template <typename TEvent>
-Status
-O_<TN, TA, TH, TS...>::deepReact(FullControl& control,
-								 const TEvent& event)
-{
-	ScopedRegion outer{control, REGION_ID, HEAD_ID, REGION_SIZE};
+template <typename TRegistry>
+struct RuntimeForksT<TRegistry, false> {
+	struct Bits {
+		HFSM_INLINE explicit operator bool() const						{ return false;							}
 
-	if (const auto headStatus = _headState.deepReact(control, event)) {
-		ControlLock lock{control};
-		_subStates.wideReact(control, event);
+		HFSM_INLINE void clear()										{}
+		HFSM_INLINE bool get(const ShortIndex) const					{ return false;							}
+	};
 
-		return headStatus;
-	} else {
-		const Status subStatus = _subStates.wideReact(control, event);
+	static HFSM_INLINE Bits requested(TRegistry&, const ForkID)			{ HFSM_BREAK(); return Bits{};			}
 
-		if (subStatus.outerTransition)
-			return subStatus;
+	static HFSM_INLINE void attach(TRegistry&, const ShortIndex, const Parent, const Units)	{ HFSM_BREAK();		}
+};
 
-		ScopedRegion inner{control, REGION_ID, HEAD_ID, REGION_SIZE};
+////////////////////////////////////////////////////////////////////////////////
 
-		return subStatus && control._planData.planExists.template get<REGION_ID>() ?
-			control.updatePlan(_headState, subStatus) : subStatus;
-	}
-}
+// Machine running a RuntimeLayoutT hierarchy with the semantics of compiled machines:
+//  composite, resumable, utilitarian and orthogonal regions, guards and plans,
+//  reported to the same logger interface
+//  Registry, plans and controls are the ones compiled machines use,
+//  only the traversal walks the layout tables instead of the type hierarchy
+//  Not supported: random regions, parallel orthogonal regions, coroutines,
+//  payloads, static plans, serialization, structure report, profiler and statistics
 
-//------------------------------------------------------------------------------
+template <typename TF>
+class RuntimeR_ {
+	using Info					= TF;
+	using Config_				= typename Info::Config_;
+	using Context				= typename Info::Context;
+	using Utility				= typename Config_::Utility;
+	using RNG					= typename Config_::RNG;
+	using Logger				= typename Config_::Logger;
+	using UP					= typename Config_::UP;
 
-template <typename TN, typename TA, typename TH, typename... TS>
-bool
-O_<TN, TA, TH, TS...>::deepForwardExitGuard(GuardControl& control) {
-	const ProngConstBits requested = orthoRequested(static_cast<const GuardControl&>(control));
+	using Args					= typename Info::Args;
+	using Layout				= typename Info::Layout;
 
-	ScopedRegion region{control, REGION_ID, HEAD_ID, REGION_SIZE};
+	static constexpr LongIndex SUBSTITUTION_LIMIT = Info::SUBSTITUTION_LIMIT;
 
-	if (requested)
-		return _subStates.wideForwardExitGuard(control, requested);
-	else
-		return _subStates.wideForwardExitGuard(control);
-}
+	using Registry				= RegistryT<Args>;
+	using RegistryBackUp		= typename Registry::BackUp;
+	using Forks					= RuntimeForksT<Registry, (Info::ORTHO_REGIONS > 0)>;
+	using ForkBits				= typename Forks::Bits;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	using Control				= ControlT<Args>;
 
-template <typename TN, typename TA, typename TH, typename... TS>
-bool
-O_<TN, TA, TH, TS...>::deepExitGuard(GuardControl& control) {
-	ScopedRegion region{control, REGION_ID, HEAD_ID, REGION_SIZE};
+	using PlanControl			= PlanControlT<Args>;
+	using PlanData				= PlanDataT   <Args>;
 
-	return _headState.deepExitGuard(control) ||
-		   _subStates.wideExitGuard(control);
-}
+	using FullControl			= FullControlT<Args>;
+	using Requests				= typename FullControl::Requests;
 
-//------------------------------------------------------------------------------
+	using GuardControl			= GuardControlT<Args>;
 
-template <typename TN, typename TA, typename TH, typename... TS>
-void
-O_<TN, TA, TH, TS...>::deepExit(PlanControl& control) {
-	_subStates.wideExit(control);
-	_headState.deepExit(control);
-}
+	using ScopedOrigin			= typename PlanControl::Origin;
+	using ScopedRegion			= typename PlanControl::Region;
+	using ControlLock			= typename FullControl::Lock;
 
-//------------------------------------------------------------------------------
+public:
+	static constexpr LongIndex  STATE_COUNT		  = Info::STATE_COUNT;
+	static constexpr ShortIndex COMPO_REGIONS	  = Info::COMPO_REGIONS;
+	static constexpr ShortIndex ORTHO_REGIONS	  = Info::ORTHO_REGIONS;
+	static constexpr ShortIndex ORTHO_UNITS		  = Info::ORTHO_UNITS;
+	static constexpr ShortIndex REGION_COUNT	  = Info::REGION_COUNT;
 
-template <typename TN, typename TA, typename TH, typename... TS>
-void
-O_<TN, TA, TH, TS...>::deepDestruct(PlanControl& control) {
-	_subStates.wideDestruct(control);
-	_headState.deepDestruct(control);
-}
+	HFSM_IF_TIMERS(using Timers = typename Args::Timers);
 
-//------------------------------------------------------------------------------
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
-void
-O_<TN, TA, TH, TS...>::deepForwardActive(Control& control,
-										 const Request::Type request)
-{
-	HFSM_ASSERT(control._registry.isActive(HEAD_ID));
+public:
+	RuntimeR_(const Layout& layout,
+			  Context& context
+			  HFSM_IF_LOGGER(, Logger* const logger = nullptr));
 
-	const ProngConstBits requested = orthoRequested(static_cast<const Control&>(control));
-	HFSM_ASSERT(!!requested);
+	~RuntimeR_();
 
-	_subStates.wideForwardActive(control, request, requested);
-}
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	void update();
 
-template <typename TN, typename TA, typename TH, typename... TS>
-void
-O_<TN, TA, TH, TS...>::deepForwardRequest(Control& control,
-										  const Request::Type request)
-{
-	const ProngConstBits requested = orthoRequested(static_cast<const Control&>(control));
+	template <typename TEvent>
+	HFSM_INLINE void react(const TEvent& event);
 
-	if (requested)
-		_subStates.wideForwardRequest(control, request, requested);
-	else
-		deepRequest					 (control, request);
-}
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	HFSM_INLINE bool isActive   (const StateID stateId) const	{ return _registry.isActive   (stateId);	}
+	HFSM_INLINE bool isResumable(const StateID stateId) const	{ return _registry.isResumable(stateId);	}
 
-template <typename TN, typename TA, typename TH, typename... TS>
-void
-O_<TN, TA, TH, TS...>::deepRequest(Control& control,
-								   const Request::Type request)
-{
-	switch (request) {
-	case Request::REMAIN:
-		deepRequestRemain (control._registry);
-		break;
+	HFSM_INLINE bool isScheduled(const StateID stateId) const	{ return isResumable(stateId);				}
 
-	case Request::CHANGE:
-		deepRequestChange (control);
-		break;
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	case Request::RESTART:
-		deepRequestRestart(control._registry);
-		break;
+	HFSM_INLINE void changeTo(const StateID stateId);
+	HFSM_INLINE void restart (const StateID stateId);
+	HFSM_INLINE void resume	 (const StateID stateId);
+	HFSM_INLINE void utilize (const StateID stateId);
+	HFSM_INLINE void schedule(const StateID stateId);
 
-	case Request::RESUME:
-		deepRequestResume (control._registry);
-		break;
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	case Request::UTILIZE:
-		deepRequestUtilize(control);
-		break;
+	HFSM_INLINE const Layout& layout() const					{ return _layout;							}
 
-	case Request::RANDOMIZE:
-		deepRequestRandomize(control);
-		break;
+#if defined HFSM_ENABLE_LOG_INTERFACE || defined HFSM_ENABLE_VERBOSE_DEBUG_LOG
+	void attachLogger(Logger* const logger)						{ _logger = logger;							}
+#endif
 
-	default:
-		HFSM_BREAK();
-	}
-}
+	//----------------------------------------------------------------------
 
-//------------------------------------------------------------------------------
+private:
+	void initialEnter();
+	void processTransitions();
 
-template <typename TN, typename TA, typename TH, typename... TS>
-void
-O_<TN, TA, TH, TS...>::deepRequestChange(Control& control) {
-	_subStates.wideRequestChange(control);
-}
+	bool applyRequest(Control& control, const Request& request);
+	bool applyRequests(Control& control);
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	bool cancelledByEntryGuards(const Requests& pendingRequests);
+	bool cancelledByGuards(const Requests& pendingRequests);
 
-template <typename TN, typename TA, typename TH, typename... TS>
-void
-O_<TN, TA, TH, TS...>::deepRequestRemain(Registry& registry) {
-	_subStates.wideRequestRemain(registry);
-}
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	HFSM_INLINE StateID prong(const RegionID regionId, const ShortIndex index) const;
 
-template <typename TN, typename TA, typename TH, typename... TS>
-void
-O_<TN, TA, TH, TS...>::deepRequestRestart(Registry& registry) {
-	_subStates.wideRequestRestart(registry);
-}
+	HFSM_INLINE ShortIndex& compoRequested(const RegionID regionId);
+	HFSM_INLINE ShortIndex& compoActive	  (const RegionID regionId);
+	HFSM_INLINE ShortIndex& compoResumable(const RegionID regionId);
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	HFSM_INLINE ForkBits	orthoRequested(const RegionID regionId);
 
-template <typename TN, typename TA, typename TH, typename... TS>
-void
-O_<TN, TA, TH, TS...>::deepRequestResume(Registry& registry) {
-	_subStates.wideRequestResume(registry);
-}
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	// callbacks of a single state, the same as the head of a region
+
+	HFSM_INLINE bool	stateEntryGuard	  (GuardControl& control, const StateID stateId);
+	HFSM_INLINE void	stateConstruct	  (PlanControl&	 control, const StateID stateId);
+	HFSM_INLINE void	stateEnter		  (PlanControl&	 control, const StateID stateId);
+	HFSM_INLINE void	stateReenter	  (PlanControl&	 control, const StateID stateId);
+	HFSM_INLINE Status	stateUpdate		  (FullControl&	 control, const StateID stateId);
+	HFSM_INLINE Status	stateReact		  (FullControl&	 control, const StateID stateId, const RuntimeEvent& event);
+	HFSM_INLINE bool	stateExitGuard	  (GuardControl& control, const StateID stateId);
+	HFSM_INLINE void	stateExit		  (PlanControl&	 control, const StateID stateId);
+	HFSM_INLINE void	stateDestruct	  (PlanControl&	 control, const StateID stateId);
+	HFSM_INLINE void	statePlanSucceeded(FullControl&	 control, const StateID stateId);
+	HFSM_INLINE void	statePlanFailed	  (FullControl&	 control, const StateID stateId);
+	HFSM_INLINE UP		stateReport		  (Control&		 control, const StateID stateId);
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
-void
-O_<TN, TA, TH, TS...>::deepRequestUtilize(Control& control) {
-	_subStates.wideRequestUtilize(control);
-}
+	bool	deepForwardEntryGuard(GuardControl& control, const StateID stateId);
+	bool	deepEntryGuard		 (GuardControl& control, const StateID stateId);
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	void	deepConstruct		 (PlanControl&	control, const StateID stateId);
 
-template <typename TN, typename TA, typename TH, typename... TS>
-void
-O_<TN, TA, TH, TS...>::deepRequestRandomize(Control& control) {
-	_subStates.wideRequestRandomize(control);
-}
+	void	deepEnter			 (PlanControl&	control, const StateID stateId);
+	void	deepReenter			 (PlanControl&	control, const StateID stateId);
 
-//------------------------------------------------------------------------------
+	Status	deepUpdate			 (FullControl&	control, const StateID stateId);
+	Status	deepReact			 (FullControl&	control, const StateID stateId, const RuntimeEvent& event);
 
-template <typename TN, typename TA, typename TH, typename... TS>
-typename TA::UP
-O_<TN, TA, TH, TS...>::deepReportChange(Control& control) {
-	const UP	  h = _headState.deepReportChange(control);
-	const Utility s = _subStates.wideReportChange(control);
+	bool	deepForwardExitGuard (GuardControl& control, const StateID stateId);
+	bool	deepExitGuard		 (GuardControl& control, const StateID stateId);
 
-	const Utility sub = s / WIDTH;
+	void	deepExit			 (PlanControl&	control, const StateID stateId);
 
-	HFSM_LOG_UTILITY_RESOLUTION(control.context(), HEAD_ID, INVALID_STATE_ID, sub);
+	void	deepDestruct		 (PlanControl&	control, const StateID stateId);
 
-	return {
-		h.utility * sub,
-		h.prong
-	};
-}
+	void	deepForwardActive	 (Control&		control, const StateID stateId, const Request::Type request);
+	void	deepForwardRequest	 (Control&		control, const StateID stateId, const Request::Type request);
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	void	deepRequest			 (Control&		control, const StateID stateId, const Request::Type request);
+	void	deepRequestChange	 (Control&		control, const StateID stateId);
+	void	deepRequestRemain	 (Control&		control, const StateID stateId);
+	void	deepRequestRestart	 (Control&		control, const StateID stateId);
+	void	deepRequestResume	 (Control&		control, const StateID stateId);
+	void	deepRequestUtilize	 (Control&		control, const StateID stateId);
 
-template <typename TN, typename TA, typename TH, typename... TS>
-typename TA::UP
-O_<TN, TA, TH, TS...>::deepReportUtilize(Control& control) {
-	const UP	  h = _headState.deepReportUtilize(control);
-	const Utility s = _subStates.wideReportUtilize(control);
+	UP		deepReportChange	 (Control&		control, const StateID stateId);
+	UP		deepReportUtilize	 (Control&		control, const StateID stateId);
 
-	const Utility sub = s / WIDTH;
+	void	deepChangeToRequested(PlanControl&	control, const StateID stateId);
 
-	HFSM_LOG_UTILITY_RESOLUTION(control.context(), HEAD_ID, INVALID_STATE_ID, sub);
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	return {
-		h.utility * sub,
-		h.prong
-	};
-}
+	Status	subUpdate			 (FullControl&	control, const RegionID regionId);
+	Status	subReact			 (FullControl&	control, const RegionID regionId, const RuntimeEvent& event);
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	UP		subReportChange		 (Control&		control, const RegionID regionId);
+	UP		subReportUtilize	 (Control&		control, const RegionID regionId);
 
-template <typename TN, typename TA, typename TH, typename... TS>
-typename TA::Rank
-O_<TN, TA, TH, TS...>::deepReportRank(Control& control) {
-	return _headState.wrapRank(control);
-}
+	Status	updatePlan			 (FullControl&	control, const StateID headId, const Status subStatus);
+	Status	buildPlanStatus		 (FullControl&	control, const StateID headId);
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	//----------------------------------------------------------------------
 
-template <typename TN, typename TA, typename TH, typename... TS>
-typename TA::Utility
-O_<TN, TA, TH, TS...>::deepReportRandomize(Control& control) {
-	const Utility h = _headState.wrapUtility(control);
-	const Utility s = _subStates.wideReportRandomize(control);
+private:
+	const Layout& _layout;
 
-	const Utility sub = s / WIDTH;
+	Context& _context;
 
-	HFSM_LOG_RANDOM_RESOLUTION(control.context(), HEAD_ID, INVALID_STATE_ID, sub);
+	// only handed to the controls, runtime layouts have no random regions
+	RNG _rng{0};
 
-	return h * sub;
-}
+	Registry _registry;
+	PlanData _planData;
 
-//------------------------------------------------------------------------------
+	Requests _requests;
 
-template <typename TN, typename TA, typename TH, typename... TS>
-void
-O_<TN, TA, TH, TS...>::deepChangeToRequested(PlanControl& control) {
-	_subStates.wideChangeToRequested(control);
-}
+	HFSM_IF_LOGGER(Logger* _logger);
+	HFSM_IF_TIMERS(Timers _timers);
+};
 
 //------------------------------------------------------------------------------
 
-#ifdef HFSM_ENABLE_STRUCTURE_REPORT
-
-template <typename TN, typename TA, typename TH, typename... TS>
-void
-O_<TN, TA, TH, TS...>::deepGetNames(const LongIndex parent,
-									const RegionType region,
-									const ShortIndex depth,
-									StructureStateInfos& stateInfos) const
-{
-	_headState.deepGetNames(parent, region,			depth,	   stateInfos);
-	_subStates.wideGetNames(stateInfos.count() - 1, depth + 1, stateInfos);
-}
-
-#endif
+template <typename TConfig,
+		  LongIndex NStates,
+		  ShortIndex NCompo,
+		  ShortIndex NOrtho,
+		  ShortIndex NUnits>
+struct RuntimeF_ final {
+	using Config_		= TConfig;
+	using Context		= typename Config_::Context;
 
-//------------------------------------------------------------------------------
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-#ifdef HFSM_ENABLE_SERIALIZATION
+	static constexpr LongIndex  SUBSTITUTION_LIMIT = Config_::SUBSTITUTION_LIMIT;
 
-template <typename TN, typename TA, typename TH, typename... TS>
-void
-O_<TN, TA, TH, TS...>::deepSaveActive(const Registry& registry,
-									  WriteStream& stream) const
-{
-	_subStates.wideSaveActive(registry, stream);
-}
+	static constexpr LongIndex  STATE_COUNT		= NStates;
+	static constexpr ShortIndex COMPO_REGIONS	= NCompo;
+	static constexpr ShortIndex ORTHO_REGIONS	= NOrtho;
+	static constexpr ShortIndex ORTHO_UNITS		= NUnits;
+	static constexpr ShortIndex REGION_COUNT	= COMPO_REGIONS + ORTHO_REGIONS;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	static constexpr LongIndex  TASK_CAPACITY	= Config_::TASK_CAPACITY != INVALID_LONG_INDEX ?
+													  Config_::TASK_CAPACITY : STATE_COUNT * 2;
 
-template <typename TN, typename TA, typename TH, typename... TS>
-void
-O_<TN, TA, TH, TS...>::deepSaveResumable(const Registry& registry,
-										 WriteStream& stream) const
-{
-	_subStates.wideSaveResumable(registry, stream);
-}
+	static_assert(STATE_COUNT < (ShortIndex) -1, "Too many states in the hierarchy. Change 'ShortIndex' type.");
+	static_assert(COMPO_REGIONS > 0, "Runtime machines need at least one composite region");
+	static_assert(ORTHO_UNITS >= ORTHO_REGIONS, "Each orthogonal region needs at least one unit");
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	using StateList		= RuntimeListT<STATE_COUNT>;
+	using RegionList	= RuntimeListT<REGION_COUNT>;
 
-template <typename TN, typename TA, typename TH, typename... TS>
-void
-O_<TN, TA, TH, TS...>::deepLoadRequested(Registry& registry,
-										 ReadStream& stream) const
-{
-	_subStates.wideLoadRequested(registry, stream);
-}
+	using Args			= ArgsT<Context,
+								Config_,
+								StateList,
+								RegionList,
+								COMPO_REGIONS,
+								ORTHO_REGIONS,
+								ORTHO_UNITS,
+								0,
+								TASK_CAPACITY>;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN, typename TA, typename TH, typename... TS>
-void
-O_<TN, TA, TH, TS...>::deepLoadResumable(Registry& registry,
-										 ReadStream& stream) const
-{
-	_subStates.wideLoadResumable(registry, stream);
-}
+	using Instance		= RuntimeR_<RuntimeF_>;
+	using Layout		= RuntimeLayoutT<RuntimeF_>;
+	using Callbacks		= RuntimeCallbacksT<Args>;
+	using Event			= RuntimeEvent;
 
-#endif
+	using Control		= ControlT	   <Args>;
+	using PlanControl	= PlanControlT <Args>;
+	using FullControl	= FullControlT <Args>;
+	using GuardControl	= GuardControlT<Args>;
+};
 
 ////////////////////////////////////////////////////////////////////////////////
 
 }
 }
+
 namespace hfsm2 {
 namespace detail {
 
-#ifndef HFSM_EXPLICIT_MEMBER_SPECIALIZATION
+////////////////////////////////////////////////////////////////////////////////
 
-//------------------------------------------------------------------------------
+template <typename TF>
+StateID
+RuntimeLayoutT<TF>::add(const StateID parent,
+						const RuntimeRegion region,
+						const Callbacks& callbacks)
+{
+	HFSM_ASSERT(!_built);
 
-template <typename...>
-struct Accessor;
+	if (_built || _stateCount >= STATE_COUNT)
+		return INVALID_STATE_ID;
 
-////////////////////////////////////////////////////////////////////////////////
+	const StateID stateId = (StateID) _stateCount;
 
-template <typename T,
-		  typename TN,
-		  typename TA,
-		  Strategy TG,
-		  typename TH,
-		  typename... TS>
-struct Accessor<T,		 C_<TN, TA, TG, TH, TS...>> {
-	using Host =		 C_<TN, TA, TG, TH, TS...>;
+	if (parent == INVALID_STATE_ID) {
+		if (stateId != 0 || region == RuntimeRegion::NONE)
+			return INVALID_STATE_ID;
+	} else if (parent >= stateId ||
+			   _regions[parent] == INVALID_REGION_ID ||
+			   parent + _sizes[parent] != stateId)
+		return INVALID_STATE_ID;
 
-	HFSM_INLINE		  T& get()			{ return Accessor<T,	   typename Host::SubStates>{host._subStates}.get();	}
+	if (region != RuntimeRegion::NONE) {
+		if (_regionCount >= REGION_COUNT)
+			return INVALID_STATE_ID;
 
-	Host& host;
-};
+		if (region == RuntimeRegion::ORTHOGONAL ?
+				_orthoCount >= ORTHO_REGIONS :
+				_compoCount >= COMPO_REGIONS)
+			return INVALID_STATE_ID;
+	}
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename T,
-		  typename TN,
-		  typename TA,
-		  Strategy TG,
-		  typename TH,
-		  typename... TS>
-struct Accessor<T, const C_<TN, TA, TG, TH, TS...>> {
-	using Host =   const C_<TN, TA, TG, TH, TS...>;
+	if (parent != INVALID_STATE_ID) {
+		const RegionID owner = _regions[parent];
 
-	HFSM_INLINE const T& get() const	{ return Accessor<T, const typename Host::SubStates>{host._subStates}.get();	}
+		_parents[stateId] = Parent{_forks[owner], _widths[owner]};
+		++_widths[owner];
 
-	Host& host;
-};
+		for (StateID s = parent; s != INVALID_STATE_ID; s = _owners[s])
+			++_sizes[s];
+	} else
+		_parents[stateId] = Parent{};
 
-//------------------------------------------------------------------------------
+	_owners [stateId] = parent;
+	_sizes  [stateId] = 1;
 
-template <typename T,
-		  typename TN,
-		  typename TA,
-		  Strategy TG,
-		  typename... TS>
-struct Accessor<T,		 C_<TN, TA, TG,  T, TS...>> {
-	using Host =		 C_<TN, TA, TG,  T, TS...>;
+	if (region != RuntimeRegion::NONE) {
+		const RegionID regionId = _regionCount++;
 
-	HFSM_INLINE		  T& get()			{ return host._headState._headBox.get();	}
+		_heads [regionId] = stateId;
+		_types [regionId] = region;
+		_widths[regionId] = 0;
+		_forks [regionId] = region == RuntimeRegion::ORTHOGONAL ?
+								(ForkID) -++_orthoCount :
+								(ForkID)  ++_compoCount;
 
-	Host& host;
-};
+		_regions[stateId] = regionId;
+	} else
+		_regions[stateId] = INVALID_REGION_ID;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	_utilities	  [stateId] = callbacks.utility;
+	_entryGuards  [stateId] = callbacks.entryGuard;
+	_enters		  [stateId] = callbacks.enter;
+	_reenters	  [stateId] = callbacks.reenter;
+	_updates	  [stateId] = callbacks.update;
+	_reacts		  [stateId] = callbacks.react;
+	_exitGuards	  [stateId] = callbacks.exitGuard;
+	_exits		  [stateId] = callbacks.exit;
+	_planSucceeded[stateId] = callbacks.planSucceeded;
+	_planFailed	  [stateId] = callbacks.planFailed;
 
-template <typename T,
-		  typename TN,
-		  typename TA,
-		  Strategy TG,
-		  typename... TS>
-struct Accessor<T, const C_<TN, TA, TG,  T, TS...>> {
-	using Host =   const C_<TN, TA, TG,  T, TS...>;
+	++_stateCount;
 
-	HFSM_INLINE const T& get() const	{ return host._headState._headBox.get();	}
+	return stateId;
+}
 
-	Host& host;
-};
+//------------------------------------------------------------------------------
 
-////////////////////////////////////////////////////////////////////////////////
+template <typename TF>
+bool
+RuntimeLayoutT<TF>::build() {
+	HFSM_ASSERT(!_built);
 
-template <typename T,
-		  typename TN,
-		  typename TA,
-		  Strategy TG,
-		  ShortIndex NI,
-		  typename... TS>
-struct Accessor<T,		 CS_<TN, TA, TG, NI, TS...>> {
-	using Host =		 CS_<TN, TA, TG, NI, TS...>;
+	if (_built || _stateCount == 0)
+		return false;
 
-	HFSM_INLINE		  T& get()		 {
-		return Host::LHalfInfo::StateList::template contains<T>() ?
-			Accessor<T,		  typename Host::LHalf>{host.lHalf}.get() :
-			Accessor<T,		  typename Host::RHalf>{host.rHalf}.get();
-	}
+	LongIndex  first = 0;
+	ShortIndex units = 0;
 
-	Host& host;
-};
+	for (RegionID r = 0; r < _regionCount; ++r) {
+		if (_widths[r] == 0)
+			return false;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+		_firstProngs[r] = first;
+		first += _widths[r];
 
-template <typename T,
-		  typename TN,
-		  typename TA,
-		  Strategy TG,
-		  ShortIndex NI,
-		  typename... TS>
-struct Accessor<T, const CS_<TN, TA, TG, NI, TS...>> {
-	using Host =   const CS_<TN, TA, TG, NI, TS...>;
+		if (_types[r] == RuntimeRegion::ORTHOGONAL) {
+			_units[r] = units;
+			units += (_widths[r] + 7) / 8;
 
-	HFSM_INLINE const T& get() const {
-		return Host::LHalfInfo::StateList::template contains<T>() ?
-			Accessor<T, const typename Host::LHalf>{host.lHalf}.get() :
-			Accessor<T, const typename Host::RHalf>{host.rHalf}.get();
+			if (units > ORTHO_UNITS)
+				return false;
+		}
 	}
 
-	Host& host;
-};
+	for (StateID s = 1; s < _stateCount; ++s)
+		_prongs[_firstProngs[_regions[_owners[s]]] + _parents[s].prong] = s;
 
-//------------------------------------------------------------------------------
+	_built = true;
 
-template <typename T,
-		  typename TN,
-		  typename TA,
-		  Strategy TG,
-		  ShortIndex NI,
-		  typename TS>
-struct Accessor<T,		 CS_<TN, TA, TG, NI, TS>> {
-	using Host =		 CS_<TN, TA, TG, NI, TS>;
+	return true;
+}
 
-	HFSM_INLINE		  T& get()			{ return Accessor<T,	   typename Host::State>{host.state}.get();				}
+////////////////////////////////////////////////////////////////////////////////
 
-	Host& host;
-};
+template <typename TF>
+RuntimeR_<TF>::RuntimeR_(const Layout& layout,
+						 Context& context
+						 HFSM_IF_LOGGER(, Logger* const logger))
+	: _layout{layout}
+	, _context{context}
+	HFSM_IF_LOGGER(, _logger{logger})
+{
+	HFSM_ASSERT(_layout._built);
+
+	for (StateID s = 0; s < _layout._stateCount; ++s)
+		_registry.stateParents[s] = _layout._parents[s];
+
+	for (RegionID r = 0; r < _layout._regionCount; ++r) {
+		const ForkID forkId = _layout._forks[r];
+		const Parent parent = _layout._parents[_layout._heads[r]];
+
+		if (forkId > 0)
+			_registry.compoParents[forkId - 1] = parent;
+		else
+			Forks::attach(_registry,
+						  (ShortIndex) (-forkId - 1),
+						  parent,
+						  Units{_layout._units[r], _layout._widths[r]});
+	}
+
+	initialEnter();
+}
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename T,
-		  typename TN,
-		  typename TA,
-		  Strategy TG,
-		  ShortIndex NI,
-		  typename TS>
-struct Accessor<T, const CS_<TN, TA, TG, NI, TS>> {
-	using Host =   const CS_<TN, TA, TG, NI, TS>;
+template <typename TF>
+RuntimeR_<TF>::~RuntimeR_() {
+	PlanControl control{_context,
+						_rng,
+						_registry,
+						_planData,
+						HFSM_LOGGER_OR(_logger, nullptr)
+						HFSM_IF_PROFILER(, nullptr)
+						HFSM_IF_STATISTICS(, nullptr)
+						HFSM_IF_TIMERS(, _timers)};
 
-	HFSM_INLINE const T& get() const	{ return Accessor<T, const typename Host::State>{host.state}.get();				}
+	deepExit	(control, 0);
+	deepDestruct(control, 0);
 
-	Host& host;
-};
+	HFSM_IF_ASSERT(_planData.verifyPlans());
+}
 
-////////////////////////////////////////////////////////////////////////////////
+//------------------------------------------------------------------------------
 
-template <typename T,
-		  typename TN,
-		  typename TA,
-		  typename TH,
-		  typename... TS>
-struct Accessor<T,		 O_<TN, TA, TH, TS...>> {
-	using Host =		 O_<TN, TA, TH, TS...>;
+template <typename TF>
+void
+RuntimeR_<TF>::update() {
+	HFSM_IF_TIMERS(_timers.advance(_requests, _registry));
 
-	HFSM_INLINE		  T& get()			{ return Accessor<T,	   typename Host::SubStates>{host._subStates}.get();	}
+	FullControl control{_context,
+						_rng,
+						_registry,
+						_planData,
+						_requests,
+						HFSM_LOGGER_OR(_logger, nullptr)
+						HFSM_IF_PROFILER(, nullptr)
+						HFSM_IF_STATISTICS(, nullptr)
+						HFSM_IF_TIMERS(, _timers)};
 
-	Host& host;
-};
+	deepUpdate(control, 0);
+
+	HFSM_IF_ASSERT(_planData.verifyPlans());
+
+	if (_requests.count())
+		processTransitions();
+
+	_requests.clear();
+}
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename T,
-		  typename TN,
-		  typename TA,
-		  typename TH,
-		  typename... TS>
-struct Accessor<T, const O_<TN, TA, TH, TS...>> {
-	using Host =   const O_<TN, TA, TH, TS...>;
+template <typename TF>
+template <typename TEvent>
+void
+RuntimeR_<TF>::react(const TEvent& event) {
+	const RuntimeEvent runtimeEvent{event};
 
-	HFSM_INLINE const T& get() const	{ return Accessor<T, const typename Host::SubStates>{host._subStates}.get();	}
+	FullControl control{_context,
+						_rng,
+						_registry,
+						_planData,
+						_requests,
+						HFSM_LOGGER_OR(_logger, nullptr)
+						HFSM_IF_PROFILER(, nullptr)
+						HFSM_IF_STATISTICS(, nullptr)
+						HFSM_IF_TIMERS(, _timers)};
 
-	Host& host;
-};
+	deepReact(control, 0, runtimeEvent);
 
-//------------------------------------------------------------------------------
+	HFSM_IF_ASSERT(_planData.verifyPlans());
 
-template <typename T,
-		  typename TN,
-		  typename TA,
-		  typename... TS>
-struct Accessor<T,		 O_<TN, TA,  T, TS...>> {
-	using Host =		 O_<TN, TA,  T, TS...>;
+	if (_requests.count())
+		processTransitions();
 
-	HFSM_INLINE		  T& get()			{ return host._headState._headBox.get();	}
+	_requests.clear();
+}
 
-	Host& host;
-};
+//------------------------------------------------------------------------------
+
+template <typename TF>
+void
+RuntimeR_<TF>::changeTo(const StateID stateId) {
+	_requests.append(Request{Request::Type::CHANGE, stateId});
+
+	HFSM_LOG_TRANSITION(_context, INVALID_STATE_ID, TransitionType::CHANGE, stateId);
+}
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename T,
-		  typename TN,
-		  typename TA,
-		  typename... TS>
-struct Accessor<T, const O_<TN, TA,  T, TS...>> {
-	using Host =   const O_<TN, TA,  T, TS...>;
+template <typename TF>
+void
+RuntimeR_<TF>::restart(const StateID stateId) {
+	_requests.append(Request{Request::Type::RESTART, stateId});
 
-	HFSM_INLINE const T& get() const	{ return host._headState._headBox.get();	}
+	HFSM_LOG_TRANSITION(_context, INVALID_STATE_ID, TransitionType::RESTART, stateId);
+}
 
-	Host& host;
-};
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+template <typename TF>
+void
+RuntimeR_<TF>::resume(const StateID stateId) {
+	_requests.append(Request{Request::Type::RESUME, stateId});
 
-////////////////////////////////////////////////////////////////////////////////
+	HFSM_LOG_TRANSITION(_context, INVALID_STATE_ID, TransitionType::RESUME, stateId);
+}
 
-template <typename T,
-		  typename TN,
-		  typename TA,
-		  ShortIndex NI,
-		  typename... TS>
-struct Accessor<T,		 OS_<TN, TA, NI, TS...>> {
-	using Host =		 OS_<TN, TA, NI, TS...>;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	HFSM_INLINE		  T& get()		 {
-		return Host::InitialStates::template contains<T>() ?
-			Accessor<T,		  typename Host::Initial  >{host.initial  }.get() :
-			Accessor<T,		  typename Host::Remaining>{host.remaining}.get();
-	}
+template <typename TF>
+void
+RuntimeR_<TF>::utilize(const StateID stateId) {
+	_requests.append(Request{Request::Type::UTILIZE, stateId});
 
-	Host& host;
-};
+	HFSM_LOG_TRANSITION(_context, INVALID_STATE_ID, TransitionType::UTILIZE, stateId);
+}
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename T,
-		  typename TN,
-		  typename TA,
-		  ShortIndex NI,
-		  typename... TS>
-struct Accessor<T, const OS_<TN, TA, NI, TS...>> {
-	using Host =   const OS_<TN, TA, NI, TS...>;
-
-	HFSM_INLINE const T& get() const {
-		return Host::InitialStates::template contains<T>() ?
-			Accessor<T, const typename Host::Initial  >{host.initial  }.get() :
-			Accessor<T, const typename Host::Remaining>{host.remaining}.get();
-	}
+template <typename TF>
+void
+RuntimeR_<TF>::schedule(const StateID stateId) {
+	_requests.append(Request{Request::Type::SCHEDULE, stateId});
 
-	Host& host;
-};
+	HFSM_LOG_TRANSITION(_context, INVALID_STATE_ID, TransitionType::SCHEDULE, stateId);
+}
 
 //------------------------------------------------------------------------------
 
-template <typename T,
-		  typename TN,
-		  typename TA,
-		  ShortIndex NI,
-		  typename TS>
-struct Accessor<T,		 OS_<TN, TA, NI, TS>> {
-	using Host =		 OS_<TN, TA, NI, TS>;
+template <typename TF>
+void
+RuntimeR_<TF>::initialEnter() {
+	HFSM_ASSERT(_requests.count() == 0);
 
-	HFSM_INLINE		  T& get()			{ return Accessor<T,	   typename Host::Initial>{host.initial  }.get();	}
+	RegistryBackUp undo;
+	Requests lastRequests;
 
-	Host& host;
-};
+	PlanControl control{_context,
+						_rng,
+						_registry,
+						_planData,
+						HFSM_LOGGER_OR(_logger, nullptr)
+						HFSM_IF_PROFILER(, nullptr)
+						HFSM_IF_STATISTICS(, nullptr)
+						HFSM_IF_TIMERS(, _timers)};
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	deepRequestChange(control, 0);
 
-template <typename T,
-		  typename TN,
-		  typename TA,
-		  ShortIndex NI,
-		  typename TS>
-struct Accessor<T, const OS_<TN, TA, NI, TS>> {
-	using Host =   const OS_<TN, TA, NI, TS>;
+	cancelledByEntryGuards(_requests);
 
-	HFSM_INLINE const T& get() const	{ return Accessor<T, const typename Host::Initial>{host.initial  }.get();	}
+	for (LongIndex i = 0;
+		 i < SUBSTITUTION_LIMIT && _requests.count();
+		 ++i)
+	{
+		backup(_registry, undo);
 
-	Host& host;
-};
+		if (applyRequests(control)) {
+			lastRequests = _requests;
+			_requests.clear();
 
-////////////////////////////////////////////////////////////////////////////////
+			if (cancelledByEntryGuards(lastRequests))
+				restore(_registry, undo);
+		} else
+			_requests.clear();
+	}
+	HFSM_ASSERT(_requests.count() == 0);
 
+	deepConstruct(control, 0);
+	deepEnter	 (control, 0);
 
-////////////////////////////////////////////////////////////////////////////////
+	_registry.clearRequests();
 
-#ifdef __clang__
-	#pragma clang diagnostic push
-	#pragma clang diagnostic ignored "-Wnull-dereference"
-#endif
+	HFSM_IF_ASSERT(_planData.verifyPlans());
+}
 
-template <typename T,
-		  typename TN,
-		  typename TA,
-		  typename TH>
-struct Accessor<T,		 S_<TN, TA, TH>> {
-	using Host =		 S_<TN, TA, TH>;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	HFSM_INLINE		  T& get()			{ HFSM_BREAK(); return *reinterpret_cast<T*>(0);	}
+template <typename TF>
+void
+RuntimeR_<TF>::processTransitions() {
+	HFSM_ASSERT(_requests.count());
 
-	Host& host;
-};
+	RegistryBackUp undo;
+	Requests lastRequests;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	PlanControl control{_context,
+						_rng,
+						_registry,
+						_planData,
+						HFSM_LOGGER_OR(_logger, nullptr)
+						HFSM_IF_PROFILER(, nullptr)
+						HFSM_IF_STATISTICS(, nullptr)
+						HFSM_IF_TIMERS(, _timers)};
 
-template <typename T,
-		  typename TN,
-		  typename TA,
-		  typename TH>
-struct Accessor<T, const S_<TN, TA, TH>> {
-	using Host =   const S_<TN, TA, TH>;
+	bool changesMade = false;
 
-	HFSM_INLINE const T& get() const	{ HFSM_BREAK(); return *reinterpret_cast<T*>(0);	}
+	for (LongIndex i = 0;
+		i < SUBSTITUTION_LIMIT && _requests.count();
+		++i)
+	{
+		backup(_registry, undo);
 
-	Host& host;
-};
+		if (applyRequests(control)) {
+			lastRequests = _requests;
+			_requests.clear();
 
-#ifdef __clang__
-	#pragma clang diagnostic pop
-#endif
+			HFSM_IF_PAYLOADS(const uint16_t round = _planData.payloads.seal());
 
-//------------------------------------------------------------------------------
+			if (cancelledByGuards(lastRequests)) {
+				restore(_registry, undo);
+				HFSM_IF_PAYLOADS(_planData.payloads.discard(round));
+			} else
+				changesMade = true;
+		} else {
+			_requests.clear();
 
-template <typename T,
-		  typename TN,
-		  typename TA>
-struct Accessor<T,		 S_<TN, TA,  T>> {
-	using Host =		 S_<TN, TA,  T>;
+			HFSM_IF_PAYLOADS(_planData.payloads.discard(_planData.payloads.seal()));
+		}
+	}
 
-	HFSM_INLINE		  T& get()			{ return host._headBox.get();			}
+	if (changesMade) {
+		deepChangeToRequested(control, 0);
 
-	Host& host;
-};
+		_registry.clearRequests();
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+		HFSM_IF_ASSERT(_planData.verifyPlans());
+	}
 
-template <typename T,
-		  typename TN,
-		  typename TA>
-struct Accessor<T, const S_<TN, TA,  T>> {
-	using Host =   const S_<TN, TA,  T>;
+	HFSM_IF_PAYLOADS(_planData.payloads.clear());
+}
 
-	HFSM_INLINE const T& get() const	{ return host._headBox.get();			}
+//------------------------------------------------------------------------------
 
-	Host& host;
-};
+template <typename TF>
+bool
+RuntimeR_<TF>::applyRequest(Control& control,
+							const Request& request)
+{
+	switch (request.type) {
+	case Request::CHANGE:
+	case Request::RESTART:
+	case Request::RESUME:
+	case Request::UTILIZE:
+		if (_registry.requestImmediate(request))
+			deepForwardActive(control, 0, request.type);
+		else
+			deepRequest		 (control, 0, request.type);
 
-////////////////////////////////////////////////////////////////////////////////
+		return true;
 
-#endif
+	case Request::SCHEDULE:
+		_registry.requestScheduled(request.stateId);
 
-}
-}
+		return false;
 
-namespace hfsm2 {
+	default:
+		// no random regions in runtime layouts
+		HFSM_BREAK();
 
-//------------------------------------------------------------------------------
+		return false;
+	}
+}
 
-template <typename TC_ = EmptyContext,
-		  typename TN_ = char,
-		  typename TU_ = float,
-		  typename TG_ = ::hfsm2::RandomT<TU_>,
-		  LongIndex NS = 4,
-		  LongIndex NT = INVALID_LONG_INDEX>
-struct ConfigT {
-	using Context = TC_;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	using Rank	  = TN_;
-	using Utility = TU_;
-	using RNG	  = TG_;
-	using Logger  = LoggerInterfaceT<Context, Utility>;
+template <typename TF>
+bool
+RuntimeR_<TF>::applyRequests(Control& control) {
+	bool changesMade = false;
 
-	static constexpr LongIndex SUBSTITUTION_LIMIT = NS;
-	static constexpr LongIndex TASK_CAPACITY	  = NT;
+	for (const Request& request : _requests)
+		changesMade |= applyRequest(control, request);
 
-	template <typename T>
-	using ContextT			 = ConfigT<  T, TN_, TU_, TG_, NS, NT>;
+	return changesMade;
+}
 
-	template <typename T>
-	using RankT				 = ConfigT<TC_,   T, TU_, TG_, NS, NT>;
+//------------------------------------------------------------------------------
 
-	template <typename T>
-	using UtilityT			 = ConfigT<TC_, TN_,   T, TG_, NS, NT>;
+template <typename TF>
+bool
+RuntimeR_<TF>::cancelledByEntryGuards(const Requests& pendingRequests) {
+	GuardControl guardControl{_context,
+							  _rng,
+							  _registry,
+							  _planData,
+							  _requests,
+							  pendingRequests,
+							  HFSM_LOGGER_OR(_logger, nullptr)
+							  HFSM_IF_PROFILER(, nullptr)
+							  HFSM_IF_STATISTICS(, nullptr)
+							  HFSM_IF_TIMERS(, _timers)};
 
-	template <typename T>
-	using RandomT			 = ConfigT<TC_, TN_, TU_,   T, NS, NT>;
+	return deepEntryGuard(guardControl, 0);
+}
 
-	template <LongIndex N>
-	using SubstitutionLimitN = ConfigT<TC_, TN_, TU_, TG_,  N, NS>;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	template <LongIndex N>
-	using TaskCapacityN		 = ConfigT<TC_, TN_, TU_, TG_, NT,  N>;
+template <typename TF>
+bool
+RuntimeR_<TF>::cancelledByGuards(const Requests& pendingRequests) {
+	GuardControl guardControl{_context,
+							  _rng,
+							  _registry,
+							  _planData,
+							  _requests,
+							  pendingRequests,
+							  HFSM_LOGGER_OR(_logger, nullptr)
+							  HFSM_IF_PROFILER(, nullptr)
+							  HFSM_IF_STATISTICS(, nullptr)
+							  HFSM_IF_TIMERS(, _timers)};
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	return deepForwardExitGuard (guardControl, 0) ||
+		   deepForwardEntryGuard(guardControl, 0);
+}
 
-	struct UP {
-		HFSM_INLINE UP(const Utility utility_  = Utility{1.0f},
-					   const ShortIndex prong_ = INVALID_SHORT_INDEX)
-			: utility{utility_}
-			, prong{prong_}
-		{}
+////////////////////////////////////////////////////////////////////////////////
 
-		Utility utility;
-		ShortIndex prong;
-	};
+template <typename TF>
+StateID
+RuntimeR_<TF>::prong(const RegionID regionId,
+					 const ShortIndex index) const
+{
+	HFSM_ASSERT(index < _layout._widths[regionId]);
+
+	return _layout._prongs[_layout._firstProngs[regionId] + index];
+}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-};
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-//------------------------------------------------------------------------------
+template <typename TF>
+ShortIndex&
+RuntimeR_<TF>::compoRequested(const RegionID regionId) {
+	HFSM_ASSERT(_layout._forks[regionId] > 0);
 
-using Config = ConfigT<>;
+	return _registry.compoRequested[_layout._forks[regionId] - 1];
+}
 
-namespace detail {
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-////////////////////////////////////////////////////////////////////////////////
+template <typename TF>
+ShortIndex&
+RuntimeR_<TF>::compoActive(const RegionID regionId) {
+	HFSM_ASSERT(_layout._forks[regionId] > 0);
 
-template <typename TConfig>
-struct M_ {
-	using Config_ = TConfig;
+	return _registry.compoActive[_layout._forks[regionId] - 1];
+}
 
-	//----------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	template <typename THead, typename... TSubStates>
-	using Composite			 = CI_<Strategy::Composite,	   THead, TSubStates...>;
+template <typename TF>
+ShortIndex&
+RuntimeR_<TF>::compoResumable(const RegionID regionId) {
+	HFSM_ASSERT(_layout._forks[regionId] > 0);
 
-	template <				  typename... TSubStates>
-	using CompositePeers	 = CI_<Strategy::Composite,    void,  TSubStates...>;
+	return _registry.compoResumable[_layout._forks[regionId] - 1];
+}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	template <typename THead, typename... TSubStates>
-	using Resumable			  = CI_<Strategy::Resumable,   THead, TSubStates...>;
+template <typename TF>
+typename RuntimeR_<TF>::ForkBits
+RuntimeR_<TF>::orthoRequested(const RegionID regionId) {
+	HFSM_ASSERT(_layout._forks[regionId] < 0);
 
-	template <				  typename... TSubStates>
-	using ResumablePeers	  = CI_<Strategy::Resumable,   void,  TSubStates...>;
+	return Forks::requested(_registry, _layout._forks[regionId]);
+}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//------------------------------------------------------------------------------
 
-	template <typename THead, typename... TSubStates>
-	using Utilitarian		  = CI_<Strategy::Utilitarian, THead, TSubStates...>;
+template <typename TF>
+bool
+RuntimeR_<TF>::stateEntryGuard(GuardControl& control,
+							   const StateID stateId)
+{
+	const auto callback = _layout._entryGuards[stateId];
+	HFSM_LOG_RUNTIME_METHOD(callback, stateId, Method::ENTRY_GUARD);
 
-	template <				  typename... TSubStates>
-	using UtilitarianPeers	  = CI_<Strategy::Utilitarian, void,  TSubStates...>;
+	ScopedOrigin origin{control, stateId};
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	const bool cancelledBefore = control._cancelled;
 
-	template <typename THead, typename... TSubStates>
-	using Random			  = CI_<Strategy::RandomUtil,  THead, TSubStates...>;
+	if (callback)
+		callback(stateId, control);
 
-	template <				  typename... TSubStates>
-	using RandomPeers		  = CI_<Strategy::RandomUtil,  void,  TSubStates...>;
+	return !cancelledBefore && control._cancelled;
+}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	template <typename THead, typename... TSubStates>
-	using Orthogonal		  = OI_<THead, TSubStates...>;
+template <typename TF>
+void
+RuntimeR_<TF>::stateConstruct(PlanControl& HFSM_IF_ASSERT(control),
+							  const StateID stateId)
+{
+	HFSM_ASSERT(!control._planData.tasksSuccesses.get(stateId));
+	HFSM_ASSERT(!control._planData.tasksFailures .get(stateId));
 
-	template <				  typename... TSubStates>
-	using OrthogonalPeers	  = OI_<void,  TSubStates...>;
+	HFSM_LOG_RUNTIME_METHOD(_layout._enters[stateId], stateId, Method::CONSTRUCT);
+	(void) stateId;
+}
 
-	//----------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	template <typename THead, typename... TSubStates>
-	using Root				  = RF_<Config_, Composite  <THead, TSubStates...>>;
+template <typename TF>
+void
+RuntimeR_<TF>::stateEnter(PlanControl& control,
+						  const StateID stateId)
+{
+	const auto callback = _layout._enters[stateId];
+	HFSM_LOG_RUNTIME_METHOD(callback, stateId, Method::ENTER);
 
-	template <				  typename... TSubStates>
-	using PeerRoot			  = RF_<Config_, CompositePeers  <  TSubStates...>>;
+	ScopedOrigin origin{control, stateId};
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	if (callback)
+		callback(stateId, control);
+}
 
-	template <typename THead, typename... TSubStates>
-	using ResumableRoot		  = RF_<Config_, Resumable  <THead, TSubStates...>>;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	template <				  typename... TSubStates>
-	using ResumablePeerRoot	  = RF_<Config_, ResumablePeers  <  TSubStates...>>;
+template <typename TF>
+void
+RuntimeR_<TF>::stateReenter(PlanControl& control,
+							const StateID stateId)
+{
+	HFSM_ASSERT(!control._planData.tasksSuccesses.get(stateId));
+	HFSM_ASSERT(!control._planData.tasksFailures .get(stateId));
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	const auto callback = _layout._reenters[stateId];
+	HFSM_LOG_RUNTIME_METHOD(callback, stateId, Method::REENTER);
 
-	template <typename THead, typename... TSubStates>
-	using UtilitarianRoot	  = RF_<Config_, Utilitarian<THead, TSubStates...>>;
+	ScopedOrigin origin{control, stateId};
 
-	template <				  typename... TSubStates>
-	using UtilitarianPeerRoot = RF_<Config_, UtilitarianPeers<  TSubStates...>>;
+	if (callback)
+		callback(stateId, control);
+}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	template <typename THead, typename... TSubStates>
-	using RandomRoot		  = RF_<Config_, Random		<THead, TSubStates...>>;
+template <typename TF>
+Status
+RuntimeR_<TF>::stateUpdate(FullControl& control,
+						   const StateID stateId)
+{
+	const auto callback = _layout._updates[stateId];
+	HFSM_LOG_RUNTIME_METHOD(callback, stateId, Method::UPDATE);
 
-	template <				  typename... TSubStates>
-	using RandomPeerRoot	  = RF_<Config_, RandomPeers	 <  TSubStates...>>;
+	ScopedOrigin origin{control, stateId};
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	if (callback)
+		callback(stateId, control);
 
-	template <typename THead, typename... TSubStates>
-	using OrthogonalRoot	  = RF_<Config_, Orthogonal <THead, TSubStates...>>;
+	return control._status;
+}
 
-	template <				  typename... TSubStates>
-	using OrthogonalPeerRoot  = RF_<Config_, OrthogonalPeers <  TSubStates...>>;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	//----------------------------------------------------------------------
-};
+template <typename TF>
+Status
+RuntimeR_<TF>::stateReact(FullControl& control,
+						  const StateID stateId,
+						  const RuntimeEvent& event)
+{
+	const auto callback = _layout._reacts[stateId];
+	HFSM_LOG_RUNTIME_METHOD(callback, stateId, Method::REACT);
 
-////////////////////////////////////////////////////////////////////////////////
+	ScopedOrigin origin{control, stateId};
+
+	if (callback)
+		callback(stateId, event, control);
 
+	return control._status;
 }
 
-using Machine = detail::M_<Config>;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TConfig>
-using MachineT = detail::M_<TConfig>;
+template <typename TF>
+bool
+RuntimeR_<TF>::stateExitGuard(GuardControl& control,
+							  const StateID stateId)
+{
+	const auto callback = _layout._exitGuards[stateId];
+	HFSM_LOG_RUNTIME_METHOD(callback, stateId, Method::EXIT_GUARD);
 
-////////////////////////////////////////////////////////////////////////////////
+	ScopedOrigin origin{control, stateId};
+
+	const bool cancelledBefore = control._cancelled;
+
+	if (callback)
+		callback(stateId, control);
 
+	return !cancelledBefore && control._cancelled;
 }
 
-namespace hfsm2 {
-namespace detail {
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-////////////////////////////////////////////////////////////////////////////////
+template <typename TF>
+void
+RuntimeR_<TF>::stateExit(PlanControl& control,
+						 const StateID stateId)
+{
+	const auto callback = _layout._exits[stateId];
+	HFSM_LOG_RUNTIME_METHOD(callback, stateId, Method::EXIT);
 
-template <typename TConfig,
-		  typename TApex>
-class R_ {
-	using Config_				= TConfig;
-	using Context				= typename Config_::Context;
-	using Rank					= typename Config_::Rank;
-	using Utility				= typename Config_::Utility;
-	using RNG					= typename Config_::RNG;
-	using Logger				= typename Config_::Logger;
+	ScopedOrigin origin{control, stateId};
 
-	using Apex					= TApex;
-	using ApexInfo				= WrapInfo<Apex>;
+	if (callback)
+		callback(stateId, control);
+}
 
-	using Info					= RF_<Config_, Apex>;
-	using StateList				= typename Info::StateList;
-	using RegionList			= typename Info::RegionList;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	static constexpr LongIndex SUBSTITUTION_LIMIT = Info::SUBSTITUTION_LIMIT;
-	static constexpr LongIndex TASK_CAPACITY	  = Info::TASK_CAPACITY;
+template <typename TF>
+void
+RuntimeR_<TF>::stateDestruct(PlanControl& control,
+							 const StateID stateId)
+{
+	HFSM_LOG_RUNTIME_METHOD(_layout._exits[stateId], stateId, Method::DESTRUCT);
 
-public:
-	static constexpr LongIndex  REVERSE_DEPTH	  = ApexInfo::REVERSE_DEPTH;
-	static constexpr ShortIndex COMPO_REGIONS	  = ApexInfo::COMPO_REGIONS;
-	static constexpr LongIndex  COMPO_PRONGS	  = ApexInfo::COMPO_PRONGS;
-	static constexpr ShortIndex ORTHO_REGIONS	  = ApexInfo::ORTHO_REGIONS;
-	static constexpr ShortIndex ORTHO_UNITS		  = ApexInfo::ORTHO_UNITS;
+	HFSM_IF_TIMERS(control._timers.cancel(stateId));
 
-	static constexpr LongIndex  ACTIVE_BITS		  = ApexInfo::ACTIVE_BITS;
-	static constexpr LongIndex  RESUMABLE_BITS	  = ApexInfo::RESUMABLE_BITS;
+	control._planData.tasksSuccesses.reset(stateId);
+	control._planData.tasksFailures .reset(stateId);
+}
 
-	static constexpr LongIndex  STATE_COUNT		  = ApexInfo::STATE_COUNT;
-	static constexpr LongIndex  REGION_COUNT	  = ApexInfo::REGION_COUNT;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	static_assert(STATE_COUNT <  (ShortIndex) -1, "Too many states in the hierarchy. Change 'ShortIndex' type.");
-	static_assert(STATE_COUNT == (ShortIndex) StateList::SIZE, "STATE_COUNT != StateList::SIZE");
+template <typename TF>
+void
+RuntimeR_<TF>::statePlanSucceeded(FullControl& control,
+								  const StateID stateId)
+{
+	const auto callback = _layout._planSucceeded[stateId];
+	HFSM_LOG_RUNTIME_METHOD(callback, stateId, Method::PLAN_SUCCEEDED);
 
-private:
-	using Args					= typename Info::Args;
+	ScopedOrigin origin{control, stateId};
 
-	using Registry				= RegistryT<Args>;
-	using CompoForks			= typename Registry::CompoForks;
-	using RegistryBackUp		= typename Registry::BackUp;
+	if (callback)
+		callback(stateId, control);
+	else
+		control.succeed();
+}
 
-	using MaterialApex			= Material<I_<0, 0, 0, 0>, Args, Apex>;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	using Control				= ControlT<Args>;
+template <typename TF>
+void
+RuntimeR_<TF>::statePlanFailed(FullControl& control,
+							   const StateID stateId)
+{
+	const auto callback = _layout._planFailed[stateId];
+	HFSM_LOG_RUNTIME_METHOD(callback, stateId, Method::PLAN_FAILED);
 
-	using PlanControl			= PlanControlT<Args>;
-	using PlanData				= PlanDataT   <Args>;
+	ScopedOrigin origin{control, stateId};
 
-	using FullControl			= FullControlT<Args>;
-	using Requests				= typename FullControl::Requests;
+	if (callback)
+		callback(stateId, control);
+	else
+		control.fail();
+}
 
-	using GuardControl			= GuardControlT<Args>;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-#ifdef HFSM_ENABLE_STRUCTURE_REPORT
-	static constexpr LongIndex NAME_COUNT	  = MaterialApex::NAME_COUNT;
+template <typename TF>
+typename RuntimeR_<TF>::UP
+RuntimeR_<TF>::stateReport(Control& control,
+						   const StateID stateId)
+{
+	const auto callback = _layout._utilities[stateId];
+	HFSM_LOG_RUNTIME_METHOD(callback, stateId, Method::UTILITY);
 
-	using Prefix				= StaticArray<wchar_t, REVERSE_DEPTH * 2 + 2>;
-	using Prefixes				= StaticArray<Prefix, STATE_COUNT>;
+	const Utility utility = callback ?
+		callback(stateId, static_cast<const Control&>(control)) : Utility{1.0f};
 
-	using StructureStateInfos	= typename Args::StructureStateInfos;
-#endif
+	return {utility, _layout._parents[stateId].prong};
+}
 
-#ifdef HFSM_ENABLE_SERIALIZATION
-	using WriteStream			= typename Args::WriteStream;
-	using ReadStream			= typename Args::ReadStream;
-#endif
+////////////////////////////////////////////////////////////////////////////////
 
-public:
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+template <typename TF>
+bool
+RuntimeR_<TF>::deepForwardEntryGuard(GuardControl& control,
+									 const StateID stateId)
+{
+	const RegionID regionId = _layout._regions[stateId];
 
-#ifdef HFSM_ENABLE_STRUCTURE_REPORT
-	using Structure				= Array<StructureEntry, NAME_COUNT>;
-	using ActivityHistory		= Array<char,			NAME_COUNT>;
-#endif
+	if (regionId == INVALID_REGION_ID)
+		return false;
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL) {
+		const ForkBits requested = orthoRequested(regionId);
 
-public:
-	explicit R_(Context& context,
-				RNG& rng
-				HFSM_IF_LOGGER(, Logger* const logger = nullptr));
+		ScopedRegion region{control, regionId, stateId, _layout._sizes[stateId]};
 
-	~R_();
+		bool cancelled = false;
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			if (!requested || requested.get(i))
+				cancelled |= deepForwardEntryGuard(control, prong(regionId, i));
 
-	template <typename T>
-	static constexpr StateID  stateId()				{ return			StateList ::template index<T>();	}
+		return cancelled;
+	} else {
+		const ShortIndex active	   = compoActive   (regionId);
+		const ShortIndex requested = compoRequested(regionId);
 
-	template <typename T>
-	static constexpr RegionID regionId()			{ return (RegionID) RegionList::template index<T>();	}
+		ScopedRegion region{control, regionId, stateId, _layout._sizes[stateId]};
 
-	//----------------------------------------------------------------------
+		if (requested == INVALID_SHORT_INDEX)
+			return deepForwardEntryGuard(control, prong(regionId, active));
+		else
+			return deepEntryGuard		(control, prong(regionId, requested));
+	}
+}
 
-#ifdef HFSM_EXPLICIT_MEMBER_SPECIALIZATION
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-#ifdef _MSC_VER
-	#pragma warning(push)
-	#pragma warning(disable: 4348) // redefinition of default parameter: parameter 2
-#endif
+template <typename TF>
+bool
+RuntimeR_<TF>::deepEntryGuard(GuardControl& control,
+							  const StateID stateId)
+{
+	const RegionID regionId = _layout._regions[stateId];
 
-	template <typename T, bool = StateList::template contains<T>()>
-	struct Accessor;
+	if (regionId == INVALID_REGION_ID)
+		return stateEntryGuard(control, stateId);
 
-#ifdef _MSC_VER
-	#pragma warning(pop)
-#endif
+	ScopedRegion region{control, regionId, stateId, _layout._sizes[stateId]};
 
-	template <typename T>
-	struct Accessor<T, true> {
-		HFSM_INLINE static		 T& get(	  MaterialApex& apex)	{ return apex.template access<T>();		}
-		HFSM_INLINE static const T& get(const MaterialApex& apex)	{ return apex.template access<T>();		}
-	};
+	if (stateEntryGuard(control, stateId))
+		return true;
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL) {
+		bool cancelled = false;
 
-	// if you see..
-	// VS	 - error C2027: use of undefined type 'hfsm2::detail::R_<..>::Accessor<T,false>'
-	// Clang - error : implicit instantiation of undefined template 'hfsm2::detail::R_<..>::Accessor<*, false>'
-	//
-	// .. you're trying to access() a type that is not present in the state machine hierarchy
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			cancelled |= deepEntryGuard(control, prong(regionId, i));
+
+		return cancelled;
+	} else
+		return deepEntryGuard(control, prong(regionId, compoRequested(regionId)));
+}
+
+//------------------------------------------------------------------------------
 
-	template <typename T>
-	HFSM_INLINE		  T& access()									{ return Accessor<T>::get(_apex);		}
+template <typename TF>
+void
+RuntimeR_<TF>::deepConstruct(PlanControl& control,
+							 const StateID stateId)
+{
+	const RegionID regionId = _layout._regions[stateId];
 
-	template <typename T>
-	HFSM_INLINE const T& access() const								{ return Accessor<T>::get(_apex);		}
+	if (regionId == INVALID_REGION_ID)
+		return stateConstruct(control, stateId);
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL) {
+		orthoRequested(regionId).clear();
 
-#else
+		stateConstruct(control, stateId);
 
-	template <typename T>
-	HFSM_INLINE		  T& access()					{ return Accessor<T,	   MaterialApex>{_apex}.get();	}
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			deepConstruct(control, prong(regionId, i));
+	} else {
+		ShortIndex& active	  = compoActive   (regionId);
+		ShortIndex& resumable = compoResumable(regionId);
+		ShortIndex& requested = compoRequested(regionId);
 
-	template <typename T>
-	HFSM_INLINE const T& access() const				{ return Accessor<T, const MaterialApex>{_apex}.get();	}
+		HFSM_ASSERT(active	  == INVALID_SHORT_INDEX);
+		HFSM_ASSERT(requested != INVALID_SHORT_INDEX);
 
-#endif
+		active	  = requested;
 
-	//----------------------------------------------------------------------
+		if (requested == resumable)
+			resumable = INVALID_SHORT_INDEX;
 
-	void update();
+		requested = INVALID_SHORT_INDEX;
 
-	template <typename TEvent>
-	HFSM_INLINE void react(const TEvent& event);
+		stateConstruct(control, stateId);
+		deepConstruct (control, prong(regionId, active));
+	}
+}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//------------------------------------------------------------------------------
 
-	HFSM_INLINE bool isActive   (const StateID stateId) const	{ return _registry.isActive   (stateId);	}
-	HFSM_INLINE bool isResumable(const StateID stateId) const	{ return _registry.isResumable(stateId);	}
+template <typename TF>
+void
+RuntimeR_<TF>::deepEnter(PlanControl& control,
+						 const StateID stateId)
+{
+	const RegionID regionId = _layout._regions[stateId];
 
-	HFSM_INLINE bool isScheduled(const StateID stateId) const	{ return isResumable(stateId);				}
+	if (regionId == INVALID_REGION_ID)
+		return stateEnter(control, stateId);
 
-	template <typename TState>
-	HFSM_INLINE bool isActive   () const						{ return isActive	(stateId<TState>());	}
+	ScopedRegion region{control, regionId, stateId, _layout._sizes[stateId]};
 
-	template <typename TState>
-	HFSM_INLINE bool isResumable() const						{ return isResumable(stateId<TState>());	}
+	stateEnter(control, stateId);
 
-	template <typename TState>
-	HFSM_INLINE bool isScheduled() const						{ return isResumable<TState>();				}
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL)
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			deepEnter(control, prong(regionId, i));
+	else
+		deepEnter(control, prong(regionId, compoActive(regionId)));
+}
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	HFSM_INLINE void changeTo (const StateID stateId);
-	HFSM_INLINE void restart  (const StateID stateId);
-	HFSM_INLINE void resume	  (const StateID stateId);
-	HFSM_INLINE void utilize  (const StateID stateId);
-	HFSM_INLINE void randomize(const StateID stateId);
-	HFSM_INLINE void schedule (const StateID stateId);
+template <typename TF>
+void
+RuntimeR_<TF>::deepReenter(PlanControl& control,
+						   const StateID stateId)
+{
+	const RegionID regionId = _layout._regions[stateId];
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	if (regionId == INVALID_REGION_ID)
+		return stateReenter(control, stateId);
 
-	template <typename TState>
-	HFSM_INLINE void changeTo ()								{ changeTo (stateId<TState>());				}
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL) {
+		orthoRequested(regionId).clear();
 
-	template <typename TState>
-	HFSM_INLINE void restart  ()								{ restart  (stateId<TState>());				}
+		ScopedRegion region{control, regionId, stateId, _layout._sizes[stateId]};
 
-	template <typename TState>
-	HFSM_INLINE void resume	  ()								{ resume   (stateId<TState>());				}
+		stateReenter(control, stateId);
 
-	template <typename TState>
-	HFSM_INLINE void utilize  ()								{ utilize  (stateId<TState>());				}
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			deepReenter(control, prong(regionId, i));
+	} else {
+		ShortIndex& active	  = compoActive   (regionId);
+		ShortIndex& resumable = compoResumable(regionId);
+		ShortIndex& requested = compoRequested(regionId);
 
-	template <typename TState>
-	HFSM_INLINE void randomize()								{ randomize(stateId<TState>());				}
+		HFSM_ASSERT(active	  != INVALID_SHORT_INDEX &&
+					requested != INVALID_SHORT_INDEX);
 
-	template <typename TState>
-	HFSM_INLINE void schedule ()								{ schedule (stateId<TState>());				}
+		ScopedRegion region{control, regionId, stateId, _layout._sizes[stateId]};
 
-	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+		stateReenter(control, stateId);
 
-#ifdef HFSM_ENABLE_STRUCTURE_REPORT
-	const Structure&	   structure()		 const				{ return _structure;						}
-	const ActivityHistory& activityHistory() const				{ return _activityHistory;					}
-#endif
+		if (active == requested)
+			deepReenter(control, prong(regionId, active));
+		else {
+			deepExit   (control, prong(regionId, active));
 
-#ifdef HFSM_ENABLE_TRANSITION_HISTORY
-	using TransitionHistory		= Array<Transition, COMPO_REGIONS * 4>;
+			active	  = requested;
 
-	const TransitionHistory& transitionHistory() const			{ return _transitionHistory;				}
+			if (requested == resumable)
+				resumable = INVALID_SHORT_INDEX;
 
-	void replayTransition (const Transition& transition)		{ replayTransitions(&transition, 1);		}
-	void replayTransitions(const Transition* const transitions, const uint64_t count);
-#endif
+			deepEnter  (control, prong(regionId, active));
+		}
 
-	void reset();
+		requested = INVALID_SHORT_INDEX;
+	}
+}
 
-#ifdef HFSM_ENABLE_SERIALIZATION
-	// Buffer for serialization
-	//  Members:
-	//   bitSize - Number of payload bits used
-	//   payload - Serialized data
-	//  See https://doc.hfsm.dev/user-guide/debugging-and-tools/serialization
-	using SerialBuffer			= typename Args::SerialBuffer;
+//------------------------------------------------------------------------------
 
-	// Serialize the structural configuration into 'buffer'
-	void save(		SerialBuffer& buffer) const;
+template <typename TF>
+Status
+RuntimeR_<TF>::deepUpdate(FullControl& control,
+						  const StateID stateId)
+{
+	const RegionID regionId = _layout._regions[stateId];
 
-	// De-serialize the configuration and initialize the instance
-	void load(const SerialBuffer& buffer);
-#endif
+	if (regionId == INVALID_REGION_ID)
+		return stateUpdate(control, stateId);
 
-#if defined HFSM_ENABLE_LOG_INTERFACE || defined HFSM_ENABLE_VERBOSE_DEBUG_LOG
-	void attachLogger(Logger* const logger)						{ _logger = logger;							}
-#endif
+	HFSM_IF_UPDATE_PERIODS(if (!_planData.updatePeriods.isDue(regionId)) return Status{});
 
-private:
-	void initialEnter();
-	void processTransitions();
+	ScopedRegion outer{control, regionId, stateId, _layout._sizes[stateId]};
 
-	bool applyRequest (Control& control, const Request& request);
-	bool applyRequests(Control& control);
+	if (const Status headStatus = stateUpdate(control, stateId)) {
+		ControlLock lock{control};
+		subUpdate(control, regionId);
 
-#ifdef HFSM_ENABLE_TRANSITION_HISTORY
-	bool applyRequests(Control& control,
-					   const Transition* const transitions,
-					   const uint64_t count);
-#endif
+		return headStatus;
+	} else {
+		const Status subStatus = subUpdate(control, regionId);
 
-	bool cancelledByEntryGuards(const Requests& pendingChanges);
-	bool cancelledByGuards(const Requests& pendingChanges);
+		if (subStatus.outerTransition)
+			return _layout._types[regionId] == RuntimeRegion::ORTHOGONAL ?
+				subStatus : Status{Status::NONE, true};
 
-#ifdef HFSM_ENABLE_STRUCTURE_REPORT
-	void getStateNames();
-	void udpateActivity();
-#endif
+		ScopedRegion inner{control, regionId, stateId, _layout._sizes[stateId]};
 
-	HFSM_IF_TRANSITION_HISTORY(void recordRequestsAs(const Method method));
+		return subStatus && _planData.planExists.get(regionId) ?
+			updatePlan(control, stateId, subStatus) : subStatus;
+	}
+}
 
-private:
-	Context& _context;
-	RNG& _rng;
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-	Registry _registry;
-	PlanData _planData;
+template <typename TF>
+Status
+RuntimeR_<TF>::deepReact(FullControl& control,
+						 const StateID stateId,
+						 const RuntimeEvent& event)
+{
+	const RegionID regionId = _layout._regions[stateId];
 
-	Requests _requests;
+	if (regionId == INVALID_REGION_ID)
+		return stateReact(control, stateId, event);
 
-	MaterialApex _apex;
+	ScopedRegion outer{control, regionId, stateId, _layout._sizes[stateId]};
 
-#ifdef HFSM_ENABLE_STRUCTURE_REPORT
-	Prefixes _prefixes;
-	StructureStateInfos _stateInfos;
+	if (const Status headStatus = stateReact(control, stateId, event)) {
+		ControlLock lock{control};
+		subReact(control, regionId, event);
 
-	Structure _structure;
-	ActivityHistory _activityHistory;
-#endif
+		return headStatus;
+	} else {
+		const Status subStatus = subReact(control, regionId, event);
 
-	HFSM_IF_TRANSITION_HISTORY(TransitionHistory _transitionHistory);
+		if (subStatus.outerTransition)
+			return subStatus;
 
-	HFSM_IF_LOGGER(Logger* _logger);
-};
+		ScopedRegion inner{control, regionId, stateId, _layout._sizes[stateId]};
 
-////////////////////////////////////////////////////////////////////////////////
+		return subStatus && _planData.planExists.get(regionId) ?
+			updatePlan(control, stateId, subStatus) : subStatus;
+	}
+}
 
-template <typename TConfig,
-		  typename TApex>
-class RW_ final
-	: public R_<TConfig, TApex>
+//------------------------------------------------------------------------------
+
+template <typename TF>
+bool
+RuntimeR_<TF>::deepForwardExitGuard(GuardControl& control,
+									const StateID stateId)
 {
-public:
-	using R_<TConfig, TApex>::R_;
-};
+	const RegionID regionId = _layout._regions[stateId];
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	if (regionId == INVALID_REGION_ID)
+		return false;
 
-template <typename TN_,
-		  typename TU_,
-		  typename TR_,
-		  LongIndex NS,
-		  LongIndex NT,
-		  typename TApex>
-class RW_	   <::hfsm2::ConfigT<::hfsm2::EmptyContext, TN_, TU_, TR_, NS, NT>, TApex> final
-	: public R_<::hfsm2::ConfigT<::hfsm2::EmptyContext, TN_, TU_, TR_, NS, NT>, TApex>
-	, ::hfsm2::EmptyContext
-{
-	using Config_	= ::hfsm2::ConfigT<::hfsm2::EmptyContext, TN_, TU_, TR_, NS, NT>;
-	using Context	= typename Config_::Context;
-	using RNG		= typename Config_::RNG;
-	using Logger	= typename Config_::Logger;
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL) {
+		const ForkBits requested = orthoRequested(regionId);
 
-	using R			= R_<Config_, TApex>;
+		ScopedRegion region{control, regionId, stateId, _layout._sizes[stateId]};
 
-public:
-	explicit HFSM_INLINE RW_(RNG& rng
-							 HFSM_IF_LOGGER(, Logger* const logger = nullptr))
-		: R{static_cast<Context&>(*this),
-			rng
-			HFSM_IF_LOGGER(, logger)}
-	{}
-};
+		bool cancelled = false;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			if (!requested || requested.get(i))
+				cancelled |= deepForwardExitGuard(control, prong(regionId, i));
 
-template <typename TC_,
-		  typename TN_,
-		  typename TU_,
-		  LongIndex NS,
-		  LongIndex NT,
-		  typename TApex>
-class RW_	   <::hfsm2::ConfigT<TC_, TN_, TU_, ::hfsm2::RandomT<TU_>, NS, NT>, TApex> final
-	: public R_<::hfsm2::ConfigT<TC_, TN_, TU_, ::hfsm2::RandomT<TU_>, NS, NT>, TApex>
-	, ::hfsm2::RandomT<TU_>
-{
-	using Config_	= ::hfsm2::ConfigT<TC_, TN_, TU_, ::hfsm2::RandomT<TU_>, NS, NT>;
-	using Context	= typename Config_::Context;
-	using RNG		= typename Config_::RNG;
-	using Logger	= typename Config_::Logger;
+		return cancelled;
+	} else {
+		const ShortIndex active = compoActive(regionId);
+		HFSM_ASSERT(active != INVALID_SHORT_INDEX);
 
-	using R			= R_<Config_, TApex>;
+		ScopedRegion region{control, regionId, stateId, _layout._sizes[stateId]};
 
-public:
-	explicit HFSM_INLINE RW_(Context& context
-							 HFSM_IF_LOGGER(, Logger* const logger = nullptr))
-		: R{context,
-			static_cast<RNG&>(*this)
-			HFSM_IF_LOGGER(, logger)}
-		, RNG{0}
-	{}
-};
+		if (compoRequested(regionId) == INVALID_SHORT_INDEX)
+			return deepForwardExitGuard(control, prong(regionId, active));
+		else
+			return deepExitGuard	   (control, prong(regionId, active));
+	}
+}
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TN_,
-		  typename TU_,
-		  LongIndex NS,
-		  LongIndex NT,
-		  typename TApex>
-class RW_	   <::hfsm2::ConfigT<::hfsm2::EmptyContext, TN_, TU_, ::hfsm2::RandomT<TU_>, NS, NT>, TApex> final
-	: public R_<::hfsm2::ConfigT<::hfsm2::EmptyContext, TN_, TU_, ::hfsm2::RandomT<TU_>, NS, NT>, TApex>
-	, ::hfsm2::EmptyContext
-	, ::hfsm2::RandomT<TU_>
+template <typename TF>
+bool
+RuntimeR_<TF>::deepExitGuard(GuardControl& control,
+							 const StateID stateId)
 {
-	using Config_	= ::hfsm2::ConfigT<::hfsm2::EmptyContext, TN_, TU_, ::hfsm2::RandomT<TU_>, NS, NT>;
-	using Context	= typename Config_::Context;
-	using RNG		= typename Config_::RNG;
-	using Logger	= typename Config_::Logger;
+	const RegionID regionId = _layout._regions[stateId];
 
-	using R			= R_<Config_, TApex>;
+	if (regionId == INVALID_REGION_ID)
+		return stateExitGuard(control, stateId);
 
-public:
-	explicit HFSM_INLINE RW_(HFSM_IF_LOGGER(Logger* const logger = nullptr))
-		: R{static_cast<Context&>(*this),
-			static_cast<RNG&>(*this)
-			HFSM_IF_LOGGER(, logger)}
-		, RNG{0}
-	{}
-};
+	ScopedRegion region{control, regionId, stateId, _layout._sizes[stateId]};
 
-////////////////////////////////////////////////////////////////////////////////
+	if (stateExitGuard(control, stateId))
+		return true;
 
-}
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL) {
+		bool cancelled = false;
+
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			cancelled |= deepExitGuard(control, prong(regionId, i));
+
+		return cancelled;
+	} else
+		return deepExitGuard(control, prong(regionId, compoActive(regionId)));
 }
 
-namespace hfsm2 {
-namespace detail {
+//------------------------------------------------------------------------------
 
-////////////////////////////////////////////////////////////////////////////////
+template <typename TF>
+void
+RuntimeR_<TF>::deepExit(PlanControl& control,
+						const StateID stateId)
+{
+	const RegionID regionId = _layout._regions[stateId];
 
-template <typename TG, typename TA>
-R_<TG, TA>::R_(Context& context,
-			   RNG& rng
-			   HFSM_IF_LOGGER(, Logger* const logger))
-	: _context{context}
-	, _rng{rng}
-	HFSM_IF_LOGGER(, _logger{logger})
+	if (regionId == INVALID_REGION_ID)
+		return stateExit(control, stateId);
+
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL)
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			deepExit(control, prong(regionId, i));
+	else
+		deepExit(control, prong(regionId, compoActive(regionId)));
+
+	stateExit(control, stateId);
+}
+
+//------------------------------------------------------------------------------
+
+template <typename TF>
+void
+RuntimeR_<TF>::deepDestruct(PlanControl& control,
+							const StateID stateId)
 {
-	_apex.deepRegister(_registry, Parent{});
+	const RegionID regionId = _layout._regions[stateId];
 
-	HFSM_IF_STRUCTURE(getStateNames());
+	if (regionId == INVALID_REGION_ID)
+		return stateDestruct(control, stateId);
 
-	initialEnter();
-}
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL) {
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			deepDestruct(control, prong(regionId, i));
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+		stateDestruct(control, stateId);
+	} else {
+		ShortIndex& active	  = compoActive   (regionId);
+		ShortIndex& resumable = compoResumable(regionId);
 
-template <typename TG, typename TA>
-R_<TG, TA>::~R_() {
-	PlanControl control{_context,
-						_rng,
-						_registry,
-						_planData,
-						HFSM_LOGGER_OR(_logger, nullptr)};
+		HFSM_ASSERT(active != INVALID_SHORT_INDEX);
 
-	_apex.deepExit	  (control);
-	_apex.deepDestruct(control);
+		deepDestruct (control, prong(regionId, active));
+		stateDestruct(control, stateId);
 
-	HFSM_IF_ASSERT(_planData.verifyPlans());
+		resumable = active;
+		active	  = INVALID_SHORT_INDEX;
+
+		auto plan = control.plan(regionId);
+		plan.clear();
+	}
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TG, typename TA>
+template <typename TF>
 void
-R_<TG, TA>::update() {
-	FullControl control(_context,
-						_rng,
-						_registry,
-						_planData,
-						_requests,
-						HFSM_LOGGER_OR(_logger, nullptr));
+RuntimeR_<TF>::deepForwardActive(Control& control,
+								 const StateID stateId,
+								 const Request::Type request)
+{
+	const RegionID regionId = _layout._regions[stateId];
 
-	_apex.deepUpdate(control);
+	if (regionId == INVALID_REGION_ID)
+		return;
 
-	HFSM_IF_ASSERT(_planData.verifyPlans());
+	HFSM_ASSERT(control._registry.isActive(stateId));
 
-	if (_requests.count())
-		processTransitions();
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL) {
+		const ForkBits requested = orthoRequested(regionId);
+		HFSM_ASSERT(!!requested);
 
-	_requests.clear();
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i) {
+			const Request::Type local = requested.get(i) ?
+				request : Request::REMAIN;
+
+			deepForwardActive(control, prong(regionId, i), local);
+		}
+	} else {
+		const ShortIndex requested = compoRequested(regionId);
+
+		if (requested == INVALID_SHORT_INDEX)
+			deepForwardActive (control, prong(regionId, compoActive(regionId)), request);
+		else
+			deepForwardRequest(control, prong(regionId, requested), request);
+	}
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TG, typename TA>
-template <typename TEvent>
+template <typename TF>
 void
-R_<TG, TA>::react(const TEvent& event) {
-	FullControl control{_context,
-						_rng,
-						_registry,
-						_planData,
-						_requests,
-						HFSM_LOGGER_OR(_logger, nullptr)};
+RuntimeR_<TF>::deepForwardRequest(Control& control,
+								  const StateID stateId,
+								  const Request::Type request)
+{
+	const RegionID regionId = _layout._regions[stateId];
 
-	_apex.deepReact(control, event);
+	if (regionId == INVALID_REGION_ID)
+		return;
 
-	HFSM_IF_ASSERT(_planData.verifyPlans());
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL) {
+		const ForkBits requested = orthoRequested(regionId);
 
-	if (_requests.count())
-		processTransitions();
+		if (requested)
+			for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i) {
+				const Request::Type local = requested.get(i) ?
+					request : Request::REMAIN;
 
-	_requests.clear();
+				deepForwardRequest(control, prong(regionId, i), local);
+			}
+		else
+			deepRequest(control, stateId, request);
+	} else {
+		const ShortIndex requested = compoRequested(regionId);
+
+		if (requested == INVALID_SHORT_INDEX)
+			deepRequest		  (control, stateId, request);
+		else
+			deepForwardRequest(control, prong(regionId, requested), request);
+	}
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TG, typename TA>
+template <typename TF>
 void
-R_<TG, TA>::changeTo(const StateID stateId) {
-	_requests.append(Request{Request::Type::CHANGE, stateId});
+RuntimeR_<TF>::deepRequest(Control& control,
+						   const StateID stateId,
+						   const Request::Type request)
+{
+	switch (request) {
+	case Request::REMAIN:
+		deepRequestRemain (control, stateId);
+		break;
 
-	HFSM_LOG_TRANSITION(_context, INVALID_STATE_ID, TransitionType::CHANGE, stateId);
-}
+	case Request::CHANGE:
+		deepRequestChange (control, stateId);
+		break;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	case Request::RESTART:
+		deepRequestRestart(control, stateId);
+		break;
 
-template <typename TG, typename TA>
-void
-R_<TG, TA>::restart(const StateID stateId) {
-	_requests.append(Request{Request::Type::RESTART, stateId});
+	case Request::RESUME:
+		deepRequestResume (control, stateId);
+		break;
 
-	HFSM_LOG_TRANSITION(_context, INVALID_STATE_ID, TransitionType::RESTART, stateId);
+	case Request::UTILIZE:
+		deepRequestUtilize(control, stateId);
+		break;
+
+	default:
+		HFSM_BREAK();
+	}
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TG, typename TA>
+template <typename TF>
 void
-R_<TG, TA>::resume(const StateID stateId) {
-	_requests.append(Request{Request::Type::RESUME, stateId});
+RuntimeR_<TF>::deepRequestChange(Control& control,
+								 const StateID stateId)
+{
+	const RegionID regionId = _layout._regions[stateId];
 
-	HFSM_LOG_TRANSITION(_context, INVALID_STATE_ID, TransitionType::RESUME, stateId);
-}
+	if (regionId == INVALID_REGION_ID)
+		return;
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+	switch (_layout._types[regionId]) {
+	case RuntimeRegion::COMPOSITE:
+		compoRequested(regionId) = 0;
 
-template <typename TG, typename TA>
-void
-R_<TG, TA>::utilize(const StateID stateId) {
-	_requests.append(Request{Request::Type::UTILIZE, stateId});
+		deepRequestChange(control, prong(regionId, 0));
+		break;
 
-	HFSM_LOG_TRANSITION(_context, INVALID_STATE_ID, TransitionType::UTILIZE, stateId);
-}
+	case RuntimeRegion::RESUMABLE:
+	{
+		const ShortIndex  resumable = compoResumable(regionId);
+			  ShortIndex& requested = compoRequested(regionId);
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+		requested = (resumable != INVALID_SHORT_INDEX) ?
+			resumable : 0;
 
-template <typename TG, typename TA>
-void
-R_<TG, TA>::randomize(const StateID stateId) {
-	_requests.append(Request{Request::Type::RANDOMIZE, stateId});
+		deepRequestChange(control, prong(regionId, requested));
+		break;
+	}
 
-	HFSM_LOG_TRANSITION(_context, INVALID_STATE_ID, TransitionType::RANDOMIZE, stateId);
-}
+	case RuntimeRegion::UTILITARIAN:
+	{
+		const UP s = subReportChange(control, regionId);
+		HFSM_ASSERT(s.prong != INVALID_SHORT_INDEX);
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+		ShortIndex& requested = compoRequested(regionId);
+		requested = s.prong;
 
-template <typename TG, typename TA>
-void
-R_<TG, TA>::schedule(const StateID stateId) {
-	_requests.append(Request{Request::Type::SCHEDULE, stateId});
+		HFSM_LOG_UTILITY_RESOLUTION(control.context(), stateId, requested, s.utility);
+		break;
+	}
 
-	HFSM_LOG_TRANSITION(_context, INVALID_STATE_ID, TransitionType::SCHEDULE, stateId);
-}
+	case RuntimeRegion::ORTHOGONAL:
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			deepRequestChange(control, prong(regionId, i));
+		break;
 
-//------------------------------------------------------------------------------
+	default:
+		HFSM_BREAK();
+	}
+}
 
-#ifdef HFSM_ENABLE_TRANSITION_HISTORY
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TG, typename TA>
+template <typename TF>
 void
-R_<TG, TA>::replayTransitions(const Transition* const transitions,
-							  const uint64_t count)
+RuntimeR_<TF>::deepRequestRemain(Control& control,
+								 const StateID stateId)
 {
-	if (HFSM_CHECKED(transitions && count)) {
-		HFSM_IF_TRANSITION_HISTORY(_transitionHistory.clear());
-
-		PlanControl control{_context,
-							_rng,
-							_registry,
-							_planData,
-							HFSM_LOGGER_OR(_logger, nullptr)};
-
-		if (applyRequests(control, transitions, count)) {
-			_apex.deepChangeToRequested(control);
+	const RegionID regionId = _layout._regions[stateId];
 
-			_registry.clearRequests();
+	if (regionId == INVALID_REGION_ID)
+		return;
 
-			HFSM_IF_ASSERT(_planData.verifyPlans());
-		}
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL)
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			deepRequestRemain(control, prong(regionId, i));
+	else {
+		if (compoActive(regionId) == INVALID_SHORT_INDEX)
+			compoRequested(regionId) = 0;
 
-		HFSM_IF_STRUCTURE(udpateActivity());
+		deepRequestRemain(control, prong(regionId, 0));
 	}
 }
 
-#endif
-
-//------------------------------------------------------------------------------
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TG, typename TA>
+template <typename TF>
 void
-R_<TG, TA>::reset() {
-	PlanControl control{_context,
-						_rng,
-						_registry,
-						_planData,
-						HFSM_LOGGER_OR(_logger, nullptr)};
+RuntimeR_<TF>::deepRequestRestart(Control& control,
+								  const StateID stateId)
+{
+	const RegionID regionId = _layout._regions[stateId];
 
-	_apex.deepExit	   (control);
-	_apex.deepDestruct (control);
+	if (regionId == INVALID_REGION_ID)
+		return;
 
-	_registry.reset();
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL)
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			deepRequestRestart(control, prong(regionId, i));
+	else {
+		compoRequested(regionId) = 0;
 
-	_apex.deepRequestChange(control);
-	_apex.deepConstruct(control);
-	_apex.deepEnter	   (control);
+		deepRequestRestart(control, prong(regionId, 0));
+	}
 }
 
-//------------------------------------------------------------------------------
-
-#ifdef HFSM_ENABLE_SERIALIZATION
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TG, typename TA>
+template <typename TF>
 void
-R_<TG, TA>::save(SerialBuffer& _buffer) const {
-	WriteStream stream{_buffer};
+RuntimeR_<TF>::deepRequestResume(Control& control,
+								 const StateID stateId)
+{
+	const RegionID regionId = _layout._regions[stateId];
 
-	_apex.deepSaveActive(_registry, stream);
+	if (regionId == INVALID_REGION_ID)
+		return;
+
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL)
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			deepRequestResume(control, prong(regionId, i));
+	else {
+		const ShortIndex  resumable = compoResumable(regionId);
+			  ShortIndex& requested = compoRequested(regionId);
+
+		requested = (resumable != INVALID_SHORT_INDEX) ?
+			resumable : 0;
+
+		deepRequestResume(control, prong(regionId, requested));
+	}
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TG, typename TA>
+template <typename TF>
 void
-R_<TG, TA>::load(const SerialBuffer& buffer) {
-	PlanControl control{_context,
-						_rng,
-						_registry,
-						_planData,
-						HFSM_LOGGER_OR(_logger, nullptr)};
+RuntimeR_<TF>::deepRequestUtilize(Control& control,
+								  const StateID stateId)
+{
+	const RegionID regionId = _layout._regions[stateId];
 
-	_apex.deepExit	   (control);
-	_apex.deepDestruct (control);
+	if (regionId == INVALID_REGION_ID)
+		return;
 
-	ReadStream stream{buffer};
-	_apex.deepLoadRequested(_registry, stream);
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL)
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			deepRequestUtilize(control, prong(regionId, i));
+	else {
+		const UP s = subReportUtilize(control, regionId);
 
-	_apex.deepConstruct(control);
-	_apex.deepEnter	   (control);
-}
+		ShortIndex& requested = compoRequested(regionId);
+		requested = s.prong;
 
-#endif
+		HFSM_LOG_UTILITY_RESOLUTION(control.context(), stateId, requested, s.utility);
+	}
+}
 
 //------------------------------------------------------------------------------
 
-template <typename TG, typename TA>
-void
-R_<TG, TA>::initialEnter() {
-	HFSM_ASSERT(_requests.count() == 0);
-	HFSM_IF_TRANSITION_HISTORY(HFSM_ASSERT(_transitionHistory.count() == 0));
+template <typename TF>
+typename RuntimeR_<TF>::UP
+RuntimeR_<TF>::deepReportChange(Control& control,
+								const StateID stateId)
+{
+	const RegionID regionId = _layout._regions[stateId];
 
-	RegistryBackUp undo;
-	HFSM_IF_TRANSITION_HISTORY(TransitionHistory undoTransitionHistory);
+	if (regionId == INVALID_REGION_ID)
+		return stateReport(control, stateId);
 
-	Requests lastRequests;
+	switch (_layout._types[regionId]) {
+	case RuntimeRegion::COMPOSITE:
+	{
+		compoRequested(regionId) = 0;
 
-	PlanControl control{_context,
-						_rng,
-						_registry,
-						_planData,
-						HFSM_LOGGER_OR(_logger, nullptr)};
+		const UP h = stateReport	 (control, stateId);
+		const UP s = deepReportChange(control, prong(regionId, 0));
 
-	_apex.deepRequestChange(control);
+		return {
+			h.utility * s.utility,
+			h.prong
+		};
+	}
 
-	cancelledByEntryGuards(_requests);
+	case RuntimeRegion::RESUMABLE:
+	{
+		const ShortIndex  resumable = compoResumable(regionId);
+			  ShortIndex& requested = compoRequested(regionId);
 
-	for (LongIndex i = 0;
-		 i < SUBSTITUTION_LIMIT && _requests.count();
-		 ++i)
+		requested = (resumable != INVALID_SHORT_INDEX) ?
+			resumable : 0;
+
+		const UP h = stateReport	 (control, stateId);
+		const UP s = deepReportChange(control, prong(regionId, requested));
+
+		return {
+			h.utility * s.utility,
+			h.prong
+		};
+	}
+
+	case RuntimeRegion::UTILITARIAN:
 	{
-		backup(_registry, undo);
-		HFSM_IF_TRANSITION_HISTORY(undoTransitionHistory = _transitionHistory);
+		const UP h = stateReport	(control, stateId);
+		const UP s = subReportChange(control, regionId);
 
-		if (applyRequests(control)) {
-			lastRequests = _requests;
-			_requests.clear();
+		ShortIndex& requested = compoRequested(regionId);
+		requested = s.prong;
 
-			if (cancelledByEntryGuards(lastRequests)) {
-				restore(_registry, undo);
-				HFSM_IF_TRANSITION_HISTORY(_transitionHistory = undoTransitionHistory);
-			}
-		} else
-			_requests.clear();
+		HFSM_LOG_UTILITY_RESOLUTION(control.context(), stateId, requested, s.utility);
+
+		return {
+			h.utility * s.utility,
+			h.prong
+		};
 	}
-	HFSM_ASSERT(_requests.count() == 0);
 
-	_apex.deepConstruct(control);
-	_apex.deepEnter	   (control);
+	case RuntimeRegion::ORTHOGONAL:
+	{
+		const UP h = stateReport(control, stateId);
 
-	_registry.clearRequests();
+		Utility s = Utility{0.0f};
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			s += deepReportChange(control, prong(regionId, i)).utility;
 
-	HFSM_IF_ASSERT(_planData.verifyPlans());
+		const Utility sub = s / _layout._widths[regionId];
 
-	HFSM_IF_STRUCTURE(udpateActivity());
+		HFSM_LOG_UTILITY_RESOLUTION(control.context(), stateId, INVALID_STATE_ID, sub);
+
+		return {
+			h.utility * sub,
+			h.prong
+		};
+	}
+
+	default:
+		HFSM_BREAK();
+
+		return {};
+	}
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TG, typename TA>
-void
-R_<TG, TA>::processTransitions() {
-	HFSM_ASSERT(_requests.count());
-
-	HFSM_IF_TRANSITION_HISTORY(_transitionHistory.clear());
-
-	RegistryBackUp undo;
-	HFSM_IF_TRANSITION_HISTORY(TransitionHistory undoTransitionHistory);
+template <typename TF>
+typename RuntimeR_<TF>::UP
+RuntimeR_<TF>::deepReportUtilize(Control& control,
+								 const StateID stateId)
+{
+	const RegionID regionId = _layout._regions[stateId];
 
-	Requests lastRequests;
+	if (regionId == INVALID_REGION_ID)
+		return stateReport(control, stateId);
 
-	PlanControl control{_context,
-						_rng,
-						_registry,
-						_planData,
-						HFSM_LOGGER_OR(_logger, nullptr)};
+	const UP h = stateReport(control, stateId);
 
-	bool changesMade = false;
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL) {
+		Utility s = Utility{0.0f};
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			s += deepReportUtilize(control, prong(regionId, i)).utility;
 
-	for (LongIndex i = 0;
-		i < SUBSTITUTION_LIMIT && _requests.count();
-		++i)
-	{
-		backup(_registry, undo);
-		HFSM_IF_TRANSITION_HISTORY(undoTransitionHistory = _transitionHistory);
+		const Utility sub = s / _layout._widths[regionId];
 
-		if (applyRequests(control)) {
-			lastRequests = _requests;
-			_requests.clear();
+		HFSM_LOG_UTILITY_RESOLUTION(control.context(), stateId, INVALID_STATE_ID, sub);
 
-			if (cancelledByGuards(lastRequests)) {
-				restore(_registry, undo);
-				HFSM_IF_TRANSITION_HISTORY(_transitionHistory = undoTransitionHistory);
-			} else
-				changesMade = true;
-		} else
-			_requests.clear();
-	}
+		return {
+			h.utility * sub,
+			h.prong
+		};
+	} else {
+		const UP s = subReportUtilize(control, regionId);
 
-	if (changesMade) {
-		_apex.deepChangeToRequested(control);
+		ShortIndex& requested = compoRequested(regionId);
+		requested = s.prong;
 
-		_registry.clearRequests();
+		HFSM_LOG_UTILITY_RESOLUTION(control.context(), stateId, requested, s.utility);
 
-		HFSM_IF_ASSERT(_planData.verifyPlans());
+		return {
+			h.utility * s.utility,
+			h.prong
+		};
 	}
-
-	HFSM_IF_STRUCTURE(udpateActivity());
 }
 
 //------------------------------------------------------------------------------
 
-template <typename TG, typename TA>
-bool
-R_<TG, TA>::applyRequest(Control& control,
-						 const Request& request)
+template <typename TF>
+void
+RuntimeR_<TF>::deepChangeToRequested(PlanControl& control,
+									 const StateID stateId)
 {
-	HFSM_IF_TRANSITION_HISTORY(_transitionHistory.append(Transition{request, Method::NONE}));
+	const RegionID regionId = _layout._regions[stateId];
 
-	switch (request.type) {
-	case Request::CHANGE:
-	case Request::RESTART:
-	case Request::RESUME:
-	case Request::UTILIZE:
-	case Request::RANDOMIZE:
-		if (_registry.requestImmediate(request))
-			_apex.deepForwardActive(control, request.type);
-		else
-			_apex.deepRequest	   (control, request.type);
+	if (regionId == INVALID_REGION_ID)
+		return;
 
-		return true;
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL) {
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			deepChangeToRequested(control, prong(regionId, i));
 
-	case Request::SCHEDULE:
-		_registry.requestScheduled(request.stateId);
+		return;
+	}
 
-		return false;
+	ShortIndex& active	  = compoActive	  (regionId);
+	ShortIndex& resumable = compoResumable(regionId);
+	ShortIndex& requested = compoRequested(regionId);
 
-	default:
-		HFSM_BREAK();
+	HFSM_ASSERT(active != INVALID_SHORT_INDEX);
 
-		return false;
+	if (requested == INVALID_SHORT_INDEX)
+		deepChangeToRequested(control, prong(regionId, active));
+	else if (requested != active) {
+		deepExit	 (control, prong(regionId, active));
+		deepDestruct (control, prong(regionId, active));
+
+		resumable = active;
+		active	  = requested;
+		requested = INVALID_SHORT_INDEX;
+
+		deepConstruct(control, prong(regionId, active));
+		deepEnter	 (control, prong(regionId, active));
+	} else if (_registry.compoRemains.get((ShortIndex) (_layout._forks[regionId] - 1))) {
+		deepExit	 (control, prong(regionId, active));
+		deepDestruct (control, prong(regionId, active));
+
+		requested = INVALID_SHORT_INDEX;
+
+		deepConstruct(control, prong(regionId, active));
+		deepEnter	 (control, prong(regionId, active));
+	} else {
+		requested = INVALID_SHORT_INDEX;
+
+		// no reconstruction on reenter() by design
+		deepReenter	 (control, prong(regionId, active));
 	}
 }
 
-// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+//------------------------------------------------------------------------------
 
-template <typename TG, typename TA>
-bool
-R_<TG, TA>::applyRequests(Control& control) {
-	bool changesMade = false;
+template <typename TF>
+Status
+RuntimeR_<TF>::subUpdate(FullControl& control,
+						 const RegionID regionId)
+{
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL) {
+		Status status;
 
-	for (const Request& request : _requests)
-		changesMade |= applyRequest(control, request);
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			status = combine(status, deepUpdate(control, prong(regionId, i)));
 
-	return changesMade;
+		return status;
+	} else {
+		const ShortIndex active = compoActive(regionId);
+		HFSM_ASSERT(active != INVALID_SHORT_INDEX);
+
+		return deepUpdate(control, prong(regionId, active));
+	}
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-#ifdef HFSM_ENABLE_TRANSITION_HISTORY
-
-template <typename TG, typename TA>
-bool
-R_<TG, TA>::applyRequests(Control& control,
-						  const Transition* const transitions,
-						  const uint64_t count)
+template <typename TF>
+Status
+RuntimeR_<TF>::subReact(FullControl& control,
+						const RegionID regionId,
+						const RuntimeEvent& event)
 {
-	if (HFSM_CHECKED(transitions && count)) {
-		bool changesMade = false;
+	if (_layout._types[regionId] == RuntimeRegion::ORTHOGONAL) {
+		Status status;
 
-		for (uint64_t i = 0; i < count; ++i)
-			changesMade |= applyRequest(control, transitions[i].request());
+		for (ShortIndex i = 0; i < _layout._widths[regionId]; ++i)
+			status = combine(status, deepReact(control, prong(regionId, i), event));
 
-		return changesMade;
-	} else
-		return false;
+		return status;
+	} else {
+		const ShortIndex active = compoActive(regionId);
+		HFSM_ASSERT(active != INVALID_SHORT_INDEX);
+
+		return deepReact(control, prong(regionId, active), event);
+	}
 }
 
-#endif
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-//------------------------------------------------------------------------------
+template <typename TF>
+typename RuntimeR_<TF>::UP
+RuntimeR_<TF>::subReportChange(Control& control,
+							   const RegionID regionId)
+{
+	UP best = deepReportChange(control, prong(regionId, 0));
 
-template <typename TG, typename TA>
-bool
-R_<TG, TA>::cancelledByEntryGuards(const Requests& pendingRequests) {
-	GuardControl guardControl{_context,
-							  _rng,
-							  _registry,
-							  _planData,
-							  _requests,
-							  pendingRequests,
-							  HFSM_LOGGER_OR(_logger, nullptr)};
+	// the first of equal prongs wins
+	for (ShortIndex i = 1; i < _layout._widths[regionId]; ++i) {
+		const UP s = deepReportChange(control, prong(regionId, i));
 
-	if (_apex.deepEntryGuard(guardControl)) {
-		HFSM_IF_TRANSITION_HISTORY(recordRequestsAs(Method::ENTRY_GUARD));
+		if (best.utility < s.utility)
+			best = s;
+	}
 
-		return true;
-	} else
-		return false;
+	return best;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TG, typename TA>
-bool
-R_<TG, TA>::cancelledByGuards(const Requests& pendingRequests) {
-	GuardControl guardControl{_context,
-							  _rng,
-							  _registry,
-							  _planData,
-							  _requests,
-							  pendingRequests,
-							  HFSM_LOGGER_OR(_logger, nullptr)};
+template <typename TF>
+typename RuntimeR_<TF>::UP
+RuntimeR_<TF>::subReportUtilize(Control& control,
+								const RegionID regionId)
+{
+	UP best = deepReportUtilize(control, prong(regionId, 0));
 
-	if (_apex.deepForwardExitGuard(guardControl)) {
-		HFSM_IF_TRANSITION_HISTORY(recordRequestsAs(Method::EXIT_GUARD));
+	for (ShortIndex i = 1; i < _layout._widths[regionId]; ++i) {
+		const UP s = deepReportUtilize(control, prong(regionId, i));
 
-		return true;
-	} else if (_apex.deepForwardEntryGuard(guardControl)) {
-		HFSM_IF_TRANSITION_HISTORY(recordRequestsAs(Method::ENTRY_GUARD));
+		if (best.utility < s.utility)
+			best = s;
+	}
 
-		return true;
-	} else
-		return false;
+	return best;
 }
 
 //------------------------------------------------------------------------------
 
-#ifdef HFSM_ENABLE_STRUCTURE_REPORT
-
-template <typename TG, typename TA>
-void
-R_<TG, TA>::getStateNames() {
-	_stateInfos.clear();
-	_apex.deepGetNames((LongIndex) -1, StructureStateInfo::COMPOSITE, 0, _stateInfos);
-
-	LongIndex margin = (LongIndex) -1;
-	for (LongIndex s = 0; s < _stateInfos.count(); ++s) {
-		const auto& state = _stateInfos[s];
-		auto& prefix      = _prefixes[s];
+template <typename TF>
+Status
+RuntimeR_<TF>::updatePlan(FullControl& control,
+						  const StateID headId,
+						  const Status subStatus)
+{
+	HFSM_ASSERT(subStatus);
 
-		if (margin > state.depth && state.name[0] != '\0')
-			margin = state.depth;
+	if (subStatus.result == Status::FAILURE) {
+		control._status.result = Status::FAILURE;
+		statePlanFailed(control, headId);
 
-		if (state.depth == 0)
-			prefix[0] = L'\0';
-		else {
-			const LongIndex mark = state.depth * 2 - 1;
+		if (auto p = control.plan(control._regionId))
+			p.clear();
 
-			prefix[mark + 0] = state.region == StructureStateInfo::COMPOSITE ? L'└' : L'╙';
-			prefix[mark + 1] = L' ';
-			prefix[mark + 2] = L'\0';
+		return buildPlanStatus(control, headId);
+	} else if (subStatus.result == Status::SUCCESS) {
+		if (auto p = control.plan(control._regionId)) {
+			for (auto it = p.first(); it; ++it) {
+				if (control.hasSucceeded(it->origin)) {
+					HFSM_ASSERT(control.isActive(it->origin));
 
-			for (auto d = mark; d > 0; --d)
-				prefix[d - 1] = L' ';
+					ScopedOrigin origin{control, headId};
 
-			for (auto r = s; r > state.parent; --r) {
-				auto& prefixAbove = _prefixes[r - 1];
+					control.changeTo(it->destination);
 
-				switch (prefixAbove[mark]) {
-				case L' ':
-					prefixAbove[mark] = state.region == StructureStateInfo::COMPOSITE ? L'│' : L'║';
-					break;
-				case L'└':
-					prefixAbove[mark] = L'├';
-					break;
-				case L'╙':
-					prefixAbove[mark] = L'╟';
+					it.remove();
+				} else
 					break;
-				}
 			}
-		}
-	}
-	if (margin > 0)
-		margin -= 1;
-
-	_structure.clear();
-	for (LongIndex s = 0; s < _stateInfos.count(); ++s) {
-		const auto& state = _stateInfos[s];
-		auto& prefix = _prefixes[s];
-		const LongIndex space = state.depth * 2;
-
-		if (state.name[0] != L'\0') {
-			_structure.append(StructureEntry{false, &prefix[margin * 2], state.name});
-			_activityHistory.append((char) 0);
-		} else if (s + 1 < _stateInfos.count()) {
-			auto& nextPrefix = _prefixes[s + 1];
-
-			if (s > 0)
-				for (LongIndex c = 0; c <= space; ++c)
-					nextPrefix[c] = prefix[c];
 
-			const LongIndex mark = space + 1;
+			return Status{};
+		} else {
+			control._status.result = Status::SUCCESS;
+			statePlanSucceeded(control, headId);
 
-			switch (nextPrefix[mark]) {
-			case L'├':
-				nextPrefix[mark] = state.depth == margin ? L'┌' : L'┬';
-				break;
-			case L'╟':
-				nextPrefix[mark] = state.depth == margin ? L'╓' : L'╥';
-				break;
-			}
+			return buildPlanStatus(control, headId);
 		}
-	}
+	} else
+		return Status{};
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
-template <typename TG, typename TA>
-void
-R_<TG, TA>::udpateActivity() {
-	for (LongIndex s = 0, i = 0; s < _stateInfos.count(); ++s)
-		if (_stateInfos[s].name[0] != L'\0') {
-			_structure[i].isActive = isActive(s);
-
-			auto& activity = _activityHistory[i];
+template <typename TF>
+Status
+RuntimeR_<TF>::buildPlanStatus(FullControl& control,
+							   const StateID headId)
+{
+	switch (control._status.result) {
+	case Status::NONE:
+		HFSM_BREAK();
+		break;
 
-			if (_structure[i].isActive) {
-				if (activity < 0)
-					activity = +1;
-				else
-					activity = activity < INT8_MAX ? activity + 1 : activity;
-			} else {
-				if (activity > 0)
-					activity = -1;
-				else
-					activity = activity > INT8_MIN ? activity - 1 : activity;
-			}
+	case Status::SUCCESS:
+		control.setSucceeded(headId);
 
-			++i;
-		}
-}
+		HFSM_LOG_PLAN_STATUS(_context, control._regionId, StatusEvent::SUCCEEDED);
+		break;
 
-#endif
+	case Status::FAILURE:
+		control.setFailed(headId);
 
-//------------------------------------------------------------------------------
+		HFSM_LOG_PLAN_STATUS(_context, control._regionId, StatusEvent::FAILED);
+		break;
 
-#ifdef HFSM_ENABLE_TRANSITION_HISTORY
+	default:
+		HFSM_BREAK();
+	}
 
-template <typename TG, typename TA>
-void
-R_<TG, TA>::recordRequestsAs(const Method method) {
-	for (const auto& request : _requests)
-		_transitionHistory.append(Transition{request, method});
+	return {control._status.result};
 }
 
-#endif
-
 ////////////////////////////////////////////////////////////////////////////////
 
 }
@@ -11372,4 +18937,18 @@ R_<TG, TA>::recordRequestsAs(const Method method) {
 #undef HFSM_IF_LOGGER
 #undef HFSM_LOGGER_OR
 #undef HFSM_LOG_STATE_METHOD
+#undef HFSM_LOG_RUNTIME_METHOD
 #undef HFSM_IF_STRUCTURE
+#undef HFSM_IF_PROFILER
+#undef HFSM_PROFILE_STATE_METHOD
+#undef HFSM_IF_STATISTICS
+#undef HFSM_RECORD_STATE_ACTIVITY
+#undef HFSM_IF_WATCHDOG
+#undef HFSM_IF_TIMERS
+#undef HFSM_IF_UPDATE_PERIODS
+#undef HFSM_IF_POOL_INDEX
+#undef HFSM_IF_PAYLOADS
+#undef HFSM_IF_STATIC_PLANS
+#undef HFSM_IF_PLAN_QUOTAS
+#undef HFSM_IF_PARALLEL
+#undef HFSM_IF_COROUTINES
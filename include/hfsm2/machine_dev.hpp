@@ -36,8 +36,38 @@
 #include <typeindex>
 #include <utility>			// std::conditional<>, move(), forward()
 
-#if defined _DEBUG && _MSC_VER
-	#include <intrin.h>		// __debugbreak()
+#if defined _MSC_VER && (defined _DEBUG || defined HFSM_PROFILER_RDTSC)
+	#include <intrin.h>		// __debugbreak(), __rdtsc()
+#endif
+
+#ifdef HFSM_ENABLE_COROUTINES
+	#ifndef __cpp_impl_coroutine
+		#error "HFSM_ENABLE_COROUTINES requires C++20 coroutine support"
+	#endif
+
+	#include <cstddef>		// max_align_t
+	#include <coroutine>
+	#include <exception>	// terminate()
+#endif
+
+#ifdef HFSM_ENABLE_POOL
+	#include <algorithm>	// sort()
+#endif
+
+#if defined HFSM_ENABLE_PROFILER || defined HFSM_ENABLE_POOL
+	#include <chrono>		// steady_clock
+#endif
+
+#ifdef HFSM_ENABLE_TRANSITION_TRACE
+	#include <atomic>
+#endif
+
+#if defined HFSM_ENABLE_PROFILER || defined HFSM_ENABLE_STATISTICS
+	#include <stdio.h>		// fopen(), fprintf()
+#endif
+
+#if defined HFSM_ENABLE_PROFILER && defined HFSM_PROFILER_RDTSC && !defined _MSC_VER
+	#include <x86intrin.h>	// __rdtsc()
 #endif
 
 #define HFSM_INLINE														  //inline
@@ -72,15 +102,25 @@ struct EmptyPayload {};
 #include "detail/shared/list.hpp"
 #include "detail/shared/random.hpp"
 #include "detail/shared/type_list.hpp"
+#include "detail/shared/event_buffer.hpp"
 
 #include "detail/debug/shared.hpp"
 #include "detail/debug/logger_interface.hpp"
-
+#include "detail/debug/profiler.hpp"
+#include "detail/debug/statistics.hpp"
+#include "detail/debug/watchdog.hpp"
+
+#include "detail/root/executor.hpp"
+#include "detail/root/payloads.hpp"
+#include "detail/root/coroutines.hpp"
+#include "detail/root/static_plan.hpp"
 #include "detail/root/plan_data.hpp"
 #include "detail/root/plan.hpp"
 #include "detail/root/registry.hpp"
+#include "detail/root/timers.hpp"
 #include "detail/root/control.hpp"
 #include "detail/debug/structure_report.hpp"
+#include "detail/debug/transition_trace.hpp"
 
 #include "detail/structure/injections.hpp"
 #include "detail/structure/state_box.hpp"
@@ -96,40 +136,63 @@ namespace hfsm2 {
 
 //------------------------------------------------------------------------------
 
+// TL_ - logger policy, any type providing LoggerInterfaceT's member functions
+//  'void' selects LoggerInterfaceT<Context, Utility>
+//  Calls into a non-virtual policy are dispatched statically,
+//  EmptyLoggerT compiles down to nothing
+// NP  - transition payload size in bytes, used with HFSM_ENABLE_PAYLOADS
+// NA  - coroutine frame arena size in bytes, used with HFSM_ENABLE_COROUTINES
+
 template <typename TC_ = EmptyContext,
 		  typename TN_ = char,
 		  typename TU_ = float,
 		  typename TG_ = ::hfsm2::RandomT<TU_>,
 		  LongIndex NS = 4,
-		  LongIndex NT = INVALID_LONG_INDEX>
+		  LongIndex NT = INVALID_LONG_INDEX,
+		  typename TL_ = void,
+		  LongIndex NP = 16,
+		  LongIndex NA = 1024>
 struct ConfigT {
 	using Context = TC_;
 
 	using Rank	  = TN_;
 	using Utility = TU_;
 	using RNG	  = TG_;
-	using Logger  = LoggerInterfaceT<Context, Utility>;
+	using Logger  = typename std::conditional<std::is_same<TL_, void>::value,
+											  LoggerInterfaceT<Context, Utility>,
+											  TL_>::type;
 
 	static constexpr LongIndex SUBSTITUTION_LIMIT = NS;
 	static constexpr LongIndex TASK_CAPACITY	  = NT;
+	static constexpr LongIndex PAYLOAD_SIZE		  = NP;
+	static constexpr LongIndex COROUTINE_ARENA_SIZE = NA;
 
 	template <typename T>
-	using ContextT			 = ConfigT<  T, TN_, TU_, TG_, NS, NT>;
+	using ContextT			 = ConfigT<  T, TN_, TU_, TG_, NS, NT, TL_, NP, NA>;
 
 	template <typename T>
-	using RankT				 = ConfigT<TC_,   T, TU_, TG_, NS, NT>;
+	using RankT				 = ConfigT<TC_,   T, TU_, TG_, NS, NT, TL_, NP, NA>;
 
 	template <typename T>
-	using UtilityT			 = ConfigT<TC_, TN_,   T, TG_, NS, NT>;
+	using UtilityT			 = ConfigT<TC_, TN_,   T, TG_, NS, NT, TL_, NP, NA>;
 
 	template <typename T>
-	using RandomT			 = ConfigT<TC_, TN_, TU_,   T, NS, NT>;
+	using RandomT			 = ConfigT<TC_, TN_, TU_,   T, NS, NT, TL_, NP, NA>;
 
 	template <LongIndex N>
-	using SubstitutionLimitN = ConfigT<TC_, TN_, TU_, TG_,  N, NS>;
+	using SubstitutionLimitN = ConfigT<TC_, TN_, TU_, TG_,  N, NT, TL_, NP, NA>;
 
 	template <LongIndex N>
-	using TaskCapacityN		 = ConfigT<TC_, TN_, TU_, TG_, NT,  N>;
+	using TaskCapacityN		 = ConfigT<TC_, TN_, TU_, TG_, NS,  N, TL_, NP, NA>;
+
+	template <typename T>
+	using LoggerT			 = ConfigT<TC_, TN_, TU_, TG_, NS, NT,   T, NP, NA>;
+
+	template <LongIndex N>
+	using PayloadSizeN		 = ConfigT<TC_, TN_, TU_, TG_, NS, NT, TL_,  N, NA>;
+
+	template <LongIndex N>
+	using CoroutineArenaN	 = ConfigT<TC_, TN_, TU_, TG_, NS, NT, TL_, NP,  N>;
 
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
@@ -194,10 +257,20 @@ struct M_ {
 	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 
 	template <typename THead, typename... TSubStates>
-	using Orthogonal		  = OI_<THead, TSubStates...>;
+	using Orthogonal		  = OI_<Execution::Sequential, THead, TSubStates...>;
 
 	template <				  typename... TSubStates>
-	using OrthogonalPeers	  = OI_<void,  TSubStates...>;
+	using OrthogonalPeers	  = OI_<Execution::Sequential, void,  TSubStates...>;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	// Sub-states update() and react() on the executor attached with R_::attachExecutor(),
+	//  see ExecutorInterface for the rules they have to follow
+	template <typename THead, typename... TSubStates>
+	using ParallelOrthogonal  = OI_<Execution::Parallel,   THead, TSubStates...>;
+
+	template <				  typename... TSubStates>
+	using ParallelOrthogonalPeers = OI_<Execution::Parallel, void, TSubStates...>;
 
 	//----------------------------------------------------------------------
 
@@ -240,6 +313,17 @@ struct M_ {
 	using OrthogonalPeerRoot  = RF_<Config_, OrthogonalPeers <  TSubStates...>>;
 
 	//----------------------------------------------------------------------
+
+	// Hierarchy described at run time with Runtime<>::Layout, see RuntimeLayoutT
+	//  NStates, NCompo, NOrtho - capacity in states, composite and orthogonal regions
+	//  NUnits - orthogonal prong bit bytes, one per 8 prongs of each orthogonal region
+	template <LongIndex NStates,
+			  ShortIndex NCompo,
+			  ShortIndex NOrtho = 0,
+			  ShortIndex NUnits = NOrtho>
+	using Runtime			  = RuntimeF_<Config_, NStates, NCompo, NOrtho, NUnits>;
+
+	//----------------------------------------------------------------------
 };
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -256,6 +340,10 @@ using MachineT = detail::M_<TConfig>;
 }
 
 #include "detail/root.hpp"
+#include "detail/pool.hpp"
+#include "detail/scheduler.hpp"
+#include "detail/replication.hpp"
+#include "detail/runtime.hpp"
 
 #ifdef _MSC_VER
 	#pragma warning(pop)
@@ -271,4 +359,18 @@ using MachineT = detail::M_<TConfig>;
 #undef HFSM_IF_LOGGER
 #undef HFSM_LOGGER_OR
 #undef HFSM_LOG_STATE_METHOD
+#undef HFSM_LOG_RUNTIME_METHOD
 #undef HFSM_IF_STRUCTURE
+#undef HFSM_IF_PROFILER
+#undef HFSM_PROFILE_STATE_METHOD
+#undef HFSM_IF_STATISTICS
+#undef HFSM_RECORD_STATE_ACTIVITY
+#undef HFSM_IF_WATCHDOG
+#undef HFSM_IF_TIMERS
+#undef HFSM_IF_UPDATE_PERIODS
+#undef HFSM_IF_POOL_INDEX
+#undef HFSM_IF_PAYLOADS
+#undef HFSM_IF_STATIC_PLANS
+#undef HFSM_IF_PLAN_QUOTAS
+#undef HFSM_IF_PARALLEL
+#undef HFSM_IF_COROUTINES
@@ -0,0 +1,140 @@
+#include "shared.hpp"
+
+namespace test_coalesce {
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct Context {
+	std::vector<int> positions;
+	std::vector<int> idlePositions;
+	int distance = 0;
+	int clicks = 0;
+};
+
+using M = hfsm2::MachineT<hfsm2::Config::ContextT<Context>>;
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using FSM = M::PeerRoot<
+				S(Tracker),
+				S(Idle)
+			>;
+
+#undef S
+
+//------------------------------------------------------------------------------
+
+struct Position { int x;								};
+struct Move		{ int dx; void operator += (const Move& m) { dx += m.dx; }	};
+struct Click	{										};
+struct Toggle	{										};
+
+struct Tracker : FSM::State {
+	using FSM::State::react;
+
+	void react(const Position& event, FullControl& control)	{ control._().positions.push_back(event.x);	}
+	void react(const Move&	   event, FullControl& control)	{ control._().distance += event.dx;			}
+	void react(const Click&,		  FullControl& control)	{ ++control._().clicks;						}
+	void react(const Toggle&,		  FullControl& control)	{ control.changeTo<Idle>();					}
+};
+
+struct Idle : FSM::State {
+	using FSM::State::react;
+
+	void react(const Position& event, FullControl& control)	{ control._().idlePositions.push_back(event.x);	}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+
+namespace hfsm2 {
+
+template <>
+struct CoalesceT<test_coalesce::Position> {
+	static constexpr Coalesce VALUE = Coalesce::Latest;
+};
+
+template <>
+struct CoalesceT<test_coalesce::Move> {
+	static constexpr Coalesce VALUE = Coalesce::Sum;
+};
+
+}
+
+namespace test_coalesce {
+
+using Buffer = hfsm2::EventBufferT<4, Position, Move, Click, Toggle>;
+
+//------------------------------------------------------------------------------
+
+TEST_CASE("FSM.Coalesce", "[machine]") {
+	Context context;
+	FSM::Instance machine{context};
+
+	Buffer buffer;
+
+	int clicksQueued = 0;
+
+	for (int i = 1; i <= 10; ++i)
+		REQUIRE(buffer.push(Position{i}));
+
+	for (int i = 1; i <= 10; ++i)
+		REQUIRE(buffer.push(Move{i}));
+
+	for (int i = 1; i <= 10; ++i)
+		if (buffer.push(Click{}))
+			++clicksQueued;
+
+	// clicks aren't coalesced, and overflow
+	REQUIRE(clicksQueued == 2);
+	REQUIRE(buffer.count() == 4);
+	REQUIRE(buffer.coalesced() == 18);
+
+	buffer.flush(machine);
+
+	REQUIRE(buffer.count() == 0);
+	REQUIRE(buffer.coalesced() == 0);
+
+	REQUIRE(context.positions == (std::vector<int>{10}));
+	REQUIRE(context.distance == 55);
+	REQUIRE(context.clicks == 2);
+
+	// the queue starts over after a flush
+	REQUIRE(buffer.push(Position{20}));
+	REQUIRE(buffer.push(Position{30}));
+	buffer.flush(machine);
+
+	REQUIRE(context.positions == (std::vector<int>{10, 30}));
+}
+
+//------------------------------------------------------------------------------
+
+TEST_CASE("FSM.Coalesce.Interleaved", "[machine]") {
+	Context context;
+	FSM::Instance machine{context};
+
+	Buffer buffer;
+
+	// events on either side of another type stay apart
+	REQUIRE(buffer.push(Position{1}));
+	REQUIRE(buffer.push(Toggle{}));
+	REQUIRE(buffer.push(Position{2}));
+	REQUIRE(buffer.push(Position{3}));
+
+	REQUIRE(buffer.count() == 3);
+	REQUIRE(buffer.coalesced() == 1);
+
+	buffer.flush(machine);
+	REQUIRE(machine.isActive<Idle>());
+
+	// the state active before the transition only sees what arrived before it
+	REQUIRE(context.positions	  == (std::vector<int>{1}));
+	REQUIRE(context.idlePositions == (std::vector<int>{3}));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,209 @@
+#ifdef __cpp_impl_coroutine
+
+#define HFSM_ENABLE_COROUTINES
+#define HFSM_ENABLE_POOL
+#include "shared.hpp"
+
+namespace test_coroutines {
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct Context {
+	int steps = 0;
+	int pinged = 0;
+	bool spawned = false;
+	size_t arenaUsed = 0;
+};
+
+using M = hfsm2::MachineT<hfsm2::Config::ContextT<Context>
+										 ::CoroutineArenaN<512>>;
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using FSM = M::Root<S(Apex),
+				S(Walk),
+				S(Rest)
+			>;
+
+using Napper = M::PeerRoot<
+				S(Nap),
+				S(Awake)
+			>;
+
+#undef S
+
+//------------------------------------------------------------------------------
+
+struct Ping { int value; };
+struct Pong {};
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct Apex : FSM::State {
+	void enter(PlanControl& control) {
+		control.plan().change<Walk, Rest>();
+	}
+};
+
+//------------------------------------------------------------------------------
+
+struct Walk : FSM::State {
+	void enter(PlanControl& control) {
+		control._().spawned	  = control.spawn(walk(control, control._()));
+		control._().arenaUsed = control.coroutineArena().used();
+	}
+
+	hfsm2::CoTask walk(PlanControl&, Context& context) {
+		++context.steps;
+
+		co_await hfsm2::nextTick();
+		++context.steps;
+
+		const Ping ping = co_await hfsm2::event<Ping>();
+		context.pinged = ping.value;
+
+		co_await hfsm2::timeout(2);
+		++context.steps;
+	}
+};
+
+//------------------------------------------------------------------------------
+
+struct Rest : FSM::State {
+	void enter(PlanControl& control) {
+		control._().arenaUsed = control.coroutineArena().used();
+	}
+};
+
+//------------------------------------------------------------------------------
+
+// Without update() of its own, only the task keeps the machine awake
+struct Nap : Napper::State {
+	void enter(PlanControl& control) {
+		control.spawn(nap(control, control._()));
+	}
+
+	hfsm2::CoTask nap(PlanControl&, Context& context) {
+		co_await hfsm2::timeout(2);
+		++context.steps;
+	}
+};
+
+struct Awake : Napper::State {};
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("FSM.Coroutines", "[machine]") {
+	Context context;
+	FSM::Instance machine{context};
+
+	// runs up to the first co_await from enter()
+	REQUIRE(context.spawned);
+	REQUIRE(context.steps == 1);
+	REQUIRE(context.arenaUsed > 0);
+
+	machine.update();
+	REQUIRE(context.steps == 2);
+
+	// waits for Ping only
+	machine.update();
+	machine.react(Pong{});
+	REQUIRE(context.pinged == 0);
+
+	machine.react(Ping{7});
+	REQUIRE(context.pinged == 7);
+
+	machine.update();
+	REQUIRE(context.steps == 2);
+	REQUIRE(machine.isActive<Walk>());
+
+	// completion succeeds Walk, Apex's plan moves on
+	machine.update();
+	REQUIRE(context.steps == 3);
+	REQUIRE(machine.isActive<Rest>());
+
+	// the frame is released on exit
+	REQUIRE(context.arenaUsed == 0);
+}
+
+//------------------------------------------------------------------------------
+
+TEST_CASE("FSM.Coroutines.Exit", "[machine]") {
+	Context context;
+	FSM::Instance machine{context};
+
+	machine.update();
+	REQUIRE(context.steps == 2);
+
+	// a task waiting for an event is destroyed with its state
+	machine.changeTo<Rest>();
+	machine.update();
+	REQUIRE(machine.isActive<Rest>());
+	REQUIRE(context.arenaUsed == 0);
+
+	machine.react(Ping{3});
+	REQUIRE(context.pinged == 0);
+}
+
+//------------------------------------------------------------------------------
+
+TEST_CASE("FSM.Coroutines.Pool", "[machine]") {
+	Context context;
+	Napper::Instance machine{context};
+
+	hfsm2::PoolT<Napper::Instance, 1> pool;
+	const auto handle = pool.add(machine);
+	REQUIRE(pool.isAwake(handle));
+
+	pool.update();
+	REQUIRE(pool.isAwake(handle));
+	REQUIRE(context.steps == 0);
+
+	// goes dormant once the task completes
+	pool.update();
+	REQUIRE(context.steps == 1);
+	REQUIRE(!pool.isAwake(handle));
+}
+
+//------------------------------------------------------------------------------
+
+TEST_CASE("FSM.Coroutines.Arena", "[machine]") {
+	using Arena = hfsm2::CoroutineArena;
+	constexpr size_t UNIT = Arena::ALIGNMENT;
+
+	alignas(std::max_align_t) unsigned char buffer[UNIT * 16];
+
+	Arena arena;
+	arena.attach(buffer, sizeof(buffer));
+	REQUIRE(arena.capacity() == sizeof(buffer));
+
+	void* const a = arena.allocate(UNIT * 3);
+	void* const b = arena.allocate(UNIT * 3);
+	void* const c = arena.allocate(UNIT * 3);
+	REQUIRE(a);
+	REQUIRE(b);
+	REQUIRE(c);
+	REQUIRE(arena.used() == UNIT * 12);
+
+	// out of space, no fallback to the heap
+	REQUIRE(arena.allocate(UNIT * 4) == nullptr);
+
+	// neighbouring blocks merge back
+	Arena::deallocate(a);
+	Arena::deallocate(b);
+	void* const d = arena.allocate(UNIT * 6);
+	REQUIRE(d == a);
+
+	Arena::deallocate(c);
+	Arena::deallocate(d);
+	REQUIRE(arena.used() == 0);
+	REQUIRE(arena.allocate(UNIT * 15));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
+
+#endif
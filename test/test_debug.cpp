@@ -97,9 +97,12 @@ static_assert(FSM::Instance::ORTHO_UNITS   ==  1, "ORTHO_UNITS");
 using StructureReference = std::vector<hfsm2::StructureEntry>;
 
 void
-assertStructure(const FSM::Instance::Structure& structure,
+assertStructure(const FSM::Instance& machine,
 				const StructureReference& reference)
 {
+	FSM::Instance::Structure structure;
+	machine.structure(structure);
+
 	const auto count = std::max((std::size_t) structure.count(), reference.size());
 
 	for (uint16_t i = 0; i < count; ++i) {
@@ -187,7 +190,7 @@ TEST_CASE("FSM.Debug", "[machine]") {
 
 			assertResumable(machine, all, {});
 
-			assertStructure(machine.structure(), {
+			assertStructure(machine, {
 				hfsm2::StructureEntry{ true,  L"", "Apex"},
 				hfsm2::StructureEntry{ true,  L" ├ ", "I"},
 				hfsm2::StructureEntry{ false, L" └ ", "O"},
@@ -297,7 +300,7 @@ TEST_CASE("FSM.Debug", "[machine]") {
 				FSM::stateId<I   >(),
 			});
 
-			assertStructure(machine.structure(), {
+			assertStructure(machine, {
 				hfsm2::StructureEntry{ true,  L"", "Apex"},
 				hfsm2::StructureEntry{ false, L" ├ ", "I"},
 				hfsm2::StructureEntry{ true,  L" └ ", "O"},
@@ -362,6 +365,49 @@ TEST_CASE("FSM.Debug", "[machine]") {
 	});
 }
 
+//------------------------------------------------------------------------------
+
+TEST_CASE("FSM.Debug.SharedStructure", "[machine]") {
+	Empty context;
+	hfsm2::XoShiRo128Plus generator{0};
+
+	FSM::Instance first {context, generator};
+	FSM::Instance second{context, generator};
+
+	second.changeTo<O>();
+	second.update();
+
+	FSM::Instance::Structure structureFirst;
+	FSM::Instance::Structure structureSecond;
+	first .structure(structureFirst);
+	second.structure(structureSecond);
+	REQUIRE(structureFirst.count() == structureSecond.count());
+
+	for (uint16_t i = 0; i < structureFirst.count(); ++i) {
+		// names and prefixes come from the same per-type report
+		REQUIRE(structureFirst[i].prefix == structureSecond[i].prefix);
+		REQUIRE(structureFirst[i].name	 == structureSecond[i].name);
+	}
+
+	// activity stays per instance
+	REQUIRE( structureFirst [1].isActive);
+	REQUIRE(!structureSecond[1].isActive);
+	REQUIRE( structureSecond[2].isActive);
+
+	REQUIRE(first .activityHistory()[1] == (char) +1);
+	REQUIRE(second.activityHistory()[1] == (char) -1);
+
+	// unchanged states keep counting without transitions
+	second.changeTo<I>();
+	second.update();
+	second.changeTo<O>();
+	second.update();
+
+	REQUIRE(second.activityHistory()[0] == (char) +4);
+	REQUIRE(second.activityHistory()[1] == (char) -1);
+	REQUIRE(second.activityHistory()[2] == (char) +1);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 }
@@ -0,0 +1,199 @@
+#define HFSM_ENABLE_PARALLEL
+#include "shared.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace test_parallel {
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct Context {
+	std::atomic<int> updates{0};
+	std::atomic<int> reactions{0};
+	bool finish = false;
+};
+
+using M = hfsm2::MachineT<hfsm2::Config::ContextT<Context>>;
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+template <template <typename, typename...> class TRegion>
+using FsmT = typename M::template Root<S(Apex),
+				TRegion<S(Work),
+					M::Composite<S(A),
+						S(A_1),
+						S(A_2)
+					>,
+					M::Composite<S(B),
+						S(B_1),
+						S(B_2)
+					>,
+					S(C)
+				>,
+				S(Done)
+			>;
+
+#undef S
+
+using Parallel	 = FsmT<M::ParallelOrthogonal>;
+using Sequential = FsmT<M::Orthogonal>;
+
+//------------------------------------------------------------------------------
+
+struct Event {};
+
+////////////////////////////////////////////////////////////////////////////////
+
+// both machines share the state base
+static_assert(std::is_same<Parallel::State, Sequential::State>::value, "");
+
+using FSM = Parallel;
+
+//------------------------------------------------------------------------------
+
+struct Apex : FSM::State {
+	void enter(PlanControl& control) {
+		control.plan().change<Work, Done>();
+	}
+};
+
+struct Work : FSM::State {};
+struct A	: FSM::State {};
+struct B	: FSM::State {};
+
+struct A_1 : FSM::State {
+	void update(FullControl& control) {
+		++control._().updates;
+		control.changeTo<A_2>();
+	}
+};
+
+struct A_2 : FSM::State {
+	using FSM::State::react;
+
+	void react(const Event&, FullControl& control) {
+		++control._().reactions;
+		control.changeTo<A_1>();
+	}
+};
+
+struct B_1 : FSM::State {
+	void update(FullControl& control) {
+		++control._().updates;
+		control.changeTo<B_2>();
+	}
+};
+
+struct B_2 : FSM::State {
+	using FSM::State::react;
+
+	// conflicts with A_2, prong order decides
+	void react(const Event&, FullControl& control) {
+		++control._().reactions;
+		control.changeTo<A_2>();
+	}
+};
+
+struct C : FSM::State {
+	void update(FullControl& control) {
+		++control._().updates;
+
+		if (control._().finish)
+			control.succeed();
+	}
+};
+
+struct Done : FSM::State {};
+
+//------------------------------------------------------------------------------
+
+// runs the jobs backwards, results still merge in prong order
+struct ReverseExecutor
+	: hfsm2::ExecutorInterface
+{
+	void execute(const Job job, void* const argument, const hfsm2::LongIndex count) override {
+		for (hfsm2::LongIndex i = count; i > 0; --i)
+			job(argument, i - 1);
+
+		++calls;
+	}
+
+	int calls = 0;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+struct ThreadExecutor
+	: hfsm2::ExecutorInterface
+{
+	void execute(const Job job, void* const argument, const hfsm2::LongIndex count) override {
+		std::vector<std::thread> threads;
+
+		for (hfsm2::LongIndex i = 1; i < count; ++i)
+			threads.emplace_back(job, argument, i);
+
+		job(argument, 0);
+
+		for (auto& thread : threads)
+			thread.join();
+	}
+};
+
+//------------------------------------------------------------------------------
+
+template <typename TMachine>
+void
+run(hfsm2::ExecutorInterface* const executor) {
+	Context context;
+	typename TMachine::Instance machine{context};
+	machine.attachExecutor(executor);
+
+	REQUIRE(machine.template isActive<A_1>());
+	REQUIRE(machine.template isActive<B_1>());
+	REQUIRE(machine.template isActive<C>());
+
+	machine.update();
+	REQUIRE(context.updates == 3);
+
+	REQUIRE(machine.template isActive<A_2>());
+	REQUIRE(machine.template isActive<B_2>());
+
+	// B_2's request is merged after A_2's
+	machine.react(Event{});
+	REQUIRE(context.reactions == 2);
+
+	REQUIRE(machine.template isActive<A_2>());
+	REQUIRE(machine.template isActive<B_2>());
+
+	// C's success reaches Apex's plan
+	context.finish = true;
+	machine.update();
+	REQUIRE(context.updates == 4);
+
+	REQUIRE(machine.template isActive<Done>());
+	REQUIRE(!machine.template isActive<Work>());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("FSM.Parallel", "[machine]") {
+	run<Sequential>(nullptr);
+
+	// no executor attached, prongs run in sequence
+	run<Parallel>(nullptr);
+
+	ReverseExecutor reverse;
+	run<Parallel>(&reverse);
+	REQUIRE(reverse.calls == 3);
+
+	ThreadExecutor threads;
+	run<Parallel>(&threads);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,122 @@
+#define HFSM_ENABLE_PAYLOADS
+#include "shared.hpp"
+
+namespace test_payloads {
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct Target {
+	float x, y;
+};
+
+struct Context {
+	float entered = 0.0f;
+	bool guarded  = false;
+	bool empty	  = false;
+};
+
+using Config = hfsm2::Config::ContextT<Context>::PayloadSizeN<sizeof(Target)>;
+using M = hfsm2::MachineT<Config>;
+
+static_assert(Config::PAYLOAD_SIZE == 8, "");
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using FSM = M::PeerRoot<
+				S(Idle),
+				S(Move),
+				S(Rest)
+			>;
+
+#undef S
+
+//------------------------------------------------------------------------------
+
+struct Go { Target target; };
+
+struct Idle : FSM::State {
+	using FSM::State::react;
+
+	void react(const Go& event, FullControl& control)	{ control.changeTo<Move>(event.target);	}
+};
+
+struct Move : FSM::State {
+	// negative targets are rejected
+	void entryGuard(GuardControl& control) {
+		const Target* const target = control.payload<Target>();
+
+		if (target && target->x < 0.0f) {
+			control._().guarded = true;
+			control.cancelPendingTransitions();
+		}
+	}
+
+	void enter(PlanControl& control) {
+		const Target* const target = control.payload<Target>();
+
+		control._().empty = !target;
+		if (target)
+			control._().entered = target->x + target->y;
+
+		REQUIRE(!control.payload<int>());
+	}
+};
+
+struct Rest : FSM::State {};
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("FSM.Payloads", "[machine]") {
+	Context context;
+	FSM::Instance machine{context};
+
+	machine.react(Go{{1.0f, 2.0f}});
+	REQUIRE(machine.isActive<Move>());
+	REQUIRE(context.entered == 3.0f);
+	REQUIRE(!context.empty);
+
+	// the guard sees the payload, and the payload goes away with the transition
+	machine.changeTo<Idle>();
+	machine.update();
+
+	machine.react(Go{{-1.0f, 0.0f}});
+	REQUIRE(context.guarded);
+	REQUIRE(machine.isActive<Idle>());
+
+	machine.changeTo<Move>();
+	machine.update();
+	REQUIRE(machine.isActive<Move>());
+	REQUIRE(context.empty);
+
+	// external requests
+	machine.changeTo<Idle>();
+	machine.update();
+
+	machine.changeTo<Move>(Target{4.0f, 5.0f});
+	machine.update();
+	REQUIRE(machine.isActive<Move>());
+	REQUIRE(context.entered == 9.0f);
+}
+
+//------------------------------------------------------------------------------
+
+TEST_CASE("FSM.Payloads.Full", "[machine]") {
+	Context context;
+	FSM::Instance machine{context};
+
+	// a single region has 2 payload slots
+	machine.changeTo<Move>(Target{1.0f, 1.0f});
+	machine.changeTo<Idle>(Target{2.0f, 2.0f});
+
+	// the transition is dropped along with its payload
+	machine.changeTo<Rest>(Target{3.0f, 3.0f});
+	machine.update();
+	REQUIRE(!machine.isActive<Rest>());
+	REQUIRE(machine.isActive<Idle>());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,137 @@
+#define HFSM_ENABLE_PLAN_QUOTAS
+#include "shared.hpp"
+
+namespace test_plan_quotas {
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct Context {
+	std::vector<bool> appended;
+};
+
+using M = hfsm2::MachineT<hfsm2::Config::ContextT<Context>
+										 ::TaskCapacityN<3>>;
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using FSM = M::PeerRoot<
+				S(Idle),
+				M::Orthogonal<S(Work),
+					M::Composite<S(Left),
+						S(L1),
+						S(L2),
+						S(L3)
+					>,
+					M::Composite<S(Right),
+						S(R1),
+						S(R2),
+						S(R3)
+					>
+				>
+			>;
+
+#undef S
+
+//------------------------------------------------------------------------------
+
+struct Idle : FSM::State {};
+struct Work : FSM::State {};
+
+struct Left : FSM::State {
+	void enter(PlanControl& control) {
+		auto plan = control.plan();
+
+		control._().appended.push_back(plan.change<L1, L2>());
+		control._().appended.push_back(plan.change<L2, L3>());
+	}
+};
+
+struct Right : FSM::State {
+	void enter(PlanControl& control) {
+		auto plan = control.plan();
+
+		control._().appended.push_back(plan.change<R1, R2>());
+		control._().appended.push_back(plan.change<R2, R3>());
+	}
+};
+
+struct L1 : FSM::State {};
+struct L2 : FSM::State {};
+struct L3 : FSM::State {};
+struct R1 : FSM::State {};
+struct R2 : FSM::State {};
+struct R3 : FSM::State {};
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("FSM.Plan Quotas", "[machine]") {
+	Context context;
+	FSM::Instance machine{context};
+
+	machine.setPlanQuota<Left>(1);
+	REQUIRE(machine.planUsage<Left >().quota == 1);
+	REQUIRE(machine.planUsage<Right>().quota == hfsm2::INVALID_LONG_INDEX);
+
+	machine.changeTo<Work>();
+	machine.update();
+	REQUIRE(machine.isActive<Work>());
+
+	REQUIRE(context.appended == (std::vector<bool>{true, false, true, true}));
+
+	REQUIRE(machine.planUsage<Left >().count	 == 1);
+	REQUIRE(machine.planUsage<Left >().overflows == 1);
+	REQUIRE(machine.planUsage<Right>().count	 == 2);
+	REQUIRE(machine.planUsage<Right>().overflows == 0);
+	REQUIRE(machine.planHighWater() == 3);
+
+	// exiting clears the plans, high-water marks stay
+	machine.changeTo<Idle>();
+	machine.update();
+
+	REQUIRE(machine.planUsage<Left >().count	 == 0);
+	REQUIRE(machine.planUsage<Left >().highWater == 1);
+	REQUIRE(machine.planUsage<Right>().count	 == 0);
+	REQUIRE(machine.planUsage<Right>().highWater == 2);
+	REQUIRE(machine.planHighWater() == 3);
+
+	machine.resetPlanHighWater();
+	REQUIRE(machine.planUsage<Right>().highWater == 0);
+	REQUIRE(machine.planHighWater() == 0);
+}
+
+//------------------------------------------------------------------------------
+
+TEST_CASE("FSM.Plan Quotas.Reserved", "[machine]") {
+	Context context;
+	FSM::Instance machine{context};
+
+	// Left enters first, but can only use what Right's quota leaves over
+	machine.setPlanQuota<Right>(2);
+
+	machine.changeTo<Work>();
+	machine.update();
+
+	REQUIRE(context.appended == (std::vector<bool>{true, false, true, true}));
+
+	REQUIRE(machine.planUsage<Left >().count	 == 1);
+	REQUIRE(machine.planUsage<Left >().overflows == 1);
+	REQUIRE(machine.planUsage<Right>().count	 == 2);
+	REQUIRE(machine.planUsage<Right>().overflows == 0);
+
+	// lifting the quota releases the reservation
+	machine.changeTo<Idle>();
+	machine.update();
+	machine.setPlanQuota<Right>(hfsm2::INVALID_LONG_INDEX);
+
+	context.appended.clear();
+	machine.changeTo<Work>();
+	machine.update();
+
+	REQUIRE(context.appended == (std::vector<bool>{true, true, true, false}));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
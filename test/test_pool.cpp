@@ -0,0 +1,190 @@
+#define HFSM_ENABLE_POOL
+#include "shared.hpp"
+
+namespace test_pool {
+
+////////////////////////////////////////////////////////////////////////////////
+
+using M = hfsm2::Machine;
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using FSM = M::PeerRoot<
+				S(Idle),
+				S(Busy)
+			>;
+
+using Planned = M::Root<S(Planner),
+					S(Step),
+					S(Done)
+				>;
+
+using Injected = M::PeerRoot<
+					S(Ticked),
+					S(Still)
+				>;
+
+#undef S
+
+static_assert(FSM::stateId<Idle>() == 1, "");
+static_assert(FSM::stateId<Busy>() == 2, "");
+
+//------------------------------------------------------------------------------
+
+struct Poke {};
+
+struct Idle : FSM::State {
+	using FSM::State::react;
+
+	void react(const Poke&, FullControl& control)		{ control.changeTo<Busy>();				}
+};
+
+struct Busy : FSM::State {
+	void enter(PlanControl&)							{ updates = 0;							}
+
+	void update(FullControl& control) {
+		if (++updates == 2)
+			control.changeTo<Idle>();
+	}
+
+	unsigned updates = 0;
+};
+
+//------------------------------------------------------------------------------
+
+struct Planner : Planned::State {
+	void enter(PlanControl& control)					{ control.plan().change<Step, Done>();	}
+};
+
+struct Step : Planned::State {
+	void update(FullControl& control)					{ control.succeed();					}
+};
+
+struct Done : Planned::State {};
+
+//------------------------------------------------------------------------------
+
+struct Tagged
+	: Injected::Injection
+{};
+
+struct Counted
+	: Injected::Injection
+{
+	void preUpdate(Context&)							{ ++ticks;								}
+
+	unsigned ticks = 0;
+};
+
+// per-tick work only in the second injection
+struct Ticked : Injected::StateT<Tagged, Counted> {};
+
+struct Still : Injected::StateT<Tagged> {};
+
+////////////////////////////////////////////////////////////////////////////////
+
+using FullControl = FSM::State::FullControl;
+
+static_assert(!hfsm2::detail::HasUpdateT<FullControl, Idle>::VALUE, "");
+static_assert( hfsm2::detail::HasUpdateT<FullControl, Busy>::VALUE, "");
+
+static_assert( hfsm2::detail::HasUpdateT<Injected::State::FullControl, Ticked>::VALUE, "");
+static_assert(!hfsm2::detail::HasUpdateT<Injected::State::FullControl, Still >::VALUE, "");
+
+using Pool = hfsm2::PoolT<FSM::Instance, 4>;
+
+//------------------------------------------------------------------------------
+
+TEST_CASE("FSM.Pool", "[machine]") {
+	FSM::Instance machines[3];
+
+	for (FSM::Instance& machine : machines)
+		REQUIRE(!machine.needsUpdate());
+
+	Pool pool;
+
+	Pool::Handle handles[3];
+	for (unsigned i = 0; i < 3; ++i)
+		handles[i] = pool.add(machines[i]);
+
+	REQUIRE(pool.count() == 3);
+	REQUIRE(pool.awakeCount() == 0);
+
+	// events wake machines up
+	pool.react(handles[1], Poke{});
+	REQUIRE(machines[1].isActive<Busy>());
+	REQUIRE(pool.isAwake(handles[1]));
+	REQUIRE(pool.awakeCount() == 1);
+
+	pool.update();
+	REQUIRE(pool.awakeCount() == 1);
+
+	// .. and go back to sleep when done
+	pool.update();
+	REQUIRE(machines[1].isActive<Idle>());
+	REQUIRE(pool.awakeCount() == 0);
+
+	// external requests need a refresh
+	machines[2].changeTo<Busy>();
+	REQUIRE(machines[2].needsUpdate());
+	pool.refresh(handles[2]);
+	REQUIRE(pool.isAwake(handles[2]));
+
+	pool.react(Poke{});
+	REQUIRE(pool.awakeCount() == 3);
+
+	pool.remove(handles[0]);
+	REQUIRE(pool.count() == 2);
+	REQUIRE(pool.awakeCount() == 2);
+
+	for (unsigned i = 0; i < 3; ++i)
+		pool.update();
+	REQUIRE(pool.awakeCount() == 0);
+
+	REQUIRE(pool.add(machines[0]) == handles[0]);
+}
+
+//------------------------------------------------------------------------------
+
+TEST_CASE("FSM.Pool.Completed Plan", "[machine]") {
+	Planned::Instance machine;
+	REQUIRE(machine.needsUpdate());
+
+	hfsm2::PoolT<Planned::Instance, 1> pool;
+	const auto handle = pool.add(machine);
+
+	// the plan moves to Done, which has nothing left to update
+	pool.update();
+	REQUIRE(machine.isActive<Done>());
+	REQUIRE(!machine.needsUpdate());
+	REQUIRE(!pool.isAwake(handle));
+}
+
+//------------------------------------------------------------------------------
+
+TEST_CASE("FSM.Pool.Injected PreUpdate", "[machine]") {
+	Injected::Instance machine;
+	REQUIRE(machine.needsUpdate());
+
+	hfsm2::PoolT<Injected::Instance, 1> pool;
+	const auto handle = pool.add(machine);
+
+	// preUpdate() keeps the machine ticking
+	pool.update();
+	pool.update();
+	REQUIRE(pool.isAwake(handle));
+	REQUIRE(machine.access<Ticked>().ticks == 2);
+
+	machine.changeTo<Still>();
+	pool.refresh(handle);
+
+	pool.update();
+	REQUIRE(!machine.needsUpdate());
+	REQUIRE(!pool.isAwake(handle));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,125 @@
+#define HFSM_ENABLE_POOL
+#include "shared.hpp"
+
+namespace test_pool_budget {
+
+////////////////////////////////////////////////////////////////////////////////
+
+using M = hfsm2::Machine;
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using FSM = M::PeerRoot<
+				S(Idle),
+				S(Busy)
+			>;
+
+#undef S
+
+//------------------------------------------------------------------------------
+
+struct Poke {};
+
+struct Idle : FSM::State {
+	using FSM::State::react;
+
+	void react(const Poke&, FullControl& control)		{ control.changeTo<Busy>();				}
+};
+
+struct Busy : FSM::State {
+	void update(FullControl&)							{ ++updates;							}
+
+	unsigned updates = 0;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+// every reading advances the clock by one tick
+struct StepClock {
+	static uint64_t now()								{ return ++ticks;						}
+
+	static uint64_t ticks;
+};
+
+uint64_t StepClock::ticks = 0;
+
+// favors machines with higher handles
+struct HandleOrder {
+	float operator() (const uint32_t handle,
+					  const FSM::Instance&,
+					  const uint32_t) const						{ return (float) handle;				}
+};
+
+using Pool = hfsm2::PoolT<FSM::Instance, 8, StepClock>;
+
+//------------------------------------------------------------------------------
+
+TEST_CASE("FSM.Pool Budget", "[machine]") {
+	FSM::Instance machines[5];
+
+	Pool pool;
+
+	Pool::Handle handles[5];
+	for (unsigned i = 0; i < 5; ++i) {
+		handles[i] = pool.add(machines[i]);
+		pool.react(handles[i], Poke{});
+	}
+	REQUIRE(pool.awakeCount() == 5);
+
+	const auto updates = [&](const unsigned i) {
+		return machines[i].access<Busy>().updates;
+	};
+
+	// round-robin, 2 machines per call
+	REQUIRE(pool.updateFor(2, hfsm2::RoundRobinOrder{}, 1) == 2);
+	REQUIRE(updates(0) == 1);
+	REQUIRE(updates(1) == 1);
+	REQUIRE(updates(2) == 0);
+
+	REQUIRE(pool.staleness(handles[0]) == 0);
+	REQUIRE(pool.staleness(handles[2]) == 1);
+
+	REQUIRE(pool.updateFor(2, hfsm2::RoundRobinOrder{}, 1) == 2);
+	REQUIRE(updates(2) == 1);
+	REQUIRE(updates(3) == 1);
+	REQUIRE(updates(4) == 0);
+
+	REQUIRE(pool.staleness(handles[0]) == 1);
+	REQUIRE(pool.staleness(handles[4]) == 2);
+
+	REQUIRE(pool.updateFor(2, hfsm2::RoundRobinOrder{}, 1) == 2);
+	REQUIRE(updates(4) == 1);
+	REQUIRE(updates(0) == 2);
+
+	// the clock is only sampled every 'checkInterval' machines
+	REQUIRE(pool.updateFor(1, hfsm2::RoundRobinOrder{}, 3) == 3);
+	REQUIRE(updates(1) == 2);
+	REQUIRE(updates(2) == 2);
+	REQUIRE(updates(3) == 2);
+
+	// starvation-first picks up whoever waited longest
+	REQUIRE(pool.staleness(handles[4]) == 1);
+	REQUIRE(pool.staleness(handles[0]) == 1);
+	REQUIRE(pool.staleness(handles[1]) == 0);
+
+	REQUIRE(pool.updateFor(2, hfsm2::StarvationOrder{}, 1) == 2);
+	REQUIRE(updates(4) == 2);
+	REQUIRE(updates(0) == 3);
+
+	// custom priority
+	REQUIRE(pool.updateFor(1, HandleOrder{}, 1) == 1);
+	REQUIRE(updates(4) == 3);
+
+	// a generous budget covers everyone
+	REQUIRE(pool.updateFor(1000) == 5);
+	REQUIRE(pool.current() == (Pool::Handle) Pool::INVALID_HANDLE);
+
+	for (unsigned i = 0; i < 5; ++i)
+		REQUIRE(pool.staleness(handles[i]) == 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,132 @@
+#define HFSM_ENABLE_POOL
+#define HFSM_ENABLE_POOL_INDEX
+#include "shared.hpp"
+
+namespace test_pool_index {
+
+////////////////////////////////////////////////////////////////////////////////
+
+using M = hfsm2::Machine;
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using FSM = M::PeerRoot<
+				S(Idle),
+				M::Composite<S(Combat),
+					S(Melee),
+					S(Ranged)
+				>
+			>;
+
+#undef S
+
+static_assert(FSM::stateId<Idle>()	 == 1, "");
+static_assert(FSM::stateId<Combat>() == 2, "");
+static_assert(FSM::stateId<Melee>()	 == 3, "");
+static_assert(FSM::stateId<Ranged>() == 4, "");
+
+//------------------------------------------------------------------------------
+
+struct Engage	{};
+struct Retreat	{};
+
+struct Idle : FSM::State {
+	using FSM::State::react;
+
+	void react(const Engage&, FullControl& control)		{ control.changeTo<Combat>();			}
+};
+
+struct Combat : FSM::State {
+	using FSM::State::react;
+
+	void react(const Retreat&, FullControl& control)	{ control.changeTo<Idle>();				}
+};
+
+struct Melee : FSM::State {
+	// close the distance, then switch to ranged
+	void update(FullControl& control)					{ control.changeTo<Ranged>();			}
+};
+
+struct Ranged : FSM::State {};
+
+////////////////////////////////////////////////////////////////////////////////
+
+using Pool = hfsm2::PoolT<FSM::Instance, 4>;
+
+template <typename TState>
+std::vector<Pool::Handle>
+members(const Pool& pool) {
+	std::vector<Pool::Handle> handles;
+
+	for (const Pool::Handle handle : pool.inState<TState>())
+		handles.push_back(handle);
+
+	std::sort(handles.begin(), handles.end());
+
+	return handles;
+}
+
+using Handles = std::vector<Pool::Handle>;
+
+//------------------------------------------------------------------------------
+
+TEST_CASE("FSM.Pool Index", "[machine]") {
+	FSM::Instance machines[4];
+
+	Pool pool;
+
+	Pool::Handle handles[4];
+	for (unsigned i = 0; i < 4; ++i)
+		handles[i] = pool.add(machines[i]);
+
+	REQUIRE(pool.inState<Idle>().count() == 4);
+	REQUIRE(pool.inState<Combat>().count() == 0);
+
+	pool.react(handles[1], Engage{});
+	pool.react(handles[3], Engage{});
+
+	REQUIRE(members<Idle  >(pool) == (Handles{0, 2}));
+	REQUIRE(members<Combat>(pool) == (Handles{1, 3}));
+	REQUIRE(members<Melee >(pool) == (Handles{1, 3}));
+	REQUIRE(members<Ranged>(pool) == (Handles{}));
+
+	// transitions made during update() are picked up
+	pool.update();
+
+	REQUIRE(members<Combat>(pool) == (Handles{1, 3}));
+	REQUIRE(members<Melee >(pool) == (Handles{}));
+	REQUIRE(members<Ranged>(pool) == (Handles{1, 3}));
+
+	// external changes after a refresh()
+	machines[0].changeTo<Combat>();
+	machines[0].update();
+	pool.refresh(handles[0]);
+
+	REQUIRE(members<Idle  >(pool) == (Handles{2}));
+	REQUIRE(members<Combat>(pool) == (Handles{0, 1, 3}));
+	REQUIRE(members<Melee >(pool) == (Handles{0}));
+
+	pool.react(Retreat{});
+
+	REQUIRE(members<Idle  >(pool) == (Handles{0, 1, 2, 3}));
+	REQUIRE(members<Combat>(pool) == (Handles{}));
+	REQUIRE(members<Ranged>(pool) == (Handles{}));
+
+	// removed machines leave every list
+	pool.react(handles[2], Engage{});
+	pool.remove(handles[2]);
+
+	REQUIRE(members<Idle  >(pool) == (Handles{0, 1, 3}));
+	REQUIRE(members<Combat>(pool) == (Handles{}));
+	REQUIRE(pool.inState(0).count() == 3);
+
+	REQUIRE(pool.add(machines[2]) == handles[2]);
+	REQUIRE(members<Combat>(pool) == (Handles{2}));
+	REQUIRE(members<Melee >(pool) == (Handles{2}));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,110 @@
+#define HFSM_ENABLE_PROFILER
+#include "shared.hpp"
+
+#include <fstream>
+#include <sstream>
+
+namespace test_profiler {
+
+////////////////////////////////////////////////////////////////////////////////
+
+using M = hfsm2::Machine;
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using FSM = M::PeerRoot<
+				S(A),
+				S(B)
+			>;
+
+#undef S
+
+static_assert(FSM::stateId<A>() == 1, "");
+static_assert(FSM::stateId<B>() == 2, "");
+
+//------------------------------------------------------------------------------
+
+struct A : FSM::State {
+	void update(FullControl& control) {
+		if (++updates == 3)
+			control.changeTo<B>();
+	}
+
+	unsigned updates = 0;
+};
+
+struct B : FSM::State {};
+
+//------------------------------------------------------------------------------
+
+std::string
+readFile(const char* const path) {
+	std::ifstream file{path};
+	std::stringstream content;
+	content << file.rdbuf();
+
+	return content.str();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("FSM.Profiler", "[machine]") {
+	FSM::Instance::Profiler profiler;
+
+	hfsm2::ProfileEvent events[16];
+	profiler.attachEvents(events, 16);
+
+	FSM::Instance machine;
+	machine.attachProfiler(&profiler);
+
+	for (unsigned i = 0; i < 4; ++i)
+		machine.update();
+
+	REQUIRE(machine.isActive<B>());
+
+	const hfsm2::ProfileEntry& aUpdate = profiler.entry(FSM::stateId<A>(), hfsm2::Method::UPDATE);
+	REQUIRE(aUpdate.count == 3);
+	REQUIRE(aUpdate.min <= aUpdate.mean());
+	REQUIRE(aUpdate.mean() <= aUpdate.max);
+
+	uint64_t bucketed = 0;
+	for (unsigned b = 0; b < hfsm2::ProfileEntry::BUCKET_COUNT; ++b)
+		bucketed += aUpdate.histogram[b];
+	REQUIRE(bucketed == aUpdate.count);
+
+	REQUIRE(profiler.entry(FSM::stateId<A>(), hfsm2::Method::EXIT	 ).count == 1);
+	REQUIRE(profiler.entry(FSM::stateId<B>(), hfsm2::Method::ENTER	 ).count == 1);
+	REQUIRE(profiler.entry(FSM::stateId<B>(), hfsm2::Method::UPDATE ).count == 1);
+
+	// headless root isn't timed
+	REQUIRE(profiler.entry(0,				  hfsm2::Method::UPDATE ).count == 0);
+
+	// A::update x3, A::exitGuard, B::entryGuard, A::exit, A::destruct, B::construct, B::enter, B::update
+	REQUIRE(profiler.eventCount() == 10);
+
+	// export
+
+	const char* const names[] = { "Root", "A", "B" };
+
+	REQUIRE(profiler.writeReport("hfsm2_profile.txt", names));
+	const std::string report = readFile("hfsm2_profile.txt");
+	REQUIRE(report.find("update") != std::string::npos);
+	REQUIRE(report.find("Root")	  == std::string::npos);
+	std::remove("hfsm2_profile.txt");
+
+	REQUIRE(profiler.writeChromeTrace("hfsm2_profile.json", names));
+	const std::string trace = readFile("hfsm2_profile.json");
+	REQUIRE(trace.find("{\"traceEvents\":[") == 0);
+	REQUIRE(trace.find("\"A::update\"") != std::string::npos);
+	std::remove("hfsm2_profile.json");
+
+	profiler.clear();
+	REQUIRE(profiler.entry(FSM::stateId<A>(), hfsm2::Method::UPDATE).count == 0);
+	REQUIRE(profiler.eventCount() == 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
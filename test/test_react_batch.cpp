@@ -0,0 +1,88 @@
+#include "shared.hpp"
+
+namespace test_react_batch {
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct Context {
+	std::vector<int> received;
+};
+
+using M = hfsm2::MachineT<hfsm2::Config::ContextT<Context>>;
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using FSM = M::PeerRoot<
+				S(A),
+				S(B)
+			>;
+
+#undef S
+
+//------------------------------------------------------------------------------
+
+struct Number	{ int value;	};
+struct Toggle	{				};
+
+struct A : FSM::State {
+	using FSM::State::react;
+
+	void react(const Number& event, FullControl& control)	{ control._().received.push_back( event.value);	}
+	void react(const Toggle&,		FullControl& control)	{ control.changeTo<B>();							}
+};
+
+struct B : FSM::State {
+	using FSM::State::react;
+
+	void react(const Number& event, FullControl& control)	{ control._().received.push_back(-event.value);	}
+	void react(const Toggle&,		FullControl& control)	{ control.changeTo<A>();							}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("FSM.React Batch", "[machine]") {
+	Context context;
+	FSM::Instance machine{context};
+
+	// homogeneous span
+	const Number numbers[] = { {1}, {2}, {3} };
+	machine.reactBatch(numbers, 3);
+
+	REQUIRE(context.received == (std::vector<int>{1, 2, 3}));
+
+	// a transition mid-batch applies to the events after it
+	context.received.clear();
+
+	hfsm2::EventBufferT<8, Number, Toggle> buffer;
+	REQUIRE(buffer.push(Number{1}));
+	REQUIRE(buffer.push(Toggle{}));
+	REQUIRE(buffer.push(Number{2}));
+	REQUIRE(buffer.push(Number{3}));
+	REQUIRE(buffer.push(Toggle{}));
+	REQUIRE(buffer.push(Number{4}));
+	REQUIRE(buffer.count() == 6);
+
+	machine.reactBatch(buffer);
+
+	REQUIRE(context.received == (std::vector<int>{1, -2, -3, 4}));
+	REQUIRE(machine.isActive<A>());
+
+	// capacity
+	REQUIRE(buffer.push(Toggle{}));
+	REQUIRE(buffer.push(Toggle{}));
+	REQUIRE(!buffer.push(Toggle{}));
+
+	buffer.clear();
+	REQUIRE(buffer.count() == 0);
+
+	// empty batches are no-ops
+	machine.reactBatch(buffer);
+	machine.reactBatch(numbers, 0);
+	REQUIRE(machine.isActive<A>());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
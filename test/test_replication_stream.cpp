@@ -0,0 +1,181 @@
+#define HFSM_ENABLE_TRANSITION_HISTORY
+#define HFSM_ENABLE_SERIALIZATION
+#include "shared.hpp"
+
+namespace test_replication_stream {
+
+//------------------------------------------------------------------------------
+
+using M = hfsm2::Machine;
+
+#define S(s) struct s
+
+using FSM = M::PeerRoot<
+				S(A),
+				S(B),
+				M::Composite<S(C),
+					S(C_1),
+					S(C_2)
+				>
+			>;
+
+#undef S
+
+//------------------------------------------------------------------------------
+
+static_assert(FSM::stateId<A  >() ==  1, "");
+static_assert(FSM::stateId<B  >() ==  2, "");
+static_assert(FSM::stateId<C  >() ==  3, "");
+static_assert(FSM::stateId<C_1>() ==  4, "");
+static_assert(FSM::stateId<C_2>() ==  5, "");
+
+//------------------------------------------------------------------------------
+
+struct Go {};
+
+struct A : FSM::State {
+	using FSM::State::react;
+
+	void react(const Go&, FullControl& control)			{ control.changeTo<B>();				}
+};
+
+struct B : FSM::State {
+	using FSM::State::react;
+
+	void react(const Go&, FullControl& control)			{ control.changeTo<C>();				}
+};
+
+struct C	: FSM::State {};
+struct C_1	: FSM::State {};
+struct C_2	: FSM::State {};
+
+//------------------------------------------------------------------------------
+
+constexpr uint32_t ENTITIES = 8;
+
+using Writer = hfsm2::ReplicationWriterT<64>;
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("FSM.ReplicationStream", "[machine]") {
+	FSM::Instance servers[ENTITIES];
+	FSM::Instance clients[ENTITIES];
+
+	auto resolve = [&](const uint32_t entityId) -> FSM::Instance* {
+		return entityId < ENTITIES ? &clients[entityId] : nullptr;
+	};
+
+	Writer writer;
+	std::vector<uint8_t> transport;
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	servers[1].changeTo<B>();
+	servers[5].changeTo<C_2>();
+
+	for (uint32_t i = 0; i < ENTITIES; ++i) {
+		servers[i].update();
+		REQUIRE(writer.write(i, servers[i]));
+	}
+
+	// only the machines that transitioned are sent, a byte per varint
+	REQUIRE(writer.frameCount() == 2);
+	REQUIRE(writer.size() == 6);
+
+	// bits of a full-state snapshot, per machine
+	REQUIRE(writer.size() * 8 < FSM::Instance::SerialBuffer::BIT_CAPACITY * ENTITIES);
+
+	transport.assign(writer.data(), writer.data() + writer.size());
+	writer.clear();
+	{
+		hfsm2::ReplicationReader reader{transport.data(), transport.size()};
+
+		REQUIRE(reader.apply<FSM::Instance>(resolve) == 2);
+		REQUIRE(reader.done());
+		REQUIRE(!reader.failed());
+	}
+
+	for (uint32_t i = 0; i < ENTITIES; ++i)
+		REQUIRE(clients[i].isActive<B>()   == servers[i].isActive<B>());
+
+	REQUIRE(clients[1].isActive<B>());
+	REQUIRE(clients[5].isActive<C_2>());
+	REQUIRE(clients[0].isActive<A>());
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	// history of the previous tick isn't sent again
+	servers[5].restart<C>();
+
+	for (uint32_t i = 0; i < ENTITIES; ++i) {
+		servers[i].update();
+		REQUIRE(writer.write(i, servers[i]));
+	}
+
+	REQUIRE(writer.frameCount() == 1);
+
+	// frames for unknown entities are skipped
+	REQUIRE(writer.write(ENTITIES, servers[5]));
+	REQUIRE(writer.frameCount() == 2);
+
+	transport.assign(writer.data(), writer.data() + writer.size());
+	writer.clear();
+	{
+		hfsm2::ReplicationReader reader{transport.data(), transport.size()};
+
+		REQUIRE(reader.apply<FSM::Instance>(resolve) == 1);
+		REQUIRE(reader.done());
+	}
+
+	REQUIRE(clients[5].isActive<C_1>());
+	REQUIRE(clients[1].isActive<B>());
+
+	// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+	// malformed stream, a state id out of range
+	const uint8_t garbage[] = { 0x01, 0x01, 0x7F };
+	{
+		hfsm2::ReplicationReader reader{garbage, sizeof(garbage)};
+
+		REQUIRE(reader.apply<FSM::Instance>(resolve) == 0);
+		REQUIRE(reader.failed());
+	}
+
+	// truncated stream
+	{
+		hfsm2::ReplicationReader reader{garbage, 1};
+
+		REQUIRE(reader.apply<FSM::Instance>(resolve) == 0);
+		REQUIRE(reader.failed());
+	}
+
+	REQUIRE(clients[1].isActive<B>());
+}
+
+//------------------------------------------------------------------------------
+
+TEST_CASE("FSM.ReplicationStream.Batch", "[machine]") {
+	FSM::Instance server;
+	FSM::Instance client;
+
+	// transitions of every event in the batch are kept
+	const Go events[] = { Go{}, Go{} };
+	server.reactBatch(events, 2);
+	REQUIRE(server.isActive<C_1>());
+	REQUIRE(server.transitionHistory().count() == 2);
+
+	Writer writer;
+	REQUIRE(writer.write(0, server));
+
+	hfsm2::ReplicationReader reader{writer.data(), writer.size()};
+	REQUIRE(reader.apply<FSM::Instance>([&](const uint32_t) { return &client; }) == 1);
+	REQUIRE(client.isActive<C_1>());
+
+	// .. and dropped by the next call
+	server.react(Go{});
+	REQUIRE(server.transitionHistory().count() == 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
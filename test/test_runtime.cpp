@@ -0,0 +1,314 @@
+#define HFSM_ENABLE_VERBOSE_DEBUG_LOG
+#include "shared.hpp"
+
+namespace test_runtime {
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct Context {
+	bool locked = false;
+};
+
+using M = hfsm2::MachineT<hfsm2::Config::ContextT<Context>>;
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using FSM = M::Root<S(Apex),
+				M::Composite<S(Planned),
+					S(Step_1),
+					S(Step_2)
+				>,
+				M::Resumable<S(Resumable),
+					S(R_1),
+					S(R_2)
+				>,
+				M::Orthogonal<S(Ortho),
+					M::Composite<S(O_L),
+						S(O_L_1),
+						S(O_L_2)
+					>,
+					S(O_R)
+				>,
+				M::Utilitarian<S(Util),
+					S(U_1),
+					S(U_2)
+				>
+			>;
+
+#undef S
+
+//------------------------------------------------------------------------------
+
+static_assert(FSM::stateId<Apex		>() ==  0, "");
+static_assert(FSM::stateId<Planned	>() ==  1, "");
+static_assert(FSM::stateId<Step_1	>() ==  2, "");
+static_assert(FSM::stateId<Step_2	>() ==  3, "");
+static_assert(FSM::stateId<Resumable>() ==  4, "");
+static_assert(FSM::stateId<R_1		>() ==  5, "");
+static_assert(FSM::stateId<R_2		>() ==  6, "");
+static_assert(FSM::stateId<Ortho	>() ==  7, "");
+static_assert(FSM::stateId<O_L		>() ==  8, "");
+static_assert(FSM::stateId<O_L_1	>() ==  9, "");
+static_assert(FSM::stateId<O_L_2	>() == 10, "");
+static_assert(FSM::stateId<O_R		>() == 11, "");
+static_assert(FSM::stateId<Util		>() == 12, "");
+static_assert(FSM::stateId<U_1		>() == 13, "");
+static_assert(FSM::stateId<U_2		>() == 14, "");
+
+//------------------------------------------------------------------------------
+
+struct Ping {};
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct Apex		 : FSM::State {};
+
+struct Planned
+	: FSM::State
+{
+	void enter(PlanControl& control) {
+		control.plan().change<Step_1, Step_2>();
+	}
+};
+
+struct Step_1	 : FSM::State { void update(FullControl& control) { control.succeed(); } };
+struct Step_2	 : FSM::State { void update(FullControl& control) { control.succeed(); } };
+
+struct Resumable : FSM::State {};
+struct R_1		 : FSM::State {};
+struct R_2		 : FSM::State {};
+
+struct Ortho	 : FSM::State {};
+struct O_L		 : FSM::State {};
+
+struct O_L_1
+	: FSM::State
+{
+	using FSM::State::react;
+
+	void react(const Ping&, FullControl& control) {
+		control.changeTo<O_L_2>();
+	}
+};
+
+struct O_L_2	 : FSM::State {};
+
+struct O_R
+	: FSM::State
+{
+	void exitGuard(GuardControl& control) {
+		if (control._().locked)
+			control.cancelPendingTransitions();
+	}
+};
+
+struct Util		 : FSM::State {};
+struct U_1		 : FSM::State { Utility utility(const Control&) { return 0.25f; } };
+struct U_2		 : FSM::State { Utility utility(const Control&) { return 0.75f; } };
+
+////////////////////////////////////////////////////////////////////////////////
+
+using RT = M::Runtime<FSM::Instance::STATE_COUNT, 5, 1>;
+
+using RTPlanControl  = RT::PlanControl;
+using RTFullControl  = RT::FullControl;
+using RTGuardControl = RT::GuardControl;
+
+void succeed(const hfsm2::StateID, RTFullControl& control) {
+	control.succeed();
+}
+
+RT::Layout
+makeLayout() {
+	using Region = hfsm2::RuntimeRegion;
+
+	RT::Callbacks planned;
+	planned.enter = [](const hfsm2::StateID, RTPlanControl& control) {
+		control.plan().change(FSM::stateId<Step_1>(), FSM::stateId<Step_2>());
+	};
+
+	RT::Callbacks step;
+	step.update = succeed;
+
+	RT::Callbacks ol1;
+	ol1.react = [](const hfsm2::StateID, const RT::Event& event, RTFullControl& control) {
+		if (event.as<Ping>())
+			control.changeTo(FSM::stateId<O_L_2>());
+	};
+
+	RT::Callbacks oR;
+	oR.exitGuard = [](const hfsm2::StateID, RTGuardControl& control) {
+		if (control._().locked)
+			control.cancelPendingTransitions();
+	};
+
+	RT::Callbacks u1;
+	u1.utility = [](const hfsm2::StateID, const RT::Control&) { return 0.25f; };
+
+	RT::Callbacks u2;
+	u2.utility = [](const hfsm2::StateID, const RT::Control&) { return 0.75f; };
+
+	RT::Layout layout;
+
+	const auto apex		 = layout.add(hfsm2::INVALID_STATE_ID, Region::COMPOSITE);
+	const auto plannedId = layout.add(apex, Region::COMPOSITE, planned);
+	layout.add(plannedId, Region::NONE, step);
+	layout.add(plannedId, Region::NONE, step);
+	const auto resumable = layout.add(apex, Region::RESUMABLE);
+	layout.add(resumable);
+	layout.add(resumable);
+	const auto ortho	 = layout.add(apex, Region::ORTHOGONAL);
+	const auto ol		 = layout.add(ortho, Region::COMPOSITE);
+	layout.add(ol, Region::NONE, ol1);
+	layout.add(ol);
+
+	// out of depth-first order
+	REQUIRE(layout.add(ol + 1) == hfsm2::INVALID_STATE_ID);
+
+	layout.add(ortho, Region::NONE, oR);
+	const auto util		 = layout.add(apex, Region::UTILITARIAN);
+	layout.add(util, Region::NONE, u1);
+	layout.add(util, Region::NONE, u2);
+
+	// out of capacity
+	REQUIRE(layout.add(util) == hfsm2::INVALID_STATE_ID);
+
+	REQUIRE(layout.build());
+
+	REQUIRE(layout.stateCount() == (hfsm2::LongIndex) FSM::Instance::STATE_COUNT);
+	REQUIRE(layout.regionId(ortho) == FSM::regionId<Ortho>());
+	REQUIRE(layout.regionId(util)  == FSM::regionId<Util >());
+
+	return layout;
+}
+
+//------------------------------------------------------------------------------
+
+const Types all = {
+	FSM::stateId<Planned  >(),
+	FSM::stateId<Step_1	  >(),
+	FSM::stateId<Step_2	  >(),
+	FSM::stateId<Resumable>(),
+	FSM::stateId<R_1	  >(),
+	FSM::stateId<R_2	  >(),
+	FSM::stateId<Ortho	  >(),
+	FSM::stateId<O_L	  >(),
+	FSM::stateId<O_L_1	  >(),
+	FSM::stateId<O_L_2	  >(),
+	FSM::stateId<O_R	  >(),
+	FSM::stateId<Util	  >(),
+	FSM::stateId<U_1	  >(),
+	FSM::stateId<U_2	  >(),
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("FSM.Runtime", "[machine]") {
+	LoggerT<Context> compiledLogger;
+	LoggerT<Context> runtimeLogger;
+
+	Context compiledContext;
+	Context runtimeContext;
+
+	const RT::Layout layout = makeLayout();
+
+	{
+		FSM::Instance compiled{compiledContext, &compiledLogger};
+		RT::Instance  runtime {layout, runtimeContext, &runtimeLogger};
+
+		// both machines go through the same calls and report the same sequence
+		auto check = [&] {
+			runtimeLogger.assertSequence(compiledLogger.history);
+			compiledLogger.history.clear();
+
+			for (const auto id : all)
+				REQUIRE(runtime.isActive(id) == compiled.isActive(id));
+		};
+
+		check();
+		REQUIRE(runtime.isActive(FSM::stateId<Step_1>()));
+
+		// plan moves Step_1 to Step_2, then Planned succeeds
+		compiled.update();
+		runtime .update();
+		check();
+		REQUIRE(runtime.isActive(FSM::stateId<Step_2>()));
+
+		compiled.update();
+		runtime .update();
+		check();
+
+		compiled.changeTo(FSM::stateId<R_2>());
+		runtime .changeTo(FSM::stateId<R_2>());
+		compiled.update();
+		runtime .update();
+		check();
+
+		compiled.changeTo(FSM::stateId<Ortho>());
+		runtime .changeTo(FSM::stateId<Ortho>());
+		compiled.update();
+		runtime .update();
+		check();
+
+		compiled.react(Ping{});
+		runtime .react(Ping{});
+		check();
+		REQUIRE(runtime.isActive(FSM::stateId<O_L_2>()));
+
+		// O_R's exit guard holds the machine in Ortho
+		compiledContext.locked = true;
+		runtimeContext .locked = true;
+		compiled.changeTo(FSM::stateId<Util>());
+		runtime .changeTo(FSM::stateId<Util>());
+		compiled.update();
+		runtime .update();
+		check();
+		REQUIRE(runtime.isActive(FSM::stateId<Ortho>()));
+
+		compiledContext.locked = false;
+		runtimeContext .locked = false;
+		compiled.changeTo(FSM::stateId<Util>());
+		runtime .changeTo(FSM::stateId<Util>());
+		compiled.update();
+		runtime .update();
+		check();
+		REQUIRE(runtime.isActive(FSM::stateId<U_2>()));
+
+		compiled.changeTo(FSM::stateId<Resumable>());
+		runtime .changeTo(FSM::stateId<Resumable>());
+		compiled.update();
+		runtime .update();
+		check();
+		REQUIRE(runtime.isActive(FSM::stateId<R_2>()));
+
+		compiled.restart(FSM::stateId<Resumable>());
+		runtime .restart(FSM::stateId<Resumable>());
+		compiled.update();
+		runtime .update();
+		check();
+		REQUIRE(runtime.isActive(FSM::stateId<R_1>()));
+
+		compiled.utilize(FSM::stateId<Util>());
+		runtime .utilize(FSM::stateId<Util>());
+		compiled.update();
+		runtime .update();
+		check();
+
+		compiled.schedule(FSM::stateId<R_2>());
+		runtime .schedule(FSM::stateId<R_2>());
+		compiled.changeTo(FSM::stateId<Resumable>());
+		runtime .changeTo(FSM::stateId<Resumable>());
+		compiled.update();
+		runtime .update();
+		check();
+		REQUIRE(runtime.isActive(FSM::stateId<R_2>()));
+	}
+
+	runtimeLogger.assertSequence(compiledLogger.history);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
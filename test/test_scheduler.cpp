@@ -0,0 +1,127 @@
+#include "shared.hpp"
+
+namespace test_scheduler {
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct Context {
+	unsigned updates = 0;
+};
+
+using M = hfsm2::MachineT<hfsm2::Config::ContextT<Context>>;
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using Light = M::PeerRoot<
+				S(Off),
+				S(On)
+			>;
+
+using Door	= M::PeerRoot<
+				S(Closed),
+				S(Open)
+			>;
+
+#undef S
+
+//------------------------------------------------------------------------------
+
+struct Flip  {};
+struct Knock {};
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct Off : Light::State {
+	using Light::State::react;
+
+	void react(const Flip&, FullControl& control)		{ control.changeTo<On>();				}
+};
+
+struct On : Light::State {
+	void update(FullControl& control)					{ ++control._().updates;				}
+};
+
+struct Closed : Door::State {
+	using Door::State::react;
+
+	void react(const Knock&, FullControl& control)		{ control.changeTo<Open>();				}
+};
+
+struct Open : Door::State {
+	void update(FullControl& control)					{ ++control._().updates;				}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+using Scheduler = hfsm2::SchedulerT<2, Light::Instance, Door::Instance>;
+using Handle	= Scheduler::Handle;
+
+static_assert(Scheduler::typeIndex<Light::Instance>() == 0, "");
+static_assert(Scheduler::typeIndex<Door ::Instance>() == 1, "");
+
+//------------------------------------------------------------------------------
+
+TEST_CASE("FSM.Scheduler", "[machine]") {
+	Context context;
+	Scheduler scheduler;
+
+	const Handle light = scheduler.emplace<Light::Instance>(context);
+	const Handle spare = scheduler.emplace<Light::Instance>(context);
+	const Handle door  = scheduler.emplace<Door ::Instance>(context);
+
+	// the light pool is full
+	REQUIRE(!scheduler.contains(scheduler.emplace<Light::Instance>(context)));
+
+	REQUIRE(scheduler.count() == 3);
+	REQUIRE(scheduler.count<Light::Instance>() == 2);
+	REQUIRE(scheduler.count<Door ::Instance>() == 1);
+
+	REQUIRE(scheduler.get<Light::Instance>(light));
+	REQUIRE(scheduler.get<Door ::Instance>(light) == nullptr);
+
+	// routed to a single machine
+	REQUIRE(scheduler.react(light, Flip{}));
+	REQUIRE(scheduler.get<Light::Instance>(light)->isActive<On >());
+	REQUIRE(scheduler.get<Light::Instance>(spare)->isActive<Off>());
+
+	scheduler.update();
+	REQUIRE(context.updates == 1);
+
+	// broadcast to every type
+	scheduler.react(Knock{});
+	REQUIRE(scheduler.get<Door::Instance>(door)->isActive<Open>());
+
+	scheduler.update();
+	REQUIRE(context.updates == 3);
+
+	// removed machines leave stale handles behind
+	REQUIRE( scheduler.remove(light));
+	REQUIRE(!scheduler.remove(light));
+	REQUIRE(!scheduler.contains(light));
+	REQUIRE(!scheduler.react(light, Flip{}));
+	REQUIRE(scheduler.get<Light::Instance>(light) == nullptr);
+	REQUIRE(scheduler.count<Light::Instance>() == 1);
+
+	scheduler.update();
+	REQUIRE(context.updates == 4);
+
+	// .. even once their slot is reused
+	const Handle reused = scheduler.emplace<Light::Instance>(context);
+	REQUIRE(reused.slot == light.slot);
+	REQUIRE(reused != light);
+	REQUIRE(!scheduler.contains(light));
+	REQUIRE(scheduler.get<Light::Instance>(reused)->isActive<Off>());
+
+	unsigned lights = 0;
+	scheduler.forEach<Light::Instance>([&](Light::Instance& machine) {
+		REQUIRE(machine.isActive<Off>());
+		++lights;
+	});
+	REQUIRE(lights == 2);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
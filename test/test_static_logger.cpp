@@ -0,0 +1,122 @@
+#include "shared.hpp"
+
+namespace test_static_logger {
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct StaticLogger
+	: hfsm2::EmptyLogger
+{
+	struct Record {
+		StateID origin;
+		Method method;
+		StateID target;
+	};
+
+	void recordMethod(Context& /*context*/,
+					  const StateID origin,
+					  const Method method)
+	{
+		history.push_back(Record{origin, method, hfsm2::INVALID_STATE_ID});
+	}
+
+	void recordTransition(Context& /*context*/,
+						  const StateID origin,
+						  const TransitionType /*transitionType*/,
+						  const StateID target)
+	{
+		history.push_back(Record{origin, Method::NONE, target});
+	}
+
+	std::vector<Record> history;
+};
+
+static_assert(!std::is_polymorphic<StaticLogger>::value, "");
+
+//------------------------------------------------------------------------------
+
+using M = hfsm2::MachineT<hfsm2::Config::LoggerT<StaticLogger>>;
+
+static_assert(std::is_same<M::Config_::Logger, StaticLogger>::value, "");
+
+#define S(s) struct s
+
+using FSM = M::PeerRoot<
+				S(A),
+				S(B)
+			>;
+
+#undef S
+
+static_assert(FSM::stateId<A>() == 1, "");
+static_assert(FSM::stateId<B>() == 2, "");
+
+//------------------------------------------------------------------------------
+
+struct A : FSM::State {
+	void update(FullControl& control)					{ control.changeTo<B>();		}
+};
+
+struct B : FSM::State {
+	void enter(PlanControl&)							{}
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+
+using EmptyM = hfsm2::MachineT<hfsm2::Config::LoggerT<hfsm2::EmptyLogger>>;
+
+using EmptyFSM = EmptyM::PeerRoot<
+					 struct E1,
+					 struct E2
+				 >;
+
+struct E1 : EmptyFSM::State {
+	void update(FullControl& control)					{ control.changeTo<E2>();		}
+};
+
+struct E2 : EmptyFSM::State {};
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("FSM.Static Logger", "[machine]") {
+	StaticLogger logger;
+
+	FSM::Instance machine{&logger};
+	REQUIRE(machine.isActive<A>());
+
+	logger.history.clear();
+
+	machine.update();
+	REQUIRE(machine.isActive<B>());
+
+	REQUIRE(logger.history.size() == 4);
+
+	REQUIRE(logger.history[0].origin == FSM::stateId<A>());
+	REQUIRE(logger.history[0].method == hfsm2::Method::UPDATE);
+
+	REQUIRE(logger.history[1].origin == FSM::stateId<A>());
+	REQUIRE(logger.history[1].method == hfsm2::Method::NONE);
+	REQUIRE(logger.history[1].target == FSM::stateId<B>());
+
+	REQUIRE(logger.history[2].origin == FSM::stateId<B>());
+	REQUIRE(logger.history[2].method == hfsm2::Method::CONSTRUCT);
+
+	REQUIRE(logger.history[3].origin == FSM::stateId<B>());
+	REQUIRE(logger.history[3].method == hfsm2::Method::ENTER);
+}
+
+//------------------------------------------------------------------------------
+
+TEST_CASE("FSM.Empty Logger", "[machine]") {
+	hfsm2::EmptyLogger logger;
+
+	EmptyFSM::Instance machine{&logger};
+	REQUIRE(machine.isActive<E1>());
+
+	machine.update();
+	REQUIRE(machine.isActive<E2>());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,108 @@
+#define HFSM_ENABLE_STATIC_PLANS
+#include "shared.hpp"
+
+namespace test_static_plans {
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct Context {
+	std::vector<int> steps;
+	bool succeeded = false;
+};
+
+using M = hfsm2::MachineT<hfsm2::Config::ContextT<Context>>;
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using FSM = M::PeerRoot<
+				M::Composite<S(Mission),
+					S(Approach),
+					S(Attack),
+					S(Retreat)
+				>,
+				S(Done)
+			>;
+
+#undef S
+
+//------------------------------------------------------------------------------
+
+using Sortie = hfsm2::PlanTemplate<
+				   hfsm2::Change<Approach, Attack>,
+				   hfsm2::Change<Attack,   Retreat>
+			   >;
+
+using Tasks = hfsm2::detail::StaticPlanT<FSM::StateList, Sortie>;
+
+static_assert(Tasks::COUNT == 2, "");
+
+//------------------------------------------------------------------------------
+
+struct Mission : FSM::State {
+	void enter(PlanControl& control) {
+		auto plan = control.plan();
+		REQUIRE(!plan);
+
+		plan.apply<Sortie>();
+		REQUIRE(plan);
+	}
+
+	void planSucceeded(FullControl& control) {
+		control._().succeeded = true;
+		control.changeTo<Done>();
+	}
+};
+
+template <int N>
+struct Step : FSM::State {
+	void update(FullControl& control) {
+		control._().steps.push_back(N);
+		control.succeed();
+	}
+};
+
+struct Approach	: Step<1> {};
+struct Attack	: Step<2> {};
+struct Retreat	: Step<3> {};
+
+struct Done		: FSM::State {};
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("FSM.Static Plans", "[machine]") {
+	REQUIRE(Tasks::TASKS[0].origin		== FSM::stateId<Approach>());
+	REQUIRE(Tasks::TASKS[0].destination == FSM::stateId<Attack>());
+	REQUIRE(Tasks::TASKS[1].origin		== FSM::stateId<Attack>());
+	REQUIRE(Tasks::TASKS[1].destination == FSM::stateId<Retreat>());
+
+	Context context;
+	FSM::Instance machine{context};
+	REQUIRE(machine.isActive<Approach>());
+
+	machine.update();
+	REQUIRE(machine.isActive<Attack>());
+
+	machine.update();
+	REQUIRE(machine.isActive<Retreat>());
+	REQUIRE(!context.succeeded);
+
+	machine.update();
+	REQUIRE(context.succeeded);
+	REQUIRE(machine.isActive<Done>());
+
+	REQUIRE(context.steps == (std::vector<int>{1, 2, 3}));
+
+	// re-entering the region starts the template over
+	machine.changeTo<Mission>();
+	machine.update();
+	REQUIRE(machine.isActive<Approach>());
+
+	machine.update();
+	REQUIRE(machine.isActive<Attack>());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,116 @@
+#define HFSM_ENABLE_STATISTICS
+#include "shared.hpp"
+
+#include <fstream>
+#include <sstream>
+
+namespace test_statistics {
+
+////////////////////////////////////////////////////////////////////////////////
+
+using M = hfsm2::Machine;
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using FSM = M::PeerRoot<
+				S(A),
+				S(B),
+				S(C)
+			>;
+
+#undef S
+
+static_assert(FSM::stateId<A>() == 1, "");
+static_assert(FSM::stateId<B>() == 2, "");
+static_assert(FSM::stateId<C>() == 3, "");
+
+//------------------------------------------------------------------------------
+
+struct Ping {};
+
+struct A : FSM::State {
+	using FSM::State::react;
+
+	void react(const Ping&, FullControl& control)		{ control.changeTo<B>();				}
+};
+
+struct B : FSM::State {
+	using FSM::State::react;
+
+	void react(const Ping&, FullControl& control)		{ control.changeTo<A>();				}
+};
+
+struct C : FSM::State {
+	void entryGuard(GuardControl& control)				{ control.cancelPendingTransitions();	}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("FSM.Statistics", "[machine]") {
+	FSM::Instance::Statistics statistics;
+
+	FSM::Instance machine;
+	machine.attachStatistics(&statistics);
+
+	REQUIRE(statistics.visits(FSM::stateId<A>()) == 1);
+
+	machine.update();
+	machine.update();
+
+	machine.react(Ping{});			// A -> B, tick 3
+	REQUIRE(machine.isActive<B>());
+
+	machine.react(Ping{});			// B -> A, tick 4
+	REQUIRE(machine.isActive<A>());
+
+	machine.changeTo<C>();
+	machine.update();				// cancelled, tick 5
+	REQUIRE(machine.isActive<A>());
+
+	REQUIRE(statistics.tick() == 5);
+
+	REQUIRE(statistics.transitions(FSM::stateId<A>(), FSM::stateId<B>()) == 1);
+	REQUIRE(statistics.transitions(FSM::stateId<B>(), FSM::stateId<A>()) == 1);
+	REQUIRE(statistics.transitions(hfsm2::INVALID_STATE_ID, FSM::stateId<C>()) == 0);
+	REQUIRE(statistics.cancelled(FSM::stateId<C>()) == 1);
+
+	REQUIRE(statistics.visits(FSM::stateId<A>()) == 2);
+	REQUIRE(statistics.visits(FSM::stateId<B>()) == 1);
+	REQUIRE(statistics.visits(FSM::stateId<C>()) == 0);
+
+	REQUIRE(statistics.dwell(FSM::stateId<A>()) == 4);
+	REQUIRE(statistics.dwell(FSM::stateId<B>()) == 1);
+	REQUIRE(statistics.dwell(0)					== 5);
+
+	// pool aggregation
+
+	FSM::Instance::Statistics total;
+	total.merge(statistics);
+	total.merge(statistics);
+
+	REQUIRE(total.transitions(FSM::stateId<A>(), FSM::stateId<B>()) == 2);
+	REQUIRE(total.dwell(FSM::stateId<A>()) == 8);
+
+	REQUIRE(statistics.writeCsv("hfsm2_statistics.csv"));
+
+	std::ifstream file{"hfsm2_statistics.csv"};
+	std::stringstream content;
+	content << file.rdbuf();
+	file.close();
+	std::remove("hfsm2_statistics.csv");
+
+	REQUIRE(content.str().find("1,2,1\n") != std::string::npos);
+
+	statistics.clear();
+	REQUIRE(statistics.transitions(FSM::stateId<A>(), FSM::stateId<B>()) == 0);
+	REQUIRE(statistics.dwell(FSM::stateId<A>()) == 0);
+
+	machine.update();
+	REQUIRE(statistics.dwell(FSM::stateId<A>()) == 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
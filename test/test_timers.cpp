@@ -0,0 +1,127 @@
+#define HFSM_ENABLE_TIMERS
+#include "shared.hpp"
+
+namespace test_timers {
+
+////////////////////////////////////////////////////////////////////////////////
+
+using M = hfsm2::Machine;
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using FSM = M::PeerRoot<
+				S(Wait),
+				S(Next),
+				S(Far),
+				S(Idle),
+				S(Gated)
+			>;
+
+#undef S
+
+static_assert(FSM::stateId<Wait>() == 1, "");
+static_assert(FSM::stateId<Next>() == 2, "");
+static_assert(FSM::stateId<Far >() == 3, "");
+static_assert(FSM::stateId<Idle>() == 4, "");
+static_assert(FSM::stateId<Gated>() == 5, "");
+
+//------------------------------------------------------------------------------
+
+struct Leave {};
+
+struct Wait : FSM::State {
+	using FSM::State::react;
+
+	void enter(PlanControl& control)					{ control.changeAfter<Next>(3);			}
+
+	void react(const Leave&, FullControl& control)		{ control.changeTo<Idle>();				}
+};
+
+struct Next : FSM::State {
+	void enter(PlanControl& control) {
+		// past the first level of the wheel
+		control.changeAfter<Far>(5000);
+		REQUIRE(control.timerRemaining() == 5000);
+	}
+};
+
+struct Far : FSM::State {
+	void update(FullControl& control) {
+		REQUIRE(!control.isTimerPending());
+		control.changeAfter<Wait>(1);
+		control.cancelTimer();
+	}
+};
+
+struct Idle : FSM::State {};
+
+struct Gated : FSM::State {
+	void entryGuard(GuardControl& control) {
+		// armed on behalf of a state that never gets entered
+		control.changeAfter<Wait>(2);
+		control.cancelPendingTransitions();
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("FSM.Timers", "[machine]") {
+	FSM::Instance machine;
+	REQUIRE(machine.isActive<Wait>());
+
+	machine.update();
+	machine.update();
+	REQUIRE(machine.isActive<Wait>());
+
+	machine.update();
+	REQUIRE(machine.isActive<Next>());
+
+	for (unsigned i = 1; i < 5000; ++i)
+		machine.update();
+	REQUIRE(machine.isActive<Next>());
+
+	machine.update();
+	REQUIRE(machine.isActive<Far>());
+
+	// cancelled
+	machine.update();
+	machine.update();
+	REQUIRE(machine.isActive<Far>());
+
+	// auto-cancelled on exit
+	machine.changeTo<Wait>();
+	machine.update();
+	REQUIRE(machine.isActive<Wait>());
+
+	machine.react(Leave{});
+	REQUIRE(machine.isActive<Idle>());
+
+	for (unsigned i = 0; i < 5; ++i)
+		machine.update();
+	REQUIRE(machine.isActive<Idle>());
+}
+
+//------------------------------------------------------------------------------
+
+TEST_CASE("FSM.Timers.Cancelled Entry", "[machine]") {
+	FSM::Instance machine;
+
+	machine.changeTo<Idle>();
+	machine.update();
+	REQUIRE(machine.isActive<Idle>());
+
+	machine.changeTo<Gated>();
+	machine.update();
+	REQUIRE(machine.isActive<Idle>());
+
+	// the guard's timer is dropped once it expires
+	for (unsigned i = 0; i < 5; ++i)
+		machine.update();
+	REQUIRE(machine.isActive<Idle>());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,177 @@
+#define HFSM_ENABLE_TRANSITION_HISTORY
+#define HFSM_ENABLE_TRANSITION_TRACE
+#include "shared.hpp"
+
+namespace test_transition_trace {
+
+////////////////////////////////////////////////////////////////////////////////
+
+using M = hfsm2::Machine;
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using FSM = M::PeerRoot<
+				S(A),
+				S(B),
+				M::Composite<S(C),
+					S(C1),
+					S(C2)
+				>,
+				S(D)
+			>;
+
+#undef S
+
+//------------------------------------------------------------------------------
+
+static_assert(FSM::stateId<A >() ==  1, "");
+static_assert(FSM::stateId<B >() ==  2, "");
+static_assert(FSM::stateId<C >() ==  3, "");
+static_assert(FSM::stateId<C1>() ==  4, "");
+static_assert(FSM::stateId<C2>() ==  5, "");
+static_assert(FSM::stateId<D >() ==  6, "");
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct Advance {};
+
+//------------------------------------------------------------------------------
+
+struct A  : FSM::State {
+	void update(FullControl& control)					{ control.changeTo<B>();				}
+};
+
+struct B  : FSM::State {
+	void react(const Advance&, FullControl& control)	{ control.changeTo<C>();				}
+};
+
+struct C  : FSM::State {};
+
+struct C1 : FSM::State {
+	void update(FullControl& control)					{ control.changeTo<C2>();				}
+};
+
+struct C2 : FSM::State {};
+
+struct D  : FSM::State {
+	void entryGuard(GuardControl& control)				{ control.cancelPendingTransitions();	}
+};
+
+//------------------------------------------------------------------------------
+
+void
+assertRecord(const hfsm2::TraceRecord& record,
+			 const uint32_t tick,
+			 const hfsm2::StateID origin,
+			 const hfsm2::StateID target,
+			 const hfsm2::Method method)
+{
+	REQUIRE(record.tick			  == tick);
+	REQUIRE(record.instance		  == 0);
+	REQUIRE(record.origin		  == origin);
+	REQUIRE(record.target		  == target);
+	REQUIRE(record.transitionType == hfsm2::TransitionType::CHANGE);
+	REQUIRE(record.method		  == method);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("FSM.Transition Trace", "[machine]") {
+	hfsm2::TransitionTraceT<16> trace;
+
+	FSM::Instance authority;
+	authority.attachTrace(&trace);
+	REQUIRE(authority.isActive<A>());
+
+	authority.update();
+	REQUIRE(authority.isActive<B>());
+
+	authority.react(Advance{});
+	REQUIRE(authority.isActive<C1>());
+
+	authority.update();
+	REQUIRE(authority.isActive<C2>());
+
+	authority.changeTo<D>();
+	authority.update();
+	REQUIRE(authority.isActive<C2>());
+
+	REQUIRE(authority.tick() == 4);
+	REQUIRE(trace.count() == 4);
+
+	std::vector<char> file(trace.flushSize());
+	REQUIRE(trace.flush(file.data(), file.size()) == file.size());
+
+	const hfsm2::TraceReader reader{file.data(), file.size()};
+	REQUIRE(reader.valid());
+	REQUIRE(reader.count() == 4);
+
+	assertRecord(reader[0], 1, FSM::stateId<A >(),		FSM::stateId<B >(), hfsm2::Method::NONE);
+	assertRecord(reader[1], 2, FSM::stateId<B >(),		FSM::stateId<C >(), hfsm2::Method::NONE);
+	assertRecord(reader[2], 3, FSM::stateId<C1>(),		FSM::stateId<C2>(), hfsm2::Method::NONE);
+	assertRecord(reader[3], 4, hfsm2::INVALID_STATE_ID, FSM::stateId<D >(), hfsm2::Method::ENTRY_GUARD);
+
+	// replay
+
+	FSM::Instance replicated;
+	REQUIRE(replicated.isActive<A>());
+
+	REQUIRE(hfsm2::replayTrace(replicated, reader) == 3);
+	REQUIRE(replicated.isActive<C2>());
+
+	// instances sharing a trace
+
+	FSM::Instance other;
+	other.attachTrace(&trace, 1);
+
+	other.update();
+	REQUIRE(trace.count() == 5);
+	REQUIRE(trace.flush(file.data(), file.size()) == file.size());
+
+	FSM::Instance filtered;
+	REQUIRE(hfsm2::replayTrace(filtered, hfsm2::TraceReader{file.data(), file.size()}, 1) == 1);
+	REQUIRE(filtered.isActive<B>());
+}
+
+//------------------------------------------------------------------------------
+
+TEST_CASE("FSM.Transition Trace Wrap", "[machine]") {
+	hfsm2::TransitionTraceT<4> trace;
+	REQUIRE(trace.capacity() == 4);
+
+	for (uint32_t i = 1; i <= 6; ++i)
+		trace.record(hfsm2::TraceRecord{i,
+										0,
+										hfsm2::INVALID_STATE_ID,
+										FSM::stateId<B>(),
+										hfsm2::TransitionType::CHANGE,
+										hfsm2::Method::NONE});
+	REQUIRE(trace.count() == 4);
+
+	char file[sizeof(hfsm2::TraceHeader) + sizeof(hfsm2::TraceRecord) * 4];
+
+	REQUIRE(trace.flush(file, sizeof(hfsm2::TraceHeader) - 1) == 0);
+	REQUIRE(trace.flush(file, sizeof(file)) == sizeof(file));
+
+	const hfsm2::TraceReader reader{file, sizeof(file)};
+	REQUIRE(reader.count() == 4);
+
+	for (uint32_t i = 0; i < 4; ++i)
+		REQUIRE(reader[i].tick == i + 3);
+
+	// truncated flush keeps the latest records
+	REQUIRE(trace.flush(file, sizeof(hfsm2::TraceHeader) + sizeof(hfsm2::TraceRecord) * 2)
+		 == sizeof(hfsm2::TraceHeader) + sizeof(hfsm2::TraceRecord) * 2);
+	REQUIRE(hfsm2::TraceReader{file, sizeof(file)}[0].tick == 5);
+
+	trace.clear();
+	REQUIRE(trace.count() == 0);
+
+	REQUIRE(!hfsm2::TraceReader{file, sizeof(hfsm2::TraceHeader) - 1}.valid());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
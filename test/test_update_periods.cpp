@@ -0,0 +1,77 @@
+#define HFSM_ENABLE_UPDATE_PERIODS
+#include "shared.hpp"
+
+namespace test_update_periods {
+
+////////////////////////////////////////////////////////////////////////////////
+
+using M = hfsm2::Machine;
+
+//------------------------------------------------------------------------------
+
+#define S(s) struct s
+
+using FSM = M::OrthogonalPeerRoot<
+				M::Composite<S(Fast),
+					S(FastLeaf)
+				>,
+				M::Composite<S(Slow),
+					S(SlowLeaf),
+					S(SlowOther)
+				>
+			>;
+
+#undef S
+
+//------------------------------------------------------------------------------
+
+struct Ping {};
+
+struct Counter {
+	unsigned updates = 0;
+};
+
+struct Fast		 : FSM::State {};
+struct FastLeaf	 : FSM::State, Counter	{ void update(FullControl&)				{ ++updates;					}	};
+
+struct Slow		 : FSM::State, Counter	{ void update(FullControl&)				{ ++updates;					}	};
+
+struct SlowLeaf
+	: FSM::State
+	, Counter
+{
+	using FSM::State::react;
+
+	void update(FullControl&)								{ ++updates;					}
+	void react(const Ping&, FullControl& control)			{ control.changeTo<SlowOther>();	}
+};
+
+struct SlowOther : FSM::State {};
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("FSM.UpdatePeriods", "[machine]") {
+	FSM::Instance machine;
+	machine.setUpdatePeriod<Slow>(3, 1);
+
+	for (unsigned i = 0; i < 7; ++i)
+		machine.update();
+
+	REQUIRE(machine.access<FastLeaf>().updates == 7);
+
+	// due on ticks 2 and 5
+	REQUIRE(machine.access<Slow	   >().updates == 2);
+	REQUIRE(machine.access<SlowLeaf>().updates == 2);
+
+	// reactions aren't throttled
+	machine.react(Ping{});
+	REQUIRE(machine.isActive<SlowOther>());
+
+	machine.setUpdatePeriod<Slow>(1);
+	machine.update();
+	REQUIRE(machine.access<Slow>().updates == 3);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
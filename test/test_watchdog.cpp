@@ -0,0 +1,145 @@
+#define HFSM_ENABLE_WATCHDOG
+#include "shared.hpp"
+
+namespace test_watchdog {
+
+////////////////////////////////////////////////////////////////////////////////
+
+struct WatchdogLogger
+	: hfsm2::EmptyLogger
+{
+	struct Record {
+		WatchdogEvent event;
+		StateID origin;
+		StateID target;
+	};
+
+	void recordWatchdogEvent(Context& /*context*/,
+							 const WatchdogEvent event,
+							 const StateID origin,
+							 const StateID target)
+	{
+		history.push_back(Record{event, origin, target});
+	}
+
+	std::vector<Record> history;
+};
+
+//------------------------------------------------------------------------------
+
+using M = hfsm2::MachineT<hfsm2::Config::LoggerT<WatchdogLogger>>;
+
+#define S(s) struct s
+
+using FSM = M::PeerRoot<
+				S(A),
+				S(B),
+				S(C),
+				S(D)
+			>;
+
+#undef S
+
+static_assert(FSM::stateId<A>() == 1, "");
+static_assert(FSM::stateId<B>() == 2, "");
+static_assert(FSM::stateId<C>() == 3, "");
+static_assert(FSM::stateId<D>() == 4, "");
+
+//------------------------------------------------------------------------------
+
+struct Ping {};
+
+struct A : FSM::State {
+	using FSM::State::react;
+
+	void react(const Ping&, FullControl& control)		{ control.changeTo<B>();				}
+};
+
+struct B : FSM::State {
+	using FSM::State::react;
+
+	void react(const Ping&, FullControl& control)		{ control.changeTo<A>();				}
+};
+
+// C and D keep substituting each other until the round limit is exhausted
+
+struct C : FSM::State {
+	void entryGuard(GuardControl& control) {
+		control.cancelPendingTransitions();
+		control.changeTo<D>();
+	}
+};
+
+struct D : FSM::State {
+	void entryGuard(GuardControl& control) {
+		control.cancelPendingTransitions();
+		control.changeTo<C>();
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////
+
+TEST_CASE("FSM.Watchdog", "[machine]") {
+	WatchdogLogger logger;
+
+	FSM::Instance machine;
+	machine.attachLogger(&logger);
+
+	machine.update();
+	REQUIRE(machine.watchdogReport().ticks == 1);
+	REQUIRE(machine.watchdogReport().calls == 0);
+
+	machine.react(Ping{});			// A -> B
+	REQUIRE(machine.isActive<B>());
+	REQUIRE(logger.history.empty());
+
+	machine.react(Ping{});			// B -> A, reverts A -> B
+	REQUIRE(machine.isActive<A>());
+
+	{
+		const hfsm2::WatchdogReport& report = machine.watchdogReport();
+		REQUIRE(report.calls		== 2);
+		REQUIRE(report.rounds		== 2);
+		REQUIRE(report.maxRounds	== 1);
+		REQUIRE(report.limitHits	== 0);
+		REQUIRE(report.oscillations == 1);
+		REQUIRE(report.oscillationOrigin == FSM::stateId<B>());
+		REQUIRE(report.oscillationTarget == FSM::stateId<A>());
+
+		REQUIRE(logger.history.size() == 1);
+		REQUIRE(logger.history[0].event	 == hfsm2::WatchdogEvent::OSCILLATION);
+		REQUIRE(logger.history[0].origin == FSM::stateId<B>());
+		REQUIRE(logger.history[0].target == FSM::stateId<A>());
+	}
+
+	// outside of the sliding window
+	for (unsigned i = 0; i < hfsm2::detail::Watchdog::WINDOW + 1; ++i)
+		machine.update();
+
+	machine.react(Ping{});			// A -> B, last B -> A is stale
+	REQUIRE(machine.isActive<B>());
+	REQUIRE(machine.watchdogReport().oscillations == 1);
+
+	// substitution limit
+	machine.changeTo<C>();
+	machine.update();
+	REQUIRE(machine.isActive<B>());
+
+	{
+		const hfsm2::WatchdogReport& report = machine.watchdogReport();
+		REQUIRE(report.limitHits == 1);
+		REQUIRE(report.maxRounds == 4);		// default substitution limit
+
+		REQUIRE(logger.history.size() == 2);
+		REQUIRE(logger.history[1].event	 == hfsm2::WatchdogEvent::SUBSTITUTION_LIMIT);
+		REQUIRE(logger.history[1].origin == hfsm2::INVALID_STATE_ID);
+	}
+
+	machine.resetWatchdog();
+	REQUIRE(machine.watchdogReport().ticks == 0);
+	REQUIRE(machine.watchdogReport().limitHits == 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+
+}
@@ -0,0 +1,92 @@
+import struct
+import sys
+
+#===============================================================================
+# Decoder for transition traces written by hfsm2::TransitionTrace::flush()
+#
+# usage: python3 trace.py <trace file> [instance]
+#
+# To reproduce a session, load the same file into hfsm2::TraceReader and pass
+# it to hfsm2::replayTrace() along with a freshly constructed machine
+#===============================================================================
+
+MAGIC = 0x52544648
+VERSION = 1
+
+HEADER = struct.Struct("<IHHQ")
+RECORD = struct.Struct("<IHHHBB")
+
+INVALID_STATE_ID = 0xFFFF
+
+TRANSITION_TYPES = [
+	"changeTo",
+	"restart",
+	"resume",
+	"utilize",
+	"randomize",
+	"schedule",
+]
+
+METHODS = [
+	"",
+	"rank",
+	"utility",
+	"entryGuard",
+	"construct",
+	"enter",
+	"reenter",
+	"update",
+	"react",
+	"exitGuard",
+	"exit",
+	"destruct",
+	"planSucceeded",
+	"planFailed",
+]
+
+#-------------------------------------------------------------------------------
+
+def decode(data):
+	magic, version, recordSize, count = HEADER.unpack_from(data, 0)
+
+	if magic != MAGIC or version != VERSION or recordSize != RECORD.size:
+		raise ValueError("not an hfsm2 transition trace")
+
+	if HEADER.size + count * RECORD.size > len(data):
+		raise ValueError("truncated transition trace")
+
+	for i in range(count):
+		yield RECORD.unpack_from(data, HEADER.size + i * RECORD.size)
+
+#-------------------------------------------------------------------------------
+
+def stateName(stateId):
+	return "external" if stateId == INVALID_STATE_ID else str(stateId)
+
+#===============================================================================
+
+if len(sys.argv) < 2:
+	print("usage: python3 trace.py <trace file> [instance]")
+	sys.exit(1)
+
+with open(sys.argv[1], 'rb') as input:
+	data = input.read()
+
+instanceFilter = int(sys.argv[2]) if len(sys.argv) > 2 else None
+
+for tick, instance, origin, target, transitionType, method in decode(data):
+	if instanceFilter is not None and instance != instanceFilter:
+		continue
+
+	line = "{:>10} [{}] {:>8} -> {}({})".format(tick,
+												instance,
+												stateName(origin),
+												TRANSITION_TYPES[transitionType],
+												stateName(target))
+
+	if method != 0:
+		line += " cancelled by " + METHODS[method]
+
+	print(line)
+
+#===============================================================================